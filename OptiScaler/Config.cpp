@@ -2,6 +2,7 @@
 
 #include "Config.h"
 
+#include "ConfigIni.h"
 #include "Util.h"
 
 #include "nvapi/fakenvapi.h"
@@ -10,7 +11,28 @@
 
 #include <SimpleIni.h>
 
-static CSimpleIniA ini;
+#include <fstream>
+#include <mutex>
+
+// Saves are delayed so quick menu changes end up in one write
+constexpr auto SaveDelay = std::chrono::milliseconds(500);
+constexpr auto IniCheckInterval = std::chrono::seconds(1);
+
+static ConfigIni ini;
+
+// Protects ini, saving & change checks happen on the config thread
+static std::mutex iniMutex;
+
+static bool snapshotValues = false;
+static uint32_t changedValues = 0;
+
+static void SetIniValue(const char* section, const char* key, const char* value)
+{
+    if (snapshotValues)
+        ini.SetSaved(section, key, value);
+    else if (ini.Set(section, key, value))
+        changedValues++;
+}
 
 static inline int64_t GetTicks()
 {
@@ -22,40 +44,360 @@ static inline int64_t GetTicks()
     return ticks.QuadPart;
 }
 
-static inline bool isInteger(const std::string& str, int& value)
+Config::Config()
 {
-    std::istringstream iss(str);
-    return (iss >> value) && iss.eof();
+    absoluteFileName = Util::DllPath().parent_path() / fileName;
+    BuildSchema();
+    Reload(absoluteFileName);
 }
 
-static inline bool isUInt(const std::string& str, uint32_t& value)
+// Options which map directly to a single ini key, anything with custom parsing is handled in Reload & WriteValues
+void Config::BuildSchema()
 {
-    std::istringstream iss(str);
-    return (iss >> value) && iss.eof();
-}
+    _schema = {
+        // Upscalers
+        { "Upscalers", "PrewarmUpscaler", PrewarmUpscaler },
+
+        // FrameGen
+        { "FrameGen", "Enabled", FGEnabled },
+        { "FrameGen", "DebugView", FGDebugView },
+        { "FrameGen", "DrawUIOverFG", FGDrawUIOverFG },
+        { "FrameGen", "UIPremultipliedAlpha", FGUIPremultipliedAlpha },
+        { "FrameGen", "DisableHudless", FGDisableHudless },
+        { "FrameGen", "DisableUI", FGDisableUI },
+        { "FrameGen", "SkipReset", FGSkipReset },
+        { "FrameGen", "RectLeft", FGRectLeft },
+        { "FrameGen", "RectTop", FGRectTop },
+        { "FrameGen", "RectWidth", FGRectWidth },
+        { "FrameGen", "RectHeight", FGRectHeight },
+        { "FrameGen", "AllowedFrameAhead", FGAllowedFrameAhead },
+        { "FrameGen", "DepthValidNow", FGDepthValidNow },
+        { "FrameGen", "VelocityValidNow", FGVelocityValidNow },
+        { "FrameGen", "HudlessValidNow", FGHudlessValidNow },
+        { "FrameGen", "OnlyAcceptFirstHudless", FGOnlyAcceptFirstHudless },
+        { "FrameGen", "PreserveSwapChain", FGPreserveSwapChain },
+        { "FrameGen", "SkipResizeBuffers", FGSkipResizeBuffers },
+        { "FrameGen", "ModifyBufferState", FGModifyBufferState },
+        { "FrameGen", "ModifySCIndex", FGModifySCIndex },
+        { "FrameGen", "HudCutoff", FGHudCutoff },
+
+        // FSRFG
+        { "FSRFG", "DebugTearLines", FGDebugTearLines },
+        { "FSRFG", "DebugResetLines", FGDebugResetLines },
+        { "FSRFG", "DebugPacingLines", FGDebugPacingLines },
+        { "FSRFG", "AllowAsync", FGAsync },
+        { "FSRFG", "UseMutexForSwapchain", FGUseMutexForSwapchain },
+        { "FSRFG", "FramePacingTuning", FGFramePacingTuning },
+        { "FSRFG", "FPTSafetyMarginInMs", FGFPTSafetyMarginInMs },
+        { "FSRFG", "FPTVarianceFactor", FGFPTVarianceFactor },
+        { "FSRFG", "FPTHybridSpin", FGFPTAllowHybridSpin },
+        { "FSRFG", "FPTHybridSpinTime", FGFPTHybridSpinTime },
+        { "FSRFG", "FPTWaitForSingleObjectOnFence", FGFPTAllowWaitForSingleObjectOnFence },
+        { "FSRFG", "FPTAutoTune", FGFPTAutoTune },
+        { "FSRFG", "EnableWatermark", FSRFGEnableWatermark },
 
-static inline bool isFloat(const std::string& str, float& value)
-{
-    std::istringstream iss(str);
-    return (iss >> value) && iss.eof();
-}
+        // OptiFG
+        { "OptiFG", "DisableHUDFix", FGDisableHUDFix },
+        { "OptiFG", "HUDFix", FGHUDFix },
+        { "OptiFG", "HUDLimit", FGHUDLimit },
+        { "OptiFG", "HUDFixExtended", FGHUDFixExtended },
+        { "OptiFG", "HUDFixImmediate", FGImmediateCapture },
+        { "OptiFG", "UseShards", FGUseShards },
+        { "OptiFG", "AlwaysTrackHeaps", FGAlwaysTrackHeaps },
+        { "OptiFG", "ResourceBlocking", FGResourceBlocking },
+        { "OptiFG", "HUDFixValidation", FGHudfixValidation },
+        { "OptiFG", "MakeDepthCopy", FGMakeDepthCopy },
+        { "OptiFG", "MakeMVCopy", FGMakeMVCopy },
+        { "OptiFG", "HudfixDisableRTV", FGHudfixDisableRTV },
+        { "OptiFG", "HudfixDisableSRV", FGHudfixDisableSRV },
+        { "OptiFG", "HudfixDisableUAV", FGHudfixDisableUAV },
+        { "OptiFG", "HudfixDisableOM", FGHudfixDisableOM },
+        { "OptiFG", "HudfixDisableDispatch", FGHudfixDisableDispatch },
+        { "OptiFG", "HudfixDisableDI", FGHudfixDisableDI },
+        { "OptiFG", "HudfixDisableDII", FGHudfixDisableDII },
+        { "OptiFG", "HudfixDisableSCR", FGHudfixDisableSCR },
+        { "OptiFG", "HudfixDisableSGR", FGHudfixDisableSGR },
+        { "OptiFG", "EnableDepthScale", FGEnableDepthScale },
+        { "OptiFG", "DepthScaleMax", FGDepthScaleMax },
+        { "OptiFG", "HUDFixDontUseSwapchainBuffers", FGDontUseSwapchainBuffers },
+        { "OptiFG", "HUDFixRelaxedResolutionCheck", FGRelaxedResolutionCheck },
+        { "OptiFG", "ResourceFlip", FGResourceFlip },
+        { "OptiFG", "ResourceFlipOffset", FGResourceFlipOffset },
+        { "OptiFG", "AlwaysCaptureFSRFGSwapchain", FGAlwaysCaptureFSRFGSwapchain },
+
+        // XeFG
+        { "XeFG", "InterpolationCount", FGXeFGInterpolationCount },
+        { "XeFG", "IgnoreInitChecks", FGXeFGIgnoreInitChecks },
+        { "XeFG", "UIComposition", FGXeFGUIComposition },
+        { "XeFG", "DepthInverted", FGXeFGDepthInverted },
+        { "XeFG", "JitteredMV", FGXeFGJitteredMV },
+        { "XeFG", "HighResMV", FGXeFGHighResMV },
+        { "XeFG", "DebugView", FGXeFGDebugView },
+        { "XeFG", "ForceBorderless", FGXeFGForceBorderless },
+
+        // DLSSG
+        { "DLSSG", "InterpolationCount", FGDLSSGInterpolationCount },
+        { "DLSSG", "UseGamesReflexMarkers", FGDLSSGUseGamesReflexMarkers },
+        { "DLSSG", "OverrideInterpolationCount", FGDLSSGOverrideInterpolationCount },
+        { "DLSSG", "FramerateTargetDMFG", FGDLSSGFramerateTargetDMFG },
+        { "DLSSG", "OverrideForceDMFG", FGDLSSGOverrideForceDMFG },
+
+        // FSRFGInputs
+        { "FSRFGInputs", "SkipConfigForHudless", FSRFGSkipConfigForHudless },
+        { "FSRFGInputs", "SkipDispatchForHudless", FSRFGSkipDispatchForHudless },
 
-Config::Config()
-{
-    absoluteFileName = Util::DllPath().parent_path() / fileName;
-    Reload(absoluteFileName);
+        // Framerate
+        { "Framerate", "FramerateLimit", FramerateLimit, ConfigFlags_Hot },
+        { "Framerate", "PresentProfiler", PresentProfiler },
+
+        // FSR
+        { "FSR", "VerticalFov", FsrVerticalFov },
+        { "FSR", "HorizontalFov", FsrHorizontalFov },
+        { "FSR", "CameraNear", FsrCameraNear },
+        { "FSR", "CameraFar", FsrCameraFar },
+        { "FSR", "UseFsrInputValues", FsrUseFsrInputValues },
+        { "FSR", "VelocityFactor", FsrVelocity, ConfigFlags_Hot },
+        { "FSR", "ReactiveScale", FsrReactiveScale, ConfigFlags_Hot },
+        { "FSR", "ShadingScale", FsrShadingScale, ConfigFlags_Hot },
+        { "FSR", "AccAddPerFrame", FsrAccAddPerFrame },
+        { "FSR", "MinDisOccAcc", FsrMinDisOccAcc },
+        { "FSR", "DebugView", FsrDebugView },
+        { "FSR", "UpscalerIndex", FfxUpscalerIndex },
+        { "FSR", "FGIndex", FfxFGIndex },
+        { "FSR", "UseReactiveMaskForTransparency", FsrUseMaskForTransparency },
+        { "FSR", "DlssReactiveMaskBias", DlssReactiveMaskBias },
+        { "FSR", "Fsr4ForceCapable", Fsr4ForceCapable },
+        { "FSR", "Fsr4EnableWatermark", Fsr4EnableWatermark },
+        { "FSR", "FsrNonLinearColorSpace", FsrNonLinearColorSpace },
+        { "FSR", "FsrNonLinearPQ", FsrNonLinearPQ },
+        { "FSR", "FsrNonLinearSRGB", FsrNonLinearSRGB },
+        { "FSR", "FsrAgilitySDKUpgrade", FsrAgilitySDKUpgrade },
+
+        // XeSS
+        { "XeSS", "BuildPipelines", BuildPipelines },
+        { "XeSS", "NetworkModel", NetworkModel },
+        { "XeSS", "CreateHeaps", CreateHeaps },
+
+        // DLSS
+        { "DLSS", "Enabled", DLSSEnabled },
+        { "DLSS", "UseGenericAppIdWithDlss", UseGenericAppIdWithDlss },
+        { "DLSS", "RenderPresetOverride", RenderPresetOverride },
+
+        // DLSSD
+        { "DLSSD", "RenderPresetOverride", DLSSDRenderPresetOverride },
+
+        // Log
+        { "Log", "LogToFile", LogToFile },
+        { "Log", "LogLevel", LogLevel },
+        { "Log", "LogToConsole", LogToConsole },
+        { "Log", "LogToDebug", LogToDebug },
+        { "Log", "LogToNGX", LogToNGX },
+        { "Log", "OpenConsole", OpenConsole },
+        { "Log", "SingleFile", LogSingleFile },
+        { "Log", "LogAsync", LogAsync },
+        { "Log", "LogAsyncThreads", LogAsyncThreads },
+        { "Log", "ApiCapture", ApiCaptureEnabled },
+
+        // Sharpness
+        { "Sharpness", "OverrideSharpness", OverrideSharpness, ConfigFlags_Hot },
+        { "Sharpness", "Sharpness", Sharpness, 0.0f, 1.3f, ConfigFlags_Hot },
+
+        // Menu
+        { "Menu", "Scale", MenuScale, 0.5f, 2.0f },
+        { "Menu", "OverlayMenu", OverlayMenu }, // Don't enable again if set false because of Linux issue
+        { "Menu", "ExtendedLimits", ExtendedLimits },
+        { "Menu", "ShowFps", ShowFps, ConfigFlags_Hot },
+        { "Menu", "UseHQFont", UseHQFont },
+        { "Menu", "DisableSplash", DisableSplash },
+        { "Menu", "FpsOverlayPos", FpsOverlayPos, 0, 3, ConfigFlags_Hot },
+        { "Menu", "FpsOverlayHorizontal", FpsOverlayHorizontal, ConfigFlags_Hot },
+        { "Menu", "FpsOverlayAlpha", FpsOverlayAlpha, 0.0f, 1.0f, ConfigFlags_Hot },
+        { "Menu", "FpsScale", FpsScale, 0.5f, 2.0f, ConfigFlags_Hot },
+        { "Menu", "FontSize", FontSize },
+        { "Menu", "TTFFontPath", TTFFontPath },
+        { "Menu", "LightTheme", LightTheme },
+        { "Menu", "RefreshRate", MenuRefreshRate },
+        { "Menu", "HotReloadIni", HotReloadIni },
+
+        // Hooks
+        { "Hooks", "HookOriginalNvngxOnly", HookOriginalNvngxOnly },
+        { "Hooks", "EarlyHooking", EarlyHooking },
+        { "Hooks", "UseNtdllHooks", UseNtdllHooks },
+
+        // CAS
+        { "CAS", "Enabled", RcasEnabled, ConfigFlags_Hot },
+        { "CAS", "MotionSharpnessEnabled", MotionSharpnessEnabled, ConfigFlags_Hot },
+        { "CAS", "MotionSharpness", MotionSharpness, -1.3f, 1.3f, ConfigFlags_Hot },
+        { "CAS", "MotionThreshold", MotionThreshold, 0.0f, 100.0f, ConfigFlags_Hot },
+        { "CAS", "MotionScaleLimit", MotionScaleLimit, 0.01f, 100.0f, ConfigFlags_Hot },
+        { "CAS", "ContrastEnabled", ContrastEnabled, ConfigFlags_Hot },
+        { "CAS", "Contrast", Contrast, -2.0f, 2.0f, ConfigFlags_Hot },
+        { "CAS", "DADepthScale", DADepthScale, ConfigFlags_Hot },
+        { "CAS", "DADepthBias", DADepthBias, ConfigFlags_Hot },
+        { "CAS", "DAClampOutput", DAClampOutput, ConfigFlags_Hot },
+        { "CAS", "SharpenerDebug", MotionSharpnessDebug, ConfigFlags_Hot },
+
+        // OutputScaling
+        { "OutputScaling", "Enabled", OutputScalingEnabled },
+        { "OutputScaling", "Multiplier", OutputScalingMultiplier, 0.5f, 3.0f },
+        { "OutputScaling", "FusedPasses", OutputScalingFusedPasses },
+
+        // InitFlags
+        { "InitFlags", "AutoExposure", AutoExposure },
+        { "InitFlags", "HDR", HDR },
+        { "InitFlags", "DepthInverted", DepthInverted },
+        { "InitFlags", "JitterCancellation", JitterCancellation },
+        { "InitFlags", "DisplayResolution", DisplayResolution },
+        { "InitFlags", "DisableReactiveMask", DisableReactiveMask },
+
+        // DRS
+        { "DRS", "DrsMinOverrideEnabled", DrsMinOverrideEnabled },
+        { "DRS", "DrsMaxOverrideEnabled", DrsMaxOverrideEnabled },
+        { "DRS", "DynamicResolution", DynamicResolution, ConfigFlags_Hot },
+        { "DRS", "DynamicResolutionTargetMs", DynamicResolutionTargetMs, ConfigFlags_Hot },
+
+        // UpscaleRatio
+        { "UpscaleRatio", "UpscaleRatioOverrideEnabled", UpscaleRatioOverrideEnabled },
+        { "UpscaleRatio", "UpscaleRatioOverrideValue", UpscaleRatioOverrideValue },
+
+        // QualityOverrides
+        { "QualityOverrides", "QualityRatioOverrideEnabled", QualityRatioOverrideEnabled },
+        { "QualityOverrides", "QualityRatioDLAA", QualityRatio_DLAA },
+        { "QualityOverrides", "QualityRatioUltraQuality", QualityRatio_UltraQuality },
+        { "QualityOverrides", "QualityRatioQuality", QualityRatio_Quality },
+        { "QualityOverrides", "QualityRatioBalanced", QualityRatio_Balanced },
+        { "QualityOverrides", "QualityRatioPerformance", QualityRatio_Performance },
+
+        // Anisotropy
+        { "Anisotropy", "SkipPointFilter", AnisotropySkipPointFilter, ConfigFlags_Hot },
+
+        // Mipmap
+        { "Mipmap", "MipmapBiasFixedOverride", MipmapBiasFixedOverride, ConfigFlags_Hot },
+        { "Mipmap", "MipmapBiasScaleOverride", MipmapBiasScaleOverride, ConfigFlags_Hot },
+        { "Mipmap", "MipmapBiasOverrideAll", MipmapBiasOverrideAll, ConfigFlags_Hot },
+        { "Mipmap", "MipmapBiasAuto", MipmapBiasAuto, ConfigFlags_Hot },
+        { "Mipmap", "MipmapBiasLiveUpdate", MipmapBiasLiveUpdate },
+
+        // ProcessFilter
+        { "ProcessFilter", "ProcessExclusionList", ProcessExclusionList, ConfigFlags_Lowercase },
+        { "ProcessFilter", "TargetProcessName", TargetProcess, ConfigFlags_Lowercase },
+
+        // Game Profiles
+        { "GameProfiles", "Enabled", UseGameProfiles },
+
+        // Hotfix
+        { "Hotfix", "CheckForUpdate", CheckForUpdate },
+        { "Hotfix", "DisableOverlays", DisableOverlays },
+        { "Hotfix", "RoundInternalResolution", RoundInternalResolution },
+        { "Hotfix", "RestoreComputeSignature", RestoreComputeSignature },
+        { "Hotfix", "RestoreGraphicSignature", RestoreGraphicSignature },
+        { "Hotfix", "PreferDedicatedGpu", PreferDedicatedGpu },
+        { "Hotfix", "PreferFirstDedicatedGpu", PreferFirstDedicatedGpu },
+        { "Hotfix", "SkipFirstFrames", SkipFirstFrames },
+        { "Hotfix", "UsePrecompiledShaders", UsePrecompiledShaders },
+        { "Hotfix", "ReleaseIdleBuffersOnLowVram", ReleaseIdleBuffersOnLowVram },
+        { "Hotfix", "ColorResourceBarrier", ColorResourceBarrier },
+        { "Hotfix", "MotionVectorResourceBarrier", MVResourceBarrier },
+        { "Hotfix", "DepthResourceBarrier", DepthResourceBarrier },
+        { "Hotfix", "ColorMaskResourceBarrier", MaskResourceBarrier },
+        { "Hotfix", "ExposureResourceBarrier", ExposureResourceBarrier },
+        { "Hotfix", "OutputResourceBarrier", OutputResourceBarrier },
+        { "Hotfix", "DontCreateD3D12DeviceForLuma", DontCreateD3D12DeviceForLuma },
+
+        // Dx11withDx12
+        { "Dx11withDx12", "DontUseNTShared", DontUseNTShared },
+
+        // NvApi
+        { "NvApi", "DisableFlipMetering", DisableFlipMetering },
+
+        // Spoofing
+        { "Spoofing", "Dxgi", DxgiSpoofing },
+        { "Spoofing", "DxgiFactoryWrapping", DxgiFactoryWrapping },
+        { "Spoofing", "DxgiBlacklist", DxgiBlacklist },
+        { "Spoofing", "DxgiVRAM", DxgiVRAM },
+        { "Spoofing", "Vulkan", VulkanSpoofing },
+        { "Spoofing", "VulkanExtensionSpoofing", VulkanExtensionSpoofing },
+        { "Spoofing", "VulkanVRAM", VulkanVRAM },
+        { "Spoofing", "SpoofedGPUName", SpoofedGPUName },
+        { "Spoofing", "StreamlineSpoofing", StreamlineSpoofing },
+        { "Spoofing", "SpoofHAGS", SpoofHAGS },
+        { "Spoofing", "D3DFeatureLevel", SpoofFeatureLevel },
+        { "Spoofing", "UEIntelAtomics", UESpoofIntelAtomics64 },
+        { "Spoofing", "Registry", SpoofRegistry },
+        { "Spoofing", "RegistryDriver", SpoofedDriver },
+        { "Spoofing", "User32", SpoofUser32 },
+
+        // fakenvapi
+        { "fakenvapi", "UseFakenvapi", UseFakenvapi },
+        { "fakenvapi", "ForceXeLL", ForceXeLL },
+        { "fakenvapi", "ForceLatencyFlex", FN_ForceLatencyFlex },
+        { "fakenvapi", "GpuTimestamps", FN_GpuTimestamps },
+
+        // Inputs
+        { "Inputs", "EnableDlssInputs", EnableDlssInputs },
+        { "Inputs", "EnableXeSSInputs", EnableXeSSInputs },
+        { "Inputs", "EnableFsr2Inputs", EnableFsr2Inputs },
+        { "Inputs", "UseFsr2Inputs", UseFsr2Inputs },
+        { "Inputs", "UseFsr2Dx11Inputs", UseFsr2Dx11Inputs },
+        { "Inputs", "UseFsr2VulkanInputs", UseFsr2VulkanInputs },
+        { "Inputs", "Fsr2Pattern", Fsr2Pattern },
+        { "Inputs", "EnableFsr3Inputs", EnableFsr3Inputs },
+        { "Inputs", "UseFsr3Inputs", UseFsr3Inputs },
+        { "Inputs", "Fsr3Pattern", Fsr3Pattern },
+        { "Inputs", "EnableFfxInputs", EnableFfxInputs },
+        { "Inputs", "UseFfxInputs", UseFfxInputs },
+        { "Inputs", "EnableHotSwapping", EnableHotSwapping },
+
+        // Plugins
+        { "Plugins", "Path", PluginPath },
+        { "Plugins", "LoadSpecialK", LoadSpecialK },
+        { "Plugins", "LoadReShade", LoadReShade },
+        { "Plugins", "LoadAsiPlugins", LoadAsiPlugins },
+
+        // V-Sync
+        { "V-Sync", "OverrideVsync", OverrideVsync },
+        { "V-Sync", "ForceVsync", ForceVsync },
+        { "V-Sync", "SyncInterval", VsyncInterval },
+
+        // Libraries
+        { "Libraries", "OptiDllPath", MainDllPath },
+        { "Libraries", "NvngxPath", NvngxPath },
+        { "Libraries", "NvngxDlssPath", NVNGX_DLSS_Library },
+        { "Libraries", "NvngxFeaturePath", DLSSFeaturePath },
+        { "Libraries", "NvapiPath", NvapiDllPath },
+        { "Libraries", "FfxDx12Path", FfxDx12Path },
+        { "Libraries", "FfxDx12SRPath", FfxDx12SRPath },
+        { "Libraries", "FfxDx12FGPath", FfxDx12FGPath },
+        { "Libraries", "FfxDx12RRPath", FfxDx12RRPath },
+        { "Libraries", "FfxDx12RCPath", FfxDx12RCPath },
+        { "Libraries", "FfxVkPath", FfxVkPath },
+        { "Libraries", "XeSSDx11Path", XeSSDx11Library },
+    };
 }
 
 bool Config::Reload(std::filesystem::path iniPath)
 {
     auto pathWStr = iniPath.wstring();
 
+    std::scoped_lock lock(iniMutex);
+
     LOG_INFO("Trying to load ini from: {0}", wstring_to_string(pathWStr));
-    if (ini.LoadFile(iniPath.c_str()) == SI_OK)
+    if (ini.LoadFile(iniPath))
     {
         State::Instance().nvngxIniDetected = exists(iniPath.parent_path() / "nvngx.ini");
         _log.clear();
 
+        // Hand written options below can depend on these
+        for (const auto& option : _schema)
+        {
+            std::string value = ini.GetValue(option.Section(), option.Key(), "auto");
+
+            if (!ConfigText::IsAuto(value))
+                _log.push_back(std::format("{}.{}: {}", option.Section(), option.Key(), value));
+
+            option.Load(value);
+        }
+
         // Upscalers
         {
             // transform converts only when optional has a  value
@@ -66,9 +408,6 @@ bool Config::Reload(std::filesystem::path iniPath)
 
         // Frame Generation
         {
-            FGEnabled.set_from_config(readBool("FrameGen", "Enabled"));
-            FGDebugView.set_from_config(readBool("FrameGen", "DebugView"));
-
             if (auto FGInputString = readString("FrameGen", "FGInput"); FGInputString.has_value())
             {
                 if (lstrcmpiA(FGInputString.value().c_str(), "nofg") == 0)
@@ -120,156 +459,31 @@ bool Config::Reload(std::filesystem::path iniPath)
                 FTInput.set_from_config(static_cast<FrameTimeSource>(ftInput.value()));
             }
 
-            FGDrawUIOverFG.set_from_config(readBool("FrameGen", "DrawUIOverFG"));
-            FGUIPremultipliedAlpha.set_from_config(readBool("FrameGen", "UIPremultipliedAlpha"));
-            FGDisableHudless.set_from_config(readBool("FrameGen", "DisableHudless"));
-            FGDisableUI.set_from_config(readBool("FrameGen", "DisableUI"));
-            FGSkipReset.set_from_config(readBool("FrameGen", "SkipReset"));
-            FGRectLeft.set_from_config(readInt("FrameGen", "RectLeft"));
-            FGRectTop.set_from_config(readInt("FrameGen", "RectTop"));
-            FGRectWidth.set_from_config(readInt("FrameGen", "RectWidth"));
-            FGRectHeight.set_from_config(readInt("FrameGen", "RectHeight"));
-
-            FGAllowedFrameAhead.set_from_config(readInt("FrameGen", "AllowedFrameAhead"));
             if (FGAllowedFrameAhead.has_value() && (FGAllowedFrameAhead.value() < 1 || FGAllowedFrameAhead.value() > 3))
                 FGAllowedFrameAhead.reset();
-
-            FGDepthValidNow.set_from_config(readBool("FrameGen", "DepthValidNow"));
-            FGVelocityValidNow.set_from_config(readBool("FrameGen", "VelocityValidNow"));
-            FGHudlessValidNow.set_from_config(readBool("FrameGen", "HudlessValidNow"));
-            FGOnlyAcceptFirstHudless.set_from_config(readBool("FrameGen", "OnlyAcceptFirstHudless"));
-            FGPreserveSwapChain.set_from_config(readBool("FrameGen", "PreserveSwapChain"));
-            FGSkipResizeBuffers.set_from_config(readBool("FrameGen", "SkipResizeBuffers"));
-            FGModifyBufferState.set_from_config(readBool("FrameGen", "ModifyBufferState"));
-            FGModifySCIndex.set_from_config(readBool("FrameGen", "ModifySCIndex"));
-            FGHudCutoff.set_from_config(readFloat("FrameGen", "HudCutoff"));
-        }
-
-        // FSR FG
-        {
-            FGDebugTearLines.set_from_config(readBool("FSRFG", "DebugTearLines"));
-            FGDebugResetLines.set_from_config(readBool("FSRFG", "DebugResetLines"));
-            FGDebugPacingLines.set_from_config(readBool("FSRFG", "DebugPacingLines"));
-            FGAsync.set_from_config(readBool("FSRFG", "AllowAsync"));
-            FGUseMutexForSwapchain.set_from_config(readBool("FSRFG", "UseMutexForSwapchain"));
-            FGFramePacingTuning.set_from_config(readBool("FSRFG", "FramePacingTuning"));
-            FGFPTSafetyMarginInMs.set_from_config(readFloat("FSRFG", "FPTSafetyMarginInMs"));
-            FGFPTVarianceFactor.set_from_config(readFloat("FSRFG", "FPTVarianceFactor"));
-            FGFPTAllowHybridSpin.set_from_config(readBool("FSRFG", "FPTHybridSpin"));
-            FGFPTHybridSpinTime.set_from_config(readInt("FSRFG", "FPTHybridSpinTime"));
-            FGFPTAllowWaitForSingleObjectOnFence.set_from_config(readBool("FSRFG", "FPTWaitForSingleObjectOnFence"));
-            FSRFGEnableWatermark.set_from_config(readBool("FSRFG", "EnableWatermark"));
-        }
-
-        // OptiFG
-        {
-            FGDisableHUDFix.set_from_config(readBool("OptiFG", "DisableHUDFix"));
-            FGHUDFix.set_from_config(readBool("OptiFG", "HUDFix"));
-            FGHUDLimit.set_from_config(readInt("OptiFG", "HUDLimit"));
-            FGHUDFixExtended.set_from_config(readBool("OptiFG", "HUDFixExtended"));
-            FGImmediateCapture.set_from_config(readBool("OptiFG", "HUDFixImmediate"));
-            FGUseShards.set_from_config(readBool("OptiFG", "UseShards"));
-            FGAlwaysTrackHeaps.set_from_config(readBool("OptiFG", "AlwaysTrackHeaps"));
-            FGResourceBlocking.set_from_config(readBool("OptiFG", "ResourceBlocking"));
-            FGMakeDepthCopy.set_from_config(readBool("OptiFG", "MakeDepthCopy"));
-            FGMakeMVCopy.set_from_config(readBool("OptiFG", "MakeMVCopy"));
-            FGHudfixDisableRTV.set_from_config(readBool("OptiFG", "HudfixDisableRTV"));
-            FGHudfixDisableSRV.set_from_config(readBool("OptiFG", "HudfixDisableSRV"));
-            FGHudfixDisableUAV.set_from_config(readBool("OptiFG", "HudfixDisableUAV"));
-            FGHudfixDisableOM.set_from_config(readBool("OptiFG", "HudfixDisableOM"));
-            FGHudfixDisableDispatch.set_from_config(readBool("OptiFG", "HudfixDisableDispatch"));
-            FGHudfixDisableDI.set_from_config(readBool("OptiFG", "HudfixDisableDI"));
-            FGHudfixDisableDII.set_from_config(readBool("OptiFG", "HudfixDisableDII"));
-            FGHudfixDisableSCR.set_from_config(readBool("OptiFG", "HudfixDisableSCR"));
-            FGHudfixDisableSGR.set_from_config(readBool("OptiFG", "HudfixDisableSGR"));
-
-            FGEnableDepthScale.set_from_config(readBool("OptiFG", "EnableDepthScale"));
-            FGDepthScaleMax.set_from_config(readFloat("OptiFG", "DepthScaleMax"));
-
-            FGDontUseSwapchainBuffers.set_from_config(readBool("OptiFG", "HUDFixDontUseSwapchainBuffers"));
-            FGRelaxedResolutionCheck.set_from_config(readBool("OptiFG", "HUDFixRelaxedResolutionCheck"));
-
-            FGResourceFlip.set_from_config(readBool("OptiFG", "ResourceFlip"));
-            FGResourceFlipOffset.set_from_config(readBool("OptiFG", "ResourceFlipOffset"));
-
-            FGAlwaysCaptureFSRFGSwapchain.set_from_config(readBool("OptiFG", "AlwaysCaptureFSRFGSwapchain"));
         }
 
         {
-            FGXeFGInterpolationCount.set_from_config(readInt("XeFG", "InterpolationCount"));
             if (FGXeFGInterpolationCount.has_value() &&
                 (FGXeFGInterpolationCount.value() < 1 || FGXeFGInterpolationCount.value() > 3))
                 FGXeFGInterpolationCount.reset();
-
-            FGXeFGIgnoreInitChecks.set_from_config(readBool("XeFG", "IgnoreInitChecks"));
-            FGXeFGUIComposition.set_from_config(readBool("XeFG", "UIComposition"));
-            FGXeFGDepthInverted.set_from_config(readBool("XeFG", "DepthInverted"));
-            FGXeFGJitteredMV.set_from_config(readBool("XeFG", "JitteredMV"));
-            FGXeFGHighResMV.set_from_config(readBool("XeFG", "HighResMV"));
-            FGXeFGDebugView.set_from_config(readBool("XeFG", "DebugView"));
-            FGXeFGForceBorderless.set_from_config(readBool("XeFG", "ForceBorderless"));
         }
 
         {
-            FGDLSSGInterpolationCount.set_from_config(readInt("DLSSG", "InterpolationCount"));
             if (FGDLSSGInterpolationCount.has_value() &&
                 (FGDLSSGInterpolationCount.value() < 1 || FGDLSSGInterpolationCount.value() > 6))
                 FGDLSSGInterpolationCount.reset();
 
-            FGDLSSGUseGamesReflexMarkers.set_from_config(readBool("DLSSG", "UseGamesReflexMarkers"));
-
-            FGDLSSGOverrideInterpolationCount.set_from_config(readInt("DLSSG", "OverrideInterpolationCount"));
             if (FGDLSSGOverrideInterpolationCount.has_value() &&
                 (FGDLSSGOverrideInterpolationCount.value() < 1 || FGDLSSGOverrideInterpolationCount.value() > 6))
                 FGDLSSGOverrideInterpolationCount.reset();
-
-            FGDLSSGFramerateTargetDMFG.set_from_config(readFloat("DLSSG", "FramerateTargetDMFG"));
-            FGDLSSGOverrideForceDMFG.set_from_config(readBool("DLSSG", "OverrideForceDMFG"));
-        }
-
-        // FSR FG Inputs
-        {
-            FSRFGSkipConfigForHudless.set_from_config(readBool("FSRFGInputs", "SkipConfigForHudless"));
-            FSRFGSkipDispatchForHudless.set_from_config(readBool("FSRFGInputs", "SkipDispatchForHudless"));
-        }
-
-        // Framerate
-        {
-            FramerateLimit.set_from_config(readFloat("Framerate", "FramerateLimit"));
-        }
-
-        // FSR Common
-        {
-            FsrVerticalFov.set_from_config(readFloat("FSR", "VerticalFov"));
-            FsrHorizontalFov.set_from_config(readFloat("FSR", "HorizontalFov"));
-            FsrCameraNear.set_from_config(readFloat("FSR", "CameraNear"));
-            FsrCameraFar.set_from_config(readFloat("FSR", "CameraFar"));
-            FsrUseFsrInputValues.set_from_config(readBool("FSR", "UseFsrInputValues"));
         }
 
         // FSR
         {
-            FsrVelocity.set_from_config(readFloat("FSR", "VelocityFactor"));
-            FsrReactiveScale.set_from_config(readFloat("FSR", "ReactiveScale"));
-            FsrShadingScale.set_from_config(readFloat("FSR", "ShadingScale"));
-            FsrAccAddPerFrame.set_from_config(readFloat("FSR", "AccAddPerFrame"));
-            FsrMinDisOccAcc.set_from_config(readFloat("FSR", "MinDisOccAcc"));
-            FsrDebugView.set_from_config(readBool("FSR", "DebugView"));
-            FfxUpscalerIndex.set_from_config(readInt("FSR", "UpscalerIndex"));
-            FfxFGIndex.set_from_config(readInt("FSR", "FGIndex"));
-            FsrUseMaskForTransparency.set_from_config(readBool("FSR", "UseReactiveMaskForTransparency"));
-            DlssReactiveMaskBias.set_from_config(readFloat("FSR", "DlssReactiveMaskBias"));
-            Fsr4ForceCapable.set_from_config(readBool("FSR", "Fsr4ForceCapable"));
-            Fsr4EnableWatermark.set_from_config(readBool("FSR", "Fsr4EnableWatermark"));
-
             if (auto setting = readInt("FSR", "Fsr4Model"); setting.has_value() && setting >= 0 && setting <= 5)
                 Fsr4Model.set_from_config(setting);
 
-            FsrNonLinearColorSpace.set_from_config(readBool("FSR", "FsrNonLinearColorSpace"));
-            FsrNonLinearPQ.set_from_config(readBool("FSR", "FsrNonLinearPQ"));
-            FsrNonLinearSRGB.set_from_config(readBool("FSR", "FsrNonLinearSRGB"));
-            FsrAgilitySDKUpgrade.set_from_config(readBool("FSR", "FsrAgilitySDKUpgrade"));
-
             // Only sRGB or PQ should be enabled
             if (FsrNonLinearPQ.has_value() && FsrNonLinearPQ.value())
                 FsrNonLinearSRGB.reset();
@@ -280,21 +494,8 @@ bool Config::Reload(std::filesystem::path iniPath)
                 FsrNonLinearColorSpace.set_volatile_value(true);
         }
 
-        // XeSS
-        {
-            BuildPipelines.set_from_config(readBool("XeSS", "BuildPipelines"));
-            NetworkModel.set_from_config(readInt("XeSS", "NetworkModel"));
-            CreateHeaps.set_from_config(readBool("XeSS", "CreateHeaps"));
-        }
-
         // DLSS
         {
-            // Don't enable again if set false because of no nvngx found
-            DLSSEnabled.set_from_config(readBool("DLSS", "Enabled"));
-            UseGenericAppIdWithDlss.set_from_config(readBool("DLSS", "UseGenericAppIdWithDlss"));
-
-            RenderPresetOverride.set_from_config(readBool("DLSS", "RenderPresetOverride"));
-
             constexpr size_t presetCount = 17;
 
             if (auto setting = readInt("DLSS", "RenderPresetForAll");
@@ -325,11 +526,9 @@ bool Config::Reload(std::filesystem::path iniPath)
                 setting.has_value() && setting >= 0 && (setting < presetCount || setting == NV_PRESET_LATEST))
                 RenderPresetUltraPerformance.set_from_config(setting);
         }
+
         // DLSSD
         {
-            // Don't enable again if set false because of no nvngx found
-            DLSSDRenderPresetOverride.set_from_config(readBool("DLSSD", "RenderPresetOverride"));
-
             constexpr size_t presetCount = 6;
 
             if (auto setting = readInt("DLSSD", "RenderPresetForAll");
@@ -368,16 +567,7 @@ bool Config::Reload(std::filesystem::path iniPath)
 
         // Logging
         {
-            LogToFile.set_from_config(readBool("Log", "LogToFile"));
-            LogLevel.set_from_config(readInt("Log", "LogLevel"));
-            LogToConsole.set_from_config(readBool("Log", "LogToConsole"));
-            LogToDebug.set_from_config(readBool("Log", "LogToDebug"));
-            LogToNGX.set_from_config(readBool("Log", "LogToNGX"));
-            OpenConsole.set_from_config(readBool("Log", "OpenConsole"));
             DebugWait.set_from_config(readBool("Log", "DebugWait"));
-            LogSingleFile.set_from_config(readBool("Log", "SingleFile"));
-            LogAsync.set_from_config(readBool("Log", "LogAsync"));
-            LogAsyncThreads.set_from_config(readInt("Log", "LogAsyncThreads"));
 
             {
                 auto setting = readString("Log", "LogFileName", false);
@@ -413,27 +603,11 @@ bool Config::Reload(std::filesystem::path iniPath)
         // Sharpness
         {
             SharpnessShader.set_from_config(readString("Sharpness", "Shader", true).transform(CodeToSharpnessShader));
-            OverrideSharpness.set_from_config(readBool("Sharpness", "OverrideSharpness"));
-
-            if (auto setting = readFloat("Sharpness", "Sharpness"); setting.has_value())
-                Sharpness.set_from_config(std::clamp(setting.value(), 0.0f, 1.3f));
         }
 
         // Menu
         {
-            if (auto setting = readFloat("Menu", "Scale"); setting.has_value())
-                MenuScale.set_from_config(std::clamp(setting.value(), 0.5f, 2.0f));
-
-            // Don't enable again if set false because of Linux issue
-            OverlayMenu.set_from_config(readBool("Menu", "OverlayMenu"));
             ShortcutKey.set_from_config(readInt("Menu", "ShortcutKey"));
-            ExtendedLimits.set_from_config(readBool("Menu", "ExtendedLimits"));
-            ShowFps.set_from_config(readBool("Menu", "ShowFps"));
-            UseHQFont.set_from_config(readBool("Menu", "UseHQFont"));
-            DisableSplash.set_from_config(readBool("Menu", "DisableSplash"));
-
-            if (auto setting = readInt("Menu", "FpsOverlayPos"); setting.has_value())
-                FpsOverlayPos.set_from_config(std::clamp(setting.value(), 0, 3));
 
             if (auto setting = readUInt("Menu", "FpsOverlayType"); setting.has_value())
             {
@@ -443,101 +617,24 @@ bool Config::Reload(std::filesystem::path iniPath)
 
             FpsShortcutKey.set_from_config(readInt("Menu", "FpsShortcutKey"));
             FpsCycleShortcutKey.set_from_config(readInt("Menu", "FpsCycleShortcutKey"));
-            FpsOverlayHorizontal.set_from_config(readBool("Menu", "FpsOverlayHorizontal"));
-
-            if (auto setting = readFloat("Menu", "FpsOverlayAlpha"); setting.has_value())
-                FpsOverlayAlpha.set_from_config(std::clamp(setting.value(), 0.0f, 1.0f));
-
-            if (auto setting = readFloat("Menu", "FpsScale"); setting.has_value())
-                FpsScale.set_from_config(std::clamp(setting.value(), 0.5f, 2.0f));
-
-            FontSize.set_from_config(readFloat("Menu", "FontSize"));
-            TTFFontPath.set_from_config(readWString("Menu", "TTFFontPath"));
 
             FGShortcutKey.set_from_config(readInt("Menu", "FGShortcutKey"));
 
-            LightTheme.set_from_config(readBool("Menu", "LightTheme"));
             MenuAccentColorR.set_from_config(readFloat("Menu", "AccentColorR"));
             MenuAccentColorG.set_from_config(readFloat("Menu", "AccentColorG"));
             MenuAccentColorB.set_from_config(readFloat("Menu", "AccentColorB"));
         }
 
-        // Hooks
-        {
-            HookOriginalNvngxOnly.set_from_config(readBool("Hooks", "HookOriginalNvngxOnly"));
-            EarlyHooking.set_from_config(readBool("Hooks", "EarlyHooking"));
-            UseNtdllHooks.set_from_config(readBool("Hooks", "UseNtdllHooks"));
-        }
-
-        // RCAS
-        {
-            RcasEnabled.set_from_config(readBool("CAS", "Enabled"));
-
-            MotionSharpnessEnabled.set_from_config(readBool("CAS", "MotionSharpnessEnabled"));
-
-            if (auto setting = readFloat("CAS", "MotionSharpness"); setting.has_value())
-                MotionSharpness.set_from_config(std::clamp(setting.value(), -1.3f, 1.3f));
-
-            if (auto setting = readFloat("CAS", "MotionThreshold"); setting.has_value())
-                MotionThreshold.set_from_config(std::clamp(setting.value(), 0.0f, 100.0f));
-
-            if (auto setting = readFloat("CAS", "MotionScaleLimit"); setting.has_value())
-                MotionScaleLimit.set_from_config(std::clamp(setting.value(), 0.01f, 100.0f));
-
-            ContrastEnabled.set_from_config(readBool("CAS", "ContrastEnabled"));
-            if (auto setting = readFloat("CAS", "Contrast"); setting.has_value())
-                Contrast.set_from_config(std::clamp(setting.value(), -2.0f, 2.0f));
-
-            DADepthScale.set_from_config(readFloat("CAS", "DADepthScale"));
-            DADepthBias.set_from_config(readFloat("CAS", "DADepthBias"));
-            DAClampOutput.set_from_config(readBool("CAS", "DAClampOutput"));
-
-            MotionSharpnessDebug.set_from_config(readBool("CAS", "SharpenerDebug"));
-        }
-
         // Output Scaling
         {
-            OutputScalingEnabled.set_from_config(readBool("OutputScaling", "Enabled"));
-
             if (auto v = readEnum<Scaler>("OutputScaling", "Downscaler"))
                 OutputScalingDownscaler.set_from_config(*v);
             else
                 OutputScalingDownscaler.reset();
-
-            if (auto setting = readFloat("OutputScaling", "Multiplier"); setting.has_value())
-                OutputScalingMultiplier.set_from_config(std::clamp(setting.value(), 0.5f, 3.0f));
-        }
-
-        // Init Flags
-        {
-            AutoExposure.set_from_config(readBool("InitFlags", "AutoExposure"));
-            HDR.set_from_config(readBool("InitFlags", "HDR"));
-            DepthInverted.set_from_config(readBool("InitFlags", "DepthInverted"));
-            JitterCancellation.set_from_config(readBool("InitFlags", "JitterCancellation"));
-            DisplayResolution.set_from_config(readBool("InitFlags", "DisplayResolution"));
-            DisableReactiveMask.set_from_config(readBool("InitFlags", "DisableReactiveMask"));
-        }
-
-        // DRS
-        {
-            DrsMinOverrideEnabled.set_from_config(readBool("DRS", "DrsMinOverrideEnabled"));
-            DrsMaxOverrideEnabled.set_from_config(readBool("DRS", "DrsMaxOverrideEnabled"));
-        }
-
-        // Upscale Ratio Override
-        {
-            UpscaleRatioOverrideEnabled.set_from_config(readBool("UpscaleRatio", "UpscaleRatioOverrideEnabled"));
-            UpscaleRatioOverrideValue.set_from_config(readFloat("UpscaleRatio", "UpscaleRatioOverrideValue"));
         }
 
         // Quality Overrides
         {
-            QualityRatioOverrideEnabled.set_from_config(readBool("QualityOverrides", "QualityRatioOverrideEnabled"));
-            QualityRatio_DLAA.set_from_config(readFloat("QualityOverrides", "QualityRatioDLAA"));
-            QualityRatio_UltraQuality.set_from_config(readFloat("QualityOverrides", "QualityRatioUltraQuality"));
-            QualityRatio_Quality.set_from_config(readFloat("QualityOverrides", "QualityRatioQuality"));
-            QualityRatio_Balanced.set_from_config(readFloat("QualityOverrides", "QualityRatioBalanced"));
-            QualityRatio_Performance.set_from_config(readFloat("QualityOverrides", "QualityRatioPerformance"));
             QualityRatio_UltraPerformance.set_from_config(
                 readFloat("QualityOverrides", "QualityRatioUltraPerformance"));
         }
@@ -551,7 +648,6 @@ bool Config::Reload(std::filesystem::path iniPath)
             if (AnisotropyOverride.has_value() && (AnisotropyOverride.value() > 16 || AnisotropyOverride.value() < 1))
                 AnisotropyOverride.reset();
 
-            AnisotropySkipPointFilter.set_from_config(readBool("Anisotropy", "SkipPointFilter"));
             AnisotropyModifyComp.set_from_config(readBool("Anisotropy", "AFModifyComparison"));
             AnisotropyModifyMinMax.set_from_config(readBool("Anisotropy", "AFModifyMinMax"));
         }
@@ -567,72 +663,19 @@ bool Config::Reload(std::filesystem::path iniPath)
             if (MipmapBiasOverride.has_value() &&
                 (MipmapBiasOverride.value() > 15.0 || MipmapBiasOverride.value() < -15.0))
                 MipmapBiasOverride.reset();
-
-            MipmapBiasFixedOverride.set_from_config(readBool("Mipmap", "MipmapBiasFixedOverride"));
-            MipmapBiasScaleOverride.set_from_config(readBool("Mipmap", "MipmapBiasScaleOverride"));
-            MipmapBiasOverrideAll.set_from_config(readBool("Mipmap", "MipmapBiasOverrideAll"));
-        }
-
-        // Process Filter
-        {
-            ProcessExclusionList.set_from_config(readWString("ProcessFilter", "ProcessExclusionList", true));
-            TargetProcess.set_from_config(readWString("ProcessFilter", "TargetProcessName", true));
-        }
-
-        // Hotfixes
-        {
-            CheckForUpdate.set_from_config(readBool("Hotfix", "CheckForUpdate"));
-            DisableOverlays.set_from_config(readBool("Hotfix", "DisableOverlays"));
-
-            RoundInternalResolution.set_from_config(readInt("Hotfix", "RoundInternalResolution"));
-
-            RestoreComputeSignature.set_from_config(readBool("Hotfix", "RestoreComputeSignature"));
-            RestoreGraphicSignature.set_from_config(readBool("Hotfix", "RestoreGraphicSignature"));
-            PreferDedicatedGpu.set_from_config(readBool("Hotfix", "PreferDedicatedGpu"));
-            PreferFirstDedicatedGpu.set_from_config(readBool("Hotfix", "PreferFirstDedicatedGpu"));
-            SkipFirstFrames.set_from_config(readInt("Hotfix", "SkipFirstFrames"));
-            UsePrecompiledShaders.set_from_config(readBool("Hotfix", "UsePrecompiledShaders"));
-            ColorResourceBarrier.set_from_config(readInt("Hotfix", "ColorResourceBarrier"));
-            MVResourceBarrier.set_from_config(readInt("Hotfix", "MotionVectorResourceBarrier"));
-            DepthResourceBarrier.set_from_config(readInt("Hotfix", "DepthResourceBarrier"));
-            MaskResourceBarrier.set_from_config(readInt("Hotfix", "ColorMaskResourceBarrier"));
-            ExposureResourceBarrier.set_from_config(readInt("Hotfix", "ExposureResourceBarrier"));
-            OutputResourceBarrier.set_from_config(readInt("Hotfix", "OutputResourceBarrier"));
-            DontCreateD3D12DeviceForLuma.set_from_config(readBool("Hotfix", "DontCreateD3D12DeviceForLuma"));
         }
 
         // Dx11 with Dx12
         {
             Dx11DelayedInit.set_from_config(readInt("Dx11withDx12", "UseDelayedInit"));
-            DontUseNTShared.set_from_config(readBool("Dx11withDx12", "DontUseNTShared"));
-        }
-
-        // NvApi
-        {
-            DisableFlipMetering.set_from_config(readBool("NvApi", "DisableFlipMetering"));
         }
 
         // Spoofing
         {
-            DxgiSpoofing.set_from_config(readBool("Spoofing", "Dxgi"));
-            DxgiFactoryWrapping.set_from_config(readBool("Spoofing", "DxgiFactoryWrapping"));
-            DxgiBlacklist.set_from_config(readString("Spoofing", "DxgiBlacklist"));
-            DxgiVRAM.set_from_config(readInt("Spoofing", "DxgiVRAM"));
-            VulkanSpoofing.set_from_config(readBool("Spoofing", "Vulkan"));
-            VulkanExtensionSpoofing.set_from_config(readBool("Spoofing", "VulkanExtensionSpoofing"));
-            VulkanVRAM.set_from_config(readInt("Spoofing", "VulkanVRAM"));
-            SpoofedGPUName.set_from_config(readWString("Spoofing", "SpoofedGPUName"));
-            StreamlineSpoofing.set_from_config(readBool("Spoofing", "StreamlineSpoofing"));
-            SpoofHAGS.set_from_config(readBool("Spoofing", "SpoofHAGS"));
-            SpoofFeatureLevel.set_from_config(readBool("Spoofing", "D3DFeatureLevel"));
             SpoofedVendorId.set_from_config(readUInt("Spoofing", "SpoofedVendorId"));
             SpoofedDeviceId.set_from_config(readUInt("Spoofing", "SpoofedDeviceId"));
             TargetVendorId.set_from_config(readUInt("Spoofing", "TargetVendorId"));
             TargetDeviceId.set_from_config(readUInt("Spoofing", "TargetDeviceId"));
-            UESpoofIntelAtomics64.set_from_config(readBool("Spoofing", "UEIntelAtomics"));
-            SpoofRegistry.set_from_config(readBool("Spoofing", "Registry"));
-            SpoofedDriver.set_from_config(readWString("Spoofing", "RegistryDriver"));
-            SpoofUser32.set_from_config(readBool("Spoofing", "User32"));
 
             // Enable HAGS when DLSS-G will be used
             if (!SpoofHAGS.has_value())
@@ -645,10 +688,6 @@ bool Config::Reload(std::filesystem::path iniPath)
 
         // fakenvapi
         {
-            UseFakenvapi.set_from_config(readBool("fakenvapi", "UseFakenvapi"));
-            ForceXeLL.set_from_config(readBool("fakenvapi", "ForceXeLL"));
-            FN_ForceLatencyFlex.set_from_config(readBool("fakenvapi", "ForceLatencyFlex"));
-
             if (auto v = readEnum<LFXMode>("fakenvapi", "LatencyFlexMode"))
                 FN_LatencyFlexMode.set_from_config(*v);
             else
@@ -664,34 +703,6 @@ bool Config::Reload(std::filesystem::path iniPath)
                 FN_ForceReflex.set_volatile_value(ForceReflex::ForceDisable);
         }
 
-        // Inputs
-        {
-            EnableDlssInputs.set_from_config(readBool("Inputs", "EnableDlssInputs"));
-            EnableXeSSInputs.set_from_config(readBool("Inputs", "EnableXeSSInputs"));
-
-            EnableFsr2Inputs.set_from_config(readBool("Inputs", "EnableFsr2Inputs"));
-            UseFsr2Inputs.set_from_config(readBool("Inputs", "UseFsr2Inputs"));
-            UseFsr2Dx11Inputs.set_from_config(readBool("Inputs", "UseFsr2Dx11Inputs"));
-            UseFsr2VulkanInputs.set_from_config(readBool("Inputs", "UseFsr2VulkanInputs"));
-            Fsr2Pattern.set_from_config(readBool("Inputs", "Fsr2Pattern"));
-
-            EnableFsr3Inputs.set_from_config(readBool("Inputs", "EnableFsr3Inputs"));
-            UseFsr3Inputs.set_from_config(readBool("Inputs", "UseFsr3Inputs"));
-            Fsr3Pattern.set_from_config(readBool("Inputs", "Fsr3Pattern"));
-
-            EnableFfxInputs.set_from_config(readBool("Inputs", "EnableFfxInputs"));
-            UseFfxInputs.set_from_config(readBool("Inputs", "UseFfxInputs"));
-            EnableHotSwapping.set_from_config(readBool("Inputs", "EnableHotSwapping"));
-        }
-
-        // Plugins
-        {
-            PluginPath.set_from_config(readWString("Plugins", "Path"));
-            LoadSpecialK.set_from_config(readBool("Plugins", "LoadSpecialK"));
-            LoadReShade.set_from_config(readBool("Plugins", "LoadReShade"));
-            LoadAsiPlugins.set_from_config(readBool("Plugins", "LoadAsiPlugins"));
-        }
-
         // HDR
         {
             ForceHDR.set_from_config(readBool("HDR", "ForceHDR"));
@@ -699,35 +710,25 @@ bool Config::Reload(std::filesystem::path iniPath)
             SkipColorSpace.set_from_config(readBool("HDR", "SkipColorSpace"));
         }
 
-        // V-Sync
-        {
-            OverrideVsync.set_from_config(readBool("V-Sync", "OverrideVsync"));
-            ForceVsync.set_from_config(readBool("V-Sync", "ForceVsync"));
-            VsyncInterval.set_from_config(readInt("V-Sync", "SyncInterval"));
-        }
-
         // Libraries
         {
-            MainDllPath.set_from_config(readWString("Libraries", "OptiDllPath"));
-
-            NvngxPath.set_from_config(readWString("Libraries", "NvngxPath"));
-            NVNGX_DLSS_Library.set_from_config(readWString("Libraries", "NvngxDlssPath"));
-            DLSSFeaturePath.set_from_config(readWString("Libraries", "NvngxFeaturePath"));
-            NvapiDllPath.set_from_config(readWString("Libraries", "NvapiPath"));
-
-            FfxDx12Path.set_from_config(readWString("Libraries", "FfxDx12Path"));
-            FfxDx12SRPath.set_from_config(readWString("Libraries", "FfxDx12SRPath"));
-            FfxDx12FGPath.set_from_config(readWString("Libraries", "FfxDx12FGPath"));
-            FfxDx12RRPath.set_from_config(readWString("Libraries", "FfxDx12RRPath"));
-            FfxDx12RCPath.set_from_config(readWString("Libraries", "FfxDx12RCPath"));
-            FfxVkPath.set_from_config(readWString("Libraries", "FfxVkPath"));
-
             XeSSLibrary.set_from_config(readWString("Libraries", "XeSSPath"));
             XeSSLibrary.set_from_config(readWString("Libraries", "XeFGPath"));
             XeSSLibrary.set_from_config(readWString("Libraries", "XeLLPath"));
-            XeSSDx11Library.set_from_config(readWString("Libraries", "XeSSDx11Path"));
         }
 
+        _generation++;
+
+        // Values as they are in the file, only the ones changed after this point get saved.
+        // Menu changes which were waiting for the delayed save stay queued.
+        ini.ClearSaved();
+        snapshotValues = true;
+        WriteValues();
+        snapshotValues = false;
+
+        std::error_code ec;
+        _iniWriteTime = std::filesystem::last_write_time(iniPath, ec);
+
         return true;
     }
 
@@ -788,8 +789,11 @@ std::string GetFloatValue(std::optional<float> value)
     return std::to_string(value.value());
 }
 
-bool Config::SaveIni()
+void Config::WriteValues()
 {
+    for (const auto& option : _schema)
+        SetIniValue(option.Section(), option.Key(), option.Text().c_str());
+
     // Upscalers
     {
         auto SaveUpscaler = [&](const char* key, auto& upscalerSetting)
@@ -798,20 +802,18 @@ bool Config::SaveIni()
                                     .transform(UpscalerToCode) // Turn enum into string
                                     .value_or("auto");
 
-            ini.SetValue("Upscalers", key, value.c_str());
+            SetIniValue("Upscalers", key, value.c_str());
         };
 
-        SaveUpscaler("Dx11Upscaler", Instance()->Dx11Upscaler);
-        SaveUpscaler("Dx12Upscaler", Instance()->Dx12Upscaler);
-        SaveUpscaler("VulkanUpscaler", Instance()->VulkanUpscaler);
+        SaveUpscaler("Dx11Upscaler", Dx11Upscaler);
+        SaveUpscaler("Dx12Upscaler", Dx12Upscaler);
+        SaveUpscaler("VulkanUpscaler", VulkanUpscaler);
     }
 
     // Frame Generation
     {
-        ini.SetValue("FrameGen", "Enabled", GetBoolValue(Instance()->FGEnabled.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "DebugView", GetBoolValue(Instance()->FGDebugView.value_for_config()).c_str());
         std::string FGInputString = "auto";
-        if (auto FGInputHeld = Instance()->FGInput.value_for_config(); FGInputHeld.has_value())
+        if (auto FGInputHeld = FGInput.value_for_config(); FGInputHeld.has_value())
         {
             if (FGInputHeld.value() == FGInput::NoFG)
                 FGInputString = "NoFG";
@@ -826,10 +828,10 @@ bool Config::SaveIni()
             else if (FGInputHeld.value() == FGInput::FSRFG30)
                 FGInputString = "FSRFG30";
         }
-        ini.SetValue("FrameGen", "FGInput", FGInputString.c_str());
+        SetIniValue("FrameGen", "FGInput", FGInputString.c_str());
 
         std::string FGOutputString = "auto";
-        if (auto FGOutputHeld = Instance()->FGOutput.value_for_config(); FGOutputHeld.has_value())
+        if (auto FGOutputHeld = FGOutput.value_for_config(); FGOutputHeld.has_value())
         {
             if (FGOutputHeld.value() == FGOutput::NoFG)
                 FGOutputString = "NoFG";
@@ -844,259 +846,55 @@ bool Config::SaveIni()
             else if (FGOutputHeld.value() == FGOutput::DLSSG)
                 FGOutputString = "DLSSG";
         }
-        ini.SetValue("FrameGen", "FGOutput", FGOutputString.c_str());
+        SetIniValue("FrameGen", "FGOutput", FGOutputString.c_str());
 
         std::optional<int> ftInput;
-        if (Instance()->FTInput.has_value())
-            ftInput = (int) Instance()->FTInput.value();
-
-        ini.SetValue("FrameGen", "FTInput", GetIntValue(ftInput).c_str());
-        ini.SetValue("FrameGen", "DrawUIOverFG", GetBoolValue(Instance()->FGDrawUIOverFG.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "UIPremultipliedAlpha",
-                     GetBoolValue(Instance()->FGUIPremultipliedAlpha.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "DisableHudless",
-                     GetBoolValue(Instance()->FGDisableHudless.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "DisableUI", GetBoolValue(Instance()->FGDisableUI.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "SkipReset", GetBoolValue(Instance()->FGSkipReset.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "RectLeft", GetIntValue(Instance()->FGRectLeft.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "RectTop", GetIntValue(Instance()->FGRectTop.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "RectWidth", GetIntValue(Instance()->FGRectWidth.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "RectHeight", GetIntValue(Instance()->FGRectHeight.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "AllowedFrameAhead",
-                     GetIntValue(Instance()->FGAllowedFrameAhead.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "DepthValidNow", GetBoolValue(Instance()->FGDepthValidNow.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "VelocityValidNow",
-                     GetBoolValue(Instance()->FGVelocityValidNow.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "HudlessValidNow",
-                     GetBoolValue(Instance()->FGHudlessValidNow.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "OnlyAcceptFirstHudless",
-                     GetBoolValue(Instance()->FGOnlyAcceptFirstHudless.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "PreserveSwapChain",
-                     GetBoolValue(Instance()->FGPreserveSwapChain.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "SkipResizeBuffers",
-                     GetBoolValue(Instance()->FGSkipResizeBuffers.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "ModifyBufferState",
-                     GetBoolValue(Instance()->FGModifyBufferState.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "ModifySCIndex", GetBoolValue(Instance()->FGModifySCIndex.value_for_config()).c_str());
-        ini.SetValue("FrameGen", "HudCutoff", GetFloatValue(Instance()->FGHudCutoff.value_for_config()).c_str());
-    }
-
-    // FSR FG output
-    {
-        ini.SetValue("FSRFG", "DebugTearLines", GetBoolValue(Instance()->FGDebugTearLines.value_for_config()).c_str());
-        ini.SetValue("FSRFG", "DebugResetLines",
-                     GetBoolValue(Instance()->FGDebugResetLines.value_for_config()).c_str());
-        ini.SetValue("FSRFG", "DebugPacingLines",
-                     GetBoolValue(Instance()->FGDebugPacingLines.value_for_config()).c_str());
-        ini.SetValue("FSRFG", "AllowAsync", GetBoolValue(Instance()->FGAsync.value_for_config()).c_str());
-        ini.SetValue("FSRFG", "UseMutexForSwapchain",
-                     GetBoolValue(Instance()->FGUseMutexForSwapchain.value_for_config()).c_str());
-        ini.SetValue("FSRFG", "FramePacingTuning",
-                     GetBoolValue(Instance()->FGFramePacingTuning.value_for_config()).c_str());
-        ini.SetValue("FSRFG", "FPTSafetyMarginInMs",
-                     GetFloatValue(Instance()->FGFPTSafetyMarginInMs.value_for_config()).c_str());
-        ini.SetValue("FSRFG", "FPTVarianceFactor",
-                     GetFloatValue(Instance()->FGFPTVarianceFactor.value_for_config()).c_str());
-        ini.SetValue("FSRFG", "FPTHybridSpin",
-                     GetBoolValue(Instance()->FGFPTAllowHybridSpin.value_for_config()).c_str());
-        ini.SetValue("FSRFG", "FPTHybridSpinTime",
-                     GetIntValue(Instance()->FGFPTHybridSpinTime.value_for_config()).c_str());
-        ini.SetValue("FSRFG", "FPTWaitForSingleObjectOnFence",
-                     GetBoolValue(Instance()->FGFPTAllowWaitForSingleObjectOnFence.value_for_config()).c_str());
-        ini.SetValue("FSRFG", "EnableWatermark",
-                     GetBoolValue(Instance()->FSRFGEnableWatermark.value_for_config()).c_str());
-    }
-
-    // XeFG output
-    {
-        ini.SetValue("XeFG", "InterpolationCount",
-                     GetIntValue(Instance()->FGXeFGInterpolationCount.value_for_config()).c_str());
-        ini.SetValue("XeFG", "IgnoreInitChecks",
-                     GetBoolValue(Instance()->FGXeFGIgnoreInitChecks.value_for_config()).c_str());
-        ini.SetValue("XeFG", "UIComposition", GetBoolValue(Instance()->FGXeFGUIComposition.value_for_config()).c_str());
-        ini.SetValue("XeFG", "DepthInverted", GetBoolValue(Instance()->FGXeFGDepthInverted.value_for_config()).c_str());
-        ini.SetValue("XeFG", "JitteredMV", GetBoolValue(Instance()->FGXeFGJitteredMV.value_for_config()).c_str());
-        ini.SetValue("XeFG", "HighResMV", GetBoolValue(Instance()->FGXeFGHighResMV.value_for_config()).c_str());
-        ini.SetValue("XeFG", "DebugView", GetBoolValue(Instance()->FGXeFGDebugView.value_for_config()).c_str());
-        ini.SetValue("XeFG", "ForceBorderless",
-                     GetBoolValue(Instance()->FGXeFGForceBorderless.value_for_config()).c_str());
-    }
-
-    {
-        ini.SetValue("DLSSG", "InterpolationCount",
-                     GetIntValue(Instance()->FGDLSSGInterpolationCount.value_for_config()).c_str());
-        ini.SetValue("DLSSG", "UseGamesReflexMarkers",
-                     GetBoolValue(Instance()->FGDLSSGUseGamesReflexMarkers.value_for_config()).c_str());
-        ini.SetValue("DLSSG", "OverrideInterpolationCount",
-                     GetIntValue(Instance()->FGDLSSGOverrideInterpolationCount.value_for_config()).c_str());
-        ini.SetValue("DLSSG", "FramerateTargetDMFG",
-                     GetFloatValue(Instance()->FGDLSSGFramerateTargetDMFG.value_for_config()).c_str());
-        ini.SetValue("DLSSG", "OverrideForceDMFG",
-                     GetBoolValue(Instance()->FGDLSSGOverrideForceDMFG.value_for_config()).c_str());
-    }
+        if (FTInput.has_value())
+            ftInput = (int) FTInput.value();
 
-    // OptiFG
-    {
-        ini.SetValue("OptiFG", "DisableHUDFix", GetBoolValue(Instance()->FGDisableHUDFix.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HUDFix", GetBoolValue(Instance()->FGHUDFix.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HUDLimit", GetIntValue(Instance()->FGHUDLimit.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HUDFixExtended", GetBoolValue(Instance()->FGHUDFixExtended.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HUDFixImmediate",
-                     GetBoolValue(Instance()->FGImmediateCapture.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "UseShards", GetBoolValue(Instance()->FGUseShards.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "AlwaysTrackHeaps",
-                     GetBoolValue(Instance()->FGAlwaysTrackHeaps.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "ResourceBlocking",
-                     GetBoolValue(Instance()->FGResourceBlocking.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "MakeDepthCopy", GetBoolValue(Instance()->FGMakeDepthCopy.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "MakeMVCopy", GetBoolValue(Instance()->FGMakeMVCopy.value_for_config()).c_str());
-
-        ini.SetValue("OptiFG", "HudfixDisableRTV",
-                     GetBoolValue(Instance()->FGHudfixDisableRTV.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HudfixDisableSRV",
-                     GetBoolValue(Instance()->FGHudfixDisableSRV.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HudfixDisableUAV",
-                     GetBoolValue(Instance()->FGHudfixDisableUAV.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HudfixDisableOM",
-                     GetBoolValue(Instance()->FGHudfixDisableOM.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HudfixDisableDispatch",
-                     GetBoolValue(Instance()->FGHudfixDisableDispatch.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HudfixDisableDI",
-                     GetBoolValue(Instance()->FGHudfixDisableDI.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HudfixDisableDII",
-                     GetBoolValue(Instance()->FGHudfixDisableDII.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HudfixDisableSCR",
-                     GetBoolValue(Instance()->FGHudfixDisableSCR.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HudfixDisableSGR",
-                     GetBoolValue(Instance()->FGHudfixDisableSGR.value_for_config()).c_str());
-
-        ini.SetValue("OptiFG", "EnableDepthScale",
-                     GetBoolValue(Instance()->FGEnableDepthScale.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "DepthScaleMax", GetFloatValue(Instance()->FGDepthScaleMax.value_for_config()).c_str());
-
-        ini.SetValue("OptiFG", "HUDFixDontUseSwapchainBuffers",
-                     GetBoolValue(Instance()->FGDontUseSwapchainBuffers.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "HUDFixRelaxedResolutionCheck",
-                     GetBoolValue(Instance()->FGRelaxedResolutionCheck.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "ResourceFlip", GetBoolValue(Instance()->FGResourceFlip.value_for_config()).c_str());
-        ini.SetValue("OptiFG", "ResourceFlipOffset",
-                     GetBoolValue(Instance()->FGResourceFlipOffset.value_for_config()).c_str());
-
-        ini.SetValue("OptiFG", "AlwaysCaptureFSRFGSwapchain",
-                     GetBoolValue(Instance()->FGAlwaysCaptureFSRFGSwapchain.value_for_config()).c_str());
-    }
-
-    // FSR FG Inputs
-    {
-        ini.SetValue("FSRFGInputs", "SkipConfigForHudless",
-                     GetBoolValue(Instance()->FSRFGSkipConfigForHudless.value_for_config()).c_str());
-        ini.SetValue("FSRFGInputs", "SkipDispatchForHudless",
-                     GetBoolValue(Instance()->FSRFGSkipDispatchForHudless.value_for_config()).c_str());
-    }
-
-    // Framerate
-    {
-        ini.SetValue("Framerate", "FramerateLimit",
-                     GetFloatValue(Instance()->FramerateLimit.value_for_config()).c_str());
+        SetIniValue("FrameGen", "FTInput", GetIntValue(ftInput).c_str());
     }
 
     // Output Scaling
     {
-        ini.SetValue("OutputScaling", "Enabled",
-                     GetBoolValue(Instance()->OutputScalingEnabled.value_for_config()).c_str());
-        ini.SetValue("OutputScaling", "Multiplier",
-                     GetFloatValue(Instance()->OutputScalingMultiplier.value_for_config()).c_str());
-        ini.SetValue("OutputScaling", "Downscaler", GetIntValue(Instance()->OutputScalingDownscaler).c_str());
-    }
-
-    // FSR common
-    {
-        ini.SetValue("FSR", "VerticalFov", GetFloatValue(Instance()->FsrVerticalFov.value_for_config()).c_str());
-        ini.SetValue("FSR", "HorizontalFov", GetFloatValue(Instance()->FsrHorizontalFov.value_for_config()).c_str());
-        ini.SetValue("FSR", "CameraNear", GetFloatValue(Instance()->FsrCameraNear.value_for_config()).c_str());
-        ini.SetValue("FSR", "CameraFar", GetFloatValue(Instance()->FsrCameraFar.value_for_config()).c_str());
-        ini.SetValue("FSR", "UseFsrInputValues",
-                     GetBoolValue(Instance()->FsrUseFsrInputValues.value_for_config()).c_str());
+        SetIniValue("OutputScaling", "Downscaler", GetIntValue(OutputScalingDownscaler).c_str());
     }
 
     // FSR
     {
-        ini.SetValue("FSR", "VelocityFactor", GetFloatValue(Instance()->FsrVelocity.value_for_config()).c_str());
-        ini.SetValue("FSR", "ReactiveScale", GetFloatValue(Instance()->FsrReactiveScale.value_for_config()).c_str());
-        ini.SetValue("FSR", "ShadingScale", GetFloatValue(Instance()->FsrShadingScale.value_for_config()).c_str());
-        ini.SetValue("FSR", "AccAddPerFrame", GetFloatValue(Instance()->FsrAccAddPerFrame.value_for_config()).c_str());
-        ini.SetValue("FSR", "MinDisOccAcc", GetFloatValue(Instance()->FsrMinDisOccAcc.value_for_config()).c_str());
-        ini.SetValue("FSR", "DebugView", GetBoolValue(Instance()->FsrDebugView.value_for_config()).c_str());
-        ini.SetValue("FSR", "UpscalerIndex", GetIntValue(Instance()->FfxUpscalerIndex.value_for_config()).c_str());
-        ini.SetValue("FSR", "FGIndex", GetIntValue(Instance()->FfxFGIndex.value_for_config()).c_str());
-        ini.SetValue("FSR", "UseReactiveMaskForTransparency",
-                     GetBoolValue(Instance()->FsrUseMaskForTransparency.value_for_config()).c_str());
-        ini.SetValue("FSR", "DlssReactiveMaskBias",
-                     GetFloatValue(Instance()->DlssReactiveMaskBias.value_for_config()).c_str());
-        ini.SetValue("FSR", "Fsr4ForceCapable", GetBoolValue(Instance()->Fsr4ForceCapable.value_for_config()).c_str());
-        ini.SetValue("FSR", "Fsr4Model", GetIntValue(Instance()->Fsr4Model.value_for_config()).c_str());
-        ini.SetValue("FSR", "Fsr4EnableWatermark",
-                     GetBoolValue(Instance()->Fsr4EnableWatermark.value_for_config()).c_str());
-        ini.SetValue("FSR", "FsrNonLinearColorSpace",
-                     GetBoolValue(Instance()->FsrNonLinearColorSpace.value_for_config()).c_str());
-        ini.SetValue("FSR", "FsrNonLinearPQ", GetBoolValue(Instance()->FsrNonLinearPQ.value_for_config()).c_str());
-        ini.SetValue("FSR", "FsrNonLinearSRGB", GetBoolValue(Instance()->FsrNonLinearSRGB.value_for_config()).c_str());
-        ini.SetValue("FSR", "FsrAgilitySDKUpgrade",
-                     GetBoolValue(Instance()->FsrAgilitySDKUpgrade.value_for_config()).c_str());
-    }
-
-    // XeSS
-    {
-        ini.SetValue("XeSS", "BuildPipelines", GetBoolValue(Instance()->BuildPipelines.value_for_config()).c_str());
-        ini.SetValue("XeSS", "CreateHeaps", GetBoolValue(Instance()->CreateHeaps.value_for_config()).c_str());
-        ini.SetValue("XeSS", "NetworkModel", GetIntValue(Instance()->NetworkModel.value_for_config()).c_str());
+        SetIniValue("FSR", "Fsr4Model", GetIntValue(Fsr4Model.value_for_config()).c_str());
     }
 
     // DLSS
     {
-        ini.SetValue("DLSS", "Enabled", GetBoolValue(Instance()->DLSSEnabled.value_for_config()).c_str());
-        ini.SetValue("DLSS", "RenderPresetOverride",
-                     GetBoolValue(Instance()->RenderPresetOverride.value_for_config()).c_str());
-        ini.SetValue("DLSS", "RenderPresetForAll",
-                     GetIntValue(Instance()->RenderPresetForAll.value_for_config()).c_str());
-        ini.SetValue("DLSS", "RenderPresetDLAA", GetIntValue(Instance()->RenderPresetDLAA.value_for_config()).c_str());
-        ini.SetValue("DLSS", "RenderPresetUltraQuality",
-                     GetIntValue(Instance()->RenderPresetUltraQuality.value_for_config()).c_str());
-        ini.SetValue("DLSS", "RenderPresetQuality",
-                     GetIntValue(Instance()->RenderPresetQuality.value_for_config()).c_str());
-        ini.SetValue("DLSS", "RenderPresetBalanced",
-                     GetIntValue(Instance()->RenderPresetBalanced.value_for_config()).c_str());
-        ini.SetValue("DLSS", "RenderPresetPerformance",
-                     GetIntValue(Instance()->RenderPresetPerformance.value_for_config()).c_str());
-        ini.SetValue("DLSS", "RenderPresetUltraPerformance",
-                     GetIntValue(Instance()->RenderPresetUltraPerformance.value_for_config()).c_str());
-        ini.SetValue("DLSS", "UseGenericAppIdWithDlss",
-                     GetBoolValue(Instance()->UseGenericAppIdWithDlss.value_for_config()).c_str());
+        SetIniValue("DLSS", "RenderPresetForAll", GetIntValue(RenderPresetForAll.value_for_config()).c_str());
+        SetIniValue("DLSS", "RenderPresetDLAA", GetIntValue(RenderPresetDLAA.value_for_config()).c_str());
+        SetIniValue("DLSS", "RenderPresetUltraQuality",
+                    GetIntValue(RenderPresetUltraQuality.value_for_config()).c_str());
+        SetIniValue("DLSS", "RenderPresetQuality", GetIntValue(RenderPresetQuality.value_for_config()).c_str());
+        SetIniValue("DLSS", "RenderPresetBalanced", GetIntValue(RenderPresetBalanced.value_for_config()).c_str());
+        SetIniValue("DLSS", "RenderPresetPerformance", GetIntValue(RenderPresetPerformance.value_for_config()).c_str());
+        SetIniValue("DLSS", "RenderPresetUltraPerformance",
+                    GetIntValue(RenderPresetUltraPerformance.value_for_config()).c_str());
     }
 
     // DLSSD
     {
-        ini.SetValue("DLSSD", "RenderPresetOverride",
-                     GetBoolValue(Instance()->DLSSDRenderPresetOverride.value_for_config()).c_str());
-        ini.SetValue("DLSSD", "RenderPresetForAll",
-                     GetIntValue(Instance()->DLSSDRenderPresetForAll.value_for_config()).c_str());
-        ini.SetValue("DLSSD", "RenderPresetDLAA",
-                     GetIntValue(Instance()->DLSSDRenderPresetDLAA.value_for_config()).c_str());
-        ini.SetValue("DLSSD", "RenderPresetUltraQuality",
-                     GetIntValue(Instance()->DLSSDRenderPresetUltraQuality.value_for_config()).c_str());
-        ini.SetValue("DLSSD", "RenderPresetQuality",
-                     GetIntValue(Instance()->DLSSDRenderPresetQuality.value_for_config()).c_str());
-        ini.SetValue("DLSSD", "RenderPresetBalanced",
-                     GetIntValue(Instance()->DLSSDRenderPresetBalanced.value_for_config()).c_str());
-        ini.SetValue("DLSSD", "RenderPresetPerformance",
-                     GetIntValue(Instance()->DLSSDRenderPresetPerformance.value_for_config()).c_str());
-        ini.SetValue("DLSSD", "RenderPresetUltraPerformance",
-                     GetIntValue(Instance()->DLSSDRenderPresetUltraPerformance.value_for_config()).c_str());
+        SetIniValue("DLSSD", "RenderPresetForAll", GetIntValue(DLSSDRenderPresetForAll.value_for_config()).c_str());
+        SetIniValue("DLSSD", "RenderPresetDLAA", GetIntValue(DLSSDRenderPresetDLAA.value_for_config()).c_str());
+        SetIniValue("DLSSD", "RenderPresetUltraQuality",
+                    GetIntValue(DLSSDRenderPresetUltraQuality.value_for_config()).c_str());
+        SetIniValue("DLSSD", "RenderPresetQuality", GetIntValue(DLSSDRenderPresetQuality.value_for_config()).c_str());
+        SetIniValue("DLSSD", "RenderPresetBalanced", GetIntValue(DLSSDRenderPresetBalanced.value_for_config()).c_str());
+        SetIniValue("DLSSD", "RenderPresetPerformance",
+                    GetIntValue(DLSSDRenderPresetPerformance.value_for_config()).c_str());
+        SetIniValue("DLSSD", "RenderPresetUltraPerformance",
+                    GetIntValue(DLSSDRenderPresetUltraPerformance.value_for_config()).c_str());
     }
 
     // NvngxFG
     {
-        ini.SetValue("NvngxFG", "MakeDepthCopy", GetBoolValue(Instance()->MakeDepthCopy.value_for_config()).c_str());
+        SetIniValue("NvngxFG", "MakeDepthCopy", GetBoolValue(MakeDepthCopy.value_for_config()).c_str());
     }
 
     // Sharpness
@@ -1105,376 +903,334 @@ bool Config::SaveIni()
                                  .transform(SharpnessShaderToCode) // Turn enum into string
                                  .value_or("auto");
 
-        ini.SetValue("Sharpness", "Shader", shader.c_str());
-
-        ini.SetValue("Sharpness", "OverrideSharpness",
-                     GetBoolValue(Instance()->OverrideSharpness.value_for_config()).c_str());
-        ini.SetValue("Sharpness", "Sharpness", GetFloatValue(Instance()->Sharpness.value_for_config()).c_str());
+        SetIniValue("Sharpness", "Shader", shader.c_str());
     }
 
-    // CAS
+    // Menu
     {
-        ini.SetValue("CAS", "Enabled", GetBoolValue(Instance()->RcasEnabled.value_for_config()).c_str());
+        auto setting = ShortcutKey.value_for_config();
+        SetIniValue("Menu", "ShortcutKey", GetIntValue(ShortcutKey.value_for_config(), setting > 0).c_str());
 
-        ini.SetValue("CAS", "MotionSharpnessEnabled",
-                     GetBoolValue(Instance()->MotionSharpnessEnabled.value_for_config()).c_str());
-        ini.SetValue("CAS", "MotionSharpness", GetFloatValue(Instance()->MotionSharpness.value_for_config()).c_str());
-        ini.SetValue("CAS", "MotionThreshold", GetFloatValue(Instance()->MotionThreshold.value_for_config()).c_str());
-        ini.SetValue("CAS", "MotionScaleLimit", GetFloatValue(Instance()->MotionScaleLimit.value_for_config()).c_str());
+        setting = FGShortcutKey.value_for_config();
+        SetIniValue("Menu", "FGShortcutKey", GetIntValue(FGShortcutKey.value_for_config(), setting > 0).c_str());
 
-        ini.SetValue("CAS", "ContrastEnabled", GetBoolValue(Instance()->ContrastEnabled.value_for_config()).c_str());
-        ini.SetValue("CAS", "Contrast", GetFloatValue(Instance()->Contrast.value_for_config()).c_str());
+        setting = FpsShortcutKey.value_for_config();
+        SetIniValue("Menu", "FpsShortcutKey", GetIntValue(FpsShortcutKey.value_for_config(), setting > 0).c_str());
 
-        ini.SetValue("CAS", "DADepthScale", GetFloatValue(Instance()->DADepthScale.value_for_config()).c_str());
-        ini.SetValue("CAS", "DADepthBias", GetFloatValue(Instance()->DADepthBias.value_for_config()).c_str());
-        ini.SetValue("CAS", "DAClampOutput", GetBoolValue(Instance()->DAClampOutput.value_for_config()).c_str());
+        setting = FpsCycleShortcutKey.value_for_config();
+        SetIniValue("Menu", "FpsCycleShortcutKey",
+                    GetIntValue(FpsCycleShortcutKey.value_for_config(), setting > 0).c_str());
 
-        ini.SetValue("CAS", "SharpenerDebug",
-                     GetBoolValue(Instance()->MotionSharpnessDebug.value_for_config()).c_str());
-    }
+        SetIniValue("Menu", "FpsOverlayType", GetIntValue(FpsOverlayType.value_for_config()).c_str());
 
-    // Menu
-    {
-        ini.SetValue("Menu", "Scale", GetFloatValue(Instance()->MenuScale).c_str());
-        ini.SetValue("Menu", "OverlayMenu", GetBoolValue(Instance()->OverlayMenu.value_for_config()).c_str());
-
-        auto setting = Instance()->ShortcutKey.value_for_config();
-        ini.SetValue("Menu", "ShortcutKey",
-                     GetIntValue(Instance()->ShortcutKey.value_for_config(), setting > 0).c_str());
-
-        ini.SetValue("Menu", "ExtendedLimits", GetBoolValue(Instance()->ExtendedLimits.value_for_config()).c_str());
-        ini.SetValue("Menu", "ShowFps", GetBoolValue(Instance()->ShowFps.value_for_config()).c_str());
-        ini.SetValue("Menu", "UseHQFont", GetBoolValue(Instance()->UseHQFont.value_for_config()).c_str());
-        ini.SetValue("Menu", "DisableSplash", GetBoolValue(Instance()->DisableSplash.value_for_config()).c_str());
-
-        setting = Instance()->FGShortcutKey.value_for_config();
-        ini.SetValue("Menu", "FGShortcutKey",
-                     GetIntValue(Instance()->FGShortcutKey.value_for_config(), setting > 0).c_str());
-
-        setting = Instance()->FpsShortcutKey.value_for_config();
-        ini.SetValue("Menu", "FpsShortcutKey",
-                     GetIntValue(Instance()->FpsShortcutKey.value_for_config(), setting > 0).c_str());
-
-        setting = Instance()->FpsCycleShortcutKey.value_for_config();
-        ini.SetValue("Menu", "FpsCycleShortcutKey",
-                     GetIntValue(Instance()->FpsCycleShortcutKey.value_for_config(), setting > 0).c_str());
-
-        ini.SetValue("Menu", "FpsOverlayPos", GetIntValue(Instance()->FpsOverlayPos.value_for_config()).c_str());
-        ini.SetValue("Menu", "FpsOverlayType", GetIntValue(Instance()->FpsOverlayType.value_for_config()).c_str());
-        ini.SetValue("Menu", "FpsOverlayHorizontal",
-                     GetBoolValue(Instance()->FpsOverlayHorizontal.value_for_config()).c_str());
-        ini.SetValue("Menu", "FpsOverlayAlpha", GetFloatValue(Instance()->FpsOverlayAlpha.value_for_config()).c_str());
-        ini.SetValue("Menu", "FpsScale", GetFloatValue(Instance()->FpsScale.value_for_config()).c_str());
-        ini.SetValue("Menu", "FontSize", GetFloatValue(Instance()->FontSize.value_for_config()).c_str());
-        ini.SetValue("Menu", "TTFFontPath",
-                     wstring_to_string(Instance()->TTFFontPath.value_for_config_or(L"auto")).c_str());
-
-        ini.SetValue("Menu", "LightTheme", GetBoolValue(Instance()->LightTheme.value_for_config()).c_str());
-        ini.SetValue("Menu", "MenuAccentColorR",
-                     GetFloatValue(Instance()->MenuAccentColorR.value_for_config()).c_str());
-        ini.SetValue("Menu", "MenuAccentColorG",
-                     GetFloatValue(Instance()->MenuAccentColorG.value_for_config()).c_str());
-        ini.SetValue("Menu", "MenuAccentColorB",
-                     GetFloatValue(Instance()->MenuAccentColorB.value_for_config()).c_str());
+        SetIniValue("Menu", "MenuAccentColorR", GetFloatValue(MenuAccentColorR.value_for_config()).c_str());
+        SetIniValue("Menu", "MenuAccentColorG", GetFloatValue(MenuAccentColorG.value_for_config()).c_str());
+        SetIniValue("Menu", "MenuAccentColorB", GetFloatValue(MenuAccentColorB.value_for_config()).c_str());
     }
 
-    // Hooks
+    // Quality Overrides
     {
-        ini.SetValue("Hooks", "HookOriginalNvngxOnly",
-                     GetBoolValue(Instance()->HookOriginalNvngxOnly.value_for_config()).c_str());
-        ini.SetValue("Hooks", "EarlyHooking", GetBoolValue(Instance()->EarlyHooking.value_for_config()).c_str());
-        ini.SetValue("Hooks", "UseNtdllHooks", GetBoolValue(Instance()->UseNtdllHooks.value_for_config()).c_str());
+        SetIniValue("QualityOverrides", "QualityRatioUltraPerformance",
+                    GetFloatValue(QualityRatio_UltraPerformance.value_for_config()).c_str());
     }
 
-    // InitFlags
+    // Anisotropy
     {
-        ini.SetValue("InitFlags", "AutoExposure", GetBoolValue(Instance()->AutoExposure.value_for_config()).c_str());
-        ini.SetValue("InitFlags", "HDR", GetBoolValue(Instance()->HDR.value_for_config()).c_str());
-        ini.SetValue("InitFlags", "DepthInverted", GetBoolValue(Instance()->DepthInverted.value_for_config()).c_str());
-        ini.SetValue("InitFlags", "JitterCancellation",
-                     GetBoolValue(Instance()->JitterCancellation.value_for_config()).c_str());
-        ini.SetValue("InitFlags", "DisplayResolution",
-                     GetBoolValue(Instance()->DisplayResolution.value_for_config()).c_str());
-        ini.SetValue("InitFlags", "DisableReactiveMask",
-                     GetBoolValue(Instance()->DisableReactiveMask.value_for_config()).c_str());
+        SetIniValue("Anisotropy", "AnisotropyOverride", GetIntValue(AnisotropyOverride.value_for_config()).c_str());
+        SetIniValue("Anisotropy", "ModifyComparison", GetBoolValue(AnisotropyModifyComp.value_for_config()).c_str());
+        SetIniValue("Anisotropy", "ModifyMinMax", GetBoolValue(AnisotropyModifyMinMax.value_for_config()).c_str());
     }
 
-    // Upscale Ratio Override
+    // Mipmap
     {
-        ini.SetValue("UpscaleRatio", "UpscaleRatioOverrideEnabled",
-                     GetBoolValue(Instance()->UpscaleRatioOverrideEnabled.value_for_config()).c_str());
-        ini.SetValue("UpscaleRatio", "UpscaleRatioOverrideValue",
-                     GetFloatValue(Instance()->UpscaleRatioOverrideValue.value_for_config()).c_str());
+        SetIniValue("Mipmap", "MipmapBiasOverride", GetFloatValue(MipmapBiasOverride.value_for_config()).c_str());
     }
 
-    // Quality Overrides
+    // Logging
     {
-        ini.SetValue("QualityOverrides", "QualityRatioOverrideEnabled",
-                     GetBoolValue(Instance()->QualityRatioOverrideEnabled.value_for_config()).c_str());
-        ini.SetValue("QualityOverrides", "QualityRatioDLAA",
-                     GetFloatValue(Instance()->QualityRatio_DLAA.value_for_config()).c_str());
-        ini.SetValue("QualityOverrides", "QualityRatioUltraQuality",
-                     GetFloatValue(Instance()->QualityRatio_UltraQuality.value_for_config()).c_str());
-        ini.SetValue("QualityOverrides", "QualityRatioQuality",
-                     GetFloatValue(Instance()->QualityRatio_Quality.value_for_config()).c_str());
-        ini.SetValue("QualityOverrides", "QualityRatioBalanced",
-                     GetFloatValue(Instance()->QualityRatio_Balanced.value_for_config()).c_str());
-        ini.SetValue("QualityOverrides", "QualityRatioPerformance",
-                     GetFloatValue(Instance()->QualityRatio_Performance.value_for_config()).c_str());
-        ini.SetValue("QualityOverrides", "QualityRatioUltraPerformance",
-                     GetFloatValue(Instance()->QualityRatio_UltraPerformance.value_for_config()).c_str());
+        SetIniValue("Log", "LogFileName", wstring_to_string(LogFileName.value_for_config_or(L"auto")).c_str());
     }
 
-    // Anisotropy
+    // Spoofing
     {
-        ini.SetValue("Anisotropy", "AnisotropyOverride",
-                     GetIntValue(Instance()->AnisotropyOverride.value_for_config()).c_str());
-        ini.SetValue("Anisotropy", "ModifyComparison",
-                     GetBoolValue(Instance()->AnisotropyModifyComp.value_for_config()).c_str());
-        ini.SetValue("Anisotropy", "ModifyMinMax",
-                     GetBoolValue(Instance()->AnisotropyModifyMinMax.value_for_config()).c_str());
-        ini.SetValue("Anisotropy", "SkipPointFilter",
-                     GetBoolValue(Instance()->AnisotropySkipPointFilter.value_for_config()).c_str());
+        SetIniValue("Spoofing", "SpoofedVendorId", GetIntValue(SpoofedVendorId.value_for_config(), true).c_str());
+        SetIniValue("Spoofing", "SpoofedDeviceId", GetIntValue(SpoofedDeviceId.value_for_config(), true).c_str());
+        SetIniValue("Spoofing", "TargetVendorId", GetIntValue(TargetVendorId.value_for_config(), true).c_str());
+        SetIniValue("Spoofing", "TargetDeviceId", GetIntValue(TargetDeviceId.value_for_config(), true).c_str());
     }
 
-    // Mipmap
+    // fakenvapi
     {
-        ini.SetValue("Mipmap", "MipmapBiasOverride",
-                     GetFloatValue(Instance()->MipmapBiasOverride.value_for_config()).c_str());
-        ini.SetValue("Mipmap", "MipmapBiasOverrideAll",
-                     GetBoolValue(Instance()->MipmapBiasOverrideAll.value_for_config()).c_str());
-        ini.SetValue("Mipmap", "MipmapBiasFixedOverride",
-                     GetBoolValue(Instance()->MipmapBiasFixedOverride.value_for_config()).c_str());
-        ini.SetValue("Mipmap", "MipmapBiasScaleOverride",
-                     GetBoolValue(Instance()->MipmapBiasScaleOverride.value_for_config()).c_str());
+        SetIniValue("fakenvapi", "LatencyFlexMode", GetIntValue(FN_LatencyFlexMode.value_for_config()).c_str());
+        SetIniValue("fakenvapi", "ForceReflex", GetIntValue(FN_ForceReflex.value_for_config()).c_str());
     }
 
-    // Process Filter
+    // V-Sync
     {
-        ini.SetValue("ProcessFilter", "TargetProcessName",
-                     wstring_to_string(Instance()->TargetProcess.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("ProcessFilter", "ProcessExclusionList",
-                     wstring_to_string(Instance()->ProcessExclusionList.value_for_config_or(L"auto")).c_str());
+        if (VsyncInterval.has_value())
+        {
+            if (VsyncInterval.value() < 0 || VsyncInterval.value() > 3)
+                VsyncInterval.reset();
+        }
     }
 
-    // Hotfixes
+    // Libraries
     {
-        ini.SetValue("Hotfix", "DontCreateD3D12DeviceForLuma",
-                     GetBoolValue(Instance()->DontCreateD3D12DeviceForLuma.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "CheckForUpdate", GetBoolValue(Instance()->CheckForUpdate.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "DisableOverlays", GetBoolValue(Instance()->DisableOverlays.value_for_config()).c_str());
-
-        ini.SetValue("Hotfix", "RoundInternalResolution",
-                     GetIntValue(Instance()->RoundInternalResolution.value_for_config()).c_str());
-
-        ini.SetValue("Hotfix", "RestoreComputeSignature",
-                     GetBoolValue(Instance()->RestoreComputeSignature.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "RestoreGraphicSignature",
-                     GetBoolValue(Instance()->RestoreGraphicSignature.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "SkipFirstFrames", GetIntValue(Instance()->SkipFirstFrames.value_for_config()).c_str());
-
-        ini.SetValue("Hotfix", "UsePrecompiledShaders",
-                     GetBoolValue(Instance()->UsePrecompiledShaders.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "PreferDedicatedGpu",
-                     GetBoolValue(Instance()->PreferDedicatedGpu.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "PreferFirstDedicatedGpu",
-                     GetBoolValue(Instance()->PreferFirstDedicatedGpu.value_for_config()).c_str());
-
-        ini.SetValue("Hotfix", "ColorResourceBarrier",
-                     GetIntValue(Instance()->ColorResourceBarrier.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "MotionVectorResourceBarrier",
-                     GetIntValue(Instance()->MVResourceBarrier.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "DepthResourceBarrier",
-                     GetIntValue(Instance()->DepthResourceBarrier.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "ColorMaskResourceBarrier",
-                     GetIntValue(Instance()->MaskResourceBarrier.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "ExposureResourceBarrier",
-                     GetIntValue(Instance()->ExposureResourceBarrier.value_for_config()).c_str());
-        ini.SetValue("Hotfix", "OutputResourceBarrier",
-                     GetIntValue(Instance()->OutputResourceBarrier.value_for_config()).c_str());
+        SetIniValue("Libraries", "XeSSPath", wstring_to_string(XeSSLibrary.value_for_config_or(L"auto")).c_str());
+        SetIniValue("Libraries", "XeFGPath", wstring_to_string(XeFGLibrary.value_for_config_or(L"auto")).c_str());
+        SetIniValue("Libraries", "XeLLPath", wstring_to_string(XeLLLibrary.value_for_config_or(L"auto")).c_str());
     }
 
-    // Dx11 with Dx12
-    {
-        ini.SetValue("Dx11withDx12", "DontUseNTShared",
-                     GetBoolValue(Instance()->DontUseNTShared.value_for_config()).c_str());
-    }
+}
 
-    // Logging
+bool Config::SaveIni()
+{
+    std::scoped_lock lock(iniMutex);
+
+    changedValues = 0;
+    WriteValues();
+
+    // Also retries an earlier delayed save which failed
+    if (ini.Unsaved() == 0)
     {
-        ini.SetValue("Log", "LogToFile", GetBoolValue(Instance()->LogToFile.value_for_config()).c_str());
-        ini.SetValue("Log", "LogLevel", GetIntValue(Instance()->LogLevel.value_for_config()).c_str());
-        ini.SetValue("Log", "LogToConsole", GetBoolValue(Instance()->LogToConsole.value_for_config()).c_str());
-        ini.SetValue("Log", "LogToDebug", GetBoolValue(Instance()->LogToDebug.value_for_config()).c_str());
-        ini.SetValue("Log", "LogToNGX", GetBoolValue(Instance()->LogToNGX.value_for_config()).c_str());
-        ini.SetValue("Log", "OpenConsole", GetBoolValue(Instance()->OpenConsole.value_for_config()).c_str());
-        ini.SetValue("Log", "SingleFile", GetBoolValue(Instance()->LogSingleFile.value_for_config()).c_str());
-        ini.SetValue("Log", "LogFileName",
-                     wstring_to_string(Instance()->LogFileName.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("Log", "LogAsync", GetBoolValue(Instance()->LogAsync.value_for_config()).c_str());
-        ini.SetValue("Log", "LogAsyncThreads", GetIntValue(Instance()->LogAsyncThreads.value_for_config()).c_str());
+        LOG_DEBUG("No changed values, skipping save");
+        return true;
     }
 
-    // NvApi
+    // Save button of the menu, written right away so a failure can be shown
+    _saveDue.reset();
+    return WriteIni();
+}
+
+bool Config::SaveXeFG()
+{
+    std::scoped_lock lock(iniMutex);
+
+    changedValues = 0;
+    SetIniValue("XeFG", "DepthInverted", GetBoolValue(FGXeFGDepthInverted.value_for_config()).c_str());
+    SetIniValue("XeFG", "JitteredMV", GetBoolValue(FGXeFGJitteredMV.value_for_config()).c_str());
+    SetIniValue("XeFG", "HighResMV", GetBoolValue(FGXeFGHighResMV.value_for_config()).c_str());
+
+    return QueueSave();
+}
+
+// Called with ini mutex locked
+bool Config::QueueSave()
+{
+    if (changedValues == 0)
     {
-        ini.SetValue("NvApi", "DisableFlipMetering",
-                     GetBoolValue(Instance()->DisableFlipMetering.value_for_config()).c_str());
+        LOG_DEBUG("No changed values, skipping save");
+        return true;
     }
 
-    // DRS
+    LOG_DEBUG("{} changed values, saving in {}ms", changedValues, SaveDelay.count());
+
+    _saveDue = std::chrono::steady_clock::now() + SaveDelay;
+    StartWorker();
+
+    return true;
+}
+
+void Config::StartWorker()
+{
+    static std::once_flag started;
+    std::call_once(started, [this]() { std::thread(&Config::Worker, this).detach(); });
+}
+
+void Config::Worker()
+{
+    auto nextCheck = std::chrono::steady_clock::now() + IniCheckInterval;
+
+    while (!State::Instance().isShuttingDown)
     {
-        ini.SetValue("DRS", "DrsMinOverrideEnabled",
-                     GetBoolValue(Instance()->DrsMinOverrideEnabled.value_for_config()).c_str());
-        ini.SetValue("DRS", "DrsMaxOverrideEnabled",
-                     GetBoolValue(Instance()->DrsMaxOverrideEnabled.value_for_config()).c_str());
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        auto now = std::chrono::steady_clock::now();
+
+        {
+            std::scoped_lock lock(iniMutex);
+
+            // Failed saves are not retried here, next save request or SaveIni tries again
+            if (_saveDue.has_value() && now >= _saveDue.value())
+            {
+                _saveDue.reset();
+                WriteIni();
+            }
+        }
+
+        if (HotReloadIni.value_or_default() && now >= nextCheck)
+        {
+            nextCheck = now + IniCheckInterval;
+            CheckIniChanges();
+        }
     }
+}
 
-    // Spoofing
+// Called with ini mutex locked
+bool Config::WriteIni()
+{
+    LOG_INFO("Trying to save ini to: {0}", wstring_to_string(absoluteFileName.wstring()));
+
+    if (!ini.SaveFile(absoluteFileName))
     {
-        ini.SetValue("Spoofing", "Dxgi", GetBoolValue(Instance()->DxgiSpoofing.value_for_config()).c_str());
-        ini.SetValue("Spoofing", "DxgiFactoryWrapping",
-                     GetBoolValue(Instance()->DxgiFactoryWrapping.value_for_config()).c_str());
-        ini.SetValue("Spoofing", "DxgiBlacklist", Instance()->DxgiBlacklist.value_for_config_or("auto").c_str());
-        ini.SetValue("Spoofing", "Vulkan", GetBoolValue(Instance()->VulkanSpoofing.value_for_config()).c_str());
-        ini.SetValue("Spoofing", "VulkanExtensionSpoofing",
-                     GetBoolValue(Instance()->VulkanExtensionSpoofing.value_for_config()).c_str());
-        ini.SetValue("Spoofing", "VulkanVRAM", GetIntValue(Instance()->VulkanVRAM.value_for_config()).c_str());
-        ini.SetValue("Spoofing", "DxgiVRAM", GetIntValue(Instance()->DxgiVRAM.value_for_config()).c_str());
-        ini.SetValue("Spoofing", "SpoofedGPUName",
-                     wstring_to_string(Instance()->SpoofedGPUName.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("Spoofing", "StreamlineSpoofing",
-                     GetBoolValue(Instance()->StreamlineSpoofing.value_for_config()).c_str());
-        ini.SetValue("Spoofing", "SpoofHAGS", GetBoolValue(Instance()->SpoofHAGS.value_for_config()).c_str());
-        ini.SetValue("Spoofing", "D3DFeatureLevel",
-                     GetBoolValue(Instance()->SpoofFeatureLevel.value_for_config()).c_str());
-        ini.SetValue("Spoofing", "UEIntelAtomics",
-                     GetBoolValue(Instance()->UESpoofIntelAtomics64.value_for_config()).c_str());
-        ini.SetValue("Spoofing", "SpoofedVendorId",
-                     GetIntValue(Instance()->SpoofedVendorId.value_for_config(), true).c_str());
-        ini.SetValue("Spoofing", "SpoofedDeviceId",
-                     GetIntValue(Instance()->SpoofedDeviceId.value_for_config(), true).c_str());
-        ini.SetValue("Spoofing", "TargetVendorId",
-                     GetIntValue(Instance()->TargetVendorId.value_for_config(), true).c_str());
-        ini.SetValue("Spoofing", "TargetDeviceId",
-                     GetIntValue(Instance()->TargetDeviceId.value_for_config(), true).c_str());
-        ini.SetValue("Spoofing", "Registry", GetBoolValue(Instance()->SpoofRegistry.value_for_config()).c_str());
-        ini.SetValue("Spoofing", "RegistryDriver",
-                     wstring_to_string(Instance()->SpoofedDriver.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("Spoofing", "User32", GetBoolValue(Instance()->SpoofUser32.value_for_config()).c_str());
+        LOG_ERROR("Can't save ini, {} values are not saved", ini.Unsaved());
+        return false;
     }
 
-    // Plugins
-    {
+    // Don't detect our own save as an external edit
+    std::error_code ec;
+    _iniWriteTime = std::filesystem::last_write_time(absoluteFileName, ec);
 
-        ini.SetValue("Plugins", "Path", wstring_to_string(Instance()->PluginPath.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("Plugins", "LoadSpecialK", GetBoolValue(Instance()->LoadSpecialK.value_for_config()).c_str());
-        ini.SetValue("Plugins", "LoadReShade", GetBoolValue(Instance()->LoadReShade.value_for_config()).c_str());
-        ini.SetValue("Plugins", "LoadAsiPlugins", GetBoolValue(Instance()->LoadAsiPlugins.value_for_config()).c_str());
-    }
+    return true;
+}
+
+void Config::CheckIniChanges()
+{
+    std::error_code ec;
+    auto writeTime = std::filesystem::last_write_time(absoluteFileName, ec);
 
-    // fakenvapi
     {
-        ini.SetValue("fakenvapi", "UseFakenvapi", GetBoolValue(Instance()->UseFakenvapi.value_for_config()).c_str());
-        ini.SetValue("fakenvapi", "ForceXeLL", GetBoolValue(Instance()->ForceXeLL.value_for_config()).c_str());
-        ini.SetValue("fakenvapi", "ForceLatencyFlex",
-                     GetBoolValue(Instance()->FN_ForceLatencyFlex.value_for_config()).c_str());
-        ini.SetValue("fakenvapi", "LatencyFlexMode",
-                     GetIntValue(Instance()->FN_LatencyFlexMode.value_for_config()).c_str());
-        ini.SetValue("fakenvapi", "ForceReflex", GetIntValue(Instance()->FN_ForceReflex.value_for_config()).c_str());
+        std::scoped_lock lock(iniMutex);
+
+        if (ec || writeTime == _iniWriteTime)
+            return;
     }
 
-    // inputs
+    std::ifstream file(absoluteFileName, std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    // Editors might truncate the file before writing, try again on next check
+    CSimpleIniA fileIni;
+    if (data.empty() || fileIni.LoadData(data) != SI_OK)
+        return;
+
+    std::scoped_lock lock(iniMutex);
+
+    _iniWriteTime = writeTime;
+
+    for (size_t i = 0; i < _schema.size(); i++)
     {
-        ini.SetValue("Inputs", "EnableDlssInputs",
-                     GetBoolValue(Instance()->EnableDlssInputs.value_for_config()).c_str());
-        ini.SetValue("Inputs", "EnableXeSSInputs",
-                     GetBoolValue(Instance()->EnableXeSSInputs.value_for_config()).c_str());
-        ini.SetValue("Inputs", "UseFsr2Inputs", GetBoolValue(Instance()->UseFsr2Inputs.value_for_config()).c_str());
-        ini.SetValue("Inputs", "UseFsr2Dx11Inputs",
-                     GetBoolValue(Instance()->UseFsr2Dx11Inputs.value_for_config()).c_str());
-        ini.SetValue("Inputs", "UseFsr2VulkanInputs",
-                     GetBoolValue(Instance()->UseFsr2VulkanInputs.value_for_config()).c_str());
-        ini.SetValue("Inputs", "Fsr2Pattern", GetBoolValue(Instance()->Fsr2Pattern.value_for_config()).c_str());
-        ini.SetValue("Inputs", "UseFsr3Inputs", GetBoolValue(Instance()->UseFsr3Inputs.value_for_config()).c_str());
-        ini.SetValue("Inputs", "Fsr3Pattern", GetBoolValue(Instance()->Fsr3Pattern.value_for_config()).c_str());
-        ini.SetValue("Inputs", "UseFfxInputs", GetBoolValue(Instance()->UseFfxInputs.value_for_config()).c_str());
-        ini.SetValue("Inputs", "EnableHotSwapping",
-                     GetBoolValue(Instance()->EnableHotSwapping.value_for_config()).c_str());
-
-        ini.SetValue("Inputs", "EnableFsr2Inputs",
-                     GetBoolValue(Instance()->EnableFsr2Inputs.value_for_config()).c_str());
-        ini.SetValue("Inputs", "EnableFsr3Inputs",
-                     GetBoolValue(Instance()->EnableFsr3Inputs.value_for_config()).c_str());
-        ini.SetValue("Inputs", "EnableFfxInputs", GetBoolValue(Instance()->EnableFfxInputs.value_for_config()).c_str());
+        const auto& option = _schema[i];
+        std::string value = fileIni.GetValue(option.Section(), option.Key(), "auto");
+
+        if (value == ini.GetValue(option.Section(), option.Key(), "auto"))
+            continue;
+
+        // Menu change waiting for the delayed save is newer than the file
+        if (ini.IsUnsaved(option.Section(), option.Key()))
+        {
+            LOG_INFO("{}.{} changed to {}, keeping the unsaved menu value", option.Section(), option.Key(), value);
+            continue;
+        }
+
+        if (option.IsHot())
+            _pendingValues.push_back({ i, value });
+        else
+            LOG_INFO("{}.{} changed to {}, will be used after restart", option.Section(), option.Key(), value);
     }
 
-    // V-Sync
+    // Next save is based on the edited file, values which were not applied don't get overwritten
+    // because they still match the saved values. Pending menu changes are put back and saved as queued.
+    ini.LoadData(data);
+
+    if (!_pendingValues.empty())
+        _hasPendingValues = true;
+}
+
+void Config::ApplyIniChanges()
+{
+    if (HotReloadIni.value_or_default())
+        StartWorker();
+
+    if (!_hasPendingValues)
+        return;
+
+    std::scoped_lock lock(iniMutex);
+
+    for (const auto& [index, value] : _pendingValues)
     {
-        ini.SetValue("V-Sync", "OverrideVsync", GetBoolValue(Instance()->OverrideVsync.value_for_config()).c_str());
-        ini.SetValue("V-Sync", "ForceVsync", GetBoolValue(Instance()->ForceVsync.value_for_config()).c_str());
-        ini.SetValue("V-Sync", "SyncInterval", GetIntValue(Instance()->VsyncInterval.value_for_config()).c_str());
+        const auto& option = _schema[index];
 
-        if (Instance()->VsyncInterval.has_value())
+        if (!option.Apply(value))
         {
-            if (Instance()->VsyncInterval.value() < 0 || Instance()->VsyncInterval.value() > 3)
-                Instance()->VsyncInterval.reset();
+            LOG_WARN("Ignoring invalid value for {}.{}: {}", option.Section(), option.Key(), value);
+            continue;
         }
+
+        LOG_INFO("{}.{} reloaded: {}", option.Section(), option.Key(), value);
+        ini.SetSaved(option.Section(), option.Key(), option.Text());
     }
 
-    // Libraries
+    _pendingValues.clear();
+    _hasPendingValues = false;
+    _generation++;
+}
+
+bool Config::FlushSave()
+{
+    std::scoped_lock lock(iniMutex);
+
+    if (!_saveDue.has_value())
+        return true;
+
+    _saveDue.reset();
+    return WriteIni();
+}
+
+size_t Config::ApplyProfileOptions(const std::vector<std::pair<std::string, std::string>>& options)
+{
+    size_t applied = 0;
+
+    for (const auto& [name, value] : options)
     {
-        ini.SetValue("Libraries", "OptiDllPath",
-                     wstring_to_string(Instance()->MainDllPath.value_for_config_or(L"auto")).c_str());
-
-        ini.SetValue("Libraries", "NvngxPath",
-                     wstring_to_string(Instance()->NvngxPath.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("Libraries", "NvngxFeaturePath",
-                     wstring_to_string(Instance()->DLSSFeaturePath.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("Libraries", "NvngxDlssPath",
-                     wstring_to_string(Instance()->NVNGX_DLSS_Library.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("Libraries", "NvapiPath",
-                     wstring_to_string(Instance()->NvapiDllPath.value_for_config_or(L"auto")).c_str());
-
-        ini.SetValue("Libraries", "FfxDx12Path",
-                     wstring_to_string(Instance()->FfxDx12Path.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("Libraries", "FfxDx12SRPath",
-                     wstring_to_string(Instance()->FfxDx12SRPath.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("Libraries", "FfxDx12FGPath",
-                     wstring_to_string(Instance()->FfxDx12FGPath.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("Libraries", "FfxDx12RRPath",
-                     wstring_to_string(Instance()->FfxDx12RRPath.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("Libraries", "FfxDx12RCPath",
-                     wstring_to_string(Instance()->FfxDx12RCPath.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("Libraries", "FfxVkPath",
-                     wstring_to_string(Instance()->FfxVkPath.value_for_config_or(L"auto")).c_str());
-
-        ini.SetValue("Libraries", "XeSSPath",
-                     wstring_to_string(Instance()->XeSSLibrary.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("Libraries", "XeFGPath",
-                     wstring_to_string(Instance()->XeFGLibrary.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("Libraries", "XeLLPath",
-                     wstring_to_string(Instance()->XeLLLibrary.value_for_config_or(L"auto")).c_str());
-        ini.SetValue("Libraries", "XeSSDx11Path",
-                     wstring_to_string(Instance()->XeSSDx11Library.value_for_config_or(L"auto")).c_str());
-    }
+        auto matches = [&name](const ConfigOption& option)
+        { return lstrcmpiA(std::format("{}.{}", option.Section(), option.Key()).c_str(), name.c_str()) == 0; };
+
+        auto option = std::ranges::find_if(_schema, matches);
 
-    auto pathWStr = absoluteFileName.wstring();
+        if (option == _schema.end())
+        {
+            LOG_WARN("Profile option {} is unknown or can't be set from profiles", name);
+            continue;
+        }
 
-    LOG_INFO("Trying to save ini to: {0}", wstring_to_string(pathWStr));
+        if (!option->LoadDefault(value))
+        {
+            LOG_WARN("Profile option {} has invalid value: {}", name, value);
+            continue;
+        }
 
-    return ini.SaveFile(absoluteFileName.wstring().c_str()) >= 0;
+        LOG_DEBUG("Profile option {}: {}", name, value);
+        applied++;
+    }
+
+    return applied;
 }
 
-bool Config::SaveXeFG()
+const ConfigOption* Config::FindOption(const void* member) const
+{
+    auto option = std::ranges::find_if(_schema, [member](const ConfigOption& o) { return o.Member() == member; });
+    return option == _schema.end() ? nullptr : &(*option);
+}
+
+std::vector<std::pair<std::string, std::string>> Config::GetProfileOptions()
 {
-    ini.SetValue("XeFG", "DepthInverted", GetBoolValue(Instance()->FGXeFGDepthInverted.value_for_config()).c_str());
-    ini.SetValue("XeFG", "JitteredMV", GetBoolValue(Instance()->FGXeFGJitteredMV.value_for_config()).c_str());
-    ini.SetValue("XeFG", "HighResMV", GetBoolValue(Instance()->FGXeFGHighResMV.value_for_config()).c_str());
+    // Paths, logging & menu preferences belong to the install, not to the game
+    constexpr std::string_view localSections[] = { "Libraries",     "Log",         "Menu", "Plugins",
+                                                    "ProcessFilter", "GameProfiles" };
+
+    std::vector<std::pair<std::string, std::string>> result;
+
+    for (const auto& option : _schema)
+    {
+        if (std::ranges::find(localSections, option.Section()) != std::end(localSections))
+            continue;
 
-    auto pathWStr = absoluteFileName.wstring();
-    LOG_INFO("Trying to save ini to: {0}", wstring_to_string(pathWStr));
+        if (auto value = option.CurrentText(); !ConfigText::IsAuto(value))
+            result.push_back({ std::format("{}.{}", option.Section(), option.Key()), value });
+    }
 
-    return ini.SaveFile(absoluteFileName.wstring().c_str()) >= 0;
+    return result;
 }
 
 void Config::CheckUpscalerFiles()
@@ -1558,122 +1314,32 @@ std::optional<std::wstring> Config::readWString(std::string section, std::string
 
 std::optional<float> Config::readFloat(std::string section, std::string key)
 {
-    auto value = readString(section, key);
+    if (auto value = readString(section, key); value.has_value())
+        return ConfigText::Parse<float>(value.value());
 
-    try
-    {
-        float result;
-
-        if (value.has_value() && isFloat(value.value(), result))
-            return result;
-
-        return std::nullopt;
-    }
-    catch (const std::bad_optional_access&) // missing or auto value
-    {
-        return std::nullopt;
-    }
-    catch (const std::invalid_argument&) // invalid float string for std::stof
-    {
-        return std::nullopt;
-    }
-    catch (const std::out_of_range&) // out of range for 32 bit float
-    {
-        return std::nullopt;
-    }
+    return std::nullopt;
 }
 
 std::optional<int> Config::readInt(std::string section, std::string key)
 {
-    auto value = readString(section, key);
-    if (!value.has_value())
-        return std::nullopt;
+    if (auto value = readString(section, key); value.has_value())
+        return ConfigText::Parse<int>(value.value());
 
-    const auto& s = *value;
-    try
-    {
-        size_t idx = 0;
-        int result;
-
-        // detect hex prefix
-        if (s.size() > 2 && (s[0] == '0') && (s[1] == 'x' || s[1] == 'X'))
-        {
-            result = std::stoi(s, &idx, 16);
-        }
-        else
-        {
-            result = std::stoi(s, &idx, 10);
-        }
-
-        // ensure we consumed the whole string
-        if (idx == s.size())
-            return result;
-        else
-            return std::nullopt;
-    }
-    catch (const std::bad_optional_access&) // missing or auto value
-    {
-        return std::nullopt;
-    }
-    catch (const std::invalid_argument&) // invalid float string for std::stof
-    {
-        return std::nullopt;
-    }
-    catch (const std::out_of_range&) // out// out of range for 32 bit float
-    {
-        return std::nullopt;
-    }
+    return std::nullopt;
 }
 
 std::optional<uint32_t> Config::readUInt(std::string section, std::string key)
 {
-    auto value = readString(section, key);
-    if (!value.has_value())
-        return std::nullopt;
+    if (auto value = readString(section, key); value.has_value())
+        return ConfigText::Parse<uint32_t>(value.value());
 
-    const auto& s = *value;
-    try
-    {
-        size_t idx = 0;
-        int result;
-
-        // detect hex prefix
-        if (s.size() > 2 && (s[0] == '0') && (s[1] == 'x' || s[1] == 'X'))
-        {
-            result = std::stoi(s, &idx, 16);
-        }
-        else
-        {
-            result = std::stoi(s, &idx, 10);
-        }
-
-        // ensure we consumed the whole string
-        if (idx == s.size())
-            return result;
-        else
-            return std::nullopt;
-    }
-    catch (const std::bad_optional_access&) // missing or auto value
-    {
-        return std::nullopt;
-    }
-    catch (const std::invalid_argument&) // invalid float string for std::stof
-    {
-        return std::nullopt;
-    }
-    catch (const std::out_of_range&) // out// out of range for 32 bit float
-    {
-        return std::nullopt;
-    }
+    return std::nullopt;
 }
 
 std::optional<bool> Config::readBool(std::string section, std::string key)
 {
-    auto value = readString(section, key, true);
-    if (value == "true")
-        return true;
-    else if (value == "false")
-        return false;
+    if (auto value = readString(section, key, true); value.has_value())
+        return ConfigText::Parse<bool>(value.value());
 
     return std::nullopt;
 }
@@ -1,149 +1,12 @@
 #pragma once
 #include "SysUtils.h"
 #include "State.h"
+#include "ConfigSchema.h"
+#include "CustomOptional.h"
 
 #include <optional>
 #include <filesystem>
 
-enum HasDefaultValue
-{
-    WithDefault,
-    NoDefault,
-    SoftDefault // Change always gets saved to the config
-};
-
-template <class T, HasDefaultValue defaultState = WithDefault> class CustomOptional : public std::optional<T>
-{
-  private:
-    T _defaultValue;
-    std::optional<T> _configIni;
-    bool _volatile;
-
-  public:
-    CustomOptional(T defaultValue)
-        requires(defaultState != NoDefault)
-        : std::optional<T>(), _defaultValue(std::move(defaultValue)), _configIni(std::nullopt), _volatile(false)
-    {
-    }
-
-    CustomOptional()
-        requires(defaultState == NoDefault)
-        : std::optional<T>(), _defaultValue(T {}), _configIni(std::nullopt), _volatile(false)
-    {
-    }
-
-    // Prevents a change from being saved to ini
-    constexpr void set_volatile_value(const T& value)
-    {
-        if (!_volatile)
-        { // make sure the previously set value is saved
-            if (this->has_value())
-                _configIni = this->value();
-            else
-                _configIni = std::nullopt;
-        }
-        _volatile = true;
-        std::optional<T>::operator=(value);
-    }
-
-    // Use this when first setting a CustomOptional
-    constexpr void set_from_config(const std::optional<T>& opt)
-    {
-        if (!this->has_value())
-        {
-            _configIni = opt;
-            std::optional<T>::operator=(opt);
-        }
-    }
-
-    constexpr CustomOptional& operator=(const T& value)
-    {
-        _volatile = false;
-        std::optional<T>::operator=(value);
-        return *this;
-    }
-
-    constexpr CustomOptional& operator=(T&& value)
-    {
-        _volatile = false;
-        std::optional<T>::operator=(std::move(value));
-        return *this;
-    }
-
-    constexpr CustomOptional& operator=(const std::optional<T>& opt)
-    {
-        _volatile = false;
-        std::optional<T>::operator=(opt);
-        return *this;
-    }
-
-    constexpr CustomOptional& operator=(std::optional<T>&& opt)
-    {
-        _volatile = false;
-        std::optional<T>::operator=(std::move(opt));
-        return *this;
-    }
-
-    // Needed for string literals for some reason
-    constexpr CustomOptional& operator=(const char* value)
-        requires std::same_as<T, std::string>
-    {
-        _volatile = false;
-        std::optional<T>::operator=(T(value));
-        return *this;
-    }
-
-    constexpr T value_or_default() const&
-        requires(defaultState != NoDefault)
-    {
-        return this->has_value() ? this->value() : _defaultValue;
-    }
-
-    constexpr T value_or_default() &&
-        requires(defaultState != NoDefault) {
-            return this->has_value() ? std::move(this->value()) : std::move(_defaultValue);
-        }
-
-        constexpr std::optional<T> value_for_config()
-            requires(defaultState == WithDefault)
-    {
-        if (_volatile)
-        {
-            if (_configIni != _defaultValue)
-                return _configIni;
-
-            return std::nullopt;
-        }
-
-        if (!this->has_value() || *this == _defaultValue)
-            return std::nullopt;
-
-        return this->value();
-    }
-
-    constexpr std::optional<T> value_for_config()
-        requires(defaultState != WithDefault)
-    {
-        if (_volatile)
-            return _configIni;
-
-        if (this->has_value())
-            return this->value();
-
-        return std::nullopt;
-    }
-
-    constexpr T value_for_config_or(T other)
-    {
-        auto option = value_for_config();
-
-        if (option.has_value())
-            return option.value();
-        else
-            return other;
-    }
-};
-
 constexpr inline int UnboundKey = -1;
 constexpr uint32_t NV_PRESET_LATEST = 0x00FFFFFF;
 
@@ -215,6 +78,7 @@ class Config
     CustomOptional<bool> LogSingleFile { true };
     CustomOptional<bool> LogAsync { false };
     CustomOptional<int> LogAsyncThreads { 4 };
+    CustomOptional<bool> ApiCaptureEnabled { false };
 
     // XeSS
     CustomOptional<bool> BuildPipelines { true };
@@ -310,6 +174,8 @@ class Config
     CustomOptional<float> MenuAccentColorR { 0.01f };
     CustomOptional<float> MenuAccentColorG { 0.18f };
     CustomOptional<float> MenuAccentColorB { 0.34f };
+    CustomOptional<int> MenuRefreshRate { 0 }; // 0 means rebuild every frame
+    CustomOptional<bool> HotReloadIni { true };
 
     // Hooks
     CustomOptional<bool> HookOriginalNvngxOnly { false };
@@ -323,6 +189,8 @@ class Config
     // DRS
     CustomOptional<bool> DrsMinOverrideEnabled { false };
     CustomOptional<bool> DrsMaxOverrideEnabled { false };
+    CustomOptional<bool> DynamicResolution { false };
+    CustomOptional<float> DynamicResolutionTargetMs { 16.667f };
 
     // Quality Overrides
     CustomOptional<bool> QualityRatioOverrideEnabled { false };
@@ -344,6 +212,9 @@ class Config
         L"edcefrenderprocess.exe"
     };
 
+    // Game Profiles
+    CustomOptional<bool> UseGameProfiles { true };
+
     // Hotfixes
     CustomOptional<bool> CheckForUpdate { true };
     CustomOptional<bool> DisableOverlays { false };
@@ -352,6 +223,8 @@ class Config
     CustomOptional<bool> MipmapBiasFixedOverride { false };
     CustomOptional<bool> MipmapBiasScaleOverride { false };
     CustomOptional<bool> MipmapBiasOverrideAll { false };
+    CustomOptional<bool> MipmapBiasAuto { false };
+    CustomOptional<bool> MipmapBiasLiveUpdate { false };
 
     CustomOptional<int, NoDefault> AnisotropyOverride; // disabled by default
     CustomOptional<bool> OverrideShaderSampler { true };
@@ -366,6 +239,7 @@ class Config
     CustomOptional<bool> RestoreGraphicSignature { false };
 
     CustomOptional<bool> UsePrecompiledShaders { false };
+    CustomOptional<bool> ReleaseIdleBuffersOnLowVram { true };
 
     CustomOptional<bool> UseGenericAppIdWithDlss { false };
     CustomOptional<bool> PreferDedicatedGpu { true };
@@ -384,11 +258,13 @@ class Config
     CustomOptional<Upscaler, SoftDefault> Dx11Upscaler { Upscaler::FSR22 };
     CustomOptional<Upscaler, SoftDefault> Dx12Upscaler { Upscaler::XeSS };
     CustomOptional<Upscaler, SoftDefault> VulkanUpscaler { Upscaler::FSR22 };
+    CustomOptional<bool> PrewarmUpscaler { false };
 
     // Output Scaling
     CustomOptional<bool> OutputScalingEnabled { false };
     CustomOptional<float> OutputScalingMultiplier { 1.5f };
     CustomOptional<Scaler> OutputScalingDownscaler { Scaler::FSR1 };
+    CustomOptional<bool> OutputScalingFusedPasses { false };
 
     // FSR
     CustomOptional<bool> FsrDebugView { false };
@@ -422,6 +298,7 @@ class Config
     // vulkanwdx12
     CustomOptional<bool> VulkanUseCopyForInputs { false };
     CustomOptional<bool> VulkanUseCopyForOutput { false };
+    CustomOptional<bool> VulkanElideStaticInputs { false };
 
     // NVAPI Override
     CustomOptional<bool> DisableFlipMetering { false };
@@ -508,6 +385,7 @@ class Config
     // OptiFG - Resource Tracking
     CustomOptional<bool> FGAlwaysTrackHeaps { false };
     CustomOptional<bool> FGResourceBlocking { false };
+    CustomOptional<bool> FGHudfixValidation { false };
     CustomOptional<bool> FGUseShards { false };
 
     // OptiFG - DLSS-D Depth scale
@@ -526,6 +404,7 @@ class Config
     CustomOptional<bool> FGFPTAllowHybridSpin { false };
     CustomOptional<int> FGFPTHybridSpinTime { 2 };
     CustomOptional<bool> FGFPTAllowWaitForSingleObjectOnFence { false };
+    CustomOptional<bool> FGFPTAutoTune { false };
 
     CustomOptional<bool> FSRFGSkipConfigForHudless { false };
     CustomOptional<bool> FSRFGSkipDispatchForHudless { false };
@@ -557,6 +436,7 @@ class Config
     CustomOptional<bool> FN_ForceLatencyFlex { false };
     CustomOptional<LFXMode> FN_LatencyFlexMode { LFXMode::Conservative };
     CustomOptional<ForceReflex> FN_ForceReflex { ForceReflex::InGame };
+    CustomOptional<bool> FN_GpuTimestamps { false };
 
     // Inputs
     CustomOptional<bool> EnableDlssInputs { true };
@@ -575,6 +455,7 @@ class Config
 
     // Framerate
     CustomOptional<float> FramerateLimit { 0.0f };
+    CustomOptional<bool> PresentProfiler { false };
 
     // HDR
     CustomOptional<bool> ForceHDR { false };
@@ -587,13 +468,35 @@ class Config
     CustomOptional<UINT> VsyncInterval { 0 };
 
     bool LoadFromPath(const wchar_t* InPath);
+
+    // Only changed values are written. SaveIni writes the file right away and returns false when it can't,
+    // SaveXeFG leaves the write to the config thread after a short delay
     bool SaveIni();
     bool SaveXeFG();
 
+    // Applies hot reloadable options which were changed by editing the ini, called on present
+    void ApplyIniChanges();
+
+    // Writes a pending save immediately, called on window close and swapchain / device release.
+    // Not on DLL detach, file IO under the loader lock can deadlock.
+    bool FlushSave();
+
+    // Game profile options fill the ones which are not set in ini, returns number of options applied
+    size_t ApplyProfileOptions(const std::vector<std::pair<std::string, std::string>>& options);
+
+    // "Section.Key" & value of options which are in use and can be shared between installs
+    std::vector<std::pair<std::string, std::string>> GetProfileOptions();
+
+    // Option table entry of a member, nullptr for options with custom parsing
+    const ConfigOption* FindOption(const void* member) const;
+
     void CheckUpscalerFiles();
 
     std::vector<std::string> GetConfigLog();
 
+    // Increased on every ini (re)load, for invalidating values cached from config
+    uint32_t Generation() const { return _generation; }
+
     static Config* Instance();
 
   private:
@@ -602,9 +505,27 @@ class Config
 
     std::filesystem::path absoluteFileName;
     std::wstring fileName = L"OptiScaler.ini";
+    uint32_t _generation = 0;
+
+    std::vector<ConfigOption> _schema;
+
+    // Guarded by the ini mutex in Config.cpp
+    std::optional<std::chrono::steady_clock::time_point> _saveDue;
+    std::filesystem::file_time_type _iniWriteTime {};
+    std::vector<std::pair<size_t, std::string>> _pendingValues; // Schema index, new ini value
+    std::atomic<bool> _hasPendingValues = false;
 
     bool Reload(std::filesystem::path iniPath);
 
+    void BuildSchema();
+    void WriteValues();
+    bool QueueSave();
+
+    void StartWorker();
+    void Worker();
+    bool WriteIni();
+    void CheckIniChanges();
+
     std::optional<std::string> readString(std::string section, std::string key, bool lowercase = false);
     std::optional<std::wstring> readWString(std::string section, std::string key, bool lowercase = false);
     std::optional<float> readFloat(std::string section, std::string key);
@@ -0,0 +1,114 @@
+#pragma once
+#include <SysUtils.h>
+
+#include <SimpleIni.h>
+#include <ankerl/unordered_dense.h>
+
+#include <filesystem>
+#include <string>
+
+// Ini file contents and, for every value, what was last loaded from or saved to the file.
+// Only values which changed since then are written, edits of other keys in the file survive a save.
+// Values waiting for a write are put back when the file is loaded again before the write happens.
+// Not thread safe, Config guards it with its ini mutex.
+class ConfigIni
+{
+  public:
+    // Keeps the current contents when the file can't be loaded
+    bool LoadFile(const std::filesystem::path& path)
+    {
+        if (_ini.LoadFile(path.c_str()) != SI_OK)
+            return false;
+
+        MergeUnsaved();
+        return true;
+    }
+
+    // Replaces the contents with data
+    bool LoadData(const std::string& data)
+    {
+        _ini.Reset();
+
+        if (_ini.LoadData(data) != SI_OK)
+            return false;
+
+        MergeUnsaved();
+        return true;
+    }
+
+    // Unsaved values are kept when the write fails
+    bool SaveFile(const std::filesystem::path& path)
+    {
+        if (_ini.SaveFile(path.c_str()) < 0)
+            return false;
+
+        _unsaved.clear();
+        return true;
+    }
+
+    const char* GetValue(const char* section, const char* key, const char* defaultValue) const
+    {
+        return _ini.GetValue(section, key, defaultValue);
+    }
+
+    // Forgets what was saved, followed by SetSaved for every value after a load
+    void ClearSaved()
+    {
+        _saved.clear();
+
+        for (const auto& [name, unsaved] : _unsaved)
+            _saved[name] = unsaved.Value;
+    }
+
+    // Value in use matches the file, nothing to write
+    void SetSaved(const char* section, const char* key, const std::string& value)
+    {
+        auto name = Name(section, key);
+
+        if (!_unsaved.contains(name))
+            _saved[name] = value;
+    }
+
+    // Sets the value when it differs from the saved one, returns true when it changed
+    bool Set(const char* section, const char* key, const std::string& value)
+    {
+        auto name = Name(section, key);
+        auto& saved = _saved[name];
+
+        if (saved == value)
+            return false;
+
+        _ini.SetValue(section, key, value.c_str());
+        _unsaved[name] = { section, key, value };
+        saved = value;
+
+        return true;
+    }
+
+    bool IsUnsaved(const char* section, const char* key) const { return _unsaved.contains(Name(section, key)); }
+    size_t Unsaved() const { return _unsaved.size(); }
+
+  private:
+    struct UnsavedValue
+    {
+        std::string Section;
+        std::string Key;
+        std::string Value;
+    };
+
+    static std::string Name(const char* section, const char* key) { return std::string(section) + "." + key; }
+
+    void MergeUnsaved()
+    {
+        for (const auto& [name, unsaved] : _unsaved)
+        {
+            LOG_DEBUG("Keeping unsaved {}: {}", name, unsaved.Value);
+            _ini.SetValue(unsaved.Section.c_str(), unsaved.Key.c_str(), unsaved.Value.c_str());
+            _saved[name] = unsaved.Value;
+        }
+    }
+
+    CSimpleIniA _ini;
+    ankerl::unordered_dense::map<std::string, std::string> _saved;
+    ankerl::unordered_dense::map<std::string, UnsavedValue> _unsaved;
+};
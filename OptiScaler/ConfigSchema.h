@@ -0,0 +1,210 @@
+#pragma once
+#include <SysUtils.h>
+
+#include <algorithm>
+#include <functional>
+#include <optional>
+#include <sstream>
+#include <string>
+
+// Ini text <-> option value conversions, missing keys & "auto" are empty optionals
+namespace ConfigText
+{
+inline std::string ToLower(std::string text)
+{
+    std::ranges::transform(text, text.begin(), [](unsigned char c) { return std::tolower(c); });
+    return text;
+}
+
+inline bool IsAuto(const std::string& text) { return ToLower(text) == "auto"; }
+
+template <typename T> std::optional<T> Parse(const std::string& text, bool lowercase = false)
+{
+    if (IsAuto(text))
+        return std::nullopt;
+
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        auto lower = ToLower(text);
+
+        if (lower == "true")
+            return true;
+        else if (lower == "false")
+            return false;
+
+        return std::nullopt;
+    }
+    else if constexpr (std::is_same_v<T, float>)
+    {
+        std::istringstream iss(text);
+        float value;
+
+        if ((iss >> value) && iss.eof())
+            return value;
+
+        return std::nullopt;
+    }
+    else if constexpr (std::is_integral_v<T>)
+    {
+        try
+        {
+            size_t idx = 0;
+            int value;
+
+            // detect hex prefix
+            if (text.size() > 2 && (text[0] == '0') && (text[1] == 'x' || text[1] == 'X'))
+                value = std::stoi(text, &idx, 16);
+            else
+                value = std::stoi(text, &idx, 10);
+
+            // ensure we consumed the whole string
+            if (idx == text.size())
+                return (T) value;
+
+            return std::nullopt;
+        }
+        catch (const std::invalid_argument&)
+        {
+            return std::nullopt;
+        }
+        catch (const std::out_of_range&)
+        {
+            return std::nullopt;
+        }
+    }
+    else if constexpr (std::is_same_v<T, std::string>)
+    {
+        return lowercase ? ToLower(text) : text;
+    }
+    else
+    {
+        static_assert(std::is_same_v<T, std::wstring>, "Unsupported config type");
+        return string_to_wstring(lowercase ? ToLower(text) : text);
+    }
+}
+
+template <typename T> std::string Format(const std::optional<T>& value)
+{
+    if (!value.has_value())
+        return "auto";
+
+    if constexpr (std::is_same_v<T, bool>)
+        return value.value() ? "true" : "false";
+    else if constexpr (std::is_arithmetic_v<T>)
+        return std::to_string(value.value());
+    else if constexpr (std::is_same_v<T, std::string>)
+        return value.value();
+    else
+        return wstring_to_string(value.value());
+}
+} // namespace ConfigText
+
+enum ConfigFlags : uint32_t
+{
+    ConfigFlags_None = 0,
+    ConfigFlags_Hot = 1 << 0,       // Applied when the ini is edited while the game is running
+    ConfigFlags_Lowercase = 1 << 1, // Strings are lowercased while loading
+};
+
+// One ini key bound to a Config member. Ranged options clamp loaded values into [min, max],
+// menu widgets of the option use the same range.
+// Only options which are read on every use should be Hot, others are applied on next start.
+class ConfigOption
+{
+  public:
+    template <typename O>
+    ConfigOption(const char* section, const char* key, O& option, uint32_t flags = ConfigFlags_None)
+        : _section(section), _key(key), _flags(flags), _member(&option)
+    {
+        Bind<O>(option, std::nullopt);
+    }
+
+    template <typename O>
+    ConfigOption(const char* section, const char* key, O& option, std::type_identity_t<typename O::value_type> min,
+                 std::type_identity_t<typename O::value_type> max, uint32_t flags = ConfigFlags_None)
+        : _section(section), _key(key), _flags(flags), _member(&option), _range(std::pair { (float) min, (float) max })
+    {
+        Bind<O>(option, std::pair { min, max });
+    }
+
+    const char* Section() const { return _section; }
+    const char* Key() const { return _key; }
+    bool IsHot() const { return (_flags & ConfigFlags_Hot) != 0; }
+
+    // Config member the option is bound to, for finding the option of a member
+    const void* Member() const { return _member; }
+
+    // [min, max] of ranged options
+    std::optional<std::pair<float, float>> Range() const { return _range; }
+
+    // First load, doesn't override values which are already set.
+    // Returns false when text is not a valid value for the option.
+    bool Load(const std::string& text) const { return _load(text, LoadMode::Config); }
+
+    // Hot reload, replaces the current value. Invalid text leaves the option untouched.
+    bool Apply(const std::string& text) const { return _load(text, LoadMode::Replace); }
+
+    // Game profile value, only used when the option is not set. It's volatile so it never ends up in the ini.
+    bool LoadDefault(const std::string& text) const { return _load(text, LoadMode::Default); }
+
+    // Ini text of the value which would be saved
+    std::string Text() const { return _text(false); }
+
+    // Ini text of the value in use, including volatile values
+    std::string CurrentText() const { return _text(true); }
+
+  private:
+    enum class LoadMode
+    {
+        Config,
+        Replace,
+        Default,
+    };
+
+    const char* _section;
+    const char* _key;
+    uint32_t _flags;
+    const void* _member;
+    std::optional<std::pair<float, float>> _range;
+
+    std::function<bool(const std::string&, LoadMode)> _load;
+    std::function<std::string(bool)> _text;
+
+    template <typename O>
+    void Bind(O& option, std::optional<std::pair<typename O::value_type, typename O::value_type>> range)
+    {
+        using T = typename O::value_type;
+
+        _load = [&option, range, lowercase = (_flags & ConfigFlags_Lowercase) != 0](const std::string& text,
+                                                                                     LoadMode mode)
+        {
+            auto value = ConfigText::Parse<T>(text, lowercase);
+
+            if (!value.has_value() && !ConfigText::IsAuto(text))
+                return false;
+
+            if constexpr (std::is_arithmetic_v<T>)
+            {
+                if (value.has_value() && range.has_value())
+                    value = std::clamp(value.value(), range->first, range->second);
+            }
+
+            if (mode == LoadMode::Replace)
+                option = value;
+            else if (mode == LoadMode::Config)
+                option.set_from_config(value);
+            else if (value.has_value() && !option.has_value())
+                option.set_volatile_value(value.value());
+
+            return true;
+        };
+
+        _text = [&option](bool current)
+        {
+            if (current)
+                return ConfigText::Format<T>(option);
+
+            return ConfigText::Format<T>(option.value_for_config());
+        };
+    }
+};
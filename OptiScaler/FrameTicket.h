@@ -0,0 +1,173 @@
+#pragma once
+
+#include <SysUtils.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+
+struct FrameTicketStats
+{
+    uint64_t Waits = 0;      // WaitFor calls
+    uint64_t FastPaths = 0;  // WaitFor calls that returned without blocking
+    uint64_t Timeouts = 0;   // WaitFor calls that gave up, their frame is dropped
+    uint64_t Untracked = 0;  // Begin calls that found every slot taken
+    uint64_t TotalWaitNs = 0;
+    uint64_t MaxWaitNs = 0;
+};
+
+// Ticket for ordering the present and the dispatch threads of FG
+// Present marks the frame FG is dispatching from it with Begin/End. The dispatch side of a new frame only
+// waits while a present of a frame with the same ring index (frame % BUFFER_COUNT) is in flight, that present
+// still reads the resources the new frame is about to overwrite. Only ring indices are compared, so a frame
+// count restarting with a new FG context can't make an in-flight present look finished.
+// Real and interpolated presents can overlap, each one takes its own slot
+class FrameTicket
+{
+  public:
+    static constexpr uint32_t Slots = 4;
+
+  private:
+    static constexpr uint64_t NoFrame = UINT64_MAX;
+
+    std::atomic<uint64_t> _inFlight[Slots] { NoFrame, NoFrame, NoFrame, NoFrame };
+    std::atomic<uint64_t> _completed { 0 };
+    std::atomic<uint32_t> _waiters { 0 };
+
+    std::mutex _mtx;
+    std::condition_variable _cv;
+
+    std::atomic<uint64_t> _waits { 0 };
+    std::atomic<uint64_t> _fastPaths { 0 };
+    std::atomic<uint64_t> _timeouts { 0 };
+    std::atomic<uint64_t> _untracked { 0 };
+    std::atomic<uint64_t> _totalWaitNs { 0 };
+    std::atomic<uint64_t> _maxWaitNs { 0 };
+
+    bool IsReady(uint64_t frame) const
+    {
+        for (auto& slot : _inFlight)
+        {
+            auto inFlight = slot.load(std::memory_order_seq_cst);
+
+            if (inFlight != NoFrame && inFlight % BUFFER_COUNT == frame % BUFFER_COUNT)
+                return false;
+        }
+
+        return true;
+    }
+
+  public:
+    // Returns the slot to pass to End, Slots when all of them are taken and the present isn't tracked
+    uint32_t Begin(uint64_t frame)
+    {
+        for (uint32_t i = 0; i < Slots; i++)
+        {
+            auto expected = NoFrame;
+
+            if (_inFlight[i].compare_exchange_strong(expected, frame, std::memory_order_seq_cst))
+                return i;
+        }
+
+        _untracked.fetch_add(1, std::memory_order_relaxed);
+        return Slots;
+    }
+
+    void End(uint32_t slot, uint64_t frame)
+    {
+        _completed.store(frame, std::memory_order_release);
+
+        if (slot < Slots)
+            _inFlight[slot].store(NoFrame, std::memory_order_seq_cst);
+
+        // Only touch the mutex when someone is actually sleeping on it
+        if (_waiters.load(std::memory_order_seq_cst) > 0)
+        {
+            std::scoped_lock lock(_mtx);
+            _cv.notify_all();
+        }
+    }
+
+    // Returns true when no present of a frame with the ring index of `frame` is in flight
+    // false when timeout is reached, caller should drop the frame instead of overwriting its resources
+    bool WaitFor(uint64_t frame, uint32_t timeoutMs = 100)
+    {
+        _waits.fetch_add(1, std::memory_order_relaxed);
+
+        if (IsReady(frame))
+        {
+            _fastPaths.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+
+        // Present calls are short, spin a little before going to sleep
+        for (size_t i = 0; i < 64; i++)
+        {
+            if (IsReady(frame))
+                break;
+
+            YieldProcessor();
+        }
+
+        bool ready = IsReady(frame);
+
+        if (!ready)
+        {
+            _waiters.fetch_add(1, std::memory_order_seq_cst);
+
+            {
+                std::unique_lock lock(_mtx);
+                ready = _cv.wait_for(lock, std::chrono::milliseconds(timeoutMs), [&] { return IsReady(frame); });
+            }
+
+            _waiters.fetch_sub(1, std::memory_order_seq_cst);
+        }
+
+        auto waitNs =
+            (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+                .count();
+
+        _totalWaitNs.fetch_add(waitNs, std::memory_order_relaxed);
+
+        auto maxWait = _maxWaitNs.load(std::memory_order_relaxed);
+        while (waitNs > maxWait && !_maxWaitNs.compare_exchange_weak(maxWait, waitNs, std::memory_order_relaxed))
+            ;
+
+        if (!ready)
+        {
+            _timeouts.fetch_add(1, std::memory_order_relaxed);
+            LOG_WARN("Timed out waiting for present of index: {}, frame: {}, last completed: {}",
+                     frame % BUFFER_COUNT, frame, _completed.load(std::memory_order_relaxed));
+        }
+
+        return ready;
+    }
+
+    // Frame of the last finished present
+    uint64_t Completed() const { return _completed.load(std::memory_order_acquire); }
+
+    FrameTicketStats GetStats() const
+    {
+        FrameTicketStats stats {};
+        stats.Waits = _waits.load(std::memory_order_relaxed);
+        stats.FastPaths = _fastPaths.load(std::memory_order_relaxed);
+        stats.Timeouts = _timeouts.load(std::memory_order_relaxed);
+        stats.Untracked = _untracked.load(std::memory_order_relaxed);
+        stats.TotalWaitNs = _totalWaitNs.load(std::memory_order_relaxed);
+        stats.MaxWaitNs = _maxWaitNs.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void ResetStats()
+    {
+        _waits.store(0, std::memory_order_relaxed);
+        _fastPaths.store(0, std::memory_order_relaxed);
+        _timeouts.store(0, std::memory_order_relaxed);
+        _untracked.store(0, std::memory_order_relaxed);
+        _totalWaitNs.store(0, std::memory_order_relaxed);
+        _maxWaitNs.store(0, std::memory_order_relaxed);
+    }
+};
@@ -7,6 +7,7 @@
 #include <ankerl/unordered_dense.h>
 #include <misc/IdentifyGpu.h>
 #include <framegen/nvngx/Nvngx_FG.h>
+#include <misc/DynamicResolution.h>
 
 /// @brief Calculates the resolution scaling ratio override based on the provided quality level and current
 /// configuration.
@@ -16,6 +17,13 @@ std::optional<float> GetQualityOverrideRatio(const NVSDK_NGX_PerfQuality_Value i
 {
     std::optional<float> output;
 
+    // DLAA is asked for native resolution explicitly
+    if (auto dynamicRatio = DynamicResolution::LiveRatio();
+        dynamicRatio.has_value() && input != NVSDK_NGX_PerfQuality_Value_DLAA)
+    {
+        return dynamicRatio;
+    }
+
     auto sliderLimit = Config::Instance()->ExtendedLimits.value_or_default() ? 0.1f : 1.0f;
 
     if (Config::Instance()->UpscaleRatioOverrideEnabled.value_or_default() &&
@@ -75,6 +83,32 @@ std::optional<float> GetQualityOverrideRatio(const NVSDK_NGX_PerfQuality_Value i
     return output;
 }
 
+/// @brief Passes the DRS range written to the optimal settings to the dynamic resolution controller, so it only picks
+/// render sizes the game was told it can use.
+/// @param InParams Parameter table the DRS min / max render sizes were written to.
+/// @param Width Display width of the query.
+/// @param input The performance quality value of the query, DLAA queries don't limit the controller.
+static void ReportDrsRange(NVSDK_NGX_Parameter* InParams, unsigned int Width, const NVSDK_NGX_PerfQuality_Value input)
+{
+    unsigned int drsMinWidth = 0;
+    unsigned int drsMaxWidth = 0;
+
+    if (input == NVSDK_NGX_PerfQuality_Value_DLAA)
+        return;
+
+    auto minResult = InParams->Get(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Min_Render_Width, &drsMinWidth);
+    auto maxResult = InParams->Get(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Max_Render_Width, &drsMaxWidth);
+
+    if (minResult != NVSDK_NGX_Result_Success || maxResult != NVSDK_NGX_Result_Success)
+        return;
+
+    // Pinned range (DRS overrides) leaves nothing to pick from, keep the last one
+    if (drsMinWidth == 0 || drsMaxWidth <= drsMinWidth)
+        return;
+
+    DynamicResolution::SetAdvertisedRange((float) Width / (float) drsMaxWidth, (float) Width / (float) drsMinWidth);
+}
+
 NVNGX_Parameters::NVNGX_Parameters(std::string_view name, bool isPersistent) : Name(name)
 {
     // Old flag used to indicate custom table. Obsolete?
@@ -364,6 +398,19 @@ std::vector<std::string> NVNGX_Parameters::enumerate() const
     return keys;
 }
 
+std::vector<std::pair<std::string, Parameter>> NVNGX_Parameters::snapshot() const
+{
+    const std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector<std::pair<std::string, Parameter>> values;
+    values.reserve(m_values.size());
+
+    for (auto& value : m_values)
+        values.emplace_back(value.first, value.second);
+
+    return values;
+}
+
 template <typename T> void NVNGX_Parameters::setT(const char* key, T& value)
 {
     const std::lock_guard<std::mutex> lock(m_mutex);
@@ -528,6 +575,8 @@ NVSDK_NGX_Result NVSDK_CONV NVSDK_NGX_DLSS_GetOptimalSettingsCallback(NVSDK_NGX_
         }
     }
 
+    ReportDrsRange(InParams, Width, enumPQValue);
+
     InParams->Set(NVSDK_NGX_Parameter_SizeInBytes, Width * Height * 31);
     InParams->Set(NVSDK_NGX_Parameter_DLSSMode, NVSDK_NGX_DLSS_Mode_DLSS_DLISP);
 
@@ -671,6 +720,8 @@ NVSDK_NGX_Result NVSDK_CONV NVSDK_NGX_DLSSD_GetOptimalSettingsCallback(NVSDK_NGX
         InParams->Set(NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Max_Render_Height, Height);
     }
 
+    ReportDrsRange(InParams, Width, enumPQValue);
+
     InParams->Set(NVSDK_NGX_Parameter_SizeInBytes, Width * Height * 31);
     InParams->Set(NVSDK_NGX_Parameter_DLSSMode, NVSDK_NGX_DLSS_Mode_DLSS_DLISP);
 
@@ -224,6 +224,9 @@ struct NVNGX_Parameters : public NVSDK_NGX_Parameter
 
     std::vector<std::string> enumerate() const;
 
+    /// @brief Copies all key/value pairs under the lock, used by API capture.
+    std::vector<std::pair<std::string, Parameter>> snapshot() const;
+
   private:
     ankerl::unordered_dense::map<std::string, Parameter> m_values;
     mutable std::mutex m_mutex;
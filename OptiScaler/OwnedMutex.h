@@ -1,6 +1,6 @@
 #pragma once
 
-#include "SysUtils.h"
+#include <SysUtils.h>
 
 #include <atomic>
 #include <shared_mutex>
@@ -10,11 +10,13 @@ class OwnedMutex
   private:
     std::shared_mutex mtx;
     std::atomic<uint32_t> owner { 0 }; // don't use 0
+    std::atomic<DWORD> ownerThread { 0 };
 
   public:
     void lock(uint32_t _owner)
     {
         mtx.lock();
+        ownerThread.store(GetCurrentThreadId(), std::memory_order_relaxed);
         owner.store(_owner, std::memory_order_release);
     }
 
@@ -29,11 +31,23 @@ class OwnedMutex
             return;
         }
 
+        ownerThread.store(0, std::memory_order_relaxed);
         owner.store(0, std::memory_order_release);
         mtx.unlock();
     }
 
     uint32_t getOwner() { return owner.load(std::memory_order_seq_cst); }
+
+    // Only the owning thread can see its own id here, for everyone else the answer is false either way
+    bool isOwnedByThisThread()
+    {
+        return owner.load(std::memory_order_acquire) != 0 &&
+               ownerThread.load(std::memory_order_relaxed) == GetCurrentThreadId();
+    }
+
+    // Shared side doesn't set an owner, only blocks while an owner holds the mutex
+    void lock_shared() { mtx.lock_shared(); }
+    void unlock_shared() { mtx.unlock_shared(); }
 };
 
 class OwnedLockGuard
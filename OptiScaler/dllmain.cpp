@@ -47,6 +47,7 @@
 #include <cwctype>
 #include <version_check.h>
 #include <misc/IdentifyGpu.h>
+#include <misc/GameProfiles.h>
 #include <sha1/sha1.hpp>
 
 static std::vector<HMODULE> _asiHandles;
@@ -1239,6 +1240,48 @@ static void printQuirks(flag_set<GameQuirk>& quirks)
     return;
 }
 
+static void ApplyGameProfile(const std::string& exeName, const Util::version_t& productVersion,
+                             flag_set<GameQuirk>& quirks)
+{
+    auto& profiles = GameProfiles::Instance();
+    auto dir = Util::DllPath().parent_path();
+
+    // Exported profiles are loaded last to override the shipped ones
+    profiles.LoadFile(dir / GameProfiles::FileName);
+    profiles.LoadFile(dir / GameProfiles::UserFileName);
+
+    std::string version;
+
+    if (productVersion != Util::version_t {})
+    {
+        version = std::format("{}.{}.{}.{}", productVersion.major, productVersion.minor, productVersion.patch,
+                              productVersion.reserved);
+    }
+
+    auto hash = []()
+    {
+        SHA1 checksum;
+        std::ifstream file(Util::ExePath(), std::ios::binary);
+
+        checksum.update(file);
+        return checksum.final();
+    };
+
+    auto profile = profiles.Select(exeName, version, hash);
+
+    if (profile == nullptr)
+        return;
+
+    quirks |= profile->Quirks;
+    quirks &= ~profile->DisabledQuirks;
+
+    auto applied = Config::Instance()->ApplyProfileOptions(profile->Options);
+
+    LOG_INFO("Game profile: {} ({}), {} of {} options applied", profile->Name, profile->Source, applied,
+             profile->Options.size());
+    State::Instance().detectedQuirks.push_back(std::format("Game profile: {}", profile->Name));
+}
+
 static void CheckQuirks(bool isNvidia)
 {
     auto exePathFilename = Util::ExePath().filename().string();
@@ -1281,6 +1324,10 @@ static void CheckQuirks(bool isNvidia)
 
     auto quirks = getQuirksForExe(exePathFilename);
 
+    // Profile options come before quirks, so the quirks don't replace them
+    if (Config::Instance()->UseGameProfiles.value_or_default())
+        ApplyGameProfile(exePathFilename, productVersion, quirks);
+
     auto state = &State::Instance();
 
     // Apply config-level quirks
@@ -4,7 +4,9 @@
 
 int IFGFeature::GetIndex() { return (_frameCount % BUFFER_COUNT); }
 
-int IFGFeature::GetIndexWillBeDispatched()
+int IFGFeature::GetIndexWillBeDispatched() { return (FrameWillBeDispatched() % BUFFER_COUNT); }
+
+UINT64 IFGFeature::FrameWillBeDispatched()
 {
     UINT64 df;
 
@@ -29,7 +31,7 @@ int IFGFeature::GetIndexWillBeDispatched()
         df = _lastDispatchedFrame + 1; // Render next one
     }
 
-    return (df % BUFFER_COUNT);
+    return df;
 }
 
 UINT64 IFGFeature::StartNewFrame()
@@ -1,6 +1,7 @@
 #pragma once
 #include "SysUtils.h"
 #include <OwnedMutex.h>
+#include <FrameTicket.h>
 #include <dxgi1_6.h>
 #include <flag-set-cpp/flag_set.hpp>
 
@@ -95,6 +96,7 @@ class IFGFeature
 
   public:
     OwnedMutex Mutex;
+    FrameTicket PresentTicket;
 
     virtual feature_version Version() = 0;
     virtual const char* Name() = 0;
@@ -110,6 +112,7 @@ class IFGFeature
 
     int GetIndex();
     int GetIndexWillBeDispatched();
+    UINT64 FrameWillBeDispatched();
     UINT64 StartNewFrame();
 
     bool IsResourceReady(FG_ResourceType type, int index = -1);
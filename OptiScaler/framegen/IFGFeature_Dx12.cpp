@@ -2,6 +2,8 @@
 #include "IFGFeature_Dx12.h"
 #include <State.h>
 #include <Config.h>
+#include <misc/VramRegistry.h>
+#include <hudfix/Hudfix_Dx12.h>
 
 #include <magic_enum.hpp>
 
@@ -251,6 +253,56 @@ void IFGFeature_Dx12::FlipResource(Dx12Resource* resource)
     }
 }
 
+void IFGFeature_Dx12::ValidateHudless(ID3D12GraphicsCommandList* cmdList, int fIndex, ID3D12Resource* hudless,
+                                      D3D12_RESOURCE_STATES hudlessState, ID3D12Resource* present,
+                                      D3D12_RESOURCE_STATES presentState)
+{
+    if (!Config::Instance()->FGHudfixValidation.value_or_default() || hudless == nullptr)
+        return;
+
+    auto hudlessResource = GetResource(FG_ResourceType::HudlessColor, fIndex);
+
+    if (hudlessResource == nullptr)
+        return;
+
+    // Only hudless picked by Hudfix is validated, null when it's trusted or rejected already
+    auto source = Hudfix_Dx12::ValidationSource(fIndex, hudlessResource->resource);
+
+    if (source == nullptr)
+        return;
+
+    if (_hudlessValidate.get() == nullptr)
+    {
+        _hudlessValidate = std::make_unique<HV_Dx12>("HudlessValidate", _device);
+        return;
+    }
+
+    if (!_hudlessValidate->IsInit())
+        return;
+
+    // Don't reset the swapchain command list when there is nothing to validate
+    if (cmdList == nullptr)
+        cmdList = GetSCCommandList(fIndex);
+
+    if (cmdList == nullptr)
+        return;
+
+    if (present == nullptr)
+    {
+        _hudlessValidate->Dispatch((IDXGISwapChain3*) _swapChain, cmdList, hudless, hudlessState, (uint64_t) source);
+    }
+    else
+    {
+        _hudlessValidate->Dispatch(cmdList, hudless, hudlessState, present, presentState, (uint64_t) source);
+    }
+
+    uint64_t tag = 0;
+    HudlessStats stats {};
+
+    if (_hudlessValidate->GetResult(tag, stats))
+        Hudfix_Dx12::HudlessValidated((ID3D12Resource*) tag, stats);
+}
+
 bool IFGFeature_Dx12::CreateBufferResourceWithSize(ID3D12Device* device, ID3D12Resource* source,
                                                    D3D12_RESOURCE_STATES state, ID3D12Resource** target, UINT width,
                                                    UINT height, bool UAV, bool depth)
@@ -305,6 +357,7 @@ bool IFGFeature_Dx12::CreateBufferResourceWithSize(ID3D12Device* device, ID3D12R
     }
 
     LOG_DEBUG("Created new one: {}x{}", inDesc.Width, inDesc.Height);
+    VramRegistry::Instance().Track(*target, "Frame Generation", "Resource copy");
 
     return true;
 }
@@ -416,6 +469,7 @@ bool IFGFeature_Dx12::CreateBufferResource(ID3D12Device* device, ID3D12Resource*
     }
 
     LOG_DEBUG("Created new one: {}x{}", inDesc.Width, inDesc.Height);
+    VramRegistry::Instance().Track(*target, "Frame Generation", "Resource copy");
 
     return true;
 }
@@ -423,16 +477,7 @@ bool IFGFeature_Dx12::CreateBufferResource(ID3D12Device* device, ID3D12Resource*
 void IFGFeature_Dx12::ResourceBarrier(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* resource,
                                       D3D12_RESOURCE_STATES beforeState, D3D12_RESOURCE_STATES afterState)
 {
-    if (beforeState == afterState)
-        return;
-
-    D3D12_RESOURCE_BARRIER barrier = {};
-    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    barrier.Transition.pResource = resource;
-    barrier.Transition.StateBefore = beforeState;
-    barrier.Transition.StateAfter = afterState;
-    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-    cmdList->ResourceBarrier(1, &barrier);
+    ResourceTransition(cmdList, resource, beforeState, afterState);
 }
 
 bool IFGFeature_Dx12::CopyResource(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* source, ID3D12Resource** target,
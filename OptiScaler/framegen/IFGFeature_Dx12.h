@@ -6,6 +6,7 @@
 
 #include <shaders/resource_flip/RF_Dx12.h>
 #include <shaders/hudless_compare/HC_Dx12.h>
+#include <shaders/hudless_validate/HV_Dx12.h>
 #include <shaders/render_ui/RUI_Dx12.h>
 
 #include <dxgi1_6.h>
@@ -65,6 +66,7 @@ class IFGFeature_Dx12 : public virtual IFGFeature
     std::unique_ptr<RF_Dx12> _mvFlip;
     std::unique_ptr<RF_Dx12> _depthFlip;
     std::unique_ptr<HC_Dx12> _hudlessCompare;
+    std::unique_ptr<HV_Dx12> _hudlessValidate;
     std::unique_ptr<RUI_Dx12> _renderUI;
 
     bool CreateBufferResource(ID3D12Device* InDevice, ID3D12Resource* InSource, D3D12_RESOURCE_STATES InState,
@@ -79,6 +81,12 @@ class IFGFeature_Dx12 : public virtual IFGFeature
     void NewFrame() override final;
     void FlipResource(Dx12Resource* resource);
 
+    // Compares hudless picked by Hudfix with the final image.
+    // present == nullptr uses the swapchain backbuffer, cmdList == nullptr the swapchain command list
+    void ValidateHudless(ID3D12GraphicsCommandList* cmdList, int fIndex, ID3D12Resource* hudless,
+                         D3D12_RESOURCE_STATES hudlessState, ID3D12Resource* present = nullptr,
+                         D3D12_RESOURCE_STATES presentState = D3D12_RESOURCE_STATE_PRESENT);
+
   protected:
     virtual void ReleaseObjects() = 0;
     virtual void CreateObjects(ID3D12Device* InDevice) = 0;
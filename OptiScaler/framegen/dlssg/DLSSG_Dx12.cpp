@@ -611,10 +611,6 @@ void DLSSG_Dx12::EvaluateState(ID3D12Device* device, FG_Constants& fgConstants)
 
         // Pause for 10 frames
         UpdateTarget();
-
-        // Release FG mutex
-        if (Mutex.getOwner() == 2)
-            Mutex.unlockThis(2);
     }
 
     state.SCchanged = false;
@@ -633,6 +629,7 @@ void DLSSG_Dx12::ReleaseObjects()
 
     _renderUI.reset();
     _hudlessCompare.reset();
+    _hudlessValidate.reset();
     _mvFlip.reset();
     _depthFlip.reset();
 }
@@ -766,6 +763,18 @@ bool DLSSG_Dx12::Present()
 
     if (IsActive() && !IsPaused())
     {
+        // Before the debug overlay, it draws into the backbuffer
+        if (Config::Instance()->FGHudfixValidation.value_or_default())
+        {
+            auto hudless = GetResource(FG_ResourceType::HudlessColor, fIndex);
+            if (hudless != nullptr && (hudless->validity == FG_ResourceValidity::UntilPresent ||
+                                       hudless->validity == FG_ResourceValidity::JustTrackCmdlist ||
+                                       hudless->validity == FG_ResourceValidity::UntilPresentFromDispatch))
+            {
+                ValidateHudless(nullptr, fIndex, hudless->GetResource(), hudless->state);
+            }
+        }
+
         if (State::Instance().FGHudlessCompare)
         {
             auto hudless = GetResource(FG_ResourceType::HudlessColor, fIndex);
@@ -115,16 +115,7 @@ inline static bool CompareResourceFormats(DXGI_FORMAT sc, DXGI_FORMAT hudless)
 static inline void ResourceBarrier(ID3D12GraphicsCommandList* InCommandList, ID3D12Resource* InResource,
                                    D3D12_RESOURCE_STATES InBeforeState, D3D12_RESOURCE_STATES InAfterState)
 {
-    if (InBeforeState == InAfterState)
-        return;
-
-    D3D12_RESOURCE_BARRIER barrier = {};
-    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    barrier.Transition.pResource = InResource;
-    barrier.Transition.StateBefore = InBeforeState;
-    barrier.Transition.StateAfter = InAfterState;
-    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-    InCommandList->ResourceBarrier(1, &barrier);
+    ResourceTransition(InCommandList, InResource, InBeforeState, InAfterState);
 }
 
 bool FSRFG_Dx12::HudlessFormatTransfer(int index, ID3D12Device* device, DXGI_FORMAT targetFormat,
@@ -158,11 +149,12 @@ bool FSRFG_Dx12::HudlessFormatTransfer(int index, ID3D12Device* device, DXGI_FOR
 
             resource->cmdList->CopyResource(_hudlessCopyResource[index], resource->GetResource());
 
-            ResourceBarrier(resource->cmdList, resource->GetResource(), D3D12_RESOURCE_STATE_COPY_SOURCE,
-                            resource->state);
-
-            ResourceBarrier(resource->cmdList, _hudlessCopyResource[index], D3D12_RESOURCE_STATE_COPY_DEST,
-                            D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+            {
+                BarrierBatch barriers(resource->cmdList);
+                barriers.Transition(resource->GetResource(), D3D12_RESOURCE_STATE_COPY_SOURCE, resource->state);
+                barriers.Transition(_hudlessCopyResource[index], D3D12_RESOURCE_STATE_COPY_DEST,
+                                    D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+            }
 
             _hudlessTransfer[index].get()->Dispatch(cmdList, _hudlessCopyResource[index],
                                                     _hudlessTransfer[index].get()->Buffer());
@@ -643,7 +635,9 @@ ffxReturnCode_t FSRFG_Dx12::DispatchCallback(ffxDispatchDescFrameGeneration* par
     bool applyHudCutoff = Config::Instance()->FGHudCutoff.value_or_default() > 0.0f ||
                           State::Instance().gameQuirks & GameQuirk::FSRFGHudlessMismatchFixup;
 
-    if ((applyHudCutoff || State::Instance().FGHudlessCompare) && !lastFGDisableHudless)
+    bool validateHudless = Config::Instance()->FGHudfixValidation.value_or_default();
+
+    if ((applyHudCutoff || validateHudless || State::Instance().FGHudlessCompare) && !lastFGDisableHudless)
     {
         auto presentWithHud = (ID3D12Resource*) params->presentColor.resource;
         auto hudlessResource = _resourceCopy[fIndex][FG_ResourceType::HudlessColor];
@@ -664,6 +658,13 @@ ffxReturnCode_t FSRFG_Dx12::DispatchCallback(ffxDispatchDescFrameGeneration* par
         {
             auto cmdList = (ID3D12GraphicsCommandList*) params->commandList;
 
+            // Before HudCopy, it changes the hudless
+            if (validateHudless)
+            {
+                ValidateHudless(cmdList, fIndex, hudlessResource, hudlessState, presentWithHud,
+                                GetD3D12State((FfxApiResourceState) params->presentColor.state));
+            }
+
             if (applyHudCutoff)
             {
                 if (_hudCopy[fIndex].get() == nullptr)
@@ -1272,10 +1273,6 @@ void FSRFG_Dx12::EvaluateState(ID3D12Device* device, FG_Constants& fgConstants)
 
         // Pause for 10 frames
         UpdateTarget();
-
-        // Release FG mutex
-        if (Mutex.getOwner() == 2)
-            Mutex.unlockThis(2);
     }
 
     State::Instance().SCchanged = false;
@@ -1295,6 +1292,7 @@ void FSRFG_Dx12::ReleaseObjects()
 
     _renderUI.reset();
     _hudlessCompare.reset();
+    _hudlessValidate.reset();
     _mvFlip.reset();
     _depthFlip.reset();
 }
@@ -0,0 +1,373 @@
+#include "pch.h"
+#include "FramePaceAutoTune.h"
+
+#include <Config.h>
+
+#include <algorithm>
+#include <chrono>
+
+// Safe bounds of the tuned values
+static constexpr float MinSafetyMargin = 0.01f;
+static constexpr float MaxSafetyMargin = 1.0f;
+static constexpr float SafetyMarginStep = 0.05f;
+static constexpr float MinVarianceFactor = 0.1f;
+static constexpr float MaxVarianceFactor = 0.5f;
+static constexpr float VarianceFactorStep = 0.05f;
+static constexpr int MinHybridSpinTime = 2;
+
+// Hysteresis, in windows
+static constexpr uint32_t RaiseAfter = 2;
+static constexpr uint32_t LowerAfter = 3;
+static constexpr uint32_t StableAfter = 3;
+static constexpr uint32_t RetuneAfter = 3;
+
+// Trial settings are kept when they save at least this much CPU time...
+static constexpr double TrialMinCpuGain = 0.05;
+// ...and jitter doesn't get worse than this
+static constexpr double TrialMaxJitterLoss = 1.2;
+
+void FramePaceAutoTune::Reset(const FramePaceParams& initial)
+{
+    _params = initial;
+    _phase = Phase::TuneMargins;
+    _samples.clear();
+    _samples.reserve(WindowSize + 1);
+    _lastWindow = {};
+
+    // First window after (re)start is usually FG ramping up
+    _settleWindows = 1;
+    _headroomWindows = 0;
+    _stableWindows = 0;
+    _overTargetWindows = 0;
+    _lastChangeWasLower = false;
+    _lowerBlocked = false;
+}
+
+std::optional<FramePaceParams> FramePaceAutoTune::AddPresent(uint64_t timeNs, bool interpolated, uint64_t cpuNs)
+{
+    if (_samples.empty())
+        _windowCpuStart = cpuNs;
+
+    _samples.push_back({ timeNs, interpolated });
+    _windowCpuEnd = cpuNs;
+
+    if (_samples.size() <= WindowSize)
+        return std::nullopt;
+
+    _lastWindow = CalculateWindow();
+
+    // Last present starts the next window
+    auto last = _samples.back();
+    _samples.clear();
+    _samples.push_back(last);
+    _windowCpuStart = cpuNs;
+
+    if (_settleWindows > 0)
+    {
+        _settleWindows--;
+        return std::nullopt;
+    }
+
+    return Evaluate(_lastWindow);
+}
+
+FramePaceWindowStats FramePaceAutoTune::CalculateWindow() const
+{
+    FramePaceWindowStats window {};
+    window.Presents = (uint32_t) _samples.size();
+
+    std::vector<double> intervals;
+    intervals.reserve(_samples.size());
+
+    for (size_t i = 1; i < _samples.size(); i++)
+        intervals.push_back((_samples[i].TimeNs - _samples[i - 1].TimeNs) / 1000000.0);
+
+    if (intervals.empty())
+        return window;
+
+    auto sorted = intervals;
+    std::sort(sorted.begin(), sorted.end());
+    window.MedianIntervalMs = sorted[sorted.size() / 2];
+
+    if (window.MedianIntervalMs <= 0.0)
+        return window;
+
+    auto relativeStdDev = [&](bool interpolated)
+    {
+        double sum = 0.0;
+        double sumSq = 0.0;
+        uint32_t count = 0;
+
+        for (size_t i = 0; i < intervals.size(); i++)
+        {
+            if (_samples[i + 1].Interpolated != interpolated)
+                continue;
+
+            sum += intervals[i];
+            sumSq += intervals[i] * intervals[i];
+            count++;
+        }
+
+        if (count < 2)
+            return 0.0;
+
+        auto mean = sum / count;
+        auto variance = std::max(sumSq / count - mean * mean, 0.0);
+
+        return std::sqrt(variance) / window.MedianIntervalMs;
+    };
+
+    window.RealJitter = relativeStdDev(false);
+    window.InterpolatedJitter = relativeStdDev(true);
+    window.CpuMsPerPresent = (_windowCpuEnd - _windowCpuStart) / 1000000.0 / intervals.size();
+
+    return window;
+}
+
+bool FramePaceAutoTune::RaiseMargins()
+{
+    if (_params.VarianceFactor < MaxVarianceFactor)
+    {
+        _params.VarianceFactor = std::min(_params.VarianceFactor + VarianceFactorStep, MaxVarianceFactor);
+        return true;
+    }
+
+    if (_params.SafetyMarginInMs < MaxSafetyMargin)
+    {
+        _params.SafetyMarginInMs = std::min(_params.SafetyMarginInMs + SafetyMarginStep, MaxSafetyMargin);
+        return true;
+    }
+
+    return false;
+}
+
+bool FramePaceAutoTune::LowerMargins()
+{
+    if (_params.SafetyMarginInMs > MinSafetyMargin)
+    {
+        _params.SafetyMarginInMs = std::max(_params.SafetyMarginInMs - SafetyMarginStep, MinSafetyMargin);
+        return true;
+    }
+
+    if (_params.VarianceFactor > MinVarianceFactor)
+    {
+        _params.VarianceFactor = std::max(_params.VarianceFactor - VarianceFactorStep, MinVarianceFactor);
+        return true;
+    }
+
+    return false;
+}
+
+std::optional<FramePaceParams> FramePaceAutoTune::Evaluate(const FramePaceWindowStats& window)
+{
+    auto jitter = std::max(window.RealJitter, window.InterpolatedJitter);
+    auto changed = false;
+
+    // Starts the next trial which isn't enabled yet, or finishes tuning
+    auto startNextTrial = [&](Phase from, double baseCpuMs, double baseJitter)
+    {
+        _trialBase = _params;
+        _trialBaseCpuMs = baseCpuMs;
+        _trialBaseJitter = baseJitter;
+
+        if (from < Phase::TrialHybridSpin && !_params.AllowHybridSpin)
+        {
+            _params.AllowHybridSpin = true;
+            _params.HybridSpinTime = std::max(_params.HybridSpinTime, MinHybridSpinTime);
+            _phase = Phase::TrialHybridSpin;
+            changed = true;
+        }
+        else if (from < Phase::TrialWaitOnFence && !_params.AllowWaitForSingleObjectOnFence)
+        {
+            _params.AllowWaitForSingleObjectOnFence = true;
+            _phase = Phase::TrialWaitOnFence;
+            changed = true;
+        }
+        else
+        {
+            _phase = Phase::Converged;
+
+            LOG_INFO("FSR-FG frame pacing converged, interval: {:.2f} ms, jitter: {:.3f}, CPU: {:.2f} ms/present",
+                     window.MedianIntervalMs, jitter, window.CpuMsPerPresent);
+            LOG_INFO("FPTSafetyMarginInMs={:.2f} FPTVarianceFactor={:.2f} FPTHybridSpin={} FPTHybridSpinTime={} "
+                     "FPTWaitForSingleObjectOnFence={}",
+                     _params.SafetyMarginInMs, _params.VarianceFactor, _params.AllowHybridSpin,
+                     _params.HybridSpinTime, _params.AllowWaitForSingleObjectOnFence);
+        }
+    };
+
+    switch (_phase)
+    {
+    case Phase::TuneMargins:
+        if (jitter > TargetJitter)
+        {
+            _headroomWindows = 0;
+            _stableWindows = 0;
+
+            if (++_overTargetWindows < RaiseAfter)
+                break;
+
+            _overTargetWindows = 0;
+
+            // Lowering caused this, don't try it again
+            if (_lastChangeWasLower)
+                _lowerBlocked = true;
+
+            _lastChangeWasLower = false;
+
+            if (RaiseMargins())
+            {
+                changed = true;
+                break;
+            }
+
+            // Nothing more to raise, this is the best we can do
+            startNextTrial(Phase::TrialWaitOnFence, window.CpuMsPerPresent, jitter);
+        }
+        else if (jitter < TargetJitter * 0.5 && !_lowerBlocked)
+        {
+            _overTargetWindows = 0;
+            _stableWindows = 0;
+
+            if (++_headroomWindows < LowerAfter)
+                break;
+
+            _headroomWindows = 0;
+
+            if (LowerMargins())
+            {
+                _lastChangeWasLower = true;
+                changed = true;
+                break;
+            }
+
+            startNextTrial(Phase::TuneMargins, window.CpuMsPerPresent, jitter);
+        }
+        else
+        {
+            _overTargetWindows = 0;
+            _headroomWindows = 0;
+
+            if (++_stableWindows >= StableAfter)
+            {
+                _stableWindows = 0;
+                startNextTrial(Phase::TuneMargins, window.CpuMsPerPresent, jitter);
+            }
+        }
+
+        break;
+
+    case Phase::TrialHybridSpin:
+    case Phase::TrialWaitOnFence:
+    {
+        auto keep = window.CpuMsPerPresent < _trialBaseCpuMs * (1.0 - TrialMinCpuGain) &&
+                    jitter <= std::max(TargetJitter, _trialBaseJitter * TrialMaxJitterLoss);
+
+        LOG_DEBUG("{} trial, CPU: {:.3f} -> {:.3f} ms, jitter: {:.3f} -> {:.3f}, keeping: {}",
+                  _phase == Phase::TrialHybridSpin ? "Hybrid spin" : "WaitForSingleObjectOnFence", _trialBaseCpuMs,
+                  window.CpuMsPerPresent, _trialBaseJitter, jitter, keep);
+
+        auto trialPhase = _phase;
+
+        if (keep)
+        {
+            startNextTrial(trialPhase, window.CpuMsPerPresent, jitter);
+        }
+        else
+        {
+            _params = _trialBase;
+            changed = true;
+            startNextTrial(trialPhase, _trialBaseCpuMs, _trialBaseJitter);
+        }
+
+        break;
+    }
+
+    case Phase::Converged:
+        if (jitter > TargetJitter * 2.0)
+        {
+            if (++_overTargetWindows >= RetuneAfter)
+            {
+                LOG_INFO("FSR-FG frame pacing jitter went up to {:.3f}, tuning again", jitter);
+
+                _overTargetWindows = 0;
+                _lowerBlocked = false;
+                _lastChangeWasLower = false;
+                _phase = Phase::TuneMargins;
+            }
+        }
+        else
+        {
+            _overTargetWindows = 0;
+        }
+
+        break;
+    }
+
+    if (!changed)
+        return std::nullopt;
+
+    // Let the new values take effect before measuring again
+    _settleWindows = 1;
+
+    return _params;
+}
+
+void FramePaceAutoTune::OnPresent(bool interpolated, bool fgActive)
+{
+    static std::optional<FramePaceAutoTune> live;
+
+    auto& cfg = *Config::Instance();
+
+    if (!fgActive || !cfg.FGFPTAutoTune.value_or_default() || !cfg.FGFramePacingTuning.value_or_default())
+    {
+        live.reset();
+        return;
+    }
+
+    if (!live.has_value())
+    {
+        FramePaceParams params {};
+        params.SafetyMarginInMs = cfg.FGFPTSafetyMarginInMs.value_or_default();
+        params.VarianceFactor = cfg.FGFPTVarianceFactor.value_or_default();
+        params.AllowHybridSpin = cfg.FGFPTAllowHybridSpin.value_or_default();
+        params.HybridSpinTime = cfg.FGFPTHybridSpinTime.value_or_default();
+        params.AllowWaitForSingleObjectOnFence = cfg.FGFPTAllowWaitForSingleObjectOnFence.value_or_default();
+
+        live.emplace(params);
+        LOG_INFO("FSR-FG frame pacing auto tune started");
+    }
+
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    uint64_t cpuNs = 0;
+
+    if (GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime))
+    {
+        auto kernel = ((uint64_t) kernelTime.dwHighDateTime << 32) | kernelTime.dwLowDateTime;
+        auto user = ((uint64_t) userTime.dwHighDateTime << 32) | userTime.dwLowDateTime;
+        cpuNs = (kernel + user) * 100;
+    }
+
+    auto nowNs = (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     std::chrono::steady_clock::now().time_since_epoch())
+                     .count();
+
+    auto params = live->AddPresent(nowNs, interpolated, cpuNs);
+
+    if (!params.has_value())
+        return;
+
+    LOG_DEBUG("Applying SafetyMargin: {:.2f}, VarianceFactor: {:.2f}, HybridSpin: {}, HybridSpinTime: {}, "
+              "WaitForSingleObjectOnFence: {}",
+              params->SafetyMarginInMs, params->VarianceFactor, params->AllowHybridSpin, params->HybridSpinTime,
+              params->AllowWaitForSingleObjectOnFence);
+
+    // Volatile so tuned values are only saved when user sets them
+    cfg.FGFPTSafetyMarginInMs.set_volatile_value(params->SafetyMarginInMs);
+    cfg.FGFPTVarianceFactor.set_volatile_value(params->VarianceFactor);
+    cfg.FGFPTAllowHybridSpin.set_volatile_value(params->AllowHybridSpin);
+    cfg.FGFPTHybridSpinTime.set_volatile_value(params->HybridSpinTime);
+    cfg.FGFPTAllowWaitForSingleObjectOnFence.set_volatile_value(params->AllowWaitForSingleObjectOnFence);
+
+    State::Instance().FSRFGFTPchanged = true;
+}
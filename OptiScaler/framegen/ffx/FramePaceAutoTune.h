@@ -0,0 +1,95 @@
+#pragma once
+#include "SysUtils.h"
+
+#include <optional>
+#include <vector>
+
+// Mirrors the tunable fields of FfxSwapchainFramePacingTuning
+struct FramePaceParams
+{
+    float SafetyMarginInMs = 0.01f;
+    float VarianceFactor = 0.3f;
+    bool AllowHybridSpin = false;
+    int HybridSpinTime = 2;
+    bool AllowWaitForSingleObjectOnFence = false;
+};
+
+struct FramePaceWindowStats
+{
+    uint32_t Presents = 0;
+    double MedianIntervalMs = 0.0;
+    double RealJitter = 0.0;         // stddev / median of intervals ending with a real frame
+    double InterpolatedJitter = 0.0; // stddev / median of intervals ending with an interpolated frame
+    double CpuMsPerPresent = 0.0;
+};
+
+// Closed loop tuning of FSR-FG frame pacing. Collects present timestamps over a window,
+// raises safety margin / variance factor while the present interval jitter is over the target,
+// lowers them again with hysteresis when there is headroom, then trials hybrid spin and
+// WaitForSingleObjectOnFence and keeps them only when they lower the CPU cost without hurting jitter.
+// Doesn't touch any global state, so recorded present traces can be replayed through AddPresent.
+class FramePaceAutoTune
+{
+  public:
+    enum class Phase : uint32_t
+    {
+        TuneMargins,
+        TrialHybridSpin,
+        TrialWaitOnFence,
+        Converged
+    };
+
+    static constexpr uint32_t WindowSize = 240;
+
+    // Relative jitter (interval stddev / median interval) aimed for
+    static constexpr double TargetJitter = 0.05;
+
+    explicit FramePaceAutoTune(const FramePaceParams& initial) { Reset(initial); }
+
+    void Reset(const FramePaceParams& initial);
+
+    // timeNs is the present time, cpuNs is the process CPU time at that point.
+    // Returns new parameters when they should be applied.
+    std::optional<FramePaceParams> AddPresent(uint64_t timeNs, bool interpolated, uint64_t cpuNs);
+
+    const FramePaceParams& Params() const { return _params; }
+    const FramePaceWindowStats& LastWindow() const { return _lastWindow; }
+    Phase CurrentPhase() const { return _phase; }
+
+    // Live tuning from the present path, applies changes to config and requests reconfiguration of FSR-FG
+    static void OnPresent(bool interpolated, bool fgActive);
+
+  private:
+    FramePaceWindowStats CalculateWindow() const;
+    std::optional<FramePaceParams> Evaluate(const FramePaceWindowStats& window);
+
+    bool RaiseMargins();
+    bool LowerMargins();
+
+    FramePaceParams _params {};
+    Phase _phase = Phase::TuneMargins;
+
+    struct Sample
+    {
+        uint64_t TimeNs;
+        bool Interpolated;
+    };
+
+    std::vector<Sample> _samples;
+    uint64_t _windowCpuStart = 0;
+    uint64_t _windowCpuEnd = 0;
+    FramePaceWindowStats _lastWindow {};
+
+    // Hysteresis
+    uint32_t _settleWindows = 0;
+    uint32_t _headroomWindows = 0;
+    uint32_t _stableWindows = 0;
+    uint32_t _overTargetWindows = 0;
+    bool _lastChangeWasLower = false;
+    bool _lowerBlocked = false;
+
+    // Trials
+    FramePaceParams _trialBase {};
+    double _trialBaseCpuMs = 0.0;
+    double _trialBaseJitter = 0.0;
+};
@@ -7,6 +7,7 @@
 #include <magic_enum.hpp>
 
 #include <resource_tracking/ResTrack_Dx12.h>
+#include <upscalers/Prewarm_Dx12.h>
 
 #include <proxies/D3D12_Proxy.h>
 #include <proxies/XeFG_Proxy.h>
@@ -19,6 +20,7 @@
 
 #include <dxgi1_6.h>
 #include <misc/IdentifyGpu.h>
+#include <misc/SamplerRegistry.h>
 
 #include "Hook_Utils.h"
 
@@ -30,6 +32,9 @@ using PFN_CreateCommittedResource = rewrite_signature<decltype(&ID3D12Device::Cr
 using PFN_CreatePlacedResource = rewrite_signature<decltype(&ID3D12Device::CreatePlacedResource)>::type;
 using PFN_SetResidencyPriority = rewrite_signature<decltype(&ID3D12Device1::SetResidencyPriority)>::type;
 using PFN_CreateRootSignature = rewrite_signature<decltype(&ID3D12Device::CreateRootSignature)>::type;
+using PFN_CreateDescriptorHeap = rewrite_signature<decltype(&ID3D12Device::CreateDescriptorHeap)>::type;
+using PFN_CopyDescriptors = rewrite_signature<decltype(&ID3D12Device::CopyDescriptors)>::type;
+using PFN_CopyDescriptorsSimple = rewrite_signature<decltype(&ID3D12Device::CopyDescriptorsSimple)>::type;
 
 // GetResourceAllocationInfo is a special case because of the struct return,
 // see comment on hkGetResourceAllocationInfo for details
@@ -51,6 +56,9 @@ static PFN_CreatePlacedResource o_CreatePlacedResource = nullptr;
 static PFN_SetResidencyPriority o_SetResidencyPriority = nullptr;
 static PFN_GetResourceAllocationInfo o_GetResourceAllocationInfo = nullptr;
 static PFN_CreateRootSignature o_CreateRootSignature = nullptr;
+static PFN_CreateDescriptorHeap o_CreateDescriptorHeap = nullptr;
+static PFN_CopyDescriptors o_CopyDescriptors = nullptr;
+static PFN_CopyDescriptorsSimple o_CopyDescriptorsSimple = nullptr;
 static PFN_D3D12GetInterface o_D3D12GetInterface = nullptr;
 static PFN_CreateDevice o_CreateDevice = nullptr;
 
@@ -248,6 +256,98 @@ static void ApplySamplerOverrides(D3D12_STATIC_SAMPLER_DESC1& samplerDesc)
     }
 }
 
+// Fixed bias from render / display ratio of the current feature, follows DRS
+static std::optional<float> AutoMipmapBias()
+{
+    if (!Config::Instance()->MipmapBiasAuto.value_or_default())
+        return std::nullopt;
+
+    auto feature = State::Instance().currentFeature;
+
+    if (feature == nullptr || feature->IsFrozen() || feature->RenderWidth() == 0)
+        return std::nullopt;
+
+    return SamplerRegistry::RatioBias(feature->RenderWidth(), feature->DisplayWidth());
+}
+
+// Everything ApplySamplerOverrides depends on, staged samplers are rewritten when it changes
+struct SamplerSettings
+{
+    std::optional<float> Bias;
+    std::optional<float> AutoBias;
+    std::optional<int> Anisotropy;
+    bool Fixed = false;
+    bool Scale = false;
+    bool All = false;
+    bool ModifyComp = false;
+    bool ModifyMinMax = false;
+    bool SkipPoint = false;
+
+    bool operator==(const SamplerSettings& other) const = default;
+};
+
+static SamplerSettings CurrentSamplerSettings()
+{
+    auto config = Config::Instance();
+
+    SamplerSettings settings {};
+    settings.Bias = config->MipmapBiasOverride;
+    settings.AutoBias = AutoMipmapBias();
+    settings.Anisotropy = config->AnisotropyOverride;
+    settings.Fixed = config->MipmapBiasFixedOverride.value_or_default();
+    settings.Scale = config->MipmapBiasScaleOverride.value_or_default();
+    settings.All = config->MipmapBiasOverrideAll.value_or_default();
+    settings.ModifyComp = config->AnisotropyModifyComp.value_or_default();
+    settings.ModifyMinMax = config->AnisotropyModifyMinMax.value_or_default();
+    settings.SkipPoint = config->AnisotropySkipPointFilter.value_or_default();
+
+    return settings;
+}
+
+static void ApplySamplerOverrides(D3D12_SAMPLER_DESC& samplerDesc)
+{
+    if (Config::Instance()->AnisotropyOverride.has_value())
+    {
+        LOG_DEBUG("Overriding {2:X} to anisotropic filtering {0} -> {1}", samplerDesc.MaxAnisotropy,
+                  Config::Instance()->AnisotropyOverride.value(), (UINT) samplerDesc.Filter);
+
+        samplerDesc.Filter = UpgradeToAF(samplerDesc.Filter);
+        samplerDesc.MaxAnisotropy = Config::Instance()->AnisotropyOverride.value();
+    }
+
+    if ((samplerDesc.MipLODBias < 0.0f && samplerDesc.MinLOD != samplerDesc.MaxLOD) ||
+        Config::Instance()->MipmapBiasOverrideAll.value_or_default())
+    {
+        if (auto autoBias = AutoMipmapBias(); autoBias.has_value())
+        {
+            LOG_DEBUG("Overriding mipmap bias {0} -> {1} (auto)", samplerDesc.MipLODBias, autoBias.value());
+            samplerDesc.MipLODBias =
+                SamplerRegistry::OverrideBias(samplerDesc.MipLODBias, autoBias.value(), SamplerBiasMode::Fixed);
+        }
+        else if (Config::Instance()->MipmapBiasOverride.has_value())
+        {
+            LOG_DEBUG("Overriding mipmap bias {0} -> {1}", samplerDesc.MipLODBias,
+                      Config::Instance()->MipmapBiasOverride.value());
+
+            auto mode = SamplerBiasMode::Add;
+
+            if (Config::Instance()->MipmapBiasFixedOverride.value_or_default())
+                mode = SamplerBiasMode::Fixed;
+            else if (Config::Instance()->MipmapBiasScaleOverride.value_or_default())
+                mode = SamplerBiasMode::Scale;
+
+            samplerDesc.MipLODBias = SamplerRegistry::OverrideBias(
+                samplerDesc.MipLODBias, Config::Instance()->MipmapBiasOverride.value(), mode);
+        }
+
+        if (State::Instance().lastMipBiasMax < samplerDesc.MipLODBias)
+            State::Instance().lastMipBiasMax = samplerDesc.MipLODBias;
+
+        if (State::Instance().lastMipBias > samplerDesc.MipLODBias)
+            State::Instance().lastMipBias = samplerDesc.MipLODBias;
+    }
+}
+
 VALIDATE_HOOK(hkSetComputeRootSignature, PFN_SetComputeRootSignature)
 static void hkSetComputeRootSignature(ID3D12GraphicsCommandList* commandList, ID3D12RootSignature* pRootSignature)
 {
@@ -772,6 +872,7 @@ static ULONG hkD3D12DeviceRelease(IUnknown* device)
         {
             LOG_DEBUG("Set State::Instance().currentD3D12Device = nullptr, was: {:X}", (size_t) device);
             State::Instance().currentD3D12Device = nullptr;
+            Config::Instance()->FlushSave();
         }
     }
 
@@ -935,45 +1036,109 @@ static void hkCreateSampler(ID3D12Device* device, const D3D12_SAMPLER_DESC* pDes
         return;
 
     D3D12_SAMPLER_DESC newDesc = *pDesc;
+    ApplySamplerOverrides(newDesc);
 
-    if (Config::Instance()->AnisotropyOverride.has_value())
+    // Registry lock is only taken when live update is enabled and the game has staging sampler heaps
+    if (!Config::Instance()->MipmapBiasLiveUpdate.value_or_default() || !SamplerRegistry::Instance().HasHeaps())
+        return o_CreateSampler(device, &newDesc, DestDescriptor);
+
+    SamplerRegistry::Instance().Create(device, *pDesc, DestDescriptor.ptr,
+                                       [&]() { o_CreateSampler(device, &newDesc, DestDescriptor); });
+}
+
+// Copies between staging heaps move the original desc along, and a copy can't read a half rewritten slot
+VALIDATE_HOOK(hkCopyDescriptors, PFN_CopyDescriptors)
+static void hkCopyDescriptors(ID3D12Device* device, UINT NumDestDescriptorRanges,
+                              const D3D12_CPU_DESCRIPTOR_HANDLE* pDestDescriptorRangeStarts,
+                              const UINT* pDestDescriptorRangeSizes, UINT NumSrcDescriptorRanges,
+                              const D3D12_CPU_DESCRIPTOR_HANDLE* pSrcDescriptorRangeStarts,
+                              const UINT* pSrcDescriptorRangeSizes, D3D12_DESCRIPTOR_HEAP_TYPE DescriptorHeapsType)
+{
+    auto copy = [&]()
     {
-        LOG_DEBUG("Overriding {2:X} to anisotropic filtering {0} -> {1}", pDesc->MaxAnisotropy,
-                  Config::Instance()->AnisotropyOverride.value(), (UINT) newDesc.Filter);
+        o_CopyDescriptors(device, NumDestDescriptorRanges, pDestDescriptorRangeStarts, pDestDescriptorRangeSizes,
+                          NumSrcDescriptorRanges, pSrcDescriptorRangeStarts, pSrcDescriptorRangeSizes,
+                          DescriptorHeapsType);
+    };
 
-        newDesc.Filter = UpgradeToAF(pDesc->Filter);
-        newDesc.MaxAnisotropy = Config::Instance()->AnisotropyOverride.value();
-    }
-    else
+    if (DescriptorHeapsType != D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER ||
+        !Config::Instance()->MipmapBiasLiveUpdate.value_or_default() || !SamplerRegistry::Instance().HasHeaps())
     {
-        newDesc.Filter = pDesc->Filter;
-        newDesc.MaxAnisotropy = pDesc->MaxAnisotropy;
+        return copy();
     }
 
-    if ((newDesc.MipLODBias < 0.0f && newDesc.MinLOD != newDesc.MaxLOD) ||
-        Config::Instance()->MipmapBiasOverrideAll.value_or_default())
+    auto increment = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
+    SamplerRegistry::Instance().Copy(NumDestDescriptorRanges, pDestDescriptorRangeStarts, pDestDescriptorRangeSizes,
+                                     NumSrcDescriptorRanges, pSrcDescriptorRangeStarts, pSrcDescriptorRangeSizes,
+                                     increment, copy);
+}
+
+VALIDATE_HOOK(hkCopyDescriptorsSimple, PFN_CopyDescriptorsSimple)
+static void hkCopyDescriptorsSimple(ID3D12Device* device, UINT NumDescriptors,
+                                    D3D12_CPU_DESCRIPTOR_HANDLE DestDescriptorRangeStart,
+                                    D3D12_CPU_DESCRIPTOR_HANDLE SrcDescriptorRangeStart,
+                                    D3D12_DESCRIPTOR_HEAP_TYPE DescriptorHeapsType)
+{
+    auto copy = [&]()
     {
-        if (Config::Instance()->MipmapBiasOverride.has_value())
-        {
-            LOG_DEBUG("Overriding mipmap bias {0} -> {1}", pDesc->MipLODBias,
-                      Config::Instance()->MipmapBiasOverride.value());
+        o_CopyDescriptorsSimple(device, NumDescriptors, DestDescriptorRangeStart, SrcDescriptorRangeStart,
+                                DescriptorHeapsType);
+    };
 
-            if (Config::Instance()->MipmapBiasFixedOverride.value_or_default())
-                newDesc.MipLODBias = Config::Instance()->MipmapBiasOverride.value();
-            else if (Config::Instance()->MipmapBiasScaleOverride.value_or_default())
-                newDesc.MipLODBias = newDesc.MipLODBias * Config::Instance()->MipmapBiasOverride.value();
-            else
-                newDesc.MipLODBias = newDesc.MipLODBias + Config::Instance()->MipmapBiasOverride.value();
-        }
+    if (DescriptorHeapsType != D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER ||
+        !Config::Instance()->MipmapBiasLiveUpdate.value_or_default() || !SamplerRegistry::Instance().HasHeaps())
+    {
+        return copy();
+    }
+
+    auto increment = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
+    SamplerRegistry::Instance().Copy(1, &DestDescriptorRangeStart, &NumDescriptors, 1, &SrcDescriptorRangeStart,
+                                     &NumDescriptors, increment, copy);
+}
+
+static void WINAPI OnSamplerHeapDestroyed(void* pData) { SamplerRegistry::Instance().RemoveHeap((uint64_t) pData); }
 
-        if (State::Instance().lastMipBiasMax < newDesc.MipLODBias)
-            State::Instance().lastMipBiasMax = newDesc.MipLODBias;
+VALIDATE_HOOK(hkCreateDescriptorHeap, PFN_CreateDescriptorHeap)
+static HRESULT hkCreateDescriptorHeap(ID3D12Device* device, const D3D12_DESCRIPTOR_HEAP_DESC* pDescriptorHeapDesc,
+                                      REFIID riid, void** ppvHeap)
+{
+    auto result = o_CreateDescriptorHeap(device, pDescriptorHeapDesc, riid, ppvHeap);
 
-        if (State::Instance().lastMipBias > newDesc.MipLODBias)
-            State::Instance().lastMipBias = newDesc.MipLODBias;
+    if (result != S_OK || ppvHeap == nullptr || *ppvHeap == nullptr ||
+        pDescriptorHeapDesc->Type != D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER || riid != __uuidof(ID3D12DescriptorHeap))
+    {
+        return result;
     }
 
-    return o_CreateSampler(device, &newDesc, DestDescriptor);
+    // GPU might be reading shader visible heaps at any time, only staging heaps are rewritten
+    if ((pDescriptorHeapDesc->Flags & D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE) != 0)
+        return result;
+
+    auto heap = (ID3D12DescriptorHeap*) (*ppvHeap);
+
+    // Slots of a heap without the notifier can't be rewritten safely, they are not tracked
+    ID3DDestructionNotifier* notifier = nullptr;
+    if (heap->QueryInterface(IID_PPV_ARGS(&notifier)) != S_OK || notifier == nullptr)
+        return result;
+
+    auto id = (uint64_t) heap;
+    UINT callbackId = 0;
+    auto notifierResult = notifier->RegisterDestructionCallback(OnSamplerHeapDestroyed, (void*) id, &callbackId);
+    notifier->Release();
+
+    if (notifierResult != S_OK)
+        return result;
+
+    auto increment = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER);
+    auto cpuStart = (SIZE_T) heap->GetCPUDescriptorHandleForHeapStart().ptr;
+    auto cpuEnd = cpuStart + (increment * pDescriptorHeapDesc->NumDescriptors);
+
+    LOG_DEBUG("Sampler heap: {:X}, Cpu: {}-{}, Desc count: {}", id, cpuStart, cpuEnd,
+              pDescriptorHeapDesc->NumDescriptors);
+
+    SamplerRegistry::Instance().AddHeap(id, cpuStart, cpuEnd);
+
+    return result;
 }
 
 VALIDATE_HOOK(hkCreateRootSignature, PFN_CreateRootSignature)
@@ -1132,6 +1297,9 @@ static void HookToDevice(ID3D12Device* InDevice)
     o_CreateSampler = (PFN_CreateSampler) pVTable[22];
     o_CheckFeatureSupport = (PFN_CheckFeatureSupport) pVTable[13];
     o_CreateRootSignature = (PFN_CreateRootSignature) pVTable[16];
+    o_CreateDescriptorHeap = (PFN_CreateDescriptorHeap) pVTable[14];
+    o_CopyDescriptors = (PFN_CopyDescriptors) pVTable[23];
+    o_CopyDescriptorsSimple = (PFN_CopyDescriptorsSimple) pVTable[24];
     o_GetResourceAllocationInfo = (PFN_GetResourceAllocationInfo) pVTable[25];
     o_CreateCommittedResource = (PFN_CreateCommittedResource) pVTable[27];
     o_CreatePlacedResource = (PFN_CreatePlacedResource) pVTable[29];
@@ -1161,6 +1329,16 @@ static void HookToDevice(ID3D12Device* InDevice)
         if (o_CreateRootSignature != nullptr)
             DetourAttach(&(PVOID&) o_CreateRootSignature, hkCreateRootSignature);
 
+        // Staging sampler heaps and copies for live sampler updates
+        if (o_CreateDescriptorHeap != nullptr)
+            DetourAttach(&(PVOID&) o_CreateDescriptorHeap, hkCreateDescriptorHeap);
+
+        if (o_CopyDescriptors != nullptr)
+            DetourAttach(&(PVOID&) o_CopyDescriptors, hkCopyDescriptors);
+
+        if (o_CopyDescriptorsSimple != nullptr)
+            DetourAttach(&(PVOID&) o_CopyDescriptorsSimple, hkCopyDescriptorsSimple);
+
         // Will be used for tracking current d3d12 device too
         if (o_D3D12DeviceRelease != nullptr)
             DetourAttach(&(PVOID&) o_D3D12DeviceRelease, hkD3D12DeviceRelease);
@@ -1191,6 +1369,8 @@ static void HookToDevice(ID3D12Device* InDevice)
 
     HookToCommandList(InDevice);
 
+    Prewarm_Dx12::Start(InDevice);
+
     if (State::Instance().activeFgInput == FGInput::Upscaler && !Config::Instance()->FGDisableHUDFix.value_or_default())
         ResTrack_Dx12::HookDevice(InDevice);
 
@@ -1215,6 +1395,15 @@ static void UnhookDevice()
     if (o_CreateRootSignature != nullptr)
         DetourDetach(&(PVOID&) o_CreateRootSignature, hkCreateRootSignature);
 
+    if (o_CreateDescriptorHeap != nullptr)
+        DetourDetach(&(PVOID&) o_CreateDescriptorHeap, hkCreateDescriptorHeap);
+
+    if (o_CopyDescriptors != nullptr)
+        DetourDetach(&(PVOID&) o_CopyDescriptors, hkCopyDescriptors);
+
+    if (o_CopyDescriptorsSimple != nullptr)
+        DetourDetach(&(PVOID&) o_CopyDescriptorsSimple, hkCopyDescriptorsSimple);
+
     if (o_CheckFeatureSupport != nullptr)
         DetourDetach(&(PVOID&) o_CheckFeatureSupport, hkCheckFeatureSupport);
 
@@ -1233,6 +1422,9 @@ static void UnhookDevice()
     DetourTransactionCommit();
 
     o_CreateSampler = nullptr;
+    o_CreateDescriptorHeap = nullptr;
+    o_CopyDescriptors = nullptr;
+    o_CopyDescriptorsSimple = nullptr;
     o_CheckFeatureSupport = nullptr;
     o_CreateCommittedResource = nullptr;
     o_CreatePlacedResource = nullptr;
@@ -1365,3 +1557,38 @@ void D3D12Hooks::RestoreGraphicsRootSignature(ID3D12GraphicsCommandList* cmdList
 }
 
 void D3D12Hooks::HookDevice(ID3D12Device* device) { HookToDevice(device); }
+
+void D3D12Hooks::UpdateSamplers()
+{
+    static std::optional<SamplerSettings> applied;
+
+    if (o_CreateSampler == nullptr || !Config::Instance()->MipmapBiasLiveUpdate.value_or_default())
+        return;
+
+    auto current = CurrentSamplerSettings();
+
+    // Samplers created until now already use these
+    if (!applied.has_value())
+        applied = current;
+
+    if (applied.value() == current)
+        return;
+
+    applied = current;
+
+    State::Instance().lastMipBias = 100.0f;
+    State::Instance().lastMipBiasMax = -100.0f;
+
+    // Only staging heaps are rewritten, GPU never reads them. Shader visible samplers pick the
+    // new settings up when the game creates or copies them again.
+    // Once per present, game's CreateSampler and sampler copies wait for the registry lock meanwhile
+    auto count = SamplerRegistry::Instance().ForEach(
+        [](ID3D12Device* device, const D3D12_SAMPLER_DESC& original, SIZE_T cpuHandle)
+        {
+            auto desc = original;
+            ApplySamplerOverrides(desc);
+            o_CreateSampler(device, &desc, { cpuHandle });
+        });
+
+    LOG_INFO("Sampler settings changed, updated {} staged samplers", count);
+}
@@ -19,4 +19,7 @@ class D3D12Hooks
     static void HookToCommandListLate(ID3D12GraphicsCommandList* commandList);
     static void RestoreComputeRootSignature(ID3D12GraphicsCommandList* cmdList);
     static void RestoreGraphicsRootSignature(ID3D12GraphicsCommandList* cmdList);
+
+    // Applies changed mipmap bias / anisotropy settings to samplers which are already created
+    static void UpdateSamplers();
 };
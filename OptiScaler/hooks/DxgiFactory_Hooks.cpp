@@ -20,6 +20,7 @@
 #include <magic_enum.hpp>
 #endif
 #include <misc/IdentifyGpu.h>
+#include <misc/SwapchainCache.h>
 
 void DxgiFactoryHooks::HookToFactory(IDXGIFactory* pFactory)
 {
@@ -391,6 +392,8 @@ HRESULT DxgiFactoryHooks::CreateSwapChain(IDXGIFactory* realFactory, IUnknown* p
                 State::Instance().screenHeight = static_cast<float>(localDesc.BufferDesc.Height);
             }
 
+            SwapchainCache::Instance().Invalidate();
+
             LOG_DEBUG("Created new swapchain: {0:X}, hWnd: {1:X}", (UINT64) *ppSwapChain,
                       (UINT64) localDesc.OutputWindow);
 
@@ -685,6 +688,8 @@ HRESULT DxgiFactoryHooks::CreateSwapChainForHwnd(IDXGIFactory2* realFactory, IUn
 
             realSC->GetDesc(&State::Instance().currentSwapchainDesc);
 
+            SwapchainCache::Instance().Invalidate();
+
             LOG_DEBUG("Created new swapchain: {0:X}, hWnd: {1:X}", (uintptr_t) *ppSwapChain, (uintptr_t) hWnd);
 
             WrappedIDXGISwapChain4* wrapped;
@@ -809,6 +814,8 @@ HRESULT DxgiFactoryHooks::CreateSwapChainForCoreWindow(IDXGIFactory2* realFactor
         State::Instance().screenWidth = static_cast<float>(localDesc.Width);
         State::Instance().screenHeight = static_cast<float>(localDesc.Height);
 
+        SwapchainCache::Instance().Invalidate();
+
         LOG_DEBUG("Created new swapchain: {0:X}, hWnd: {1:X}", (UINT64) *ppSwapChain, (UINT64) pWindow);
 
         WrappedIDXGISwapChain4* wrapped;
@@ -1071,6 +1078,8 @@ HRESULT DxgiFactoryHooks::DLSSGCreateSwapChain(IDXGIFactory* realFactory, IUnkno
                 State::Instance().screenHeight = static_cast<float>(localDesc.BufferDesc.Height);
             }
 
+            SwapchainCache::Instance().Invalidate();
+
             LOG_DEBUG("Created new swapchain: {0:X}, hWnd: {1:X}", (UINT64) *ppSwapChain,
                       (UINT64) localDesc.OutputWindow);
 
@@ -1385,6 +1394,8 @@ HRESULT DxgiFactoryHooks::DLSSGCreateSwapChainForHwnd(IDXGIFactory2* realFactory
 
             realSC->GetDesc(&State::Instance().currentSwapchainDesc);
 
+            SwapchainCache::Instance().Invalidate();
+
             LOG_DEBUG("Created new swapchain: {0:X}, hWnd: {1:X}", (uintptr_t) *ppSwapChain, (uintptr_t) hWnd);
 
             WrappedIDXGISwapChain4* wrapped;
@@ -1509,6 +1520,8 @@ HRESULT DxgiFactoryHooks::DLSSGCreateSwapChainForCoreWindow(IDXGIFactory2* realF
         State::Instance().screenWidth = static_cast<float>(localDesc.Width);
         State::Instance().screenHeight = static_cast<float>(localDesc.Height);
 
+        SwapchainCache::Instance().Invalidate();
+
         LOG_DEBUG("Created new swapchain: {0:X}, hWnd: {1:X}", (UINT64) *ppSwapChain, (UINT64) pWindow);
 
         WrappedIDXGISwapChain4* wrapped;
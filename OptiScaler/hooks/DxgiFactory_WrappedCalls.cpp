@@ -18,6 +18,7 @@
 #include <magic_enum.hpp>
 #endif
 #include <misc/IdentifyGpu.h>
+#include <misc/SwapchainCache.h>
 
 HRESULT DxgiFactoryWrappedCalls::CreateSwapChain(IDXGIFactory* realFactory, WrappedIDXGIFactory7* wrappedFactory,
                                                  IUnknown* pDevice, const DXGI_SWAP_CHAIN_DESC* pDesc,
@@ -247,6 +248,8 @@ HRESULT DxgiFactoryWrappedCalls::CreateSwapChain(IDXGIFactory* realFactory, Wrap
                 State::Instance().screenHeight = static_cast<float>(localDesc.BufferDesc.Height);
             }
 
+            SwapchainCache::Instance().Invalidate();
+
             LOG_DEBUG("Created new swapchain: {0:X}, hWnd: {1:X}", (UINT64) *ppSwapChain,
                       (UINT64) localDesc.OutputWindow);
             *ppSwapChain =
@@ -527,6 +530,8 @@ HRESULT DxgiFactoryWrappedCalls::CreateSwapChainForHwnd(IDXGIFactory2* realFacto
                 State::Instance().screenHeight = static_cast<float>(localDesc.Height);
             }
 
+            SwapchainCache::Instance().Invalidate();
+
             LOG_DEBUG("Created new swapchain: {0:X}, hWnd: {1:X}", (UINT64) *ppSwapChain, (UINT64) hWnd);
             *ppSwapChain = new WrappedIDXGISwapChain4(realSC, readDevice, hWnd, localDesc.Flags, false);
 
@@ -629,6 +634,8 @@ HRESULT DxgiFactoryWrappedCalls::CreateSwapChainForCoreWindow(IDXGIFactory2* rea
         State::Instance().screenWidth = static_cast<float>(localDesc.Width);
         State::Instance().screenHeight = static_cast<float>(localDesc.Height);
 
+        SwapchainCache::Instance().Invalidate();
+
         LOG_DEBUG("Created new swapchain: {0:X}, hWnd: {1:X}", (UINT64) *ppSwapChain, (UINT64) pWindow);
         *ppSwapChain = new WrappedIDXGISwapChain4(realSC, readDevice, (HWND) pWindow, localDesc.Flags, true);
 
@@ -13,6 +13,8 @@
 #include <resource_tracking/ResTrack_Dx12.h>
 
 #include <misc/FrameLimit.h>
+#include <misc/PresentProfiler.h>
+#include <misc/SwapchainCache.h>
 #include <upscaler_time/UpscalerTime_Dx12.h>
 
 #include <hooks/Reflex_Hooks.h>
@@ -422,6 +424,9 @@ HRESULT FGHooks::hkSetFullscreenState(IDXGISwapChain* This, BOOL Fullscreen, IDX
         LOG_DEBUG("Fullscreen: {}, pTarget: {:X}, Result: {:X}", Fullscreen, (size_t) pTarget, (UINT) result);
     }
 
+    if (result == S_OK)
+        SwapchainCache::Instance().Invalidate();
+
     if (result == S_OK && modeChanged)
     {
         LOG_DEBUG("Mode changed");
@@ -487,6 +492,8 @@ HRESULT FGHooks::hkGetFullscreenState(IDXGISwapChain* This, BOOL* pFullscreen, I
 HRESULT FGHooks::hkResizeBuffers(IDXGISwapChain* This, UINT BufferCount, UINT Width, UINT Height, DXGI_FORMAT NewFormat,
                                  UINT SwapChainFlags)
 {
+    SwapchainCache::Instance().Invalidate();
+
     // Skip XeFG's internal call
     if (_skipResize)
     {
@@ -721,6 +728,8 @@ HRESULT FGHooks::hkResizeTarget(IDXGISwapChain* This, const DXGI_MODE_DESC* pNew
 HRESULT FGHooks::hkResizeBuffers1(IDXGISwapChain3* This, UINT BufferCount, UINT Width, UINT Height, DXGI_FORMAT Format,
                                   UINT SwapChainFlags, const UINT* pCreationNodeMask, IUnknown* const* ppPresentQueue)
 {
+    SwapchainCache::Instance().Invalidate();
+
     // Skip XeFG's internal call
     if (_skipResize1)
     {
@@ -1021,6 +1030,7 @@ HRESULT FGHooks::FGPresent(IDXGISwapChain* This, UINT SyncInterval, UINT Flags,
     }
 
     auto willPresent = (Flags & DXGI_PRESENT_TEST) == 0;
+    PresentProfiler::ScopedFrame profilerFrame(willPresent);
 
     if (willPresent)
     {
@@ -1040,26 +1050,46 @@ HRESULT FGHooks::FGPresent(IDXGISwapChain* This, UINT SyncInterval, UINT Flags,
 
     if (willPresent && State::Instance().currentCommandQueue != nullptr)
     {
+        PresentProfiler::ScopedPhase phase(PresentPhase::ReadUpscalerTime);
         UpscalerTimeDx12::ReadUpscalingTime(State::Instance().currentCommandQueue);
     }
 
+    // Set while this thread holds the shared lock, FG presents from inside the game's present.
+    // Locking shared twice is undefined and deadlocks when release/resize queues in between
+    static thread_local bool presentHoldsMutex = false;
+
     auto fg = State::Instance().currentFG;
     bool mutexUsed = false;
+    UINT64 presentFrame = 0;
+    uint32_t presentSlot = FrameTicket::Slots;
     if (willPresent && fg != nullptr && fg->IsActive() && !fg->IsPaused() &&
-        Config::Instance()->FGUseMutexForSwapchain.value_or_default() && fg->Mutex.getOwner() != 2)
+        Config::Instance()->FGUseMutexForSwapchain.value_or_default() && !presentHoldsMutex &&
+        !fg->Mutex.isOwnedByThisThread())
     {
-        LOG_TRACE("Waiting FG->Mutex 2, current: {}", fg->Mutex.getOwner());
-        fg->Mutex.lock(2);
+        // Shared lock only blocks while swapchain is being released/resized,
+        // dispatch side syncs with PresentTicket instead of the mutex
+        LOG_TRACE("Waiting FG->Mutex shared, current: {}", fg->Mutex.getOwner());
+        PresentProfiler::ScopedPhase phase(PresentPhase::FGMutexWait);
+        fg->Mutex.lock_shared();
         mutexUsed = true;
-        LOG_TRACE("Accuired FG->Mutex: {}", fg->Mutex.getOwner());
+        presentHoldsMutex = true;
+
+        // Frame whose resources this present reads, not the newest one the game started
+        presentFrame = fg->IsDispatched() ? fg->FrameCount() : fg->FrameWillBeDispatched();
+        presentSlot = fg->PresentTicket.Begin(presentFrame);
+        LOG_TRACE("Present ticket for frame: {}, slot: {}", presentFrame, presentSlot);
     }
 
+    // First query of the frame, present time passes of FG & Hudfix get the cached index
+    if (willPresent && fg != nullptr)
+        SwapchainCache::Instance().CurrentIndex((IDXGISwapChain3*) This);
+
     sl::FrameToken* localToken = nullptr;
     sl::Result tokenResult = sl::Result::eErrorReflexAPI;
     if (willPresent && (State::Instance().activeFgOutput == FGOutput::DLSSG ||
                         State::Instance().activeFgOutput == FGOutput::DLSSGWithNvngx))
     {
-        ((IDXGISwapChain4*) This)->GetCurrentBackBufferIndex();
+        PresentProfiler::ScopedPhase phase(PresentPhase::StreamlineMarkers);
 
         if (!ReflexHooks::gameIsSendingMarkers() ||
             !Config::Instance()->FGDLSSGUseGamesReflexMarkers.value_or_default())
@@ -1076,6 +1106,8 @@ HRESULT FGHooks::FGPresent(IDXGISwapChain* This, UINT SyncInterval, UINT Flags,
 
     if (willPresent && fg != nullptr)
     {
+        PresentProfiler::ScopedPhase phase(PresentPhase::FGPresent);
+
         // Some games use this callback to render UI even when
         // FG is disabled. So call it when there is FGFeature
         if (State::Instance().activeFgInput == FGInput::FSRFG)
@@ -1090,6 +1122,7 @@ HRESULT FGHooks::FGPresent(IDXGISwapChain* This, UINT SyncInterval, UINT Flags,
 
     if (willPresent)
     {
+        PresentProfiler::ScopedPhase phase(PresentPhase::Hudfix);
         ResTrack_Dx12::ClearPossibleHudless();
         Hudfix_Dx12::PresentStart();
     }
@@ -1129,10 +1162,17 @@ HRESULT FGHooks::FGPresent(IDXGISwapChain* This, UINT SyncInterval, UINT Flags,
         State::Instance().FGPresentIsCalled = true;
 
     HRESULT result;
-    if (pPresentParameters == nullptr)
-        result = o_FGSCPresent(This, SyncInterval, Flags);
-    else
-        result = o_FGSCPresent1((IDXGISwapChain1*) This, SyncInterval, Flags, pPresentParameters);
+    {
+        PresentProfiler::ScopedPhase phase(PresentPhase::Present);
+
+        if (pPresentParameters == nullptr)
+            result = o_FGSCPresent(This, SyncInterval, Flags);
+        else
+            result = o_FGSCPresent1((IDXGISwapChain1*) This, SyncInterval, Flags, pPresentParameters);
+    }
+
+    if (willPresent)
+        SwapchainCache::Instance().Presented();
 
     if (result == S_OK)
     {
@@ -1151,22 +1191,29 @@ HRESULT FGHooks::FGPresent(IDXGISwapChain* This, UINT SyncInterval, UINT Flags,
         (State::Instance().activeFgOutput == FGOutput::DLSSG ||
          State::Instance().activeFgOutput == FGOutput::DLSSGWithNvngx))
     {
+        PresentProfiler::ScopedPhase phase(PresentPhase::StreamlineMarkers);
         StreamlineProxy::PCLSetMarker()(sl::PCLMarker::ePresentEnd, *localToken);
         StreamlineProxy::ReflexSleep()(*localToken);
     }
 
-    Hudfix_Dx12::PresentEnd();
+    {
+        PresentProfiler::ScopedPhase phase(PresentPhase::Hudfix);
+        Hudfix_Dx12::PresentEnd();
+    }
 
     if (willPresent && !State::Instance().reflexLimitsFps && State::Instance().activeFgOutput != FGOutput::NoFG &&
         !IdentifyGpu::getPrimaryGpu().usesDxvk && !XellHooks::canLimit())
     {
+        PresentProfiler::ScopedPhase phase(PresentPhase::FrameLimit);
         FrameLimit::sleep(fg != nullptr ? fg->IsActive() && !fg->IsPaused() : false);
     }
 
     if (mutexUsed && fg != nullptr)
     {
-        LOG_TRACE("Releasing FG->Mutex: {}", fg->Mutex.getOwner());
-        fg->Mutex.unlockThis(2);
+        LOG_TRACE("Releasing FG->Mutex shared, frame: {}", presentFrame);
+        fg->PresentTicket.End(presentSlot, presentFrame);
+        fg->Mutex.unlock_shared();
+        presentHoldsMutex = false;
     }
 
     LOG_DEBUG("Present finished");
@@ -1269,6 +1316,7 @@ ULONG FGHooks::hkFGRelease(IUnknown* This)
 
             LOG_DEBUG("FG Swapchain released, clearing currentFGSwapchain");
             State::Instance().currentFGSwapchain = nullptr;
+            SwapchainCache::Instance().Invalidate();
 
             if (State::Instance().currentWrappedSwapchain != nullptr &&
                 State::Instance().currentSwapchainDesc.OutputWindow == _hwnd)
@@ -8,6 +8,7 @@
 
 #include <magic_enum.hpp>
 #include <nvapi/fakenvapi/nvapi_calls.h>
+#include <misc/LatencyAnalytics.h>
 
 #include <math.h>
 
@@ -552,6 +553,8 @@ bool ReflexHooks::updateTimingData()
             return false;
         }
 
+        LatencyAnalytics::Consume(results->frameReport, std::size(results->frameReport));
+
         // 64th element has the latest data
         return processFrameReport(results->frameReport[63]);
     }
@@ -568,6 +571,8 @@ bool ReflexHooks::updateTimingData()
             return false;
         }
 
+        LatencyAnalytics::Consume(results->frameReport, std::size(results->frameReport));
+
         // 64th element has the latest data
         return processFrameReport(results->frameReport[63]);
     }
@@ -11,6 +11,7 @@
 #include <upscaler_time/UpscalerTime_Vk.h>
 
 #include <misc/FrameLimit.h>
+#include <misc/DynamicResolution.h>
 #include "Reflex_Hooks.h"
 
 #include <spoofing/Vulkan_Spoofing.h>
@@ -223,6 +224,13 @@ static VkResult hkvkQueuePresentKHR(VkQueue queue, const VkPresentInfoKHR* pPres
 
     ReflexHooks::update(false, true);
 
+    // DXVK presents are handled on the DXGI side
+    if (!IdentifyGpu::getPrimaryGpu().usesDxvk)
+    {
+        DynamicResolution::OnPresent(false);
+        Config::Instance()->ApplyIniChanges();
+    }
+
     // original call
     ScopedVulkanCreatingSC scopedVulkanCreatingSC {};
     auto result = o_QueuePresentKHR(queue, &localPresentInfo);
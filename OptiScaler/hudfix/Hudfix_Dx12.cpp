@@ -4,6 +4,7 @@
 #include <Util.h>
 #include <State.h>
 #include <Config.h>
+#include <misc/VramRegistry.h>
 
 #include <framegen/IFGFeature_Dx12.h>
 
@@ -197,6 +198,7 @@ bool Hudfix_Dx12::CreateBufferResource(ID3D12Device* InDevice, ResourceInfo* InS
     }
 
     LOG_DEBUG("Created new one: {}x{}", texDesc.Width, texDesc.Height);
+    VramRegistry::Instance().Track(*OutResource, "Hudfix", "Hudless copy");
     return true;
 }
 
@@ -249,22 +251,14 @@ bool Hudfix_Dx12::CreateBufferResourceWithSize(ID3D12Device* InDevice, ResourceI
     }
 
     LOG_DEBUG("Created new one: {}x{}", InWidth, InHeight);
+    VramRegistry::Instance().Track(*OutResource, "Hudfix", "Hudless copy");
     return true;
 }
 
 void Hudfix_Dx12::ResourceBarrier(ID3D12GraphicsCommandList* InCommandList, ID3D12Resource* InResource,
                                   D3D12_RESOURCE_STATES InBeforeState, D3D12_RESOURCE_STATES InAfterState)
 {
-    if (InBeforeState == InAfterState)
-        return;
-
-    D3D12_RESOURCE_BARRIER barrier = {};
-    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    barrier.Transition.pResource = InResource;
-    barrier.Transition.StateBefore = InBeforeState;
-    barrier.Transition.StateAfter = InAfterState;
-    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-    InCommandList->ResourceBarrier(1, &barrier);
+    ResourceTransition(InCommandList, InResource, InBeforeState, InAfterState);
 }
 
 bool Hudfix_Dx12::CheckCapture()
@@ -330,6 +324,57 @@ inline static std::string GetDispatchString(UINT source)
     }
 }
 
+uint8_t Hudfix_Dx12::MatchSwapchain(ResourceInfo* resource)
+{
+    auto& scDesc = State::Instance().currentSwapchainDesc.BufferDesc;
+    auto key = HudlessSwapchainKey(scDesc.Width, scDesc.Height, scDesc.Format);
+    uint8_t match = HudlessMatch_None;
+
+    // Key & match are stored together, CheckResource can run on other threads meanwhile
+    auto publish = [resource, key, &match]()
+    {
+        std::atomic_ref(resource->scState).store(HudlessMatchState(key, match), std::memory_order_relaxed);
+        return match;
+    };
+
+    // There are all these chacks because looks like ResTracker is still missing some resources
+    // Need check more docs about D3D12 resource/heap usage
+    if (resource->width == 0 || resource->height == 0)
+        return publish();
+
+    // check for resource flags
+    constexpr auto unsupportedFlags =
+        D3D12_RESOURCE_FLAG_RAYTRACING_ACCELERATION_STRUCTURE | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL |
+        D3D12_RESOURCE_FLAG_VIDEO_DECODE_REFERENCE_ONLY | D3D12_RESOURCE_FLAG_DENY_SHADER_RESOURCE |
+        D3D12_RESOURCE_FLAG_VIDEO_ENCODE_REFERENCE_ONLY;
+
+    if ((resource->flags & unsupportedFlags) != 0)
+        return publish();
+
+    match = HudlessMatch_Usable;
+
+    if (resource->width == scDesc.Width && resource->height == scDesc.Height)
+    {
+        match |= HudlessMatch_Size;
+    }
+    else
+    {
+        auto toleranceX = scDesc.Width / 8;
+        auto toleranceY = scDesc.Height / 8;
+
+        if (resource->height >= scDesc.Height - toleranceY && resource->height <= scDesc.Height + toleranceY &&
+            resource->width >= scDesc.Width - toleranceX && resource->width <= scDesc.Width + toleranceX)
+        {
+            match |= HudlessMatch_RelaxedSize;
+        }
+    }
+
+    if (CompareResourceFormats(resource->format, scDesc.Format))
+        match |= HudlessMatch_Format;
+
+    return publish();
+}
+
 bool Hudfix_Dx12::CheckResource(ResourceInfo* resource)
 {
     if (resource == nullptr || resource->buffer == nullptr || State::Instance().isShuttingDown)
@@ -339,102 +384,47 @@ bool Hudfix_Dx12::CheckResource(ResourceInfo* resource)
     }
 
     if (State::Instance().FGonlyUseCapturedResources)
-    {
-        auto result = _captureList.find(resource->buffer) != _captureList.end();
-        return result;
-    }
+        return _captureList.Contains(resource->buffer);
 
-    auto& s = State::Instance();
+    auto& scDesc = State::Instance().currentSwapchainDesc.BufferDesc;
 
-    // There are all these chacks because looks like ResTracker is still missing some resources
-    // Need check more docs about D3D12 resource/heap usage
+    // Match is computed at view creation, only swapchain changes need a recompute
+    auto state = std::atomic_ref(resource->scState).load(std::memory_order_relaxed);
+    auto match = HudlessStateMatch(state);
 
-    // Compare aganist stored info first
-    if (resource->width == 0 || resource->height == 0)
-    {
-        // LOG_TRACE("Resource has invalid dimensions!");
-        return false;
-    }
+    if (HudlessStateKey(state) != HudlessSwapchainKey(scDesc.Width, scDesc.Height, scDesc.Format))
+        match = MatchSwapchain(resource);
 
-    // Get resource info
-    auto resDesc = resource->buffer->GetDesc();
+    if ((match & HudlessMatch_Usable) == 0)
+        return false;
 
     // dimensions not match
-    uint32_t width = s.currentSwapchainDesc.BufferDesc.Width;
-    uint32_t height = s.currentSwapchainDesc.BufferDesc.Height;
-
-    if (resDesc.Height != height || resDesc.Width != width)
+    if ((match & HudlessMatch_Size) == 0)
     {
-        auto toleranceX = width / 8;
-        auto toleranceY = height / 8;
-
         // Extended size check
         if (resource->captureInfo != CaptureInfo::Upscaler &&
             !(Config::Instance()->FGRelaxedResolutionCheck.value_or_default() &&
-              resDesc.Height >= height - toleranceY && resDesc.Height <= height + toleranceY &&
-              resDesc.Width >= width - toleranceX && resDesc.Width <= width + toleranceX))
+              (match & HudlessMatch_RelaxedSize) != 0))
         {
-            // LOG_TRACE("Resource dimensions do not match! Resource: {}x{}, Swapchain: {}x{}", resDesc.Width,
-            //           resDesc.Height, width, height);
-
             return false;
         }
 
         resource->extended = true;
     }
 
-    // check for resource flags
-    if ((resDesc.Flags & (D3D12_RESOURCE_FLAG_RAYTRACING_ACCELERATION_STRUCTURE |
-                          D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL | D3D12_RESOURCE_FLAG_VIDEO_DECODE_REFERENCE_ONLY |
-                          D3D12_RESOURCE_FLAG_DENY_SHADER_RESOURCE | D3D12_RESOURCE_FLAG_VIDEO_ENCODE_REFERENCE_ONLY)) >
-        0)
-    {
-        // LOG_TRACE("Resource has unsupported flags! Flags: {:X}", (UINT) resDesc.Flags);
-
+    // format doesn't match and extended not active
+    if ((match & HudlessMatch_Format) == 0 && !Config::Instance()->FGHUDFixExtended.value_or_default())
         return false;
-    }
 
-    std::string caller;
     auto source = resource->captureInfo & 0xFF;
     auto dispatcher = resource->captureInfo & 0xFF00;
 
-    // format match
-    if (CompareResourceFormats(resDesc.Format, s.currentSwapchainDesc.BufferDesc.Format))
-    {
-        LOG_DEBUG("{}->{} Width: {}/{}, Height: {}/{}, Format: {}/{}, Resource: {:X}, convertFormat: {} -> TRUE",
-                  GetSourceString(source), GetDispatchString(dispatcher), resDesc.Width, width, resDesc.Height, height,
-                  (UINT) resDesc.Format, (UINT) s.currentSwapchainDesc.BufferDesc.Format, (size_t) resource->buffer,
-                  Config::Instance()->FGHUDFixExtended.value_or_default());
-
-        return true;
-    }
-
-    // extended not active
-    if (!Config::Instance()->FGHUDFixExtended.value_or_default())
-    {
-        // LOG_TRACE(
-        //     "{}->{} Resource format does not match and extended check is not active! Format: {}/{}, Resource: {:X}",
-        //     GetSourceString(source), GetDispatchString(dispatcher), (UINT) resDesc.Format,
-        //     (UINT) s.currentSwapchainDesc.BufferDesc.Format, (size_t) resource->buffer);
-
-        return false;
-    }
-
-    {
-        LOG_DEBUG("{}->{} Width: {}/{}, Height: {}/{}, Format: {}/{}, Resource: {:X}, convertFormat: {} -> TRUE",
-                  GetSourceString(source), GetDispatchString(dispatcher), resDesc.Width, width, resDesc.Height, height,
-                  (UINT) resDesc.Format, (UINT) s.currentSwapchainDesc.BufferDesc.Format, (size_t) resource->buffer,
-                  Config::Instance()->FGHUDFixExtended.value_or_default());
+    LOG_DEBUG("{}->{} Width: {}/{}, Height: {}/{}, Format: {}/{}, Resource: {:X}, convertFormat: {} -> TRUE",
+              GetSourceString(source), GetDispatchString(dispatcher), resource->width, scDesc.Width, resource->height,
+              scDesc.Height, (UINT) resource->format, (UINT) scDesc.Format, (size_t) resource->buffer,
+              Config::Instance()->FGHUDFixExtended.value_or_default());
 
-        return true;
-    }
-
-    // LOG_TRACE(
-    //     "Last {}->{} Resource format does not match and extended check is not active! Format: {}/{}, Resource: {:X}",
-    //     GetSourceString(source), GetDispatchString(dispatcher), (UINT) resDesc.Format,
-    //     (UINT) s.currentSwapchainDesc.BufferDesc.Format, (size_t) resource->buffer);
-
-    // return false;
+    return true;
 }
 
 int Hudfix_Dx12::GetIndex() { return _upscaleCounter % BUFFER_COUNT; }
@@ -486,8 +476,9 @@ void Hudfix_Dx12::UpscaleStart()
 {
     if (State::Instance().FGresetCapturedResources)
     {
-        std::lock_guard<std::mutex> lock(_captureMutex);
-        _captureList.clear();
+        // Inserts happen under the same lock
+        std::lock_guard<std::mutex> lock(_checkMutex);
+        _captureList.Clear();
         LOG_DEBUG("FGResetCapturedResources");
         State::Instance().FGcapturedResourceCount = 0;
         State::Instance().FGresetCapturedResources = false;
@@ -498,6 +489,24 @@ void Hudfix_Dx12::UpscaleStart()
         LOG_DEBUG("ClearCapturedHudlesses");
         State::Instance().ClearCapturedHudlesses = false;
         State::Instance().CapturedHudlesses.clear();
+
+        std::lock_guard<std::mutex> lock(_checkMutex);
+        _validator.Reset();
+    }
+
+    if (Config::Instance()->FGHudfixValidation.value_or_default())
+    {
+        std::lock_guard<std::mutex> lock(_checkMutex);
+
+        _validator.Retry(_upscaleCounter,
+                         [](uint64_t id)
+                         {
+                             LOG_INFO("Hudless {:X} will be validated again", (size_t) id);
+
+                             auto& captured = State::Instance().CapturedHudlesses;
+                             if (auto it = captured.find((void*) id); it != captured.end())
+                                 it->second.enabled = true;
+                         });
     }
 }
 
@@ -861,6 +870,9 @@ bool Hudfix_Dx12::CheckForHudless(ID3D12GraphicsCommandList* cmdList, ResourceIn
                     setResource.validity = FG_ResourceValidity::JustTrackCmdlist;
                     setResource.frameIndex = fg->GetIndexWillBeDispatched();
 
+                    _hudlessSource[setResource.frameIndex] = resource->buffer;
+                    _hudlessCopy[setResource.frameIndex] = setResource.resource;
+
                     fg->SetResource(&setResource);
                 }
             }
@@ -891,15 +903,19 @@ bool Hudfix_Dx12::CheckForHudless(ID3D12GraphicsCommandList* cmdList, ResourceIn
                 setResource.validity = FG_ResourceValidity::JustTrackCmdlist;
                 setResource.frameIndex = fg->GetIndexWillBeDispatched();
 
+                _hudlessSource[setResource.frameIndex] = resource->buffer;
+                _hudlessCopy[setResource.frameIndex] = setResource.resource;
+
                 fg->SetResource(&setResource);
             }
         }
 
         if (s.FGcaptureResources)
         {
-            std::lock_guard<std::mutex> lock(_captureMutex);
-            _captureList.insert(resource->buffer);
-            s.FGcapturedResourceCount = _captureList.size();
+            if (!_captureList.Insert(resource->buffer))
+                LOG_WARN("Capture list is full, {:X} is not added", (size_t) resource->buffer);
+
+            s.FGcapturedResourceCount = _captureList.Count();
         }
 
         LOG_DEBUG("Calling FG with hudless");
@@ -931,6 +947,53 @@ bool Hudfix_Dx12::CheckForHudless(ID3D12GraphicsCommandList* cmdList, ResourceIn
     return false;
 }
 
+ID3D12Resource* Hudfix_Dx12::ValidationSource(int fgIndex, ID3D12Resource* hudless)
+{
+    if (fgIndex < 0 || fgIndex >= BUFFER_COUNT || hudless == nullptr)
+        return nullptr;
+
+    std::lock_guard<std::mutex> lock(_checkMutex);
+
+    // Hudless of this frame is not from Hudfix
+    if (_hudlessCopy[fgIndex] != hudless || _hudlessSource[fgIndex] == nullptr)
+        return nullptr;
+
+    auto source = _hudlessSource[fgIndex];
+
+    if (!_validator.WantsSample((uint64_t) source, _upscaleCounter))
+        return nullptr;
+
+    return source;
+}
+
+void Hudfix_Dx12::HudlessValidated(ID3D12Resource* source, const HudlessStats& stats)
+{
+    auto& s = State::Instance();
+
+    std::lock_guard<std::mutex> lock(_checkMutex);
+
+    auto verdict = _validator.AddSample((uint64_t) source, stats, _upscaleCounter);
+
+    LOG_TRACE("Hudless {:X}, changed tiles: {}/{}, coverage: {:.3f}, mean delta: {:.3f}", (size_t) source,
+              stats.ChangedTiles, stats.Tiles, stats.Coverage(), stats.MeanDelta);
+
+    if (verdict == HudlessVerdict::Good)
+    {
+        LOG_INFO("Hudless {:X} passed validation", (size_t) source);
+        return;
+    }
+
+    if (verdict != HudlessVerdict::Bad)
+        return;
+
+    LOG_WARN("Hudless {:X} failed validation, changed tiles: {}/{}, coverage: {:.3f}, disabling it for a while",
+             (size_t) source, stats.ChangedTiles, stats.Tiles, stats.Coverage());
+
+    // Enabled again by _validator.Retry in UpscaleStart, or from the Hudless Resources window
+    if (auto it = s.CapturedHudlesses.find(source); it != s.CapturedHudlesses.end())
+        it->second.enabled = false;
+}
+
 void Hudfix_Dx12::ResetCounters()
 {
     _fgCounter = 0;
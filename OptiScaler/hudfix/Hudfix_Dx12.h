@@ -1,10 +1,11 @@
 #pragma once
 #include "SysUtils.h"
 #include <shaders/format_transfer/FT_Dx12.h>
+#include "HudlessValidator.h"
+#include "HudlessCandidates.h"
 
 #include <ankerl/unordered_dense.h>
 
-#include <set>
 #include <dxgi.h>
 #include <d3d12.h>
 #include <shared_mutex>
@@ -43,6 +44,7 @@ typedef struct ResourceInfo
     double lastUsedFrame = 0;
     bool extended = false;
     UINT captureInfo = 0;
+    uint64_t scState = 0; // HudlessMatchState, swapchain key & match flags, only accessed with std::atomic_ref
 } resource_info;
 
 typedef struct HudlessInfo
@@ -81,10 +83,9 @@ class Hudfix_Dx12
     inline static ankerl::unordered_dense::map<ID3D12Resource*, HudlessInfo> _hudlessList;
 
     // Capture List
-    inline static std::set<ID3D12Resource*> _captureList;
+    inline static HudlessCaptureSet<4096> _captureList;
 
     inline static std::mutex _checkMutex;
-    inline static std::mutex _captureMutex;
     inline static std::mutex _counterMutex;
     inline static INT64 _captureCounter[BUFFER_COUNT] = { 0, 0, 0, 0 };
     inline static FT_Dx12* _formatTransfer[BUFFER_COUNT] = { nullptr, nullptr, nullptr, nullptr };
@@ -96,6 +97,11 @@ class Hudfix_Dx12
 
     inline static bool _skipHudlessChecks = false;
 
+    // Game resource & the copy given to FG as hudless, per FG frame index
+    inline static ID3D12Resource* _hudlessSource[BUFFER_COUNT] = { nullptr, nullptr, nullptr, nullptr };
+    inline static ID3D12Resource* _hudlessCopy[BUFFER_COUNT] = { nullptr, nullptr, nullptr, nullptr };
+    inline static HudlessValidator _validator;
+
     static bool CreateObjects();
     static bool CreateBufferResource(ID3D12Device* InDevice, ResourceInfo* InSource, D3D12_RESOURCE_STATES InState,
                                      ID3D12Resource** OutResource);
@@ -143,6 +149,16 @@ class Hudfix_Dx12
 
     static bool CheckResource(ResourceInfo* resource);
 
+    // Compares the desc snapshot of the resource with current swapchain, called when views are created
+    // and again by CheckResource after the swapchain changes
+    static uint8_t MatchSwapchain(ResourceInfo* resource);
+
+    // Game resource of the hudless given to FG when it still needs validation, nullptr otherwise
+    static ID3D12Resource* ValidationSource(int fgIndex, ID3D12Resource* hudless);
+
+    // Stats of the hudless against the final image, disables the source when it's a wrong pick
+    static void HudlessValidated(ID3D12Resource* source, const HudlessStats& stats);
+
     // Reset frame counters
     static void ResetCounters();
 
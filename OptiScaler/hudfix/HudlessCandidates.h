@@ -0,0 +1,108 @@
+#pragma once
+#include "SysUtils.h"
+
+#include <atomic>
+
+// Swapchain compatibility of a resource, computed from the desc snapshot taken at view creation
+enum HudlessMatch : uint8_t
+{
+    HudlessMatch_None = 0,
+    HudlessMatch_Usable = 1 << 0,      // Dimensions & flags allow using it as hudless
+    HudlessMatch_Size = 1 << 1,        // Same size as swapchain
+    HudlessMatch_RelaxedSize = 1 << 2, // Within 1/8 of the swapchain size
+    HudlessMatch_Format = 1 << 3,      // Same format group as swapchain
+};
+
+// Swapchain size & format packed into one integer. Resources keep the key their match was computed
+// for, so a resize or format change invalidates all of them without touching them.
+inline uint64_t HudlessSwapchainKey(uint32_t width, uint32_t height, uint32_t format)
+{
+    // High bit is always set, so zero initialized resource infos never match
+    return (uint64_t) (width & 0xFFFFF) | ((uint64_t) (height & 0xFFFFF) << 20) | ((uint64_t) (format & 0xFFF) << 40) |
+           (1ull << 63);
+}
+
+// Swapchain key & HudlessMatch flags of a resource in one word (flags use the free bits 52-59 of the key),
+// so it's published with a single store and readers never see the flags of another key
+constexpr uint64_t HudlessMatchShift = 52;
+constexpr uint64_t HudlessMatchMask = 0xFFull << HudlessMatchShift;
+
+inline uint64_t HudlessMatchState(uint64_t key, uint8_t match) { return key | ((uint64_t) match << HudlessMatchShift); }
+inline uint64_t HudlessStateKey(uint64_t state) { return state & ~HudlessMatchMask; }
+inline uint8_t HudlessStateMatch(uint64_t state) { return (uint8_t) ((state & HudlessMatchMask) >> HudlessMatchShift); }
+
+// Insert only set of resource pointers, lookups & inserts don't lock.
+// Clear can run while others read (they might miss an entry) but not while others insert,
+// Hudfix_Dx12 guards Insert & Clear with its capture mutex.
+template <size_t Capacity> class HudlessCaptureSet
+{
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2");
+
+  public:
+    // Returns false when the set is full
+    bool Insert(const void* resource)
+    {
+        for (size_t i = 0, slot = Slot(resource); i < Capacity; i++, slot = (slot + 1) & (Capacity - 1))
+        {
+            const void* current = _slots[slot].load(std::memory_order_acquire);
+
+            if (current == resource)
+                return true;
+
+            if (current == nullptr)
+            {
+                if (_slots[slot].compare_exchange_strong(current, resource, std::memory_order_acq_rel))
+                {
+                    _count.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+
+                // Another thread took the slot, it might be the same resource
+                if (current == resource)
+                    return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool Contains(const void* resource) const
+    {
+        for (size_t i = 0, slot = Slot(resource); i < Capacity; i++, slot = (slot + 1) & (Capacity - 1))
+        {
+            const void* current = _slots[slot].load(std::memory_order_acquire);
+
+            if (current == resource)
+                return true;
+
+            if (current == nullptr)
+                return false;
+        }
+
+        return false;
+    }
+
+    void Clear()
+    {
+        for (auto& slot : _slots)
+            slot.store(nullptr, std::memory_order_relaxed);
+
+        _count.store(0, std::memory_order_release);
+    }
+
+    size_t Count() const { return _count.load(std::memory_order_relaxed); }
+
+  private:
+    std::atomic<const void*> _slots[Capacity] {};
+    std::atomic<size_t> _count { 0 };
+
+    static size_t Slot(const void* resource)
+    {
+        // Pointers are aligned, mix the bits before masking
+        auto value = (uint64_t) resource;
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdull;
+        value ^= value >> 33;
+        return (size_t) value & (Capacity - 1);
+    }
+};
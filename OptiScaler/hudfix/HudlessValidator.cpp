@@ -0,0 +1,145 @@
+#include "pch.h"
+#include "HudlessValidator.h"
+
+#include <algorithm>
+
+HudlessStats HudlessValidator::Reduce(const HudlessTileStats* tiles, size_t count)
+{
+    HudlessStats stats {};
+    uint64_t deltaSum = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        auto& tile = tiles[i];
+
+        // Tiles outside of the image or garbage from an unfinished copy
+        if (tile.Pixels == 0 || tile.DiffPixels > tile.Pixels)
+            continue;
+
+        stats.Tiles++;
+        stats.Pixels += tile.Pixels;
+        stats.DiffPixels += tile.DiffPixels;
+        deltaSum += tile.DeltaSum;
+
+        if (tile.DiffPixels > tile.Pixels * TileCoverage)
+            stats.ChangedTiles++;
+    }
+
+    if (stats.Pixels > 0)
+        stats.MeanDelta = (float) ((double) deltaSum / (double) stats.Pixels / 255.0);
+
+    return stats;
+}
+
+HudlessVerdict HudlessValidator::Score(const HudlessStats& stats)
+{
+    // Same image, either there is no HUD on screen or candidate already has it
+    if (stats.Pixels == 0 || stats.DiffPixels == 0)
+        return HudlessVerdict::Unknown;
+
+    if (stats.MeanDelta >= BadMeanDelta)
+        return HudlessVerdict::Bad;
+
+    auto tileShare = stats.ChangedTileShare();
+
+    if (tileShare >= BadTileShare && stats.Coverage() >= BadCoverage)
+        return HudlessVerdict::Bad;
+
+    if (tileShare < GoodTileShare)
+        return HudlessVerdict::Good;
+
+    return HudlessVerdict::Unknown;
+}
+
+HudlessVerdict HudlessValidator::AddSample(uint64_t id, const HudlessStats& stats, uint64_t frame)
+{
+    auto& candidate = _candidates[id];
+
+    if (candidate.Verdict != HudlessVerdict::Unknown)
+        return HudlessVerdict::Unknown;
+
+    // Candidate matched the final image before, whole image changing now is a fade or an overlay
+    if (candidate.TotalGood > 0 && WholeImage(stats))
+        return HudlessVerdict::Unknown;
+
+    auto verdict = Score(stats);
+
+    if (verdict == HudlessVerdict::Unknown)
+        return HudlessVerdict::Unknown;
+
+    if (verdict == HudlessVerdict::Good)
+    {
+        candidate.Good++;
+        candidate.TotalGood++;
+    }
+    else
+    {
+        candidate.Bad++;
+    }
+
+    if (candidate.TotalGood >= TrustSamples)
+    {
+        candidate.Verdict = HudlessVerdict::Good;
+        return HudlessVerdict::Good;
+    }
+
+    auto total = candidate.Good + candidate.Bad;
+
+    if (candidate.Bad >= RejectSamples && candidate.Bad >= total * RejectShare)
+    {
+        candidate.Verdict = HudlessVerdict::Bad;
+        candidate.RetryFrame = frame + (RetryFrames << std::min(candidate.Rejections, MaxRetryShift));
+        candidate.Rejections++;
+        _rejected++;
+        return HudlessVerdict::Bad;
+    }
+
+    // Keep the recent history only
+    if (total >= Window)
+    {
+        candidate.Good /= 2;
+        candidate.Bad /= 2;
+    }
+
+    return HudlessVerdict::Unknown;
+}
+
+bool HudlessValidator::WantsSample(uint64_t id, uint64_t frame)
+{
+    auto& candidate = _candidates[id];
+
+    if (candidate.Verdict != HudlessVerdict::Unknown)
+        return false;
+
+    // First sample right away, then sparse so a few seconds of pause menu can't fill the window
+    if (candidate.LastSampleFrame != 0 && frame < candidate.LastSampleFrame + SampleInterval)
+        return false;
+
+    candidate.LastSampleFrame = frame == 0 ? 1 : frame;
+    return true;
+}
+
+HudlessVerdict HudlessValidator::Verdict(uint64_t id) const
+{
+    auto it = _candidates.find(id);
+    return it == _candidates.end() ? HudlessVerdict::Unknown : it->second.Verdict;
+}
+
+void HudlessValidator::Remove(uint64_t id)
+{
+    auto it = _candidates.find(id);
+
+    if (it == _candidates.end())
+        return;
+
+    if (it->second.Verdict == HudlessVerdict::Bad)
+        _rejected--;
+
+    _candidates.erase(it);
+}
+
+void HudlessValidator::Reset()
+{
+    _candidates.clear();
+    _rejected = 0;
+}
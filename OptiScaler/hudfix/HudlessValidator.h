@@ -0,0 +1,116 @@
+#pragma once
+#include "SysUtils.h"
+
+#include <ankerl/unordered_dense.h>
+
+// One tile of the stats buffer written by HV_Dx12, layout must match the shader
+struct HudlessTileStats
+{
+    uint32_t Pixels = 0;     // Pixels of the tile inside the image
+    uint32_t DiffPixels = 0; // Pixels which differ more than the threshold
+    uint32_t DeltaSum = 0;   // Sum of largest channel difference, 0-255 per pixel
+    uint32_t MaxDelta = 0;   // 0-255
+};
+
+struct HudlessStats
+{
+    uint32_t Tiles = 0;
+    uint32_t ChangedTiles = 0; // Tiles with more than TileCoverage of their pixels different
+    uint64_t Pixels = 0;
+    uint64_t DiffPixels = 0;
+    float MeanDelta = 0.0f; // 0.0 - 1.0
+
+    float ChangedTileShare() const { return Tiles == 0 ? 0.0f : (float) ChangedTiles / (float) Tiles; }
+    float Coverage() const { return Pixels == 0 ? 0.0f : (float) ((double) DiffPixels / (double) Pixels); }
+};
+
+enum class HudlessVerdict : uint8_t
+{
+    Unknown,
+    Good,
+    Bad,
+};
+
+// Scores hudless candidates by comparing them with the final (with HUD) image.
+// Correct hudless only differs where the HUD is drawn, which is a limited part of the screen,
+// picks from an earlier stage of the frame (before tonemap, post process etc.) or unrelated
+// targets differ almost everywhere. Pause menus, fades & loading screens look the same as a wrong pick,
+// so candidates are sampled sparsely over a long window, whole image changes are ignored once a candidate
+// matched the final image before, and rejected candidates are tried again after a back off.
+// Once a candidate proved itself it is trusted and not sampled anymore.
+// Doesn't touch any D3D12 or global state so it can be fed with synthetic stats.
+class HudlessValidator
+{
+  public:
+    static constexpr float TileCoverage = 0.01f;
+
+    // Single sample limits
+    static constexpr float BadTileShare = 0.7f;
+    static constexpr float BadCoverage = 0.4f;
+    static constexpr float BadMeanDelta = 0.2f;
+    static constexpr float GoodTileShare = 0.5f;
+    static constexpr float WholeImageShare = 0.95f;
+
+    // Candidate limits, counted in samples
+    static constexpr uint64_t SampleInterval = 8; // Frames between two samples of a candidate
+    static constexpr uint32_t Window = 60;        // ~480 frames
+    static constexpr uint32_t RejectSamples = 30;
+    static constexpr float RejectShare = 0.85f;
+    static constexpr uint32_t TrustSamples = 120;
+
+    // Rejected candidates are sampled again after this many frames, doubled on every rejection up to 8x
+    static constexpr uint64_t RetryFrames = 1800;
+    static constexpr uint32_t MaxRetryShift = 3;
+
+    static HudlessStats Reduce(const HudlessTileStats* tiles, size_t count);
+    static HudlessVerdict Score(const HudlessStats& stats);
+
+    // Fade, dim, loading screen or a pick which doesn't match at all
+    static bool WholeImage(const HudlessStats& stats) { return stats.ChangedTileShare() >= WholeImageShare; }
+
+    // Returns Bad only once, when the candidate should be rejected
+    HudlessVerdict AddSample(uint64_t id, const HudlessStats& stats, uint64_t frame);
+
+    // True once every SampleInterval frames, false for trusted & rejected candidates
+    bool WantsSample(uint64_t id, uint64_t frame);
+
+    // Calls fn(id) for rejected candidates which should be sampled again
+    template <typename Fn> void Retry(uint64_t frame, Fn&& fn)
+    {
+        if (_rejected == 0)
+            return;
+
+        for (auto& [id, candidate] : _candidates)
+        {
+            if (candidate.Verdict != HudlessVerdict::Bad || frame < candidate.RetryFrame)
+                continue;
+
+            candidate.Verdict = HudlessVerdict::Unknown;
+            candidate.Good = 0;
+            candidate.Bad = 0;
+            _rejected--;
+
+            fn(id);
+        }
+    }
+
+    HudlessVerdict Verdict(uint64_t id) const;
+
+    void Remove(uint64_t id);
+    void Reset();
+
+  private:
+    struct Candidate
+    {
+        uint32_t Good = 0;
+        uint32_t Bad = 0;
+        uint32_t TotalGood = 0;
+        uint32_t Rejections = 0;
+        uint64_t LastSampleFrame = 0;
+        uint64_t RetryFrame = 0;
+        HudlessVerdict Verdict = HudlessVerdict::Unknown;
+    };
+
+    ankerl::unordered_dense::map<uint64_t, Candidate> _candidates;
+    uint32_t _rejected = 0;
+};
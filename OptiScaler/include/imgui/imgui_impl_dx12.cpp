@@ -100,6 +100,17 @@ static ImGui_ImplDX12_Data* ImGui_ImplDX12_GetBackendData()
     return ImGui::GetCurrentContext() ? (ImGui_ImplDX12_Data*)ImGui::GetIO().BackendRendererUserData : nullptr;
 }
 
+// Draw recorded from the draw data uploaded into a set of render buffers
+struct ImGui_ImplDX12_CachedDraw
+{
+    D3D12_RECT          Scissor;
+    UINT64              Texture;
+    UINT                ElemCount;
+    UINT                StartIndex;
+    INT                 BaseVertex;
+    bool                ResetRenderState;
+};
+
 // Buffers used during the rendering of a frame
 struct ImGui_ImplDX12_RenderBuffers
 {
@@ -107,6 +118,10 @@ struct ImGui_ImplDX12_RenderBuffers
     ID3D12Resource*     VertexBuffer;
     int                 IndexBufferSize;
     int                 VertexBufferSize;
+
+    // Generation of the draw data in the buffers (0 = none), its draws are replayed while the caller passes the same one
+    ImU64                               Generation;
+    ImVector<ImGui_ImplDX12_CachedDraw> Draws;
 };
 
 // Buffers used for secondary viewports created by the multi-viewports systems
@@ -161,6 +176,7 @@ struct ImGui_ImplDX12_ViewportData
             FrameRenderBuffers[i].VertexBuffer = nullptr;
             FrameRenderBuffers[i].VertexBufferSize = 5000;
             FrameRenderBuffers[i].IndexBufferSize = 10000;
+            FrameRenderBuffers[i].Generation = 0;
         }
     }
     ~ImGui_ImplDX12_ViewportData()
@@ -255,7 +271,7 @@ static inline void SafeRelease(T*& res)
 }
 
 // Render function
-void ImGui_ImplDX12_RenderDrawData(ImDrawData* draw_data, ID3D12GraphicsCommandList* command_list)
+void ImGui_ImplDX12_RenderDrawData(ImDrawData* draw_data, ID3D12GraphicsCommandList* command_list, int buffer_index, ImU64 generation)
 {
     // Avoid rendering when minimized
     if (draw_data->DisplaySize.x <= 0.0f || draw_data->DisplaySize.y <= 0.0f)
@@ -272,7 +288,32 @@ void ImGui_ImplDX12_RenderDrawData(ImDrawData* draw_data, ID3D12GraphicsCommandL
     ImGui_ImplDX12_Data* bd = ImGui_ImplDX12_GetBackendData();
     ImGui_ImplDX12_ViewportData* vd = (ImGui_ImplDX12_ViewportData*)draw_data->OwnerViewport->RendererUserData;
     vd->FrameIndex++;
-    ImGui_ImplDX12_RenderBuffers* fr = &vd->FrameRenderBuffers[vd->FrameIndex % bd->numFramesInFlight];
+    UINT buffer = buffer_index >= 0 ? (UINT)buffer_index : vd->FrameIndex;
+    ImGui_ImplDX12_RenderBuffers* fr = &vd->FrameRenderBuffers[buffer % bd->numFramesInFlight];
+
+    // Draw data didn't change since it was uploaded into these buffers, skip the upload and the draw list walk
+    if (generation != 0 && fr->Generation == generation)
+    {
+        ImGui_ImplDX12_SetupRenderState(draw_data, command_list, fr);
+
+        for (const ImGui_ImplDX12_CachedDraw& draw : fr->Draws)
+        {
+            if (draw.ResetRenderState)
+            {
+                ImGui_ImplDX12_SetupRenderState(draw_data, command_list, fr);
+                continue;
+            }
+
+            command_list->RSSetScissorRects(1, &draw.Scissor);
+            D3D12_GPU_DESCRIPTOR_HANDLE texture_handle = {};
+            texture_handle.ptr = draw.Texture;
+            command_list->SetGraphicsRootDescriptorTable(1, texture_handle);
+            command_list->DrawIndexedInstanced(draw.ElemCount, 1, draw.StartIndex, draw.BaseVertex, 0);
+        }
+        return;
+    }
+    fr->Generation = 0;
+    fr->Draws.resize(0);
 
     // Create and grow vertex/index buffers if needed
     if (fr->VertexBuffer == nullptr || fr->VertexBufferSize < draw_data->TotalVtxCount)
@@ -357,6 +398,8 @@ void ImGui_ImplDX12_RenderDrawData(ImDrawData* draw_data, ID3D12GraphicsCommandL
 
     // Render command lists
     // (Because we merged all buffers into a single one, we maintain our own offset into them)
+    // User callbacks can't be replayed, draw data using them is never cached
+    bool cacheable = generation != 0;
     int global_vtx_offset = 0;
     int global_idx_offset = 0;
     ImVec2 clip_off = draw_data->DisplayPos;
@@ -372,9 +415,20 @@ void ImGui_ImplDX12_RenderDrawData(ImDrawData* draw_data, ID3D12GraphicsCommandL
                 // User callback, registered via ImDrawList::AddCallback()
                 // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
                 if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
+                {
                     ImGui_ImplDX12_SetupRenderState(draw_data, command_list, fr);
+                    if (cacheable)
+                    {
+                        ImGui_ImplDX12_CachedDraw draw = {};
+                        draw.ResetRenderState = true;
+                        fr->Draws.push_back(draw);
+                    }
+                }
                 else
+                {
                     pcmd->UserCallback(draw_list, pcmd);
+                    cacheable = false;
+                }
             }
             else
             {
@@ -393,12 +447,26 @@ void ImGui_ImplDX12_RenderDrawData(ImDrawData* draw_data, ID3D12GraphicsCommandL
                 texture_handle.ptr = (UINT64)pcmd->GetTexID();
                 command_list->SetGraphicsRootDescriptorTable(1, texture_handle);
                 command_list->DrawIndexedInstanced(pcmd->ElemCount, 1, pcmd->IdxOffset + global_idx_offset, pcmd->VtxOffset + global_vtx_offset, 0);
+
+                if (cacheable)
+                {
+                    ImGui_ImplDX12_CachedDraw draw = {};
+                    draw.Scissor = r;
+                    draw.Texture = texture_handle.ptr;
+                    draw.ElemCount = pcmd->ElemCount;
+                    draw.StartIndex = pcmd->IdxOffset + global_idx_offset;
+                    draw.BaseVertex = pcmd->VtxOffset + global_vtx_offset;
+                    fr->Draws.push_back(draw);
+                }
             }
         }
         global_idx_offset += draw_list->IdxBuffer.Size;
         global_vtx_offset += draw_list->VtxBuffer.Size;
     }
     platform_io.Renderer_RenderState = nullptr;
+
+    if (cacheable)
+        fr->Generation = generation;
 }
 
 static void ImGui_ImplDX12_DestroyTexture(ImTextureData* tex)
@@ -852,6 +920,8 @@ static void ImGui_ImplDX12_DestroyRenderBuffers(ImGui_ImplDX12_RenderBuffers* re
     SafeRelease(render_buffers->IndexBuffer);
     SafeRelease(render_buffers->VertexBuffer);
     render_buffers->IndexBufferSize = render_buffers->VertexBufferSize = 0;
+    render_buffers->Generation = 0;
+    render_buffers->Draws.clear();
 }
 
 void    ImGui_ImplDX12_InvalidateDeviceObjects()
@@ -98,7 +98,9 @@ struct ImGui_ImplDX12_InitInfo
 IMGUI_IMPL_API bool     ImGui_ImplDX12_Init(ImGui_ImplDX12_InitInfo* info);
 IMGUI_IMPL_API void     ImGui_ImplDX12_Shutdown(bool shutdown_platform = true, bool invalidate = true);
 IMGUI_IMPL_API void     ImGui_ImplDX12_NewFrame();
-IMGUI_IMPL_API void     ImGui_ImplDX12_RenderDrawData(ImDrawData* draw_data, ID3D12GraphicsCommandList* graphics_command_list);
+// - buffer_index: render buffers to use (e.g. the backbuffer index), -1 cycles through them
+// - generation: non zero id of the draw data, when it matches the last upload into the buffers only the draws are recorded again
+IMGUI_IMPL_API void     ImGui_ImplDX12_RenderDrawData(ImDrawData* draw_data, ID3D12GraphicsCommandList* graphics_command_list, int buffer_index = -1, ImU64 generation = 0);
 
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
 // Legacy initialization API Obsoleted in 1.91.5
@@ -0,0 +1,137 @@
+#pragma once
+#include "SysUtils.h"
+
+#include <ankerl/unordered_dense.h>
+
+#include <deque>
+#include <vector>
+
+// Slot index + generation, generation changes every time a slot is freed
+// so handles of destroyed contexts never resolve to a newer context in the same slot
+struct ContextSlotHandle
+{
+    uint32_t Index = 0;
+    uint32_t Generation = 0; // 0 is never a valid generation
+
+    bool IsValid() const { return Generation != 0; }
+    bool operator==(const ContextSlotHandle& other) const = default;
+
+    // For inputs which hand out their own context values, a packed valid handle is never 0
+    uint64_t Pack() const { return ((uint64_t) Generation << 32) | Index; }
+    static ContextSlotHandle Unpack(uint64_t packed) { return { (uint32_t) packed, (uint32_t) (packed >> 32) }; }
+};
+
+// Keeps everything an input layer knows about a game context in one struct,
+// instead of one map per field. Game context -> entry is a single hash lookup,
+// handle -> entry is an index + generation check, so inputs resolve the game context once per call
+// and pass the handle around. Entry addresses are stable until the entry is erased.
+// Not thread safe, same as the maps it replaces.
+template <typename Key, typename Value> class ContextSlotMap
+{
+  private:
+    struct Slot
+    {
+        Value Data {};
+        uint32_t Generation = 1;
+        bool Used = false;
+    };
+
+    std::deque<Slot> _slots;
+    std::vector<uint32_t> _freeSlots;
+    ankerl::unordered_dense::map<Key, ContextSlotHandle> _lookup;
+
+  public:
+    Value* Get(ContextSlotHandle handle)
+    {
+        if (handle.Index >= _slots.size())
+            return nullptr;
+
+        auto& slot = _slots[handle.Index];
+
+        if (!slot.Used || slot.Generation != handle.Generation)
+            return nullptr;
+
+        return &slot.Data;
+    }
+
+    Value* Find(Key key)
+    {
+        auto it = _lookup.find(key);
+
+        if (it == _lookup.end())
+            return nullptr;
+
+        return Get(it->second);
+    }
+
+    ContextSlotHandle HandleOf(Key key) const
+    {
+        auto it = _lookup.find(key);
+
+        if (it == _lookup.end())
+            return {};
+
+        return it->second;
+    }
+
+    // Handle the next Emplace of a new key gets, lets inputs build their context values from it
+    ContextSlotHandle NextHandle() const
+    {
+        if (!_freeSlots.empty())
+            return { _freeSlots.back(), _slots[_freeSlots.back()].Generation };
+
+        return { (uint32_t) _slots.size(), 1 };
+    }
+
+    // Returns the existing entry of key or a new default constructed one
+    Value& Emplace(Key key)
+    {
+        if (auto existing = Find(key); existing != nullptr)
+            return *existing;
+
+        uint32_t index = 0;
+
+        if (!_freeSlots.empty())
+        {
+            index = _freeSlots.back();
+            _freeSlots.pop_back();
+        }
+        else
+        {
+            index = (uint32_t) _slots.size();
+            _slots.emplace_back();
+        }
+
+        auto& slot = _slots[index];
+        slot.Used = true;
+        slot.Data = {};
+
+        _lookup[key] = { index, slot.Generation };
+
+        return slot.Data;
+    }
+
+    bool Erase(Key key)
+    {
+        auto it = _lookup.find(key);
+
+        if (it == _lookup.end())
+            return false;
+
+        auto& slot = _slots[it->second.Index];
+        slot.Used = false;
+        slot.Data = {};
+
+        // Skip 0 when wrapping, it marks invalid handles
+        if (++slot.Generation == 0)
+            slot.Generation = 1;
+
+        _freeSlots.push_back(it->second.Index);
+        _lookup.erase(it);
+
+        return true;
+    }
+
+    bool Contains(Key key) const { return _lookup.contains(key); }
+    size_t Size() const { return _lookup.size(); }
+};
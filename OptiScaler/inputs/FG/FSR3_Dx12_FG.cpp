@@ -3,6 +3,7 @@
 
 #include "Config.h"
 #include "Util.h"
+#include "misc/VramRegistry.h"
 #include "MathUtils.h"
 
 #include "resource.h"
@@ -338,6 +339,7 @@ static bool CreateBufferResource(ID3D12Device* InDevice, ID3D12Resource* InResou
     }
 
     LOG_DEBUG("Created new one: {}x{}", inDesc.Width, inDesc.Height);
+    VramRegistry::Instance().Track(*OutResource, "FSR3 FG", "Resource copy");
     return true;
 }
 
@@ -4,6 +4,7 @@
 
 #include <Util.h>
 #include <Config.h>
+#include <misc/VramRegistry.h>
 
 #include <magic_enum.hpp>
 
@@ -213,6 +214,7 @@ static bool CreateBufferResource(ID3D12Device* InDevice, ID3D12Resource* InResou
     }
 
     LOG_DEBUG("Created new one: {}x{}", inDesc.Width, inDesc.Height);
+    VramRegistry::Instance().Track(*OutResource, "FfxApi FG", "Resource copy");
     return false;
 }
 
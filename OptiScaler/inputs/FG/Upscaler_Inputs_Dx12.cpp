@@ -142,12 +142,13 @@ void UpscalerInputsDx12::UpscaleStart(ID3D12GraphicsCommandList* InCmdList, NVSD
     if (!State::Instance().isShuttingDown && fg->IsActive() && Config::Instance()->FGEnabled.value_or_default() &&
         State::Instance().currentSwapchain != nullptr)
     {
-        // Wait for present
-        if (fg->Mutex.getOwner() == 2)
+        // Wait if an in-flight present still reads the resources of this frame's index. On timeout
+        // don't overwrite them and let FG skip this frame
+        if (!fg->PresentTicket.WaitFor(fg->FrameCount()))
         {
-            LOG_TRACE("Waiting for present!");
-            fg->Mutex.lock(4);
-            fg->Mutex.unlockThis(4);
+            LOG_WARN("(FG) present still in flight, dropping frame: {}", fg->FrameCount());
+            _droppedFrame = fg->FrameCount();
+            return;
         }
 
         bool allocatorReset = false;
@@ -253,6 +254,10 @@ void UpscalerInputsDx12::UpscaleEnd(ID3D12GraphicsCommandList* InCmdList, NVSDK_
     if (fg == nullptr || State::Instance().activeFgInput != FGInput::Upscaler || _device == nullptr)
         return;
 
+    // Inputs weren't copied at UpscaleStart
+    if (_droppedFrame == fg->FrameCount())
+        return;
+
     // FG Dispatch
     if (fg->IsActive() && Config::Instance()->FGEnabled.value_or_default() &&
         State::Instance().currentSwapchain != nullptr)
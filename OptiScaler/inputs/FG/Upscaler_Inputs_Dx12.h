@@ -7,6 +7,7 @@ class UpscalerInputsDx12
 {
   private:
     inline static ID3D12Device* _device = nullptr;
+    inline static UINT64 _droppedFrame = UINT64_MAX;
 
   public:
     static void Init(ID3D12Device* device);
@@ -5,6 +5,7 @@
 #include "Config.h"
 #include "resource.h"
 #include "NVNGX_Parameter.h"
+#include "ContextSlotMap.h"
 
 #include <proxies/KernelBase_Proxy.h>
 
@@ -38,9 +39,14 @@ static PFN_ffxFsr2GetUpscaleRatioFromQualityMode o_ffxFsr2GetUpscaleRatioFromQua
 static PFN_ffxFsr2GetRenderResolutionFromQualityMode o_ffxFsr2GetRenderResolutionFromQualityMode_Dx11 = nullptr;
 static PFN_ffxFsr2GetJitterPhaseCount o_ffxFsr2GetJitterPhaseCount_Dx11 = nullptr;
 
-static std::unordered_map<FfxFsr2Context*, FfxFsr2ContextDescription> _initParams;
-static std::unordered_map<FfxFsr2Context*, NVSDK_NGX_Parameter*> _nvParams;
-static std::unordered_map<FfxFsr2Context*, NVSDK_NGX_Handle*> _contexts;
+struct Fsr2Dx11Context
+{
+    FfxFsr2ContextDescription InitParams {};
+    NVSDK_NGX_Parameter* Params = nullptr;
+    NVSDK_NGX_Handle* Handle = nullptr; // Created on first dispatch
+};
+
+static ContextSlotMap<FfxFsr2Context*, Fsr2Dx11Context> _contexts;
 static ID3D11Device* _d3d11Device = nullptr;
 static bool _nvnxgInited = false;
 static bool _skipCreate = false;
@@ -48,16 +54,18 @@ static bool _skipDispatch = false;
 static bool _skipDestroy = false;
 static float qualityRatios[] = { 1.0f, 1.5f, 1.7f, 2.0f, 3.0f };
 
-static bool CreateDLSSContext(FfxFsr2Context* handle, const FfxFsr2DispatchDescription* pExecParams)
+static bool CreateDLSSContext(ContextSlotHandle slot, const FfxFsr2DispatchDescription* pExecParams)
 {
     LOG_DEBUG("");
 
-    if (!_nvParams.contains(handle))
+    auto entry = _contexts.Get(slot);
+
+    if (entry == nullptr)
         return false;
 
     NVSDK_NGX_Handle* nvHandle = nullptr;
-    auto params = _nvParams[handle];
-    auto initParams = &_initParams[handle];
+    auto params = entry->Params;
+    auto initParams = &entry->InitParams;
     auto commandList = (ID3D11DeviceContext*) pExecParams->commandList;
 
     UINT initFlags = 0;
@@ -103,7 +111,7 @@ static bool CreateDLSSContext(FfxFsr2Context* handle, const FfxFsr2DispatchDescr
         NVSDK_NGX_Result_Success)
         return false;
 
-    _contexts[handle] = nvHandle;
+    entry->Handle = nvHandle;
 
     return true;
 }
@@ -234,13 +242,14 @@ static FfxErrorCode ffxFsr2ContextCreate_Dx11(FfxFsr2Context* context, FfxFsr2Co
     if (NVSDK_NGX_D3D11_GetCapabilityParameters(&params) != NVSDK_NGX_Result_Success)
         return FFX_ERROR_BACKEND_API_ERROR;
 
-    _nvParams[context] = params;
+    auto& entry = _contexts.Emplace(context);
+    entry.Params = params;
 
     FfxFsr2ContextDescription ccd {};
     ccd.flags = contextDescription->flags;
     ccd.maxRenderSize = contextDescription->maxRenderSize;
     ccd.displaySize = contextDescription->displaySize;
-    _initParams[context] = ccd;
+    entry.InitParams = ccd;
 
     LOG_INFO("context created: {:X}", (size_t) context);
 
@@ -266,13 +275,18 @@ static FfxErrorCode ffxFsr2ContextDispatch_Dx11(FfxFsr2Context* context,
     if (dispatchDescription == nullptr || context == nullptr || dispatchDescription->commandList == nullptr)
         return FFX_ERROR_INVALID_ARGUMENT;
 
-    // If not in contexts list create and add context
-    if (!_contexts.contains(context) && _initParams.contains(context) &&
-        !CreateDLSSContext(context, dispatchDescription))
+    auto slot = _contexts.HandleOf(context);
+    auto entry = _contexts.Get(slot);
+
+    if (entry == nullptr)
+        return FFX_ERROR_INVALID_ARGUMENT;
+
+    // If NGX feature is not created yet create it
+    if (entry->Handle == nullptr && !CreateDLSSContext(slot, dispatchDescription))
         return FFX_ERROR_INVALID_ARGUMENT;
 
-    NVSDK_NGX_Parameter* params = _nvParams[context];
-    NVSDK_NGX_Handle* handle = _contexts[context];
+    NVSDK_NGX_Parameter* params = entry->Params;
+    NVSDK_NGX_Handle* handle = entry->Handle;
 
     params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, dispatchDescription->jitterOffset.x);
     params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, dispatchDescription->jitterOffset.y);
@@ -321,12 +335,10 @@ static FfxErrorCode ffxFsr2ContextDestroy_Dx11(FfxFsr2Context* context)
     if (context == nullptr)
         return FFX_ERROR_INVALID_ARGUMENT;
 
-    if (_contexts.contains(context))
-        NVSDK_NGX_D3D11_ReleaseFeature(_contexts[context]);
+    if (auto entry = _contexts.Find(context); entry != nullptr && entry->Handle != nullptr)
+        NVSDK_NGX_D3D11_ReleaseFeature(entry->Handle);
 
-    _contexts.erase(context);
-    _nvParams.erase(context);
-    _initParams.erase(context);
+    _contexts.Erase(context);
 
     _skipDestroy = true;
     auto cdResult = o_ffxFsr2ContextDestroy_Dx11(context);
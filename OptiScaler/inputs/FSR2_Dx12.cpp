@@ -5,6 +5,7 @@
 #include "Config.h"
 #include "resource.h"
 #include "NVNGX_Parameter.h"
+#include "ContextSlotMap.h"
 
 #include <proxies/KernelBase_Proxy.h>
 
@@ -110,9 +111,14 @@ static PFN_ffxFsr2GetRenderResolutionFromQualityMode o_ffxFsr2GetRenderResolutio
 static PFN_ffxGetResourceFromDX12Resource_Dx12 o_ffxGetResourceFromDX12Resource_Dx12 = nullptr;
 static PFN_ffxFsr2GetInterfaceDX12 o_ffxFsr2GetInterfaceDX12 = nullptr;
 
-static std::unordered_map<Fsr212::FfxFsr2Context*, Fsr212::FfxFsr2ContextDescription> _initParams;
-static std::unordered_map<Fsr212::FfxFsr2Context*, NVSDK_NGX_Parameter*> _nvParams;
-static std::unordered_map<Fsr212::FfxFsr2Context*, NVSDK_NGX_Handle*> _contexts;
+struct Fsr2Dx12Context
+{
+    Fsr212::FfxFsr2ContextDescription InitParams {};
+    NVSDK_NGX_Parameter* Params = nullptr;
+    NVSDK_NGX_Handle* Handle = nullptr; // Created on first dispatch
+};
+
+static ContextSlotMap<Fsr212::FfxFsr2Context*, Fsr2Dx12Context> _contexts;
 static ID3D12Device* _d3d12Device = nullptr;
 static bool _nvnxgInited = false;
 static bool _skipCreate = false;
@@ -120,16 +126,18 @@ static bool _skipDispatch = false;
 static bool _skipDestroy = false;
 static float qualityRatios[] = { 1.0f, 1.5f, 1.7f, 2.0f, 3.0f };
 
-static bool CreateDLSSContext(Fsr212::FfxFsr2Context* handle, const Fsr212::FfxFsr2DispatchDescription* pExecParams)
+static bool CreateDLSSContext(ContextSlotHandle slot, const Fsr212::FfxFsr2DispatchDescription* pExecParams)
 {
     LOG_DEBUG("");
 
-    if (!_nvParams.contains(handle))
+    auto entry = _contexts.Get(slot);
+
+    if (entry == nullptr)
         return false;
 
     NVSDK_NGX_Handle* nvHandle = nullptr;
-    auto params = _nvParams[handle];
-    auto initParams = &_initParams[handle];
+    auto params = entry->Params;
+    auto initParams = &entry->InitParams;
     auto commandList = (ID3D12GraphicsCommandList*) pExecParams->commandList;
 
     UINT initFlags = 0;
@@ -175,21 +183,23 @@ static bool CreateDLSSContext(Fsr212::FfxFsr2Context* handle, const Fsr212::FfxF
         NVSDK_NGX_Result_Success)
         return false;
 
-    _contexts[handle] = nvHandle;
+    entry->Handle = nvHandle;
 
     return true;
 }
 
-static bool CreateDLSSContext20(Fsr212::FfxFsr2Context* handle, const FfxFsr20DispatchDescription* pExecParams)
+static bool CreateDLSSContext20(ContextSlotHandle slot, const FfxFsr20DispatchDescription* pExecParams)
 {
     LOG_DEBUG("");
 
-    if (!_nvParams.contains(handle))
+    auto entry = _contexts.Get(slot);
+
+    if (entry == nullptr)
         return false;
 
     NVSDK_NGX_Handle* nvHandle = nullptr;
-    auto params = _nvParams[handle];
-    auto initParams = &_initParams[handle];
+    auto params = entry->Params;
+    auto initParams = &entry->InitParams;
     auto commandList = (ID3D12GraphicsCommandList*) pExecParams->commandList;
 
     UINT initFlags = 0;
@@ -235,22 +245,24 @@ static bool CreateDLSSContext20(Fsr212::FfxFsr2Context* handle, const FfxFsr20Di
         NVSDK_NGX_Result_Success)
         return false;
 
-    _contexts[handle] = nvHandle;
+    entry->Handle = nvHandle;
 
     return true;
 }
 
 // Tiny Tina's Wonderland
-static bool CreateDLSSContextTiny(Fsr212::FfxFsr2Context* handle, const FfxFsr2TinyDispatchDescription* pExecParams)
+static bool CreateDLSSContextTiny(ContextSlotHandle slot, const FfxFsr2TinyDispatchDescription* pExecParams)
 {
     LOG_DEBUG("");
 
-    if (!_nvParams.contains(handle))
+    auto entry = _contexts.Get(slot);
+
+    if (entry == nullptr)
         return false;
 
     NVSDK_NGX_Handle* nvHandle = nullptr;
-    auto params = _nvParams[handle];
-    auto initParams = &_initParams[handle];
+    auto params = entry->Params;
+    auto initParams = &entry->InitParams;
     auto commandList = (ID3D12GraphicsCommandList*) pExecParams->commandList;
 
     UINT initFlags = 0;
@@ -296,7 +308,7 @@ static bool CreateDLSSContextTiny(Fsr212::FfxFsr2Context* handle, const FfxFsr2T
         NVSDK_NGX_Result_Success)
         return false;
 
-    _contexts[handle] = nvHandle;
+    entry->Handle = nvHandle;
 
     return true;
 }
@@ -431,13 +443,14 @@ static Fsr212::FfxErrorCode ffxFsr2ContextCreate_Dx12(Fsr212::FfxFsr2Context* co
     if (NVSDK_NGX_D3D12_GetCapabilityParameters(&params) != NVSDK_NGX_Result_Success)
         return Fsr212::FFX_ERROR_BACKEND_API_ERROR;
 
-    _nvParams[context] = params;
+    auto& entry = _contexts.Emplace(context);
+    entry.Params = params;
 
     Fsr212::FfxFsr2ContextDescription ccd {};
     ccd.flags = contextDescription->flags;
     ccd.maxRenderSize = contextDescription->maxRenderSize;
     ccd.displaySize = contextDescription->displaySize;
-    _initParams[context] = ccd;
+    entry.InitParams = ccd;
 
     LOG_INFO("context created: {:X}", (size_t) context);
 
@@ -549,13 +562,14 @@ static Fsr212::FfxErrorCode ffxFsr2ContextCreate_Pattern_Dx12(Fsr212::FfxFsr2Con
     if (NVSDK_NGX_D3D12_GetCapabilityParameters(&params) != NVSDK_NGX_Result_Success)
         return Fsr212::FFX_ERROR_BACKEND_API_ERROR;
 
-    _nvParams[context] = params;
+    auto& entry = _contexts.Emplace(context);
+    entry.Params = params;
 
     Fsr212::FfxFsr2ContextDescription ccd {};
     ccd.flags = contextDescription->flags;
     ccd.maxRenderSize = contextDescription->maxRenderSize;
     ccd.displaySize = contextDescription->displaySize;
-    _initParams[context] = ccd;
+    entry.InitParams = ccd;
 
     LOG_INFO("context created: {:X}", (size_t) context);
 
@@ -591,13 +605,18 @@ static Fsr212::FfxErrorCode ffxFsr2ContextDispatch_Dx12(Fsr212::FfxFsr2Context*
     if (dispatchDescription == nullptr || context == nullptr || dispatchDescription->commandList == nullptr)
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
-    // If not in contexts list create and add context
-    if (!_contexts.contains(context) && _initParams.contains(context) &&
-        !CreateDLSSContext(context, dispatchDescription))
+    auto slot = _contexts.HandleOf(context);
+    auto entry = _contexts.Get(slot);
+
+    if (entry == nullptr)
+        return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
+
+    // If NGX feature is not created yet create it
+    if (entry->Handle == nullptr && !CreateDLSSContext(slot, dispatchDescription))
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
-    NVSDK_NGX_Parameter* params = _nvParams[context];
-    NVSDK_NGX_Handle* handle = _contexts[context];
+    NVSDK_NGX_Parameter* params = entry->Params;
+    NVSDK_NGX_Handle* handle = entry->Handle;
 
     params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, dispatchDescription->jitterOffset.x);
     params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, dispatchDescription->jitterOffset.y);
@@ -655,13 +674,18 @@ ffxFsr2ContextDispatch_Pattern_Dx12(Fsr212::FfxFsr2Context* context,
     if (dispatchDescription == nullptr || context == nullptr || dispatchDescription->commandList == nullptr)
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
-    // If not in contexts list create and add context
-    if (!_contexts.contains(context) && _initParams.contains(context) &&
-        !CreateDLSSContext(context, dispatchDescription))
+    auto slot = _contexts.HandleOf(context);
+    auto entry = _contexts.Get(slot);
+
+    if (entry == nullptr)
+        return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
+
+    // If NGX feature is not created yet create it
+    if (entry->Handle == nullptr && !CreateDLSSContext(slot, dispatchDescription))
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
-    NVSDK_NGX_Parameter* params = _nvParams[context];
-    NVSDK_NGX_Handle* handle = _contexts[context];
+    NVSDK_NGX_Parameter* params = entry->Params;
+    NVSDK_NGX_Handle* handle = entry->Handle;
 
     params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, dispatchDescription->jitterOffset.x);
     params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, dispatchDescription->jitterOffset.y);
@@ -722,13 +746,18 @@ static Fsr212::FfxErrorCode ffxFsr20ContextDispatch_Dx12(Fsr212::FfxFsr2Context*
     if (dispatchDescription == nullptr || context == nullptr || dispatchDescription->commandList == nullptr)
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
-    // If not in contexts list create and add context
-    if (!_contexts.contains(context) && _initParams.contains(context) &&
-        !CreateDLSSContext20(context, dispatchDescription))
+    auto slot = _contexts.HandleOf(context);
+    auto entry = _contexts.Get(slot);
+
+    if (entry == nullptr)
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
-    NVSDK_NGX_Parameter* params = _nvParams[context];
-    NVSDK_NGX_Handle* handle = _contexts[context];
+    // If NGX feature is not created yet create it
+    if (entry->Handle == nullptr && !CreateDLSSContext20(slot, dispatchDescription))
+        return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
+
+    NVSDK_NGX_Parameter* params = entry->Params;
+    NVSDK_NGX_Handle* handle = entry->Handle;
 
     params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, dispatchDescription->jitterOffset.x);
     params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, dispatchDescription->jitterOffset.y);
@@ -790,13 +819,18 @@ static Fsr212::FfxErrorCode ffxFsr20ContextDispatch_Pattern_Dx12(Fsr212::FfxFsr2
     if (dispatchDescription == nullptr || context == nullptr || dispatchDescription->commandList == nullptr)
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
-    // If not in contexts list create and add context
-    if (!_contexts.contains(context) && _initParams.contains(context) &&
-        !CreateDLSSContext20(context, dispatchDescription))
+    auto slot = _contexts.HandleOf(context);
+    auto entry = _contexts.Get(slot);
+
+    if (entry == nullptr)
+        return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
+
+    // If NGX feature is not created yet create it
+    if (entry->Handle == nullptr && !CreateDLSSContext20(slot, dispatchDescription))
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
-    NVSDK_NGX_Parameter* params = _nvParams[context];
-    NVSDK_NGX_Handle* handle = _contexts[context];
+    NVSDK_NGX_Parameter* params = entry->Params;
+    NVSDK_NGX_Handle* handle = entry->Handle;
 
     params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, dispatchDescription->jitterOffset.x);
     params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, dispatchDescription->jitterOffset.y);
@@ -854,13 +888,18 @@ static Fsr212::FfxErrorCode ffxFsr2TinyContextDispatch_Dx12(Fsr212::FfxFsr2Conte
     if (dispatchDescription == nullptr || context == nullptr || dispatchDescription->commandList == nullptr)
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
-    // If not in contexts list create and add context
-    if (!_contexts.contains(context) && _initParams.contains(context) &&
-        !CreateDLSSContextTiny(context, dispatchDescription))
+    auto slot = _contexts.HandleOf(context);
+    auto entry = _contexts.Get(slot);
+
+    if (entry == nullptr)
+        return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
+
+    // If NGX feature is not created yet create it
+    if (entry->Handle == nullptr && !CreateDLSSContextTiny(slot, dispatchDescription))
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
-    NVSDK_NGX_Parameter* params = _nvParams[context];
-    NVSDK_NGX_Handle* handle = _contexts[context];
+    NVSDK_NGX_Parameter* params = entry->Params;
+    NVSDK_NGX_Handle* handle = entry->Handle;
 
     params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, dispatchDescription->jitterOffset.x);
     params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, dispatchDescription->jitterOffset.y);
@@ -909,12 +948,10 @@ static Fsr212::FfxErrorCode ffxFsr2ContextDestroy_Dx12(Fsr212::FfxFsr2Context* c
     if (context == nullptr)
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
-    if (_contexts.contains(context))
-        NVSDK_NGX_D3D12_ReleaseFeature(_contexts[context]);
+    if (auto entry = _contexts.Find(context); entry != nullptr && entry->Handle != nullptr)
+        NVSDK_NGX_D3D12_ReleaseFeature(entry->Handle);
 
-    _contexts.erase(context);
-    _nvParams.erase(context);
-    _initParams.erase(context);
+    _contexts.Erase(context);
 
     _skipDestroy = true;
     auto cdResult = o_ffxFsr2ContextDestroy_Dx12(context);
@@ -930,12 +967,10 @@ static Fsr212::FfxErrorCode ffxFsr2ContextDestroy_Pattern_Dx12(Fsr212::FfxFsr2Co
     if (context == nullptr)
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
-    if (_contexts.contains(context))
-        NVSDK_NGX_D3D12_ReleaseFeature(_contexts[context]);
+    if (auto entry = _contexts.Find(context); entry != nullptr && entry->Handle != nullptr)
+        NVSDK_NGX_D3D12_ReleaseFeature(entry->Handle);
 
-    _contexts.erase(context);
-    _nvParams.erase(context);
-    _initParams.erase(context);
+    _contexts.Erase(context);
 
     auto cdResult = o_ffxFsr2ContextDestroy_Pattern_Dx12(context);
     LOG_INFO("result: {:X}", (UINT) cdResult);
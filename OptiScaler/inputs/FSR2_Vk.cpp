@@ -5,6 +5,7 @@
 #include "Config.h"
 #include "resource.h"
 #include "NVNGX_Parameter.h"
+#include "ContextSlotMap.h"
 
 #include <proxies/KernelBase_Proxy.h>
 
@@ -45,9 +46,14 @@ static PFN_ffxFsr2GetJitterPhaseCount o_ffxFsr2GetJitterPhaseCount_Vk = nullptr;
 static PFN_ffxFsr2GetScratchMemorySizeVK o_ffxFsr2GetScratchMemorySize_Vk = nullptr;
 static PFN_ffxGetDeviceVK o_ffxGetDevice_Vk = nullptr;
 
-static std::unordered_map<FfxFsr2Context*, FfxFsr2ContextDescription> _initParams;
-static std::unordered_map<FfxFsr2Context*, NVSDK_NGX_Parameter*> _nvParams;
-static std::unordered_map<FfxFsr2Context*, NVSDK_NGX_Handle*> _contexts;
+struct Fsr2VkContext
+{
+    FfxFsr2ContextDescription InitParams {};
+    NVSDK_NGX_Parameter* Params = nullptr;
+    NVSDK_NGX_Handle* Handle = nullptr; // Created on first dispatch
+};
+
+static ContextSlotMap<FfxFsr2Context*, Fsr2VkContext> _contexts;
 static VkDevice _vkDevice = nullptr;
 static VkPhysicalDevice _vkPhysicalDevice = nullptr;
 static PFN_vkGetDeviceProcAddr _vkDeviceProcAddress = nullptr;
@@ -179,16 +185,18 @@ static bool CreateIVandNVRes(FfxResource resource, VkImageView* imageView, NVSDK
     return true;
 }
 
-static bool CreateDLSSContext(FfxFsr2Context* handle, const FfxFsr2DispatchDescription* pExecParams)
+static bool CreateDLSSContext(ContextSlotHandle slot, const FfxFsr2DispatchDescription* pExecParams)
 {
-    LOG_DEBUG("context: {:X}", (size_t) handle);
+    LOG_DEBUG("slot: {}", slot.Index);
+
+    auto entry = _contexts.Get(slot);
 
-    if (!_nvParams.contains(handle))
+    if (entry == nullptr)
         return false;
 
     NVSDK_NGX_Handle* nvHandle = nullptr;
-    auto params = _nvParams[handle];
-    auto initParams = &_initParams[handle];
+    auto params = entry->Params;
+    auto initParams = &entry->InitParams;
     auto commandList = (VkCommandBuffer) pExecParams->commandList;
 
     UINT initFlags = 0;
@@ -242,8 +250,8 @@ static bool CreateDLSSContext(FfxFsr2Context* handle, const FfxFsr2DispatchDescr
         return false;
     }
 
-    _contexts[handle] = nvHandle;
-    LOG_INFO("context created: {:X}", (size_t) handle);
+    entry->Handle = nvHandle;
+    LOG_INFO("context created, slot: {}", slot.Index);
 
     return true;
 }
@@ -357,13 +365,14 @@ static FfxErrorCode ffxFsr2ContextCreate_Vk(FfxFsr2Context* context, FfxFsr2Cont
     if (NVSDK_NGX_VULKAN_GetCapabilityParameters(&params) != NVSDK_NGX_Result_Success)
         return FFX_ERROR_BACKEND_API_ERROR;
 
-    _nvParams[context] = params;
+    auto& entry = _contexts.Emplace(context);
+    entry.Params = params;
 
     FfxFsr2ContextDescription ccd {};
     ccd.flags = contextDescription->flags;
     ccd.maxRenderSize = contextDescription->maxRenderSize;
     ccd.displaySize = contextDescription->displaySize;
-    _initParams[context] = ccd;
+    entry.InitParams = ccd;
 
     LOG_INFO("context created: {:X}", (size_t) context);
 
@@ -389,13 +398,18 @@ static FfxErrorCode ffxFsr2ContextDispatch_Vk(FfxFsr2Context* context,
     if (dispatchDescription == nullptr || context == nullptr || dispatchDescription->commandList == nullptr)
         return FFX_ERROR_INVALID_ARGUMENT;
 
-    // If not in contexts list create and add context
-    if (!_contexts.contains(context) && _initParams.contains(context) &&
-        !CreateDLSSContext(context, dispatchDescription))
+    auto slot = _contexts.HandleOf(context);
+    auto entry = _contexts.Get(slot);
+
+    if (entry == nullptr)
+        return FFX_ERROR_INVALID_ARGUMENT;
+
+    // If NGX feature is not created yet create it
+    if (entry->Handle == nullptr && !CreateDLSSContext(slot, dispatchDescription))
         return FFX_ERROR_INVALID_ARGUMENT;
 
-    NVSDK_NGX_Parameter* params = _nvParams[context];
-    NVSDK_NGX_Handle* handle = _contexts[context];
+    NVSDK_NGX_Parameter* params = entry->Params;
+    NVSDK_NGX_Handle* handle = entry->Handle;
 
     params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, dispatchDescription->jitterOffset.x);
     params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, dispatchDescription->jitterOffset.y);
@@ -534,12 +548,10 @@ static FfxErrorCode ffxFsr2ContextDestroy_Vk(FfxFsr2Context* context)
     if (context == nullptr)
         return FFX_ERROR_INVALID_ARGUMENT;
 
-    if (_contexts.contains(context))
-        NVSDK_NGX_VULKAN_ReleaseFeature(_contexts[context]);
+    if (auto entry = _contexts.Find(context); entry != nullptr && entry->Handle != nullptr)
+        NVSDK_NGX_VULKAN_ReleaseFeature(entry->Handle);
 
-    _contexts.erase(context);
-    _nvParams.erase(context);
-    _initParams.erase(context);
+    _contexts.Erase(context);
 
     _skipDestroy = true;
     auto cdResult = o_ffxFsr2ContextDestroy_Vk(context);
@@ -6,6 +6,7 @@
 
 #include "resource.h"
 #include "NVNGX_Parameter.h"
+#include "ContextSlotMap.h"
 
 #include <proxies/KernelBase_Proxy.h>
 
@@ -44,9 +45,14 @@ static PFN_ffxFsr3UpscalerGetRenderResolutionFromQualityMode o_ffxFsr3UpscalerGe
     nullptr;
 static PFN_ffxFSR3GetInterfaceDX12 o_ffxFSR3GetInterfaceDX12 = nullptr;
 
-static std::unordered_map<Fsr3::FfxFsr3UpscalerContext*, Fsr3::FfxFsr3UpscalerContextDescription> _initParams;
-static std::unordered_map<Fsr3::FfxFsr3UpscalerContext*, NVSDK_NGX_Parameter*> _nvParams;
-static std::unordered_map<Fsr3::FfxFsr3UpscalerContext*, NVSDK_NGX_Handle*> _contexts;
+struct Fsr3Dx12Context
+{
+    Fsr3::FfxFsr3UpscalerContextDescription InitParams {};
+    NVSDK_NGX_Parameter* Params = nullptr;
+    NVSDK_NGX_Handle* Handle = nullptr; // Created on first dispatch
+};
+
+static ContextSlotMap<Fsr3::FfxFsr3UpscalerContext*, Fsr3Dx12Context> _contexts;
 static ID3D12Device* _d3d12Device = nullptr;
 static bool _nvnxgInited = false;
 static bool _skipCreate = false;
@@ -83,17 +89,18 @@ static D3D12_RESOURCE_STATES GetD3D12State(Fsr3::FfxResourceStates state)
     }
 }
 
-static bool CreateDLSSContext(Fsr3::FfxFsr3UpscalerContext* handle,
-                              const Fsr3::FfxFsr3UpscalerDispatchDescription* pExecParams)
+static bool CreateDLSSContext(ContextSlotHandle slot, const Fsr3::FfxFsr3UpscalerDispatchDescription* pExecParams)
 {
     LOG_DEBUG("");
 
-    if (!_nvParams.contains(handle))
+    auto entry = _contexts.Get(slot);
+
+    if (entry == nullptr)
         return false;
 
     NVSDK_NGX_Handle* nvHandle = nullptr;
-    auto params = _nvParams[handle];
-    auto initParams = &_initParams[handle];
+    auto params = entry->Params;
+    auto initParams = &entry->InitParams;
     auto commandList = (ID3D12GraphicsCommandList*) pExecParams->commandList;
 
     UINT initFlags = 0;
@@ -139,7 +146,7 @@ static bool CreateDLSSContext(Fsr3::FfxFsr3UpscalerContext* handle,
         NVSDK_NGX_Result_Success)
         return false;
 
-    _contexts[handle] = nvHandle;
+    entry->Handle = nvHandle;
 
     return true;
 }
@@ -281,14 +288,15 @@ static Fsr3::FfxErrorCode ffxFsr3ContextCreate_Dx12(Fsr3::FfxFsr3UpscalerContext
     if (NVSDK_NGX_D3D12_GetCapabilityParameters(&params) != NVSDK_NGX_Result_Success)
         return Fsr3::FFX_ERROR_BACKEND_API_ERROR;
 
-    _nvParams[pContext] = params;
+    auto& entry = _contexts.Emplace(pContext);
+    entry.Params = params;
 
     Fsr3::FfxFsr3UpscalerContextDescription ccd {};
     ccd.flags = pContextDescription->flags;
     ccd.maxRenderSize = pContextDescription->maxRenderSize;
     ccd.displaySize = pContextDescription->displaySize;
     ccd.backendInterface.device = pContextDescription->backendInterface.device;
-    _initParams[pContext] = ccd;
+    entry.InitParams = ccd;
 
     LOG_INFO("context created: {:X}", (size_t) pContext);
 
@@ -318,13 +326,18 @@ static Fsr3::FfxErrorCode ffxFsr3ContextDispatch_Dx12(Fsr3::FfxFsr3UpscalerConte
     if (pDispatchDescription == nullptr || pContext == nullptr || pDispatchDescription->commandList == nullptr)
         return Fsr3::FFX_ERROR_BACKEND_API_ERROR;
 
-    // If not in contexts list create and add context
-    if (!_contexts.contains(pContext) && _initParams.contains(pContext) &&
-        !CreateDLSSContext(pContext, pDispatchDescription))
+    auto slot = _contexts.HandleOf(pContext);
+    auto entry = _contexts.Get(slot);
+
+    if (entry == nullptr)
         return Fsr3::FFX_ERROR_INVALID_ARGUMENT;
 
-    NVSDK_NGX_Parameter* params = _nvParams[pContext];
-    NVSDK_NGX_Handle* handle = _contexts[pContext];
+    // If NGX feature is not created yet create it
+    if (entry->Handle == nullptr && !CreateDLSSContext(slot, pDispatchDescription))
+        return Fsr3::FFX_ERROR_INVALID_ARGUMENT;
+
+    NVSDK_NGX_Parameter* params = entry->Params;
+    NVSDK_NGX_Handle* handle = entry->Handle;
 
     params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, pDispatchDescription->jitterOffset.x);
     params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, pDispatchDescription->jitterOffset.y);
@@ -394,12 +407,10 @@ static Fsr3::FfxErrorCode ffxFsr3ContextDestroy_Dx12(Fsr3::FfxFsr3UpscalerContex
 
     LOG_DEBUG("context: {:X}", (size_t) pContext);
 
-    if (_contexts.contains(pContext))
-        NVSDK_NGX_D3D12_ReleaseFeature(_contexts[pContext]);
+    if (auto entry = _contexts.Find(pContext); entry != nullptr && entry->Handle != nullptr)
+        NVSDK_NGX_D3D12_ReleaseFeature(entry->Handle);
 
-    _contexts.erase(pContext);
-    _nvParams.erase(pContext);
-    _initParams.erase(pContext);
+    _contexts.Erase(pContext);
 
     _skipDestroy = true;
     auto cdResult = o_ffxFsr3UpscalerContextDestroy_Dx12(pContext);
@@ -515,14 +526,15 @@ ffxFsr3ContextCreate_Pattern_Dx12(Fsr3::FfxFsr3UpscalerContext* pContext,
     if (NVSDK_NGX_D3D12_GetCapabilityParameters(&params) != NVSDK_NGX_Result_Success)
         return Fsr3::FFX_ERROR_BACKEND_API_ERROR;
 
-    _nvParams[pContext] = params;
+    auto& entry = _contexts.Emplace(pContext);
+    entry.Params = params;
 
     Fsr3::FfxFsr3UpscalerContextDescription ccd {};
     ccd.flags = pContextDescription->flags;
     ccd.maxRenderSize = pContextDescription->maxRenderSize;
     ccd.displaySize = pContextDescription->displaySize;
     ccd.backendInterface.device = pContextDescription->backendInterface.device;
-    _initParams[pContext] = ccd;
+    entry.InitParams = ccd;
 
     LOG_INFO("context created: {:X}", (size_t) pContext);
 
@@ -543,13 +555,18 @@ ffxFsr3ContextDispatch_Pattern_Dx12(Fsr3::FfxFsr3UpscalerContext* pContext,
     if (pDispatchDescription == nullptr || pContext == nullptr || pDispatchDescription->commandList == nullptr)
         return Fsr3::FFX_ERROR_BACKEND_API_ERROR;
 
-    // If not in contexts list create and add context
-    if (!_contexts.contains(pContext) && _initParams.contains(pContext) &&
-        !CreateDLSSContext(pContext, pDispatchDescription))
+    auto slot = _contexts.HandleOf(pContext);
+    auto entry = _contexts.Get(slot);
+
+    if (entry == nullptr)
+        return Fsr3::FFX_ERROR_INVALID_ARGUMENT;
+
+    // If NGX feature is not created yet create it
+    if (entry->Handle == nullptr && !CreateDLSSContext(slot, pDispatchDescription))
         return Fsr3::FFX_ERROR_INVALID_ARGUMENT;
 
-    NVSDK_NGX_Parameter* params = _nvParams[pContext];
-    NVSDK_NGX_Handle* handle = _contexts[pContext];
+    NVSDK_NGX_Parameter* params = entry->Params;
+    NVSDK_NGX_Handle* handle = entry->Handle;
 
     params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, pDispatchDescription->jitterOffset.x);
     params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, pDispatchDescription->jitterOffset.y);
@@ -619,12 +636,10 @@ static Fsr3::FfxErrorCode ffxFsr3ContextDestroy_Pattern_Dx12(Fsr3::FfxFsr3Upscal
 
     LOG_DEBUG("context: {:X}", (size_t) pContext);
 
-    if (_contexts.contains(pContext))
-        NVSDK_NGX_D3D12_ReleaseFeature(_contexts[pContext]);
+    if (auto entry = _contexts.Find(pContext); entry != nullptr && entry->Handle != nullptr)
+        NVSDK_NGX_D3D12_ReleaseFeature(entry->Handle);
 
-    _contexts.erase(pContext);
-    _nvParams.erase(pContext);
-    _initParams.erase(pContext);
+    _contexts.Erase(pContext);
 
     auto cdResult = o_ffxFsr3UpscalerContextDestroy_Dx12(pContext);
     LOG_INFO("result: {:X}", (UINT) cdResult);
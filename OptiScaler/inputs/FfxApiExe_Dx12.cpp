@@ -5,6 +5,7 @@
 
 #include "resource.h"
 #include "NVNGX_Parameter.h"
+#include "ContextSlotMap.h"
 
 #include <proxies/KernelBase_Proxy.h>
 
@@ -21,23 +22,30 @@ inline static PfnFfxConfigure _D3D12_Configure = nullptr;
 inline static PfnFfxQuery _D3D12_Query = nullptr;
 inline static PfnFfxDispatch _D3D12_Dispatch = nullptr;
 
-static std::unordered_map<ffxContext, ffxCreateContextDescUpscale> _initParams;
-static std::unordered_map<ffxContext, NVSDK_NGX_Parameter*> _nvParams;
-static std::unordered_map<ffxContext, NVSDK_NGX_Handle*> _contexts;
+struct FfxApiExeContext
+{
+    ffxCreateContextDescUpscale InitParams {};
+    NVSDK_NGX_Parameter* Params = nullptr;
+    NVSDK_NGX_Handle* Handle = nullptr; // Created on first dispatch
+};
+
+static ContextSlotMap<ffxContext, FfxApiExeContext> _contexts;
 static ID3D12Device* _d3d12Device = nullptr;
 static bool _nvnxgInited = false;
 static float qualityRatios[] = { 1.0f, 1.5f, 1.7f, 2.0f, 3.0f };
 
-static bool CreateDLSSContext(ffxContext handle, const ffxDispatchDescUpscale* pExecParams)
+static bool CreateDLSSContext(ContextSlotHandle slot, const ffxDispatchDescUpscale* pExecParams)
 {
-    LOG_DEBUG("context: {:X}", (size_t) handle);
+    LOG_DEBUG("slot: {}", slot.Index);
 
-    if (!_nvParams.contains(handle))
+    auto entry = _contexts.Get(slot);
+
+    if (entry == nullptr)
         return false;
 
     NVSDK_NGX_Handle* nvHandle = nullptr;
-    auto params = _nvParams[handle];
-    auto initParams = &_initParams[handle];
+    auto params = entry->Params;
+    auto initParams = &entry->InitParams;
     auto commandList = (ID3D12GraphicsCommandList*) pExecParams->commandList;
 
     UINT initFlags = 0;
@@ -92,8 +100,8 @@ static bool CreateDLSSContext(ffxContext handle, const ffxDispatchDescUpscale* p
         return false;
     }
 
-    _contexts[handle] = nvHandle;
-    LOG_INFO("context created: {:X}", (size_t) handle);
+    entry->Handle = nvHandle;
+    LOG_INFO("context created, slot: {}", slot.Index);
 
     return true;
 }
@@ -220,13 +228,14 @@ static ffxReturnCode_t ffxCreateContext_Dx12(ffxContext* context, ffxCreateConte
     if (NVSDK_NGX_D3D12_GetCapabilityParameters(&params) != NVSDK_NGX_Result_Success)
         return FFX_API_RETURN_ERROR_RUNTIME_ERROR;
 
-    _nvParams[*context] = params;
+    auto& entry = _contexts.Emplace(*context);
+    entry.Params = params;
 
     ffxCreateContextDescUpscale ccd {};
     ccd.flags = createDesc->flags;
     ccd.maxRenderSize = createDesc->maxRenderSize;
     ccd.maxUpscaleSize = createDesc->maxUpscaleSize;
-    _initParams[*context] = ccd;
+    entry.InitParams = ccd;
 
     LOG_INFO("context created: {:X}", (size_t) *context);
 
@@ -243,12 +252,10 @@ static ffxReturnCode_t ffxDestroyContext_Dx12(ffxContext* context, const ffxAllo
     auto cdResult = _D3D12_DestroyContext(context, memCb);
     LOG_INFO("result: {:X}", (UINT) cdResult);
 
-    if (_contexts.contains(*context))
-        NVSDK_NGX_D3D12_ReleaseFeature(_contexts[*context]);
+    if (auto entry = _contexts.Find(*context); entry != nullptr && entry->Handle != nullptr)
+        NVSDK_NGX_D3D12_ReleaseFeature(entry->Handle);
 
-    _contexts.erase(*context);
-    _nvParams.erase(*context);
-    _initParams.erase(*context);
+    _contexts.Erase(*context);
 
     return FFX_API_RETURN_OK;
 }
@@ -317,7 +324,10 @@ static ffxReturnCode_t ffxDispatch_Dx12(ffxContext* context, ffxDispatchDescHead
 
     LOG_DEBUG("context: {:X}, type: {:X}", (size_t) *context, desc->type);
 
-    if (context == nullptr || !_initParams.contains(*context))
+    auto slot = context != nullptr ? _contexts.HandleOf(*context) : ContextSlotHandle {};
+    auto entry = _contexts.Get(slot);
+
+    if (entry == nullptr)
     {
         LOG_INFO("Not in _contexts, desc type: {:X}", desc->type);
         return _D3D12_Dispatch(context, desc);
@@ -347,11 +357,11 @@ static ffxReturnCode_t ffxDispatch_Dx12(ffxContext* context, ffxDispatchDescHead
 
     // If not in contexts list create and add context
     auto contextId = (size_t) *context;
-    if (!_contexts.contains(*context) && _initParams.contains(*context) && !CreateDLSSContext(*context, dispatchDesc))
+    if (entry->Handle == nullptr && !CreateDLSSContext(slot, dispatchDesc))
         return FFX_API_RETURN_ERROR_RUNTIME_ERROR;
 
-    NVSDK_NGX_Parameter* params = _nvParams[*context];
-    NVSDK_NGX_Handle* handle = _contexts[*context];
+    NVSDK_NGX_Parameter* params = entry->Params;
+    NVSDK_NGX_Handle* handle = entry->Handle;
 
     params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, dispatchDesc->jitterOffset.x);
     params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, dispatchDesc->jitterOffset.y);
@@ -6,6 +6,7 @@
 
 #include "resource.h"
 #include "NVNGX_Parameter.h"
+#include "ContextSlotMap.h"
 #include "proxies/FfxApi_Proxy.h"
 
 #include "FG/FfxApi_Dx12_FG.h"
@@ -15,9 +16,14 @@
 
 #include <magic_enum.hpp>
 
-static std::unordered_map<ffxContext, ffxCreateContextDescUpscale> _initParams;
-static std::unordered_map<ffxContext, NVSDK_NGX_Parameter*> _nvParams;
-static std::unordered_map<ffxContext, NVSDK_NGX_Handle*> _contexts;
+struct FfxApiDx12Context
+{
+    ffxCreateContextDescUpscale InitParams {};
+    NVSDK_NGX_Parameter* Params = nullptr;
+    NVSDK_NGX_Handle* Handle = nullptr; // Created on first dispatch
+};
+
+static ContextSlotMap<ffxContext, FfxApiDx12Context> _contexts;
 static ID3D12Device* _d3d12Device = nullptr;
 static bool _nvnxgInited = false;
 static float qualityRatios[] = { 1.0f, 1.5f, 1.7f, 2.0f, 3.0f };
@@ -58,16 +64,18 @@ static bool ffxGetJitterOffsetLocal(float* outX, float* outY, int32_t index, int
     return true;
 }
 
-static bool CreateDLSSContext(ffxContext handle, const ffxDispatchDescUpscale* pExecParams)
+static bool CreateDLSSContext(ContextSlotHandle slot, const ffxDispatchDescUpscale* pExecParams)
 {
-    LOG_DEBUG("context: {:X}", (size_t) handle);
+    LOG_DEBUG("slot: {}", slot.Index);
 
-    if (!_nvParams.contains(handle))
+    auto entry = _contexts.Get(slot);
+
+    if (entry == nullptr)
         return false;
 
     NVSDK_NGX_Handle* nvHandle = nullptr;
-    auto params = _nvParams[handle];
-    auto initParams = &_initParams[handle];
+    auto params = entry->Params;
+    auto initParams = &entry->InitParams;
     auto commandList = (ID3D12GraphicsCommandList*) pExecParams->commandList;
 
     UINT initFlags = 0;
@@ -122,8 +130,8 @@ static bool CreateDLSSContext(ffxContext handle, const ffxDispatchDescUpscale* p
         return false;
     }
 
-    _contexts[handle] = nvHandle;
-    LOG_INFO("context created: {:X}", (size_t) handle);
+    entry->Handle = nvHandle;
+    LOG_INFO("context created, slot: {}", slot.Index);
 
     return true;
 }
@@ -281,13 +289,14 @@ ffxReturnCode_t ffxCreateContext_Dx12(ffxContext* context, ffxCreateContextDescH
     if (NVSDK_NGX_D3D12_GetCapabilityParameters(&params) != NVSDK_NGX_Result_Success)
         return FFX_API_RETURN_ERROR_RUNTIME_ERROR;
 
-    _nvParams[*context] = params;
+    auto& entry = _contexts.Emplace(*context);
+    entry.Params = params;
 
     ffxCreateContextDescUpscale ccd {};
     ccd.flags = createDesc->flags;
     ccd.maxRenderSize = createDesc->maxRenderSize;
     ccd.maxUpscaleSize = createDesc->maxUpscaleSize;
-    _initParams[*context] = ccd;
+    entry.InitParams = ccd;
 
     LOG_INFO("context created: {:X}", (size_t) *context);
 
@@ -313,15 +322,13 @@ ffxReturnCode_t ffxDestroyContext_Dx12(ffxContext* context, const ffxAllocationC
         return result;
     }
 
-    bool upscalerContext =
-        _contexts.contains(*context) || _initParams.contains(*context) || _nvParams.contains(*context);
+    auto entry = _contexts.Find(*context);
+    bool upscalerContext = entry != nullptr;
 
-    if (_contexts.contains(*context))
-        NVSDK_NGX_D3D12_ReleaseFeature(_contexts[*context]);
+    if (entry != nullptr && entry->Handle != nullptr)
+        NVSDK_NGX_D3D12_ReleaseFeature(entry->Handle);
 
-    _contexts.erase(*context);
-    _nvParams.erase(*context);
-    _initParams.erase(*context);
+    _contexts.Erase(*context);
 
     if (upscalerContext && !Config::Instance()->EnableHotSwapping.value_or_default())
         return FFX_API_RETURN_OK;
@@ -532,7 +539,7 @@ ffxReturnCode_t ffxQuery_Dx12(ffxContext* context, ffxQueryDescHeader* desc)
         return FFX_API_RETURN_OK;
     }
 
-    if (context != nullptr && _contexts.contains(*context) && !Config::Instance()->EnableHotSwapping.value_or_default())
+    if (context != nullptr && _contexts.Contains(*context) && !Config::Instance()->EnableHotSwapping.value_or_default())
     {
         LOG_INFO("Hot swapping disabled, ignoring upscaler query");
         return FFX_API_RETURN_OK;
@@ -574,7 +581,10 @@ ffxReturnCode_t ffxDispatch_Dx12(ffxContext* context, ffxDispatchDescHeader* des
         !Config::Instance()->UseFfxInputs.value_or_default())
         return FfxApiProxy::D3D12_Dispatch(context, desc);
 
-    if (context == nullptr || !_initParams.contains(*context))
+    auto slot = context != nullptr ? _contexts.HandleOf(*context) : ContextSlotHandle {};
+    auto entry = _contexts.Get(slot);
+
+    if (entry == nullptr)
     {
         LOG_INFO("Not in _contexts");
         return FfxApiProxy::D3D12_Dispatch(context, desc);
@@ -606,11 +616,11 @@ ffxReturnCode_t ffxDispatch_Dx12(ffxContext* context, ffxDispatchDescHeader* des
 
     // If not in contexts list create and add context
     auto contextId = (size_t) *context;
-    if (!_contexts.contains(*context) && _initParams.contains(*context) && !CreateDLSSContext(*context, dispatchDesc))
+    if (entry->Handle == nullptr && !CreateDLSSContext(slot, dispatchDesc))
         return FFX_API_RETURN_ERROR_RUNTIME_ERROR;
 
-    NVSDK_NGX_Parameter* params = _nvParams[*context];
-    NVSDK_NGX_Handle* handle = _contexts[*context];
+    NVSDK_NGX_Parameter* params = entry->Params;
+    NVSDK_NGX_Handle* handle = entry->Handle;
 
     params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, dispatchDesc->jitterOffset.x);
     params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, dispatchDesc->jitterOffset.y);
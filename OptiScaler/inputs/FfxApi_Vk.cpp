@@ -5,6 +5,7 @@
 #include <Config.h>
 #include <resource.h>
 #include <NVNGX_Parameter.h>
+#include <inputs/ContextSlotMap.h>
 
 #include <proxies/FfxApi_Proxy.h>
 
@@ -14,9 +15,14 @@
 #include <nvsdk_ngx_vk.h>
 #include <nvsdk_ngx_helpers_vk.h>
 
-static std::unordered_map<ffxContext, ffxCreateContextDescUpscale> _initParams;
-static std::unordered_map<ffxContext, NVSDK_NGX_Parameter*> _nvParams;
-static std::unordered_map<ffxContext, NVSDK_NGX_Handle*> _contexts;
+struct FfxApiVkContext
+{
+    ffxCreateContextDescUpscale InitParams {};
+    NVSDK_NGX_Parameter* Params = nullptr;
+    NVSDK_NGX_Handle* Handle = nullptr; // Created on first dispatch
+};
+
+static ContextSlotMap<ffxContext, FfxApiVkContext> _contexts;
 static VkDevice _vkDevice = nullptr;
 static VkPhysicalDevice _vkPhysicalDevice = nullptr;
 static PFN_vkGetDeviceProcAddr _vkDeviceProcAddress = nullptr;
@@ -221,16 +227,18 @@ static bool CreateIVandNVRes(FfxApiResource resource, VkImageView* imageView, NV
     return true;
 }
 
-static bool CreateDLSSContext(ffxContext handle, const ffxDispatchDescUpscale* pExecParams)
+static bool CreateDLSSContext(ContextSlotHandle slot, const ffxDispatchDescUpscale* pExecParams)
 {
-    LOG_DEBUG("context: {:X}", (size_t) handle);
+    LOG_DEBUG("slot: {}", slot.Index);
 
-    if (!_nvParams.contains(handle))
+    auto entry = _contexts.Get(slot);
+
+    if (entry == nullptr)
         return false;
 
     NVSDK_NGX_Handle* nvHandle = nullptr;
-    auto params = _nvParams[handle];
-    auto initParams = &_initParams[handle];
+    auto params = entry->Params;
+    auto initParams = &entry->InitParams;
     auto commandList = (VkCommandBuffer) pExecParams->commandList;
 
     UINT initFlags = 0;
@@ -285,8 +293,8 @@ static bool CreateDLSSContext(ffxContext handle, const ffxDispatchDescUpscale* p
         return false;
     }
 
-    _contexts[handle] = nvHandle;
-    LOG_INFO("context created: {:X}", (size_t) handle);
+    entry->Handle = nvHandle;
+    LOG_INFO("context created, slot: {}", slot.Index);
 
     return true;
 }
@@ -422,13 +430,14 @@ ffxReturnCode_t ffxCreateContext_Vk(ffxContext* context, ffxCreateContextDescHea
     if (NVSDK_NGX_VULKAN_GetCapabilityParameters(&params) != NVSDK_NGX_Result_Success)
         return FFX_API_RETURN_ERROR_RUNTIME_ERROR;
 
-    _nvParams[*context] = params;
+    auto& entry = _contexts.Emplace(*context);
+    entry.Params = params;
 
     ffxCreateContextDescUpscale ccd {};
     ccd.flags = createDesc->flags;
     ccd.maxRenderSize = createDesc->maxRenderSize;
     ccd.maxUpscaleSize = createDesc->maxUpscaleSize;
-    _initParams[*context] = ccd;
+    entry.InitParams = ccd;
 
     LOG_INFO("context created: {:X}", (size_t) *context);
 
@@ -444,15 +453,13 @@ ffxReturnCode_t ffxDestroyContext_Vk(ffxContext* context, const ffxAllocationCal
 
     LOG_DEBUG("context: {:X}", (size_t) *context);
 
-    bool upscalerContext =
-        _contexts.contains(*context) || _initParams.contains(*context) || _nvParams.contains(*context);
+    auto entry = _contexts.Find(*context);
+    bool upscalerContext = entry != nullptr;
 
-    if (_contexts.contains(*context))
-        NVSDK_NGX_VULKAN_ReleaseFeature(_contexts[*context]);
+    if (entry != nullptr && entry->Handle != nullptr)
+        NVSDK_NGX_VULKAN_ReleaseFeature(entry->Handle);
 
-    _contexts.erase(*context);
-    _nvParams.erase(*context);
-    _initParams.erase(*context);
+    _contexts.Erase(*context);
 
     if (upscalerContext && !Config::Instance()->EnableHotSwapping.value_or_default())
         return FFX_API_RETURN_OK;
@@ -619,7 +626,7 @@ ffxReturnCode_t ffxQuery_Vk(ffxContext* context, ffxQueryDescHeader* desc)
         return FFX_API_RETURN_OK;
     }
 
-    if (context != nullptr && _contexts.contains(*context) && !Config::Instance()->EnableHotSwapping.value_or_default())
+    if (context != nullptr && _contexts.Contains(*context) && !Config::Instance()->EnableHotSwapping.value_or_default())
     {
         LOG_INFO("Hot swapping disabled, ignoring upscaler query");
         return FFX_API_RETURN_OK;
@@ -654,7 +661,10 @@ ffxReturnCode_t ffxDispatch_Vk(ffxContext* context, ffxDispatchDescHeader* desc)
         !Config::Instance()->UseFfxInputs.value_or_default())
         return FfxApiProxy::VULKAN_Dispatch()(context, desc);
 
-    if (context == nullptr || !_initParams.contains(*context))
+    auto slot = context != nullptr ? _contexts.HandleOf(*context) : ContextSlotHandle {};
+    auto entry = _contexts.Get(slot);
+
+    if (entry == nullptr)
     {
         LOG_INFO("Not in _contexts");
         return FfxApiProxy::VULKAN_Dispatch()(context, desc);
@@ -690,15 +700,14 @@ ffxReturnCode_t ffxDispatch_Vk(ffxContext* context, ffxDispatchDescHeader* desc)
 
     // If not in contexts list create and add context
     auto contextId = (size_t) *context;
-    if (!_contexts.contains(*context) && _initParams.contains(*context) && !CreateDLSSContext(*context, dispatchDesc))
+    if (entry->Handle == nullptr && !CreateDLSSContext(slot, dispatchDesc))
     {
-        LOG_DEBUG("!_contexts.contains(*context) && _initParams.contains(*context) && !CreateDLSSContext(*context, "
-                  "dispatchDesc)");
+        LOG_DEBUG("CreateDLSSContext failed");
         return FFX_API_RETURN_ERROR_RUNTIME_ERROR;
     }
 
-    NVSDK_NGX_Parameter* params = _nvParams[*context];
-    NVSDK_NGX_Handle* handle = _contexts[*context];
+    NVSDK_NGX_Parameter* params = entry->Params;
+    NVSDK_NGX_Handle* handle = entry->Handle;
 
     params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, dispatchDesc->jitterOffset.x);
     params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, dispatchDesc->jitterOffset.y);
@@ -5,4 +5,5 @@ template <typename FeatureType> struct ContextData
     std::unique_ptr<FeatureType> feature;
     NVSDK_NGX_Parameter* createParams = nullptr;
     int changeBackendCounter = 0;
+    double createTime = 0.0; // Used for logging time to first upscaled frame
 };
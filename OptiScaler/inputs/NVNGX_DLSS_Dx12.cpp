@@ -23,6 +23,7 @@
 #include "detours/detours.h"
 #include <ankerl/unordered_dense.h>
 #include <misc/IdentifyGpu.h>
+#include <misc/ApiCapture.h>
 
 static ankerl::unordered_dense::map<unsigned int, ContextData<IFeature_Dx12>> Dx12Contexts;
 static std::unordered_map<unsigned int, NVSDK_NGX_Feature> HandleToFeature;
@@ -665,6 +666,7 @@ static NVSDK_NGX_Result TryCreateOptiFeature(ID3D12GraphicsCommandList* InCmdLis
 
     // Create context entry
     Dx12Contexts[handleId] = {};
+    Dx12Contexts[handleId].createTime = Util::MillisecondsNow();
 
     // Retrieve feature implementation
     if (!FeatureProvider_Dx12::GetFeature(upscalerBackend, handleId, InParameters, &Dx12Contexts[handleId].feature))
@@ -804,10 +806,16 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_CreateFeature(ID3D12GraphicsComma
     }
 
     // OptiScaler internal handling (SuperSampling or RayReconstruction)
+    ApiCapture::CallRecord capture(ApiCaptureEvent::CreateFeature, 0, InParameters, (uint32_t) InFeatureID);
     auto tryResult = TryCreateOptiFeature(InCmdList, InFeatureID, InParameters, OutHandle);
 
     if (tryResult == NVSDK_NGX_Result_Success)
+    {
         HandleToFeature[(*OutHandle)->Id] = InFeatureID;
+        capture.SetHandleId((*OutHandle)->Id);
+    }
+
+    capture.End(tryResult);
 
     return tryResult;
 }
@@ -866,6 +874,8 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_ReleaseFeature(NVSDK_NGX_Handle*
         return Nvngx_FG::D3D12_ReleaseFeature(InHandle);
     }
 
+    ApiCapture::CallRecord capture(ApiCaptureEvent::Release, handleId, nullptr);
+
     // Remove feature from context map
     if (auto it = Dx12Contexts.find(handleId); it != Dx12Contexts.end())
     {
@@ -888,6 +898,8 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_ReleaseFeature(NVSDK_NGX_Handle*
             LOG_ERROR("can't release feature with id {0}!", handleId);
     }
 
+    capture.End(NVSDK_NGX_Result_Success);
+
     return NVSDK_NGX_Result_Success;
 }
 
@@ -1067,11 +1079,15 @@ static NVSDK_NGX_Result TryEvaluateOptiFeature(ID3D12GraphicsCommandList* InCmdL
     // Cleanup on success
     if (evalSuccess)
     {
-        // Upscaler time calc
-        // Record the second timestamp
-        UpscalerTimeDx12::UpscaleEnd(InCmdList);
-
+        // Second timestamp is recorded by the feature, before its post upscale passes
         UpscalerInputsDx12::UpscaleEnd(InCmdList, InParameters, feature);
+
+        if (ctxData.createTime > 0.0)
+        {
+            LOG_INFO("Time to first upscaled frame: {:.2f} ms ({})", Util::MillisecondsNow() - ctxData.createTime,
+                     feature->Name());
+            ctxData.createTime = 0.0;
+        }
     }
     else
     {
@@ -1172,7 +1188,11 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
     }
 
     // OptiScaler internal handling
-    return TryEvaluateOptiFeature(InCmdList, InFeatureHandle, InParameters, InCallback);
+    ApiCapture::CallRecord capture(ApiCaptureEvent::Evaluate, handleId, InParameters);
+    auto result = TryEvaluateOptiFeature(InCmdList, InFeatureHandle, InParameters, InCallback);
+    capture.End(result);
+
+    return result;
 }
 
 #pragma endregion
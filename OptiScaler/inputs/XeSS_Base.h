@@ -1,6 +1,9 @@
 #pragma once
 #include "SysUtils.h"
+#include "ContextSlotMap.h"
+
 #include <map>
+#include <optional>
 
 #include <xess_d3d12.h>
 #include <xess_d3d11.h>
@@ -12,10 +15,22 @@ typedef struct Scale
     float y;
 } scale;
 
-extern std::unordered_map<xess_context_handle_t, NVSDK_NGX_Parameter*> _nvParams;
-extern std::unordered_map<xess_context_handle_t, NVSDK_NGX_Handle*> _contexts;
-extern std::unordered_map<xess_context_handle_t, Scale> _motionScales;
-extern std::unordered_map<xess_context_handle_t, Scale> _jitterScales;
-extern std::unordered_map<xess_context_handle_t, xess_d3d12_init_params_t> _d3d12InitParams;
-extern std::unordered_map<xess_context_handle_t, xess_vk_init_params_t> _vkInitParams;
-extern std::unordered_map<xess_context_handle_t, xess_d3d11_init_params_t> _d3d11InitParams;
+// Shared by all XeSS backends, init params tell which API created the context
+struct XeSSContext
+{
+    NVSDK_NGX_Parameter* Params = nullptr;
+    NVSDK_NGX_Handle* Handle = nullptr; // Created on first execute
+    Scale MotionScale { 1.0f, 1.0f };
+    std::optional<Scale> JitterScale;
+    std::optional<xess_d3d12_init_params_t> D3D12InitParams;
+    std::optional<xess_vk_init_params_t> VkInitParams;
+    std::optional<xess_d3d11_init_params_t> D3D11InitParams;
+};
+
+extern ContextSlotMap<xess_context_handle_t, XeSSContext> _contexts;
+
+// XeSS context handles given to the game are packed slot handles, resolving them skips the hash lookup
+inline XeSSContext* GetXeSSContext(xess_context_handle_t hContext)
+{
+    return _contexts.Get(ContextSlotHandle::Unpack((uint64_t) hContext));
+}
@@ -123,29 +123,22 @@ xess_result_t hk_xessDestroyContext(xess_context_handle_t hContext)
 {
     LOG_DEBUG("hContext: {}", (size_t) hContext);
 
-    if (!_contexts.contains(hContext))
-        return XESS_RESULT_ERROR_INVALID_CONTEXT;
+    auto entry = GetXeSSContext(hContext);
 
-    if (_d3d12InitParams.contains(hContext))
-    {
-        NVSDK_NGX_D3D12_ReleaseFeature(_contexts[hContext]);
-        _d3d12InitParams.erase(hContext);
-    }
-
-    if (_d3d11InitParams.contains(hContext))
-    {
-        NVSDK_NGX_D3D11_ReleaseFeature(_contexts[hContext]);
-        _d3d11InitParams.erase(hContext);
-    }
+    if (entry == nullptr)
+        return XESS_RESULT_ERROR_INVALID_CONTEXT;
 
-    if (_vkInitParams.contains(hContext))
+    if (entry->Handle != nullptr)
     {
-        NVSDK_NGX_VULKAN_ReleaseFeature(_contexts[hContext]);
-        _vkInitParams.erase(hContext);
+        if (entry->D3D12InitParams.has_value())
+            NVSDK_NGX_D3D12_ReleaseFeature(entry->Handle);
+        else if (entry->D3D11InitParams.has_value())
+            NVSDK_NGX_D3D11_ReleaseFeature(entry->Handle);
+        else if (entry->VkInitParams.has_value())
+            NVSDK_NGX_VULKAN_ReleaseFeature(entry->Handle);
     }
 
-    _contexts.erase(hContext);
-    _nvParams.erase(hContext);
+    _contexts.Erase(hContext);
 
     return XESS_RESULT_SUCCESS;
 }
@@ -154,7 +147,12 @@ xess_result_t hk_xessSetVelocityScale(xess_context_handle_t hContext, float x, f
 {
     LOG_DEBUG("hContext: {}, x: {}, y: {}", (size_t) hContext, x, y);
 
-    _motionScales[hContext] = { x, y };
+    auto entry = GetXeSSContext(hContext);
+
+    if (entry == nullptr)
+        return XESS_RESULT_ERROR_INVALID_CONTEXT;
+
+    entry->MotionScale = { x, y };
 
     return XESS_RESULT_SUCCESS;
 }
@@ -170,10 +168,12 @@ xess_result_t hk_xessGetExposureMultiplier(xess_context_handle_t hContext, float
 {
     LOG_DEBUG("");
 
-    if (!_nvParams.contains(hContext))
+    auto entry = GetXeSSContext(hContext);
+
+    if (entry == nullptr)
         return XESS_RESULT_ERROR_INVALID_CONTEXT;
 
-    if (_nvParams[hContext]->Get(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, pScale) == NVSDK_NGX_Result_Success)
+    if (entry->Params->Get(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, pScale) == NVSDK_NGX_Result_Success)
         return XESS_RESULT_SUCCESS;
 
     return XESS_RESULT_ERROR_UNKNOWN;
@@ -277,10 +277,12 @@ xess_result_t hk_xessGetJitterScale(xess_context_handle_t hContext, float* pX, f
 {
     LOG_DEBUG("");
 
-    if (!_jitterScales.contains(hContext))
+    auto entry = GetXeSSContext(hContext);
+
+    if (entry == nullptr || !entry->JitterScale.has_value())
         return XESS_RESULT_ERROR_INVALID_CONTEXT;
 
-    auto scales = &_jitterScales[hContext];
+    auto scales = &entry->JitterScale.value();
 
     *pX = scales->x;
     *pY = scales->y;
@@ -381,10 +383,12 @@ xess_result_t hk_xessGetVelocityScale(xess_context_handle_t hContext, float* pX,
 {
     LOG_DEBUG("");
 
-    if (!_motionScales.contains(hContext))
+    auto entry = GetXeSSContext(hContext);
+
+    if (entry == nullptr)
         return XESS_RESULT_ERROR_INVALID_CONTEXT;
 
-    auto scales = &_motionScales[hContext];
+    auto scales = &entry->MotionScale;
 
     *pX = scales->x;
     *pY = scales->y;
@@ -396,7 +400,12 @@ xess_result_t hk_xessSetJitterScale(xess_context_handle_t hContext, float x, flo
 {
     LOG_DEBUG("x: {}, y: {}", x, y);
 
-    _jitterScales[hContext] = { x, y };
+    auto entry = GetXeSSContext(hContext);
+
+    if (entry == nullptr)
+        return XESS_RESULT_ERROR_INVALID_CONTEXT;
+
+    entry->JitterScale = Scale { x, y };
 
     return XESS_RESULT_SUCCESS;
 }
@@ -405,10 +414,12 @@ xess_result_t hk_xessSetExposureMultiplier(xess_context_handle_t hContext, float
 {
     LOG_DEBUG("");
 
-    if (!_nvParams.contains(hContext))
+    auto entry = GetXeSSContext(hContext);
+
+    if (entry == nullptr)
         return XESS_RESULT_ERROR_INVALID_CONTEXT;
 
-    _nvParams[hContext]->Set(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, scale);
+    entry->Params->Set(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, scale);
 
     return XESS_RESULT_SUCCESS;
 }
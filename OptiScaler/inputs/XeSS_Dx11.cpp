@@ -6,7 +6,6 @@
 #include <proxies/XeSS_Proxy.h>
 #include "menu/menu_overlay_dx.h"
 
-static UINT64 _handleCounter = 33370000;
 static UINT64 _frameCounter = 0;
 static xess_context_handle_t _currentContext = nullptr;
 static ID3D11Device* _d3d11Device = nullptr;
@@ -16,12 +15,14 @@ static bool CreateDLSSContext(xess_context_handle_t handle, ID3D11DeviceContext*
 {
     LOG_DEBUG("");
 
-    if (!_nvParams.contains(handle))
+    auto entry = GetXeSSContext(handle);
+
+    if (entry == nullptr || !entry->D3D11InitParams.has_value())
         return false;
 
     NVSDK_NGX_Handle* nvHandle = nullptr;
-    auto params = _nvParams[handle];
-    auto initParams = &_d3d11InitParams[handle];
+    auto params = entry->Params;
+    auto initParams = &entry->D3D11InitParams.value();
     UINT initFlags = 0;
 
     if ((initParams->initFlags & XESS_INIT_FLAG_LDR_INPUT_COLOR) == 0)
@@ -88,7 +89,7 @@ static bool CreateDLSSContext(xess_context_handle_t handle, ID3D11DeviceContext*
         NVSDK_NGX_Result_Success)
         return false;
 
-    _contexts[handle] = nvHandle;
+    entry->Handle = nvHandle;
 
     return true;
 }
@@ -143,15 +144,15 @@ xess_result_t hk_xessD3D11CreateContext(ID3D11Device* device, xess_context_handl
     }
 
     _d3d11Device = device;
-    *phContext = (xess_context_handle_t) ++_handleCounter;
+    *phContext = (xess_context_handle_t) _contexts.NextHandle().Pack();
 
     NVSDK_NGX_Parameter* params = nullptr;
 
     if (NVSDK_NGX_D3D12_GetCapabilityParameters(&params) != NVSDK_NGX_Result_Success)
         return XESS_RESULT_ERROR_INVALID_ARGUMENT;
 
-    _nvParams[*phContext] = params;
-    _motionScales[*phContext] = { 1.0, 1.0 };
+    auto& entry = _contexts.Emplace(*phContext);
+    entry.Params = params;
 
     return XESS_RESULT_SUCCESS;
 }
@@ -160,18 +161,23 @@ xess_result_t hk_xessD3D11Init(xess_context_handle_t hContext, const xess_d3d11_
 {
     LOG_DEBUG("");
 
+    auto entry = GetXeSSContext(hContext);
+
+    if (entry == nullptr)
+        return XESS_RESULT_ERROR_INVALID_CONTEXT;
+
     xess_d3d11_init_params_t ip {};
     ip.initFlags = pInitParams->initFlags;
     ip.outputResolution = pInitParams->outputResolution;
     ip.qualitySetting = pInitParams->qualitySetting;
 
-    _d3d11InitParams[hContext] = ip;
+    entry->D3D11InitParams = ip;
 
-    if (!_contexts.contains(hContext))
+    if (entry->Handle == nullptr)
         return XESS_RESULT_SUCCESS;
 
-    NVSDK_NGX_D3D11_ReleaseFeature(_contexts[hContext]);
-    _contexts.erase(hContext);
+    NVSDK_NGX_D3D11_ReleaseFeature(entry->Handle);
+    entry->Handle = nullptr;
 
     return XESS_RESULT_SUCCESS;
 }
@@ -191,43 +197,48 @@ xess_result_t hk_xessD3D11Execute(xess_context_handle_t hContext, const xess_d3d
 
     pCommandList->Release();
 
-    if (!_contexts.contains(hContext) && !CreateDLSSContext(hContext, pCommandList, pExecParams))
+    auto entry = GetXeSSContext(hContext);
+
+    if (entry == nullptr)
+        return XESS_RESULT_ERROR_INVALID_CONTEXT;
+
+    if (!entry->D3D11InitParams.has_value())
+        return XESS_RESULT_ERROR_UNINITIALIZED;
+
+    if (entry->Handle == nullptr && !CreateDLSSContext(hContext, pCommandList, pExecParams))
         return XESS_RESULT_ERROR_UNKNOWN;
 
-    NVSDK_NGX_Parameter* params = _nvParams[hContext];
-    NVSDK_NGX_Handle* handle = _contexts[hContext];
-    xess_d3d12_init_params_t* initParams = &_d3d12InitParams[hContext];
+    NVSDK_NGX_Parameter* params = entry->Params;
+    NVSDK_NGX_Handle* handle = entry->Handle;
+    auto initParams = &entry->D3D11InitParams.value();
 
-    if (_motionScales.contains(hContext))
-    {
-        auto scales = &_motionScales[hContext];
+    auto motionScale = &entry->MotionScale;
 
-        if ((initParams->initFlags & XESS_INIT_FLAG_USE_NDC_VELOCITY))
+    if ((initParams->initFlags & XESS_INIT_FLAG_USE_NDC_VELOCITY))
+    {
+        if (initParams->initFlags & XESS_INIT_FLAG_HIGH_RES_MV)
         {
-            if (initParams->initFlags & XESS_INIT_FLAG_HIGH_RES_MV)
-            {
-                params->Set(NVSDK_NGX_Parameter_MV_Scale_X, initParams->outputResolution.x * 0.5 * scales->x);
-                params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, initParams->outputResolution.y * -0.5 * scales->y);
-            }
-            else
-            {
-                params->Set(NVSDK_NGX_Parameter_MV_Scale_X, pExecParams->inputWidth * 0.5 * scales->x);
-                params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, pExecParams->inputHeight * -0.5 * scales->y);
-            }
+            params->Set(NVSDK_NGX_Parameter_MV_Scale_X, initParams->outputResolution.x * 0.5 * motionScale->x);
+            params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, initParams->outputResolution.y * -0.5 * motionScale->y);
         }
         else
         {
-            params->Set(NVSDK_NGX_Parameter_MV_Scale_X, scales->x);
-            params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, scales->y);
+            params->Set(NVSDK_NGX_Parameter_MV_Scale_X, pExecParams->inputWidth * 0.5 * motionScale->x);
+            params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, pExecParams->inputHeight * -0.5 * motionScale->y);
         }
     }
+    else
+    {
+        params->Set(NVSDK_NGX_Parameter_MV_Scale_X, motionScale->x);
+        params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, motionScale->y);
+    }
 
     float jitterScaleX = 1.0f;
     float jitterScaleY = 1.0f;
 
-    if (_jitterScales.contains(hContext))
+    if (entry->JitterScale.has_value())
     {
-        auto scales = &_jitterScales[hContext];
+        auto scales = &entry->JitterScale.value();
         jitterScaleX = scales->x;
         jitterScaleY = scales->y;
     }
@@ -278,10 +289,12 @@ xess_result_t hk_xessD3D11GetInitParams(xess_context_handle_t hContext, xess_d3d
 {
     LOG_DEBUG("");
 
-    if (!_d3d11InitParams.contains(hContext))
+    auto entry = GetXeSSContext(hContext);
+
+    if (entry == nullptr || !entry->D3D11InitParams.has_value())
         return XESS_RESULT_ERROR_INVALID_CONTEXT;
 
-    auto ip = &_d3d12InitParams[hContext];
+    auto ip = &entry->D3D11InitParams.value();
 
     pInitParams->initFlags = ip->initFlags;
     pInitParams->outputResolution = ip->outputResolution;
@@ -6,7 +6,6 @@
 #include <proxies/XeSS_Proxy.h>
 #include "menu/menu_overlay_dx.h"
 
-static UINT64 _handleCounter = 13370000;
 static UINT64 _frameCounter = 0;
 static xess_context_handle_t _currentContext = nullptr;
 static ID3D12Device* _d3d12Device = nullptr;
@@ -16,12 +15,14 @@ static bool CreateDLSSContext(xess_context_handle_t handle, ID3D12GraphicsComman
 {
     LOG_DEBUG("");
 
-    if (!_nvParams.contains(handle))
+    auto entry = GetXeSSContext(handle);
+
+    if (entry == nullptr || !entry->D3D12InitParams.has_value())
         return false;
 
     NVSDK_NGX_Handle* nvHandle = nullptr;
-    auto params = _nvParams[handle];
-    auto initParams = &_d3d12InitParams[handle];
+    auto params = entry->Params;
+    auto initParams = &entry->D3D12InitParams.value();
 
     UINT initFlags = 0;
 
@@ -89,7 +90,7 @@ static bool CreateDLSSContext(xess_context_handle_t handle, ID3D12GraphicsComman
         NVSDK_NGX_Result_Success)
         return false;
 
-    _contexts[handle] = nvHandle;
+    entry->Handle = nvHandle;
 
     return true;
 }
@@ -144,15 +145,15 @@ xess_result_t hk_xessD3D12CreateContext(ID3D12Device* pDevice, xess_context_hand
     }
 
     _d3d12Device = pDevice;
-    *phContext = (xess_context_handle_t) ++_handleCounter;
+    *phContext = (xess_context_handle_t) _contexts.NextHandle().Pack();
 
     NVSDK_NGX_Parameter* params = nullptr;
 
     if (NVSDK_NGX_D3D12_GetCapabilityParameters(&params) != NVSDK_NGX_Result_Success)
         return XESS_RESULT_ERROR_INVALID_ARGUMENT;
 
-    _nvParams[*phContext] = params;
-    _motionScales[*phContext] = { 1.0, 1.0 };
+    auto& entry = _contexts.Emplace(*phContext);
+    entry.Params = params;
 
     return XESS_RESULT_SUCCESS;
 }
@@ -168,6 +169,11 @@ xess_result_t hk_xessD3D12Init(xess_context_handle_t hContext, const xess_d3d12_
 {
     LOG_DEBUG("");
 
+    auto entry = GetXeSSContext(hContext);
+
+    if (entry == nullptr)
+        return XESS_RESULT_ERROR_INVALID_CONTEXT;
+
     xess_d3d12_init_params_t ip {};
     ip.bufferHeapOffset = pInitParams->bufferHeapOffset;
     ip.creationNodeMask = pInitParams->creationNodeMask;
@@ -180,13 +186,13 @@ xess_result_t hk_xessD3D12Init(xess_context_handle_t hContext, const xess_d3d12_
     ip.textureHeapOffset = pInitParams->textureHeapOffset;
     ip.visibleNodeMask = pInitParams->visibleNodeMask;
 
-    _d3d12InitParams[hContext] = ip;
+    entry->D3D12InitParams = ip;
 
-    if (!_contexts.contains(hContext))
+    if (entry->Handle == nullptr)
         return XESS_RESULT_SUCCESS;
 
-    NVSDK_NGX_D3D12_ReleaseFeature(_contexts[hContext]);
-    _contexts.erase(hContext);
+    NVSDK_NGX_D3D12_ReleaseFeature(entry->Handle);
+    entry->Handle = nullptr;
 
     return XESS_RESULT_SUCCESS;
 }
@@ -199,43 +205,48 @@ xess_result_t hk_xessD3D12Execute(xess_context_handle_t hContext, ID3D12Graphics
     if (pCommandList == nullptr)
         return XESS_RESULT_ERROR_INVALID_ARGUMENT;
 
-    if (!_contexts.contains(hContext) && !CreateDLSSContext(hContext, pCommandList, pExecParams))
+    auto entry = GetXeSSContext(hContext);
+
+    if (entry == nullptr)
+        return XESS_RESULT_ERROR_INVALID_CONTEXT;
+
+    if (!entry->D3D12InitParams.has_value())
+        return XESS_RESULT_ERROR_UNINITIALIZED;
+
+    if (entry->Handle == nullptr && !CreateDLSSContext(hContext, pCommandList, pExecParams))
         return XESS_RESULT_ERROR_UNKNOWN;
 
-    NVSDK_NGX_Parameter* params = _nvParams[hContext];
-    NVSDK_NGX_Handle* handle = _contexts[hContext];
-    xess_d3d12_init_params_t* initParams = &_d3d12InitParams[hContext];
+    NVSDK_NGX_Parameter* params = entry->Params;
+    NVSDK_NGX_Handle* handle = entry->Handle;
+    auto initParams = &entry->D3D12InitParams.value();
 
-    if (_motionScales.contains(hContext))
-    {
-        auto scales = &_motionScales[hContext];
+    auto motionScale = &entry->MotionScale;
 
-        if ((initParams->initFlags & XESS_INIT_FLAG_USE_NDC_VELOCITY))
+    if ((initParams->initFlags & XESS_INIT_FLAG_USE_NDC_VELOCITY))
+    {
+        if (initParams->initFlags & XESS_INIT_FLAG_HIGH_RES_MV)
         {
-            if (initParams->initFlags & XESS_INIT_FLAG_HIGH_RES_MV)
-            {
-                params->Set(NVSDK_NGX_Parameter_MV_Scale_X, initParams->outputResolution.x * 0.5 * scales->x);
-                params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, initParams->outputResolution.y * -0.5 * scales->y);
-            }
-            else
-            {
-                params->Set(NVSDK_NGX_Parameter_MV_Scale_X, pExecParams->inputWidth * 0.5 * scales->x);
-                params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, pExecParams->inputHeight * -0.5 * scales->y);
-            }
+            params->Set(NVSDK_NGX_Parameter_MV_Scale_X, initParams->outputResolution.x * 0.5 * motionScale->x);
+            params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, initParams->outputResolution.y * -0.5 * motionScale->y);
         }
         else
         {
-            params->Set(NVSDK_NGX_Parameter_MV_Scale_X, scales->x);
-            params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, scales->y);
+            params->Set(NVSDK_NGX_Parameter_MV_Scale_X, pExecParams->inputWidth * 0.5 * motionScale->x);
+            params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, pExecParams->inputHeight * -0.5 * motionScale->y);
         }
     }
+    else
+    {
+        params->Set(NVSDK_NGX_Parameter_MV_Scale_X, motionScale->x);
+        params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, motionScale->y);
+    }
 
     float jitterScaleX = 1.0f;
     float jitterScaleY = 1.0f;
 
-    if (_jitterScales.contains(hContext))
+    if (entry->JitterScale.has_value())
     {
-        auto scales = &_jitterScales[hContext];
+        auto scales = &entry->JitterScale.value();
         jitterScaleX = scales->x;
         jitterScaleY = scales->y;
     }
@@ -286,10 +297,12 @@ xess_result_t hk_xessD3D12GetInitParams(xess_context_handle_t hContext, xess_d3d
 {
     LOG_DEBUG("");
 
-    if (!_d3d12InitParams.contains(hContext))
+    auto entry = GetXeSSContext(hContext);
+
+    if (entry == nullptr || !entry->D3D12InitParams.has_value())
         return XESS_RESULT_ERROR_INVALID_CONTEXT;
 
-    auto ip = &_d3d12InitParams[hContext];
+    auto ip = &entry->D3D12InitParams.value();
 
     pInitParams->bufferHeapOffset = ip->bufferHeapOffset;
     pInitParams->creationNodeMask = ip->creationNodeMask;
@@ -8,7 +8,6 @@
 
 #include <nvsdk_ngx_vk.h>
 
-static UINT64 _handleCounter = 23370000;
 static UINT64 _frameCounter = 0;
 static xess_context_handle_t _currentContext = nullptr;
 static VkDevice _device = nullptr;
@@ -26,12 +25,14 @@ static bool CreateDLSSContext(xess_context_handle_t handle, VkCommandBuffer comm
 {
     LOG_DEBUG("");
 
-    if (!_nvParams.contains(handle))
+    auto entry = GetXeSSContext(handle);
+
+    if (entry == nullptr || !entry->VkInitParams.has_value())
         return false;
 
     NVSDK_NGX_Handle* nvHandle = nullptr;
-    auto params = _nvParams[handle];
-    auto initParams = &_vkInitParams[handle];
+    auto params = entry->Params;
+    auto initParams = &entry->VkInitParams.value();
 
     UINT initFlags = 0;
 
@@ -99,7 +100,7 @@ static bool CreateDLSSContext(xess_context_handle_t handle, VkCommandBuffer comm
         NVSDK_NGX_Result_Success)
         return false;
 
-    _contexts[handle] = nvHandle;
+    entry->Handle = nvHandle;
 
     return true;
 }
@@ -142,15 +143,15 @@ xess_result_t hk_xessVKCreateContext(VkInstance instance, VkPhysicalDevice physi
             return XESS_RESULT_ERROR_UNINITIALIZED;
     }
 
-    *phContext = (xess_context_handle_t) ++_handleCounter;
+    *phContext = (xess_context_handle_t) _contexts.NextHandle().Pack();
 
     NVSDK_NGX_Parameter* params = nullptr;
 
     if (NVSDK_NGX_VULKAN_GetCapabilityParameters(&params) != NVSDK_NGX_Result_Success)
         return XESS_RESULT_ERROR_INVALID_ARGUMENT;
 
-    _nvParams[*phContext] = params;
-    _motionScales[*phContext] = { 1.0f, 1.0f };
+    auto& entry = _contexts.Emplace(*phContext);
+    entry.Params = params;
 
     LOG_DEBUG("Created context: {}", (size_t) *phContext);
 
@@ -168,6 +169,11 @@ xess_result_t hk_xessVKInit(xess_context_handle_t hContext, const xess_vk_init_p
 {
     LOG_DEBUG("initFlags: {:X}", pInitParams->initFlags);
 
+    auto entry = GetXeSSContext(hContext);
+
+    if (entry == nullptr)
+        return XESS_RESULT_ERROR_INVALID_CONTEXT;
+
     xess_vk_init_params_t ip {};
     ip.bufferHeapOffset = pInitParams->bufferHeapOffset;
     ip.creationNodeMask = pInitParams->creationNodeMask;
@@ -180,13 +186,13 @@ xess_result_t hk_xessVKInit(xess_context_handle_t hContext, const xess_vk_init_p
     ip.textureHeapOffset = pInitParams->textureHeapOffset;
     ip.visibleNodeMask = pInitParams->visibleNodeMask;
 
-    _vkInitParams[hContext] = ip;
+    entry->VkInitParams = ip;
 
-    if (!_contexts.contains(hContext))
+    if (entry->Handle == nullptr)
         return XESS_RESULT_SUCCESS;
 
-    NVSDK_NGX_VULKAN_ReleaseFeature(_contexts[hContext]);
-    _contexts.erase(hContext);
+    NVSDK_NGX_VULKAN_ReleaseFeature(entry->Handle);
+    entry->Handle = nullptr;
 
     return XESS_RESULT_SUCCESS;
 }
@@ -199,43 +205,48 @@ xess_result_t hk_xessVKExecute(xess_context_handle_t hContext, VkCommandBuffer c
     if (commandBuffer == nullptr)
         return XESS_RESULT_ERROR_INVALID_ARGUMENT;
 
-    if (!_contexts.contains(hContext) && !CreateDLSSContext(hContext, commandBuffer, pExecParams))
+    auto entry = GetXeSSContext(hContext);
+
+    if (entry == nullptr)
+        return XESS_RESULT_ERROR_INVALID_CONTEXT;
+
+    if (!entry->VkInitParams.has_value())
+        return XESS_RESULT_ERROR_UNINITIALIZED;
+
+    if (entry->Handle == nullptr && !CreateDLSSContext(hContext, commandBuffer, pExecParams))
         return XESS_RESULT_ERROR_UNKNOWN;
 
-    NVSDK_NGX_Parameter* params = _nvParams[hContext];
-    NVSDK_NGX_Handle* handle = _contexts[hContext];
-    xess_vk_init_params_t* initParams = &_vkInitParams[hContext];
+    NVSDK_NGX_Parameter* params = entry->Params;
+    NVSDK_NGX_Handle* handle = entry->Handle;
+    auto initParams = &entry->VkInitParams.value();
 
-    if (_motionScales.contains(hContext))
-    {
-        auto scales = &_motionScales[hContext];
+    auto motionScale = &entry->MotionScale;
 
-        if ((initParams->initFlags & XESS_INIT_FLAG_USE_NDC_VELOCITY))
+    if ((initParams->initFlags & XESS_INIT_FLAG_USE_NDC_VELOCITY))
+    {
+        if (initParams->initFlags & XESS_INIT_FLAG_HIGH_RES_MV)
         {
-            if (initParams->initFlags & XESS_INIT_FLAG_HIGH_RES_MV)
-            {
-                params->Set(NVSDK_NGX_Parameter_MV_Scale_X, initParams->outputResolution.x * 0.5 * scales->x);
-                params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, initParams->outputResolution.y * -0.5 * scales->y);
-            }
-            else
-            {
-                params->Set(NVSDK_NGX_Parameter_MV_Scale_X, pExecParams->inputWidth * 0.5 * scales->x);
-                params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, pExecParams->inputHeight * -0.5 * scales->y);
-            }
+            params->Set(NVSDK_NGX_Parameter_MV_Scale_X, initParams->outputResolution.x * 0.5 * motionScale->x);
+            params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, initParams->outputResolution.y * -0.5 * motionScale->y);
         }
         else
         {
-            params->Set(NVSDK_NGX_Parameter_MV_Scale_X, scales->x);
-            params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, scales->y);
+            params->Set(NVSDK_NGX_Parameter_MV_Scale_X, pExecParams->inputWidth * 0.5 * motionScale->x);
+            params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, pExecParams->inputHeight * -0.5 * motionScale->y);
         }
     }
+    else
+    {
+        params->Set(NVSDK_NGX_Parameter_MV_Scale_X, motionScale->x);
+        params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, motionScale->y);
+    }
 
     float jitterScaleX = 1.0f;
     float jitterScaleY = 1.0f;
 
-    if (_jitterScales.contains(hContext))
+    if (entry->JitterScale.has_value())
     {
-        auto scales = &_jitterScales[hContext];
+        auto scales = &entry->JitterScale.value();
         jitterScaleX = scales->x;
         jitterScaleY = scales->y;
     }
@@ -339,10 +350,12 @@ xess_result_t hk_xessVKGetInitParams(xess_context_handle_t hContext, xess_vk_ini
 {
     LOG_DEBUG("");
 
-    if (!_vkInitParams.contains(hContext))
+    auto entry = GetXeSSContext(hContext);
+
+    if (entry == nullptr || !entry->VkInitParams.has_value())
         return XESS_RESULT_ERROR_INVALID_CONTEXT;
 
-    auto ip = &_vkInitParams[hContext];
+    auto ip = &entry->VkInitParams.value();
 
     pInitParams->bufferHeapOffset = ip->bufferHeapOffset;
     pInitParams->creationNodeMask = ip->creationNodeMask;
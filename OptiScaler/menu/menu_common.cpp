@@ -26,6 +26,15 @@
 #include <array>
 #include <chrono>
 #include <misc/IdentifyGpu.h>
+#include <misc/PacingSimulator.h>
+#include <misc/PresentProfiler.h>
+#include <misc/LatencyAnalytics.h>
+#include <misc/VramRegistry.h>
+#include <misc/DynamicResolution.h>
+#include <misc/SamplerRegistry.h>
+#include <misc/GameProfiles.h>
+#include <upscalers/IFeature_VkwDx12.h>
+#include <magic_enum.hpp>
 #include <hooks/Xell_Hooks.h>
 
 #define MARK_ALL_BACKENDS_CHANGED()                                                                                    \
@@ -249,6 +258,44 @@ void MenuCommon::ShowResetButton(CustomOptional<bool, NoDefault>* initFlag, std:
     ImGui::EndDisabled();
 }
 
+void MenuCommon::ShowOptionKey(const void* option)
+{
+    if (auto entry = Config::Instance()->FindOption(option); entry != nullptr)
+        ShowTooltip(std::format("[{}] {}", entry->Section(), entry->Key()).c_str());
+}
+
+bool MenuCommon::OptionCheckbox(const char* label, CustomOptional<bool>& option)
+{
+    bool value = option.value_or_default();
+    bool changed = ImGui::Checkbox(label, &value);
+
+    if (changed)
+        option = value;
+
+    ShowOptionKey(&option);
+    return changed;
+}
+
+bool MenuCommon::OptionSlider(const char* label, CustomOptional<float>& option, const char* format)
+{
+    auto entry = Config::Instance()->FindOption(&option);
+    auto range = entry != nullptr ? entry->Range() : std::nullopt;
+    float value = option.value_or_default();
+    bool changed = false;
+
+    // Options without a range in the table can't be a slider
+    if (range.has_value())
+        changed = ImGui::SliderFloat(label, &value, range->first, range->second, format);
+    else
+        changed = ImGui::InputFloat(label, &value, 0.0f, 0.0f, format);
+
+    if (changed)
+        option = value;
+
+    ShowOptionKey(&option);
+    return changed;
+}
+
 inline void MenuCommon::ReInitUpscaler()
 {
     if (!State::Instance().currentFeature)
@@ -759,6 +806,10 @@ LRESULT MenuCommon::WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
     {
         LOG_WARN("IsShuttingDown = true");
         State::Instance().isShuttingDown = true;
+
+        // Config thread stops now, DLL detach is too late for file IO
+        Config::Instance()->FlushSave();
+
         return CallWindowProc(_oWndProc, hWnd, msg, wParam, lParam);
     }
 
@@ -1648,6 +1699,9 @@ bool MenuCommon::RenderMenu()
 
     // Handle Inputs
     {
+        if (inputFG || inputFps || inputFpsCycle || inputMenu)
+            _uiRebuildRequested = true;
+
         if (inputFG)
         {
             inputFG = false;
@@ -1802,6 +1856,28 @@ bool MenuCommon::RenderMenu()
     if ((!config->DisableSplash.value_or_default() && now > splashStart && now < splashLimit) ||
         config->ShowFps.value_or_default() || _isVisible || ImGui::notifications.size() > 0)
     {
+        // Nothing changed, backends will draw the previous frame's draw data again
+        if (!ShouldRebuildUi(now))
+        {
+            // Keep graph history complete for the next rebuild
+            if (config->ShowFps.value_or_default() || _isVisible)
+            {
+                gFrameTimes.Push(static_cast<float>(state.frameTimes.back()));
+                gUpscalerTimes.Push(
+                    static_cast<float>(state.upscaleTimes.empty() ? 0.0f : state.upscaleTimes.back()));
+            }
+
+            return true;
+        }
+
+        _uiBuilt = true;
+        _uiRebuildRequested = false;
+        _uiBuildTime = now;
+        _uiConfigGeneration = config->Generation();
+        _uiScreenWidth = state.screenWidth;
+        _uiScreenHeight = state.screenHeight;
+        _uiGeneration++;
+
         if (!_isUWP)
         {
             ImGui_ImplWin32_NewFrame();
@@ -1817,6 +1893,10 @@ bool MenuCommon::RenderMenu()
 
         newFrame = true;
     }
+    else
+    {
+        _uiBuilt = false;
+    }
 
     float menuResScale = MenuResolutionScale(io);
 
@@ -2237,6 +2317,15 @@ bool MenuCommon::RenderMenu()
                     ImGui::Text("FGId: %llu, RfxId: %llu", localFrameCount, state.reflexFrameId);
                     ImGui::Text("Reflex timings, whole frame: %.1fms", rangeInNs / 1000.0);
 
+                    // Rolling values of the last frames, single frame values are too noisy to read
+                    auto latencyStats = LatencyAnalytics::GetStats();
+
+                    if (latencyStats.Frames > 0)
+                    {
+                        ImGui::Text("Latency p50: %.1fms, p99: %.1fms, stalls: %u", latencyStats.Total.P50Ms,
+                                    latencyStats.Total.P99Ms, latencyStats.Stalls);
+                    }
+
                     const auto maxWidth =
                         config->FpsOverlayHorizontal.value_or_default() ? ImGui::GetWindowWidth() : plotSize.x;
 
@@ -2249,6 +2338,10 @@ bool MenuCommon::RenderMenu()
 
                         auto& timing = timingData[type].value();
                         float duration = static_cast<float>(timing.length * rangeInNs / 1000.0);
+
+                        // TimingType has TimeRange before the stages
+                        if (latencyStats.Frames > 0)
+                            duration = static_cast<float>(latencyStats.Stages[type - 1].P50Ms);
                         ImGui::TextColored(toneMappedColor, "%-12s %4.1fms", desc, duration);
                         auto leftLimit = ImGui::GetItemRectMin().x + offsetForText * fpsScale;
                         auto start = static_cast<float>(leftLimit + (ImGui::GetItemRectMin().x + maxWidth - leftLimit) *
@@ -2676,6 +2769,24 @@ bool MenuCommon::RenderMenu()
                                 ImGui::Checkbox("Use CopyResource for Output", &outputUseCopy))
                                 config->VulkanUseCopyForOutput = outputUseCopy;
 
+                            if (bool elideStatic = config->VulkanElideStaticInputs.value_or_default();
+                                ImGui::Checkbox("Skip Static Input Copies", &elideStatic))
+                                config->VulkanElideStaticInputs = elideStatic;
+
+                            ShowHelpMarker("Skips exposure and reactive mask copies while\n"
+                                           "the game keeps passing the same image\n\n"
+                                           "Don't use if the game updates them in place");
+
+                            if (auto bridge = dynamic_cast<IFeature_VkwDx12*>(currentFeature); bridge != nullptr)
+                            {
+                                const auto& stats = bridge->PipelineStats();
+                                auto avgWait = stats.Waits > 0 ? stats.WaitMs / (double) stats.Waits : 0.0;
+
+                                ImGui::Text("Copies: %llu, Elided: %llu", stats.Copies, stats.CopiesElided);
+                                ImGui::Text("Waits: %llu / %llu frames, Avg: %.2f ms, Max: %.2f ms, Timeouts: %llu",
+                                            stats.Waits, stats.Frames, avgWait, stats.MaxWaitMs, stats.WaitTimeouts);
+                            }
+
                             ImGui::Spacing();
                             ImGui::Spacing();
                         }
@@ -3875,6 +3986,16 @@ bool MenuCommon::RenderMenu()
 
                                     ImGui::BeginDisabled(!config->FGFramePacingTuning.value_or_default());
 
+                                    if (bool fptAutoTune = config->FGFPTAutoTune.value_or_default();
+                                        ImGui::Checkbox("Auto Tune", &fptAutoTune))
+                                    {
+                                        config->FGFPTAutoTune = fptAutoTune;
+                                    }
+                                    ShowHelpMarker("Adjusts the values below by measuring present jitter and CPU cost\n"
+                                                   "Converged values are written to the log");
+
+                                    ImGui::BeginDisabled(config->FGFPTAutoTune.value_or_default());
+
                                     ImGui::PushItemWidth(115.0f * menuResScale);
                                     auto fptSafetyMargin = config->FGFPTSafetyMarginInMs.value_or_default();
                                     if (ImGui::InputFloat("Safety Margins in ms", &fptSafetyMargin, 0.01f, 0.1f,
@@ -3919,6 +4040,7 @@ bool MenuCommon::RenderMenu()
                                     if (ImGui::Button("Apply Timing Changes"))
                                         state.FSRFGFTPchanged = true;
 
+                                    ImGui::EndDisabled();
                                     ImGui::EndDisabled();
                                     ImGui::TreePop();
                                 }
@@ -4372,6 +4494,14 @@ bool MenuCommon::RenderMenu()
                                                "Helps games which use black borders for some \n"
                                                "resolutions and screen ratios (e.g. Witcher 3)");
 
+                                if (OptionCheckbox("Validate Hudless", config->FGHudfixValidation))
+                                    LOG_DEBUG("Enabled set FGHudfixValidation: {}", config->FGHudfixValidation.value());
+                                ShowHelpMarker("Compare Hudless with the final image on GPU\n"
+                                               "and disable it for a while when it keeps\n"
+                                               "differing almost everywhere\n\n"
+                                               "Disabled resources are retried later or can be\n"
+                                               "enabled again from the Hudless Resources window");
+
                                 ImGui::BeginDisabled(state.FGresetCapturedResources);
                                 ImGui::PushItemWidth(95.0f * menuResScale);
                                 if (ImGui::Checkbox("FG Create List", &state.FGcaptureResources))
@@ -4525,6 +4655,22 @@ bool MenuCommon::RenderMenu()
                                 ShowHelpMarker("Use mutex to prevent desync of FG and crashes\n"
                                                "Disabling might improve the perf but decrease stability");
 
+                                if (useMutexForPresent && state.currentFG != nullptr)
+                                {
+                                    auto ticketStats = state.currentFG->PresentTicket.GetStats();
+                                    auto blocked = ticketStats.Waits - ticketStats.FastPaths;
+                                    auto avgWait =
+                                        blocked > 0 ? ticketStats.TotalWaitNs / (double) blocked / 1000.0 : 0.0;
+
+                                    ImGui::Text("Present waits: %llu, blocked: %llu, dropped: %llu", ticketStats.Waits,
+                                                blocked, ticketStats.Timeouts);
+                                    ImGui::Text("Blocked wait avg: %.1f us, max: %.1f us", avgWait,
+                                                ticketStats.MaxWaitNs / 1000.0);
+
+                                    if (ImGui::Button("Reset##PresentTicket"))
+                                        state.currentFG->PresentTicket.ResetStats();
+                                }
+
                                 ImGui::TreePop();
                             }
 
@@ -4930,6 +5076,114 @@ bool MenuCommon::RenderMenu()
                             config->FramerateLimit = _limitFps;
                         }
                     }
+
+                    if (auto ch = ScopedCollapsingHeader("Pacing Simulator"); ch.IsHeaderOpen())
+                    {
+                        ScopedIndent indent {};
+                        ImGui::Spacing();
+
+                        static PacingSimParams simParams {};
+
+                        ImGui::PushItemWidth(105.0f * menuResScale);
+                        ImGui::InputFloat("CPU ms", &simParams.SimulationMs, 0.5f, 1.0f, "%.1f");
+                        ImGui::InputFloat("GPU ms", &simParams.GpuMs, 0.5f, 1.0f, "%.1f");
+                        ImGui::PopItemWidth();
+
+                        ImGui::Checkbox("VSync", &simParams.VSync);
+                        ShowHelpMarker("Runs FrameLimit and the LatencyFlex modes against a simulated\n"
+                                       "game with the values above, the current FPS limit and refresh rate\n\n"
+                                       "Results are also written to the log");
+
+                        ImGui::SameLine(0.0f, 16.0f);
+
+                        ImGui::BeginDisabled(PacingSimulator::IsRunning());
+                        if (ImGui::Button("Run Simulation"))
+                        {
+                            simParams.FpsLimit = config->FramerateLimit.value_or_default();
+                            simParams.RefreshRate = refreshRate > 0 ? (float) refreshRate : 60.0f;
+                            PacingSimulator::RunAsync(simParams);
+                        }
+                        ImGui::EndDisabled();
+
+                        for (const auto& result : PacingSimulator::LastResults())
+                        {
+                            ImGui::Text("%-16s %6.2f ms (p99 %6.2f)  %6.1f fps  +/-%.2f ms",
+                                        std::string(magic_enum::enum_name(result.Policy)).c_str(),
+                                        result.AvgLatencyMs, result.P99LatencyMs, result.Fps,
+                                        result.FrameTimeStdDevMs);
+                        }
+                    }
+
+                    if (auto ch = ScopedCollapsingHeader("Present Profiler"); ch.IsHeaderOpen())
+                    {
+                        ScopedIndent indent {};
+                        ImGui::Spacing();
+
+                        if (bool profiler = config->PresentProfiler.value_or_default();
+                            ImGui::Checkbox("Enable Profiler", &profiler))
+                        {
+                            config->PresentProfiler = profiler;
+                            PresentProfiler::Reset();
+                        }
+                        ShowHelpMarker("Measures each phase of the present path\n"
+                                       "Times of nested phases are not included in the outer phase\n\n"
+                                       "Values are p50 / p99 / max of the last 512 presents");
+
+                        ImGui::SameLine(0.0f, 16.0f);
+
+                        ImGui::BeginDisabled(!config->PresentProfiler.value_or_default());
+                        if (ImGui::Button("Save CSV"))
+                            PresentProfiler::DumpCsv(Util::DllPath().parent_path() / "present_profiler.csv");
+                        ImGui::EndDisabled();
+
+                        if (config->PresentProfiler.value_or_default())
+                        {
+                            auto stats = PresentProfiler::GetStats();
+
+                            for (size_t i = 0; i < (size_t) PresentPhase::Count; i++)
+                            {
+                                const auto& phase = stats.Phases[i];
+                                ImGui::Text("%-18s %6.3f / %6.3f / %6.3f ms",
+                                            std::string(magic_enum::enum_name((PresentPhase) i)).c_str(),
+                                            phase.P50Ms, phase.P99Ms, phase.MaxMs);
+                            }
+
+                            ImGui::Text("%-18s %6.3f / %6.3f / %6.3f ms", "Total", stats.Total.P50Ms,
+                                        stats.Total.P99Ms, stats.Total.MaxMs);
+                        }
+                    }
+
+                    if (auto ch = ScopedCollapsingHeader("VRAM Usage"); ch.IsHeaderOpen())
+                    {
+                        ScopedIndent indent {};
+                        ImGui::Spacing();
+
+                        if (bool releaseIdle = config->ReleaseIdleBuffersOnLowVram.value_or_default();
+                            ImGui::Checkbox("Release Idle Buffers On Low VRAM", &releaseIdle))
+                        {
+                            config->ReleaseIdleBuffersOnLowVram = releaseIdle;
+                        }
+                        ShowHelpMarker("When VRAM usage is close to the budget, releases buffers of\n"
+                                       "output scaling, RCAS & mipmap bias passes which are not used\n"
+                                       "for a while. They are recreated when the pass is used again");
+
+                        auto& registry = VramRegistry::Instance();
+                        auto budget = registry.LastBudget();
+
+                        if (budget.Budget > 0)
+                        {
+                            ImGui::Text("Usage: %llu / %llu MB (%s)", budget.Usage / 1048576, budget.Budget / 1048576,
+                                        std::string(magic_enum::enum_name(registry.Pressure())).c_str());
+                        }
+
+                        ImGui::Text("OptiScaler: %.2f MB", registry.Total() / 1048576.0);
+
+                        for (const auto& total : registry.Totals())
+                        {
+                            ImGui::Text("%-18s %8.2f MB in %u", total.Owner.c_str(), total.Bytes / 1048576.0,
+                                        total.Count);
+                        }
+                    }
                 }
 
                 // FAKENVAPI ---------------------------
@@ -5006,11 +5260,8 @@ bool MenuCommon::RenderMenu()
                     // SHARPNESS -----------------------------
                     ImGui::SeparatorText("Sharpness");
 
-                    if (bool overrideSharpness = config->OverrideSharpness.value_or_default();
-                        ImGui::Checkbox("Override", &overrideSharpness))
+                    if (OptionCheckbox("Override", config->OverrideSharpness))
                     {
-                        config->OverrideSharpness = overrideSharpness;
-
                         if (currentBackend == Upscaler::DLSS && currentFeature->Version().major < 3)
                         {
                             state.newBackend = currentBackend;
@@ -5022,10 +5273,7 @@ bool MenuCommon::RenderMenu()
 
                     ImGui::BeginDisabled(!config->OverrideSharpness.value_or_default());
 
-                    float sharpness = config->Sharpness.value_or_default();
-
-                    if (ImGui::SliderFloat("Sharpness", &sharpness, 0.0f, 1.0f))
-                        config->Sharpness = sharpness;
+                    OptionSlider("Sharpness", config->Sharpness);
 
                     ImGui::EndDisabled();
 
@@ -5096,16 +5344,12 @@ bool MenuCommon::RenderMenu()
 
                         ImGui::Spacing();
 
-                        if (bool overrideMotionSharpness = config->MotionSharpnessEnabled.value_or_default();
-                            ImGui::Checkbox("Enable Motion Adaptive Sharpness", &overrideMotionSharpness))
-                            config->MotionSharpnessEnabled = overrideMotionSharpness;
+                        OptionCheckbox("Enable Motion Adaptive Sharpness", config->MotionSharpnessEnabled);
                         ShowHelpMarker("Enables sharpness adjustments according to the motion");
 
                         if (Config::Instance()->SharpnessShader.value_or_default() != SharpenShader::RCAS)
                         {
-                            if (bool overrideMSDebug = config->MotionSharpnessDebug.value_or_default();
-                                ImGui::Checkbox("DA + MAS Debug", &overrideMSDebug))
-                                config->MotionSharpnessDebug = overrideMSDebug;
+                            OptionCheckbox("DA + MAS Debug", config->MotionSharpnessDebug);
 
                             ShowHelpMarker("Enable DA + MAS debug views\n"
                                            "Blue tint for DA detected edges\n\n"
@@ -5190,17 +5434,13 @@ bool MenuCommon::RenderMenu()
                         }
                         else
                         {
-                            if (bool contrastEnabled = config->ContrastEnabled.value_or_default();
-                                ImGui::Checkbox("Contrast Enabled", &contrastEnabled))
-                                config->ContrastEnabled = contrastEnabled;
+                            OptionCheckbox("Contrast Enabled", config->ContrastEnabled);
 
                             ShowHelpMarker("Controls sharpness at high contrast areas.");
 
                             ImGui::BeginDisabled(!config->ContrastEnabled.value_or_default());
 
-                            float contrast = config->Contrast.value_or_default();
-                            if (ImGui::SliderFloat("Contrast", &contrast, -2.0f, 2.0f, "%.2f"))
-                                config->Contrast = contrast;
+                            OptionSlider("Contrast", config->Contrast, "%.2f");
 
                             ShowHelpMarker("Positive values decrease sharpness at high contrast areas.\n"
                                            "Negative values increase sharpness at high contrast areas.");
@@ -5218,34 +5458,26 @@ bool MenuCommon::RenderMenu()
 
                             if (Config::Instance()->SharpnessShader.value_or_default() == SharpenShader::RCAS)
                             {
-                                if (bool overrideMSDebug = config->MotionSharpnessDebug.value_or_default();
-                                    ImGui::Checkbox("MAS Debug", &overrideMSDebug))
-                                    config->MotionSharpnessDebug = overrideMSDebug;
+                                OptionCheckbox("MAS Debug", config->MotionSharpnessDebug);
                                 ShowHelpMarker("Areas that are more red will have more sharpness applied\n"
                                                "Green areas will get reduced sharpness");
                             }
 
-                            float motionSharpness = config->MotionSharpness.value_or_default();
-                            ImGui::SliderFloat("MotionSharpness", &motionSharpness, -1.0f, 1.0f, "%.3f");
-                            config->MotionSharpness = motionSharpness;
+                            OptionSlider("MotionSharpness", config->MotionSharpness);
 
                             ShowHelpMarker("Maximum amount of sharpness that motion can add or remove.\n\n"
                                            "Negative values reduce sharpening in motion (recommended).\n"
                                            "Positive values increase sharpening in motion.\n\n"
                                            "The final adjustment scales with motion and is capped at this value.");
 
-                            float motionThreshod = config->MotionThreshold.value_or_default();
-                            ImGui::SliderFloat("MotionThreshod", &motionThreshod, 0.0f, 100.0f, "%.2f");
-                            config->MotionThreshold = motionThreshod;
+                            OptionSlider("MotionThreshod", config->MotionThreshold, "%.2f");
 
                             ShowHelpMarker(
                                 "Minimum motion required before motion-based sharpening adjustment begins.\n\n"
                                 "Higher values ignore small movements (more stable).\n"
                                 "Lower values react to subtle motion (more sensitive).");
 
-                            float motionScale = config->MotionScaleLimit.value_or_default();
-                            ImGui::SliderFloat("MotionRange", &motionScale, 0.01f, 100.0f, "%.2f");
-                            config->MotionScaleLimit = motionScale;
+                            OptionSlider("MotionRange", config->MotionScaleLimit, "%.2f");
 
                             ShowHelpMarker(
                                 "Defines the motion range over which the effect ramps from zero to full strength.\n\n"
@@ -5438,6 +5670,23 @@ bool MenuCommon::RenderMenu()
                             ImGui::SliderFloat("Ratio", &_ssRatio, 0.5f, 3.0f, "%.2f");
                             ImGui::EndDisabled();
 
+                            if (state.api == API::DX12)
+                            {
+                                ImGui::BeginDisabled(!config->OutputScalingEnabled.value_or_default());
+
+                                if (bool fused = config->OutputScalingFusedPasses.value_or_default();
+                                    ImGui::Checkbox("Fused Passes", &fused))
+                                {
+                                    config->OutputScalingFusedPasses = fused;
+                                }
+
+                                ShowHelpMarker("Runs downscaling and RCAS sharpening in a single compute pass\n"
+                                               "Only used with Bicubic to Kaiser3 downscalers and RCAS\n"
+                                               "Timings are written to the log");
+
+                                ImGui::EndDisabled();
+                            }
+
                             if (currentFeature != nullptr && !currentFeature->IsFrozen())
                             {
                                 ImGui::Text("Output Scaling is %s, Target Res: %dx%d (%.2f)\nJitter Count: %d",
@@ -5453,6 +5702,31 @@ bool MenuCommon::RenderMenu()
                         }
                     }
 
+                    // JITTER -----------------------------
+                    ImGui::SeparatorText("Jitter");
+
+                    const auto& jitter = currentFeature->JitterInfo();
+                    auto recommended = JitterAnalyzer::RecommendedPhaseCount(currentFeature->RenderWidth(),
+                                                                             currentFeature->DisplayWidth());
+
+                    ImGui::Text("Phases: %u%s (recommended %u), Halton: %u/%u, Confidence: %.2f",
+                                jitter.PhaseCount, jitter.PeriodLocked ? "" : "?", recommended, jitter.BaseX,
+                                jitter.BaseY, jitter.Confidence);
+                    ImGui::Text("Units: %s, Flipped: %s%s, Resets: %u",
+                                jitter.Units == JitterUnits::Pixels ? "Pixels"
+                                : jitter.Units == JitterUnits::NDC  ? "NDC"
+                                                                    : "Unknown",
+                                jitter.FlippedX ? "X" : "", jitter.FlippedY ? "Y" : "", jitter.Resets);
+
+                    const ImVec4 warningColor(1.f, 0.8f, 0.f, 1.f);
+
+                    if (jitter.ZeroJitter)
+                        ImGui::TextColored(warningColor, "Jitter is zero, upscaler can't gather details!");
+                    else if (jitter.PeriodLocked && jitter.Units == JitterUnits::NDC)
+                        ImGui::TextColored(warningColor, "Jitter looks like NDC values, pixels are expected!");
+                    else if (jitter.PeriodLocked && jitter.PhaseCount * 2 < recommended)
+                        ImGui::TextColored(warningColor, "Low phase count, might cause shimmering!");
+
                     // INIT -----------------------------
                     ImGui::SeparatorText("Init Flags");
                     if (ImGui::BeginTable("init", 2, ImGuiTableFlags_SizingStretchProp))
@@ -5619,6 +5893,59 @@ bool MenuCommon::RenderMenu()
                     }
                 }
 
+                // GAME PROFILE -----------------------------
+                ImGui::Spacing();
+                if (auto ch = ScopedCollapsingHeader("Game Profile"); ch.IsHeaderOpen())
+                {
+                    ScopedIndent indent {};
+                    ImGui::Spacing();
+
+                    auto activeProfile = GameProfiles::Instance().Active();
+
+                    if (activeProfile != nullptr)
+                        ImGui::Text("Active: %s (%s)", activeProfile->Name.c_str(), activeProfile->Source.c_str());
+                    else
+                        ImGui::Text("No profile for this game");
+
+                    bool useProfiles = config->UseGameProfiles.value_or_default();
+                    if (ImGui::Checkbox("Use Game Profiles", &useProfiles))
+                        config->UseGameProfiles = useProfiles;
+
+                    ShowHelpMarker("Known good settings for the game from GameProfiles.ini\n"
+                                   "Settings in OptiScaler.ini always override the profile\n\n"
+                                   "Requires a restart");
+
+                    if (ImGui::Button("Export Profile"))
+                    {
+                        GameProfile profile {};
+
+                        // Keep the keys of the active profile, so the export replaces it
+                        if (activeProfile != nullptr)
+                        {
+                            profile = *activeProfile;
+                        }
+                        else
+                        {
+                            profile.Name = state.GameName.empty() ? state.GameExe : state.GameName;
+                            profile.Exes.push_back(state.GameExe);
+                            to_lower_in_place(profile.Exes.back());
+                        }
+
+                        profile.Options = config->GetProfileOptions();
+
+                        auto path = Util::DllPath().parent_path() / GameProfiles::UserFileName;
+                        auto exported = GameProfiles::Export(path, profile);
+
+                        ImGuiToast notification { exported ? ImGuiToastType::Success : ImGuiToastType::Error, 5000 };
+                        notification.setTitle(exported ? "Game profile exported" : "Game profile export failed");
+                        notification.setContent("%s", wstring_to_string(path.filename().wstring()).c_str());
+                        ImGui::InsertNotification(notification);
+                    }
+
+                    ShowHelpMarker("Saves the current settings as the profile of this game\n"
+                                   "into GameProfiles.user.ini, which overrides GameProfiles.ini");
+                }
+
                 // ADVANCED SETTINGS -----------------------------
                 ImGui::Spacing();
                 if (auto ch = ScopedCollapsingHeader("Advanced Settings"); ch.IsHeaderOpen())
@@ -5664,6 +5991,26 @@ bool MenuCommon::RenderMenu()
                         ImGui::EndTable();
                     }
 
+                    if (bool dynamicRes = config->DynamicResolution.value_or_default();
+                        ImGui::Checkbox("Dynamic Resolution", &dynamicRes))
+                    {
+                        config->DynamicResolution = dynamicRes;
+                    }
+                    ShowHelpMarker("Adjusts upscale ratio to keep frame time around the target\n"
+                                   "Only works with DLSS inputs and games which query\n"
+                                   "optimal settings while running");
+
+                    if (config->DynamicResolution.value_or_default())
+                    {
+                        float targetMs = config->DynamicResolutionTargetMs.value_or_default();
+                        if (ImGui::SliderFloat("Target Frame Time", &targetMs, 4.0f, 50.0f, "%.2f ms"))
+                            config->DynamicResolutionTargetMs = targetMs;
+                        ShowHelpMarker("Applied when Dynamic Resolution is toggled");
+
+                        if (auto ratio = DynamicResolution::LiveRatio(); ratio.has_value())
+                            ImGui::Text("Current Ratio: %.2f", ratio.value());
+                    }
+
                     // Non-DLSS hotfixes -----------------------------
                     if (currentFeature != nullptr && !currentFeature->IsFrozen() && currentBackend != Upscaler::DLSS)
                     {
@@ -6051,9 +6398,14 @@ bool MenuCommon::RenderMenu()
                         ImGui::EndCombo();
                     }
 
-                    float fpsAlpha = config->FpsOverlayAlpha.value_or_default();
-                    if (ImGui::SliderFloat("Background Alpha", &fpsAlpha, 0.0f, 1.0f, "%.2f"))
-                        config->FpsOverlayAlpha = fpsAlpha;
+                    OptionSlider("Background Alpha", config->FpsOverlayAlpha, "%.2f");
+
+                    int uiRefreshRate = config->MenuRefreshRate.value_or_default();
+                    if (ImGui::SliderInt("Refresh Rate", &uiRefreshRate, 0, 60,
+                                         uiRefreshRate == 0 ? "Every frame" : "%d Hz"))
+                        config->MenuRefreshRate = uiRefreshRate;
+                    ShowHelpMarker("Rebuild rate of menu & overlays when there is no input\n"
+                                   "Frames in between draw the previous frame again, lowers CPU cost");
 
                     const char* options[] = { "Same as menu", "0.5", "0.6", "0.7", "0.8", "0.9", "1.0", "1.1", "1.2",
                                               "1.3",          "1.4", "1.5", "1.6", "1.7", "1.8", "1.9", "2.0" };
@@ -6277,6 +6629,21 @@ bool MenuCommon::RenderMenu()
                         }
                         ImGui::EndDisabled();
 
+                        OptionCheckbox("MB Auto From Render Ratio", config->MipmapBiasAuto);
+
+                        ShowHelpMarker("Use log2(render width / display width) as fixed bias\n"
+                                       "Follows render resolution changes of DRS\n"
+                                       "Takes precedence over override value");
+
+                        ImGui::SameLine(0.0f, 6.0f);
+
+                        OptionCheckbox("Update Staged Samplers", config->MipmapBiasLiveUpdate);
+
+                        ShowHelpMarker("Apply changes to samplers game keeps in staging heaps (DX12 only)\n"
+                                       "ONLY staging copies are rewritten, samplers GPU is using are not\n"
+                                       "Changes show up when the game copies them again or creates new ones\n"
+                                       "Samplers created while this is disabled are not updated");
+
                         ImGui::BeginDisabled(config->MipmapBiasOverride.has_value() &&
                                              config->MipmapBiasOverride.value() == _mipBias);
                         {
@@ -6334,7 +6701,13 @@ bool MenuCommon::RenderMenu()
                             ImGui::Text("Current : %.3f / %.3f", state.lastMipBias, state.lastMipBiasMax);
                         }
 
-                        ImGui::Text("Will be applied after RESOLUTION/PRESET change !!!");
+                        if (state.api == DX12 && config->MipmapBiasLiveUpdate.value_or_default())
+                        {
+                            ImGui::Text("Staged samplers: %zu", SamplerRegistry::Instance().Slots());
+                            ImGui::Text("In use samplers update when game copies staged ones again !!!");
+                        }
+                        else
+                            ImGui::Text("Will be applied after RESOLUTION/PRESET change !!!");
                     }
 
                     ImGui::Spacing();
@@ -6504,7 +6877,14 @@ bool MenuCommon::RenderMenu()
                 ImGui::SameLine(0.0f, 15.0f);
 
                 if (ImGui::Button("Save INI"))
-                    config->SaveIni();
+                    _iniSaveFailed = !config->SaveIni();
+
+                if (_iniSaveFailed)
+                {
+                    ShowTooltip("Can't save ini, check if the file is read only");
+                    ImGui::SameLine(0.0f, 6.0f);
+                    ImGui::TextColored(ImVec4(1.f, 0.4f, 0.f, 1.f), "Save failed!");
+                }
 
                 ImGui::SameLine(0.0f, 6.0f);
 
@@ -6831,6 +7211,27 @@ bool MenuCommon::RenderMenu()
     return newFrame;
 }
 
+bool MenuCommon::ShouldRebuildUi(double now)
+{
+    auto refreshRate = Config::Instance()->MenuRefreshRate.value_or_default();
+
+    if (refreshRate <= 0 || !_uiBuilt || _uiRebuildRequested)
+        return true;
+
+    // Queued input events are only processed by NewFrame, active items (sliders, text inputs) need every frame
+    if (GImGui->InputEventsQueue.Size > 0 || GImGui->ActiveId != 0)
+        return true;
+
+    auto& state = State::Instance();
+    if (Config::Instance()->Generation() != _uiConfigGeneration || state.screenWidth != _uiScreenWidth ||
+        state.screenHeight != _uiScreenHeight)
+    {
+        return true;
+    }
+
+    return (now - _uiBuildTime) >= 1000.0 / refreshRate;
+}
+
 void MenuCommon::Init(HWND InHwnd, bool isUWP)
 {
     _handle = InHwnd;
@@ -6917,6 +7318,7 @@ void MenuCommon::Init(HWND InHwnd, bool isUWP)
         AttachHooks();
 
     ApplyThemeStyle();
+    _uiBuilt = false;
     _isInited = true;
 }
 
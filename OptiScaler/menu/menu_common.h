@@ -87,6 +87,7 @@ class MenuCommon
 
     // mipmap calculations
     inline static bool _showMipmapCalcWindow = false;
+    inline static bool _iniSaveFailed = false;
     inline static bool _showHudlessWindow = false;
     inline static float _mipBias = 0.0f;
     inline static float _mipBiasCalculated = 0.0f;
@@ -120,10 +121,26 @@ class MenuCommon
     inline static bool _dx12Ready = false;
     inline static bool _vulkanReady = false;
 
+    // reduced rate ui rebuild
+    inline static bool _uiBuilt = false;
+    inline static bool _uiRebuildRequested = false;
+    inline static double _uiBuildTime = 0.0;
+    inline static uint32_t _uiConfigGeneration = 0;
+    inline static float _uiScreenWidth = 0.0f;
+    inline static float _uiScreenHeight = 0.0f;
+    inline static uint64_t _uiGeneration = 0;
+
+    static bool ShouldRebuildUi(double now);
+
     inline static void ShowTooltip(const char* tip);
 
     inline static void ShowHelpMarker(const char* tip);
     inline static void ShowResetButton(CustomOptional<bool, NoDefault>* initFlag, std::string buttonName);
+
+    // Widgets for options of the config table, range & ini key come from the table
+    inline static bool OptionCheckbox(const char* label, CustomOptional<bool>& option);
+    inline static bool OptionSlider(const char* label, CustomOptional<float>& option, const char* format = "%.3f");
+    inline static void ShowOptionKey(const void* option);
     inline static void ReInitUpscaler();
 
     inline static void SeparatorWithHelpMarker(const char* label, const char* tip);
@@ -196,6 +213,9 @@ class MenuCommon
     static bool IsVisible() { return _isVisible; }
     static HWND Handle() { return _handle; }
 
+    // Changes with every UI rebuild, backends replay their recorded draws while it stays the same
+    static uint64_t UiGeneration() { return _uiGeneration; }
+
     static bool RenderMenu();
     static void Init(HWND InHwnd, bool isUWP);
     static void Shutdown();
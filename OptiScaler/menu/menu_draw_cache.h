@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Remembers which UI build (MenuCommon::UiGeneration) the overlay commands recorded for each
+// backbuffer belong to. While the UI isn't rebuilt the recorded commands are submitted again
+// instead of uploading the vertices and recording the draws once more.
+class MenuDrawCache
+{
+  private:
+    std::vector<uint64_t> _generations;
+
+  public:
+    bool CanReplay(uint32_t backbuffer, uint64_t generation) const
+    {
+        return generation != 0 && backbuffer < _generations.size() && _generations[backbuffer] == generation;
+    }
+
+    // Call before recording, a failed or partial recording must not be replayed
+    void Invalidate(uint32_t backbuffer)
+    {
+        if (backbuffer < _generations.size())
+            _generations[backbuffer] = 0;
+    }
+
+    void Recorded(uint32_t backbuffer, uint64_t generation)
+    {
+        if (backbuffer >= _generations.size())
+            _generations.resize(backbuffer + 1, 0);
+
+        _generations[backbuffer] = generation;
+    }
+
+    // Command lists, render targets or swapchain images were recreated
+    void Clear() { _generations.clear(); }
+};
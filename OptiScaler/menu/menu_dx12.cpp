@@ -124,8 +124,9 @@ bool Menu_Dx12::Render(ID3D12GraphicsCommandList* pCmdList, ID3D12Resource* outT
         // ImGui_ImplWin32_NewFrame();
 
         // Render
+        // Menu wasn't rebuilt since this buffer was uploaded, only the draws are recorded again
         if (MenuDxBase::RenderMenu())
-            ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), pCmdList);
+            ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), pCmdList, (int) backbuf, MenuDxBase::UiGeneration());
 
         outBarrier.Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;
         outBarrier.Transition.StateAfter = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
@@ -173,7 +174,7 @@ bool Menu_Dx12::Render(ID3D12GraphicsCommandList* pCmdList, ID3D12Resource* outT
     // Render to buffer
     if (MenuDxBase::RenderMenu())
     {
-        ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), pCmdList);
+        ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), pCmdList, (int) backbuf, MenuDxBase::UiGeneration());
 
         outBarrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_SOURCE;
         outBarrier.Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_DEST;
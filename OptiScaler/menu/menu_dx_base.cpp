@@ -24,6 +24,8 @@ bool MenuDxBase::RenderMenu()
     return false;
 }
 
+uint64_t MenuDxBase::UiGeneration() { return MenuCommon::UiGeneration(); }
+
 bool MenuDxBase::IsHandleDifferent()
 {
     if (Config::Instance()->OverlayMenu.value_or_default())
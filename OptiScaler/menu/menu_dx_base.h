@@ -15,6 +15,7 @@ class MenuDxBase
   protected:
     long frameCounter = 0;
     static bool RenderMenu();
+    static uint64_t UiGeneration();
 
     static DXGI_FORMAT TranslateTypelessFormats(DXGI_FORMAT format)
     {
@@ -38,6 +38,8 @@ bool MenuOverlayBase::RenderMenu()
     return MenuCommon::RenderMenu();
 }
 
+uint64_t MenuOverlayBase::UiGeneration() { return MenuCommon::UiGeneration(); }
+
 void MenuOverlayBase::Shutdown() { MenuCommon::Shutdown(); }
 
 void MenuOverlayBase::HideMenu() { MenuCommon::HideMenu(); }
@@ -19,6 +19,7 @@ class MenuOverlayBase
 
     static void Init(HWND InHandle, bool isUWP);
     static bool RenderMenu();
+    static uint64_t UiGeneration();
     static void Shutdown();
     static void HideMenu();
 };
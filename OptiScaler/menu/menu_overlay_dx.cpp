@@ -1,6 +1,7 @@
 #include "pch.h"
 #include "menu_overlay_base.h"
 #include "menu_overlay_dx.h"
+#include "menu_draw_cache.h"
 
 #include <Util.h>
 #include <Logger.h>
@@ -27,8 +28,9 @@ static ID3D12DescriptorHeap* g_pd3dRtvDescHeap = nullptr;
 static ID3D12DescriptorHeap* g_pd3dSrvDescHeap = nullptr;
 static DescriptorHeapAllocator g_pd3dSrvDescHeapAlloc;
 static ID3D12CommandQueue* g_pd3dCommandQueue = nullptr;
-static ID3D12GraphicsCommandList* g_pd3dCommandList = nullptr;
+static ID3D12GraphicsCommandList* g_pd3dCommandLists[NUM_BACK_BUFFERS] = {};
 static ID3D12CommandAllocator* g_commandAllocators[NUM_BACK_BUFFERS] = {};
+static MenuDrawCache g_drawCache;
 static ID3D12Resource* g_mainRenderTargetResource[NUM_BACK_BUFFERS] = {};
 static D3D12_CPU_DESCRIPTOR_HANDLE g_mainRenderTargetDescriptor[NUM_BACK_BUFFERS] = {};
 
@@ -124,6 +126,9 @@ static void CleanupRenderTargetDx12(bool clearQueue)
 
     LOG_TRACE("clearQueue: {}", clearQueue);
 
+    // Recorded lists reference the render targets
+    g_drawCache.Clear();
+
     for (UINT i = 0; i < NUM_BACK_BUFFERS; ++i)
     {
         if (g_mainRenderTargetResource[i])
@@ -144,11 +149,10 @@ static void CleanupRenderTargetDx12(bool clearQueue)
 
         for (UINT i = 0; i < NUM_BACK_BUFFERS; ++i)
         {
+            SAFE_RELEASE(g_pd3dCommandLists[i]);
             SAFE_RELEASE(g_commandAllocators[i]);
         }
 
-        SAFE_RELEASE(g_pd3dCommandList);
-
         if (g_pd3dCommandQueue != nullptr)
             g_pd3dCommandQueue = nullptr;
 
@@ -361,6 +365,7 @@ static void RenderImGui_DX12(IDXGISwapChain* pSwapChainPlain)
             g_pd3dSrvDescHeapAlloc.Create(device, g_pd3dSrvDescHeap);
         }
 
+        // One list per backbuffer, a recorded list is executed again while the menu isn't rebuilt
         for (UINT i = 0; i < NUM_BACK_BUFFERS; ++i)
         {
             result =
@@ -374,27 +379,27 @@ static void RenderImGui_DX12(IDXGISwapChain* pSwapChainPlain)
                 pSwapChain->Release();
                 return;
             }
-        }
 
-        result = device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, g_commandAllocators[0], NULL,
-                                           IID_PPV_ARGS(&g_pd3dCommandList));
-        if (result != S_OK)
-        {
-            LOG_ERROR("CreateCommandList: {0:X}", (unsigned long) result);
-            MenuOverlayBase::HideMenu();
-            CleanupRenderTargetDx12(true);
-            pSwapChain->Release();
-            return;
-        }
+            result = device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, g_commandAllocators[i], NULL,
+                                               IID_PPV_ARGS(&g_pd3dCommandLists[i]));
+            if (result != S_OK)
+            {
+                LOG_ERROR("CreateCommandList[{0}]: {1:X}", i, (unsigned long) result);
+                MenuOverlayBase::HideMenu();
+                CleanupRenderTargetDx12(true);
+                pSwapChain->Release();
+                return;
+            }
 
-        result = g_pd3dCommandList->Close();
-        if (result != S_OK)
-        {
-            LOG_ERROR("g_pd3dCommandList->Close: {0:X}", (unsigned long) result);
-            MenuOverlayBase::HideMenu();
-            CleanupRenderTargetDx12(false);
-            pSwapChain->Release();
-            return;
+            result = g_pd3dCommandLists[i]->Close();
+            if (result != S_OK)
+            {
+                LOG_ERROR("g_pd3dCommandLists[{0}]->Close: {1:X}", i, (unsigned long) result);
+                MenuOverlayBase::HideMenu();
+                CleanupRenderTargetDx12(false);
+                pSwapChain->Release();
+                return;
+            }
         }
 
         DXGI_SWAP_CHAIN_DESC scDesc;
@@ -442,53 +447,65 @@ static void RenderImGui_DX12(IDXGISwapChain* pSwapChainPlain)
                 ImGui::Render();
 
                 UINT backBufferIdx = pSwapChain->GetCurrentBackBufferIndex();
-                ID3D12CommandAllocator* commandAllocator = g_commandAllocators[backBufferIdx];
-
-                auto result = commandAllocator->Reset();
-                if (result != S_OK)
-                {
-                    LOG_ERROR("commandAllocator->Reset: {0:X}", (unsigned long) result);
-                    CleanupRenderTargetDx12(false);
-                    pSwapChain->Release();
-                    return;
-                }
-
-                D3D12_RESOURCE_BARRIER barrier = {};
-                barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-                barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-                barrier.Transition.pResource = g_mainRenderTargetResource[backBufferIdx];
-                barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-                barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_PRESENT;
-                barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_RENDER_TARGET;
-
-                result = g_pd3dCommandList->Reset(commandAllocator, nullptr);
-                if (result != S_OK)
-                {
-                    LOG_ERROR("g_pd3dCommandList->Reset: {0:X}", (unsigned long) result);
-                    pSwapChain->Release();
-                    return;
-                }
-
-                g_pd3dCommandList->ResourceBarrier(1, &barrier);
-                g_pd3dCommandList->OMSetRenderTargets(1, &g_mainRenderTargetDescriptor[backBufferIdx], FALSE, NULL);
-                g_pd3dCommandList->SetDescriptorHeaps(1, &g_pd3dSrvDescHeap);
-
-                ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), g_pd3dCommandList);
+                ID3D12GraphicsCommandList* commandList = g_pd3dCommandLists[backBufferIdx];
+                auto generation = MenuOverlayBase::UiGeneration();
 
-                barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;
-                barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PRESENT;
-                g_pd3dCommandList->ResourceBarrier(1, &barrier);
-
-                result = g_pd3dCommandList->Close();
-                if (result != S_OK)
+                // Menu wasn't rebuilt since this backbuffer's list was recorded, execute it again
+                if (!g_drawCache.CanReplay(backBufferIdx, generation))
                 {
-                    LOG_ERROR("g_pd3dCommandList->Close: {0:X}", (unsigned long) result);
-                    CleanupRenderTargetDx12(true);
-                    pSwapChain->Release();
-                    return;
+                    g_drawCache.Invalidate(backBufferIdx);
+
+                    ID3D12CommandAllocator* commandAllocator = g_commandAllocators[backBufferIdx];
+
+                    auto result = commandAllocator->Reset();
+                    if (result != S_OK)
+                    {
+                        LOG_ERROR("commandAllocator->Reset: {0:X}", (unsigned long) result);
+                        CleanupRenderTargetDx12(false);
+                        pSwapChain->Release();
+                        return;
+                    }
+
+                    D3D12_RESOURCE_BARRIER barrier = {};
+                    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+                    barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+                    barrier.Transition.pResource = g_mainRenderTargetResource[backBufferIdx];
+                    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+                    barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_PRESENT;
+                    barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_RENDER_TARGET;
+
+                    result = commandList->Reset(commandAllocator, nullptr);
+                    if (result != S_OK)
+                    {
+                        LOG_ERROR("commandList->Reset: {0:X}", (unsigned long) result);
+                        pSwapChain->Release();
+                        return;
+                    }
+
+                    commandList->ResourceBarrier(1, &barrier);
+                    commandList->OMSetRenderTargets(1, &g_mainRenderTargetDescriptor[backBufferIdx], FALSE, NULL);
+                    commandList->SetDescriptorHeaps(1, &g_pd3dSrvDescHeap);
+
+                    // Buffers of this backbuffer stay untouched until its list is recorded again
+                    ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), commandList, backBufferIdx);
+
+                    barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;
+                    barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PRESENT;
+                    commandList->ResourceBarrier(1, &barrier);
+
+                    result = commandList->Close();
+                    if (result != S_OK)
+                    {
+                        LOG_ERROR("commandList->Close: {0:X}", (unsigned long) result);
+                        CleanupRenderTargetDx12(true);
+                        pSwapChain->Release();
+                        return;
+                    }
+
+                    g_drawCache.Recorded(backBufferIdx, generation);
                 }
 
-                ID3D12CommandList* ppCommandLists[] = { g_pd3dCommandList };
+                ID3D12CommandList* ppCommandLists[] = { commandList };
                 ((ID3D12CommandQueue*) currentSCCommandQueue)->ExecuteCommandLists(1, ppCommandLists);
             }
         }
@@ -505,7 +522,19 @@ static void RenderImGui_DX12(IDXGISwapChain* pSwapChainPlain)
     pSwapChain->Release();
 }
 
-ID3D12GraphicsCommandList* MenuOverlayDx::MenuCommandList() { return g_pd3dCommandList; }
+bool MenuOverlayDx::IsMenuCommandList(ID3D12GraphicsCommandList* commandList)
+{
+    if (commandList == nullptr)
+        return false;
+
+    for (auto menuList : g_pd3dCommandLists)
+    {
+        if (menuList == commandList)
+            return true;
+    }
+
+    return false;
+}
 
 void MenuOverlayDx::CleanupRenderTarget(bool clearQueue, HWND hWnd)
 {
@@ -7,7 +7,7 @@
 
 namespace MenuOverlayDx
 {
-ID3D12GraphicsCommandList* MenuCommandList();
+bool IsMenuCommandList(ID3D12GraphicsCommandList* commandList);
 void CleanupRenderTarget(bool clearQueue, HWND hWnd);
 void Present(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Flags,
              const DXGI_PRESENT_PARAMETERS* pPresentParameters, IUnknown* pDevice, HWND hWnd, bool isUWP);
@@ -1,6 +1,7 @@
 #include "pch.h"
 #include "menu_overlay_base.h"
 #include "menu_overlay_vk.h"
+#include "menu_draw_cache.h"
 
 #include <Util.h>
 #include <Config.h>
@@ -26,6 +27,7 @@ static VkSemaphore* _ImVulkan_Semaphores = VK_NULL_HANDLE;
 static VkRenderPass _vkRenderPass = VK_NULL_HANDLE;
 static uint32_t _scImageCount;
 static ULONG64 _frameCount;
+static MenuDrawCache _drawCache;
 
 static void SetVkObjectName(VkDevice device, VkInstance instance, VkObjectType objectType, uint64_t objectHandle,
                             const char* name)
@@ -494,6 +496,7 @@ void MenuOverlayVk::DestroyVulkanObjects(bool shutdown)
     }
 
     _ImVulkan_Info = {};
+    _drawCache.Clear();
 
     _vkCleanMutex.unlock();
 }
@@ -538,34 +541,50 @@ bool MenuOverlayVk::QueuePresent(VkQueue queue, VkPresentInfoKHR* pPresentInfo)
                 vkWaitForFences(_ImVulkan_Info.Device, 1, &fd->Fence, VK_TRUE, UINT64_MAX);
                 vkResetFences(_ImVulkan_Info.Device, 1, &fd->Fence);
 
-                {
-                    vkResetCommandPool(_ImVulkan_Info.Device, fd->CommandPool, 0);
-                    VkCommandBufferBeginInfo info = {};
-                    info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-                    info.flags |= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-                    vkBeginCommandBuffer(fd->CommandBuffer, &info);
-                }
+                auto generation = MenuOverlayBase::UiGeneration();
 
+                // Menu wasn't rebuilt since this image's command buffer was recorded, submit it again
+                if (_drawCache.CanReplay(idx, generation))
                 {
-                    VkRenderPassBeginInfo info = {};
-                    info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-                    info.renderPass = _vkRenderPass;
-                    info.framebuffer = fd->Framebuffer;
-                    info.renderArea.extent.width = static_cast<uint32_t>(ImGui::GetIO().DisplaySize.x);
-                    info.renderArea.extent.height = static_cast<uint32_t>(ImGui::GetIO().DisplaySize.y);
-                    vkCmdBeginRenderPass(fd->CommandBuffer, &info, VK_SUBPASS_CONTENTS_INLINE);
+                    // To make RenderMenu happy as it expects this
+                    ImGui::Render();
                 }
-
-                ImGui::Render();
-                ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), fd->CommandBuffer);
-
-                // Submit command buffer
-                vkCmdEndRenderPass(fd->CommandBuffer);
-                auto ecbResult = vkEndCommandBuffer(fd->CommandBuffer);
-                if (ecbResult != VK_SUCCESS)
+                else
                 {
-                    LOG_ERROR("vkQueueSubmit error: {0:X}", (UINT) ecbResult);
-                    return false;
+                    _drawCache.Invalidate(idx);
+
+                    {
+                        // Not one time submit, it's submitted again while the menu doesn't change
+                        vkResetCommandPool(_ImVulkan_Info.Device, fd->CommandPool, 0);
+                        VkCommandBufferBeginInfo info = {};
+                        info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+                        vkBeginCommandBuffer(fd->CommandBuffer, &info);
+                    }
+
+                    {
+                        VkRenderPassBeginInfo info = {};
+                        info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+                        info.renderPass = _vkRenderPass;
+                        info.framebuffer = fd->Framebuffer;
+                        info.renderArea.extent.width = static_cast<uint32_t>(ImGui::GetIO().DisplaySize.x);
+                        info.renderArea.extent.height = static_cast<uint32_t>(ImGui::GetIO().DisplaySize.y);
+                        vkCmdBeginRenderPass(fd->CommandBuffer, &info, VK_SUBPASS_CONTENTS_INLINE);
+                    }
+
+                    // Buffers of this image stay untouched until its command buffer is recorded again
+                    ImGui::Render();
+                    ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), fd->CommandBuffer, VK_NULL_HANDLE, idx);
+
+                    // Submit command buffer
+                    vkCmdEndRenderPass(fd->CommandBuffer);
+                    auto ecbResult = vkEndCommandBuffer(fd->CommandBuffer);
+                    if (ecbResult != VK_SUCCESS)
+                    {
+                        LOG_ERROR("vkQueueSubmit error: {0:X}", (UINT) ecbResult);
+                        return false;
+                    }
+
+                    _drawCache.Recorded(idx, generation);
                 }
 
                 // Submit queue and semaphores
@@ -0,0 +1,168 @@
+#include "pch.h"
+#include "ApiCapture.h"
+
+#include <NVNGX_Parameter.h>
+#include <Util.h>
+
+template <typename T> static void Append(std::vector<uint8_t>& out, T value)
+{
+    auto bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+ApiCapture::CallRecord::CallRecord(ApiCaptureEvent event, uint32_t handleId, NVSDK_NGX_Parameter* params,
+                                   uint32_t featureId)
+    : _event(event), _handleId(handleId)
+{
+    if (!ApiCapture::IsActive())
+        return;
+
+    _active = true;
+
+    if (_event == ApiCaptureEvent::CreateFeature)
+        Append(_payload, featureId);
+
+    if (_event != ApiCaptureEvent::Release)
+        ApiCapture::WriteParameters(_payload, params);
+
+    _start = Util::MillisecondsNow();
+}
+
+void ApiCapture::CallRecord::End(NVSDK_NGX_Result result)
+{
+    if (!_active)
+        return;
+
+    _active = false;
+    ApiCapture::Write(_event, _handleId, Util::MillisecondsNow() - _start, result, _payload);
+}
+
+bool ApiCapture::IsActive() { return Config::Instance()->ApiCaptureEnabled.value_or_default() && !_finished; }
+
+bool ApiCapture::Open()
+{
+    if (_opened)
+        return _file.is_open();
+
+    _opened = true;
+
+    auto path = Util::DllPath().parent_path() / "optiscaler_capture.ocap";
+    _file.open(path, std::ios::binary | std::ios::trunc);
+
+    if (!_file.is_open())
+    {
+        LOG_ERROR("Can't open capture file: {}", path.string());
+        _finished = true;
+        return false;
+    }
+
+    const char magic[8] = "OPTICAP";
+    _file.write(magic, sizeof(magic));
+
+    uint32_t header[2] = { Version, 0 };
+    _file.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+    _startTime = Util::MillisecondsNow();
+
+    LOG_INFO("Capturing NGX calls to: {}", path.string());
+
+    return true;
+}
+
+void ApiCapture::WriteParameters(std::vector<uint8_t>& out, NVSDK_NGX_Parameter* params)
+{
+    uint32_t allocType = NGX_AllocTypes::Unknown;
+
+    // Only our own tables can be enumerated
+    if (params == nullptr || params->Get(NGX_AllocTypes::AllocKey.data(), &allocType) != NVSDK_NGX_Result_Success ||
+        (allocType != NGX_AllocTypes::InternDynamic && allocType != NGX_AllocTypes::InternPersistent))
+    {
+        Append(out, (uint32_t) 0);
+        return;
+    }
+
+    auto values = static_cast<NVNGX_Parameters*>(params)->snapshot();
+    Append(out, (uint32_t) values.size());
+
+    for (auto& [key, value] : values)
+    {
+        auto keyLength = (uint16_t) std::min<size_t>(key.size(), UINT16_MAX);
+        Append(out, keyLength);
+        out.insert(out.end(), key.begin(), key.begin() + keyLength);
+
+        ApiCaptureValue type = ApiCaptureValue::Unknown;
+
+        if (value.key == typeid(float).hash_code())
+            type = ApiCaptureValue::Float;
+        else if (value.key == typeid(double).hash_code())
+            type = ApiCaptureValue::Double;
+        else if (value.key == typeid(int).hash_code())
+            type = ApiCaptureValue::Int;
+        else if (value.key == typeid(unsigned int).hash_code())
+            type = ApiCaptureValue::UInt;
+        else if (value.key == typeid(unsigned long long).hash_code())
+            type = ApiCaptureValue::ULongLong;
+        else if (value.key == typeid(void*).hash_code())
+            type = ApiCaptureValue::Pointer;
+        else if (value.key == typeid(ID3D11Resource*).hash_code())
+            type = ApiCaptureValue::Dx11Resource;
+        else if (value.key == typeid(ID3D12Resource*).hash_code())
+            type = ApiCaptureValue::Dx12Resource;
+
+        // Widest union member covers all types
+        uint64_t bits = 0;
+        memcpy(&bits, &value.values, std::min(sizeof(bits), sizeof(value.values)));
+
+        Append(out, (uint8_t) type);
+        Append(out, bits);
+
+        if (type == ApiCaptureValue::Dx12Resource)
+        {
+            D3D12_RESOURCE_DESC desc {};
+
+            if (value.values.d12r != nullptr)
+                desc = value.values.d12r->GetDesc();
+
+            Append(out, (uint32_t) desc.Dimension);
+            Append(out, (uint64_t) desc.Width);
+            Append(out, (uint32_t) desc.Height);
+            Append(out, (uint16_t) desc.DepthOrArraySize);
+            Append(out, (uint16_t) desc.MipLevels);
+            Append(out, (uint32_t) desc.Format);
+            Append(out, (uint32_t) desc.Flags);
+        }
+    }
+}
+
+void ApiCapture::Write(ApiCaptureEvent event, uint32_t handleId, double callMs, NVSDK_NGX_Result result,
+                       const std::vector<uint8_t>& payload)
+{
+    std::scoped_lock lock(_mutex);
+
+    if (_finished || !Open())
+        return;
+
+    std::vector<uint8_t> record;
+    record.reserve(payload.size() + 32);
+
+    Append(record, (uint8_t) event);
+    Append(record, handleId);
+    Append(record, (uint64_t) ((Util::MillisecondsNow() - _startTime) * 1000000.0));
+    Append(record, (float) callMs);
+    Append(record, (int32_t) result);
+    Append(record, (uint32_t) payload.size());
+    record.insert(record.end(), payload.begin(), payload.end());
+
+    _file.write(reinterpret_cast<const char*>(record.data()), record.size());
+
+    if (event == ApiCaptureEvent::Evaluate && ++_evaluates >= MaxEvaluates)
+    {
+        _file.close();
+        _finished = true;
+        LOG_INFO("Capture finished after {} evaluates", _evaluates);
+    }
+    else if (event != ApiCaptureEvent::Evaluate)
+    {
+        _file.flush();
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include "SysUtils.h"
+
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+enum class ApiCaptureEvent : uint8_t
+{
+    CreateFeature = 1,
+    Evaluate = 2,
+    Release = 3,
+};
+
+enum class ApiCaptureValue : uint8_t
+{
+    Unknown = 0,
+    Float = 1,
+    Double = 2,
+    Int = 3,
+    UInt = 4,
+    ULongLong = 5,
+    Pointer = 6,      // void*, only the address is stored
+    Dx11Resource = 7, // only the address is stored
+    Dx12Resource = 8, // address + D3D12_RESOURCE_DESC fields
+};
+
+// Binary capture of NGX Dx12 CreateFeature/Evaluate/Release calls, every input layer
+// (NVNGX, FSR2/3, FFX API, XeSS) ends up in these so parameters are captured after translation.
+// Enable it before starting the game, creates are needed to make sense of the evaluates.
+// Capture stops after MaxEvaluates evaluate calls, file is flushed after every create/release.
+//
+// File layout (little endian)
+//   Header : char[8] "OPTICAP", uint32 version, uint32 reserved
+//   Record : uint8 event, uint32 handleId, uint64 timeNs (since capture start), float callMs, int32 result,
+//            uint32 payloadSize, payload
+//   Create payload   : uint32 featureId, parameters
+//   Evaluate payload : parameters
+//   Release payload  : empty
+//   Parameters : uint32 count, count x { uint16 keyLength, key, uint8 ApiCaptureValue, uint64 value }
+//                Dx12Resource values are followed by uint32 dimension, uint64 width, uint32 height,
+//                uint16 depthOrArraySize, uint16 mipLevels, uint32 format, uint32 flags
+class ApiCapture
+{
+  public:
+    static constexpr uint32_t Version = 1;
+    static constexpr uint32_t MaxEvaluates = 3600;
+
+    // Parameters are snapshotted before the call, written with result & timing after it
+    class CallRecord
+    {
+      private:
+        bool _active = false;
+        ApiCaptureEvent _event;
+        uint32_t _handleId = 0;
+        double _start = 0.0;
+        std::vector<uint8_t> _payload;
+
+      public:
+        CallRecord(ApiCaptureEvent event, uint32_t handleId, NVSDK_NGX_Parameter* params, uint32_t featureId = 0);
+
+        void SetHandleId(uint32_t handleId) { _handleId = handleId; }
+        void End(NVSDK_NGX_Result result);
+    };
+
+    static bool IsActive();
+
+  private:
+    inline static std::mutex _mutex;
+    inline static std::ofstream _file;
+    inline static bool _opened = false;
+    inline static std::atomic<bool> _finished { false };
+    inline static uint32_t _evaluates = 0;
+    inline static double _startTime = 0.0;
+
+    static bool Open();
+    static void WriteParameters(std::vector<uint8_t>& out, NVSDK_NGX_Parameter* params);
+    static void Write(ApiCaptureEvent event, uint32_t handleId, double callMs, NVSDK_NGX_Result result,
+                      const std::vector<uint8_t>& payload);
+};
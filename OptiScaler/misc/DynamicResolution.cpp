@@ -0,0 +1,226 @@
+#include "pch.h"
+#include "DynamicResolution.h"
+
+#include <Config.h>
+#include <State.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+// Frames longer than this are loading screens or pauses, not GPU load
+static constexpr double MaxFrameTimeMs = 250.0;
+
+// Part of the frame time which scales with render pixels is never assumed below this
+static constexpr double MinScalingShare = 0.1;
+
+// 0.0 when the live controller is not running
+static std::atomic<float> liveRatio { 0.0f };
+
+// 0.0 until the game queried optimal settings
+static std::atomic<float> advertisedMinRatio { 0.0f };
+static std::atomic<float> advertisedMaxRatio { 0.0f };
+
+void DynamicResolution::Reset(const DynamicResolutionParams& params)
+{
+    _params = params;
+    _ratio = std::clamp(params.InitialRatio, params.MinRatio, params.MaxRatio);
+    _lastMedianMs = 0.0;
+    _settle = SettleFrames;
+    _changes = 0;
+    _waitingFrames = 0;
+
+    // Initial ratio is a request too, game might still render at the size it picked before
+    _applied = false;
+
+    _frameTimes.clear();
+    _frameTimes.reserve(WindowSize);
+    _upscaleTimes.clear();
+    _upscaleTimes.reserve(WindowSize);
+}
+
+double DynamicResolution::Median(std::vector<double>& values)
+{
+    auto middle = values.begin() + values.size() / 2;
+    std::nth_element(values.begin(), middle, values.end());
+    return *middle;
+}
+
+void DynamicResolution::SetRange(float minRatio, float maxRatio)
+{
+    if (minRatio <= 0.0f || maxRatio < minRatio)
+        return;
+
+    _params.MinRatio = minRatio;
+    _params.MaxRatio = maxRatio;
+
+    // Clamped ratio is a new request for the game
+    if (auto clamped = std::clamp(_ratio, minRatio, maxRatio); clamped != _ratio)
+    {
+        _ratio = clamped;
+        _applied = false;
+        _waitingFrames = 0;
+    }
+}
+
+std::optional<float> DynamicResolution::AddFrame(double frameTimeMs, double upscaleTimeMs, float observedRatio)
+{
+    if (frameTimeMs <= 0.0 || frameTimeMs > MaxFrameTimeMs)
+        return std::nullopt;
+
+    // Frame times don't tell anything about the requested ratio until the game renders at it
+    if (!_applied)
+    {
+        if (observedRatio <= 0.0f || std::abs(observedRatio / _ratio - 1.0f) <= AppliedTolerance)
+        {
+            _applied = true;
+        }
+        else if (++_waitingFrames >= ApplyTimeoutFrames)
+        {
+            LOG_DEBUG("Ratio {:.2f} not applied by the game, continuing from {:.2f}", _ratio, observedRatio);
+            _ratio = std::clamp(observedRatio, _params.MinRatio, _params.MaxRatio);
+            _applied = true;
+        }
+        else
+        {
+            return std::nullopt;
+        }
+    }
+
+    if (_settle > 0)
+    {
+        _settle--;
+        return std::nullopt;
+    }
+
+    _frameTimes.push_back(frameTimeMs);
+    _upscaleTimes.push_back(std::max(upscaleTimeMs, 0.0));
+
+    if (_frameTimes.size() < WindowSize)
+        return std::nullopt;
+
+    auto frameMs = Median(_frameTimes);
+    auto upscaleMs = Median(_upscaleTimes);
+    _frameTimes.clear();
+    _upscaleTimes.clear();
+
+    _lastMedianMs = frameMs;
+
+    double target = _params.TargetFrameTimeMs;
+
+    if (frameMs <= target * (1.0 + Hysteresis) && frameMs >= target * (1.0 - Hysteresis))
+        return std::nullopt;
+
+    // Render cost scales with pixel count, which is 1 / ratio^2
+    auto scalingMs = std::max(frameMs - upscaleMs, frameMs * MinScalingShare);
+    auto targetScalingMs = std::max(target - upscaleMs, target * MinScalingShare);
+    auto wanted = _ratio * (float) std::sqrt(scalingMs / targetScalingMs);
+
+    wanted = std::clamp(wanted, _ratio - MaxStep, _ratio + MaxStep);
+
+    // Rounded steps can land an ulp outside of the range, clamp comes last
+    wanted = std::round(wanted / RatioStep) * RatioStep;
+    wanted = std::clamp(wanted, _params.MinRatio, _params.MaxRatio);
+
+    if (std::abs(wanted - _ratio) < RatioStep * 0.5f)
+        return std::nullopt;
+
+    LOG_DEBUG("Frame time: {:.2f} ms, upscaler: {:.2f} ms, target: {:.2f} ms, ratio: {:.2f} -> {:.2f}", frameMs,
+              upscaleMs, target, _ratio, wanted);
+
+    _ratio = wanted;
+    _settle = SettleFrames;
+    _changes++;
+    _applied = false;
+    _waitingFrames = 0;
+
+    return _ratio;
+}
+
+void DynamicResolution::OnPresent(bool interpolated)
+{
+    static std::optional<DynamicResolution> live;
+    static double pendingFrameTimeMs = 0.0;
+
+    auto& cfg = *Config::Instance();
+    auto& state = State::Instance();
+
+    if (!cfg.DynamicResolution.value_or_default() || state.currentFeature == nullptr)
+    {
+        if (live.has_value())
+        {
+            LOG_INFO("Dynamic resolution stopped after {} changes", live->Changes());
+            live.reset();
+            liveRatio = 0.0f;
+        }
+
+        return;
+    }
+
+    if (!live.has_value())
+    {
+        DynamicResolutionParams params {};
+        params.TargetFrameTimeMs = cfg.DynamicResolutionTargetMs.value_or_default();
+
+        // DLSS normally only supports DRS in range of 0.5 and 1.0, narrowed to what the game was told below
+        params.MaxRatio = 2.0f;
+
+        live.emplace(params);
+        pendingFrameTimeMs = 0.0;
+
+        LOG_INFO("Dynamic resolution started, target: {:.2f} ms, ratio: {:.2f} - {:.2f}", params.TargetFrameTimeMs,
+                 params.MinRatio, params.MaxRatio);
+    }
+
+    // Published ratio always comes from the controller, so range changes and resyncs show up right away
+    if (auto minRatio = advertisedMinRatio.load(); minRatio > 0.0f)
+        live->SetRange(minRatio, advertisedMaxRatio.load());
+
+    liveRatio = live->Ratio();
+
+    double upscaleTimeMs = 0.0;
+
+    {
+        std::scoped_lock lock(state.frameTimeMutex);
+
+        if (!state.frameTimes.empty())
+            pendingFrameTimeMs += state.frameTimes.back();
+
+        if (!state.upscaleTimes.empty())
+            upscaleTimeMs = state.upscaleTimes.back();
+    }
+
+    // Interpolated presents split a real frame, their intervals are summed up
+    if (interpolated)
+        return;
+
+    float observedRatio = 0.0f;
+    auto feature = state.currentFeature;
+
+    if (feature->RenderWidth() > 0)
+        observedRatio = (float) feature->DisplayWidth() / (float) feature->RenderWidth();
+
+    auto ratio = live->AddFrame(pendingFrameTimeMs, upscaleTimeMs, observedRatio);
+    pendingFrameTimeMs = 0.0;
+
+    liveRatio = live->Ratio();
+
+    if (ratio.has_value())
+        LOG_INFO("Dynamic resolution ratio: {:.2f}, median frame time: {:.2f} ms", ratio.value(), live->LastMedianMs());
+}
+
+void DynamicResolution::SetAdvertisedRange(float minRatio, float maxRatio)
+{
+    advertisedMaxRatio = maxRatio;
+    advertisedMinRatio = minRatio;
+}
+
+std::optional<float> DynamicResolution::LiveRatio()
+{
+    auto ratio = liveRatio.load();
+
+    if (ratio <= 0.0f)
+        return std::nullopt;
+
+    return ratio;
+}
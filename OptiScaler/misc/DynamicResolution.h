@@ -0,0 +1,74 @@
+#pragma once
+#include "SysUtils.h"
+
+#include <optional>
+#include <vector>
+
+// Ratios are display size / render size, same as UpscaleRatioOverrideValue
+struct DynamicResolutionParams
+{
+    float TargetFrameTimeMs = 16.667f;
+    float MinRatio = 1.0f; // Highest render resolution
+    float MaxRatio = 2.0f; // Lowest render resolution
+    float InitialRatio = 1.5f;
+};
+
+// Closed loop render resolution controller. Collects frame & upscaler times over a window,
+// when the median frame time leaves the band around the target it estimates the ratio which hits the target.
+// Upscaler time depends on the display size so it is kept out of the part which scales with render pixels.
+// Doesn't touch any global state, so recorded frame time traces can be replayed through AddFrame.
+class DynamicResolution
+{
+  public:
+    static constexpr uint32_t WindowSize = 30;
+    static constexpr uint32_t SettleFrames = 10; // Game applies the new size a few frames later
+
+    // Median frame time inside target +/- Hysteresis is left alone
+    static constexpr double Hysteresis = 0.05;
+
+    static constexpr float MaxStep = 0.1f;
+    static constexpr float RatioStep = 0.01f;
+
+    // Render size the game uses has to match the last request before the next step is taken.
+    // A game which doesn't follow (no re-query of optimal settings) is resynced after ApplyTimeoutFrames
+    static constexpr float AppliedTolerance = 0.02f;
+    static constexpr uint32_t ApplyTimeoutFrames = 120;
+
+    explicit DynamicResolution(const DynamicResolutionParams& params) { Reset(params); }
+
+    void Reset(const DynamicResolutionParams& params);
+
+    // frameTimeMs is the time of a real (not interpolated) frame, observedRatio is display / render size of it
+    // (0 when unknown, requests are assumed to be applied then). Returns the new ratio when it should be applied.
+    std::optional<float> AddFrame(double frameTimeMs, double upscaleTimeMs, float observedRatio = 0.0f);
+
+    // Keeps the ratio inside the DRS range reported to the game
+    void SetRange(float minRatio, float maxRatio);
+
+    float Ratio() const { return _ratio; }
+    double LastMedianMs() const { return _lastMedianMs; }
+    uint32_t Changes() const { return _changes; }
+
+    // Live control from the present path, ratio is picked up by the NGX optimal settings callbacks
+    static void OnPresent(bool interpolated);
+
+    // Ratio of the live controller, empty when it's not running
+    static std::optional<float> LiveRatio();
+
+    // DRS range reported by the optimal settings callbacks as display / render size
+    static void SetAdvertisedRange(float minRatio, float maxRatio);
+
+  private:
+    static double Median(std::vector<double>& values);
+
+    DynamicResolutionParams _params {};
+    float _ratio = 1.0f;
+    double _lastMedianMs = 0.0;
+    uint32_t _settle = 0;
+    uint32_t _changes = 0;
+    bool _applied = true;
+    uint32_t _waitingFrames = 0;
+
+    std::vector<double> _frameTimes;
+    std::vector<double> _upscaleTimes;
+};
@@ -3,11 +3,9 @@
 
 class FrameLimit
 {
-    static uint64_t get_timestamp();
-    static int timer_sleep(int64_t hundred_ns);
-    static int busywait_sleep(int64_t ns);
-    static int combined_sleep(int64_t ns);
-
   public:
     static void sleep(bool fgActive);
+
+    // Limiter body with caller owned state, previousFrameTime is in ns
+    static void sleep(bool fgActive, float fpsCap, uint64_t& previousFrameTime);
 };
@@ -0,0 +1,291 @@
+#include "pch.h"
+#include "GameProfiles.h"
+
+#include <SimpleIni.h>
+#include <magic_enum.hpp>
+
+#include <fstream>
+#include <sstream>
+
+static std::string Trim(std::string_view text)
+{
+    auto begin = text.find_first_not_of(" \t");
+
+    if (begin == std::string_view::npos)
+        return {};
+
+    auto end = text.find_last_not_of(" \t");
+    return std::string(text.substr(begin, end - begin + 1));
+}
+
+static std::vector<std::string> Split(const std::string& text)
+{
+    std::vector<std::string> result;
+    std::stringstream stream(text);
+    std::string item;
+
+    while (std::getline(stream, item, '|'))
+    {
+        item = Trim(item);
+
+        if (!item.empty())
+            result.push_back(item);
+    }
+
+    return result;
+}
+
+std::string GameProfiles::MatchKey(std::string_view exe, std::string_view version, std::string_view hash)
+{
+    if (!hash.empty())
+        return std::string(exe) + "|h:" + std::string(hash);
+
+    if (!version.empty())
+        return std::string(exe) + "|v:" + std::string(version);
+
+    return std::string(exe);
+}
+
+bool GameProfiles::ParseQuirks(const std::string& text, flag_set<GameQuirk>& quirks, const std::string& profile)
+{
+    bool result = true;
+
+    for (const auto& name : Split(text))
+    {
+        auto quirk = magic_enum::enum_cast<GameQuirk>(name, magic_enum::case_insensitive);
+
+        if (!quirk.has_value() || quirk.value() == GameQuirk::_)
+        {
+            LOG_WARN("Profile {}: unknown quirk {}", profile, name);
+            result = false;
+            continue;
+        }
+
+        quirks |= quirk.value();
+    }
+
+    return result;
+}
+
+std::string GameProfiles::QuirksToText(flag_set<GameQuirk> quirks)
+{
+    std::string result;
+
+    for (auto quirk : magic_enum::enum_values<GameQuirk>())
+    {
+        if (quirk == GameQuirk::_ || !(quirks & quirk))
+            continue;
+
+        if (!result.empty())
+            result += "|";
+
+        result += magic_enum::enum_name(quirk);
+    }
+
+    return result;
+}
+
+bool GameProfiles::Load(std::string_view data, std::string_view source)
+{
+    CSimpleIniA ini;
+
+    if (ini.LoadData(data.data(), data.size()) != SI_OK)
+    {
+        LOG_ERROR("Can't parse game profiles: {}", source);
+        return false;
+    }
+
+    auto version = ini.GetLongValue("GameProfiles", "Version", 0);
+
+    if (version == 0 || version > Version)
+    {
+        LOG_ERROR("Game profiles {} have version {}, supported version is {}", source, version, Version);
+        return false;
+    }
+
+    CSimpleIniA::TNamesDepend sections;
+    ini.GetAllSections(sections);
+    sections.sort(CSimpleIniA::Entry::LoadOrder());
+
+    size_t loaded = 0;
+
+    for (const auto& section : sections)
+    {
+        if (lstrcmpiA(section.pItem, "GameProfiles") == 0)
+            continue;
+
+        GameProfile profile {};
+        profile.Name = section.pItem;
+        profile.Source = source;
+
+        CSimpleIniA::TNamesDepend keys;
+        ini.GetAllKeys(section.pItem, keys);
+        keys.sort(CSimpleIniA::Entry::LoadOrder());
+
+        for (const auto& key : keys)
+        {
+            std::string name = key.pItem;
+            std::string value = Trim(ini.GetValue(section.pItem, key.pItem, ""));
+
+            if (lstrcmpiA(key.pItem, "Exe") == 0)
+            {
+                profile.Exes = Split(value);
+
+                for (auto& exe : profile.Exes)
+                    to_lower_in_place(exe);
+            }
+            else if (lstrcmpiA(key.pItem, "ProductVersion") == 0)
+            {
+                profile.ProductVersion = value;
+            }
+            else if (lstrcmpiA(key.pItem, "SHA1") == 0)
+            {
+                profile.Hash = value;
+                to_lower_in_place(profile.Hash);
+            }
+            else if (lstrcmpiA(key.pItem, "Quirks") == 0)
+            {
+                ParseQuirks(value, profile.Quirks, profile.Name);
+            }
+            else if (lstrcmpiA(key.pItem, "DisabledQuirks") == 0)
+            {
+                ParseQuirks(value, profile.DisabledQuirks, profile.Name);
+            }
+            else if (name.find('.') != std::string::npos)
+            {
+                profile.Options.push_back({ name, value });
+            }
+            else
+            {
+                LOG_WARN("Profile {}: unknown key {}", profile.Name, name);
+            }
+        }
+
+        if (profile.Exes.empty())
+        {
+            LOG_WARN("Profile {} has no Exe, skipping", profile.Name);
+            continue;
+        }
+
+        size_t index = _profiles.size();
+        _profiles.push_back(std::move(profile));
+
+        auto& added = _profiles.back();
+
+        for (const auto& exe : added.Exes)
+        {
+            _index[MatchKey(exe, added.ProductVersion, added.Hash)] = index;
+
+            if (!added.Hash.empty())
+                _hashedExes.insert(exe);
+        }
+
+        loaded++;
+    }
+
+    LOG_INFO("Loaded {} game profiles from {}", loaded, source);
+    return true;
+}
+
+bool GameProfiles::LoadFile(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file.is_open())
+        return false;
+
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return Load(data, wstring_to_string(path.filename().wstring()));
+}
+
+const GameProfile* GameProfiles::Find(std::string exeName, const std::string& productVersion,
+                                      const std::function<std::string()>& hash) const
+{
+    if (_index.empty())
+        return nullptr;
+
+    to_lower_in_place(exeName);
+
+    if (hash && _hashedExes.contains(exeName))
+    {
+        auto exeHash = hash();
+        to_lower_in_place(exeHash);
+
+        if (!exeHash.empty())
+        {
+            if (auto it = _index.find(MatchKey(exeName, "", exeHash)); it != _index.end())
+                return &_profiles[it->second];
+        }
+    }
+
+    // 1.2.3.4 -> 1.2.3 -> 1.2 -> 1
+    std::string_view version = productVersion;
+
+    while (!version.empty())
+    {
+        if (auto it = _index.find(MatchKey(exeName, version, "")); it != _index.end())
+            return &_profiles[it->second];
+
+        auto dot = version.find_last_of('.');
+
+        if (dot == std::string_view::npos)
+            break;
+
+        version = version.substr(0, dot);
+    }
+
+    if (auto it = _index.find(MatchKey(exeName, "", "")); it != _index.end())
+        return &_profiles[it->second];
+
+    return nullptr;
+}
+
+bool GameProfiles::Export(const std::filesystem::path& path, const GameProfile& profile)
+{
+    CSimpleIniA ini;
+
+    if (std::filesystem::exists(path) && ini.LoadFile(path.wstring().c_str()) != SI_OK)
+    {
+        LOG_ERROR("Can't load {} for exporting the profile", wstring_to_string(path.wstring()));
+        return false;
+    }
+
+    ini.SetLongValue("GameProfiles", "Version", Version);
+    ini.Delete(profile.Name.c_str(), nullptr);
+
+    std::string exes;
+
+    for (const auto& exe : profile.Exes)
+    {
+        if (!exes.empty())
+            exes += "|";
+
+        exes += exe;
+    }
+
+    ini.SetValue(profile.Name.c_str(), "Exe", exes.c_str());
+
+    if (!profile.ProductVersion.empty())
+        ini.SetValue(profile.Name.c_str(), "ProductVersion", profile.ProductVersion.c_str());
+
+    if (!profile.Hash.empty())
+        ini.SetValue(profile.Name.c_str(), "SHA1", profile.Hash.c_str());
+
+    if (auto quirks = QuirksToText(profile.Quirks); !quirks.empty())
+        ini.SetValue(profile.Name.c_str(), "Quirks", quirks.c_str());
+
+    if (auto quirks = QuirksToText(profile.DisabledQuirks); !quirks.empty())
+        ini.SetValue(profile.Name.c_str(), "DisabledQuirks", quirks.c_str());
+
+    for (const auto& [key, value] : profile.Options)
+        ini.SetValue(profile.Name.c_str(), key.c_str(), value.c_str());
+
+    if (ini.SaveFile(path.wstring().c_str()) != SI_OK)
+    {
+        LOG_ERROR("Can't save profile {} to {}", profile.Name, wstring_to_string(path.wstring()));
+        return false;
+    }
+
+    LOG_INFO("Profile {} exported to {}", profile.Name, wstring_to_string(path.wstring()));
+    return true;
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include "SysUtils.h"
+
+#include <misc/Quirks.h>
+
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <ankerl/unordered_dense.h>
+
+struct GameProfile
+{
+    std::string Name; // Ini section name
+    std::string Source;
+
+    // Matching, exe is required, others are optional
+    std::vector<std::string> Exes;
+    std::string ProductVersion; // Prefix match, "1.2" matches 1.2.x.x
+    std::string Hash;           // SHA1 of the exe
+
+    // "Section.Key" of OptiScaler.ini & value text
+    std::vector<std::pair<std::string, std::string>> Options;
+
+    flag_set<GameQuirk> Quirks;
+    flag_set<GameQuirk> DisabledQuirks; // Removed from built-in quirks of the exe
+};
+
+// Known good settings per game, loaded once at startup.
+// Profile values only fill the options which are not set in OptiScaler.ini, so the order is
+// OptiScaler.ini > game profile > built-in quirks > defaults.
+//
+// [GameProfiles]
+// Version=1
+//
+// [Some Game]
+// Exe=somegame.exe|somegame-win64-shipping.exe
+// ProductVersion=1.2
+// SHA1=...
+// Quirks=DisableHudfix|SkipFirst10Frames
+// DisabledQuirks=DisableDxgiSpoofing
+// FrameGen.AllowedFrameAhead=2
+class GameProfiles
+{
+  public:
+    static constexpr uint32_t Version = 1;
+
+    static constexpr const wchar_t* FileName = L"GameProfiles.ini";
+    static constexpr const wchar_t* UserFileName = L"GameProfiles.user.ini"; // Exports from menu, overrides FileName
+
+    static GameProfiles& Instance()
+    {
+        static GameProfiles* instance = new GameProfiles();
+        return *instance;
+    }
+
+    // Profiles with the same match keys as an earlier one replace it, so overrides should be loaded last
+    bool Load(std::string_view data, std::string_view source);
+    bool LoadFile(const std::filesystem::path& path);
+
+    // Most specific profile wins: exe & hash, exe & product version (longest prefix), exe only.
+    // Hashing the exe is slow, hash is only called when there is a hash keyed profile for the exe.
+    const GameProfile* Find(std::string exeName, const std::string& productVersion,
+                            const std::function<std::string()>& hash) const;
+
+    // Find & remember the profile of the running game
+    const GameProfile* Select(const std::string& exeName, const std::string& productVersion,
+                              const std::function<std::string()>& hash)
+    {
+        _active = Find(exeName, productVersion, hash);
+        return _active;
+    }
+
+    const GameProfile* Active() const { return _active; }
+    size_t Count() const { return _profiles.size(); }
+
+    // Writes (or replaces) a profile section into an ini file
+    static bool Export(const std::filesystem::path& path, const GameProfile& profile);
+
+    static std::string QuirksToText(flag_set<GameQuirk> quirks);
+
+  private:
+    std::vector<GameProfile> _profiles;
+    const GameProfile* _active = nullptr;
+
+    // Match key -> profile index
+    ankerl::unordered_dense::map<std::string, size_t> _index;
+
+    // Exes which have hash keyed profiles
+    ankerl::unordered_dense::set<std::string> _hashedExes;
+
+    static std::string MatchKey(std::string_view exe, std::string_view version, std::string_view hash);
+    static bool ParseQuirks(const std::string& text, flag_set<GameQuirk>& quirks, const std::string& profile);
+};
@@ -0,0 +1,210 @@
+#include "pch.h"
+#include "LatencyAnalytics.h"
+
+#include <magic_enum.hpp>
+
+#include <algorithm>
+
+// Stage times further than this many median absolute deviations from the median are outliers
+static constexpr double OutlierMadFactor = 4.0;
+static constexpr double OutlierMinDeltaMs = 1.0;
+
+// Frame intervals longer than this multiple of the median interval are stalls
+static constexpr double StallFactor = 2.5;
+
+static constexpr uint64_t LogInterval = 600;
+
+static double Median(std::vector<double>& samples)
+{
+    auto middle = samples.begin() + samples.size() / 2;
+    std::nth_element(samples.begin(), middle, samples.end());
+    return *middle;
+}
+
+static LatencyStageStats CalculateStats(std::vector<double> samples)
+{
+    LatencyStageStats stats {};
+
+    if (samples.empty())
+        return stats;
+
+    auto sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+
+    stats.P50Ms = sorted[(sorted.size() - 1) / 2];
+    stats.P99Ms = sorted[(size_t) (0.99 * (sorted.size() - 1))];
+    stats.MaxMs = sorted.back();
+
+    std::vector<double> deviations;
+    deviations.reserve(samples.size());
+
+    for (auto sample : samples)
+        deviations.push_back(std::abs(sample - stats.P50Ms));
+
+    auto limit = std::max(OutlierMadFactor * Median(deviations), OutlierMinDeltaMs);
+
+    for (auto sample : samples)
+    {
+        if (sample - stats.P50Ms > limit)
+            stats.Outliers++;
+    }
+
+    return stats;
+}
+
+uint32_t LatencyAnalytics::AddFrames(const std::vector<LatencyFrameTimes>& frames)
+{
+    std::scoped_lock lock(_mutex);
+
+    uint64_t newestFrameId = 0;
+
+    for (const auto& frame : frames)
+    {
+        if (frame.GpuRenderEnd != 0 && frame.FrameId > newestFrameId)
+            newestFrameId = frame.FrameId;
+    }
+
+    if (newestFrameId == 0)
+        return 0;
+
+    // Game restarted its frame ids (level load, swapchain recreation etc.)
+    if (newestFrameId < _lastFrameId)
+    {
+        LOG_DEBUG("Reflex frame ids went backwards ({} -> {}), resetting history", _lastFrameId, newestFrameId);
+
+        _count = 0;
+        _lastFrameId = 0;
+        _lastSimStart = 0;
+        _intervalCount = 0;
+    }
+
+    // Reports should be ordered but don't depend on it
+    std::vector<const LatencyFrameTimes*> ordered;
+    ordered.reserve(frames.size());
+
+    for (const auto& frame : frames)
+    {
+        // Skip empty slots, frames still in flight and frames we already have
+        if (frame.FrameId == 0 || frame.GpuRenderEnd == 0 || frame.FrameId <= _lastFrameId)
+            continue;
+
+        ordered.push_back(&frame);
+    }
+
+    std::sort(ordered.begin(), ordered.end(),
+              [](const LatencyFrameTimes* a, const LatencyFrameTimes* b) { return a->FrameId < b->FrameId; });
+
+    for (auto frame : ordered)
+    {
+        _history[_count % HistorySize] = *frame;
+        _count++;
+
+        if (_lastSimStart != 0 && frame->SimStart > _lastSimStart)
+        {
+            _intervalUs[_intervalCount % HistorySize] = frame->SimStart - _lastSimStart;
+            _intervalCount++;
+        }
+
+        _lastSimStart = frame->SimStart;
+        _lastFrameId = frame->FrameId;
+    }
+
+    if (ordered.empty())
+        return 0;
+
+    UpdateStats();
+
+    _framesSinceLog += ordered.size();
+
+    if (_framesSinceLog >= LogInterval)
+    {
+        _framesSinceLog = 0;
+
+        LOG_INFO("Reflex latency over {} frames, p50: {:.2f} ms, p99: {:.2f} ms, max: {:.2f} ms, stalls: {}, "
+                 "outliers: {}",
+                 _stats.Frames, _stats.Total.P50Ms, _stats.Total.P99Ms, _stats.Total.MaxMs, _stats.Stalls,
+                 _stats.Total.Outliers);
+
+        for (size_t i = 0; i < (size_t) LatencyStage::Count; i++)
+        {
+            const auto& stage = _stats.Stages[i];
+            LOG_DEBUG("  {}: p50: {:.2f} ms, p99: {:.2f} ms, max: {:.2f} ms, outliers: {}",
+                      magic_enum::enum_name((LatencyStage) i), stage.P50Ms, stage.P99Ms, stage.MaxMs,
+                      stage.Outliers);
+        }
+    }
+
+    return (uint32_t) ordered.size();
+}
+
+void LatencyAnalytics::UpdateStats()
+{
+    auto frameCount = (size_t) std::min<uint64_t>(_count, HistorySize);
+
+    LatencyStats stats {};
+    stats.Frames = (uint32_t) frameCount;
+    stats.LastFrameId = _lastFrameId;
+
+    std::vector<double> samples;
+    samples.reserve(frameCount);
+
+    for (size_t stage = 0; stage < (size_t) LatencyStage::Count; stage++)
+    {
+        samples.clear();
+
+        for (size_t i = 0; i < frameCount; i++)
+            samples.push_back(_history[i].StageUs[stage] / 1000.0);
+
+        stats.Stages[stage] = CalculateStats(samples);
+    }
+
+    samples.clear();
+
+    for (size_t i = 0; i < frameCount; i++)
+    {
+        const auto& frame = _history[i];
+
+        if (frame.GpuRenderEnd >= frame.SimStart)
+            samples.push_back((frame.GpuRenderEnd - frame.SimStart) / 1000.0);
+    }
+
+    stats.Total = CalculateStats(samples);
+
+    auto intervalCount = (size_t) std::min<uint64_t>(_intervalCount, HistorySize);
+
+    if (intervalCount > 0)
+    {
+        samples.clear();
+
+        for (size_t i = 0; i < intervalCount; i++)
+            samples.push_back(_intervalUs[i] / 1000.0);
+
+        stats.IntervalP50Ms = Median(samples);
+
+        for (size_t i = 0; i < intervalCount; i++)
+        {
+            if (_intervalUs[i] / 1000.0 > stats.IntervalP50Ms * StallFactor)
+                stats.Stalls++;
+        }
+    }
+
+    _stats = stats;
+}
+
+LatencyStats LatencyAnalytics::GetStats()
+{
+    std::scoped_lock lock(_mutex);
+    return _stats;
+}
+
+void LatencyAnalytics::Reset()
+{
+    std::scoped_lock lock(_mutex);
+
+    _count = 0;
+    _lastFrameId = 0;
+    _lastSimStart = 0;
+    _intervalCount = 0;
+    _framesSinceLog = 0;
+    _stats = {};
+}
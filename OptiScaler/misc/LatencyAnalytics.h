@@ -0,0 +1,105 @@
+#pragma once
+#include "SysUtils.h"
+
+#include <array>
+#include <mutex>
+#include <vector>
+
+enum class LatencyStage : uint32_t
+{
+    Simulation,
+    RenderSubmit,
+    Present,
+    Driver,
+    OsRenderQueue,
+    GpuRender,
+    Count
+};
+
+struct LatencyStageStats
+{
+    double P50Ms = 0.0;
+    double P99Ms = 0.0;
+    double MaxMs = 0.0;
+    uint32_t Outliers = 0;
+};
+
+struct LatencyStats
+{
+    uint32_t Frames = 0;
+    uint64_t LastFrameId = 0;
+    std::array<LatencyStageStats, (size_t) LatencyStage::Count> Stages {};
+
+    // Sim start to GPU render end
+    LatencyStageStats Total {};
+
+    // Frame interval (sim start to sim start)
+    double IntervalP50Ms = 0.0;
+    uint32_t Stalls = 0;
+};
+
+// Report timestamps are in microseconds
+struct LatencyFrameTimes
+{
+    uint64_t FrameId = 0;
+    uint64_t SimStart = 0;
+    uint64_t GpuRenderEnd = 0;
+    std::array<uint64_t, (size_t) LatencyStage::Count> StageUs {};
+};
+
+// Rolling latency statistics from Reflex frame reports (NvAPI_D3D_GetLatency / NvAPI_Vulkan_GetLatency).
+// Every call hands over the whole 64 frame report window, frames already seen are skipped by frameID.
+class LatencyAnalytics
+{
+  public:
+    static constexpr size_t HistorySize = 256;
+
+    template <typename Report> static uint32_t Consume(const Report* reports, size_t count)
+    {
+        std::vector<LatencyFrameTimes> frames;
+        frames.reserve(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const auto& report = reports[i];
+            LatencyFrameTimes frame {};
+
+            frame.FrameId = report.frameID;
+            frame.SimStart = report.simStartTime;
+            frame.GpuRenderEnd = report.gpuRenderEndTime;
+            frame.StageUs[(size_t) LatencyStage::Simulation] = Duration(report.simStartTime, report.simEndTime);
+            frame.StageUs[(size_t) LatencyStage::RenderSubmit] =
+                Duration(report.renderSubmitStartTime, report.renderSubmitEndTime);
+            frame.StageUs[(size_t) LatencyStage::Present] = Duration(report.presentStartTime, report.presentEndTime);
+            frame.StageUs[(size_t) LatencyStage::Driver] = Duration(report.driverStartTime, report.driverEndTime);
+            frame.StageUs[(size_t) LatencyStage::OsRenderQueue] =
+                Duration(report.osRenderQueueStartTime, report.osRenderQueueEndTime);
+            frame.StageUs[(size_t) LatencyStage::GpuRender] =
+                Duration(report.gpuRenderStartTime, report.gpuRenderEndTime);
+
+            frames.push_back(frame);
+        }
+
+        return AddFrames(frames);
+    }
+
+    // Returns number of new frames
+    static uint32_t AddFrames(const std::vector<LatencyFrameTimes>& frames);
+
+    static LatencyStats GetStats();
+    static void Reset();
+
+  private:
+    static uint64_t Duration(uint64_t start, uint64_t end) { return end >= start ? end - start : 0; }
+    static void UpdateStats();
+
+    static inline std::mutex _mutex;
+    static inline std::array<LatencyFrameTimes, HistorySize> _history {};
+    static inline uint64_t _count = 0;
+    static inline uint64_t _lastFrameId = 0;
+    static inline uint64_t _lastSimStart = 0;
+    static inline std::array<uint64_t, HistorySize> _intervalUs {};
+    static inline uint64_t _intervalCount = 0;
+    static inline uint64_t _framesSinceLog = 0;
+    static inline LatencyStats _stats {};
+};
@@ -0,0 +1,265 @@
+#include "pch.h"
+#include "PacingSimulator.h"
+
+#include "FrameLimit.h"
+#include <nvapi/fakenvapi/fn_util.h>
+#include <nvapi/fakenvapi/frame_reports.h>
+#include <nvapi/fakenvapi/low_latency_tech/ll_latencyflex.h>
+
+#include <magic_enum.hpp>
+
+#include <deque>
+#include <random>
+#include <thread>
+
+namespace
+{
+class SimClock : public FnClock
+{
+    uint64_t _now = 1'000'000'000ULL;
+
+  public:
+    uint64_t now() override { return _now; }
+
+    int sleep(int64_t ns) override
+    {
+        if (ns > 0)
+            _now += ns;
+
+        return 0;
+    }
+
+    void AdvanceTo(uint64_t time)
+    {
+        if (time > _now)
+            _now = time;
+    }
+};
+
+// Installs the virtual clock for the current thread only, live pacing on other threads is not affected
+class ScopedClockOverride
+{
+    FnClock* _previous = nullptr;
+
+  public:
+    explicit ScopedClockOverride(FnClock* clock) : _previous(fn_clock_override) { fn_clock_override = clock; }
+    ~ScopedClockOverride() { fn_clock_override = _previous; }
+};
+
+uint64_t SampleNs(std::mt19937_64& rng, float meanMs, float jitterMs)
+{
+    std::normal_distribution<double> dist(meanMs, jitterMs);
+    return (uint64_t) (std::max(dist(rng), 0.1) * 1'000'000.0);
+}
+} // namespace
+
+PacingSimResult PacingSimulator::RunPolicy(PacingPolicy policy, const PacingSimParams& params)
+{
+    SimClock clock;
+    ScopedClockOverride clockOverride(&clock);
+
+    // Same workload for every policy
+    std::mt19937_64 rng(params.Seed);
+
+    std::unique_ptr<LatencyFlex> lfx;
+
+    // Filled from the same markers a game sends to SetLatencyMarker
+    auto reports = std::make_unique<FrameReports>();
+
+    if (policy == PacingPolicy::LFXConservative || policy == PacingPolicy::LFXAggressive ||
+        policy == PacingPolicy::LFXReflexIDs)
+    {
+        lfx = std::make_unique<LatencyFlex>();
+        lfx->init(nullptr);
+
+        if (policy == PacingPolicy::LFXConservative)
+            lfx->set_lfx_mode_override(LFXMode::Conservative);
+        else if (policy == PacingPolicy::LFXAggressive)
+            lfx->set_lfx_mode_override(LFXMode::Aggressive);
+        else
+            lfx->set_lfx_mode_override(LFXMode::ReflexIDs);
+
+        SleepMode sleepMode {};
+        sleepMode.low_latency_enabled = true;
+        sleepMode.minimum_interval_us = params.FpsLimit > 0.0f ? (uint32_t) (1'000'000 / params.FpsLimit) : 0;
+        sleepMode.use_markers_to_optimize = true;
+        lfx->set_sleep_mode(&sleepMode);
+    }
+
+    const uint64_t refreshNs = (uint64_t) (1'000'000'000.0 / std::max(params.RefreshRate, 1.0f));
+
+    uint64_t previousLimitTime = 0;
+    uint64_t gpuFreeAt = 0;
+    uint64_t lastDisplay = 0;
+    uint64_t firstDisplay = 0;
+    std::deque<uint64_t> inFlight;
+
+    std::vector<double> latencies;
+    std::vector<double> frameTimes;
+    latencies.reserve(params.Frames);
+    frameTimes.reserve(params.Frames);
+
+    double reportedLatencySum = 0.0;
+    uint32_t reportedLatencyCount = 0;
+
+    for (uint64_t frameId = 1; frameId <= params.WarmupFrames + params.Frames; frameId++)
+    {
+        MarkerParams marker {};
+        marker.frame_id = frameId;
+
+        if (policy == PacingPolicy::FrameLimit)
+            FrameLimit::sleep(false, params.FpsLimit, previousLimitTime);
+
+        if (lfx != nullptr)
+            lfx->sleep();
+
+        auto setMarker = [&](MarkerType type)
+        {
+            marker.marker_type = type;
+            reports->add_marker(frameId, type, true);
+
+            if (lfx != nullptr)
+                lfx->set_marker(nullptr, &marker);
+        };
+
+        setMarker(MarkerType::SIMULATION_START);
+        auto inputTime = clock.now();
+
+        clock.sleep(SampleNs(rng, params.SimulationMs, params.SimulationJitterMs));
+        setMarker(MarkerType::SIMULATION_END);
+        setMarker(MarkerType::RENDERSUBMIT_START);
+
+        clock.sleep(SampleNs(rng, params.RenderSubmitMs, params.RenderSubmitJitterMs));
+        setMarker(MarkerType::RENDERSUBMIT_END);
+        setMarker(MarkerType::PRESENT_START);
+
+        // GPU executes frames in submit order
+        auto gpuStart = std::max(clock.now(), gpuFreeAt);
+        auto gpuEnd = gpuStart + SampleNs(rng, params.GpuMs, params.GpuJitterMs);
+        gpuFreeAt = gpuEnd;
+
+        // With vsync only one frame can be shown per refresh
+        auto displayAt = gpuEnd;
+        if (params.VSync)
+        {
+            displayAt = ((gpuEnd + refreshNs - 1) / refreshNs) * refreshNs;
+            displayAt = std::max(displayAt, lastDisplay + refreshNs);
+        }
+
+        if (frameId > params.WarmupFrames)
+        {
+            if (firstDisplay == 0)
+                firstDisplay = displayAt;
+            else
+                frameTimes.push_back((displayAt - lastDisplay) / 1'000'000.0);
+
+            latencies.push_back((displayAt - inputTime) / 1'000'000.0);
+        }
+
+        lastDisplay = displayAt;
+        inFlight.push_back(displayAt);
+
+        // Present blocks while the queue is full
+        while (!inFlight.empty() && inFlight.front() <= clock.now())
+            inFlight.pop_front();
+
+        while (inFlight.size() > params.MaxQueuedFrames)
+        {
+            clock.AdvanceTo(inFlight.front());
+            inFlight.pop_front();
+        }
+
+        setMarker(MarkerType::PRESENT_END);
+
+        if (auto report = reports->find(frameId); report != nullptr && frameId > params.WarmupFrames)
+        {
+            reportedLatencySum += (report->presentEndTime - report->simStartTime) / 1000.0;
+            reportedLatencyCount++;
+        }
+    }
+
+    if (lfx != nullptr)
+        lfx->deinit();
+
+    PacingSimResult result {};
+    result.Policy = policy;
+
+    if (latencies.empty() || frameTimes.empty())
+        return result;
+
+    double latencySum = 0.0;
+    for (auto latency : latencies)
+        latencySum += latency;
+
+    result.AvgLatencyMs = latencySum / latencies.size();
+
+    if (reportedLatencyCount > 0)
+        result.AvgReportedLatencyMs = reportedLatencySum / reportedLatencyCount;
+
+    std::sort(latencies.begin(), latencies.end());
+    result.P99LatencyMs = latencies[std::min(latencies.size() - 1, (size_t) (latencies.size() * 0.99))];
+
+    double frameTimeSum = 0.0;
+    for (auto frameTime : frameTimes)
+        frameTimeSum += frameTime;
+
+    result.AvgFrameTimeMs = frameTimeSum / frameTimes.size();
+
+    double variance = 0.0;
+    for (auto frameTime : frameTimes)
+        variance += (frameTime - result.AvgFrameTimeMs) * (frameTime - result.AvgFrameTimeMs);
+
+    result.FrameTimeStdDevMs = std::sqrt(variance / frameTimes.size());
+    result.Fps = frameTimes.size() * 1000.0 / ((lastDisplay - firstDisplay) / 1'000'000.0);
+
+    return result;
+}
+
+std::vector<PacingSimResult> PacingSimulator::Run(const PacingSimParams& params)
+{
+    std::vector<PacingSimResult> results;
+
+    for (uint32_t i = 0; i < (uint32_t) PacingPolicy::Count; i++)
+    {
+        auto result = RunPolicy((PacingPolicy) i, params);
+
+        LOG_INFO("{}: latency avg {:.2f} ms p99 {:.2f} ms (reported {:.2f} ms), frame time {:.2f} ms (stddev {:.2f}), "
+                 "{:.1f} fps",
+                 magic_enum::enum_name(result.Policy), result.AvgLatencyMs, result.P99LatencyMs,
+                 result.AvgReportedLatencyMs, result.AvgFrameTimeMs, result.FrameTimeStdDevMs, result.Fps);
+
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+void PacingSimulator::RunAsync(PacingSimParams params)
+{
+    if (_running.exchange(true))
+        return;
+
+    std::thread(
+        [params]()
+        {
+            LOG_INFO("Pacing simulation: cpu {:.1f}+{:.1f} ms, gpu {:.1f} ms, queue {}, {:.0f} Hz, vsync {}, limit {:.1f}",
+                     params.SimulationMs, params.RenderSubmitMs, params.GpuMs, params.MaxQueuedFrames,
+                     params.RefreshRate, params.VSync, params.FpsLimit);
+
+            auto results = Run(params);
+
+            {
+                std::lock_guard<std::mutex> lock(_resultsMutex);
+                _lastResults = std::move(results);
+            }
+
+            _running.store(false);
+        })
+        .detach();
+}
+
+std::vector<PacingSimResult> PacingSimulator::LastResults()
+{
+    std::lock_guard<std::mutex> lock(_resultsMutex);
+    return _lastResults;
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include "SysUtils.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+enum class PacingPolicy : uint32_t
+{
+    None,
+    FrameLimit,
+    LFXConservative,
+    LFXAggressive,
+    LFXReflexIDs,
+    Count
+};
+
+struct PacingSimParams
+{
+    uint32_t Frames = 2000;
+    uint32_t WarmupFrames = 200;
+    uint64_t Seed = 1;
+
+    // CPU, per frame
+    float SimulationMs = 6.0f;
+    float SimulationJitterMs = 1.0f;
+    float RenderSubmitMs = 2.0f;
+    float RenderSubmitJitterMs = 0.5f;
+
+    // GPU, per frame
+    float GpuMs = 10.0f;
+    float GpuJitterMs = 1.5f;
+    uint32_t MaxQueuedFrames = 2;
+
+    // Display
+    float RefreshRate = 144.0f;
+    bool VSync = false;
+
+    // Used by FrameLimit and as Reflex limit for LatencyFlex, 0 = no limit
+    float FpsLimit = 0.0f;
+};
+
+struct PacingSimResult
+{
+    PacingPolicy Policy = PacingPolicy::None;
+    double AvgLatencyMs = 0.0;
+    double P99LatencyMs = 0.0;
+    // Sim start to present end of the marker reports, what Reflex overlays show as PC latency
+    double AvgReportedLatencyMs = 0.0;
+    double AvgFrameTimeMs = 0.0;
+    double FrameTimeStdDevMs = 0.0;
+    double Fps = 0.0;
+};
+
+// Deterministic model of CPU sim / submit, GPU queue and present, driving the real
+// FrameLimit, LatencyFlex and latency report code through a virtual clock on the calling thread
+class PacingSimulator
+{
+  public:
+    static std::vector<PacingSimResult> Run(const PacingSimParams& params);
+
+    // Runs on a worker thread, results are logged and kept for the menu
+    static void RunAsync(PacingSimParams params);
+    static bool IsRunning() { return _running.load(); }
+    static std::vector<PacingSimResult> LastResults();
+
+  private:
+    static PacingSimResult RunPolicy(PacingPolicy policy, const PacingSimParams& params);
+
+    static inline std::atomic<bool> _running { false };
+    static inline std::mutex _resultsMutex;
+    static inline std::vector<PacingSimResult> _lastResults;
+};
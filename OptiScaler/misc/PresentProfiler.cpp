@@ -0,0 +1,193 @@
+#include "pch.h"
+#include "PresentProfiler.h"
+
+#include <nvapi/fakenvapi/fn_util.h>
+
+#include <magic_enum.hpp>
+
+#include <fstream>
+#include <iomanip>
+
+// Record of the present currently running on this thread, FSR FG presents from its own thread
+static thread_local PresentFrameRecord _current {};
+static thread_local uint64_t _frameStart = 0;
+static thread_local uint32_t _depth = 0;
+static thread_local uint64_t _nestedNs = 0;
+
+PresentProfiler::ScopedPhase::ScopedPhase(PresentPhase phase) : _phase(phase)
+{
+    if (_depth == 0)
+        return;
+
+    _outerNestedNs = _nestedNs;
+    _nestedNs = 0;
+    _start = get_timestamp();
+}
+
+PresentProfiler::ScopedPhase::~ScopedPhase()
+{
+    if (_start == 0)
+        return;
+
+    auto elapsed = get_timestamp() - _start;
+    AddPhase(_phase, elapsed > _nestedNs ? elapsed - _nestedNs : 0);
+
+    _nestedNs = _outerNestedNs + elapsed;
+}
+
+bool PresentProfiler::IsEnabled() { return Config::Instance()->PresentProfiler.value_or_default(); }
+
+void PresentProfiler::BeginFrame()
+{
+    // Enabled state is only checked at the outermost present, nested ones always follow it
+    if (_depth == 0 && !IsEnabled())
+        return;
+
+    if (_depth++ > 0)
+        return;
+
+    _current = {};
+    _nestedNs = 0;
+    _frameStart = get_timestamp();
+}
+
+void PresentProfiler::EndFrame()
+{
+    if (_depth == 0 || --_depth > 0)
+        return;
+
+    _current.TotalNs = get_timestamp() - _frameStart;
+
+    std::scoped_lock lock(_ringMutex);
+    _current.Frame = _committed;
+    _ring[_committed % RingSize] = _current;
+    _committed++;
+}
+
+void PresentProfiler::AddPhase(PresentPhase phase, uint64_t ns)
+{
+    if (_depth == 0 || phase >= PresentPhase::Count)
+        return;
+
+    _current.PhaseNs[(size_t) phase] += ns;
+}
+
+PresentPhaseStats PresentProfiler::CalculateStats(std::vector<double>& samples)
+{
+    PresentPhaseStats stats {};
+
+    if (samples.empty())
+        return stats;
+
+    auto percentile = [&samples](double p)
+    {
+        auto index = (size_t) (p * (samples.size() - 1));
+        std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+        return samples[index];
+    };
+
+    stats.P50Ms = percentile(0.50);
+    stats.P99Ms = percentile(0.99);
+    stats.MaxMs = *std::max_element(samples.begin(), samples.end());
+
+    return stats;
+}
+
+PresentProfilerStats PresentProfiler::GetStats()
+{
+    std::vector<PresentFrameRecord> ring;
+    size_t count = 0;
+
+    {
+        std::scoped_lock lock(_ringMutex);
+
+        if (_committed == 0 || _committed - _statsFrame < StatsInterval)
+            return _stats;
+
+        _statsFrame = _committed;
+        count = (size_t) std::min<uint64_t>(_committed, RingSize);
+        ring.assign(_ring.begin(), _ring.begin() + count);
+    }
+
+    PresentProfilerStats stats {};
+    stats.Frames = (uint32_t) count;
+
+    std::vector<double> samples;
+    samples.reserve(count);
+
+    for (size_t phase = 0; phase < (size_t) PresentPhase::Count; phase++)
+    {
+        samples.clear();
+
+        for (size_t i = 0; i < count; i++)
+            samples.push_back(ring[i].PhaseNs[phase] / 1000000.0);
+
+        stats.Phases[phase] = CalculateStats(samples);
+    }
+
+    samples.clear();
+
+    for (size_t i = 0; i < count; i++)
+        samples.push_back(ring[i].TotalNs / 1000000.0);
+
+    stats.Total = CalculateStats(samples);
+
+    std::scoped_lock lock(_ringMutex);
+    _stats = stats;
+
+    return stats;
+}
+
+bool PresentProfiler::DumpCsv(const std::filesystem::path& path)
+{
+    std::vector<PresentFrameRecord> ring;
+    uint64_t committed = 0;
+
+    {
+        std::scoped_lock lock(_ringMutex);
+        ring.assign(_ring.begin(), _ring.end());
+        committed = _committed;
+    }
+
+    std::ofstream file(path, std::ios::trunc);
+
+    if (!file.is_open())
+    {
+        LOG_ERROR("Can't open {}", path.string());
+        return false;
+    }
+
+    file << std::fixed << std::setprecision(4) << "Frame,TotalMs";
+
+    for (size_t phase = 0; phase < (size_t) PresentPhase::Count; phase++)
+        file << "," << magic_enum::enum_name((PresentPhase) phase) << "Ms";
+
+    file << "\n";
+
+    // Oldest record first
+    auto count = std::min<uint64_t>(committed, RingSize);
+
+    for (auto frame = committed - count; frame < committed; frame++)
+    {
+        auto& record = ring[frame % RingSize];
+        file << record.Frame << "," << record.TotalNs / 1000000.0;
+
+        for (auto ns : record.PhaseNs)
+            file << "," << ns / 1000000.0;
+
+        file << "\n";
+    }
+
+    LOG_INFO("Saved {} present profiler records to {}", count, path.string());
+
+    return true;
+}
+
+void PresentProfiler::Reset()
+{
+    std::scoped_lock lock(_ringMutex);
+    _ring = {};
+    _committed = 0;
+    _statsFrame = 0;
+    _stats = {};
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include "SysUtils.h"
+
+#include <array>
+#include <mutex>
+#include <vector>
+
+enum class PresentPhase : uint32_t
+{
+    ReflexUpdate,
+    ReadUpscalerTime,
+    Overlay,
+    FGMutexWait,
+    FGPresent,
+    StreamlineMarkers,
+    Hudfix,
+    Present,
+    FrameLimit,
+    Count
+};
+
+struct PresentPhaseStats
+{
+    double P50Ms = 0.0;
+    double P99Ms = 0.0;
+    double MaxMs = 0.0;
+};
+
+struct PresentProfilerStats
+{
+    uint32_t Frames = 0;
+    std::array<PresentPhaseStats, (size_t) PresentPhase::Count> Phases {};
+    PresentPhaseStats Total {};
+};
+
+struct PresentFrameRecord
+{
+    uint64_t Frame = 0;
+    uint64_t TotalNs = 0;
+    std::array<uint64_t, (size_t) PresentPhase::Count> PhaseNs {};
+};
+
+// Per phase timings of the present path (wrapped swapchain LocalPresent and FGHooks::FGPresent).
+// Phases of nested presents are added to the outermost one, every outermost present is one record.
+// Uses get_timestamp so the timings can be driven by fn_clock_override.
+class PresentProfiler
+{
+  public:
+    static constexpr size_t RingSize = 512;
+
+    class ScopedFrame
+    {
+      private:
+        bool _active;
+
+      public:
+        explicit ScopedFrame(bool active) : _active(active)
+        {
+            if (_active)
+                PresentProfiler::BeginFrame();
+        }
+
+        ~ScopedFrame()
+        {
+            if (_active)
+                PresentProfiler::EndFrame();
+        }
+    };
+
+    // Time of phases nested inside this one is not counted for it
+    class ScopedPhase
+    {
+      private:
+        PresentPhase _phase;
+        uint64_t _start = 0;
+        uint64_t _outerNestedNs = 0;
+
+      public:
+        explicit ScopedPhase(PresentPhase phase);
+        ~ScopedPhase();
+    };
+
+    static bool IsEnabled();
+
+    static void BeginFrame();
+    static void EndFrame();
+    static void AddPhase(PresentPhase phase, uint64_t ns);
+
+    // p50 / p99 / max over the ring, recalculated at most every StatsInterval frames
+    static PresentProfilerStats GetStats();
+    static bool DumpCsv(const std::filesystem::path& path);
+    static void Reset();
+
+    static constexpr uint32_t StatsInterval = 30;
+
+  private:
+    static PresentPhaseStats CalculateStats(std::vector<double>& samples);
+
+    static inline std::mutex _ringMutex;
+    static inline std::array<PresentFrameRecord, RingSize> _ring {};
+    static inline uint64_t _committed = 0;
+
+    static inline uint64_t _statsFrame = 0;
+    static inline PresentProfilerStats _stats {};
+};
@@ -0,0 +1,127 @@
+#include "pch.h"
+#include "SamplerRegistry.h"
+
+#include <algorithm>
+#include <cmath>
+
+void SamplerRegistry::AddHeap(uint64_t id, SIZE_T start, SIZE_T end)
+{
+    std::scoped_lock lock(_mutex);
+
+    // Same address can be reused by a new heap after the old one is gone
+    std::erase_if(_heaps, [id](const Heap& heap) { return heap.Id == id; });
+    _heaps.push_back({ id, start, end });
+    _heapCount.store((uint32_t) _heaps.size(), std::memory_order_release);
+    _lastHeap = _heaps.size() - 1;
+}
+
+void SamplerRegistry::RemoveHeap(uint64_t id)
+{
+    std::scoped_lock lock(_mutex);
+
+    auto it = std::find_if(_heaps.begin(), _heaps.end(), [id](const Heap& heap) { return heap.Id == id; });
+
+    if (it == _heaps.end())
+        return;
+
+    std::vector<SIZE_T> stale;
+
+    for (auto& [handle, slot] : _slots)
+    {
+        if (handle >= it->Start && handle < it->End)
+            stale.push_back(handle);
+    }
+
+    for (auto handle : stale)
+        _slots.erase(handle);
+
+    LOG_DEBUG("Heap: {:X}, removed {} samplers", id, stale.size());
+
+    _heaps.erase(it);
+    _heapCount.store((uint32_t) _heaps.size(), std::memory_order_release);
+    _lastHeap = 0;
+}
+
+bool SamplerRegistry::InKnownHeap(SIZE_T cpuHandle)
+{
+    auto contains = [cpuHandle](const Heap& heap) { return cpuHandle >= heap.Start && cpuHandle < heap.End; };
+
+    if (_lastHeap >= _heaps.size() || !contains(_heaps[_lastHeap]))
+    {
+        auto it = std::find_if(_heaps.begin(), _heaps.end(), contains);
+
+        if (it == _heaps.end())
+            return false;
+
+        _lastHeap = it - _heaps.begin();
+    }
+
+    return true;
+}
+
+bool SamplerRegistry::Record(ID3D12Device* device, const D3D12_SAMPLER_DESC& original, SIZE_T cpuHandle)
+{
+    if (!InKnownHeap(cpuHandle))
+        return false;
+
+    _slots[cpuHandle] = { device, original };
+    return true;
+}
+
+void SamplerRegistry::CopySlot(SIZE_T dest, SIZE_T src)
+{
+    if (!InKnownHeap(dest))
+        return;
+
+    if (auto it = _slots.find(src); it != _slots.end())
+    {
+        auto slot = it->second;
+        _slots[dest] = slot;
+    }
+    else
+    {
+        _slots.erase(dest);
+    }
+}
+
+size_t SamplerRegistry::Slots()
+{
+    std::scoped_lock lock(_mutex);
+    return _slots.size();
+}
+
+size_t SamplerRegistry::Heaps()
+{
+    std::scoped_lock lock(_mutex);
+    return _heaps.size();
+}
+
+float SamplerRegistry::OverrideBias(float bias, float value, SamplerBiasMode mode)
+{
+    switch (mode)
+    {
+    case SamplerBiasMode::Fixed:
+        bias = value;
+        break;
+
+    case SamplerBiasMode::Scale:
+        bias = bias * value;
+        break;
+
+    default:
+        bias = bias + value;
+        break;
+    }
+
+    // D3D12 limits
+    return std::clamp(bias, -16.0f, 15.99f);
+}
+
+float SamplerRegistry::RatioBias(uint32_t renderWidth, uint32_t displayWidth)
+{
+    if (renderWidth == 0 || displayWidth == 0)
+        return 0.0f;
+
+    auto bias = std::log2((float) renderWidth / (float) displayWidth);
+    return std::round(bias * 20.0f) / 20.0f;
+}
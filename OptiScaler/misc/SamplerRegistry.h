@@ -0,0 +1,137 @@
+#pragma once
+#include "SysUtils.h"
+
+#include <d3d12.h>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <ankerl/unordered_dense.h>
+
+// Mirrors MipmapBiasFixedOverride / MipmapBiasScaleOverride, value is added otherwise
+enum class SamplerBiasMode : uint8_t
+{
+    Add,
+    Fixed,
+    Scale,
+};
+
+// Keeps the original desc of every sampler the game writes into a known staging (non shader visible)
+// sampler heap, keyed by destination CPU handle, so overrides can be applied to them again when the
+// settings change. GPU never reads staging heaps, rewriting them can't race with rendering. Shader
+// visible heaps are not tracked, their samplers get the new settings when the game creates or copies
+// them again. Heaps are removed (with their slots) when they are destroyed.
+class SamplerRegistry
+{
+  public:
+    static SamplerRegistry& Instance()
+    {
+        // Never destroyed, destruction callbacks can arrive after static destructors on exit
+        static SamplerRegistry* instance = new SamplerRegistry();
+        return *instance;
+    }
+
+    // Range is [start, end) of CPU handles
+    void AddHeap(uint64_t id, SIZE_T start, SIZE_T end);
+    void RemoveHeap(uint64_t id);
+
+    // Lock free, false until a staging sampler heap is known
+    bool HasHeaps() const { return _heapCount.load(std::memory_order_acquire) != 0; }
+
+    // Calls create() and records the slot under the same lock, so a rewrite can't overwrite
+    // a newer sampler of the game with the previous desc. Returns false when handle is not in a known heap.
+    template <typename Fn>
+    bool Create(ID3D12Device* device, const D3D12_SAMPLER_DESC& original, SIZE_T cpuHandle, Fn&& create)
+    {
+        std::scoped_lock lock(_mutex);
+        create();
+        return Record(device, original, cpuHandle);
+    }
+
+    // Calls copy() and moves the records of copied slots along with the descriptors. Destination slots
+    // copied from an unknown source are forgotten, a rewrite would put back the previous sampler otherwise.
+    // Null range sizes mean ranges of one descriptor, like for ID3D12Device::CopyDescriptors.
+    template <typename Fn>
+    void Copy(UINT numDestRanges, const D3D12_CPU_DESCRIPTOR_HANDLE* destStarts, const UINT* destSizes,
+              UINT numSrcRanges, const D3D12_CPU_DESCRIPTOR_HANDLE* srcStarts, const UINT* srcSizes,
+              UINT increment, Fn&& copy)
+    {
+        std::scoped_lock lock(_mutex);
+        copy();
+
+        UINT destRange = 0;
+        UINT destIndex = 0;
+        UINT srcRange = 0;
+        UINT srcIndex = 0;
+
+        while (destRange < numDestRanges && srcRange < numSrcRanges)
+        {
+            auto destSize = destSizes == nullptr ? 1 : destSizes[destRange];
+            auto srcSize = srcSizes == nullptr ? 1 : srcSizes[srcRange];
+
+            if (destIndex >= destSize)
+            {
+                destRange++;
+                destIndex = 0;
+                continue;
+            }
+
+            if (srcIndex >= srcSize)
+            {
+                srcRange++;
+                srcIndex = 0;
+                continue;
+            }
+
+            CopySlot(destStarts[destRange].ptr + (SIZE_T) destIndex * increment,
+                     srcStarts[srcRange].ptr + (SIZE_T) srcIndex * increment);
+
+            destIndex++;
+            srcIndex++;
+        }
+    }
+
+    // Calls fn(device, original desc, cpu handle) for every live slot, no slot or heap can change meanwhile
+    template <typename Fn> size_t ForEach(Fn&& fn)
+    {
+        std::scoped_lock lock(_mutex);
+
+        for (auto& [handle, slot] : _slots)
+            fn(slot.Device, slot.Original, handle);
+
+        return _slots.size();
+    }
+
+    size_t Slots();
+    size_t Heaps();
+
+    static float OverrideBias(float bias, float value, SamplerBiasMode mode);
+
+    // log2(render / display), rounded to 0.05 so small DRS changes don't cause rewrites
+    static float RatioBias(uint32_t renderWidth, uint32_t displayWidth);
+
+  private:
+    bool Record(ID3D12Device* device, const D3D12_SAMPLER_DESC& original, SIZE_T cpuHandle);
+    bool InKnownHeap(SIZE_T cpuHandle);
+    void CopySlot(SIZE_T dest, SIZE_T src);
+
+    struct Heap
+    {
+        uint64_t Id = 0;
+        SIZE_T Start = 0;
+        SIZE_T End = 0;
+    };
+
+    struct Slot
+    {
+        ID3D12Device* Device = nullptr; // Heap keeps the device alive
+        D3D12_SAMPLER_DESC Original {};
+    };
+
+    std::mutex _mutex;
+    std::vector<Heap> _heaps;
+    std::atomic<uint32_t> _heapCount { 0 };
+    size_t _lastHeap = 0; // Samplers are usually written into the same heap in a row
+    ankerl::unordered_dense::map<SIZE_T, Slot> _slots;
+};
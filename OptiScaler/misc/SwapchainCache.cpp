@@ -0,0 +1,176 @@
+#include "pch.h"
+#include "SwapchainCache.h"
+
+#include <State.h>
+#include <shaders/Shader_Dx12.h>
+
+SwapchainBuffers::~SwapchainBuffers()
+{
+    if (State::Instance().isShuttingDown)
+        return;
+
+    SAFE_RELEASE(RtvHeap);
+    SAFE_RELEASE(SrvHeap);
+}
+
+std::shared_ptr<const SwapchainBuffers> SwapchainCache::Build(IDXGISwapChain3* swapchain, ID3D12Device* device)
+{
+    auto entry = std::make_shared<SwapchainBuffers>();
+
+    if (swapchain->GetDesc(&entry->Desc) != S_OK)
+    {
+        LOG_WARN("Can't get swapchain desc!");
+        return nullptr;
+    }
+
+    auto count = entry->Desc.BufferCount;
+
+    if (count == 0 || count > DXGI_MAX_SWAP_CHAIN_BUFFERS)
+        return nullptr;
+
+    for (UINT i = 0; i < count; i++)
+    {
+        ID3D12Resource* buffer = nullptr;
+        auto result = swapchain->GetBuffer(i, IID_PPV_ARGS(&buffer));
+
+        if (result != S_OK)
+        {
+            LOG_ERROR("GetBuffer({}) error: {:X}", i, (UINT) result);
+            return nullptr;
+        }
+
+        buffer->Release();
+        entry->Buffers.push_back(buffer);
+    }
+
+    entry->ViewFormat = Shader_Dx12::TranslateTypelessFormats(entry->Desc.BufferDesc.Format);
+
+    auto bufferFlags = entry->Buffers[0]->GetDesc().Flags;
+
+    ScopedSkipHeapCapture skipHeapCapture {};
+
+    D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
+    heapDesc.NumDescriptors = count;
+    heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+
+    if ((bufferFlags & D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET) != 0)
+    {
+        heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
+        auto result = device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&entry->RtvHeap));
+
+        if (result != S_OK)
+        {
+            LOG_ERROR("CreateDescriptorHeap(RTV) error: {:X}", (UINT) result);
+            return nullptr;
+        }
+
+        entry->RtvDescriptorSize = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
+
+        D3D12_RENDER_TARGET_VIEW_DESC rtvDesc = {};
+        rtvDesc.Format = entry->ViewFormat;
+        rtvDesc.ViewDimension = D3D12_RTV_DIMENSION_TEXTURE2D;
+
+        for (UINT i = 0; i < count; i++)
+            device->CreateRenderTargetView(entry->Buffers[i], &rtvDesc, entry->Rtv(i));
+    }
+
+    if ((bufferFlags & D3D12_RESOURCE_FLAG_DENY_SHADER_RESOURCE) == 0)
+    {
+        heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+        auto result = device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&entry->SrvHeap));
+
+        if (result != S_OK)
+        {
+            LOG_ERROR("CreateDescriptorHeap(SRV) error: {:X}", (UINT) result);
+            return nullptr;
+        }
+
+        entry->SrvDescriptorSize = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+        D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+        srvDesc.Format = entry->ViewFormat;
+        srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+        srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+        srvDesc.Texture2D.MipLevels = 1;
+
+        for (UINT i = 0; i < count; i++)
+            device->CreateShaderResourceView(entry->Buffers[i], &srvDesc, entry->Srv(i));
+    }
+
+    LOG_DEBUG("Cached {} backbuffers of {:X}, {}x{}, format: {}, RTV: {}, SRV: {}", count, (size_t) swapchain,
+              entry->Width(), entry->Height(), (UINT) entry->ViewFormat, entry->RtvHeap != nullptr,
+              entry->SrvHeap != nullptr);
+
+    return entry;
+}
+
+std::shared_ptr<const SwapchainBuffers> SwapchainCache::Get(IDXGISwapChain3* swapchain, ID3D12Device* device)
+{
+    if (swapchain == nullptr || device == nullptr)
+        return nullptr;
+
+    uint64_t generation = 0;
+
+    {
+        std::scoped_lock lock(_mutex);
+
+        if (auto it = _entries.find(swapchain); it != _entries.end())
+            return it->second;
+
+        generation = _generation;
+    }
+
+    // DXGI calls are made without holding the lock, they might wait for the present thread
+    auto entry = Build(swapchain, device);
+
+    std::scoped_lock lock(_mutex);
+
+    // Swapchain changed while building, don't keep it (failures are kept too, until next change)
+    if (generation != _generation)
+        return entry;
+
+    return _entries.try_emplace(swapchain, entry).first->second;
+}
+
+UINT SwapchainCache::CurrentIndex(IDXGISwapChain3* swapchain)
+{
+    uint64_t presents = 0;
+
+    {
+        std::scoped_lock lock(_mutex);
+
+        if (auto it = _indexes.find(swapchain); it != _indexes.end())
+            return it->second;
+
+        presents = _presents;
+    }
+
+    auto index = swapchain->GetCurrentBackBufferIndex();
+
+    std::scoped_lock lock(_mutex);
+
+    if (presents == _presents)
+        _indexes[swapchain] = index;
+
+    return index;
+}
+
+void SwapchainCache::Presented()
+{
+    std::scoped_lock lock(_mutex);
+    _presents++;
+    _indexes.clear();
+}
+
+void SwapchainCache::Invalidate()
+{
+    std::scoped_lock lock(_mutex);
+
+    if (!_entries.empty())
+        LOG_DEBUG("Dropping {} cached swapchains", _entries.size());
+
+    _generation++;
+    _presents++; // ResizeBuffers resets the index too
+    _entries.clear();
+    _indexes.clear();
+}
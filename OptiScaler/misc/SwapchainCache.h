@@ -0,0 +1,81 @@
+#pragma once
+#include "SysUtils.h"
+
+#include <d3d12.h>
+#include <dxgi1_6.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <ankerl/unordered_dense.h>
+
+// Backbuffers of a swapchain & their views. Never changes after it's built, a resize or a new
+// swapchain builds a new one, so a pass can keep using the one it got until its dispatch ends.
+struct SwapchainBuffers
+{
+    DXGI_SWAP_CHAIN_DESC Desc {};
+    DXGI_FORMAT ViewFormat = DXGI_FORMAT_UNKNOWN; // Typeless formats translated
+
+    // Not referenced, ResizeBuffers would fail otherwise
+    std::vector<ID3D12Resource*> Buffers;
+
+    // Not shader visible, RTVs are used directly, SRVs need to be copied into a frame heap.
+    // Heaps are null when backbuffers don't allow render target or shader resource usage.
+    ID3D12DescriptorHeap* RtvHeap = nullptr;
+    ID3D12DescriptorHeap* SrvHeap = nullptr;
+    UINT RtvDescriptorSize = 0;
+    UINT SrvDescriptorSize = 0;
+
+    UINT Width() const { return Desc.BufferDesc.Width; }
+    UINT Height() const { return Desc.BufferDesc.Height; }
+
+    D3D12_CPU_DESCRIPTOR_HANDLE Rtv(UINT index) const
+    {
+        auto handle = RtvHeap->GetCPUDescriptorHandleForHeapStart();
+        handle.ptr += (SIZE_T) index * RtvDescriptorSize;
+        return handle;
+    }
+
+    D3D12_CPU_DESCRIPTOR_HANDLE Srv(UINT index) const
+    {
+        auto handle = SrvHeap->GetCPUDescriptorHandleForHeapStart();
+        handle.ptr += (SIZE_T) index * SrvDescriptorSize;
+        return handle;
+    }
+
+    ~SwapchainBuffers();
+};
+
+// Keeps backbuffers & views of the swapchains used by present time passes, so they don't query
+// DXGI every frame. Entries are built on first use and dropped when any swapchain is created,
+// resized, changes fullscreen state or is released.
+class SwapchainCache
+{
+  public:
+    static SwapchainCache& Instance()
+    {
+        static SwapchainCache* instance = new SwapchainCache();
+        return *instance;
+    }
+
+    // Null when the swapchain is not a D3D12 one or can't be read
+    std::shared_ptr<const SwapchainBuffers> Get(IDXGISwapChain3* swapchain, ID3D12Device* device);
+
+    // Backbuffer index only changes with Present & ResizeBuffers, it's queried once per present
+    UINT CurrentIndex(IDXGISwapChain3* swapchain);
+
+    // Called after every present
+    void Presented();
+
+    void Invalidate();
+
+  private:
+    std::mutex _mutex;
+    uint64_t _generation = 0; // Invalidate calls
+    uint64_t _presents = 0;
+    ankerl::unordered_dense::map<IDXGISwapChain*, std::shared_ptr<const SwapchainBuffers>> _entries;
+    ankerl::unordered_dense::map<IDXGISwapChain*, UINT> _indexes;
+
+    static std::shared_ptr<const SwapchainBuffers> Build(IDXGISwapChain3* swapchain, ID3D12Device* device);
+};
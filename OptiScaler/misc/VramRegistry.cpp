@@ -0,0 +1,220 @@
+#include "pch.h"
+#include "VramRegistry.h"
+
+#include <State.h>
+#include <proxies/Dxgi_Proxy.h>
+
+#include <magic_enum.hpp>
+
+class DxgiBudgetSource : public IVramBudgetSource
+{
+  private:
+    IDXGIAdapter3* _adapter = nullptr;
+    LUID _luid {};
+    bool _failed = false;
+
+  public:
+    bool Init(LUID luid)
+    {
+        if (_luid.LowPart == luid.LowPart && _luid.HighPart == luid.HighPart && (_adapter != nullptr || _failed))
+            return _adapter != nullptr;
+
+        SAFE_RELEASE(_adapter);
+        _luid = luid;
+        _failed = true;
+
+        ScopedSkipSpoofing skipSpoofing {};
+        ScopedSkipDxgiLoadChecks skipDxgiLoadChecks {};
+
+        IDXGIFactory4* factory = nullptr;
+        if (DxgiProxy::CreateDxgiFactory_()(__uuidof(factory), (IDXGIFactory**) &factory) != S_OK ||
+            factory == nullptr)
+        {
+            LOG_ERROR("Can't create DXGI factory, VRAM budget won't be available");
+            return false;
+        }
+
+        auto result = factory->EnumAdapterByLuid(luid, IID_PPV_ARGS(&_adapter));
+        factory->Release();
+
+        if (result != S_OK)
+        {
+            LOG_ERROR("EnumAdapterByLuid error: {:X}, VRAM budget won't be available", (UINT) result);
+            _adapter = nullptr;
+            return false;
+        }
+
+        _failed = false;
+        return true;
+    }
+
+    bool Query(VramBudget& budget) override
+    {
+        DXGI_QUERY_VIDEO_MEMORY_INFO info {};
+
+        if (_adapter == nullptr || _adapter->QueryVideoMemoryInfo(0, DXGI_MEMORY_SEGMENT_GROUP_LOCAL, &info) != S_OK)
+            return false;
+
+        budget.Budget = info.Budget;
+        budget.Usage = info.CurrentUsage;
+        return true;
+    }
+};
+
+static void WINAPI OnResourceDestroyed(void* pData) { VramRegistry::Instance().Remove((uint64_t) pData); }
+
+void VramRegistry::Track(ID3D12Resource* resource, std::string_view owner, std::string_view purpose)
+{
+    if (resource == nullptr)
+        return;
+
+    ID3D12Device* device = nullptr;
+    if (resource->GetDevice(IID_PPV_ARGS(&device)) != S_OK || device == nullptr)
+        return;
+
+    auto desc = resource->GetDesc();
+    auto info = device->GetResourceAllocationInfo(0, 1, &desc);
+    device->Release();
+
+    // Without the notifier the entry would outlive the resource
+    ID3DDestructionNotifier* notifier = nullptr;
+    if (resource->QueryInterface(IID_PPV_ARGS(&notifier)) != S_OK || notifier == nullptr)
+    {
+        LOG_DEBUG("No destruction notifier, {} / {} is not tracked", owner, purpose);
+        return;
+    }
+
+    auto id = (uint64_t) resource;
+    UINT callbackId = 0;
+    auto result = notifier->RegisterDestructionCallback(OnResourceDestroyed, (void*) id, &callbackId);
+    notifier->Release();
+
+    if (result != S_OK)
+    {
+        LOG_DEBUG("RegisterDestructionCallback error: {:X}", (UINT) result);
+        return;
+    }
+
+    Add(id, owner, purpose, info.SizeInBytes);
+}
+
+void VramRegistry::Add(uint64_t id, std::string_view owner, std::string_view purpose, uint64_t bytes)
+{
+    std::scoped_lock lock(_mutex);
+
+    auto& entry = _entries[id];
+    _total -= entry.Bytes;
+
+    entry.Owner = owner;
+    entry.Purpose = purpose;
+    entry.Bytes = bytes;
+    _total += bytes;
+
+    LOG_DEBUG("{} / {}: {:.2f} MB, total: {:.2f} MB", owner, purpose, bytes / 1048576.0, _total / 1048576.0);
+}
+
+void VramRegistry::Remove(uint64_t id)
+{
+    std::scoped_lock lock(_mutex);
+
+    auto it = _entries.find(id);
+
+    if (it == _entries.end())
+        return;
+
+    _total -= it->second.Bytes;
+    _entries.erase(it);
+}
+
+uint64_t VramRegistry::Total()
+{
+    std::scoped_lock lock(_mutex);
+    return _total;
+}
+
+std::vector<VramOwnerTotal> VramRegistry::Totals()
+{
+    std::vector<VramOwnerTotal> totals;
+
+    {
+        std::scoped_lock lock(_mutex);
+
+        for (auto& [id, entry] : _entries)
+        {
+            auto it = std::find_if(totals.begin(), totals.end(),
+                                   [&entry](const VramOwnerTotal& total) { return total.Owner == entry.Owner; });
+
+            if (it == totals.end())
+            {
+                totals.push_back({ entry.Owner, 0, 0 });
+                it = totals.end() - 1;
+            }
+
+            it->Bytes += entry.Bytes;
+            it->Count++;
+        }
+    }
+
+    std::sort(totals.begin(), totals.end(),
+              [](const VramOwnerTotal& a, const VramOwnerTotal& b) { return a.Bytes > b.Bytes; });
+
+    return totals;
+}
+
+VramBudget VramRegistry::LastBudget()
+{
+    std::scoped_lock lock(_mutex);
+    return _budget;
+}
+
+VramPressure VramRegistry::Update(IVramBudgetSource& source)
+{
+    VramBudget budget {};
+
+    if (!source.Query(budget) || budget.Budget == 0)
+        return _pressure;
+
+    {
+        std::scoped_lock lock(_mutex);
+        _budget = budget;
+    }
+
+    auto previous = _pressure.load();
+    auto ratio = (double) budget.Usage / (double) budget.Budget;
+    auto pressure = VramPressure::None;
+
+    if (ratio > 1.0)
+        pressure = VramPressure::Critical;
+    else if (ratio > HighPressure || (previous != VramPressure::None && ratio > HighPressureExit))
+        pressure = VramPressure::High;
+
+    _pressure = pressure;
+
+    if (pressure != previous)
+    {
+        LOG_INFO("VRAM pressure: {} -> {}, usage: {} MB / budget: {} MB", magic_enum::enum_name(previous),
+                 magic_enum::enum_name(pressure), budget.Usage / 1048576, budget.Budget / 1048576);
+        LogTotals();
+    }
+
+    return pressure;
+}
+
+void VramRegistry::OnPresent(uint64_t frame, LUID adapterLuid)
+{
+    if (frame % UpdateInterval != 0)
+        return;
+
+    static DxgiBudgetSource dxgiSource;
+
+    if (dxgiSource.Init(adapterLuid))
+        Update(dxgiSource);
+}
+
+void VramRegistry::LogTotals()
+{
+    for (auto& total : Totals())
+        LOG_INFO("  {}: {:.2f} MB in {} resources", total.Owner, total.Bytes / 1048576.0, total.Count);
+
+    LOG_INFO("  Total: {:.2f} MB", Total() / 1048576.0);
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include "SysUtils.h"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <ankerl/unordered_dense.h>
+
+struct VramBudget
+{
+    uint64_t Budget = 0; // Bytes the OS lets the process use, changes at runtime
+    uint64_t Usage = 0;  // Whole process, not only OptiScaler
+};
+
+// Budget of the local (dedicated) memory segment, behind an interface so the policy can be fed fake values
+class IVramBudgetSource
+{
+  public:
+    virtual ~IVramBudgetSource() = default;
+    virtual bool Query(VramBudget& budget) = 0;
+};
+
+enum class VramPressure : uint8_t
+{
+    None,
+    High,     // Usage above HighPressure of budget
+    Critical, // Usage above budget, OS is paging
+};
+
+struct VramOwnerTotal
+{
+    std::string Owner;
+    uint64_t Bytes = 0;
+    uint32_t Count = 0;
+};
+
+// Keeps size, owner & purpose of resources OptiScaler creates for itself.
+// D3D12 resources are removed automatically when they are destroyed (ID3DDestructionNotifier),
+// so only creation sites need to report. Owners check Pressure() at a safe point of their
+// own and release idle buffers, registry never releases anything itself.
+class VramRegistry
+{
+  public:
+    // Double like the usage ratio, 0.9f is below 0.9 and would flag exactly 90% as high
+    static constexpr double HighPressure = 0.9;
+    static constexpr double HighPressureExit = 0.85; // Hysteresis
+    static constexpr uint64_t IdleReleaseFrames = 600;
+
+    static VramRegistry& Instance()
+    {
+        // Never destroyed, destruction callbacks can arrive after static destructors on exit
+        static VramRegistry* instance = new VramRegistry();
+        return *instance;
+    }
+
+    void Track(ID3D12Resource* resource, std::string_view owner, std::string_view purpose);
+
+    void Add(uint64_t id, std::string_view owner, std::string_view purpose, uint64_t bytes);
+    void Remove(uint64_t id);
+
+    uint64_t Total();
+    std::vector<VramOwnerTotal> Totals();
+
+    VramPressure Update(IVramBudgetSource& source);
+    VramPressure Pressure() const { return _pressure; }
+    VramBudget LastBudget();
+
+    // Buffers not requested for IdleReleaseFrames presents only take VRAM while under pressure
+    static bool ShouldReleaseIdle(VramPressure pressure, bool hasBuffer, uint64_t idleFrames)
+    {
+        return pressure != VramPressure::None && hasBuffer && idleFrames > IdleReleaseFrames;
+    }
+
+    // Queries budget of the adapter every UpdateInterval presents
+    void OnPresent(uint64_t frame, LUID adapterLuid);
+
+  private:
+    static constexpr uint64_t UpdateInterval = 60;
+
+    struct Entry
+    {
+        std::string Owner;
+        std::string Purpose;
+        uint64_t Bytes = 0;
+    };
+
+    std::mutex _mutex;
+    ankerl::unordered_dense::map<uint64_t, Entry> _entries;
+    uint64_t _total = 0;
+    VramBudget _budget {};
+    std::atomic<VramPressure> _pressure { VramPressure::None };
+
+    void LogTotals();
+};
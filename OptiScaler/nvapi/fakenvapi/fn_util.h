@@ -21,8 +21,23 @@ void tonvss(NvAPI_ShortString nvss, std::string str);
     if (std::string(it->func) == #method)                                                                              \
         return fakenvapi::idToFuncMapping.insert({ id, (void*) nvapi_calls::method }).first->second;
 
+// Time source for the pacing code, can be replaced per thread (used by the pacing simulator)
+class FnClock
+{
+  public:
+    virtual ~FnClock() = default;
+
+    virtual uint64_t now() = 0;        // ns
+    virtual int sleep(int64_t ns) = 0; // 0 on success
+};
+
+inline thread_local FnClock* fn_clock_override = nullptr;
+
 static inline uint64_t get_timestamp()
 {
+    if (fn_clock_override != nullptr)
+        return fn_clock_override->now();
+
     FILETIME fileTime;
     GetSystemTimePreciseAsFileTime(&fileTime);
 
@@ -64,6 +79,9 @@ inline int busywait_sleep(int64_t ns)
 
 inline int eepy(int64_t ns)
 {
+    if (fn_clock_override != nullptr)
+        return fn_clock_override->sleep(ns);
+
     constexpr int64_t busywait_threshold = 2'000'000; // 2ms
 
     int status;
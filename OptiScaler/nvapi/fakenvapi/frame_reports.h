@@ -0,0 +1,119 @@
+#pragma once
+
+#include "fn_util.h"
+#include "low_latency_tech/low_latency_tech.h"
+
+#include <cstring>
+
+#define FRAME_REPORTS_BUFFER_SIZE 70
+
+struct FrameReport
+{
+    uint64_t frameID;
+    uint64_t inputSampleTime;
+    uint64_t simStartTime;
+    uint64_t simEndTime;
+    uint64_t renderSubmitStartTime;
+    uint64_t renderSubmitEndTime;
+    uint64_t presentStartTime;
+    uint64_t presentEndTime;
+    uint64_t driverStartTime;
+    uint64_t driverEndTime;
+    uint64_t osRenderQueueStartTime;
+    uint64_t osRenderQueueEndTime;
+    uint64_t gpuRenderStartTime;
+    uint64_t gpuRenderEndTime;
+    uint32_t gpuActiveRenderTimeUs;
+    uint32_t gpuFrameTimeUs;
+    uint8_t rsvd[120];
+};
+
+// Latency reports built from the markers, indexed by frameID % FRAME_REPORTS_BUFFER_SIZE.
+// Used by the D3D and Vulkan paths of LowLatency and by the pacing simulator, times come from get_timestamp()
+class FrameReports
+{
+  private:
+    FrameReport reports[FRAME_REPORTS_BUFFER_SIZE] {};
+
+    uint64_t last_sim_start = 0;
+    uint64_t _2nd_last_sim_start = 0;
+    bool sim_start_seeded = false;
+
+  public:
+    FrameReport& operator[](size_t index) { return reports[index]; }
+    const FrameReport& operator[](size_t index) const { return reports[index]; }
+    const FrameReport* data() const { return reports; }
+
+    // nullptr when the slot was already reused by another frame
+    const FrameReport* find(uint64_t frame_id) const
+    {
+        auto report = &reports[frame_id % FRAME_REPORTS_BUFFER_SIZE];
+        return report->frameID == frame_id ? report : nullptr;
+    }
+
+    void clear() { std::memset(reports, 0, sizeof(reports)); }
+
+    // Marker values of NV_LATENCY_MARKER_TYPE and NV_VULKAN_LATENCY_MARKER_TYPE match MarkerType.
+    // GPU placeholders are skipped when the GPU times are filled from timestamp queries
+    void add_marker(uint64_t frame_id, MarkerType marker_type, bool gpu_placeholders)
+    {
+        auto current_timestamp = get_timestamp() / 1000;
+
+        if (!sim_start_seeded)
+        {
+            last_sim_start = current_timestamp;
+            _2nd_last_sim_start = current_timestamp;
+            sim_start_seeded = true;
+        }
+
+        auto current_report = &reports[frame_id % FRAME_REPORTS_BUFFER_SIZE];
+
+        if (current_report->frameID != frame_id)
+        {
+            *current_report = FrameReport {};
+        }
+
+        current_report->frameID = frame_id;
+        current_report->driverStartTime = current_timestamp;
+        current_report->driverEndTime = current_timestamp + 100;
+
+        if (gpu_placeholders)
+        {
+            current_report->gpuFrameTimeUs = (uint32_t) (last_sim_start - _2nd_last_sim_start);
+            current_report->gpuActiveRenderTimeUs = 100;
+            current_report->gpuRenderStartTime = current_timestamp;
+            current_report->gpuRenderEndTime = current_timestamp + 100;
+        }
+
+        current_report->osRenderQueueStartTime = current_timestamp;
+        current_report->osRenderQueueEndTime = current_timestamp + 100;
+        switch (marker_type)
+        {
+        case MarkerType::SIMULATION_START:
+            _2nd_last_sim_start = last_sim_start;
+            last_sim_start = get_timestamp() / 1000;
+            current_report->simStartTime = last_sim_start;
+            break;
+        case MarkerType::SIMULATION_END:
+            current_report->simEndTime = get_timestamp() / 1000;
+            break;
+        case MarkerType::RENDERSUBMIT_START:
+            current_report->renderSubmitStartTime = get_timestamp() / 1000;
+            break;
+        case MarkerType::RENDERSUBMIT_END:
+            current_report->renderSubmitEndTime = get_timestamp() / 1000;
+            break;
+        case MarkerType::PRESENT_START:
+            current_report->presentStartTime = get_timestamp() / 1000;
+            break;
+        case MarkerType::PRESENT_END:
+            current_report->presentEndTime = get_timestamp() / 1000;
+            break;
+        case MarkerType::INPUT_SAMPLE:
+            current_report->inputSampleTime = get_timestamp() / 1000;
+            break;
+        default:
+            break;
+        }
+    }
+};
@@ -0,0 +1,367 @@
+#include "pch.h"
+#include "gpu_timing_d3d.h"
+
+#include "fn_util.h"
+#include "log.h"
+
+#include <d3dx/d3dx12.h>
+
+bool GpuTimingD3D::init(QueueContext* context, ID3D12Device* device)
+{
+    auto type = context->queue->GetDesc().Type;
+
+    // Copy queues need D3D12_FEATURE_D3D12_OPTIONS3, skip them
+    if (type == D3D12_COMMAND_LIST_TYPE_COPY)
+        return false;
+
+    D3D12_QUERY_HEAP_DESC heapDesc {};
+    heapDesc.Count = GPU_TIMING_SLOTS * 2;
+    heapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+
+    if (device->CreateQueryHeap(&heapDesc, IID_PPV_ARGS(&context->query_heap)) != S_OK)
+    {
+        LOG_ERROR("CreateQueryHeap failed");
+        return false;
+    }
+
+    auto bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(GPU_TIMING_SLOTS * 2 * sizeof(uint64_t));
+    auto heapProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_READBACK);
+
+    if (device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &bufferDesc, D3D12_RESOURCE_STATE_COPY_DEST,
+                                        nullptr, IID_PPV_ARGS(&context->readback)) != S_OK ||
+        device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&context->fence)) != S_OK)
+    {
+        LOG_ERROR("Can't create readback buffer or fence");
+        return false;
+    }
+
+    for (auto& slot : context->slots)
+    {
+        if (device->CreateCommandAllocator(type, IID_PPV_ARGS(&slot.allocator)) != S_OK ||
+            device->CreateCommandList(0, type, slot.allocator, nullptr, IID_PPV_ARGS(&slot.start_list)) != S_OK ||
+            device->CreateCommandList(0, type, slot.allocator, nullptr, IID_PPV_ARGS(&slot.end_list)) != S_OK)
+        {
+            LOG_ERROR("Can't create command lists");
+            return false;
+        }
+
+        slot.start_list->Close();
+        slot.end_list->Close();
+    }
+
+    if (!calibrate(context))
+        return false;
+
+    LOG_INFO("GPU latency timestamps enabled for queue {:X}", (size_t) context->queue);
+    return true;
+}
+
+GpuTimingD3D::~GpuTimingD3D()
+{
+    if (State::Instance().isShuttingDown)
+        return;
+
+    deinit();
+}
+
+// Without wait the context is only released when the GPU is done with it
+bool GpuTimingD3D::release(QueueContext* context, bool wait)
+{
+    auto fence = context->fence;
+    bool idle = fence == nullptr || fence->GetCompletedValue() >= context->fence_value;
+
+    if (!idle && !wait)
+        return false;
+
+    // Lists might still be in flight on the game's queue
+    if (!idle)
+    {
+        auto event = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+
+        idle = event != nullptr && fence->SetEventOnCompletion(context->fence_value, event) == S_OK &&
+               WaitForSingleObject(event, 500) == WAIT_OBJECT_0;
+
+        if (event != nullptr)
+            CloseHandle(event);
+    }
+
+    if (!idle)
+    {
+        // Queue is hung, leaking is safer than releasing objects the GPU might still use
+        LOG_WARN("GPU timing fence wait timed out, leaking timing objects");
+        return true;
+    }
+
+    release_objects(context);
+    SAFE_RELEASE(context->queue);
+
+    return true;
+}
+
+void GpuTimingD3D::release_objects(QueueContext* context)
+{
+    for (auto& slot : context->slots)
+    {
+        SAFE_RELEASE(slot.start_list);
+        SAFE_RELEASE(slot.end_list);
+        SAFE_RELEASE(slot.allocator);
+    }
+
+    SAFE_RELEASE(context->fence);
+    SAFE_RELEASE(context->readback);
+    SAFE_RELEASE(context->query_heap);
+}
+
+void GpuTimingD3D::deinit()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (auto& context : contexts)
+        release(context.get(), true);
+
+    contexts.clear();
+    current = nullptr;
+}
+
+bool GpuTimingD3D::calibrate(QueueContext* context)
+{
+    uint64_t gpu_timestamp = 0;
+    uint64_t cpu_qpc = 0;
+
+    if (context->queue->GetTimestampFrequency(&context->gpu_frequency) != S_OK || context->gpu_frequency == 0 ||
+        context->queue->GetClockCalibration(&gpu_timestamp, &cpu_qpc) != S_OK)
+    {
+        LOG_ERROR("Can't calibrate GPU clock");
+        return false;
+    }
+
+    // Markers use get_timestamp() (system time), bridge it from QPC
+    LARGE_INTEGER qpc_frequency;
+    LARGE_INTEGER qpc_now;
+    QueryPerformanceFrequency(&qpc_frequency);
+    QueryPerformanceCounter(&qpc_now);
+    auto now_us = get_timestamp() / 1000;
+
+    auto qpc_delta_us = (int64_t) ((qpc_now.QuadPart - (int64_t) cpu_qpc) * 1'000'000 / qpc_frequency.QuadPart);
+
+    context->calibration_gpu = gpu_timestamp;
+    context->calibration_us = now_us - qpc_delta_us;
+    context->frames_since_calibration = 0;
+
+    return true;
+}
+
+uint64_t GpuTimingD3D::to_report_us(const QueueContext* context, uint64_t gpu_timestamp)
+{
+    auto delta_ticks = (int64_t) (gpu_timestamp - context->calibration_gpu);
+    return context->calibration_us + (int64_t) ((double) delta_ticks * 1'000'000.0 / (double) context->gpu_frequency);
+}
+
+GpuTimingD3D::QueueContext* GpuTimingD3D::get_context(IUnknown* pDevice, ID3D12CommandQueue* pQueue)
+{
+    for (auto& context : contexts)
+    {
+        if (context->queue == pQueue)
+            return context.get();
+    }
+
+    if (contexts.size() >= GPU_TIMING_MAX_QUEUES)
+        return nullptr;
+
+    auto context = std::make_unique<QueueContext>();
+
+    // Game can release the queue at any time, keep it alive while it's timed
+    pQueue->AddRef();
+    context->queue = pQueue;
+
+    ID3D12Device* d3d12Device = nullptr;
+
+    // D3D11 devices stay unsupported
+    if (pDevice->QueryInterface(IID_PPV_ARGS(&d3d12Device)) == S_OK)
+    {
+        context->supported = init(context.get(), d3d12Device);
+        d3d12Device->Release();
+    }
+
+    // Nothing was submitted yet, only the queue reference is kept so it isn't retried
+    if (!context->supported)
+        release_objects(context.get());
+
+    contexts.push_back(std::move(context));
+    return contexts.back().get();
+}
+
+// Contexts of queues released by the game are dropped once their lists finished
+void GpuTimingD3D::retire_released_queues()
+{
+    for (auto it = contexts.begin(); it != contexts.end();)
+    {
+        auto context = it->get();
+
+        context->queue->AddRef();
+        bool released = context->queue->Release() == 1;
+
+        if (!released || !release(context, false))
+        {
+            it++;
+            continue;
+        }
+
+        if (current == context)
+            current = nullptr;
+
+        it = contexts.erase(it);
+    }
+}
+
+void GpuTimingD3D::render_submit_start(IUnknown* pDevice, ID3D12CommandQueue* pQueue, uint64_t frame_id)
+{
+    if (pDevice == nullptr || pQueue == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto context = get_context(pDevice, pQueue);
+    current = context;
+
+    if (context == nullptr || !context->supported)
+        return;
+
+    auto index = context->next_slot;
+    auto& slot = context->slots[index];
+
+    // Ring wrapped without a RENDERSUBMIT_END for this slot, expire it
+    if (slot.started)
+    {
+        LOG_DEBUG("Expiring GPU timing of frame {}", slot.frame_id);
+        slot.started = false;
+        slot.pending = false;
+    }
+
+    // Still in flight, drop this frame
+    if (context->fence->GetCompletedValue() < slot.fence_value)
+        return;
+
+    slot.pending = false;
+    context->next_slot = (context->next_slot + 1) % GPU_TIMING_SLOTS;
+
+    if (slot.allocator->Reset() != S_OK || slot.start_list->Reset(slot.allocator, nullptr) != S_OK)
+        return;
+
+    slot.start_list->EndQuery(context->query_heap, D3D12_QUERY_TYPE_TIMESTAMP, index * 2);
+    slot.start_list->Close();
+
+    ID3D12CommandList* lists[] = { slot.start_list };
+    context->queue->ExecuteCommandLists(1, lists);
+
+    // Allocator can't be reset before the start list finishes, even if the end never arrives
+    context->queue->Signal(context->fence, ++context->fence_value);
+
+    slot.fence_value = context->fence_value;
+    slot.frame_id = frame_id;
+    slot.started = true;
+}
+
+void GpuTimingD3D::render_submit_end(uint64_t frame_id)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    QueueContext* context = nullptr;
+    Slot* slot = nullptr;
+
+    for (auto& queueContext : contexts)
+    {
+        if (!queueContext->supported)
+            continue;
+
+        for (auto& started : queueContext->slots)
+        {
+            if (!started.started)
+                continue;
+
+            if (started.frame_id == frame_id)
+            {
+                context = queueContext.get();
+                slot = &started;
+            }
+            else if (started.frame_id < frame_id)
+            {
+                // Older frames that never got their end marker won't get one anymore
+                started.started = false;
+            }
+        }
+    }
+
+    if (slot == nullptr)
+        return;
+
+    auto index = (uint32_t) (slot - context->slots);
+    slot->started = false;
+
+    if (slot->end_list->Reset(slot->allocator, nullptr) != S_OK)
+        return;
+
+    slot->end_list->EndQuery(context->query_heap, D3D12_QUERY_TYPE_TIMESTAMP, index * 2 + 1);
+    slot->end_list->ResolveQueryData(context->query_heap, D3D12_QUERY_TYPE_TIMESTAMP, index * 2, 2,
+                                     context->readback, index * 2 * sizeof(uint64_t));
+    slot->end_list->Close();
+
+    ID3D12CommandList* lists[] = { slot->end_list };
+    context->queue->ExecuteCommandLists(1, lists);
+    context->queue->Signal(context->fence, ++context->fence_value);
+
+    slot->fence_value = context->fence_value;
+    slot->pending = true;
+}
+
+void GpuTimingD3D::present()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // GPU and CPU clocks drift apart over time
+    for (auto& context : contexts)
+    {
+        if (context->supported && ++context->frames_since_calibration > 300)
+            calibrate(context.get());
+    }
+
+    retire_released_queues();
+}
+
+void GpuTimingD3D::collect(const std::function<void(uint64_t frame_id, uint64_t start_us, uint64_t end_us)>& callback)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (auto& context : contexts)
+    {
+        if (!context->supported)
+            continue;
+
+        auto completed = context->fence->GetCompletedValue();
+
+        for (uint32_t i = 0; i < GPU_TIMING_SLOTS; i++)
+        {
+            auto& slot = context->slots[i];
+
+            if (!slot.pending || completed < slot.fence_value)
+                continue;
+
+            slot.pending = false;
+
+            D3D12_RANGE range { i * 2 * sizeof(uint64_t), (i * 2 + 2) * sizeof(uint64_t) };
+            uint64_t* data = nullptr;
+
+            if (context->readback->Map(0, &range, reinterpret_cast<void**>(&data)) != S_OK || data == nullptr)
+                continue;
+
+            auto start = data[i * 2];
+            auto end = data[i * 2 + 1];
+
+            D3D12_RANGE written { 0, 0 };
+            context->readback->Unmap(0, &written);
+
+            if (end > start)
+                callback(slot.frame_id, to_report_us(context.get(), start), to_report_us(context.get(), end));
+        }
+    }
+}
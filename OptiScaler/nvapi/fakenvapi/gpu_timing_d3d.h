@@ -0,0 +1,78 @@
+#pragma once
+
+#include <d3d12.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#define GPU_TIMING_SLOTS 16
+#define GPU_TIMING_MAX_QUEUES 4
+
+// Timestamps the game's render submission on its D3D12 queues, results are
+// converted to the get_timestamp() clock in microseconds like the CPU markers
+class GpuTimingD3D
+{
+  private:
+    struct Slot
+    {
+        ID3D12CommandAllocator* allocator = nullptr;
+        ID3D12GraphicsCommandList* start_list = nullptr;
+        ID3D12GraphicsCommandList* end_list = nullptr;
+        uint64_t frame_id = 0;
+        uint64_t fence_value = 0;
+        bool started = false;
+        bool pending = false;
+    };
+
+    // Timing objects of one game queue. The queue is referenced until the context is
+    // released, so a recycled pointer can't be mistaken for it
+    struct QueueContext
+    {
+        ID3D12CommandQueue* queue = nullptr;
+        bool supported = false;
+
+        ID3D12QueryHeap* query_heap = nullptr;
+        ID3D12Resource* readback = nullptr;
+        ID3D12Fence* fence = nullptr;
+        uint64_t fence_value = 0;
+
+        Slot slots[GPU_TIMING_SLOTS] {};
+        uint32_t next_slot = 0;
+
+        // GPU tick <-> report clock calibration
+        uint64_t gpu_frequency = 0;
+        uint64_t calibration_gpu = 0;
+        uint64_t calibration_us = 0;
+        uint32_t frames_since_calibration = 0;
+    };
+
+    std::mutex mutex;
+
+    std::vector<std::unique_ptr<QueueContext>> contexts;
+    QueueContext* current = nullptr;
+
+    bool init(QueueContext* context, ID3D12Device* device);
+    bool release(QueueContext* context, bool wait);
+    void release_objects(QueueContext* context);
+    bool calibrate(QueueContext* context);
+    QueueContext* get_context(IUnknown* pDevice, ID3D12CommandQueue* pQueue);
+    void retire_released_queues();
+
+    static uint64_t to_report_us(const QueueContext* context, uint64_t gpu_timestamp);
+
+  public:
+    ~GpuTimingD3D();
+
+    void deinit();
+    bool is_active() const { return current != nullptr && current->supported; }
+
+    void render_submit_start(IUnknown* pDevice, ID3D12CommandQueue* pQueue, uint64_t frame_id);
+    void render_submit_end(uint64_t frame_id);
+    void present();
+
+    // Calls back with GPU start / end in microseconds for every finished frame
+    void collect(const std::function<void(uint64_t frame_id, uint64_t start_us, uint64_t end_us)>& callback);
+};
@@ -42,7 +42,7 @@ bool LowLatency::deinit_current_tech()
 
         old_tech->deinit();
 
-        std::memset(frame_reports, 0, sizeof(frame_reports));
+        frame_reports.clear();
 
         return true;
     }
@@ -6,41 +6,25 @@
 #include <d3d12.h>
 
 #include "fn_util.h"
+#include "frame_reports.h"
+#include "gpu_timing_d3d.h"
 #include <optional>
 
-#define FRAME_REPORTS_BUFFER_SIZE 70
 #define NVAPI_BUFFER_SIZE 64
 
-struct FrameReport
-{
-    uint64_t frameID;
-    uint64_t inputSampleTime;
-    uint64_t simStartTime;
-    uint64_t simEndTime;
-    uint64_t renderSubmitStartTime;
-    uint64_t renderSubmitEndTime;
-    uint64_t presentStartTime;
-    uint64_t presentEndTime;
-    uint64_t driverStartTime;
-    uint64_t driverEndTime;
-    uint64_t osRenderQueueStartTime;
-    uint64_t osRenderQueueEndTime;
-    uint64_t gpuRenderStartTime;
-    uint64_t gpuRenderEndTime;
-    uint32_t gpuActiveRenderTimeUs;
-    uint32_t gpuFrameTimeUs;
-    uint8_t rsvd[120];
-};
-
 class LowLatency
 {
   private:
     std::atomic<std::shared_ptr<LowLatencyTech>> currently_active_tech;
-    FrameReport frame_reports[FRAME_REPORTS_BUFFER_SIZE] {};
+    FrameReports frame_reports;
     std::optional<bool> forced_fg;
     bool fg;
     uint32_t delay_deinit = 0;
 
+    // D3D12 only, GPU times of the reports come from here when active
+    GpuTimingD3D gpu_timing;
+    uint64_t last_gpu_end_us = 0;
+
     // Once set, it will be used for all init attempts
     void* forced_low_latency_context = nullptr;
     LowLatencyMode forced_low_latency_tech = LowLatencyMode::LatencyFlex;
@@ -52,6 +36,7 @@ class LowLatency
     bool update_low_latency_tech(IUnknown* pDevice);
     void get_latency_result(NV_LATENCY_RESULT_PARAMS* pGetLatencyParams);
     void add_marker_to_report(NV_LATENCY_MARKER_PARAMS* pSetLatencyMarkerParams);
+    void add_gpu_times_to_reports();
 
     // Vulkan
     bool update_low_latency_tech(HANDLE vkDevice);
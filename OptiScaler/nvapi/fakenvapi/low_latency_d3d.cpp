@@ -153,65 +153,43 @@ void LowLatency::get_latency_result(NV_LATENCY_RESULT_PARAMS* pGetLatencyParams)
 
     // Copy starting from older before wrapping around
     size_t firstChunk = std::min<uint64_t>(NVAPI_BUFFER_SIZE, FRAME_REPORTS_BUFFER_SIZE - minIdx);
-    std::memcpy(pGetLatencyParams->frameReport, frame_reports + minIdx, firstChunk * sizeof(FrameReport));
+    std::memcpy(pGetLatencyParams->frameReport, frame_reports.data() + minIdx, firstChunk * sizeof(FrameReport));
 
     // Copy the rest after wrapping around
     if (firstChunk < NVAPI_BUFFER_SIZE)
     {
-        std::memcpy(pGetLatencyParams->frameReport + firstChunk, frame_reports,
+        std::memcpy(pGetLatencyParams->frameReport + firstChunk, frame_reports.data(),
                     (NVAPI_BUFFER_SIZE - firstChunk) * sizeof(FrameReport));
     }
 }
 
 void LowLatency::add_marker_to_report(NV_LATENCY_MARKER_PARAMS* pSetLatencyMarkerParams)
 {
-    auto current_timestamp = get_timestamp() / 1000;
-    static auto last_sim_start = current_timestamp;
-    static auto _2nd_last_sim_start = current_timestamp;
-    auto current_report = &frame_reports[pSetLatencyMarkerParams->frameID % FRAME_REPORTS_BUFFER_SIZE];
+    // Placeholders for the GPU times, real values are filled by add_gpu_times_to_reports
+    frame_reports.add_marker(pSetLatencyMarkerParams->frameID, (MarkerType) pSetLatencyMarkerParams->markerType,
+                             !gpu_timing.is_active());
+}
 
-    if (current_report->frameID != pSetLatencyMarkerParams->frameID)
-    {
-        *current_report = FrameReport {};
-    }
+void LowLatency::add_gpu_times_to_reports()
+{
+    gpu_timing.collect(
+        [this](uint64_t frame_id, uint64_t start_us, uint64_t end_us)
+        {
+            auto report = &frame_reports[frame_id % FRAME_REPORTS_BUFFER_SIZE];
 
-    current_report->frameID = pSetLatencyMarkerParams->frameID;
-    current_report->gpuFrameTimeUs = (uint32_t) (last_sim_start - _2nd_last_sim_start);
-    current_report->gpuActiveRenderTimeUs = 100;
-    current_report->driverStartTime = current_timestamp;
-    current_report->driverEndTime = current_timestamp + 100;
-    current_report->gpuRenderStartTime = current_timestamp;
-    current_report->gpuRenderEndTime = current_timestamp + 100;
-    current_report->osRenderQueueStartTime = current_timestamp;
-    current_report->osRenderQueueEndTime = current_timestamp + 100;
-    switch (pSetLatencyMarkerParams->markerType)
-    {
-    case SIMULATION_START:
-        _2nd_last_sim_start = last_sim_start;
-        last_sim_start = get_timestamp() / 1000;
-        current_report->simStartTime = last_sim_start;
-        break;
-    case SIMULATION_END:
-        current_report->simEndTime = get_timestamp() / 1000;
-        break;
-    case RENDERSUBMIT_START:
-        current_report->renderSubmitStartTime = get_timestamp() / 1000;
-        break;
-    case RENDERSUBMIT_END:
-        current_report->renderSubmitEndTime = get_timestamp() / 1000;
-        break;
-    case PRESENT_START:
-        current_report->presentStartTime = get_timestamp() / 1000;
-        break;
-    case PRESENT_END:
-        current_report->presentEndTime = get_timestamp() / 1000;
-        break;
-    case INPUT_SAMPLE:
-        current_report->inputSampleTime = get_timestamp() / 1000;
-        break;
-    default:
-        break;
-    }
+            // Slot already reused by a newer frame
+            if (report->frameID != frame_id)
+                return;
+
+            report->gpuRenderStartTime = start_us;
+            report->gpuRenderEndTime = end_us;
+            report->gpuActiveRenderTimeUs = (uint32_t) (end_us - start_us);
+            report->gpuFrameTimeUs = last_gpu_end_us != 0 && end_us > last_gpu_end_us
+                                         ? (uint32_t) (end_us - last_gpu_end_us)
+                                         : report->gpuActiveRenderTimeUs;
+
+            last_gpu_end_us = end_us;
+        });
 }
 
 // public
@@ -272,6 +250,30 @@ NvAPI_Status LowLatency::SetLatencyMarker(IUnknown* pDev, NV_LATENCY_MARKER_PARA
 
     add_marker_to_report(pSetLatencyMarkerParams);
 
+    if (Config::Instance()->FN_GpuTimestamps.value_or_default())
+    {
+        if (pSetLatencyMarkerParams->markerType == RENDERSUBMIT_START)
+        {
+            gpu_timing.render_submit_start(pDev, State::Instance().currentCommandQueue,
+                                           pSetLatencyMarkerParams->frameID);
+        }
+        else if (pSetLatencyMarkerParams->markerType == RENDERSUBMIT_END)
+        {
+            gpu_timing.render_submit_end(pSetLatencyMarkerParams->frameID);
+        }
+        else if (pSetLatencyMarkerParams->markerType == PRESENT_START)
+        {
+            gpu_timing.present();
+        }
+
+        add_gpu_times_to_reports();
+    }
+    else
+    {
+        // Also drops the references of the timed queues
+        gpu_timing.deinit();
+    }
+
     MarkerParams marker_params {};
 
     marker_params.frame_id = pSetLatencyMarkerParams->frameID;
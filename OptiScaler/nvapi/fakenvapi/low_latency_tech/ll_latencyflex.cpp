@@ -10,10 +10,9 @@ void LatencyFlex::lfx_sleep(uint64_t reflex_frame_id)
 
     deinit_mutex.lock();
 
-    static LFXMode previous_lfx_mode = (LFXMode) Config::Instance()->FN_LatencyFlexMode.value_or_default();
-    LFXMode lfx_mode = (LFXMode) Config::Instance()->FN_LatencyFlexMode.value_or_default();
+    LFXMode lfx_mode = get_lfx_mode();
 
-    if (previous_lfx_mode != lfx_mode)
+    if (previous_lfx_mode.has_value() && previous_lfx_mode.value() != lfx_mode)
         needs_reset = true;
 
     previous_lfx_mode = lfx_mode;
@@ -47,7 +46,6 @@ void LatencyFlex::lfx_sleep(uint64_t reflex_frame_id)
 
     if (target > current_timestamp)
     {
-        static uint64_t timeout_events = 0;
         uint64_t timeout_timestamp = current_timestamp + 50000000ULL;
         if (target > timeout_timestamp)
         {
@@ -87,9 +85,7 @@ void LatencyFlex::lfx_end_frame(uint64_t reflex_frame_id)
 {
     auto current_timestamp = get_timestamp();
     mutex.lock();
-    auto frame_id = (LFXMode) Config::Instance()->FN_LatencyFlexMode.value_or_default() == LFXMode::ReflexIDs
-                        ? reflex_frame_id
-                        : this->frame_id;
+    auto frame_id = get_lfx_mode() == LFXMode::ReflexIDs ? reflex_frame_id : this->frame_id;
     // log_event("lfx_endframe", "{}", frame_id);
     if (ctx)
         ctx->EndFrame(frame_id, current_timestamp, &latency, &frame_time);
@@ -154,7 +150,7 @@ void LatencyFlex::set_sleep_mode(SleepMode* sleep_mode)
 
 void LatencyFlex::sleep()
 {
-    if ((LFXMode) Config::Instance()->FN_LatencyFlexMode.value_or_default() != LFXMode::ReflexIDs)
+    if (get_lfx_mode() != LFXMode::ReflexIDs)
     {
         last_sleep_framecount = simulation_framecount;
 
@@ -180,7 +176,7 @@ void LatencyFlex::set_marker(IUnknown* pDevice, MarkerParams* marker_params)
         break;
 
     case MarkerType::RENDERSUBMIT_END:
-        if ((LFXMode) Config::Instance()->FN_LatencyFlexMode.value_or_default() != LFXMode::Conservative)
+        if (get_lfx_mode() != LFXMode::Conservative)
             lfx_end_frame(marker_params->frame_id);
         break;
     }
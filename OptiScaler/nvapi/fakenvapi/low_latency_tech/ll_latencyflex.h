@@ -3,6 +3,9 @@
 #include "low_latency_tech.h"
 #include <latencyflex.h>
 
+#include "config.h"
+#include <optional>
+
 class LatencyFlex : public virtual LowLatencyTech
 {
   private:
@@ -22,6 +25,15 @@ class LatencyFlex : public virtual LowLatencyTech
     uint64_t target = 0;
     uint64_t frame_id = 0;
     bool needs_reset = false;
+    uint64_t timeout_events = 0;
+
+    std::optional<LFXMode> previous_lfx_mode;
+    std::optional<LFXMode> lfx_mode_override;
+
+    LFXMode get_lfx_mode() const
+    {
+        return lfx_mode_override.value_or((LFXMode) Config::Instance()->FN_LatencyFlexMode.value_or_default());
+    }
 
     void lfx_sleep(uint64_t frame_id);
     void lfx_end_frame(uint64_t frame_id);
@@ -54,4 +66,7 @@ class LatencyFlex : public virtual LowLatencyTech
     void sleep() override;
     void set_marker(IUnknown* pDevice, MarkerParams* marker_params) override;
     void set_async_marker(MarkerParams* marker_params) override {}; // Not used by LFX
+
+    // Pins the mode instead of following FN_LatencyFlexMode (pacing simulator)
+    void set_lfx_mode_override(std::optional<LFXMode> mode) { lfx_mode_override = mode; };
 };
\ No newline at end of file
@@ -3,7 +3,7 @@
 #include <dxgi.h>
 #include <d3d12.h>
 
-#include "../log.h"
+#include <nvapi/fakenvapi/log.h>
 #include <magic_enum.hpp>
 
 #define INVALID_ID 0xFFFFFFFFFFFFFFFF
@@ -89,12 +89,12 @@ void LowLatency::get_latency_result(NV_VULKAN_LATENCY_RESULT_PARAMS* pGetLatency
 
     // Copy starting from older before wrapping around
     size_t firstChunk = std::min<uint64_t>(NVAPI_BUFFER_SIZE, FRAME_REPORTS_BUFFER_SIZE - minIdx);
-    std::memcpy(pGetLatencyParams->frameReport, frame_reports + minIdx, firstChunk * sizeof(FrameReport));
+    std::memcpy(pGetLatencyParams->frameReport, frame_reports.data() + minIdx, firstChunk * sizeof(FrameReport));
 
     // Copy the rest after wrapping around
     if (firstChunk < NVAPI_BUFFER_SIZE)
     {
-        std::memcpy(pGetLatencyParams->frameReport + firstChunk, frame_reports,
+        std::memcpy(pGetLatencyParams->frameReport + firstChunk, frame_reports.data(),
                     (NVAPI_BUFFER_SIZE - firstChunk) * sizeof(FrameReport));
     }
 
@@ -108,53 +108,9 @@ void LowLatency::get_latency_result(NV_VULKAN_LATENCY_RESULT_PARAMS* pGetLatency
 
 void LowLatency::add_marker_to_report(NV_VULKAN_LATENCY_MARKER_PARAMS* pSetLatencyMarkerParams)
 {
-    auto current_timestamp = get_timestamp() / 1000;
-    static auto last_sim_start = current_timestamp;
-    static auto _2nd_last_sim_start = current_timestamp;
-    auto current_report = &frame_reports[pSetLatencyMarkerParams->frameID % FRAME_REPORTS_BUFFER_SIZE];
-
-    if (current_report->frameID != pSetLatencyMarkerParams->frameID)
-    {
-        *current_report = FrameReport {};
-    }
-
-    current_report->frameID = pSetLatencyMarkerParams->frameID;
-    current_report->gpuFrameTimeUs = (uint32_t) (last_sim_start - _2nd_last_sim_start);
-    current_report->gpuActiveRenderTimeUs = 100;
-    current_report->driverStartTime = current_timestamp;
-    current_report->driverEndTime = current_timestamp + 100;
-    current_report->gpuRenderStartTime = current_timestamp;
-    current_report->gpuRenderEndTime = current_timestamp + 100;
-    current_report->osRenderQueueStartTime = current_timestamp;
-    current_report->osRenderQueueEndTime = current_timestamp + 100;
-    switch (pSetLatencyMarkerParams->markerType)
-    {
-    case VULKAN_SIMULATION_START:
-        _2nd_last_sim_start = last_sim_start;
-        last_sim_start = get_timestamp() / 1000;
-        current_report->simStartTime = last_sim_start;
-        break;
-    case VULKAN_SIMULATION_END:
-        current_report->simEndTime = get_timestamp() / 1000;
-        break;
-    case VULKAN_RENDERSUBMIT_START:
-        current_report->renderSubmitStartTime = get_timestamp() / 1000;
-        break;
-    case VULKAN_RENDERSUBMIT_END:
-        current_report->renderSubmitEndTime = get_timestamp() / 1000;
-        break;
-    case VULKAN_PRESENT_START:
-        current_report->presentStartTime = get_timestamp() / 1000;
-        break;
-    case VULKAN_PRESENT_END:
-        current_report->presentEndTime = get_timestamp() / 1000;
-        break;
-    case VULKAN_INPUT_SAMPLE:
-        current_report->inputSampleTime = get_timestamp() / 1000;
-        break;
-    default:
-        break;
-    }
+    // GPU times stay placeholders, the marker API has no queue to write timestamps to.
+    // VK_EXT_calibrated_timestamps would need the game's VkQueue, Dx12 gets it from State::currentCommandQueue
+    frame_reports.add_marker(pSetLatencyMarkerParams->frameID, (MarkerType) pSetLatencyMarkerParams->markerType, true);
 }
 
 // public
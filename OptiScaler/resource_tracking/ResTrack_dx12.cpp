@@ -4,6 +4,7 @@
 #include <Config.h>
 #include <State.h>
 #include <Util.h>
+#include <misc/VramRegistry.h>
 
 #include <menu/menu_overlay_dx.h>
 
@@ -243,6 +244,7 @@ bool ResTrack_Dx12::CreateBufferResource(ID3D12Device* InDevice, ResourceInfo* I
     }
 
     (*OutResource)->SetName(L"fgHudlessSCBufferCopy");
+    VramRegistry::Instance().Track(*OutResource, "Resource Tracking", "Hudless swapchain copy");
     return true;
 }
 
@@ -520,6 +522,9 @@ void ResTrack_Dx12::FillResourceInfo(ID3D12Resource* resource, ResourceInfo* inf
     info->height = desc.Height;
     info->format = desc.Format;
     info->flags = desc.Flags;
+
+    // Hudless checks use this snapshot instead of calling GetDesc on every draw & dispatch
+    Hudfix_Dx12::MatchSwapchain(info);
 }
 
 bool ResTrack_Dx12::IsHudFixActive()
@@ -1162,7 +1167,7 @@ void ResTrack_Dx12::hkSetGraphicsRootDescriptorTable(ID3D12GraphicsCommandList*
     // Consistent early exit - always call original function
     auto shouldTrack = !Config::Instance()->FGHudfixDisableSGR.value_or_default() && BaseDescriptor.ptr != 0 &&
                        IsHudFixActive() && !Hudfix_Dx12::SkipHudlessChecks() &&
-                       This != MenuOverlayDx::MenuCommandList();
+                       !MenuOverlayDx::IsMenuCommandList(This);
 
     if (!shouldTrack)
     {
@@ -1258,7 +1263,7 @@ void ResTrack_Dx12::hkOMSetRenderTargets(ID3D12GraphicsCommandList* This, UINT N
     // Consistent early exit validation
     auto shouldTrack = !Config::Instance()->FGHudfixDisableOM.value_or_default() && NumRenderTargetDescriptors > 0 &&
                        pRenderTargetDescriptors != nullptr && IsHudFixActive() && !Hudfix_Dx12::SkipHudlessChecks() &&
-                       This != MenuOverlayDx::MenuCommandList();
+                       !MenuOverlayDx::IsMenuCommandList(This);
 
     if (!shouldTrack)
     {
@@ -1377,7 +1382,7 @@ void ResTrack_Dx12::hkSetComputeRootDescriptorTable(ID3D12GraphicsCommandList* T
     // Consistent early exit - always call original function
     auto shouldTrack = !Config::Instance()->FGHudfixDisableSCR.value_or_default() && BaseDescriptor.ptr != 0 &&
                        IsHudFixActive() && !Hudfix_Dx12::SkipHudlessChecks() &&
-                       This != MenuOverlayDx::MenuCommandList();
+                       !MenuOverlayDx::IsMenuCommandList(This);
 
     if (!shouldTrack)
     {
@@ -1487,7 +1492,7 @@ void ResTrack_Dx12::hkDrawInstanced(ID3D12GraphicsCommandList* This, UINT Vertex
 
     if (!_useShards)
     {
-        if (This == MenuOverlayDx::MenuCommandList())
+        if (MenuOverlayDx::IsMenuCommandList(This))
         {
             std::lock_guard<std::mutex> lock(_hudlessTrackMutex);
             fgPossibleHudless[fIndex].erase(This);
@@ -1530,7 +1535,7 @@ void ResTrack_Dx12::hkDrawInstanced(ID3D12GraphicsCommandList* This, UINT Vertex
         size_t shardIdx = GetShardIndex(This);
         auto& shard = _hudlessShards[fIndex][shardIdx];
 
-        if (This == MenuOverlayDx::MenuCommandList() && shard.map.contains(This))
+        if (MenuOverlayDx::IsMenuCommandList(This) && shard.map.contains(This))
         {
 #ifdef USE_SPINLOCK_MUTEX
             std::lock_guard<SpinLock> lock(shard.mutex);
@@ -1607,7 +1612,7 @@ void ResTrack_Dx12::hkDrawIndexedInstanced(ID3D12GraphicsCommandList* This, UINT
 
     if (!_useShards)
     {
-        if (This == MenuOverlayDx::MenuCommandList())
+        if (MenuOverlayDx::IsMenuCommandList(This))
         {
             std::lock_guard<std::mutex> lock(_hudlessTrackMutex);
             fgPossibleHudless[fIndex].erase(This);
@@ -1650,7 +1655,7 @@ void ResTrack_Dx12::hkDrawIndexedInstanced(ID3D12GraphicsCommandList* This, UINT
         size_t shardIdx = GetShardIndex(This);
         auto& shard = _hudlessShards[fIndex][shardIdx];
 
-        if (This == MenuOverlayDx::MenuCommandList() && shard.map.contains(This))
+        if (MenuOverlayDx::IsMenuCommandList(This) && shard.map.contains(This))
         {
 #ifdef USE_SPINLOCK_MUTEX
             std::lock_guard<SpinLock> lock(shard.mutex);
@@ -1799,7 +1804,7 @@ void ResTrack_Dx12::hkDispatch(ID3D12GraphicsCommandList* This, UINT ThreadGroup
 
     if (!_useShards)
     {
-        if (This == MenuOverlayDx::MenuCommandList())
+        if (MenuOverlayDx::IsMenuCommandList(This))
         {
             std::lock_guard<std::mutex> lock(_hudlessTrackMutex);
             fgPossibleHudless[fIndex].erase(This);
@@ -1841,7 +1846,7 @@ void ResTrack_Dx12::hkDispatch(ID3D12GraphicsCommandList* This, UINT ThreadGroup
         size_t shardIdx = GetShardIndex(This);
         auto& shard = _hudlessShards[fIndex][shardIdx];
 
-        if (This == MenuOverlayDx::MenuCommandList() && shard.map.contains(This))
+        if (MenuOverlayDx::IsMenuCommandList(This) && shard.map.contains(This))
         {
 #ifdef USE_SPINLOCK_MUTEX
             std::lock_guard<SpinLock> lock(shard.mutex);
@@ -1,6 +1,7 @@
 #include "pch.h"
 #include "Shader_Dx12.h"
 #include <d3dx/d3dx12.h>
+#include <misc/VramRegistry.h>
 
 using Microsoft::WRL::ComPtr;
 
@@ -94,8 +95,8 @@ bool Shader_Dx12::CreateComputePipeline(ID3D12Device* device, ID3D12PipelineStat
 {
     ComPtr<ID3DBlob> shaderBlob;
 
-    // Compile if not using precompiled
-    if (!Config::Instance()->UsePrecompiledShaders.value_or_default() && source)
+    // Compile if not using precompiled or there is no precompiled variant of it
+    if ((!Config::Instance()->UsePrecompiledShaders.value_or_default() || bytecode == nullptr) && source)
         shaderBlob = CompileShader(source, "CSMain", "cs_5_0");
 
     return CreateComputeShader(device, _rootSignature, pipelineState, shaderBlob.Get(),
@@ -110,6 +111,8 @@ bool Shader_Dx12::CreateBufferResource(ID3D12Device* InDevice, ID3D12Resource* I
     if (InDevice == nullptr || InResource == nullptr)
         return false;
 
+    _lastBufferUse = State::Instance().frameCount;
+
     auto inDesc = InResource->GetDesc();
 
     if (InWidth != 0 && InHeight != 0)
@@ -159,24 +162,22 @@ bool Shader_Dx12::CreateBufferResource(ID3D12Device* InDevice, ID3D12Resource* I
     }
 
     LOG_DEBUG("Created new one: {}x{}", inDesc.Width, inDesc.Height);
+    VramRegistry::Instance().Track(*OutResource, _name, "Pass buffer");
+
     return true;
 }
 
+uint64_t Shader_Dx12::IdleFrames() const
+{
+    auto frame = State::Instance().frameCount;
+    return frame > _lastBufferUse ? frame - _lastBufferUse : 0;
+}
+
 void Shader_Dx12::SetBufferState(ID3D12GraphicsCommandList* InCommandList, D3D12_RESOURCE_STATES InState,
                                  ID3D12Resource* Buffer, D3D12_RESOURCE_STATES* BufferState)
 {
-    if (BufferState == nullptr || *BufferState == InState)
-        return;
-
-    D3D12_RESOURCE_BARRIER barrier = {};
-    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    barrier.Transition.pResource = Buffer;
-    barrier.Transition.StateBefore = *BufferState;
-    barrier.Transition.StateAfter = InState;
-    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-    InCommandList->ResourceBarrier(1, &barrier);
-
-    *BufferState = InState;
+    BarrierBatch barriers(InCommandList);
+    barriers.Transition(Buffer, BufferState, InState);
 }
 
 // From DirectXHelpers.cpp licensed under MIT
@@ -1,6 +1,7 @@
 #pragma once
 #include <d3d12.h>
 #include "Shader_Common.h"
+#include "Shader_Dx12Barriers.h"
 
 class Shader_Dx12
 {
@@ -15,6 +16,7 @@ class Shader_Dx12
     std::string _name = "";
     bool _init = false;
     int _counter = 0;
+    uint64_t _lastBufferUse = 0; // Present frame of the last CreateBufferResource call
 
     ID3D12RootSignature* _rootSignature = nullptr;
     ID3D12PipelineState* _pipelineState = nullptr;
@@ -24,16 +26,14 @@ class Shader_Dx12
 
     std::vector<CD3DX12_DESCRIPTOR_RANGE1> _descriptorRanges;
 
-    static DXGI_FORMAT TranslateTypelessFormats(DXGI_FORMAT format);
     static bool CreateComputeShader(ID3D12Device* device, ID3D12RootSignature* rootSignature,
                                     ID3D12PipelineState** pipelineState, ID3DBlob* shaderBlob,
                                     D3D12_SHADER_BYTECODE byteCode);
     bool CreateComputePipeline(ID3D12Device* device, ID3D12PipelineState** pipelineState, const void* bytecode,
                                size_t bytecodeSize, const char* source);
-    static bool CreateBufferResource(ID3D12Device* InDevice, ID3D12Resource* InResource, D3D12_RESOURCE_STATES InState,
-                                     ID3D12Resource** OutResource, D3D12_RESOURCE_FLAGS ResourceFlags,
-                                     uint64_t InWidth = 0, uint32_t InHeight = 0,
-                                     DXGI_FORMAT InFormat = DXGI_FORMAT_UNKNOWN);
+    bool CreateBufferResource(ID3D12Device* InDevice, ID3D12Resource* InResource, D3D12_RESOURCE_STATES InState,
+                              ID3D12Resource** OutResource, D3D12_RESOURCE_FLAGS ResourceFlags, uint64_t InWidth = 0,
+                              uint32_t InHeight = 0, DXGI_FORMAT InFormat = DXGI_FORMAT_UNKNOWN);
     static void SetBufferState(ID3D12GraphicsCommandList* InCommandList, D3D12_RESOURCE_STATES InState,
                                ID3D12Resource* Buffer, D3D12_RESOURCE_STATES* BufferState);
 
@@ -53,8 +53,13 @@ class Shader_Dx12
     bool InitHeaps(ID3D12Device* InDevice, FrameDescriptorHeap* pHeaps, size_t numOFHeaps);
 
   public:
+    static DXGI_FORMAT TranslateTypelessFormats(DXGI_FORMAT format);
+
     bool IsInit() const { return _init; }
 
+    // Presents since the buffer was last requested, passes request their buffer every frame they run
+    uint64_t IdleFrames() const;
+
     Shader_Dx12(std::string InName, ID3D12Device* InDevice);
 
     ~Shader_Dx12();
@@ -0,0 +1,102 @@
+#pragma once
+#include <d3d12.h>
+
+// Collects the transitions of a pass on one command list and issues them with a single
+// ResourceBarrier call. Only transitions which change something reach the command list:
+//  - A transition into the state the resource is already in is dropped
+//  - Transitions of a resource waiting in the batch are merged, A->B & B->C becomes A->C
+//    and A->B & B->A cancel out
+// Flush before recording work which uses the resources, destructor flushes the rest.
+class BarrierBatch
+{
+  public:
+    static constexpr UINT Capacity = 16;
+
+    explicit BarrierBatch(ID3D12GraphicsCommandList* cmdList) : _cmdList(cmdList) {}
+    ~BarrierBatch() { Flush(); }
+
+    BarrierBatch(const BarrierBatch&) = delete;
+    BarrierBatch& operator=(const BarrierBatch&) = delete;
+
+    void Transition(ID3D12Resource* resource, D3D12_RESOURCE_STATES before, D3D12_RESOURCE_STATES after)
+    {
+        if (resource == nullptr || before == after)
+            return;
+
+        for (UINT i = 0; i < _count; i++)
+        {
+            auto& transition = _barriers[i].Transition;
+
+            if (transition.pResource != resource)
+                continue;
+
+            // Caller's idea of the state doesn't match the batch, keep both in order
+            if (transition.StateAfter != before)
+            {
+                Flush();
+                break;
+            }
+
+            transition.StateAfter = after;
+
+            if (transition.StateBefore == transition.StateAfter)
+                Remove(i);
+
+            return;
+        }
+
+        if (_count == Capacity)
+            Flush();
+
+        auto& barrier = _barriers[_count++];
+        barrier = {};
+        barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+        barrier.Transition.pResource = resource;
+        barrier.Transition.StateBefore = before;
+        barrier.Transition.StateAfter = after;
+        barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+    }
+
+    // For resources whose state is tracked by their owner, state is updated
+    void Transition(ID3D12Resource* resource, D3D12_RESOURCE_STATES* state, D3D12_RESOURCE_STATES after)
+    {
+        if (state == nullptr)
+            return;
+
+        Transition(resource, *state, after);
+        *state = after;
+    }
+
+    void Flush()
+    {
+        if (_count == 0)
+            return;
+
+        _cmdList->ResourceBarrier(_count, _barriers);
+        _count = 0;
+    }
+
+    UINT Pending() const { return _count; }
+
+  private:
+    ID3D12GraphicsCommandList* _cmdList = nullptr;
+    D3D12_RESOURCE_BARRIER _barriers[Capacity] {};
+    UINT _count = 0;
+
+    // Keeps the order, expected barrier lists stay readable in logs & captures
+    void Remove(UINT index)
+    {
+        for (UINT i = index + 1; i < _count; i++)
+            _barriers[i - 1] = _barriers[i];
+
+        _count--;
+    }
+};
+
+// Single transition, for call sites which record work right after it
+inline void ResourceTransition(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* resource,
+                               D3D12_RESOURCE_STATES before, D3D12_RESOURCE_STATES after)
+{
+    BarrierBatch barriers(cmdList);
+    barriers.Transition(resource, before, after);
+}
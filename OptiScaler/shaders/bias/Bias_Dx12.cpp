@@ -22,6 +22,12 @@ bool Bias_Dx12::CreateBufferResource(ID3D12Device* InDevice, ID3D12Resource* InS
     return result;
 }
 
+void Bias_Dx12::ReleaseBuffer()
+{
+    SAFE_RELEASE(_buffer);
+    _bufferState = D3D12_RESOURCE_STATE_COMMON;
+}
+
 void Bias_Dx12::SetBufferState(ID3D12GraphicsCommandList* InCommandList, D3D12_RESOURCE_STATES InState)
 {
     return Shader_Dx12::SetBufferState(InCommandList, InState, _buffer, &_bufferState);
@@ -29,6 +29,7 @@ class Bias_Dx12 : public Shader_Dx12
                   ID3D12Resource* OutResource);
 
     ID3D12Resource* Buffer() { return _buffer; }
+    void ReleaseBuffer();
     bool CanRender() const { return _init && _buffer != nullptr; }
 
     Bias_Dx12(std::string InName, ID3D12Device* InDevice);
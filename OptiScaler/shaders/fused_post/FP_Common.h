@@ -0,0 +1,466 @@
+#pragma once
+
+#include "SysUtils.h"
+#include "Config.h"
+
+// Sharpening done inside the fused pass
+enum class FPSharpen : uint32_t
+{
+    None = 0,
+    RCAS = 1,
+    Count
+};
+
+// How the result is stored to the output resource
+enum class FPOutput : uint32_t
+{
+    Float = 0, // HDR / float targets, no clamping
+    Unorm = 1, // UNORM targets, saturated before store
+    Count
+};
+
+struct FPPermutation
+{
+    FPSharpen Sharpen = FPSharpen::None;
+    Scaler Downscaler = Scaler::Bicubic;
+    FPOutput Output = FPOutput::Float;
+
+    uint32_t Key() const
+    {
+        return ((uint32_t) Sharpen << 8) | ((uint32_t) Output << 4) | (uint32_t) Downscaler;
+    }
+
+    std::string Name() const
+    {
+        static const char* scalerNames[] = { "FSR1",     "Bicubic", "CatmullRom", "Lanczos2",
+                                             "Lanczos3", "Kaiser2", "Kaiser3",    "Magic" };
+
+        auto scalerIndex = (uint32_t) Downscaler;
+        return std::format("{}+{}+{}", scalerIndex < std::size(scalerNames) ? scalerNames[scalerIndex] : "Unknown",
+                           Sharpen == FPSharpen::RCAS ? "RCAS" : "NoSharpen",
+                           Output == FPOutput::Unorm ? "Unorm" : "Float");
+    }
+};
+
+struct alignas(256) FPConstants
+{
+    int32_t SrcWidth;
+    int32_t SrcHeight;
+    int32_t DstWidth;
+    int32_t DstHeight;
+
+    // RCAS
+    float Sharpness;
+    float Contrast;
+
+    // Motion Vector Stuff
+    int32_t DynamicSharpenEnabled;
+    int32_t DisplaySizeMV;
+    int32_t Debug;
+    int32_t MotionWidth;
+    int32_t MotionHeight;
+
+    float MotionSharpness;
+    float MotionTextureScale;
+    float MvScaleX;
+    float MvScaleY;
+    float Threshold;
+    float ScaleLimit;
+};
+
+// Output scaling + RCAS + format transfer in a single dispatch
+// Permutation macros are prepended when the pipeline is created
+//   FP_SHARPEN : 0 = none, 1 = RCAS
+//   FP_SCALER  : Scaler enum value, only the fixed footprint filters (Bicubic .. Kaiser3) are supported
+// Resampling is the same math as the standalone downscalers in OS_Common.h, fused and separate paths match
+//   FP_OUTPUT  : 0 = float target, 1 = UNORM target
+// With RCAS the resampled tile plus a one pixel apron is kept in LDS,
+// so the full resolution intermediate never goes through VRAM
+inline static std::string fusedPostCode = R"(
+cbuffer Params : register(b0)
+{
+    int SrcWidth;
+    int SrcHeight;
+    int DstWidth;
+    int DstHeight;
+
+    float Sharpness;
+    float Contrast;
+
+    int DynamicSharpenEnabled;
+    int DisplaySizeMV;
+    int Debug;
+    int MotionWidth;
+    int MotionHeight;
+
+    float MotionSharpness;
+    float MotionTextureScale;
+    float MvScaleX;
+    float MvScaleY;
+    float Threshold;
+    float ScaleLimit;
+};
+
+Texture2D<float4> InputTexture : register(t0);
+Texture2D<float2> Motion : register(t1);
+RWTexture2D<float4> OutputTexture : register(u0);
+SamplerState LinearClampSampler : register(s0);
+
+#define TILE_SIZE 16
+#define APRON 1
+#define LDS_SIZE (TILE_SIZE + 2 * APRON)
+#define LDS_COUNT (LDS_SIZE * LDS_SIZE)
+
+static float Sinc(float x)
+{
+    x *= 3.1415926535f;
+    if (abs(x) < 1e-5f)
+        return 1.0f;
+    return sin(x) / x;
+}
+
+#if FP_SCALER == 1 || FP_SCALER == 2
+
+// Keys cubic, same A values as the standalone shaders
+#if FP_SCALER == 1
+static const float A = -0.6f;
+#else
+static const float A = -0.45f;
+#endif
+
+static float CubicKeys(float x)
+{
+    x = abs(x);
+    float x2 = x * x;
+    float x3 = x2 * x;
+
+    if (x < 1.0f)
+        return (A + 2.0f) * x3 - (A + 3.0f) * x2 + 1.0f;
+    else if (x < 2.0f)
+        return A * x3 - 5.0f * A * x2 + 8.0f * A * x - 4.0f * A;
+
+    return 0.0f;
+}
+
+// 4 cubic taps as 2 bilinear taps per axis, same as downsampleCodeBC / downsampleCodeCatmull
+static void BicubicAxis(float t, out float w01, out float w23, out float o01, out float o23)
+{
+    float w0 = CubicKeys(1.0f + t);
+    float w1 = CubicKeys(t);
+    float w2 = CubicKeys(1.0f - t);
+    float w3 = CubicKeys(2.0f - t);
+
+    w01 = w0 + w1;
+    w23 = w2 + w3;
+
+    float invW01 = (w01 != 0.0f) ? (1.0f / w01) : 0.0f;
+    float invW23 = (w23 != 0.0f) ? (1.0f / w23) : 0.0f;
+
+    o01 = (-1.0f) + (w1 * invW01);
+    o23 = (1.0f) + (w3 * invW23);
+}
+
+float3 Resample(int2 dstPixel)
+{
+    float2 scale = float2((float) SrcWidth / (float) DstWidth, (float) SrcHeight / (float) DstHeight);
+    float2 srcPos = (float2(dstPixel) + 0.5f) * scale - 0.5f;
+
+    float2 ip = floor(srcPos);
+    float2 f = srcPos - ip;
+    float2 base = ip - 1.0f;
+
+    float wx01, wx23, ox01, ox23;
+    float wy01, wy23, oy01, oy23;
+    BicubicAxis(f.x, wx01, wx23, ox01, ox23);
+    BicubicAxis(f.y, wy01, wy23, oy01, oy23);
+
+    float2 invSrc = 1.0f / float2((float) SrcWidth, (float) SrcHeight);
+
+    float2 uv00 = (base + float2(ox01, oy01) + 0.5f) * invSrc;
+    float2 uv10 = (base + float2(ox23, oy01) + 0.5f) * invSrc;
+    float2 uv01 = (base + float2(ox01, oy23) + 0.5f) * invSrc;
+    float2 uv11 = (base + float2(ox23, oy23) + 0.5f) * invSrc;
+
+    float3 s00 = InputTexture.SampleLevel(LinearClampSampler, uv00, 0.0f).rgb;
+    float3 s10 = InputTexture.SampleLevel(LinearClampSampler, uv10, 0.0f).rgb;
+    float3 s01 = InputTexture.SampleLevel(LinearClampSampler, uv01, 0.0f).rgb;
+    float3 s11 = InputTexture.SampleLevel(LinearClampSampler, uv11, 0.0f).rgb;
+
+    float3 outRgb = (s00 * wx01 + s10 * wx23) * wy01 + (s01 * wx01 + s11 * wx23) * wy23;
+
+    // Same ringing clamp as the standalone shaders, over the 4 bilinear samples
+    float3 mn = min(min(s00, s10), min(s01, s11));
+    float3 mx = max(max(s00, s10), max(s01, s11));
+    return clamp(outRgb, mn, mx);
+}
+
+#else
+
+#if FP_SCALER == 3 || FP_SCALER == 4
+
+#if FP_SCALER == 3
+#define KERNEL_RADIUS 2
+#else
+#define KERNEL_RADIUS 3
+#endif
+
+static float Kernel(float x)
+{
+    if (abs(x) >= (float) KERNEL_RADIUS)
+        return 0.0f;
+
+    return Sinc(x) * Sinc(x / (float) KERNEL_RADIUS);
+}
+
+#elif FP_SCALER == 5 || FP_SCALER == 6
+
+#if FP_SCALER == 5
+#define KERNEL_RADIUS 2
+static const float BETA = 5.0f;
+#else
+#define KERNEL_RADIUS 3
+static const float BETA = 6.0f;
+#endif
+
+// Modified Bessel function I0 approximation
+static float I0(float x)
+{
+    float ax = abs(x);
+    if (ax < 3.75f)
+    {
+        float t = x / 3.75f;
+        float t2 = t * t;
+        return 1.0f + t2 * (3.5156229f + t2 * (3.0899424f + t2 * (1.2067492f + t2 * (0.2659732f +
+               t2 * (0.0360768f + t2 * 0.0045813f)))));
+    }
+
+    float t = 3.75f / ax;
+    return (exp(ax) / sqrt(ax)) * (0.39894228f + t * (0.01328592f + t * (0.00225319f + t * (-0.00157565f +
+           t * (0.00916281f + t * (-0.02057706f + t * (0.02635537f + t * (-0.01647633f + t * 0.00392377f))))))));
+}
+
+static float Kernel(float x)
+{
+    float ax = abs(x);
+    if (ax >= (float) KERNEL_RADIUS)
+        return 0.0f;
+
+    float r = ax / (float) KERNEL_RADIUS;
+    float t = sqrt(saturate(1.0f - r * r));
+
+    return Sinc(x) * I0(BETA * t) / I0(BETA);
+}
+
+#else
+#error Unsupported FP_SCALER
+#endif
+
+#define TAP_COUNT (KERNEL_RADIUS * 2)
+
+float3 Resample(int2 dstPixel)
+{
+    float2 scale = float2((float) SrcWidth / (float) DstWidth, (float) SrcHeight / (float) DstHeight);
+    float2 srcPos = (float2(dstPixel) + 0.5f) * scale - 0.5f;
+
+    float2 ip = floor(srcPos);
+    float2 f = srcPos - ip;
+    int2 base = int2(ip) - (KERNEL_RADIUS - 1);
+
+    float wx[TAP_COUNT];
+    float wy[TAP_COUNT];
+    float sumWx = 0.0f;
+    float sumWy = 0.0f;
+
+    [unroll]
+    for (int i = 0; i < TAP_COUNT; ++i)
+    {
+        wx[i] = Kernel((float) (i - (KERNEL_RADIUS - 1)) - f.x);
+        wy[i] = Kernel((float) (i - (KERNEL_RADIUS - 1)) - f.y);
+        sumWx += wx[i];
+        sumWy += wy[i];
+    }
+
+    float invSumWx = (sumWx != 0.0f) ? (1.0f / sumWx) : 0.0f;
+    float invSumWy = (sumWy != 0.0f) ? (1.0f / sumWy) : 0.0f;
+
+    float3 acc = 0.0f;
+    float3 mn = 1e30f;
+    float3 mx = -1e30f;
+
+    [unroll]
+    for (int j = 0; j < TAP_COUNT; ++j)
+    {
+        int y = clamp(base.y + j, 0, SrcHeight - 1);
+        float wyj = wy[j] * invSumWy;
+
+        [unroll]
+        for (int i = 0; i < TAP_COUNT; ++i)
+        {
+            int x = clamp(base.x + i, 0, SrcWidth - 1);
+            float3 s = InputTexture.Load(int3(x, y, 0)).rgb;
+
+            mn = min(mn, s);
+            mx = max(mx, s);
+
+            acc += s * (wx[i] * invSumWx * wyj);
+        }
+    }
+
+    // Same ringing clamp as the standalone downscalers
+    return clamp(acc, mn, mx);
+}
+
+#endif
+
+float3 OutputTransfer(float3 c)
+{
+#if FP_OUTPUT == 1
+    return saturate(c);
+#else
+    return c;
+#endif
+}
+
+#if FP_SHARPEN == 1
+
+groupshared float ldsR[LDS_COUNT];
+groupshared float ldsG[LDS_COUNT];
+groupshared float ldsB[LDS_COUNT];
+
+float3 LoadTile(int2 local)
+{
+    int i = local.y * LDS_SIZE + local.x;
+    return float3(ldsR[i], ldsG[i], ldsB[i]);
+}
+
+float ComputeSharpness(int2 pixel)
+{
+    float setSharpness = Sharpness;
+
+    if (DynamicSharpenEnabled > 0)
+    {
+        int2 mvCoord = DisplaySizeMV > 0 ? pixel : int2(pixel * MotionTextureScale);
+        mvCoord = clamp(mvCoord, int2(0, 0), int2(MotionWidth - 1, MotionHeight - 1));
+
+        float2 mv = Motion.Load(int3(mvCoord, 0)).rg;
+        float motion = max(abs(mv.x * MvScaleX), abs(mv.y * MvScaleY));
+        float add = 0.0;
+
+        if (motion > Threshold && ScaleLimit > Threshold)
+            add = ((motion - Threshold) / (ScaleLimit - Threshold)) * MotionSharpness;
+
+        if ((add > MotionSharpness && MotionSharpness > 0.0) || (add < MotionSharpness && MotionSharpness < 0.0))
+            add = MotionSharpness;
+
+        setSharpness = clamp(setSharpness + add, 0.0, 1.0);
+    }
+
+    return setSharpness;
+}
+
+float3 Rcas(int2 local, float setSharpness)
+{
+    float3 e = LoadTile(local);
+
+    if (setSharpness == 0.0)
+    {
+        if (Debug > 0 && DynamicSharpenEnabled > 0 && Sharpness > 0.0)
+            e.g *= 1.0 + (12.0 * Sharpness);
+
+        return e;
+    }
+
+    // Apron pixels are clamped to the image edge, same as RCAS border handling
+    float3 b = LoadTile(local + int2(0, -1));
+    float3 d = LoadTile(local + int2(-1, 0));
+    float3 f = LoadTile(local + int2(1, 0));
+    float3 h = LoadTile(local + int2(0, 1));
+
+    float localScale = max(max(max(e.r, max(e.g, e.b)), max(b.r, max(b.g, b.b))),
+                           max(max(d.r, max(d.g, d.b)), max(max(f.r, max(f.g, f.b)), max(h.r, max(h.g, h.b)))));
+    localScale = max(localScale, 1.0);
+
+    float3 en = max(e / localScale, 0.0);
+    float3 bn = max(b / localScale, 0.0);
+    float3 dn = max(d / localScale, 0.0);
+    float3 fn = max(f / localScale, 0.0);
+    float3 hn = max(h / localScale, 0.0);
+
+    float3 minRGB = min(min(bn, dn), min(fn, hn));
+    float3 maxRGB = max(max(bn, dn), max(fn, hn));
+
+    float2 peakC = float2(1.0, -4.0);
+
+    float3 hitMin = minRGB / max(4.0 * maxRGB, 1e-5);
+    float3 hitMax = (peakC.xxx - maxRGB) / max(4.0 * minRGB + peakC.yyy, -1e-5);
+
+    float3 lobeRGB = max(-hitMin, hitMax);
+    float lobe = max(-0.1875, min(max(lobeRGB.r, max(lobeRGB.g, lobeRGB.b)), 0.0)) * setSharpness;
+
+    if (Contrast != 0.0)
+    {
+        float3 amp = saturate(min(minRGB, 2.0 - maxRGB) / max(maxRGB, 1e-5));
+        amp = rsqrt(max(amp, 1e-5));
+
+        float peak = -3.0 * Contrast + 8.0;
+        float contrastFactor = 1.0 / max(amp.g * peak, 1.0);
+
+        lobe *= lerp(1.0, contrastFactor, saturate(Contrast));
+    }
+
+    float rcpL = rcp(4.0 * lobe + 1.0);
+    float3 output = (((bn + dn + fn + hn) * lobe + en) * rcpL) * localScale;
+
+    if (Debug > 0 && DynamicSharpenEnabled > 0)
+    {
+        if (Sharpness < setSharpness)
+            output.r *= 1.0 + (12.0 * (setSharpness - Sharpness));
+        else
+            output.g *= 1.0 + (12.0 * (Sharpness - setSharpness));
+    }
+
+    return output;
+}
+
+[numthreads(TILE_SIZE, TILE_SIZE, 1)]
+void CSMain(uint3 groupId : SV_GroupID, uint3 tid : SV_GroupThreadID, uint groupIndex : SV_GroupIndex)
+{
+    int2 tileOrigin = int2(groupId.xy) * TILE_SIZE - APRON;
+    int2 maxPixel = int2(DstWidth - 1, DstHeight - 1);
+
+    // Resample tile + apron into LDS
+    for (uint i = groupIndex; i < LDS_COUNT; i += TILE_SIZE * TILE_SIZE)
+    {
+        int2 local = int2(i % LDS_SIZE, i / LDS_SIZE);
+        int2 dstPixel = clamp(tileOrigin + local, int2(0, 0), maxPixel);
+
+        float3 c = Resample(dstPixel);
+        ldsR[i] = c.r;
+        ldsG[i] = c.g;
+        ldsB[i] = c.b;
+    }
+
+    GroupMemoryBarrierWithGroupSync();
+
+    int2 pixel = int2(groupId.xy) * TILE_SIZE + int2(tid.xy);
+
+    if (pixel.x > maxPixel.x || pixel.y > maxPixel.y)
+        return;
+
+    float3 output = Rcas(int2(tid.xy) + APRON, ComputeSharpness(pixel));
+    OutputTexture[pixel] = float4(OutputTransfer(output), 1.0f);
+}
+
+#else
+
+[numthreads(TILE_SIZE, TILE_SIZE, 1)]
+void CSMain(uint3 id : SV_DispatchThreadID)
+{
+    if (id.x >= (uint) DstWidth || id.y >= (uint) DstHeight)
+        return;
+
+    OutputTexture[id.xy] = float4(OutputTransfer(Resample(int2(id.xy))), 1.0f);
+}
+
+#endif
+)";
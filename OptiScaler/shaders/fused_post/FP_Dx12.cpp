@@ -0,0 +1,232 @@
+#include "pch.h"
+#include "FP_Dx12.h"
+#include "precompile/FP_Precompiled.h"
+
+#include <Config.h>
+
+static const FPPrecompiledShader* FindPrecompiled(uint32_t InKey)
+{
+    for (auto& shader : fpPrecompiledShaders)
+    {
+        if (shader.Data != nullptr && shader.Key == InKey)
+            return &shader;
+    }
+
+    return nullptr;
+}
+
+bool FP_Dx12::IsSupported(Scaler InScaler, SharpenShader InSharpenShader, bool InUpsample)
+{
+    // Upsampling and EASU use their own shaders, DA / LCDA need depth at output res
+    if (InUpsample || InSharpenShader != SharpenShader::RCAS)
+        return false;
+
+    if (InScaler < Scaler::Bicubic || InScaler > Scaler::Kaiser3)
+        return false;
+
+    // Permutations of a scaler are built together, checking one is enough.
+    // Missing ones are compiled from source by CreateComputePipeline
+    if (Config::Instance()->UsePrecompiledShaders.value_or_default())
+    {
+        FPPermutation permutation {};
+        permutation.Downscaler = InScaler;
+
+        static bool logged = false;
+
+        if (FindPrecompiled(permutation.Key()) == nullptr && !logged)
+        {
+            LOG_WARN("No precompiled fused post shaders for scaler {}, compiling them at runtime", (uint32_t) InScaler);
+            logged = true;
+        }
+    }
+
+    return true;
+}
+
+FPPermutation FP_Dx12::GetPermutation(Scaler InScaler, bool InSharpen, DXGI_FORMAT InOutputFormat)
+{
+    FPPermutation permutation {};
+    permutation.Downscaler = InScaler;
+    permutation.Sharpen = InSharpen ? FPSharpen::RCAS : FPSharpen::None;
+
+    switch (InOutputFormat)
+    {
+    case DXGI_FORMAT_R8G8B8A8_TYPELESS:
+    case DXGI_FORMAT_R8G8B8A8_UNORM:
+    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+    case DXGI_FORMAT_B8G8R8A8_TYPELESS:
+    case DXGI_FORMAT_B8G8R8A8_UNORM:
+    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+    case DXGI_FORMAT_R10G10B10A2_TYPELESS:
+    case DXGI_FORMAT_R10G10B10A2_UNORM:
+        permutation.Output = FPOutput::Unorm;
+        break;
+
+    default:
+        permutation.Output = FPOutput::Float;
+        break;
+    }
+
+    return permutation;
+}
+
+ID3D12PipelineState* FP_Dx12::GetPipeline(const FPPermutation& InPermutation)
+{
+    auto key = InPermutation.Key();
+
+    if (auto it = _pipelines.find(key); it != _pipelines.end())
+        return it->second;
+
+    auto source = std::format("#define FP_SHARPEN {}\n#define FP_SCALER {}\n#define FP_OUTPUT {}\n",
+                              (uint32_t) InPermutation.Sharpen, (uint32_t) InPermutation.Downscaler,
+                              (uint32_t) InPermutation.Output) +
+                  fusedPostCode;
+
+    ID3D12PipelineState* pipelineState = nullptr;
+    auto precompiled = FindPrecompiled(key);
+
+    if (!CreateComputePipeline(_device, &pipelineState, precompiled != nullptr ? precompiled->Data : nullptr,
+                               precompiled != nullptr ? precompiled->Size : 0, source.c_str()))
+    {
+        LOG_ERROR("[{0}] Failed to create pipeline for {1}", _name, InPermutation.Name());
+        pipelineState = nullptr;
+    }
+    else
+    {
+        LOG_INFO("[{0}] Created pipeline for {1}", _name, InPermutation.Name());
+    }
+
+    _pipelines[key] = pipelineState;
+    return pipelineState;
+}
+
+bool FP_Dx12::Dispatch(ID3D12GraphicsCommandList* InCmdList, ID3D12Resource* InResource,
+                       ID3D12Resource* InMotionVectors, RcasConstants InConstants, const FPPermutation& InPermutation,
+                       uint32_t InSrcWidth, uint32_t InSrcHeight, uint32_t InDstWidth, uint32_t InDstHeight,
+                       ID3D12Resource* OutResource)
+{
+    if (!_init || _device == nullptr || InCmdList == nullptr || InResource == nullptr || OutResource == nullptr)
+        return false;
+
+    if (InPermutation.Sharpen == FPSharpen::RCAS && InMotionVectors == nullptr)
+        return false;
+
+    auto pipelineState = GetPipeline(InPermutation);
+
+    if (pipelineState == nullptr)
+        return false;
+
+    LOG_DEBUG("[{0}] Start!", _name);
+
+    _counter++;
+    _counter = _counter % FP_NUM_OF_HEAPS;
+    FrameDescriptorHeap& currentHeap = _frameHeaps[_counter];
+
+    // Motion vectors are only read by the RCAS permutations but the slot still needs a valid view
+    auto motion = InMotionVectors != nullptr ? InMotionVectors : InResource;
+
+    CreateShaderResourceView(_device, InResource, currentHeap.GetSrvCPU(0));
+    CreateShaderResourceView(_device, motion, currentHeap.GetSrvCPU(1));
+    CreateUnorderedAccessView(_device, OutResource, currentHeap.GetUavCPU(0), 0);
+
+    // Reuse RCAS constant logic so both paths react to the same settings
+    InternalConstants rcasConstants {};
+    auto mvsDesc = motion->GetDesc();
+
+    rcasConstants.OutputWidth = InDstWidth;
+    rcasConstants.OutputHeight = InDstHeight;
+    rcasConstants.MotionWidth = (uint32_t) mvsDesc.Width;
+    rcasConstants.MotionHeight = mvsDesc.Height;
+
+    FillMotionConstants(rcasConstants, InConstants);
+
+    FPConstants constants {};
+    constants.SrcWidth = InSrcWidth;
+    constants.SrcHeight = InSrcHeight;
+    constants.DstWidth = InDstWidth;
+    constants.DstHeight = InDstHeight;
+    constants.Sharpness = rcasConstants.Sharpness;
+    constants.Contrast = rcasConstants.Contrast;
+    constants.DynamicSharpenEnabled = rcasConstants.DynamicSharpenEnabled;
+    constants.DisplaySizeMV = rcasConstants.DisplaySizeMV;
+    constants.Debug = rcasConstants.Debug;
+    constants.MotionWidth = rcasConstants.MotionWidth;
+    constants.MotionHeight = rcasConstants.MotionHeight;
+    constants.MotionSharpness = rcasConstants.MotionSharpness;
+    constants.MotionTextureScale = rcasConstants.MotionTextureScale;
+    constants.MvScaleX = rcasConstants.MvScaleX;
+    constants.MvScaleY = rcasConstants.MvScaleY;
+    constants.Threshold = rcasConstants.Threshold;
+    constants.ScaleLimit = rcasConstants.ScaleLimit;
+
+    if (!CreateConstantsBuffer(_device, _constantBuffer, constants, currentHeap.GetCbvCPU(0)))
+    {
+        LOG_ERROR("[{0}] Failed to create a constants buffer", _name);
+        return false;
+    }
+
+    ID3D12DescriptorHeap* heaps[] = { currentHeap.GetHeapCSU() };
+    InCmdList->SetDescriptorHeaps(_countof(heaps), heaps);
+    InCmdList->SetComputeRootSignature(_rootSignature);
+    InCmdList->SetPipelineState(pipelineState);
+    InCmdList->SetComputeRootDescriptorTable(0, currentHeap.GetTableGPUStart());
+
+    UINT dispatchWidth = (InDstWidth + InNumThreadsX - 1) / InNumThreadsX;
+    UINT dispatchHeight = (InDstHeight + InNumThreadsY - 1) / InNumThreadsY;
+    InCmdList->Dispatch(dispatchWidth, dispatchHeight, 1);
+
+    return true;
+}
+
+FP_Dx12::FP_Dx12(std::string InName, ID3D12Device* InDevice) : Shader_Dx12(InName, InDevice)
+{
+    if (InDevice == nullptr)
+    {
+        LOG_ERROR("InDevice is nullptr!");
+        return;
+    }
+
+    LOG_DEBUG("{0} start!", _name);
+
+    // Same sampler as the standalone downscalers, used by the bicubic permutations
+    CD3DX12_STATIC_SAMPLER_DESC sampler(0);
+    sampler.Filter = D3D12_FILTER_MIN_MAG_LINEAR_MIP_POINT;
+    sampler.AddressU = sampler.AddressV = D3D12_TEXTURE_ADDRESS_MODE_CLAMP;
+
+    if (!SetupRootSignature(InDevice, 2, 1, 1, 0, 0, 1, &sampler))
+    {
+        LOG_ERROR("Failed to setup root signature");
+        return;
+    }
+
+    D3D12_RESOURCE_DESC desc = CD3DX12_RESOURCE_DESC::Buffer(sizeof(FPConstants));
+    auto heapProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+
+    auto result =
+        InDevice->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &desc, D3D12_RESOURCE_STATE_GENERIC_READ,
+                                          nullptr, IID_PPV_ARGS(&_constantBuffer));
+
+    if (result != S_OK)
+    {
+        LOG_ERROR("[{0}] CreateCommittedResource error {1:x}", _name, (unsigned int) result);
+        return;
+    }
+
+    _init = InitHeaps(InDevice, _frameHeaps, FP_NUM_OF_HEAPS);
+}
+
+FP_Dx12::~FP_Dx12()
+{
+    if (!_init || State::Instance().isShuttingDown)
+        return;
+
+    for (auto& [key, pipelineState] : _pipelines)
+        SAFE_RELEASE(pipelineState);
+
+    _pipelines.clear();
+
+    for (int i = 0; i < FP_NUM_OF_HEAPS; i++)
+    {
+        _frameHeaps[i].ReleaseHeaps();
+    }
+}
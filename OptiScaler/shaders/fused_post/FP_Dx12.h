@@ -0,0 +1,39 @@
+#pragma once
+#include "FP_Common.h"
+
+#include <shaders/rcas/RCAS_Common.h>
+
+#include <d3d12.h>
+#include <d3dx/d3dx12.h>
+#include <shaders/Shader_Dx12Utils.h>
+#include <shaders/Shader_Dx12.h>
+
+#include <ankerl/unordered_dense.h>
+
+#define FP_NUM_OF_HEAPS 2
+
+// Fused post upscale pass, replaces OS_Dx12 -> RCAS_Dx12 when both are active
+// Pipelines are compiled per permutation on first use, failed ones are cached as nullptr
+class FP_Dx12 : public Shader_Dx12, public RCAS_Common
+{
+  private:
+    FrameDescriptorHeap _frameHeaps[FP_NUM_OF_HEAPS];
+    ankerl::unordered_dense::map<uint32_t, ID3D12PipelineState*> _pipelines;
+
+    uint32_t InNumThreadsX = 16;
+    uint32_t InNumThreadsY = 16;
+
+    ID3D12PipelineState* GetPipeline(const FPPermutation& InPermutation);
+
+  public:
+    static bool IsSupported(Scaler InScaler, SharpenShader InSharpenShader, bool InUpsample);
+    static FPPermutation GetPermutation(Scaler InScaler, bool InSharpen, DXGI_FORMAT InOutputFormat);
+
+    bool Dispatch(ID3D12GraphicsCommandList* InCmdList, ID3D12Resource* InResource, ID3D12Resource* InMotionVectors,
+                  RcasConstants InConstants, const FPPermutation& InPermutation, uint32_t InSrcWidth,
+                  uint32_t InSrcHeight, uint32_t InDstWidth, uint32_t InDstHeight, ID3D12Resource* OutResource);
+
+    FP_Dx12(std::string InName, ID3D12Device* InDevice);
+
+    ~FP_Dx12();
+};
@@ -0,0 +1,17 @@
+#pragma once
+
+// Generated by shaders/shader_tools/build_fused_post_shaders.py, don't edit
+
+#include <cstddef>
+#include <cstdint>
+
+struct FPPrecompiledShader
+{
+    uint32_t Key;
+    const unsigned char* Data;
+    size_t Size;
+};
+
+inline static const FPPrecompiledShader fpPrecompiledShaders[] = {
+    { 0, nullptr, 0 },
+};
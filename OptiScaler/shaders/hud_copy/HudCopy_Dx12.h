@@ -25,9 +25,6 @@ class HudCopy_Dx12 : public Shader_Dx12
     uint32_t InNumThreadsX = 16;
     uint32_t InNumThreadsY = 16;
 
-    static void ResourceBarrier(ID3D12GraphicsCommandList* InCommandList, ID3D12Resource* InResource,
-                                D3D12_RESOURCE_STATES InBeforeState, D3D12_RESOURCE_STATES InAfterState);
-
   public:
     bool Dispatch(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* hudless, ID3D12Resource* present,
                   D3D12_RESOURCE_STATES hudlessState, D3D12_RESOURCE_STATES presentState, float hudDetectionThreshold);
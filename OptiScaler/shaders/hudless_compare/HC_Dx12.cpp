@@ -6,6 +6,7 @@
 #include "precompile/hudless_compare_VShader.h"
 
 #include <Config.h>
+#include <misc/SwapchainCache.h>
 
 bool HC_Dx12::CreateBufferResource(UINT index, ID3D12Device* InDevice, ID3D12Resource* InSource,
                                    D3D12_RESOURCE_STATES InState)
@@ -25,29 +26,9 @@ bool HC_Dx12::CreateBufferResource(UINT index, ID3D12Device* InDevice, ID3D12Res
     return result;
 }
 
-void HC_Dx12::ResourceBarrier(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* resource,
-                              D3D12_RESOURCE_STATES beforeState, D3D12_RESOURCE_STATES afterState)
-{
-    if (beforeState == afterState)
-        return;
-
-    D3D12_RESOURCE_BARRIER barrier = {};
-    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    barrier.Transition.pResource = resource;
-    barrier.Transition.StateBefore = beforeState;
-    barrier.Transition.StateAfter = afterState;
-    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-    cmdList->ResourceBarrier(1, &barrier);
-}
-
 void HC_Dx12::SetBufferState(UINT index, ID3D12GraphicsCommandList* InCommandList, D3D12_RESOURCE_STATES InState)
 {
-    if (_bufferState[index] == InState)
-        return;
-
-    ResourceBarrier(InCommandList, _buffer[index], _bufferState[index], InState);
-
-    _bufferState[index] = InState;
+    Shader_Dx12::SetBufferState(InCommandList, InState, _buffer[index], &_bufferState[index]);
 }
 
 HC_Dx12::HC_Dx12(std::string InName, ID3D12Device* InDevice) : Shader_Dx12(InName, InDevice)
@@ -143,31 +124,23 @@ bool HC_Dx12::Dispatch(IDXGISwapChain3* sc, ID3D12GraphicsCommandList* cmdList,
     if (sc == nullptr || hudless == nullptr || !_init)
         return false;
 
-    DXGI_SWAP_CHAIN_DESC scDesc {};
-    if (sc->GetDesc(&scDesc) != S_OK)
-    {
-        LOG_WARN("Can't get swapchain desc!");
+    auto swapchain = SwapchainCache::Instance().Get(sc, _device);
+
+    if (swapchain == nullptr || swapchain->RtvHeap == nullptr)
         return false;
-    }
 
-    // Get SwapChain Buffer
-    ID3D12Resource* scBuffer = nullptr;
-    auto scIndex = sc->GetCurrentBackBufferIndex();
-    auto result = sc->GetBuffer(scIndex, IID_PPV_ARGS(&scBuffer));
+    auto scIndex = SwapchainCache::Instance().CurrentIndex(sc);
 
-    if (result != S_OK)
-    {
-        LOG_ERROR("sc->GetBuffer({}) error: {:X}", scIndex, (unsigned long) result);
+    if (scIndex >= swapchain->Buffers.size())
         return false;
-    }
 
-    scBuffer->Release();
+    auto scBuffer = swapchain->Buffers[scIndex];
 
     // Check Hudless Buffer
     D3D12_RESOURCE_DESC hudlessDesc = hudless->GetDesc();
 
-    if (/*hudlessDesc.Format != scDesc.BufferDesc.Format ||*/ hudlessDesc.Width != scDesc.BufferDesc.Width ||
-        hudlessDesc.Height != scDesc.BufferDesc.Height)
+    if (/*hudlessDesc.Format != swapchain->ViewFormat ||*/ hudlessDesc.Width != swapchain->Width() ||
+        hudlessDesc.Height != swapchain->Height())
     {
         return false;
     }
@@ -181,29 +154,29 @@ bool HC_Dx12::Dispatch(IDXGISwapChain3* sc, ID3D12GraphicsCommandList* cmdList,
         return false;
     }
 
+    BarrierBatch barriers(cmdList);
+
     // Copy Swapchain Buffer to read buffer
-    SetBufferState(_counter, cmdList, D3D12_RESOURCE_STATE_COPY_DEST);
-    ResourceBarrier(cmdList, scBuffer, D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    barriers.Transition(_buffer[_counter], &_bufferState[_counter], D3D12_RESOURCE_STATE_COPY_DEST);
+    barriers.Transition(scBuffer, D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    barriers.Flush();
 
     if (_buffer[_counter] != nullptr)
         cmdList->CopyResource(_buffer[_counter], scBuffer);
 
-    ResourceBarrier(cmdList, scBuffer, D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_RENDER_TARGET);
-    SetBufferState(_counter, cmdList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-
-    if (state != D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
-        ResourceBarrier(cmdList, hudless, state, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    barriers.Transition(scBuffer, D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_RENDER_TARGET);
+    barriers.Transition(_buffer[_counter], &_bufferState[_counter], D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    barriers.Transition(hudless, state, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 
     // Start setting pipeline
-    UINT outWidth = scDesc.BufferDesc.Width;
-    UINT outHeight = scDesc.BufferDesc.Height;
+    UINT outWidth = swapchain->Width();
+    UINT outHeight = swapchain->Height();
 
     FrameDescriptorHeap& currentHeap = _frameHeaps[_counter];
 
     // Create views
     CreateShaderResourceView(_device, hudless, currentHeap.GetSrvCPU(0));
     CreateShaderResourceView(_device, _buffer[_counter], currentHeap.GetSrvCPU(1));
-    CreateRenderTargetView(_device, scBuffer, currentHeap.GetRtvCPU(0), 0);
 
     InternalCompareParams constants {};
     constants.DiffThreshold = 0.003f;
@@ -224,7 +197,7 @@ bool HC_Dx12::Dispatch(IDXGISwapChain3* sc, ID3D12GraphicsCommandList* cmdList,
     cmdList->SetGraphicsRootDescriptorTable(0, currentHeap.GetTableGPUStart());
 
     // Set RTV, viewport, scissor
-    D3D12_CPU_DESCRIPTOR_HANDLE rtvHandles[] = { currentHeap.GetRtvCPU(0) };
+    D3D12_CPU_DESCRIPTOR_HANDLE rtvHandles[] = { swapchain->Rtv(scIndex) };
     cmdList->OMSetRenderTargets(_countof(rtvHandles), rtvHandles, true, nullptr);
 
     D3D12_VIEWPORT vp {};
@@ -239,14 +212,14 @@ bool HC_Dx12::Dispatch(IDXGISwapChain3* sc, ID3D12GraphicsCommandList* cmdList,
     D3D12_RECT rect { 0, 0, (LONG) outWidth, (LONG) outHeight };
     cmdList->RSSetScissorRects(1, &rect);
 
+    barriers.Flush();
+
     // Fullscreen triangle
     cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
     cmdList->DrawInstanced(3, 1, 0, 0);
 
-    ResourceBarrier(cmdList, scBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PRESENT);
-
-    if (state != D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
-        ResourceBarrier(cmdList, hudless, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, state);
+    barriers.Transition(scBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PRESENT);
+    barriers.Transition(hudless, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, state);
 
     return true;
 }
@@ -25,9 +25,6 @@ class HC_Dx12 : public Shader_Dx12
     ID3D12Resource* _buffer[HC_NUM_OF_HEAPS] = {};
     D3D12_RESOURCE_STATES _bufferState[HC_NUM_OF_HEAPS] = { D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_COMMON };
 
-    static void ResourceBarrier(ID3D12GraphicsCommandList* InCommandList, ID3D12Resource* InResource,
-                                D3D12_RESOURCE_STATES InBeforeState, D3D12_RESOURCE_STATES InAfterState);
-
   public:
     bool CreateBufferResource(UINT index, ID3D12Device* InDevice, ID3D12Resource* InSource,
                               D3D12_RESOURCE_STATES InState);
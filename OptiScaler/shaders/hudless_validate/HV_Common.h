@@ -0,0 +1,80 @@
+#pragma once
+
+#include "pch.h"
+
+// Each group reduces a 32x32 tile into uint4(pixels, diff pixels, delta sum, max delta)
+static std::string hvCode = R"(
+cbuffer Params : register(b0)
+{
+    float DiffThreshold;
+    uint Width;
+    uint Height;
+    uint TilesX;
+};
+
+Texture2D<float3> Hudless : register(t0);
+Texture2D<float3> Present : register(t1);
+
+RWByteAddressBuffer Stats : register(u0);
+
+groupshared uint gsPixels;
+groupshared uint gsDiffPixels;
+groupshared uint gsDeltaSum;
+groupshared uint gsMaxDelta;
+
+[numthreads(16, 16, 1)]
+void CSMain(uint3 groupId : SV_GroupID, uint3 threadId : SV_GroupThreadID, uint groupIndex : SV_GroupIndex)
+{
+    if (groupIndex == 0)
+    {
+        gsPixels = 0;
+        gsDiffPixels = 0;
+        gsDeltaSum = 0;
+        gsMaxDelta = 0;
+    }
+
+    GroupMemoryBarrierWithGroupSync();
+
+    uint pixels = 0;
+    uint diffPixels = 0;
+    uint deltaSum = 0;
+    uint maxDelta = 0;
+
+    [unroll]
+    for (uint y = 0; y < 2; y++)
+    {
+        [unroll]
+        for (uint x = 0; x < 2; x++)
+        {
+            uint2 pixelCoord = groupId.xy * 32 + threadId.xy * 2 + uint2(x, y);
+
+            if (pixelCoord.x >= Width || pixelCoord.y >= Height)
+                continue;
+
+            float3 diff = abs(Hudless.Load(int3(pixelCoord, 0)) - Present.Load(int3(pixelCoord, 0)));
+            float delta = saturate(max(max(diff.r, diff.g), diff.b));
+            uint quantized = (uint) (delta * 255.0f + 0.5f);
+
+            pixels++;
+            deltaSum += quantized;
+            maxDelta = max(maxDelta, quantized);
+
+            if (delta > DiffThreshold)
+                diffPixels++;
+        }
+    }
+
+    InterlockedAdd(gsPixels, pixels);
+    InterlockedAdd(gsDiffPixels, diffPixels);
+    InterlockedAdd(gsDeltaSum, deltaSum);
+    InterlockedMax(gsMaxDelta, maxDelta);
+
+    GroupMemoryBarrierWithGroupSync();
+
+    if (groupIndex == 0)
+    {
+        uint tile = groupId.y * TilesX + groupId.x;
+        Stats.Store4(tile * 16, uint4(gsPixels, gsDiffPixels, gsDeltaSum, gsMaxDelta));
+    }
+}
+)";
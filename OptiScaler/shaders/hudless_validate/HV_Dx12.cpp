@@ -0,0 +1,359 @@
+#include "pch.h"
+#include "HV_Dx12.h"
+#include "HV_Common.h"
+#include "precompile/HV_Shader.h"
+
+#include <Config.h>
+#include <State.h>
+#include <misc/SwapchainCache.h>
+#include <misc/VramRegistry.h>
+
+void HV_Dx12::ReleaseSwapchain()
+{
+    _swapchain.reset();
+    SAFE_RELEASE(_scCopy);
+}
+
+bool HV_Dx12::CacheSwapchain(IDXGISwapChain3* sc)
+{
+    auto swapchain = SwapchainCache::Instance().Get(sc, _device);
+
+    if (swapchain == _swapchain)
+        return _swapchain != nullptr && (_swapchain->SrvHeap != nullptr || _scCopy != nullptr);
+
+    ReleaseSwapchain();
+    _swapchain = swapchain;
+
+    if (_swapchain == nullptr)
+        return false;
+
+    // Backbuffers can't be read by shaders
+    if (_swapchain->SrvHeap == nullptr)
+    {
+        if (!Shader_Dx12::CreateBufferResource(_device, _swapchain->Buffers[0], D3D12_RESOURCE_STATE_COPY_DEST,
+                                               &_scCopy, D3D12_RESOURCE_FLAG_NONE))
+        {
+            LOG_ERROR("[{0}] Can't create backbuffer copy!", _name);
+            return false;
+        }
+
+        _scCopy->SetName(L"HV_BackbufferCopy");
+        VramRegistry::Instance().Track(_scCopy, "Hudless Validation", "Backbuffer copy");
+
+        CreateShaderResourceView(_device, _scCopy, _scHeap->GetCPUDescriptorHandleForHeapStart());
+    }
+
+    LOG_DEBUG("[{0}] Using {1} backbuffers, {2}x{3}, copy: {4}", _name, _swapchain->Buffers.size(),
+              _swapchain->Width(), _swapchain->Height(), _scCopy != nullptr);
+
+    return true;
+}
+
+bool HV_Dx12::CreateStatsBuffers(uint32_t width, uint32_t height)
+{
+    if (_stats != nullptr && _statsWidth == width && _statsHeight == height)
+        return true;
+
+    SAFE_RELEASE(_stats);
+
+    for (auto& slot : _slots)
+    {
+        SAFE_RELEASE(slot.Readback);
+        slot.Pending = false;
+    }
+
+    _statsTiles = 0;
+    _statsWidth = 0;
+    _statsHeight = 0;
+
+    uint32_t tilesX = (width + TileSize - 1) / TileSize;
+    uint32_t tiles = tilesX * ((height + TileSize - 1) / TileSize);
+    auto size = (UINT64) tiles * sizeof(HudlessTileStats);
+
+    auto desc = CD3DX12_RESOURCE_DESC::Buffer(size, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+    auto heapProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+
+    auto result = _device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &desc,
+                                                   D3D12_RESOURCE_STATE_UNORDERED_ACCESS, nullptr,
+                                                   IID_PPV_ARGS(&_stats));
+
+    if (result != S_OK)
+    {
+        LOG_ERROR("[{0}] CreateCommittedResource error {1:x}", _name, (unsigned int) result);
+        return false;
+    }
+
+    _stats->SetName(L"HV_Stats");
+    VramRegistry::Instance().Track(_stats, "Hudless Validation", "Tile stats");
+
+    desc = CD3DX12_RESOURCE_DESC::Buffer(size);
+    heapProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_READBACK);
+
+    for (auto& slot : _slots)
+    {
+        result = _device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &desc,
+                                                  D3D12_RESOURCE_STATE_COPY_DEST, nullptr,
+                                                  IID_PPV_ARGS(&slot.Readback));
+
+        if (result != S_OK)
+        {
+            LOG_ERROR("[{0}] CreateCommittedResource error {1:x}", _name, (unsigned int) result);
+            return false;
+        }
+
+        slot.Readback->SetName(L"HV_Readback");
+    }
+
+    D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+    uavDesc.Format = DXGI_FORMAT_R32_TYPELESS;
+    uavDesc.ViewDimension = D3D12_UAV_DIMENSION_BUFFER;
+    uavDesc.Buffer.NumElements = (UINT) (size / sizeof(uint32_t));
+    uavDesc.Buffer.Flags = D3D12_BUFFER_UAV_FLAG_RAW;
+
+    // Stats buffer & constants only change with the image size, so are the views
+    for (int i = 0; i < HV_NUM_OF_SLOTS; i++)
+        _device->CreateUnorderedAccessView(_stats, nullptr, &uavDesc, _frameHeaps[i].GetUavCPU(0));
+
+    InternalValidateParams constants {};
+    constants.DiffThreshold = 0.01f;
+    constants.Width = width;
+    constants.Height = height;
+    constants.TilesX = tilesX;
+
+    for (int i = 0; i < HV_NUM_OF_SLOTS; i++)
+    {
+        if (!CreateConstantsBuffer(_device, _constantBuffer, constants, _frameHeaps[i].GetCbvCPU(0)))
+        {
+            LOG_ERROR("[{0}] Failed to create a constants buffer", _name);
+            return false;
+        }
+    }
+
+    _statsTiles = tiles;
+    _statsWidth = width;
+    _statsHeight = height;
+    _tiles.resize(tiles);
+
+    return true;
+}
+
+void HV_Dx12::ReadSlot(Slot& slot)
+{
+    slot.Pending = false;
+
+    void* data = nullptr;
+    D3D12_RANGE readRange { 0, slot.Tiles * sizeof(HudlessTileStats) };
+
+    if (slot.Readback->Map(0, &readRange, &data) != S_OK || data == nullptr)
+        return;
+
+    memcpy(_tiles.data(), data, readRange.End);
+
+    D3D12_RANGE writeRange { 0, 0 };
+    slot.Readback->Unmap(0, &writeRange);
+
+    _result = HudlessValidator::Reduce(_tiles.data(), slot.Tiles);
+    _resultTag = slot.Tag;
+    _hasResult = true;
+}
+
+bool HV_Dx12::GetResult(uint64_t& tag, HudlessStats& stats)
+{
+    if (!_hasResult)
+        return false;
+
+    tag = _resultTag;
+    stats = _result;
+    _hasResult = false;
+
+    return true;
+}
+
+bool HV_Dx12::DispatchStats(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* hudless,
+                            D3D12_RESOURCE_STATES hudlessState, ID3D12Resource* present,
+                            D3D12_RESOURCE_STATES presentState, D3D12_CPU_DESCRIPTOR_HANDLE* presentSrv, uint64_t tag)
+{
+    auto hudlessDesc = hudless->GetDesc();
+    auto presentDesc = present->GetDesc();
+
+    if (hudlessDesc.Width != presentDesc.Width || hudlessDesc.Height != presentDesc.Height)
+        return false;
+
+    if ((hudlessDesc.Flags & D3D12_RESOURCE_FLAG_DENY_SHADER_RESOURCE) != 0)
+        return false;
+
+    UINT width = static_cast<UINT>(presentDesc.Width);
+    UINT height = presentDesc.Height;
+
+    if (!CreateStatsBuffers(width, height))
+        return false;
+
+    _counter++;
+    _counter = _counter % HV_NUM_OF_SLOTS;
+
+    auto& slot = _slots[_counter];
+
+    // Written HV_NUM_OF_SLOTS dispatches ago
+    if (slot.Pending)
+        ReadSlot(slot);
+
+    FrameDescriptorHeap& currentHeap = _frameHeaps[_counter];
+
+    // Hudless can be a different resource every frame (or a new one at the same address), no caching
+    CreateShaderResourceView(_device, hudless, currentHeap.GetSrvCPU(0));
+
+    if (presentSrv != nullptr)
+    {
+        _device->CopyDescriptorsSimple(1, currentHeap.GetSrvCPU(1), *presentSrv,
+                                       D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    }
+    else
+    {
+        CreateShaderResourceView(_device, present, currentHeap.GetSrvCPU(1));
+    }
+
+    BarrierBatch barriers(cmdList);
+    barriers.Transition(hudless, hudlessState, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+    barriers.Transition(present, presentState, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+    barriers.Flush();
+
+    ID3D12DescriptorHeap* heaps[] = { currentHeap.GetHeapCSU() };
+    cmdList->SetDescriptorHeaps(_countof(heaps), heaps);
+
+    cmdList->SetComputeRootSignature(_rootSignature);
+    cmdList->SetPipelineState(_pipelineState);
+
+    cmdList->SetComputeRootDescriptorTable(0, currentHeap.GetTableGPUStart());
+
+    // Each group reduces a whole tile
+    cmdList->Dispatch((width + TileSize - 1) / TileSize, (height + TileSize - 1) / TileSize, 1);
+
+    barriers.Transition(present, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, presentState);
+    barriers.Transition(hudless, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, hudlessState);
+    barriers.Transition(_stats, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    barriers.Flush();
+
+    cmdList->CopyBufferRegion(slot.Readback, 0, _stats, 0, (UINT64) _statsTiles * sizeof(HudlessTileStats));
+
+    barriers.Transition(_stats, D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+    slot.Tag = tag;
+    slot.Tiles = _statsTiles;
+    slot.Pending = true;
+
+    return true;
+}
+
+bool HV_Dx12::Dispatch(IDXGISwapChain3* sc, ID3D12GraphicsCommandList* cmdList, ID3D12Resource* hudless,
+                       D3D12_RESOURCE_STATES hudlessState, uint64_t tag)
+{
+    if (!_init || sc == nullptr || cmdList == nullptr || hudless == nullptr)
+        return false;
+
+    if (!CacheSwapchain(sc))
+        return false;
+
+    auto scIndex = SwapchainCache::Instance().CurrentIndex(sc);
+
+    if (scIndex >= _swapchain->Buffers.size())
+        return false;
+
+    auto scBuffer = _swapchain->Buffers[scIndex];
+
+    if (_scCopy != nullptr)
+    {
+        ResourceTransition(cmdList, scBuffer, D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_COPY_SOURCE);
+        cmdList->CopyResource(_scCopy, scBuffer);
+        ResourceTransition(cmdList, scBuffer, D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_PRESENT);
+
+        D3D12_CPU_DESCRIPTOR_HANDLE srv = _scHeap->GetCPUDescriptorHandleForHeapStart();
+        return DispatchStats(cmdList, hudless, hudlessState, _scCopy, D3D12_RESOURCE_STATE_COPY_DEST, &srv, tag);
+    }
+
+    D3D12_CPU_DESCRIPTOR_HANDLE srv = _swapchain->Srv(scIndex);
+
+    return DispatchStats(cmdList, hudless, hudlessState, scBuffer, D3D12_RESOURCE_STATE_PRESENT, &srv, tag);
+}
+
+bool HV_Dx12::Dispatch(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* hudless,
+                       D3D12_RESOURCE_STATES hudlessState, ID3D12Resource* present,
+                       D3D12_RESOURCE_STATES presentState, uint64_t tag)
+{
+    if (!_init || cmdList == nullptr || hudless == nullptr || present == nullptr)
+        return false;
+
+    if ((present->GetDesc().Flags & D3D12_RESOURCE_FLAG_DENY_SHADER_RESOURCE) != 0)
+        return false;
+
+    return DispatchStats(cmdList, hudless, hudlessState, present, presentState, nullptr, tag);
+}
+
+HV_Dx12::HV_Dx12(std::string InName, ID3D12Device* InDevice) : Shader_Dx12(InName, InDevice)
+{
+    if (InDevice == nullptr)
+    {
+        LOG_ERROR("InDevice is nullptr!");
+        return;
+    }
+
+    LOG_DEBUG("{0} start!", _name);
+
+    if (!SetupRootSignature(InDevice, 2, 1, 1))
+    {
+        LOG_ERROR("Failed to setup root signature");
+        return;
+    }
+
+    D3D12_RESOURCE_DESC desc = CD3DX12_RESOURCE_DESC::Buffer(sizeof(InternalValidateParams));
+    auto heapProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+
+    auto result =
+        InDevice->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &desc, D3D12_RESOURCE_STATE_GENERIC_READ,
+                                          nullptr, IID_PPV_ARGS(&_constantBuffer));
+
+    if (result != S_OK)
+    {
+        LOG_ERROR("[{0}] CreateCommittedResource error {1:x}", _name, (unsigned int) result);
+        return;
+    }
+
+    // Compiled from source when the precompiled header wasn't generated
+    if (!CreateComputePipeline(InDevice, &_pipelineState, HV_cso, HV_cso_size, hvCode.c_str()))
+    {
+        LOG_ERROR("[{0}] Failed to create compute pipeline", _name);
+        return;
+    }
+
+    ScopedSkipHeapCapture skipHeapCapture {};
+
+    D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
+    heapDesc.NumDescriptors = 1;
+    heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+    heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+
+    result = InDevice->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&_scHeap));
+
+    if (result != S_OK)
+    {
+        LOG_ERROR("[{0}] CreateDescriptorHeap error {1:x}", _name, (unsigned int) result);
+        return;
+    }
+
+    _init = InitHeaps(InDevice, _frameHeaps, HV_NUM_OF_SLOTS);
+}
+
+HV_Dx12::~HV_Dx12()
+{
+    if (!_init || State::Instance().isShuttingDown)
+        return;
+
+    for (int i = 0; i < HV_NUM_OF_SLOTS; i++)
+    {
+        _frameHeaps[i].ReleaseHeaps();
+        SAFE_RELEASE(_slots[i].Readback);
+    }
+
+    ReleaseSwapchain();
+    SAFE_RELEASE(_stats);
+    SAFE_RELEASE(_scHeap);
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "SysUtils.h"
+
+#include <d3d12.h>
+#include <d3dx/d3dx12.h>
+#include <dxgi1_6.h>
+#include <shaders/Shader_Dx12Utils.h>
+#include <shaders/Shader_Dx12.h>
+#include <hudfix/HudlessValidator.h>
+#include <misc/SwapchainCache.h>
+
+#include <memory>
+
+// Frames in flight can't be more than this, so a slot is finished on GPU when it comes around again
+#define HV_NUM_OF_SLOTS 4
+
+// Reduces the difference between a hudless candidate and the final image into per tile stats,
+// which are read back HV_NUM_OF_SLOTS dispatches later. Doesn't write into the swapchain.
+class HV_Dx12 : public Shader_Dx12
+{
+  public:
+    static constexpr uint32_t TileSize = 32;
+
+  private:
+    struct alignas(256) InternalValidateParams
+    {
+        float DiffThreshold = 0.01f;
+        uint32_t Width = 0;
+        uint32_t Height = 0;
+        uint32_t TilesX = 0;
+    };
+
+    struct Slot
+    {
+        ID3D12Resource* Readback = nullptr;
+        uint64_t Tag = 0;
+        uint32_t Tiles = 0;
+        bool Pending = false;
+    };
+
+    FrameDescriptorHeap _frameHeaps[HV_NUM_OF_SLOTS];
+    Slot _slots[HV_NUM_OF_SLOTS];
+
+    ID3D12Resource* _stats = nullptr;
+    uint32_t _statsTiles = 0;
+    uint32_t _statsWidth = 0;
+    uint32_t _statsHeight = 0;
+
+    std::vector<HudlessTileStats> _tiles;
+    uint64_t _resultTag = 0;
+    HudlessStats _result {};
+    bool _hasResult = false;
+
+    // Cached backbuffers the copy below was created for
+    std::shared_ptr<const SwapchainBuffers> _swapchain;
+    ID3D12Resource* _scCopy = nullptr;       // Used when backbuffers can't be read by shaders
+    ID3D12DescriptorHeap* _scHeap = nullptr; // SRV of _scCopy, not shader visible, copied into frame heaps
+
+    bool CacheSwapchain(IDXGISwapChain3* sc);
+    void ReleaseSwapchain();
+    bool CreateStatsBuffers(uint32_t width, uint32_t height);
+    void ReadSlot(Slot& slot);
+
+    bool DispatchStats(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* hudless,
+                       D3D12_RESOURCE_STATES hudlessState, ID3D12Resource* present,
+                       D3D12_RESOURCE_STATES presentState, D3D12_CPU_DESCRIPTOR_HANDLE* presentSrv, uint64_t tag);
+
+  public:
+    // Compares with the current backbuffer of the swapchain, it must be in PRESENT state
+    bool Dispatch(IDXGISwapChain3* sc, ID3D12GraphicsCommandList* cmdList, ID3D12Resource* hudless,
+                  D3D12_RESOURCE_STATES hudlessState, uint64_t tag);
+
+    bool Dispatch(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* hudless, D3D12_RESOURCE_STATES hudlessState,
+                  ID3D12Resource* present, D3D12_RESOURCE_STATES presentState, uint64_t tag);
+
+    // Stats of an earlier dispatch which became available during the last Dispatch call
+    bool GetResult(uint64_t& tag, HudlessStats& stats);
+
+    HV_Dx12(std::string InName, ID3D12Device* InDevice);
+
+    ~HV_Dx12();
+};
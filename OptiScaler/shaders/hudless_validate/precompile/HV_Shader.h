@@ -0,0 +1,9 @@
+#pragma once
+
+// Generated by shaders/shader_tools/build_hudless_validate_shader.py, don't edit
+// Not generated yet, shader is compiled at runtime until then
+
+#include <cstddef>
+
+inline static const unsigned char* HV_cso = nullptr;
+inline static const size_t HV_cso_size = 0;
@@ -36,6 +36,7 @@ class RCAS_Dx12 : public Shader_Dx12, public RCAS_Common
                   RcasConstants InConstants, ID3D12Resource* OutResource, ID3D12Resource* InDepth = nullptr);
 
     ID3D12Resource* Buffer() { return _buffer; }
+    void ReleaseBuffer();
     bool CanRender() const { return _init && _buffer != nullptr; }
 
     RCAS_Dx12(std::string InName, ID3D12Device* InDevice);
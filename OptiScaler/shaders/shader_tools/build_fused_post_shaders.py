@@ -0,0 +1,98 @@
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+# Compiles every fused post permutation with fxc and writes them into a single header.
+# Source is taken from fusedPostCode in FP_Common.h, so runtime compiled and precompiled shaders match.
+#   python build_fused_post_shaders.py
+
+tools_dir = os.path.dirname(os.path.abspath(__file__))
+fused_dir = os.path.join(tools_dir, "..", "fused_post")
+common_file = os.path.join(fused_dir, "FP_Common.h")
+output_file = os.path.join(fused_dir, "precompile", "FP_Precompiled.h")
+
+# Same values as the Scaler, FPSharpen & FPOutput enums
+scalers = { 1: "bicubic", 2: "catmull", 3: "lanczos2", 4: "lanczos3", 5: "kaiser2", 6: "kaiser3" }
+sharpens = { 0: "none", 1: "rcas" }
+outputs = { 0: "float", 1: "unorm" }
+
+
+def read_source():
+    with open(common_file, "r", encoding="utf-8") as f:
+        text = f.read()
+
+    match = re.search(r'fusedPostCode = R"\((.*?)\)";', text, re.S)
+
+    if match is None:
+        print(f"fusedPostCode not found in {common_file}")
+        sys.exit(1)
+
+    return match.group(1)
+
+
+def compile_permutation(source, scaler, sharpen, output, temp_dir):
+    hlsl_file = os.path.join(temp_dir, "fp.hlsl")
+    cso_file = os.path.join(temp_dir, "fp.cso")
+
+    with open(hlsl_file, "w", encoding="utf-8") as f:
+        f.write(f"#define FP_SHARPEN {sharpen}\n#define FP_SCALER {scaler}\n#define FP_OUTPUT {output}\n")
+        f.write(source)
+
+    result = subprocess.run([os.path.join(tools_dir, "fxc.exe"), "/nologo", "/T", "cs_5_0", "/E", "CSMain", "/O3",
+                             hlsl_file, "/Fo", cso_file])
+
+    if result.returncode != 0:
+        print(f"Compilation failed: scaler {scaler}, sharpen {sharpen}, output {output}")
+        sys.exit(1)
+
+    with open(cso_file, "rb") as f:
+        return f.read()
+
+
+def write_array(f, name, data):
+    f.write(f"inline static const unsigned char {name}[] = {{\n    ")
+
+    for i, byte in enumerate(data):
+        f.write(f"0x{byte:02x}")
+        if i < len(data) - 1:
+            f.write(", ")
+        if (i + 1) % 12 == 0:
+            f.write("\n    ")
+
+    f.write("\n};\n\n")
+
+
+def main():
+    source = read_source()
+    entries = []
+
+    with tempfile.TemporaryDirectory() as temp_dir, open(output_file, "w", newline="\n") as f:
+        f.write("#pragma once\n\n")
+        f.write("// Generated by shaders/shader_tools/build_fused_post_shaders.py, don't edit\n\n")
+        f.write("#include <cstddef>\n#include <cstdint>\n\n")
+
+        for scaler, scaler_name in scalers.items():
+            for sharpen, sharpen_name in sharpens.items():
+                for output, output_name in outputs.items():
+                    name = f"fp_{scaler_name}_{sharpen_name}_{output_name}_cso"
+                    write_array(f, name, compile_permutation(source, scaler, sharpen, output, temp_dir))
+
+                    # Same as FPPermutation::Key()
+                    entries.append(((sharpen << 8) | (output << 4) | scaler, name))
+
+        f.write("struct FPPrecompiledShader\n{\n    uint32_t Key;\n    const unsigned char* Data;\n"
+                "    size_t Size;\n};\n\n")
+        f.write("inline static const FPPrecompiledShader fpPrecompiledShaders[] = {\n")
+
+        for key, name in entries:
+            f.write(f"    {{ 0x{key:03x}, {name}, sizeof({name}) }},\n")
+
+        f.write("    { 0, nullptr, 0 },\n};\n")
+
+    print(f"{len(entries)} permutations written to {output_file}")
+
+
+if __name__ == "__main__":
+    main()
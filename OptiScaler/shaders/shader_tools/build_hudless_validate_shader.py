@@ -0,0 +1,73 @@
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+# Compiles the hudless validation shader with fxc and writes it into a header.
+# Source is taken from hvCode in HV_Common.h, so runtime compiled and precompiled shaders match.
+#   python build_hudless_validate_shader.py
+
+tools_dir = os.path.dirname(os.path.abspath(__file__))
+hv_dir = os.path.join(tools_dir, "..", "hudless_validate")
+common_file = os.path.join(hv_dir, "HV_Common.h")
+output_file = os.path.join(hv_dir, "precompile", "HV_Shader.h")
+
+
+def read_source():
+    with open(common_file, "r", encoding="utf-8") as f:
+        text = f.read()
+
+    match = re.search(r'hvCode = R"\((.*?)\)";', text, re.S)
+
+    if match is None:
+        print(f"hvCode not found in {common_file}")
+        sys.exit(1)
+
+    return match.group(1)
+
+
+def compile_shader(source, temp_dir):
+    hlsl_file = os.path.join(temp_dir, "hv.hlsl")
+    cso_file = os.path.join(temp_dir, "hv.cso")
+
+    with open(hlsl_file, "w", encoding="utf-8") as f:
+        f.write(source)
+
+    result = subprocess.run([os.path.join(tools_dir, "fxc.exe"), "/nologo", "/T", "cs_5_0", "/E", "CSMain", "/O3",
+                             hlsl_file, "/Fo", cso_file])
+
+    if result.returncode != 0:
+        print("Compilation failed")
+        sys.exit(1)
+
+    with open(cso_file, "rb") as f:
+        return f.read()
+
+
+def main():
+    with tempfile.TemporaryDirectory() as temp_dir:
+        data = compile_shader(read_source(), temp_dir)
+
+    with open(output_file, "w", newline="\n") as f:
+        f.write("#pragma once\n\n")
+        f.write("// Generated by shaders/shader_tools/build_hudless_validate_shader.py, don't edit\n\n")
+        f.write("#include <cstddef>\n\n")
+        f.write("inline static const unsigned char HV_cso_data[] = {\n    ")
+
+        for i, byte in enumerate(data):
+            f.write(f"0x{byte:02x}")
+            if i < len(data) - 1:
+                f.write(", ")
+            if (i + 1) % 12 == 0:
+                f.write("\n    ")
+
+        f.write("\n};\n\n")
+        f.write("inline static const unsigned char* HV_cso = HV_cso_data;\n")
+        f.write("inline static const size_t HV_cso_size = sizeof(HV_cso_data);\n")
+
+    print(f"{len(data)} bytes written to {output_file}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,709 @@
+import argparse
+import math
+import os
+import sys
+import time
+
+import numpy as np
+
+# CPU reference implementations of the output scaling and sharpening compute shaders.
+# Kernels follow the HLSL in output_scaling/OS_Common.h and rcas/RCAS_Common.h (float32, texel
+# center aligned, clamp addressing) and are vectorized with numpy so they run on any CI host.
+# Results track the GPU within float32 rounding, they are not bit exact (GPU sin / exp / rcp differ).
+# FSR1 (EASU) is not covered here, tools/kernel_bench has C++ ports of OS / RCAS / EASU with scalar and AVX2
+# paths compared bit exact. Motion adaptive sharpness and debug tints are not modelled.
+#
+# Usage: kernel_reference.py [images...] [--corpus <dir>] [--ratios 1.5,2.0,3.0] [--scaler all]
+#                            [--sharpen rcas] [--sharpness 0.5] [--depth <dir>] [--reference <dir>]
+#                            [--output <dir>] [--csv <file>] [--runs 3]
+
+SCALERS = ["bicubic", "catmull", "lanczos2", "lanczos3", "kaiser2", "kaiser3", "magic"]
+SHARPENERS = ["rcas", "da", "lcda"]
+IMAGE_EXTENSIONS = (".png", ".exr", ".npy")
+
+LUMA = np.array([0.2126, 0.7152, 0.0722], dtype=np.float32)
+
+
+def load_image(path):
+    if path.lower().endswith(".npy"):
+        img = np.load(path).astype(np.float32)
+    elif path.lower().endswith(".exr"):
+        import OpenEXR
+        import Imath
+
+        exr = OpenEXR.InputFile(path)
+        window = exr.header()["dataWindow"]
+        width = window.max.x - window.min.x + 1
+        height = window.max.y - window.min.y + 1
+        pixel_type = Imath.PixelType(Imath.PixelType.FLOAT)
+        channels = [np.frombuffer(exr.channel(c, pixel_type), dtype=np.float32) for c in "RGB"]
+        img = np.stack(channels, axis=-1).reshape(height, width, 3)
+    else:
+        from PIL import Image
+
+        img = np.asarray(Image.open(path).convert("RGB"), dtype=np.float32) / 255.0
+
+    return np.ascontiguousarray(img[..., :3], dtype=np.float32)
+
+
+def find_images(corpus):
+    found = []
+
+    for root, _, files in os.walk(corpus):
+        for name in sorted(files):
+            if name.lower().endswith(IMAGE_EXTENSIONS):
+                found.append(os.path.join(root, name))
+
+    return sorted(found)
+
+
+def save_image(path, img):
+    if path.lower().endswith(".npy"):
+        np.save(path, img)
+        return
+
+    from PIL import Image
+
+    Image.fromarray((np.clip(img, 0.0, 1.0) * 255.0 + 0.5).astype(np.uint8)).save(path)
+
+
+# Destination pixel centers mapped to source texel space, same as the shaders
+def source_positions(src_size, dst_size):
+    scale = np.float32(src_size) / np.float32(dst_size)
+    pos = (np.arange(dst_size, dtype=np.float32) + np.float32(0.5)) * scale - np.float32(0.5)
+    ip = np.floor(pos)
+    return ip.astype(np.int64), (pos - ip).astype(np.float32)
+
+
+def cubic_keys(x, a):
+    x = np.abs(x)
+    x2 = x * x
+    x3 = x2 * x
+    near = (a + 2.0) * x3 - (a + 3.0) * x2 + 1.0
+    far = a * x3 - 5.0 * a * x2 + 8.0 * a * x - 4.0 * a
+    return np.where(x < 1.0, near, np.where(x < 2.0, far, 0.0)).astype(np.float32)
+
+
+def sinc(x):
+    x = x * np.float32(3.1415926535)
+    safe = np.where(np.abs(x) < 1e-5, 1.0, x)
+    return np.where(np.abs(x) < 1e-5, 1.0, np.sin(safe) / safe).astype(np.float32)
+
+
+def lanczos(x, a):
+    return np.where(np.abs(x) >= a, 0.0, sinc(x) * sinc(x / a)).astype(np.float32)
+
+
+# Same Cephes style polynomial as the shaders, not scipy's i0
+def bessel_i0(x):
+    ax = np.abs(x)
+    t = x / 3.75
+    t2 = t * t
+    small = 1.0 + t2 * (3.5156229 + t2 * (3.0899424 + t2 * (1.2067492 + t2 * (0.2659732 + t2 * (0.0360768 + t2 * 0.0045813)))))
+
+    axs = np.maximum(ax, 3.75)
+    u = 3.75 / axs
+    large = (np.exp(axs) / np.sqrt(axs)) * (
+        0.39894228
+        + u * (0.01328592 + u * (0.00225319 + u * (-0.00157565 + u * (0.00916281 + u * (-0.02057706 + u * (0.02635537 + u * (-0.01647633 + u * 0.00392377)))))))
+    )
+
+    return np.where(ax < 3.75, small, large).astype(np.float32)
+
+
+def kaiser(x, a, beta):
+    r = np.abs(x) / a
+    t = np.sqrt(np.clip(1.0 - r * r, 0.0, 1.0))
+    window = bessel_i0(beta * t) / bessel_i0(np.float32(beta))
+    return np.where(np.abs(x) >= a, 0.0, sinc(x) * window).astype(np.float32)
+
+
+# Fixed footprint separable filter with normalized weights and min/max ringing clamp
+def resample_taps(img, dst_w, dst_h, kernel, radius):
+    src_h, src_w, _ = img.shape
+    taps = 2 * radius
+
+    ipx, fx = source_positions(src_w, dst_w)
+    ipy, fy = source_positions(src_h, dst_h)
+
+    offsets = np.arange(taps) - (radius - 1)
+    wx = kernel(offsets[None, :] - fx[:, None])
+    wy = kernel(offsets[None, :] - fy[:, None])
+    wx /= np.where(wx.sum(axis=1, keepdims=True) != 0.0, wx.sum(axis=1, keepdims=True), 1.0)
+    wy /= np.where(wy.sum(axis=1, keepdims=True) != 0.0, wy.sum(axis=1, keepdims=True), 1.0)
+
+    xs = np.clip(ipx[:, None] + offsets[None, :], 0, src_w - 1)
+    ys = np.clip(ipy[:, None] + offsets[None, :], 0, src_h - 1)
+
+    # Horizontal pass per tap row keeps memory at taps * dst_w * src_h
+    acc = np.zeros((dst_h, dst_w, 3), dtype=np.float32)
+    mn = np.full((dst_h, dst_w, 3), 1e30, dtype=np.float32)
+    mx = np.full((dst_h, dst_w, 3), -1e30, dtype=np.float32)
+
+    for j in range(taps):
+        rows = img[ys[:, j]]
+        for i in range(taps):
+            s = rows[:, xs[:, i]]
+            acc += s * (wy[:, j, None, None] * wx[None, :, i, None])
+            np.minimum(mn, s, out=mn)
+            np.maximum(mx, s, out=mx)
+
+    return np.clip(acc, mn, mx)
+
+
+def bilinear(img, x, y):
+    src_h, src_w, _ = img.shape
+    x0 = np.floor(x)
+    y0 = np.floor(y)
+    tx = (x - x0)[None, :, None]
+    ty = (y - y0)[:, None, None]
+    x0 = x0.astype(np.int64)
+    y0 = y0.astype(np.int64)
+    xa = np.clip(x0, 0, src_w - 1)
+    xb = np.clip(x0 + 1, 0, src_w - 1)
+    ya = np.clip(y0, 0, src_h - 1)
+    yb = np.clip(y0 + 1, 0, src_h - 1)
+
+    top = img[ya][:, xa] * (1.0 - tx) + img[ya][:, xb] * tx
+    bottom = img[yb][:, xa] * (1.0 - tx) + img[yb][:, xb] * tx
+    return (top * (1.0 - ty) + bottom * ty).astype(np.float32)
+
+
+# 4x4 Keys cubic through 4 bilinear samples, like downsampleCodeBC / downsampleCodeCatmull
+def resample_cubic(img, dst_w, dst_h, a):
+    src_h, src_w, _ = img.shape
+    ipx, fx = source_positions(src_w, dst_w)
+    ipy, fy = source_positions(src_h, dst_h)
+
+    def axis(t):
+        w0 = cubic_keys(1.0 + t, a)
+        w1 = cubic_keys(t, a)
+        w2 = cubic_keys(1.0 - t, a)
+        w3 = cubic_keys(2.0 - t, a)
+        w01 = w0 + w1
+        w23 = w2 + w3
+        o01 = -1.0 + w1 * np.where(w01 != 0.0, 1.0 / np.where(w01 != 0.0, w01, 1.0), 0.0)
+        o23 = 1.0 + w3 * np.where(w23 != 0.0, 1.0 / np.where(w23 != 0.0, w23, 1.0), 0.0)
+        return w01, w23, o01, o23
+
+    wx01, wx23, ox01, ox23 = axis(fx)
+    wy01, wy23, oy01, oy23 = axis(fy)
+
+    basex = (ipx - 1).astype(np.float32)
+    basey = (ipy - 1).astype(np.float32)
+
+    s00 = bilinear(img, basex + ox01, basey + oy01)
+    s10 = bilinear(img, basex + ox23, basey + oy01)
+    s01 = bilinear(img, basex + ox01, basey + oy23)
+    s11 = bilinear(img, basex + ox23, basey + oy23)
+
+    wx01 = wx01[None, :, None]
+    wx23 = wx23[None, :, None]
+    out = (s00 * wx01 + s10 * wx23) * wy01[:, None, None] + (s01 * wx01 + s11 * wx23) * wy23[:, None, None]
+
+    mn = np.minimum(np.minimum(s00, s10), np.minimum(s01, s11))
+    mx = np.maximum(np.maximum(s00, s10), np.maximum(s01, s11))
+    return np.clip(out, mn, mx)
+
+
+def magic_kernel(x):
+    left = 0.5 * (x + 1.5) * (x + 1.5)
+    middle = 0.75 - x * x
+    right = 0.5 * (x - 1.5) * (x - 1.5)
+    value = np.where(x <= -0.5, left, np.where(x < 0.5, middle, right))
+    return np.where(np.abs(x) >= 1.5, 0.0, value).astype(np.float32)
+
+
+MAGIC_RADIUS = np.float32(1.5)
+MAGIC_MAX_TAPS = 12
+
+
+# Per axis taps of downsampleCodeMAGIC, footprint depends on the ratio
+def magic_axis(src_size, dst_size):
+    k = np.float32(dst_size) / np.float32(src_size)
+    o = np.arange(dst_size, dtype=np.float32) + np.float32(0.5)
+
+    x0 = np.clip(np.ceil((o - MAGIC_RADIUS) / k - 0.5).astype(np.int64), 0, src_size - 1)
+    x1 = np.clip(np.floor((o + MAGIC_RADIUS) / k - 0.5).astype(np.int64), 0, src_size - 1)
+    count = np.clip(x1 - x0 + 1, 1, MAGIC_MAX_TAPS)
+
+    taps = np.arange(MAGIC_MAX_TAPS)
+    base = k * (x0.astype(np.float32) + np.float32(0.5)) - o
+    weights = magic_kernel(base[:, None] + k * taps[None, :].astype(np.float32))
+    weights = np.where(taps[None, :] < count[:, None], weights, 0.0).astype(np.float32)
+
+    total = weights.sum(axis=1, keepdims=True)
+    weights *= np.where(total > 0.0, 1.0 / np.where(total > 0.0, total, 1.0), 0.0).astype(np.float32)
+
+    return np.clip(x0[:, None] + taps[None, :], 0, src_size - 1), weights
+
+
+# No ringing clamp in the MAGIC shader, so it can be done as two passes
+def resample_magic(img, dst_w, dst_h):
+    src_h, src_w, _ = img.shape
+    xs, wx = magic_axis(src_w, dst_w)
+    ys, wy = magic_axis(src_h, dst_h)
+
+    rows = np.zeros((src_h, dst_w, 3), dtype=np.float32)
+    for i in range(MAGIC_MAX_TAPS):
+        rows += img[:, xs[:, i]] * wx[None, :, i, None]
+
+    out = np.zeros((dst_h, dst_w, 3), dtype=np.float32)
+    for j in range(MAGIC_MAX_TAPS):
+        out += rows[ys[:, j]] * wy[:, j, None, None]
+
+    return out
+
+
+def resample(img, dst_w, dst_h, scaler):
+    if scaler == "bicubic":
+        return resample_cubic(img, dst_w, dst_h, np.float32(-0.6))
+    if scaler == "catmull":
+        return resample_cubic(img, dst_w, dst_h, np.float32(-0.45))
+    if scaler == "lanczos2":
+        return resample_taps(img, dst_w, dst_h, lambda x: lanczos(x, np.float32(2.0)), 2)
+    if scaler == "lanczos3":
+        return resample_taps(img, dst_w, dst_h, lambda x: lanczos(x, np.float32(3.0)), 3)
+    if scaler == "kaiser2":
+        return resample_taps(img, dst_w, dst_h, lambda x: kaiser(x, np.float32(2.0), np.float32(5.0)), 2)
+    if scaler == "kaiser3":
+        return resample_taps(img, dst_w, dst_h, lambda x: kaiser(x, np.float32(3.0), np.float32(6.0)), 3)
+    if scaler == "magic":
+        return resample_magic(img, dst_w, dst_h)
+
+    raise ValueError(f"Unknown scaler: {scaler}")
+
+
+# rcasCode without motion sharpness (DynamicSharpenEnabled = 0)
+def rcas(img, sharpness, contrast=0.0):
+    if sharpness == 0.0:
+        return img.copy()
+
+    e = img
+    b = np.concatenate([img[:1], img[:-1]], axis=0)
+    h = np.concatenate([img[1:], img[-1:]], axis=0)
+    d = np.concatenate([img[:, :1], img[:, :-1]], axis=1)
+    f = np.concatenate([img[:, 1:], img[:, -1:]], axis=1)
+
+    local_scale = np.maximum(np.max(np.maximum.reduce([e, b, d, f, h]), axis=-1, keepdims=True), 1.0)
+
+    en = np.maximum(e / local_scale, 0.0)
+    bn = np.maximum(b / local_scale, 0.0)
+    dn = np.maximum(d / local_scale, 0.0)
+    fn = np.maximum(f / local_scale, 0.0)
+    hn = np.maximum(h / local_scale, 0.0)
+
+    min_rgb = np.minimum(np.minimum(bn, dn), np.minimum(fn, hn))
+    max_rgb = np.maximum(np.maximum(bn, dn), np.maximum(fn, hn))
+
+    hit_min = min_rgb / np.maximum(4.0 * max_rgb, 1e-5)
+    hit_max = (1.0 - max_rgb) / np.maximum(4.0 * min_rgb - 4.0, -1e-5)
+
+    lobe_rgb = np.maximum(-hit_min, hit_max)
+    lobe = np.maximum(-0.1875, np.minimum(np.max(lobe_rgb, axis=-1, keepdims=True), 0.0)) * sharpness
+
+    if contrast != 0.0:
+        amp = np.clip(np.minimum(min_rgb, 2.0 - max_rgb) / np.maximum(max_rgb, 1e-5), 0.0, 1.0)
+        amp = 1.0 / np.sqrt(np.maximum(amp, 1e-5))
+        peak = -3.0 * contrast + 8.0
+        contrast_factor = 1.0 / np.maximum(amp[..., 1:2] * peak, 1.0)
+        lobe *= 1.0 + (contrast_factor - 1.0) * min(max(contrast, 0.0), 1.0)
+
+    rcp_l = 1.0 / (4.0 * lobe + 1.0)
+    return ((((bn + dn + fn + hn) * lobe + en) * rcp_l) * local_scale).astype(np.float32)
+
+
+# Clamp addressed neighbour, value of img[y + dy, x + dx]
+def neighbour(img, dx, dy):
+    height, width = img.shape[:2]
+    ys = np.clip(np.arange(height) + dy, 0, height - 1)
+    xs = np.clip(np.arange(width) + dx, 0, width - 1)
+    return img[ys][:, xs]
+
+
+# SafeLoadDepthLinearFromOutputPixel for linear depth, sampled at output pixel p + (dx, dy)
+def depth_neighbour(depth, width, height, dx, dy):
+    depth_h, depth_w = depth.shape
+    scale = np.float32(depth_w) / np.float32(width)
+
+    def index(size, offset, limit):
+        coords = (np.arange(size) + offset).astype(np.float32)
+        return np.clip(((coords + np.float32(0.5)) * scale).astype(np.int64), 0, limit - 1)
+
+    return depth[index(height, dy, depth_h)][:, index(width, dx, depth_w)]
+
+
+def lerp(a, b, t):
+    return a + (b - a) * t
+
+
+def max3(c):
+    return np.max(c, axis=-1)
+
+
+CROSS = [(0, -1), (-1, 0), (1, 0), (0, 1)]
+DIAGONAL = [(-1, -1), (1, -1), (-1, 1), (1, 1)]
+
+
+def depth_gradient(center, cross):
+    up, left, right, down = cross
+    gxf = right - center
+    gxb = center - left
+    gyf = down - center
+    gyb = center - up
+
+    gx = np.where(np.abs(gxf) < np.abs(gxb), gxf, gxb)
+    gy = np.where(np.abs(gyf) < np.abs(gyb), gyf, gyb)
+
+    max_grad = np.abs(center) * 0.05
+    return np.clip(gx, -max_grad, max_grad), np.clip(gy, -max_grad, max_grad)
+
+
+# DepthWeightGrad / DepthWeightGradSoft (floor 0.65) and DepthWeightTapGrad (floor 0.35)
+def depth_weight(center, sample, gradient, offset, depth_scale, depth_bias, floor):
+    predicted = center + offset[0] * gradient[0] + offset[1] * gradient[1]
+    residual = np.abs(sample - predicted) / np.maximum(np.abs(center), 1e-4)
+    residual = np.maximum(residual - depth_bias - 1e-5, 0.0)
+    return lerp(floor, 1.0, np.clip(1.0 - residual * depth_scale, 0.0, 1.0))
+
+
+# Sharpness reduction shared by the depth aware shaders, motion adaptive part not modelled
+def depth_aware_sharpness(sharpness, c, cross_colors, center_depth, cross_depths, gradient, depth_scale, depth_bias,
+                          far_boost):
+    adaptive = min(max(sharpness, 0.0), 2.0)
+
+    center_luma = c @ LUMA
+    cross_lumas = [color @ LUMA for color in cross_colors]
+
+    luma_sum = sum(np.abs(luma - center_luma) for luma in cross_lumas)
+    depth_edge = np.ones_like(center_depth)
+
+    for offset, depth in zip(CROSS, cross_depths):
+        depth_edge = np.minimum(
+            depth_edge, depth_weight(center_depth, depth, gradient, offset, depth_scale, depth_bias, 0.65)
+        )
+
+    luma_confirm = np.clip((luma_sum * 0.25 - 0.02) * 18.0, 0.0, 1.0)
+    edge_factor = lerp(1.0, depth_edge, lerp(0.15, 1.0, luma_confirm))
+    edge_sharpness = adaptive * lerp(0.2, 1.0, edge_factor)
+
+    boost = np.clip((np.log2(np.maximum(center_depth, 1e-4)) - 4.0) * 0.15, 0.0, 1.0)
+    motion_stability = min(max(adaptive / max(sharpness, 1e-4), 0.0), 1.0)
+    distance_boost = lerp(1.0, lerp(1.0, far_boost, boost), motion_stability)
+
+    luma_range = np.maximum.reduce(cross_lumas + [center_luma]) - np.minimum.reduce(cross_lumas + [center_luma])
+    unstable = np.clip((luma_range - 0.12) * 4.0, 0.0, 1.0)
+    unstable *= unstable
+
+    return (edge_sharpness * distance_boost * lerp(1.0, 0.9, unstable)).astype(np.float32)
+
+
+# daSharpenCode, depth is linear and at any resolution
+def depth_aware_rcas(img, depth, sharpness, depth_scale, depth_bias, clamp_output):
+    height, width, _ = img.shape
+
+    if sharpness <= 0.0:
+        return np.clip(img, 0.0, 1.0) if clamp_output else img.copy()
+
+    e = img
+    cross_colors = [neighbour(img, dx, dy) for dx, dy in CROSS]
+    center_depth = depth_neighbour(depth, width, height, 0, 0)
+    cross_depths = [depth_neighbour(depth, width, height, dx, dy) for dx, dy in CROSS]
+    gradient = depth_gradient(center_depth, cross_depths)
+
+    final = np.minimum(
+        depth_aware_sharpness(sharpness, e, cross_colors, center_depth, cross_depths, gradient, depth_scale,
+                              depth_bias, 1.35),
+        2.0,
+    )
+
+    local_scale = np.maximum(np.maximum.reduce([max3(c) for c in [e] + cross_colors]), 1e-4)[..., None]
+
+    taps = []
+    for offset, color, depth_tap in zip(CROSS, cross_colors, cross_depths):
+        w = depth_weight(center_depth, depth_tap, gradient, offset, depth_scale, depth_bias, 0.65)[..., None]
+        taps.append(lerp(e, color, w) / local_scale)
+
+    bn, dn, fn, hn = taps
+    en = e / local_scale
+
+    min_rgb = np.minimum(np.minimum(bn, dn), np.minimum(fn, hn))
+    max_rgb = np.maximum(np.maximum(bn, dn), np.maximum(fn, hn))
+
+    hit_min = min_rgb / np.maximum(4.0 * max_rgb, 1e-5)
+    hit_max = (1.0 - max_rgb) / np.maximum(4.0 * min_rgb - 4.0, -1e-5)
+    lobe_rgb = np.maximum(-hit_min, hit_max)
+
+    rcas_sharpness = np.clip(final, 0.0, 1.0)[..., None]
+    lobe = np.maximum(-0.1875, np.minimum(np.max(lobe_rgb, axis=-1, keepdims=True), 0.0)) * rcas_sharpness
+    output = (((bn + dn + fn + hn) * lobe + en) / (4.0 * lobe + 1.0)) * local_scale
+
+    return (np.clip(output, 0.0, 1.0) if clamp_output else output).astype(np.float32)
+
+
+def remap_local_contrast(x, center, amount):
+    d = np.clip(4.2 * (x - center), -1.0, 1.0)
+    return x + amount * 0.15166667 * (np.sin(d * np.float32(3.14159265)) + np.tanh(d * 4.0))
+
+
+# lcDASharpenCode, one level local Laplacian over the 3x3 neighbourhood
+def local_contrast_rcas(img, depth, sharpness, depth_scale, depth_bias, clamp_output):
+    height, width, _ = img.shape
+
+    if sharpness <= 0.0:
+        return np.clip(img, 0.0, 1.0) if clamp_output else img.copy()
+
+    c = img
+    cross_colors = [neighbour(img, dx, dy) for dx, dy in CROSS]
+    diagonal_colors = [neighbour(img, dx, dy) for dx, dy in DIAGONAL]
+    center_depth = depth_neighbour(depth, width, height, 0, 0)
+    cross_depths = [depth_neighbour(depth, width, height, dx, dy) for dx, dy in CROSS]
+    diagonal_depths = [depth_neighbour(depth, width, height, dx, dy) for dx, dy in DIAGONAL]
+    gradient = depth_gradient(center_depth, cross_depths)
+
+    final = np.clip(
+        depth_aware_sharpness(sharpness, c, cross_colors, center_depth, cross_depths, gradient, depth_scale,
+                              depth_bias, 1.25),
+        0.0,
+        1.5,
+    )[..., None]
+
+    local_scale = np.maximum.reduce([max3(color) for color in [c] + cross_colors + diagonal_colors])
+    local_scale = np.maximum(np.maximum(local_scale, 1e-4), 0.06)[..., None]
+
+    cn = c / local_scale
+    g1 = cn * 4.0
+    l0 = cn * 4.0
+    g1_weight = np.full(local_scale.shape, 4.0, dtype=np.float32)
+    l0_weight = np.full(local_scale.shape, 4.0, dtype=np.float32)
+
+    taps = [(offset, color, depth_tap, 2.0) for offset, color, depth_tap in zip(CROSS, cross_colors, cross_depths)]
+    taps += [(offset, color, depth_tap, 1.0) for offset, color, depth_tap in zip(DIAGONAL, diagonal_colors,
+                                                                                  diagonal_depths)]
+
+    for offset, color, depth_tap, scale in taps:
+        tap_n = color / local_scale
+        w = scale * depth_weight(center_depth, depth_tap, gradient, offset, depth_scale, depth_bias, 0.35)[..., None]
+
+        g1 = g1 + tap_n * w
+        l0 = l0 + remap_local_contrast(tap_n, cn, final) * w
+        g1_weight = g1_weight + w
+        l0_weight = l0_weight + w
+
+    g1 /= np.maximum(g1_weight, 1e-5)
+    l0 /= np.maximum(l0_weight, 1e-5)
+
+    output = ((cn - l0) + g1) * local_scale
+    return (np.clip(output, 0.0, 1.0) if clamp_output else output).astype(np.float32)
+
+
+# Same defaults as RCAS_Common::FillMotionConstants for linear depth
+DA_DEPTH_SCALE = 250.0
+DA_DEPTH_BIAS = 0.0015
+
+
+def sharpen(img, sharpener, sharpness, contrast, depth, hdr):
+    if sharpness == 0.0:
+        return img
+
+    if sharpener == "rcas":
+        return rcas(img, sharpness, contrast)
+
+    # Depth aware shaders get twice the configured sharpness, without depth every tap is on the same plane
+    if depth is None:
+        depth = np.ones(img.shape[:2], dtype=np.float32)
+
+    shader = depth_aware_rcas if sharpener == "da" else local_contrast_rcas
+    return shader(img, depth, sharpness * 2.0, DA_DEPTH_SCALE, DA_DEPTH_BIAS, not hdr)
+
+
+# Area average in float64, used as ground truth when no GPU reference is given
+def box_downscale(img, dst_w, dst_h):
+    src_h, src_w, _ = img.shape
+    sat = np.zeros((src_h + 1, src_w + 1, 3), dtype=np.float64)
+    sat[1:, 1:] = img.astype(np.float64).cumsum(axis=0).cumsum(axis=1)
+
+    def edges(src, dst):
+        pos = np.arange(dst + 1, dtype=np.float64) * src / dst
+        return np.clip(np.round(pos).astype(np.int64), 0, src)
+
+    xe = edges(src_w, dst_w)
+    ye = edges(src_h, dst_h)
+    x0, x1 = xe[:-1], np.maximum(xe[1:], xe[:-1] + 1)
+    y0, y1 = ye[:-1], np.maximum(ye[1:], ye[:-1] + 1)
+
+    total = sat[y1][:, x1] - sat[y0][:, x1] - sat[y1][:, x0] + sat[y0][:, x0]
+    area = ((y1 - y0)[:, None] * (x1 - x0)[None, :])[..., None]
+    return (total / area).astype(np.float32)
+
+
+def psnr(a, b):
+    peak = max(float(b.max()), 1.0)
+    mse = float(np.mean((a.astype(np.float64) - b.astype(np.float64)) ** 2))
+    return math.inf if mse == 0.0 else 10.0 * math.log10(peak * peak / mse)
+
+
+# Luma SSIM with an 8x8 box window
+def ssim(a, b, window=8):
+    luma = np.array([0.2126, 0.7152, 0.0722])
+    x = a.astype(np.float64) @ luma
+    y = b.astype(np.float64) @ luma
+
+    def box_mean(v):
+        sat = np.zeros((v.shape[0] + 1, v.shape[1] + 1))
+        sat[1:, 1:] = v.cumsum(axis=0).cumsum(axis=1)
+        return (sat[window:, window:] - sat[:-window, window:] - sat[window:, :-window] + sat[:-window, :-window]) / (
+            window * window
+        )
+
+    peak = max(float(y.max()), 1.0)
+    c1 = (0.01 * peak) ** 2
+    c2 = (0.03 * peak) ** 2
+
+    mx = box_mean(x)
+    my = box_mean(y)
+    vx = box_mean(x * x) - mx * mx
+    vy = box_mean(y * y) - my * my
+    cxy = box_mean(x * y) - mx * my
+
+    s = ((2 * mx * my + c1) * (2 * cxy + c2)) / ((mx * mx + my * my + c1) * (vx + vy + c2))
+    return float(s.mean())
+
+
+def load_optional(directory, name):
+    if not directory:
+        return None
+
+    stem = os.path.splitext(name)[0]
+
+    for ext in (os.path.splitext(name)[1],) + IMAGE_EXTENSIONS:
+        path = os.path.join(directory, stem + ext)
+        if os.path.exists(path):
+            return load_image(path) if ext != ".npy" else np.load(path).astype(np.float32)
+
+    return None
+
+
+def run(args):
+    scalers = SCALERS if args.scaler == "all" else [args.scaler]
+    ratios = [float(r) for r in args.ratios.split(",")]
+
+    images = list(args.images)
+    if args.corpus:
+        images += find_images(args.corpus)
+
+    if not images:
+        print("No images given")
+        sys.exit(1)
+
+    rows = []
+    summary = {}
+
+    print(f"{'image':<28} {'kernel':<18} {'src':>11} {'dst':>11} {'ms':>9} {'MPix/s':>8} {'PSNR':>8} {'SSIM':>7}")
+
+    for path in images:
+        img = load_image(path)
+        src_h, src_w, _ = img.shape
+        name = os.path.basename(path)
+        hdr = not path.lower().endswith(".png")
+
+        depth = load_optional(args.depth, name)
+        if depth is not None and depth.ndim == 3:
+            depth = depth[..., 0]
+
+        for ratio in ratios:
+            dst_w = max(1, int(src_w / ratio))
+            dst_h = max(1, int(src_h / ratio))
+
+            reference = load_optional(args.reference, f"{os.path.splitext(name)[0]}_{ratio:g}.npy")
+            if reference is None and len(ratios) == 1:
+                reference = load_optional(args.reference, name)
+            if reference is None:
+                reference = box_downscale(img, dst_w, dst_h)
+
+            for scaler in scalers:
+                kernel = scaler if args.sharpness == 0.0 else f"{scaler}+{args.sharpen}"
+                best = math.inf
+                out = None
+
+                for _ in range(args.runs):
+                    start = time.perf_counter()
+                    out = resample(img, dst_w, dst_h, scaler)
+                    out = sharpen(out, args.sharpen, args.sharpness, args.contrast, depth, hdr)
+                    best = min(best, time.perf_counter() - start)
+
+                mpix = dst_w * dst_h / best / 1e6
+                quality = (psnr(out, reference), ssim(out, reference)) if reference.shape == out.shape else None
+
+                if quality is not None:
+                    quality_text = f"{quality[0]:8.2f} {quality[1]:7.4f}"
+                else:
+                    quality_text = f"{'-':>8} {'-':>7}"
+
+                print(
+                    f"{name[:28]:<28} {kernel:<18} {f'{src_w}x{src_h}':>11} {f'{dst_w}x{dst_h}':>11} "
+                    f"{best * 1000.0:9.2f} {mpix:8.2f} {quality_text}"
+                )
+
+                rows.append((name, kernel, ratio, src_w, src_h, dst_w, dst_h, best * 1000.0, mpix, quality))
+                entry = summary.setdefault((kernel, ratio), [0, 0.0, 0.0, 0.0, 0])
+                entry[0] += 1
+                entry[1] += mpix
+                if quality is not None and math.isfinite(quality[0]):
+                    entry[2] += quality[0]
+                    entry[3] += quality[1]
+                    entry[4] += 1
+
+                if args.output:
+                    os.makedirs(args.output, exist_ok=True)
+                    stem, ext = os.path.splitext(name)
+                    out_ext = ext if ext == ".png" else ".npy"
+                    save_image(os.path.join(args.output, f"{stem}_{kernel}_{ratio:g}{out_ext}"), out)
+
+    # Corpus averages, the baseline to compare shader changes against
+    print()
+    print(f"{'kernel':<18} {'ratio':>6} {'images':>7} {'MPix/s':>8} {'PSNR':>8} {'SSIM':>7}")
+
+    for (kernel, ratio), (count, mpix, total_psnr, total_ssim, measured) in summary.items():
+        if measured > 0:
+            quality_text = f"{total_psnr / measured:8.2f} {total_ssim / measured:7.4f}"
+        else:
+            quality_text = f"{'-':>8} {'-':>7}"
+
+        print(f"{kernel:<18} {ratio:>6g} {count:>7} {mpix / count:8.2f} {quality_text}")
+
+    if args.csv:
+        with open(args.csv, "w", newline="") as f:
+            f.write("image,kernel,ratio,src_w,src_h,dst_w,dst_h,ms,mpix_s,psnr,ssim\n")
+
+            for name, kernel, ratio, src_w, src_h, dst_w, dst_h, ms, mpix, quality in rows:
+                psnr_text, ssim_text = (f"{quality[0]:.4f}", f"{quality[1]:.6f}") if quality else ("", "")
+                f.write(f"{name},{kernel},{ratio:g},{src_w},{src_h},{dst_w},{dst_h},{ms:.3f},{mpix:.3f},"
+                        f"{psnr_text},{ssim_text}\n")
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="CPU reference and benchmark for output scaling / sharpen kernels")
+    parser.add_argument("images", nargs="*", help="PNG / EXR / NPY frames at output scaling resolution")
+    parser.add_argument("--corpus", help="Directory searched recursively for PNG / EXR / NPY frames")
+    parser.add_argument("--ratios", default="2.0", help="Comma separated output scaling ratios, 2.0 = 4K -> 1080p")
+    parser.add_argument("--scaler", default="all", choices=["all"] + SCALERS)
+    parser.add_argument("--sharpen", default="rcas", choices=SHARPENERS, help="Sharpen shader used after scaling")
+    parser.add_argument("--sharpness", type=float, default=0.0, help="Sharpness, 0 disables sharpening")
+    parser.add_argument("--contrast", type=float, default=0.0, help="RCAS contrast")
+    parser.add_argument("--depth", help="Directory with linear depth (same file names) for the depth aware shaders")
+    parser.add_argument(
+        "--reference",
+        help="Directory with reference outputs, <name>_<ratio>.npy or same file names for a single ratio",
+    )
+    parser.add_argument("--output", help="Directory to write the results to")
+    parser.add_argument("--csv", help="Write per image results to this file")
+    parser.add_argument("--runs", type=int, default=3, help="Timing runs per kernel, best is reported")
+
+    args = parser.parse_args()
+
+    if any(float(r) < 1.0 for r in args.ratios.split(",")):
+        print("Only downscaling ratios (>= 1.0) are covered")
+        sys.exit(1)
+
+    run(args)
@@ -5,9 +5,6 @@
 
 #include <detours/detours.h>
 
-#include <string>
-#include <algorithm>
-#include <cctype>
 #include <misc/IdentifyGpu.h>
 
 typedef HRESULT (*PFN_GetDesc)(IDXGIAdapter* This, DXGI_ADAPTER_DESC* pDesc);
@@ -20,13 +17,26 @@ inline static PFN_GetDesc1 o_GetDesc1 = nullptr;
 inline static PFN_GetDesc2 o_GetDesc2 = nullptr;
 inline static PFN_GetDesc3 o_GetDesc3 = nullptr;
 
-inline static std::string toLower(std::string s)
+// Calls from these modules are the runtimes/drivers themselves and need the real adapter info
+const wchar_t* DxgiSpoofing::_passthroughModules[] = {
+    L"vulkan-1.dll", L"amdvlk64.dll", L"dxgi.dll", L"d3d12.dll", L"d3d12Core.dll",
+};
+
+// LDR_DLL_LOADED_NOTIFICATION_DATA / LDR_DLL_UNLOADED_NOTIFICATION_DATA, not in the SDK headers
+struct LdrDllNotificationData
 {
-    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return std::tolower(c); });
-    return s;
-}
+    ULONG Flags;
+    PCUNICODE_STRING FullDllName;
+    PCUNICODE_STRING BaseDllName;
+    PVOID DllBase;
+    ULONG SizeOfImage;
+};
 
-inline static bool iequals(const std::string& a, const std::string& b) { return toLower(a) == toLower(b); }
+#define LDR_DLL_NOTIFICATION_REASON_UNLOADED 2
+
+typedef NTSTATUS(NTAPI* PFN_LdrRegisterDllNotification)(ULONG Flags,
+                                                        void(CALLBACK* NotificationFunction)(ULONG, const void*, PVOID),
+                                                        PVOID Context, PVOID* Cookie);
 
 #pragma region DXGI Adapter methods
 
@@ -43,202 +53,229 @@ inline static bool SkipSpoofing()
     return skip;
 }
 
-HRESULT DxgiSpoofing::hkGetDesc3(IDXGIAdapter4* This, DXGI_ADAPTER_DESC3* pDesc)
+void CALLBACK DxgiSpoofing::OnDllNotification(ULONG reason, const void* data, PVOID context)
 {
-    auto result = o_GetDesc3(This, pDesc);
+    if (reason != LDR_DLL_NOTIFICATION_REASON_UNLOADED || data == nullptr)
+        return;
 
-    auto caller = Util::WhoIsTheCaller(_ReturnAddress());
+    // Runs under the loader lock, only touch the cache
+    std::unique_lock lock(_callerModuleMutex);
+    _callerModules.erase((uintptr_t) ((const LdrDllNotificationData*) data)->DllBase);
+}
 
-    if (iequals(caller, "vulkan-1.dll") || iequals(caller, "amdvlk64.dll") || iequals(caller, "dxgi.dll") ||
-        iequals(caller, "d3d12.dll") || iequals(caller, "d3d12Core.dll"))
+bool DxgiSpoofing::TrackModuleUnloads()
+{
+    auto ntdll = GetModuleHandleW(L"ntdll.dll");
+    auto registerNotification =
+        ntdll != nullptr ? (PFN_LdrRegisterDllNotification) GetProcAddress(ntdll, "LdrRegisterDllNotification")
+                         : nullptr;
+
+    PVOID cookie = nullptr;
+
+    if (registerNotification == nullptr || registerNotification(0, OnDllNotification, nullptr, &cookie) != 0)
     {
-        return result;
+        LOG_WARN("Can't register DLL notification, GetDesc callers won't be cached");
+        return false;
     }
 
-#if _DEBUG
-    LOG_TRACE("result: {:X}, caller: {}", (UINT) result, caller);
-#endif
+    return true;
+}
+
+bool DxgiSpoofing::IsPassthroughCaller(void* returnAddress)
+{
+    auto address = (uintptr_t) returnAddress;
 
-    if (result == S_OK)
     {
-        if (Config::Instance()->DxgiVRAM.has_value())
+        std::shared_lock lock(_callerModuleMutex);
+
+        if (auto it = _callerModules.upper_bound(address); it != _callerModules.begin())
         {
-            uint64_t newMemSize = (uint64_t) Config::Instance()->DxgiVRAM.value() * 1073741824; // 1024 * 1024 * 1024
-            pDesc->DedicatedVideoMemory = newMemSize;
+            --it;
+
+            if (address < it->second.End)
+                return it->second.Passthrough;
         }
+    }
 
-        if (pDesc->VendorId != VendorId::Microsoft &&
-            (!Config::Instance()->TargetVendorId.has_value() ||
-             Config::Instance()->TargetVendorId.value() == pDesc->VendorId) &&
-            (!Config::Instance()->TargetDeviceId.has_value() ||
-             Config::Instance()->TargetDeviceId.value() == pDesc->DeviceId) &&
-            Config::Instance()->DxgiSpoofing.value_or_default() && !SkipSpoofing())
-        {
-            pDesc->VendorId = Config::Instance()->SpoofedVendorId.value_or_default();
-            pDesc->DeviceId = Config::Instance()->SpoofedDeviceId.value_or_default();
+    // Miss, resolve the module the call came from. Not under _callerModuleMutex, the loader lock is taken here
+    HMODULE handle = nullptr;
+    if (!GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                            (LPCWSTR) returnAddress, &handle) ||
+        handle == nullptr)
+    {
+        return false;
+    }
 
-            auto szName = Config::Instance()->SpoofedGPUName.value_or_default();
-            std::memset(pDesc->Description, 0, sizeof(pDesc->Description));
-            std::wcscpy(pDesc->Description, szName.c_str());
+    wchar_t path[MAX_PATH] {};
+    if (GetModuleFileNameW(handle, path, MAX_PATH) == 0)
+        return false;
 
-#ifdef _DEBUG
-            LOG_DEBUG("spoofing");
-#endif
+    auto name = wcsrchr(path, L'\\');
+    name = name != nullptr ? name + 1 : path;
+
+    CallerModule module {};
+
+    for (auto passthroughName : _passthroughModules)
+    {
+        if (_wcsicmp(name, passthroughName) == 0)
+        {
+            module.Passthrough = true;
+            break;
         }
     }
 
-    AttachToAdapter(This);
+    auto dosHeader = (PIMAGE_DOS_HEADER) handle;
+    auto ntHeaders = (PIMAGE_NT_HEADERS) ((uint8_t*) handle + dosHeader->e_lfanew);
+    auto start = (uintptr_t) handle;
+    module.End = start + ntHeaders->OptionalHeader.SizeOfImage;
 
-    return result;
+    // Without unload notifications a new module could land on a cached range
+    if (_unloadTracking.load(std::memory_order_relaxed))
+    {
+        std::unique_lock lock(_callerModuleMutex);
+        _callerModules[start] = module;
+
+        LOG_DEBUG("GetDesc caller {}: {:X} - {:X}, passthrough: {}", wstring_to_string(name), start, module.End,
+                  module.Passthrough);
+    }
+
+    return module.Passthrough;
 }
 
-HRESULT DxgiSpoofing::hkGetDesc2(IDXGIAdapter2* This, DXGI_ADAPTER_DESC2* pDesc)
+DxgiSpoofing::SpoofedDesc DxgiSpoofing::GetSpoofedDesc(LUID luid, UINT vendorId, UINT deviceId)
 {
-    auto result = o_GetDesc2(This, pDesc);
+    auto& cfg = *Config::Instance();
+    auto generation = cfg.Generation();
+    auto key = ((uint64_t) luid.HighPart << 32) | luid.LowPart;
 
-    auto caller = Util::WhoIsTheCaller(_ReturnAddress());
-
-    if (iequals(caller, "vulkan-1.dll") || iequals(caller, "amdvlk64.dll") || iequals(caller, "dxgi.dll") ||
-        iequals(caller, "d3d12.dll") || iequals(caller, "d3d12Core.dll"))
     {
-        return result;
+        std::shared_lock lock(_spoofedDescMutex);
+
+        if (auto it = _spoofedDescs.find(key); it != _spoofedDescs.end() && it->second.Generation == generation)
+            return it->second;
     }
 
-#if _DEBUG
-    LOG_TRACE("result: {:X}, caller: {}", (UINT) result, caller);
-#endif
+    SpoofedDesc desc {};
+    desc.Generation = generation;
 
-    if (result == S_OK)
+    if (cfg.DxgiVRAM.has_value())
     {
-        if (Config::Instance()->DxgiVRAM.has_value())
-        {
-            uint64_t newMemSize = (uint64_t) Config::Instance()->DxgiVRAM.value() * 1073741824; // 1024 * 1024 * 1024
-            pDesc->DedicatedVideoMemory = newMemSize;
-        }
-
-        auto targetVendorIdMatches = !Config::Instance()->TargetVendorId.has_value() ||
-                                     Config::Instance()->TargetVendorId.value() == pDesc->VendorId;
-
-        auto targetDeviceIdMatches = !Config::Instance()->TargetDeviceId.has_value() ||
-                                     Config::Instance()->TargetDeviceId.value() == pDesc->DeviceId;
+        desc.OverrideVRAM = true;
+        desc.DedicatedVideoMemory = (uint64_t) cfg.DxgiVRAM.value() * 1073741824; // 1024 * 1024 * 1024
+    }
 
-        if (pDesc->VendorId != VendorId::Microsoft && targetVendorIdMatches && targetDeviceIdMatches &&
-            Config::Instance()->DxgiSpoofing.value_or_default() && !SkipSpoofing())
-        {
-            pDesc->VendorId = Config::Instance()->SpoofedVendorId.value_or_default();
-            pDesc->DeviceId = Config::Instance()->SpoofedDeviceId.value_or_default();
+    auto targetVendorIdMatches = !cfg.TargetVendorId.has_value() || cfg.TargetVendorId.value() == vendorId;
+    auto targetDeviceIdMatches = !cfg.TargetDeviceId.has_value() || cfg.TargetDeviceId.value() == deviceId;
 
-            auto szName = Config::Instance()->SpoofedGPUName.value_or_default();
-            std::memset(pDesc->Description, 0, sizeof(pDesc->Description));
-            std::wcscpy(pDesc->Description, szName.c_str());
+    if (vendorId != VendorId::Microsoft && targetVendorIdMatches && targetDeviceIdMatches)
+    {
+        desc.Spoof = true;
+        desc.VendorId = cfg.SpoofedVendorId.value_or_default();
+        desc.DeviceId = cfg.SpoofedDeviceId.value_or_default();
 
-#ifdef _DEBUG
-            LOG_DEBUG("spoofing");
-#endif
-        }
+        auto szName = cfg.SpoofedGPUName.value_or_default();
+        wcsncpy_s(desc.Description, szName.c_str(), _TRUNCATE);
     }
 
-    AttachToAdapter(This);
+    LOG_DEBUG("Built spoofed desc for adapter {:X}, spoof: {}, VRAM override: {}", key, desc.Spoof,
+              desc.OverrideVRAM);
 
-    return result;
+    std::unique_lock lock(_spoofedDescMutex);
+    _spoofedDescs[key] = desc;
+
+    return desc;
 }
 
-HRESULT DxgiSpoofing::hkGetDesc1(IDXGIAdapter1* This, DXGI_ADAPTER_DESC1* pDesc)
+template <typename T> void DxgiSpoofing::ApplySpoofing(T* pDesc)
 {
-    auto result = o_GetDesc1(This, pDesc);
+    auto desc = GetSpoofedDesc(pDesc->AdapterLuid, pDesc->VendorId, pDesc->DeviceId);
 
-    auto caller = Util::WhoIsTheCaller(_ReturnAddress());
+    if (desc.OverrideVRAM)
+        pDesc->DedicatedVideoMemory = desc.DedicatedVideoMemory;
 
-    if (iequals(caller, "vulkan-1.dll") || iequals(caller, "amdvlk64.dll") || iequals(caller, "dxgi.dll") ||
-        iequals(caller, "d3d12.dll") || iequals(caller, "d3d12Core.dll"))
+    // Spoofing can be toggled at runtime, so it's not part of the cached desc
+    if (desc.Spoof && !SkipSpoofing())
     {
-        return result;
+        pDesc->VendorId = desc.VendorId;
+        pDesc->DeviceId = desc.DeviceId;
+        std::memcpy(pDesc->Description, desc.Description, sizeof(pDesc->Description));
+
+#ifdef _DEBUG
+        LOG_DEBUG("spoofing");
+#endif
     }
+}
+
+HRESULT DxgiSpoofing::hkGetDesc3(IDXGIAdapter4* This, DXGI_ADAPTER_DESC3* pDesc)
+{
+    auto result = o_GetDesc3(This, pDesc);
 
-#if _DEBUG
-    LOG_TRACE("result: {:X}, caller: {}", (UINT) result, caller);
+#ifdef _DEBUG
+    LOG_TRACE("result: {:X}, caller: {}", (UINT) result, Util::WhoIsTheCaller(_ReturnAddress()));
 #endif
 
-    if (result == S_OK)
-    {
-        if (Config::Instance()->DxgiVRAM.has_value())
-        {
-            uint64_t newMemSize = (uint64_t) Config::Instance()->DxgiVRAM.value() * 1073741824; // 1024 * 1024 * 1024
-            pDesc->DedicatedVideoMemory = newMemSize;
-        }
+    if (IsPassthroughCaller(_ReturnAddress()))
+        return result;
 
-        auto targetVendorIdMatches = !Config::Instance()->TargetVendorId.has_value() ||
-                                     Config::Instance()->TargetVendorId.value() == pDesc->VendorId;
+    if (result == S_OK)
+        ApplySpoofing(pDesc);
 
-        auto targetDeviceIdMatches = !Config::Instance()->TargetDeviceId.has_value() ||
-                                     Config::Instance()->TargetDeviceId.value() == pDesc->DeviceId;
+    AttachToAdapter(This);
 
-        if (pDesc->VendorId != VendorId::Microsoft && targetVendorIdMatches && targetDeviceIdMatches &&
-            Config::Instance()->DxgiSpoofing.value_or_default() && !SkipSpoofing())
-        {
-            pDesc->VendorId = Config::Instance()->SpoofedVendorId.value_or_default();
-            pDesc->DeviceId = Config::Instance()->SpoofedDeviceId.value_or_default();
+    return result;
+}
 
-            auto szName = Config::Instance()->SpoofedGPUName.value_or_default();
-            std::memset(pDesc->Description, 0, sizeof(pDesc->Description));
-            std::wcscpy(pDesc->Description, szName.c_str());
+HRESULT DxgiSpoofing::hkGetDesc2(IDXGIAdapter2* This, DXGI_ADAPTER_DESC2* pDesc)
+{
+    auto result = o_GetDesc2(This, pDesc);
 
 #ifdef _DEBUG
-            LOG_DEBUG("spoofing");
+    LOG_TRACE("result: {:X}, caller: {}", (UINT) result, Util::WhoIsTheCaller(_ReturnAddress()));
 #endif
-        }
-    }
+
+    if (IsPassthroughCaller(_ReturnAddress()))
+        return result;
+
+    if (result == S_OK)
+        ApplySpoofing(pDesc);
 
     AttachToAdapter(This);
 
     return result;
 }
 
-HRESULT DxgiSpoofing::hkGetDesc(IDXGIAdapter* This, DXGI_ADAPTER_DESC* pDesc)
+HRESULT DxgiSpoofing::hkGetDesc1(IDXGIAdapter1* This, DXGI_ADAPTER_DESC1* pDesc)
 {
-    auto result = o_GetDesc(This, pDesc);
+    auto result = o_GetDesc1(This, pDesc);
 
-    auto caller = Util::WhoIsTheCaller(_ReturnAddress());
+#ifdef _DEBUG
+    LOG_TRACE("result: {:X}, caller: {}", (UINT) result, Util::WhoIsTheCaller(_ReturnAddress()));
+#endif
 
-    if (iequals(caller, "vulkan-1.dll") || iequals(caller, "amdvlk64.dll") || iequals(caller, "dxgi.dll") ||
-        iequals(caller, "d3d12.dll") || iequals(caller, "d3d12Core.dll"))
-    {
+    if (IsPassthroughCaller(_ReturnAddress()))
         return result;
-    }
-
-#if _DEBUG
-    LOG_TRACE("result: {:X}, caller: {}", (UINT) result, caller);
-#endif
 
     if (result == S_OK)
-    {
-        if (Config::Instance()->DxgiVRAM.has_value())
-        {
-            uint64_t newMemSize = (uint64_t) Config::Instance()->DxgiVRAM.value() * 1073741824; // 1024 * 1024 * 1024
-            pDesc->DedicatedVideoMemory = newMemSize;
-        }
+        ApplySpoofing(pDesc);
 
-        auto targetVendorIdMatches = !Config::Instance()->TargetVendorId.has_value() ||
-                                     Config::Instance()->TargetVendorId.value() == pDesc->VendorId;
-
-        auto targetDeviceIdMatches = !Config::Instance()->TargetDeviceId.has_value() ||
-                                     Config::Instance()->TargetDeviceId.value() == pDesc->DeviceId;
+    AttachToAdapter(This);
 
-        if (pDesc->VendorId != VendorId::Microsoft && targetVendorIdMatches && targetDeviceIdMatches &&
-            Config::Instance()->DxgiSpoofing.value_or_default() && !SkipSpoofing())
-        {
-            pDesc->VendorId = Config::Instance()->SpoofedVendorId.value_or_default();
-            pDesc->DeviceId = Config::Instance()->SpoofedDeviceId.value_or_default();
+    return result;
+}
 
-            auto szName = Config::Instance()->SpoofedGPUName.value_or_default();
-            std::memset(pDesc->Description, 0, sizeof(pDesc->Description));
-            std::wcscpy(pDesc->Description, szName.c_str());
+HRESULT DxgiSpoofing::hkGetDesc(IDXGIAdapter* This, DXGI_ADAPTER_DESC* pDesc)
+{
+    auto result = o_GetDesc(This, pDesc);
 
 #ifdef _DEBUG
-            LOG_DEBUG("spoofing");
+    LOG_TRACE("result: {:X}, caller: {}", (UINT) result, Util::WhoIsTheCaller(_ReturnAddress()));
 #endif
-        }
-    }
+
+    if (IsPassthroughCaller(_ReturnAddress()))
+        return result;
+
+    if (result == S_OK)
+        ApplySpoofing(pDesc);
 
     AttachToAdapter(This);
 
@@ -251,6 +288,10 @@ HRESULT DxgiSpoofing::hkGetDesc(IDXGIAdapter* This, DXGI_ADAPTER_DESC* pDesc)
 
 void DxgiSpoofing::AttachToAdapter(IUnknown* unkAdapter)
 {
+    // Called from every GetDesc, check cheapest condition first
+    if (o_GetDesc != nullptr && o_GetDesc1 != nullptr && o_GetDesc2 != nullptr && o_GetDesc3 != nullptr)
+        return;
+
     static bool logAdded = false;
     if (!Config::Instance()->DxgiSpoofing.value_or_default() && !Config::Instance()->DxgiVRAM.has_value())
     {
@@ -263,8 +304,8 @@ void DxgiSpoofing::AttachToAdapter(IUnknown* unkAdapter)
         return;
     }
 
-    if (o_GetDesc != nullptr && o_GetDesc1 != nullptr && o_GetDesc2 != nullptr && o_GetDesc3 != nullptr)
-        return;
+    static bool unloadTracking = TrackModuleUnloads();
+    _unloadTracking.store(unloadTracking, std::memory_order_relaxed);
 
     PVOID* pVTable = *(PVOID**) unkAdapter;
 
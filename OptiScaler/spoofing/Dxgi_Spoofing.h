@@ -4,12 +4,50 @@
 
 #include <dxgi1_6.h>
 
+#include <map>
+#include <atomic>
+#include <shared_mutex>
+#include <ankerl/unordered_dense.h>
+
 class DxgiSpoofing
 {
   public:
     static void AttachToAdapter(IUnknown* unkAdapter);
 
   private:
+    // Spoofed values of an adapter, built once per adapter LUID and rebuilt after config reload
+    struct SpoofedDesc
+    {
+        uint32_t Generation = 0;
+        bool OverrideVRAM = false;
+        SIZE_T DedicatedVideoMemory = 0;
+        bool Spoof = false;
+        UINT VendorId = 0;
+        UINT DeviceId = 0;
+        WCHAR Description[128] {};
+    };
+
+    // Module a GetDesc call came from, cached by module base until the module unloads
+    struct CallerModule
+    {
+        uintptr_t End = 0;
+        bool Passthrough = false;
+    };
+
+    static const wchar_t* _passthroughModules[5];
+    static inline std::shared_mutex _spoofedDescMutex;
+    static inline ankerl::unordered_dense::map<uint64_t, SpoofedDesc> _spoofedDescs;
+
+    static inline std::shared_mutex _callerModuleMutex;
+    static inline std::map<uintptr_t, CallerModule> _callerModules;
+    static inline std::atomic<bool> _unloadTracking = false;
+
+    static bool IsPassthroughCaller(void* returnAddress);
+    static bool TrackModuleUnloads();
+    static void CALLBACK OnDllNotification(ULONG reason, const void* data, PVOID context);
+    static SpoofedDesc GetSpoofedDesc(LUID luid, UINT vendorId, UINT deviceId);
+    template <typename T> static void ApplySpoofing(T* pDesc);
+
     static HRESULT hkGetDesc(IDXGIAdapter* This, DXGI_ADAPTER_DESC* pDesc);
     static HRESULT hkGetDesc1(IDXGIAdapter1* This, DXGI_ADAPTER_DESC1* pDesc);
     static HRESULT hkGetDesc2(IDXGIAdapter2* This, DXGI_ADAPTER_DESC2* pDesc);
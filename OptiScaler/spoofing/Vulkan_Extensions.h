@@ -0,0 +1,135 @@
+#pragma once
+
+#include "SysUtils.h"
+
+#include <vulkan/vulkan_core.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+// Extension list helpers of Vulkan_Spoofing, kept apart from the hooks so they can be tested on their own
+
+struct DeviceExtensionCache
+{
+    std::vector<VkExtensionProperties> Driver;  // As reported by the driver
+    std::vector<VkExtensionProperties> Spoofed; // What the game sees, rebuilt when FG input changes
+    bool SpoofedWithFG = false;
+};
+
+// Appends ext when list doesn't have it yet, order of existing entries is kept
+inline bool MergeExtension(std::vector<VkExtensionProperties>& list, const VkExtensionProperties& ext)
+{
+    for (const auto& item : list)
+    {
+        if (std::strcmp(item.extensionName, ext.extensionName) == 0)
+            return false;
+    }
+
+    list.push_back(ext);
+    return true;
+}
+
+inline bool MergeExtension(std::vector<const char*>& list, const char* name)
+{
+    for (const auto& item : list)
+    {
+        if (std::strcmp(item, name) == 0)
+            return false;
+    }
+
+    list.push_back(name);
+    return true;
+}
+
+// Standard two call enumeration, retries when list changes between the calls
+inline VkResult EnumerateDeviceExtensions(PFN_vkEnumerateDeviceExtensionProperties enumerate,
+                                          VkPhysicalDevice physicalDevice,
+                                          std::vector<VkExtensionProperties>& extensions)
+{
+    VkResult result = VK_INCOMPLETE;
+
+    while (result == VK_INCOMPLETE)
+    {
+        uint32_t count = 0;
+        result = enumerate(physicalDevice, nullptr, &count, nullptr);
+
+        if (result != VK_SUCCESS)
+            return result;
+
+        extensions.resize(count);
+        result = enumerate(physicalDevice, nullptr, &count, extensions.data());
+        extensions.resize(count);
+    }
+
+    return result;
+}
+
+inline VkResult EnumerateInstanceExtensions(PFN_vkEnumerateInstanceExtensionProperties enumerate,
+                                            std::vector<VkExtensionProperties>& extensions)
+{
+    VkResult result = VK_INCOMPLETE;
+
+    while (result == VK_INCOMPLETE)
+    {
+        uint32_t count = 0;
+        result = enumerate(nullptr, &count, nullptr);
+
+        if (result != VK_SUCCESS)
+            return result;
+
+        extensions.resize(count);
+        result = enumerate(nullptr, &count, extensions.data());
+        extensions.resize(count);
+    }
+
+    return result;
+}
+
+// Second half of the two call enumeration for the game, VK_INCOMPLETE when its buffer is short
+inline VkResult CopyExtensions(const std::vector<VkExtensionProperties>& extensions, uint32_t* pPropertyCount,
+                               VkExtensionProperties* pProperties)
+{
+    if (pProperties == nullptr)
+    {
+        *pPropertyCount = (uint32_t) extensions.size();
+        return VK_SUCCESS;
+    }
+
+    auto count = std::min(*pPropertyCount, (uint32_t) extensions.size());
+    memcpy(pProperties, extensions.data(), count * sizeof(VkExtensionProperties));
+    *pPropertyCount = count;
+
+    return count < extensions.size() ? VK_INCOMPLETE : VK_SUCCESS;
+}
+
+// Needed by Streamline and NVNGX, reported on every GPU when extension spoofing is enabled
+inline void AddSpoofedDeviceExtensions(std::vector<VkExtensionProperties>& extensions, bool withFG)
+{
+    if (withFG)
+    {
+        MergeExtension(extensions, { VK_NV_PRESENT_METERING_EXTENSION_NAME, VK_NV_PRESENT_METERING_SPEC_VERSION });
+        MergeExtension(extensions, { VK_NV_OPTICAL_FLOW_EXTENSION_NAME, VK_NV_OPTICAL_FLOW_SPEC_VERSION });
+    }
+
+    MergeExtension(extensions,
+                   { VK_EXT_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME, VK_EXT_BUFFER_DEVICE_ADDRESS_SPEC_VERSION });
+    MergeExtension(extensions, { VK_NV_LOW_LATENCY_EXTENSION_NAME, VK_NV_LOW_LATENCY_SPEC_VERSION });
+    MergeExtension(extensions, { VK_NVX_MULTIVIEW_PER_VIEW_ATTRIBUTES_EXTENSION_NAME,
+                                 VK_NVX_MULTIVIEW_PER_VIEW_ATTRIBUTES_SPEC_VERSION });
+    MergeExtension(extensions, { VK_NVX_IMAGE_VIEW_HANDLE_EXTENSION_NAME, VK_NVX_IMAGE_VIEW_HANDLE_SPEC_VERSION });
+    MergeExtension(extensions, { VK_NVX_BINARY_IMPORT_EXTENSION_NAME, VK_NVX_BINARY_IMPORT_SPEC_VERSION });
+}
+
+// Rebuilds the spoofed list when it's missing or FG input changed since it was built, true when rebuilt
+inline bool UpdateSpoofedDeviceExtensions(DeviceExtensionCache& cache, bool withFG)
+{
+    if (!cache.Spoofed.empty() && cache.SpoofedWithFG == withFG)
+        return false;
+
+    cache.Spoofed = cache.Driver;
+    cache.SpoofedWithFG = withFG;
+    AddSpoofedDeviceExtensions(cache.Spoofed, withFG);
+
+    return true;
+}
@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "Vulkan_Spoofing.h"
+#include "Vulkan_Extensions.h"
 
 #include <Config.h>
 #include <SysUtils.h>
@@ -9,6 +10,8 @@
 
 #include <magic_enum.hpp>
 
+#include <mutex>
+
 #include <detours/detours.h>
 
 #include <vulkan/vulkan_core.h>
@@ -32,10 +35,105 @@ static PFN_vkGetPhysicalDeviceMemoryProperties2KHR o_vkGetPhysicalDeviceMemoryPr
 static PFN_vkEnumerateDeviceExtensionProperties o_vkEnumerateDeviceExtensionProperties = nullptr;
 static PFN_vkEnumerateInstanceExtensionProperties o_vkEnumerateInstanceExtensionProperties = nullptr;
 
-static uint32_t vkEnumerateInstanceExtensionPropertiesCount = 0;
-static uint32_t vkEnumerateDeviceExtensionPropertiesCount = 0;
-static bool vkEnumerateDeviceExtensionPropertiesListed = false;
-static bool vkEnumerateInstanceExtensionPropertiesListed = false;
+// Engines query extensions in loops while picking a device, serve them from here after the first call
+static std::mutex extensionCacheMutex;
+static std::unordered_map<VkPhysicalDevice, DeviceExtensionCache> deviceExtensionCache;
+static std::vector<VkExtensionProperties> instanceExtensionCache;
+
+static PFN_vkEnumerateDeviceExtensionProperties DeviceExtensionEnumerator()
+{
+    if (o_vkEnumerateDeviceExtensionProperties != nullptr)
+        return o_vkEnumerateDeviceExtensionProperties;
+
+    PFN_vkEnumerateDeviceExtensionProperties enumerate = nullptr;
+
+    if (vulkanModule == nullptr)
+        vulkanModule = KernelBaseProxy::GetModuleHandleA_()("vulkan-1.dll");
+
+    if (vulkanModule != nullptr)
+    {
+        enumerate = (PFN_vkEnumerateDeviceExtensionProperties) KernelBaseProxy::GetProcAddress_()(
+            vulkanModule, "vkEnumerateDeviceExtensionProperties");
+    }
+
+    if (enumerate == nullptr)
+        enumerate = vkEnumerateDeviceExtensionProperties;
+
+    return enumerate;
+}
+
+static PFN_vkEnumerateInstanceExtensionProperties InstanceExtensionEnumerator()
+{
+    if (o_vkEnumerateInstanceExtensionProperties != nullptr)
+        return o_vkEnumerateInstanceExtensionProperties;
+
+    PFN_vkEnumerateInstanceExtensionProperties enumerate = nullptr;
+
+    if (vulkanModule == nullptr)
+        vulkanModule = KernelBaseProxy::GetModuleHandleA_()("vulkan-1.dll");
+
+    if (vulkanModule != nullptr)
+    {
+        enumerate = (PFN_vkEnumerateInstanceExtensionProperties) KernelBaseProxy::GetProcAddress_()(
+            vulkanModule, "vkEnumerateInstanceExtensionProperties");
+    }
+
+    if (enumerate == nullptr)
+        enumerate = vkEnumerateInstanceExtensionProperties;
+
+    return enumerate;
+}
+
+// Call with extensionCacheMutex locked
+static VkResult GetDeviceExtensionCache(VkPhysicalDevice physicalDevice,
+                                        PFN_vkEnumerateDeviceExtensionProperties enumerate,
+                                        DeviceExtensionCache** cache)
+{
+    auto& entry = deviceExtensionCache[physicalDevice];
+    *cache = &entry;
+
+    if (!entry.Driver.empty())
+        return VK_SUCCESS;
+
+    auto result = EnumerateDeviceExtensions(enumerate, physicalDevice, entry.Driver);
+
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("Device extension enumeration failed: {:X}", (UINT) result);
+        entry.Driver.clear();
+        return result;
+    }
+
+    LOG_DEBUG("Device {:X} extensions ({}):", (size_t) physicalDevice, entry.Driver.size());
+    for (const auto& ext : entry.Driver)
+        LOG_DEBUG("  {}", ext.extensionName);
+
+    entry.Spoofed.clear();
+
+    return VK_SUCCESS;
+}
+
+// Call with extensionCacheMutex locked
+static VkResult GetInstanceExtensionCache(PFN_vkEnumerateInstanceExtensionProperties enumerate)
+{
+    if (!instanceExtensionCache.empty())
+        return VK_SUCCESS;
+
+    auto result = EnumerateInstanceExtensions(enumerate, instanceExtensionCache);
+
+    if (result != VK_SUCCESS)
+    {
+        LOG_ERROR("Instance extension enumeration failed: {:X}", (UINT) result);
+        instanceExtensionCache.clear();
+        return result;
+    }
+
+    LOG_DEBUG("Instance extensions ({}):", instanceExtensionCache.size());
+    for (const auto& ext : instanceExtensionCache)
+        LOG_DEBUG("  {}", ext.extensionName);
+
+    return VK_SUCCESS;
+}
 
 inline static void hkvkGetPhysicalDeviceMemoryProperties(VkPhysicalDevice physicalDevice,
                                                          VkPhysicalDeviceMemoryProperties* pMemoryProperties)
@@ -237,38 +335,12 @@ VkResult VulkanSpoofing::hkvkCreateInstance(VkInstanceCreateInfo* pCreateInfo, c
 
     if (vkInstanceExtensions.size() == 0)
     {
-        auto enumarate = o_vkEnumerateInstanceExtensionProperties;
-        if (o_vkEnumerateInstanceExtensionProperties == nullptr)
-        {
-            if (vulkanModule == nullptr)
-                vulkanModule = KernelBaseProxy::GetModuleHandleA_()("vulkan-1.dll");
-
-            if (vulkanModule != nullptr)
-            {
-                enumarate = (PFN_vkEnumerateInstanceExtensionProperties) KernelBaseProxy::GetProcAddress_()(
-                    vulkanModule, "vkEnumerateInstanceExtensionProperties");
-            }
-
-            if (enumarate == nullptr)
-            {
-                enumarate = vkEnumerateInstanceExtensionProperties;
-            }
-        }
+        std::scoped_lock lock(extensionCacheMutex);
 
-        if (enumarate != nullptr)
+        if (GetInstanceExtensionCache(InstanceExtensionEnumerator()) == VK_SUCCESS)
         {
-            LOG_INFO("vkInstanceExtensions is empty, enumerating instance extensions");
-            vkEnumerateInstanceExtensionPropertiesListed = true;
-            vkEnumerateInstanceExtensionPropertiesCount = 0;
-
-            enumarate(VK_NULL_HANDLE, &vkEnumerateInstanceExtensionPropertiesCount, VK_NULL_HANDLE);
-            std::vector<VkExtensionProperties> extensions(vkEnumerateInstanceExtensionPropertiesCount);
-            enumarate(VK_NULL_HANDLE, &vkEnumerateInstanceExtensionPropertiesCount, extensions.data());
-            for (const auto& ext : extensions)
-            {
+            for (const auto& ext : instanceExtensionCache)
                 vkInstanceExtensions[ext.extensionName] = true;
-                LOG_DEBUG("  {}", ext.extensionName);
-            }
         }
     }
 
@@ -284,7 +356,7 @@ VkResult VulkanSpoofing::hkvkCreateInstance(VkInstanceCreateInfo* pCreateInfo, c
     for (size_t i = 0; i < pCreateInfo->enabledExtensionCount; i++)
     {
         LOG_DEBUG("  {}", pCreateInfo->ppEnabledExtensionNames[i]);
-        newExtensionList.push_back(pCreateInfo->ppEnabledExtensionNames[i]);
+        MergeExtension(newExtensionList, pCreateInfo->ppEnabledExtensionNames[i]);
     }
 
     auto primaryGpu = IdentifyGpu::getPrimaryGpu();
@@ -295,19 +367,19 @@ VkResult VulkanSpoofing::hkvkCreateInstance(VkInstanceCreateInfo* pCreateInfo, c
         if (vkInstanceExtensions.contains(std::string(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME)))
         {
             LOG_DEBUG("  Adding {}", VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
-            newExtensionList.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+            MergeExtension(newExtensionList, VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
         }
 
         if (vkInstanceExtensions.contains(std::string(VK_KHR_EXTERNAL_MEMORY_CAPABILITIES_EXTENSION_NAME)))
         {
             LOG_DEBUG("  Adding {}", VK_KHR_EXTERNAL_MEMORY_CAPABILITIES_EXTENSION_NAME);
-            newExtensionList.push_back(VK_KHR_EXTERNAL_MEMORY_CAPABILITIES_EXTENSION_NAME);
+            MergeExtension(newExtensionList, VK_KHR_EXTERNAL_MEMORY_CAPABILITIES_EXTENSION_NAME);
         }
 
         if (vkInstanceExtensions.contains(std::string(VK_KHR_EXTERNAL_SEMAPHORE_CAPABILITIES_EXTENSION_NAME)))
         {
             LOG_DEBUG("  Adding {}", VK_KHR_EXTERNAL_SEMAPHORE_CAPABILITIES_EXTENSION_NAME);
-            newExtensionList.push_back(VK_KHR_EXTERNAL_SEMAPHORE_CAPABILITIES_EXTENSION_NAME);
+            MergeExtension(newExtensionList, VK_KHR_EXTERNAL_SEMAPHORE_CAPABILITIES_EXTENSION_NAME);
         }
     }
 
@@ -315,20 +387,20 @@ VkResult VulkanSpoofing::hkvkCreateInstance(VkInstanceCreateInfo* pCreateInfo, c
     if (vkInstanceExtensions.contains(std::string(VK_EXT_DEBUG_UTILS_EXTENSION_NAME)))
     {
         LOG_DEBUG("  Adding {}", VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
-        newExtensionList.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+        MergeExtension(newExtensionList, VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
     }
 
     LOG_INFO("Adding Vulkan w/Dx12 extensions");
     if (vkInstanceExtensions.contains(std::string(VK_KHR_EXTERNAL_MEMORY_CAPABILITIES_EXTENSION_NAME)))
     {
         LOG_DEBUG("  Adding {}", VK_KHR_EXTERNAL_MEMORY_CAPABILITIES_EXTENSION_NAME);
-        newExtensionList.push_back(VK_KHR_EXTERNAL_MEMORY_CAPABILITIES_EXTENSION_NAME);
+        MergeExtension(newExtensionList, VK_KHR_EXTERNAL_MEMORY_CAPABILITIES_EXTENSION_NAME);
     }
 
     if (vkInstanceExtensions.contains(std::string(VK_KHR_EXTERNAL_SEMAPHORE_CAPABILITIES_EXTENSION_NAME)))
     {
         LOG_DEBUG("  Adding {}", VK_KHR_EXTERNAL_SEMAPHORE_CAPABILITIES_EXTENSION_NAME);
-        newExtensionList.push_back(VK_KHR_EXTERNAL_SEMAPHORE_CAPABILITIES_EXTENSION_NAME);
+        MergeExtension(newExtensionList, VK_KHR_EXTERNAL_SEMAPHORE_CAPABILITIES_EXTENSION_NAME);
     }
 
     LOG_DEBUG("Layer count: {}", pCreateInfo->enabledLayerCount);
@@ -352,7 +424,7 @@ VkResult VulkanSpoofing::hkvkCreateInstance(VkInstanceCreateInfo* pCreateInfo, c
     newLayerList.push_back("VK_LAYER_KHRONOS_validation");
 
     for (size_t i = 0; i < pCreateInfo->enabledLayerCount; i++)
-        newLayerList.push_back(pCreateInfo->ppEnabledLayerNames[i]);
+        MergeExtension(newLayerList, pCreateInfo->ppEnabledLayerNames[i]);
 
     pCreateInfo->enabledLayerCount = static_cast<uint32_t>(newLayerList.size());
     pCreateInfo->ppEnabledLayerNames = newLayerList.data();
@@ -366,7 +438,7 @@ VkResult VulkanSpoofing::hkvkCreateInstance(VkInstanceCreateInfo* pCreateInfo, c
 
     next->pNext = &debugCreateInfo;
 
-    newExtensionList.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+    MergeExtension(newExtensionList, VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
 #endif
 
     pCreateInfo->enabledExtensionCount = static_cast<uint32_t>(newExtensionList.size());
@@ -386,41 +458,17 @@ VkResult VulkanSpoofing::hkvkCreateDevice(VkPhysicalDevice physicalDevice, VkDev
 
     LOG_FUNC();
 
-    if (vkDeviceExtensions.size() == 0)
+    // Checks below are done against the device being created
     {
-        LOG_INFO("vkDeviceExtensions is empty, enumerating device extensions");
-        auto enumarate = o_vkEnumerateDeviceExtensionProperties;
-        if (o_vkEnumerateDeviceExtensionProperties == nullptr)
-        {
-            if (vulkanModule == nullptr)
-                vulkanModule = KernelBaseProxy::GetModuleHandleA_()("vulkan-1.dll");
-
-            if (vulkanModule != nullptr)
-            {
-                enumarate = (PFN_vkEnumerateDeviceExtensionProperties) KernelBaseProxy::GetProcAddress_()(
-                    vulkanModule, "vkEnumerateDeviceExtensionProperties");
-            }
+        std::scoped_lock lock(extensionCacheMutex);
 
-            if (enumarate == nullptr)
-            {
-                enumarate = vkEnumerateDeviceExtensionProperties;
-            }
-        }
+        DeviceExtensionCache* cache = nullptr;
+        vkDeviceExtensions.clear();
 
-        if (enumarate != nullptr)
+        if (GetDeviceExtensionCache(physicalDevice, DeviceExtensionEnumerator(), &cache) == VK_SUCCESS)
         {
-            vkEnumerateDeviceExtensionPropertiesListed = true;
-            vkEnumerateDeviceExtensionPropertiesCount = 0;
-
-            enumarate(physicalDevice, nullptr, &vkEnumerateDeviceExtensionPropertiesCount, nullptr);
-            std::vector<VkExtensionProperties> extensions(vkEnumerateDeviceExtensionPropertiesCount);
-            enumarate(physicalDevice, nullptr, &vkEnumerateDeviceExtensionPropertiesCount, extensions.data());
-
-            for (const auto& ext : extensions)
-            {
+            for (const auto& ext : cache->Driver)
                 vkDeviceExtensions[ext.extensionName] = true;
-                LOG_DEBUG("  {}", ext.extensionName);
-            }
         }
     }
 
@@ -453,7 +501,7 @@ VkResult VulkanSpoofing::hkvkCreateDevice(VkPhysicalDevice physicalDevice, VkDev
         }
 
         // LOG_DEBUG("Adding {}", extName);
-        newExtensionList.push_back(extName);
+        MergeExtension(newExtensionList, extName);
     }
 
     if (primaryGpu.vendorId == VendorId::Nvidia)
@@ -462,25 +510,25 @@ VkResult VulkanSpoofing::hkvkCreateDevice(VkPhysicalDevice physicalDevice, VkDev
         if (vkDeviceExtensions.contains(std::string(VK_NVX_MULTIVIEW_PER_VIEW_ATTRIBUTES_EXTENSION_NAME)))
         {
             LOG_DEBUG("  Adding {}", VK_NVX_MULTIVIEW_PER_VIEW_ATTRIBUTES_EXTENSION_NAME);
-            newExtensionList.push_back(VK_NVX_MULTIVIEW_PER_VIEW_ATTRIBUTES_EXTENSION_NAME);
+            MergeExtension(newExtensionList, VK_NVX_MULTIVIEW_PER_VIEW_ATTRIBUTES_EXTENSION_NAME);
         }
 
         if (vkDeviceExtensions.contains(std::string(VK_NV_LOW_LATENCY_EXTENSION_NAME)))
         {
             LOG_DEBUG("  Adding {}", VK_NV_LOW_LATENCY_EXTENSION_NAME);
-            newExtensionList.push_back(VK_NV_LOW_LATENCY_EXTENSION_NAME);
+            MergeExtension(newExtensionList, VK_NV_LOW_LATENCY_EXTENSION_NAME);
         }
 
         if (vkDeviceExtensions.contains(std::string(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME)))
         {
             LOG_DEBUG("  Adding {}", VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
-            newExtensionList.push_back(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
+            MergeExtension(newExtensionList, VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
         }
 
         if (vkDeviceExtensions.contains(std::string(VK_EXT_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME)))
         {
             LOG_DEBUG("  Adding {}", VK_EXT_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME);
-            newExtensionList.push_back(VK_EXT_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME);
+            MergeExtension(newExtensionList, VK_EXT_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME);
         }
 
         if (!primaryGpu.dlssCapable)
@@ -488,13 +536,13 @@ VkResult VulkanSpoofing::hkvkCreateDevice(VkPhysicalDevice physicalDevice, VkDev
             if (vkDeviceExtensions.contains(std::string(VK_NVX_BINARY_IMPORT_EXTENSION_NAME)))
             {
                 LOG_DEBUG("  Adding {}", VK_NVX_BINARY_IMPORT_EXTENSION_NAME);
-                newExtensionList.push_back(VK_NVX_BINARY_IMPORT_EXTENSION_NAME);
+                MergeExtension(newExtensionList, VK_NVX_BINARY_IMPORT_EXTENSION_NAME);
             }
 
             if (vkDeviceExtensions.contains(std::string(VK_NVX_IMAGE_VIEW_HANDLE_EXTENSION_NAME)))
             {
                 LOG_DEBUG("  Adding {}", VK_NVX_IMAGE_VIEW_HANDLE_EXTENSION_NAME);
-                newExtensionList.push_back(VK_NVX_IMAGE_VIEW_HANDLE_EXTENSION_NAME);
+                MergeExtension(newExtensionList, VK_NVX_IMAGE_VIEW_HANDLE_EXTENSION_NAME);
             }
         }
     }
@@ -503,50 +551,50 @@ VkResult VulkanSpoofing::hkvkCreateDevice(VkPhysicalDevice physicalDevice, VkDev
     if (vkDeviceExtensions.contains(std::string(VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME)))
     {
         LOG_DEBUG("  Adding {}", VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME);
-        newExtensionList.push_back(VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME);
+        MergeExtension(newExtensionList, VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME);
     }
 
     if (vkDeviceExtensions.contains(std::string(VK_KHR_EXTERNAL_MEMORY_EXTENSION_NAME)))
     {
         LOG_DEBUG("  Adding {}", VK_KHR_EXTERNAL_MEMORY_EXTENSION_NAME);
-        newExtensionList.push_back(VK_KHR_EXTERNAL_MEMORY_EXTENSION_NAME);
+        MergeExtension(newExtensionList, VK_KHR_EXTERNAL_MEMORY_EXTENSION_NAME);
     }
 
     if (vkDeviceExtensions.contains(std::string(VK_KHR_EXTERNAL_SEMAPHORE_EXTENSION_NAME)))
     {
         LOG_DEBUG("  Adding {}", VK_KHR_EXTERNAL_SEMAPHORE_EXTENSION_NAME);
-        newExtensionList.push_back(VK_KHR_EXTERNAL_SEMAPHORE_EXTENSION_NAME);
+        MergeExtension(newExtensionList, VK_KHR_EXTERNAL_SEMAPHORE_EXTENSION_NAME);
     }
 
     if (vkDeviceExtensions.contains(std::string(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME)))
     {
         LOG_DEBUG("  Adding {}", VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
-        newExtensionList.push_back(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+        MergeExtension(newExtensionList, VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
     }
 
     if (vkDeviceExtensions.contains(std::string(VK_KHR_DEDICATED_ALLOCATION_EXTENSION_NAME)))
     {
         LOG_DEBUG("  Adding {}", VK_KHR_DEDICATED_ALLOCATION_EXTENSION_NAME);
-        newExtensionList.push_back(VK_KHR_DEDICATED_ALLOCATION_EXTENSION_NAME);
+        MergeExtension(newExtensionList, VK_KHR_DEDICATED_ALLOCATION_EXTENSION_NAME);
     }
 
     LOG_INFO("Adding XeSS Vulkan extensions");
     if (vkDeviceExtensions.contains(std::string(VK_KHR_SHADER_FLOAT16_INT8_EXTENSION_NAME)))
     {
         LOG_DEBUG("  Adding {}", VK_KHR_SHADER_FLOAT16_INT8_EXTENSION_NAME);
-        newExtensionList.push_back(VK_KHR_SHADER_FLOAT16_INT8_EXTENSION_NAME);
+        MergeExtension(newExtensionList, VK_KHR_SHADER_FLOAT16_INT8_EXTENSION_NAME);
     }
 
     if (vkDeviceExtensions.contains(std::string(VK_KHR_SHADER_INTEGER_DOT_PRODUCT_EXTENSION_NAME)))
     {
         LOG_DEBUG("  Adding {}", VK_KHR_SHADER_INTEGER_DOT_PRODUCT_EXTENSION_NAME);
-        newExtensionList.push_back(VK_KHR_SHADER_INTEGER_DOT_PRODUCT_EXTENSION_NAME);
+        MergeExtension(newExtensionList, VK_KHR_SHADER_INTEGER_DOT_PRODUCT_EXTENSION_NAME);
     }
 
     if (vkDeviceExtensions.contains(std::string(VK_EXT_MUTABLE_DESCRIPTOR_TYPE_EXTENSION_NAME)))
     {
         LOG_DEBUG("  Adding {}", VK_EXT_MUTABLE_DESCRIPTOR_TYPE_EXTENSION_NAME);
-        newExtensionList.push_back(VK_EXT_MUTABLE_DESCRIPTOR_TYPE_EXTENSION_NAME);
+        MergeExtension(newExtensionList, VK_EXT_MUTABLE_DESCRIPTOR_TYPE_EXTENSION_NAME);
     }
 
     LOG_INFO("Adding Vk w/Dx12 Vulkan extensions");
@@ -554,13 +602,13 @@ VkResult VulkanSpoofing::hkvkCreateDevice(VkPhysicalDevice physicalDevice, VkDev
     if (vkDeviceExtensions.contains(std::string(VK_KHR_EXTERNAL_MEMORY_WIN32_EXTENSION_NAME)))
     {
         LOG_DEBUG("  Adding {}", VK_KHR_EXTERNAL_MEMORY_WIN32_EXTENSION_NAME);
-        newExtensionList.push_back(VK_KHR_EXTERNAL_MEMORY_WIN32_EXTENSION_NAME);
+        MergeExtension(newExtensionList, VK_KHR_EXTERNAL_MEMORY_WIN32_EXTENSION_NAME);
     }
 
     if (vkDeviceExtensions.contains(std::string(VK_KHR_EXTERNAL_SEMAPHORE_WIN32_EXTENSION_NAME)))
     {
         LOG_DEBUG("  Adding {}", VK_KHR_EXTERNAL_SEMAPHORE_WIN32_EXTENSION_NAME);
-        newExtensionList.push_back(VK_KHR_EXTERNAL_SEMAPHORE_WIN32_EXTENSION_NAME);
+        MergeExtension(newExtensionList, VK_KHR_EXTERNAL_SEMAPHORE_WIN32_EXTENSION_NAME);
     }
 
 #ifdef USE_QUEUE_SUBMIT_2_KHR
@@ -568,7 +616,7 @@ VkResult VulkanSpoofing::hkvkCreateDevice(VkPhysicalDevice physicalDevice, VkDev
     if (vkDeviceExtensions.contains(std::string(VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME)))
     {
         LOG_DEBUG("  Adding {}", VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME);
-        newExtensionList.push_back(VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME);
+        MergeExtension(newExtensionList, VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME);
     }
 #endif
 
@@ -592,97 +640,25 @@ inline static VkResult hkvkEnumerateDeviceExtensionProperties(VkPhysicalDevice p
 {
     LOG_FUNC();
 
-    uint32_t count = 0;
+    // Layer queries and our own queries go to the driver as is
+    if (pLayerName != nullptr || pPropertyCount == nullptr || State::Instance().skipSpoofing)
+        return o_vkEnumerateDeviceExtensionProperties(physicalDevice, pLayerName, pPropertyCount, pProperties);
 
-    if (pPropertyCount != nullptr)
-        count = *pPropertyCount;
+    auto withFG =
+        State::Instance().activeFgInput == FGInput::DLSSG || State::Instance().activeFgInput == FGInput::NvngxFG;
 
-    if (pProperties == nullptr)
-        count = 0;
+    std::scoped_lock lock(extensionCacheMutex);
 
-    auto result = o_vkEnumerateDeviceExtensionProperties(physicalDevice, pLayerName, pPropertyCount, pProperties);
+    DeviceExtensionCache* cache = nullptr;
+    auto result = GetDeviceExtensionCache(physicalDevice, o_vkEnumerateDeviceExtensionProperties, &cache);
 
     if (result != VK_SUCCESS)
-    {
-        LOG_ERROR("o_vkEnumerateDeviceExtensionProperties({}) result: {:X}", count, (UINT) result);
         return result;
-    }
-
-    if (!State::Instance().skipSpoofing)
-    {
-        // Count query, modify and add 5 to final count
-        if (pProperties == nullptr && pPropertyCount != nullptr && count == 0)
-        {
-            if (State::Instance().activeFgInput == FGInput::DLSSG ||
-                State::Instance().activeFgInput == FGInput::NvngxFG)
-                *pPropertyCount += 7;
-            else
-                *pPropertyCount += 5;
-
-            vkEnumerateDeviceExtensionPropertiesCount = *pPropertyCount;
-            LOG_TRACE("vkEnumerateDeviceExtensionProperties count: {}", *pPropertyCount);
-            return result;
-        }
-
-        // If this is request of our modified count query (count == vkEnumerateDeviceExtensionPropertiesCount)
-        if (pProperties != nullptr && pPropertyCount != nullptr && *pPropertyCount > 0 &&
-            count == vkEnumerateDeviceExtensionPropertiesCount)
-        {
-            // Set back modified extension count
-            *pPropertyCount = count;
-
-            // And fill extension info at the end
-            VkExtensionProperties bi { VK_NVX_BINARY_IMPORT_EXTENSION_NAME, VK_NVX_BINARY_IMPORT_SPEC_VERSION };
-            memcpy(&pProperties[*pPropertyCount - 1], &bi, sizeof(VkExtensionProperties));
-
-            VkExtensionProperties ivh { VK_NVX_IMAGE_VIEW_HANDLE_EXTENSION_NAME,
-                                        VK_NVX_IMAGE_VIEW_HANDLE_SPEC_VERSION };
-            memcpy(&pProperties[*pPropertyCount - 2], &ivh, sizeof(VkExtensionProperties));
-
-            VkExtensionProperties mpva { VK_NVX_MULTIVIEW_PER_VIEW_ATTRIBUTES_EXTENSION_NAME,
-                                         VK_NVX_MULTIVIEW_PER_VIEW_ATTRIBUTES_SPEC_VERSION };
-            memcpy(&pProperties[*pPropertyCount - 3], &mpva, sizeof(VkExtensionProperties));
-
-            VkExtensionProperties ll { VK_NV_LOW_LATENCY_EXTENSION_NAME, VK_NV_LOW_LATENCY_SPEC_VERSION };
-            memcpy(&pProperties[*pPropertyCount - 4], &ll, sizeof(VkExtensionProperties));
-
-            VkExtensionProperties bda { VK_EXT_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME,
-                                        VK_EXT_BUFFER_DEVICE_ADDRESS_SPEC_VERSION };
-            memcpy(&pProperties[*pPropertyCount - 5], &bda, sizeof(VkExtensionProperties));
 
-            if (State::Instance().activeFgInput == FGInput::DLSSG ||
-                State::Instance().activeFgInput == FGInput::NvngxFG)
-            {
-                VkExtensionProperties of { VK_NV_OPTICAL_FLOW_EXTENSION_NAME, VK_NV_OPTICAL_FLOW_SPEC_VERSION };
-                memcpy(&pProperties[*pPropertyCount - 6], &of, sizeof(VkExtensionProperties));
-
-                VkExtensionProperties pm { VK_NV_PRESENT_METERING_EXTENSION_NAME, VK_NV_PRESENT_METERING_SPEC_VERSION };
-                memcpy(&pProperties[*pPropertyCount - 7], &pm, sizeof(VkExtensionProperties));
-            }
-        }
-        else
-        {
-            LOG_DEBUG("Not adding any extensions!");
-        }
-    }
+    if (UpdateSpoofedDeviceExtensions(*cache, withFG))
+        LOG_DEBUG("Spoofed device extensions: {} -> {}", cache->Driver.size(), cache->Spoofed.size());
 
-    if (!vkEnumerateDeviceExtensionPropertiesListed && count != 0)
-    {
-        vkEnumerateDeviceExtensionPropertiesListed = true;
-
-        auto minusCount = 5;
-        if (State::Instance().activeFgInput == FGInput::DLSSG || State::Instance().activeFgInput == FGInput::NvngxFG)
-            minusCount = 7;
-
-        LOG_DEBUG("Extensions returned:");
-        for (uint32_t i = 0; i < *pPropertyCount; i++)
-        {
-            LOG_DEBUG("  {}", pProperties[i].extensionName);
-
-            if (!State::Instance().skipSpoofing && i < (*pPropertyCount - minusCount))
-                vkDeviceExtensions.insert_or_assign(std::string(pProperties[i].extensionName), true);
-        }
-    }
+    result = CopyExtensions(cache->Spoofed, pPropertyCount, pProperties);
 
     LOG_FUNC_RESULT(result);
 
@@ -694,42 +670,17 @@ inline static VkResult hkvkEnumerateInstanceExtensionProperties(const char* pLay
 {
     LOG_FUNC();
 
-    auto count = *pPropertyCount;
+    if (pLayerName != nullptr || pPropertyCount == nullptr || State::Instance().skipSpoofing)
+        return o_vkEnumerateInstanceExtensionProperties(pLayerName, pPropertyCount, pProperties);
 
-    if (pProperties == nullptr)
-        count = 0;
+    std::scoped_lock lock(extensionCacheMutex);
 
-    auto result = o_vkEnumerateInstanceExtensionProperties(pLayerName, pPropertyCount, pProperties);
+    auto result = GetInstanceExtensionCache(o_vkEnumerateInstanceExtensionProperties);
 
     if (result != VK_SUCCESS)
-    {
-        LOG_ERROR("o_vkEnumerateInstanceExtensionProperties({}) result: {:X}", count, (UINT) result);
         return result;
-    }
-
-    if (!State::Instance().skipSpoofing)
-    {
-        if (pLayerName == nullptr && pProperties == nullptr && count == 0)
-        {
-            LOG_TRACE("hkvkEnumerateDeviceExtensionProperties count: {}", vkEnumerateDeviceExtensionPropertiesCount);
-            return result;
-        }
-    }
 
-    if (pPropertyCount != nullptr && pProperties != nullptr && count != 0)
-    {
-        if (!vkEnumerateInstanceExtensionPropertiesListed)
-        {
-            vkEnumerateInstanceExtensionPropertiesListed = true;
-
-            LOG_DEBUG("Extensions returned:");
-            for (size_t i = 0; i < *pPropertyCount; i++)
-            {
-                LOG_DEBUG("  {}", pProperties[i].extensionName);
-                vkInstanceExtensions.insert_or_assign(std::string(pProperties[i].extensionName), true);
-            }
-        }
-    }
+    result = CopyExtensions(instanceExtensionCache, pPropertyCount, pProperties);
 
     LOG_FUNC_RESULT(result);
 
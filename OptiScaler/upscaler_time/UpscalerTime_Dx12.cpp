@@ -12,7 +12,7 @@ void UpscalerTimeDx12::Init(ID3D12Device* device)
 
     // Create query heap for timestamp queries
     D3D12_QUERY_HEAP_DESC queryHeapDesc = {};
-    queryHeapDesc.Count = 2; // Start and End timestamps
+    queryHeapDesc.Count = 4; // Start and End timestamps for upscaling and post upscale passes
     queryHeapDesc.NodeMask = 0;
     queryHeapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
 
@@ -25,7 +25,7 @@ void UpscalerTimeDx12::Init(ID3D12Device* device)
     }
 
     // Create a readback buffer to retrieve timestamp data
-    D3D12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(2 * sizeof(UINT64));
+    D3D12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(4 * sizeof(UINT64));
     D3D12_HEAP_PROPERTIES heapProps = {};
     heapProps.Type = D3D12_HEAP_TYPE_READBACK;
 
@@ -39,13 +39,19 @@ void UpscalerTimeDx12::Init(ID3D12Device* device)
 void UpscalerTimeDx12::UpscaleStart(ID3D12GraphicsCommandList* cmdList)
 {
     if (_queryHeap != nullptr)
+    {
         cmdList->EndQuery(_queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, 0);
+        _upscaleStarted = true;
+    }
 }
 
 void UpscalerTimeDx12::UpscaleEnd(ID3D12GraphicsCommandList* cmdList)
 {
-    if (_queryHeap != nullptr)
+    // Only inputs which recorded the start query are timed
+    if (_queryHeap != nullptr && _upscaleStarted)
     {
+        _upscaleStarted = false;
+
         cmdList->EndQuery(_queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, 1);
 
         // Resolve the queries to the readback buffer
@@ -55,6 +61,61 @@ void UpscalerTimeDx12::UpscaleEnd(ID3D12GraphicsCommandList* cmdList)
     }
 }
 
+void UpscalerTimeDx12::PostUpscaleStart(ID3D12GraphicsCommandList* cmdList)
+{
+    if (_queryHeap != nullptr)
+        cmdList->EndQuery(_queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, 2);
+}
+
+void UpscalerTimeDx12::PostUpscaleEnd(ID3D12GraphicsCommandList* cmdList, uint32_t key, std::string name,
+                                      bool completed)
+{
+    if (_queryHeap != nullptr)
+    {
+        cmdList->EndQuery(_queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, 3);
+
+        if (!completed)
+            return;
+
+        cmdList->ResolveQueryData(_queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, 2, 2, _readbackBuffer, 2 * sizeof(UINT64));
+
+        _postUpscaleKey = key;
+        _postUpscaleName = name;
+        _dx12PostUpscaleTrig = true;
+    }
+}
+
+void UpscalerTimeDx12::ReadPostUpscaleTime(UINT64* timestampData, UINT64 gpuFrequency)
+{
+    _dx12PostUpscaleTrig = false;
+
+    UINT64 startTime = timestampData[2];
+    UINT64 endTime = timestampData[3];
+
+    if (endTime <= startTime)
+        return;
+
+    double elapsedTimeMs = (endTime - startTime) / static_cast<double>(gpuFrequency) * 1000.0;
+
+    if (elapsedTimeMs >= 100.0)
+        return;
+
+    auto& stats = _postUpscaleStats[_postUpscaleKey];
+    stats.Name = _postUpscaleName;
+    stats.Count++;
+    stats.TotalMs += elapsedTimeMs;
+
+    // Report averages periodically so fused and separate passes can be compared from the log
+    if (stats.Count >= 300)
+    {
+        LOG_INFO("Post upscale passes [{}]: {:.4f} ms avg over {} frames", stats.Name, stats.TotalMs / stats.Count,
+                 stats.Count);
+
+        stats.Count = 0;
+        stats.TotalMs = 0.0;
+    }
+}
+
 void UpscalerTimeDx12::ReadUpscalingTime(ID3D12CommandQueue* commandQueue)
 {
     if (_queryHeap == nullptr || !_dx12UpscaleTrig || _readbackBuffer == nullptr)
@@ -84,6 +145,9 @@ void UpscalerTimeDx12::ReadUpscalingTime(ID3D12CommandQueue* commandQueue)
             State::Instance().upscaleTimes.pop_front();
             State::Instance().frameTimeMutex.unlock();
         }
+
+        if (_dx12PostUpscaleTrig)
+            ReadPostUpscaleTime(timestampData, gpuFrequency);
     }
     else
     {
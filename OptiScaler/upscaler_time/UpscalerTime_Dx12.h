@@ -4,16 +4,38 @@
 
 #include <d3d12.h>
 
+#include <ankerl/unordered_dense.h>
+
 class UpscalerTimeDx12
 {
   public:
     static void Init(ID3D12Device* device);
     static void UpscaleStart(ID3D12GraphicsCommandList* cmdList);
+    // Called by IFeature_Dx12 right after the upscaler, before the post upscale passes
     static void UpscaleEnd(ID3D12GraphicsCommandList* cmdList);
     static void ReadUpscalingTime(ID3D12CommandQueue* commandQueue);
 
+    // Post upscale passes (output scaling, sharpening), timed per pass permutation
+    static void PostUpscaleStart(ID3D12GraphicsCommandList* cmdList);
+    // Not completed passes are not added to the stats
+    static void PostUpscaleEnd(ID3D12GraphicsCommandList* cmdList, uint32_t key, std::string name, bool completed);
+
   private:
+    struct PostPassStats
+    {
+        std::string Name;
+        uint32_t Count = 0;
+        double TotalMs = 0.0;
+    };
+
+    static void ReadPostUpscaleTime(UINT64* timestampData, UINT64 gpuFrequency);
+
     static inline ID3D12QueryHeap* _queryHeap = nullptr;
     static inline ID3D12Resource* _readbackBuffer = nullptr;
+    static inline bool _upscaleStarted = false;
     static inline bool _dx12UpscaleTrig = false;
+    static inline bool _dx12PostUpscaleTrig = false;
+    static inline uint32_t _postUpscaleKey = 0;
+    static inline std::string _postUpscaleName;
+    static inline ankerl::unordered_dense::map<uint32_t, PostPassStats> _postUpscaleStats;
 };
@@ -13,14 +13,12 @@
 #include "upscalers/ffx/FFXFeature_Dx12.h"
 #include "upscalers/xess/XeSSFeature_Dx12.h"
 #include "FeatureProvider_Dx11.h"
+#include "Prewarm_Dx12.h"
 #include <misc/IdentifyGpu.h>
 
-bool FeatureProvider_Dx12::GetFeature(Upscaler upscaler, UINT handleId, NVSDK_NGX_Parameter* parameters,
-                                      std::unique_ptr<IFeature_Dx12>* feature)
+bool FeatureProvider_Dx12::CreateFeature(Upscaler upscaler, UINT handleId, NVSDK_NGX_Parameter* parameters,
+                                         std::unique_ptr<IFeature_Dx12>* feature)
 {
-    State& state = State::Instance();
-    Config& cfg = *Config::Instance();
-    auto primaryGpu = IdentifyGpu::getPrimaryGpu();
     ScopedSkipHeapCapture skipHeapCapture {};
 
     switch (upscaler)
@@ -41,6 +39,33 @@ bool FeatureProvider_Dx12::GetFeature(Upscaler upscaler, UINT handleId, NVSDK_NG
         *feature = std::make_unique<FFXFeatureDx12>(handleId, parameters);
         break;
 
+    default:
+        return false;
+    }
+
+    return (*feature)->ModuleLoaded();
+}
+
+bool FeatureProvider_Dx12::GetFeature(Upscaler upscaler, UINT handleId, NVSDK_NGX_Parameter* parameters,
+                                      std::unique_ptr<IFeature_Dx12>* feature)
+{
+    // Covers every input and backend changes, don't create two upscaler contexts at the same time
+    Prewarm_Dx12::Wait();
+
+    State& state = State::Instance();
+    Config& cfg = *Config::Instance();
+    auto primaryGpu = IdentifyGpu::getPrimaryGpu();
+    ScopedSkipHeapCapture skipHeapCapture {};
+
+    switch (upscaler)
+    {
+    case Upscaler::XeSS:
+    case Upscaler::FSR21:
+    case Upscaler::FSR22:
+    case Upscaler::FFX:
+        CreateFeature(upscaler, handleId, parameters, feature);
+        break;
+
     case Upscaler::DLSS:
         if (primaryGpu.dlssCapable && state.NVNGX_DLSS_Path.has_value())
         {
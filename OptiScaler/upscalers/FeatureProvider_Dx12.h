@@ -9,6 +9,10 @@ class FeatureProvider_Dx12
     static bool GetFeature(Upscaler upscaler, UINT handleId, NVSDK_NGX_Parameter* parameters,
                            std::unique_ptr<IFeature_Dx12>* feature);
 
+    // Creates the given non DLSS upscaler without fallbacks, notifications or writing the selection to config
+    static bool CreateFeature(Upscaler upscaler, UINT handleId, NVSDK_NGX_Parameter* parameters,
+                              std::unique_ptr<IFeature_Dx12>* feature);
+
     static bool ChangeFeature(Upscaler upscaler, ID3D12Device* device, ID3D12GraphicsCommandList* cmdList,
                               UINT handleId, NVSDK_NGX_Parameter* parameters, ContextData<IFeature_Dx12>* contextData);
 };
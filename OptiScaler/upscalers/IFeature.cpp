@@ -236,12 +236,12 @@ void IFeature::GetRenderResolution(const NVSDK_NGX_Parameter* InParameters, unsi
     //	InParameters->Set(NVSDK_NGX_Parameter_SuperSampling_ScaleFactor, 1.0f);
     // }
 
-    JitterInfo ji {};
-    if (_jitterInfo.size() < 350 &&
-        InParameters->Get(NVSDK_NGX_Parameter_Jitter_Offset_X, &ji.x) == NVSDK_NGX_Result_Success &&
-        InParameters->Get(NVSDK_NGX_Parameter_Jitter_Offset_Y, &ji.y) == NVSDK_NGX_Result_Success)
+    float jitterX = 0.0f;
+    float jitterY = 0.0f;
+    if (InParameters->Get(NVSDK_NGX_Parameter_Jitter_Offset_X, &jitterX) == NVSDK_NGX_Result_Success &&
+        InParameters->Get(NVSDK_NGX_Parameter_Jitter_Offset_Y, &jitterY) == NVSDK_NGX_Result_Success)
     {
-        _jitterInfo.insert(std::make_pair(ji.x, ji.y));
+        _jitterAnalyzer.AddSample(jitterX, jitterY, _renderWidth, _renderHeight);
     }
 }
 
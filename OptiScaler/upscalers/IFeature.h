@@ -4,8 +4,8 @@
 #include <nvsdk_ngx.h>
 #include <nvsdk_ngx_defs.h>
 
-#include <unordered_set>
 #include <Util.h>
+#include "JitterAnalyzer.h"
 
 #define DLSS_MOD_ID_OFFSET 1000000
 
@@ -30,23 +30,7 @@ class IFeature
 
     NVSDK_NGX_PerfQuality_Value _perfQualityValue;
 
-    struct JitterInfo
-    {
-        float x;
-        float y;
-    };
-
-    struct hashFunction
-    {
-        size_t operator()(const std::pair<float, float>& p) const
-        {
-            size_t h1 = std::hash<float>()(p.first);
-            size_t h2 = std::hash<float>()(p.second);
-            return h1 ^ (h2 << 1);
-        }
-    };
-
-    std::unordered_set<std::pair<float, float>, hashFunction> _jitterInfo;
+    JitterAnalyzer _jitterAnalyzer;
 
   protected:
     // D3D11with12
@@ -96,7 +80,8 @@ class IFeature
     std::string Name() const { return UpscalerDisplayName(GetUpscalerType()); };
     std::string ShortName() const { return UpscalerShortName(GetUpscalerType()); }; // Without the version
 
-    virtual size_t JitterCount() { return _jitterInfo.size(); }
+    virtual size_t JitterCount() { return _jitterAnalyzer.Result().PhaseCount; }
+    const JitterAnalysis& JitterInfo() const { return _jitterAnalyzer.Result(); }
 
     virtual void TickFrozenCheck();
     virtual bool IsFrozen() { return _featureFrozen; };
@@ -6,6 +6,7 @@
 #include <proxies/DXGI_Proxy.h>
 #include <proxies/D3D12_Proxy.h>
 #include <misc/IdentifyGpu.h>
+#include <misc/VramRegistry.h>
 
 #define ASSIGN_DESC(dest, src)                                                                                         \
     dest.Width = src.Width;                                                                                            \
@@ -642,6 +643,8 @@ bool IFeature_Dx11wDx12::ProcessDx11Textures(const NVSDK_NGX_Parameter* InParame
             return false;
         }
 
+        VramRegistry::Instance().Track(dx11Color.Dx12Resource, "Dx11 with Dx12", "Shared color");
+
         dx11Color.Dx12Handle = dx11Color.Dx11Handle;
     }
 
@@ -657,6 +660,8 @@ bool IFeature_Dx11wDx12::ProcessDx11Textures(const NVSDK_NGX_Parameter* InParame
             return false;
         }
 
+        VramRegistry::Instance().Track(dx11Mv.Dx12Resource, "Dx11 with Dx12", "Shared motion vectors");
+
         dx11Mv.Dx11Handle = dx11Mv.Dx12Handle;
     }
 
@@ -672,6 +677,8 @@ bool IFeature_Dx11wDx12::ProcessDx11Textures(const NVSDK_NGX_Parameter* InParame
             return false;
         }
 
+        VramRegistry::Instance().Track(dx11Out.Dx12Resource, "Dx11 with Dx12", "Shared output");
+
         dx11Out.Dx12Handle = dx11Out.Dx11Handle;
     }
 
@@ -687,6 +694,8 @@ bool IFeature_Dx11wDx12::ProcessDx11Textures(const NVSDK_NGX_Parameter* InParame
             return false;
         }
 
+        VramRegistry::Instance().Track(dx11Depth.Dx12Resource, "Dx11 with Dx12", "Shared depth");
+
         auto desc = dx11Depth.Dx12Resource->GetDesc();
 
         dx11Depth.Dx12Handle = dx11Depth.Dx11Handle;
@@ -708,6 +717,8 @@ bool IFeature_Dx11wDx12::ProcessDx11Textures(const NVSDK_NGX_Parameter* InParame
             return false;
         }
 
+        VramRegistry::Instance().Track(dx11Exp.Dx12Resource, "Dx11 with Dx12", "Shared exposure");
+
         dx11Exp.Dx12Handle = dx11Exp.Dx11Handle;
     }
 
@@ -724,6 +735,8 @@ bool IFeature_Dx11wDx12::ProcessDx11Textures(const NVSDK_NGX_Parameter* InParame
             return false;
         }
 
+        VramRegistry::Instance().Track(dx11Reactive.Dx12Resource, "Dx11 with Dx12", "Shared reactive mask");
+
         dx11Reactive.Dx12Handle = dx11Reactive.Dx11Handle;
     }
 
@@ -6,6 +6,9 @@
 #include "IFeature_Dx12.h"
 #include "State.h"
 
+#include <upscaler_time/UpscalerTime_Dx12.h>
+#include <misc/VramRegistry.h>
+
 void IFeature_Dx12::ResourceBarrier(ID3D12GraphicsCommandList* InCommandList, ID3D12Resource* InResource,
                                     D3D12_RESOURCE_STATES InBeforeState, D3D12_RESOURCE_STATES InAfterState) const
 {
@@ -22,7 +25,7 @@ void IFeature_Dx12::ResourceBarrier(ID3D12GraphicsCommandList* InCommandList, ID
 }
 
 bool IFeature_Dx12::Init(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCommandList,
-                         NVSDK_NGX_Parameter* InParameters)
+                         NVSDK_NGX_Parameter* InParameters, bool InCreateMenu)
 {
     Device = InDevice;
 
@@ -30,7 +33,8 @@ bool IFeature_Dx12::Init(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCo
 
     if (result)
     {
-        if (!Config::Instance()->OverlayMenu.value_or_default() && (Imgui == nullptr || Imgui.get() == nullptr))
+        if (InCreateMenu && !Config::Instance()->OverlayMenu.value_or_default() &&
+            (Imgui == nullptr || Imgui.get() == nullptr))
             Imgui = std::make_unique<Menu_Dx12>(Util::GetProcessWindow(), InDevice);
 
         OutputScaler = std::make_unique<OS_Dx12>("Output Scaling", InDevice, (TargetWidth() < DisplayWidth()));
@@ -84,6 +88,26 @@ bool IFeature_Dx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_NGX
     if (!OutputScaler->IsInit())
         useOutputScaling = false;
 
+    // Buffers of passes which are not used for a while only take VRAM, they are recreated on next use
+    if (Config::Instance()->ReleaseIdleBuffersOnLowVram.value_or_default() &&
+        VramRegistry::Instance().Pressure() != VramPressure::None)
+    {
+        auto pressure = VramRegistry::Instance().Pressure();
+        auto releaseIdle = [pressure](auto* pass, const char* name)
+        {
+            if (pass != nullptr &&
+                VramRegistry::ShouldReleaseIdle(pressure, pass->Buffer() != nullptr, pass->IdleFrames()))
+            {
+                LOG_INFO("VRAM is low, releasing idle {} buffer", name);
+                pass->ReleaseBuffer();
+            }
+        };
+
+        releaseIdle(OutputScaler.get(), "Output Scaling");
+        releaseIdle(RCAS.get(), "RCAS");
+        releaseIdle(Bias.get(), "Bias");
+    }
+
     ID3D12Resource* paramOutput = nullptr;
     ID3D12Resource* paramMotion = nullptr;
     ID3D12Resource* paramDepth = nullptr;
@@ -92,10 +116,104 @@ bool IFeature_Dx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_NGX
     InParameters->Get(NVSDK_NGX_Parameter_MotionVectors, &paramMotion);
     InParameters->Get(NVSDK_NGX_Parameter_Depth, &paramDepth);
 
+    float localSharpness = _sharpness;
+    auto fillRcasConstants = [&](RcasConstants& rcasConstants)
+    {
+        rcasConstants.Sharpness = localSharpness;
+        rcasConstants.DepthIsLinear = DepthLinear();
+        rcasConstants.DepthIsReversed = DepthInverted();
+        rcasConstants.IsHdr = IsHdr();
+
+        InParameters->Get(NVSDK_NGX_Parameter_MV_Scale_X, &rcasConstants.MvScaleX);
+        InParameters->Get(NVSDK_NGX_Parameter_MV_Scale_Y, &rcasConstants.MvScaleY);
+
+        float nearPlane = 0.0f;
+        float farPlane = 0.0f;
+
+        // TODO: Probably doesn't work for most cases, we need camera near and far for DLSSD
+        // at it might provide linear depth, also DLSSG might be on a separate parameters instance
+        // Might need to recalc this from camera matrices
+        if (InParameters->Get("DLSSG.CameraNear", &nearPlane) == NVSDK_NGX_Result_Success &&
+            InParameters->Get("DLSSG.CameraFar", &farPlane) == NVSDK_NGX_Result_Success)
+        {
+            rcasConstants.CameraNear = nearPlane;
+            rcasConstants.CameraFar = farPlane;
+        }
+        else
+        {
+            rcasConstants.CameraNear = Config::Instance()->FsrCameraNear.value_or_default();
+            rcasConstants.CameraFar = Config::Instance()->FsrCameraFar.value_or_default();
+        }
+    };
+
+    // Created on first use so it can be toggled from the menu without a backend reinit
+    if (useOutputScaling && useRcas && FusedPost == nullptr &&
+        Config::Instance()->OutputScalingFusedPasses.value_or_default())
+    {
+        FusedPost = std::make_unique<FP_Dx12>("Fused Post", Device);
+    }
+
+    // Downscale + RCAS (+ output format) in a single dispatch when the combination is supported
+    bool useFusedPost = useOutputScaling && useRcas && FusedPost != nullptr && FusedPost->IsInit() &&
+                        Config::Instance()->OutputScalingFusedPasses.value_or_default() && paramMotion != nullptr &&
+                        paramOutput != nullptr &&
+                        FP_Dx12::IsSupported(Config::Instance()->OutputScalingDownscaler.value_or_default(),
+                                             Config::Instance()->SharpnessShader.value_or_default(),
+                                             TargetWidth() < DisplayWidth());
+
+    FPPermutation fusedPermutation {};
+    if (useFusedPost)
+    {
+        fusedPermutation = FP_Dx12::GetPermutation(Config::Instance()->OutputScalingDownscaler.value_or_default(),
+                                                   RCAS->CanRender(), paramOutput->GetDesc().Format);
+    }
+
     // Order is important as that's the order of shader dispatch
     std::vector<ShaderPass> pipeline;
 
-    if (useOutputScaling)
+    if (useFusedPost)
+    {
+        pipeline.push_back(
+            { // Setup
+              [&](ID3D12Resource* nextOutput) -> ID3D12Resource*
+              {
+                  // Disable any built-in sharpness shaders
+                  InParameters->Set(NVSDK_NGX_Parameter_Sharpness, 0.0f);
+                  _sharpness = 0.0f;
+
+                  if (OutputScaler->CreateBufferResource(Device, nextOutput, TargetWidth(), TargetHeight(),
+                                                         D3D12_RESOURCE_STATE_UNORDERED_ACCESS))
+                  {
+                      OutputScaler->SetBufferState(InCommandList, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+                      return OutputScaler->Buffer();
+                  }
+                  return nullptr;
+              },
+
+              // Dispatch
+              [&](ID3D12Resource* input, ID3D12Resource* output) -> bool
+              {
+                  LOG_DEBUG("Scaling & sharpening output...");
+                  OutputScaler->SetBufferState(InCommandList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+
+                  RcasConstants rcasConstants {};
+                  fillRcasConstants(rcasConstants);
+
+                  auto outDesc = output->GetDesc();
+
+                  if (!FusedPost->Dispatch(InCommandList, input, paramMotion, rcasConstants, fusedPermutation,
+                                           TargetWidth(), TargetHeight(), (uint32_t) outDesc.Width, outDesc.Height,
+                                           output))
+                  {
+                      // Separate passes will be used from next frame
+                      Config::Instance()->OutputScalingFusedPasses.set_volatile_value(false);
+                      return false;
+                  }
+                  return true;
+              } });
+    }
+
+    if (useOutputScaling && !useFusedPost)
     {
         pipeline.push_back(
             { // Setup
@@ -126,8 +244,7 @@ bool IFeature_Dx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_NGX
               } });
     }
 
-    float localSharpness = _sharpness;
-    if (useRcas)
+    if (useRcas && !useFusedPost)
     {
         pipeline.push_back(
             { // Setup
@@ -154,32 +271,7 @@ bool IFeature_Dx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_NGX
                   RCAS->SetBufferState(InCommandList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
 
                   RcasConstants rcasConstants {};
-
-                  rcasConstants.Sharpness = localSharpness;
-                  rcasConstants.DepthIsLinear = DepthLinear();
-                  rcasConstants.DepthIsReversed = DepthInverted();
-                  rcasConstants.IsHdr = IsHdr();
-
-                  InParameters->Get(NVSDK_NGX_Parameter_MV_Scale_X, &rcasConstants.MvScaleX);
-                  InParameters->Get(NVSDK_NGX_Parameter_MV_Scale_Y, &rcasConstants.MvScaleY);
-
-                  float nearPlane = 0.0f;
-                  float farPlane = 0.0f;
-
-                  // TODO: Probably doesn't work for most cases, we need camera near and far for DLSSD
-                  // at it might provide linear depth, also DLSSG might be on a separate parameters instance
-                  // Might need to recalc this from camera matrices
-                  if (InParameters->Get("DLSSG.CameraNear", &nearPlane) == NVSDK_NGX_Result_Success &&
-                      InParameters->Get("DLSSG.CameraFar", &farPlane) == NVSDK_NGX_Result_Success)
-                  {
-                      rcasConstants.CameraNear = nearPlane;
-                      rcasConstants.CameraFar = farPlane;
-                  }
-                  else
-                  {
-                      rcasConstants.CameraNear = Config::Instance()->FsrCameraNear.value_or_default();
-                      rcasConstants.CameraFar = Config::Instance()->FsrCameraFar.value_or_default();
-                  }
+                  fillRcasConstants(rcasConstants);
 
                   if (!RCAS->Dispatch(InCommandList, input, paramMotion, rcasConstants, output, paramDepth))
                   {
@@ -211,6 +303,18 @@ bool IFeature_Dx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_NGX
     if (!evalResult)
         return false;
 
+    // Upscaler only, post upscale passes are timed separately below
+    UpscalerTimeDx12::UpscaleEnd(InCommandList);
+
+    // Fused passes are keyed by permutation, separate chain by which passes are active
+    uint32_t postKey = useFusedPost ? fusedPermutation.Key()
+                                    : (1u << 16) | (useOutputScaling ? 1u : 0u) | (useRcas ? 2u : 0u);
+
+    if (!pipeline.empty())
+        UpscalerTimeDx12::PostUpscaleStart(InCommandList);
+
+    bool postUpscaleDone = true;
+
     // Iterate FORWARDS to execute the shaders in the defined order
     for (auto& pass : pipeline)
     {
@@ -218,11 +322,30 @@ bool IFeature_Dx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_NGX
         {
             if (!pass.Dispatch(pass.inputBuffer, pass.outputBuffer))
             {
-                return true;
+                postUpscaleDone = false;
+                break;
             }
         }
     }
 
+    if (!pipeline.empty())
+    {
+        std::string postName;
+
+        if (useFusedPost)
+            postName = "Fused " + fusedPermutation.Name();
+        else if (useOutputScaling && useRcas)
+            postName = "Separate OS+RCAS";
+        else
+            postName = useOutputScaling ? "Separate OS" : "Separate RCAS";
+
+        // Ended on failures too, start query must always be paired
+        UpscalerTimeDx12::PostUpscaleEnd(InCommandList, postKey, postName, postUpscaleDone);
+    }
+
+    if (!postUpscaleDone)
+        return true;
+
     // imgui
     if (!Config::Instance()->OverlayMenu.value_or_default() && _frameCount > 30)
     {
@@ -257,5 +380,6 @@ IFeature_Dx12::~IFeature_Dx12()
     Imgui.reset();
     OutputScaler.reset();
     RCAS.reset();
+    FusedPost.reset();
     Bias.reset();
 }
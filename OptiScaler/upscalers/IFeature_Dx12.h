@@ -7,6 +7,7 @@
 #include <menu/menu_dx12.h>
 #include <shaders/output_scaling/OS_Dx12.h>
 #include <shaders/rcas/RCAS_Dx12.h>
+#include <shaders/fused_post/FP_Dx12.h>
 #include <shaders/bias/Bias_Dx12.h>
 
 class IFeature_Dx12 : public virtual IFeature
@@ -30,6 +31,7 @@ class IFeature_Dx12 : public virtual IFeature
     static inline std::unique_ptr<Menu_Dx12> Imgui = nullptr;
     std::unique_ptr<OS_Dx12> OutputScaler = nullptr;
     std::unique_ptr<RCAS_Dx12> RCAS = nullptr;
+    std::unique_ptr<FP_Dx12> FusedPost = nullptr;
     std::unique_ptr<Bias_Dx12> Bias = nullptr;
 
     void ResourceBarrier(ID3D12GraphicsCommandList* InCommandList, ID3D12Resource* InResource,
@@ -39,7 +41,9 @@ class IFeature_Dx12 : public virtual IFeature
     virtual bool EvaluateInternal(ID3D12GraphicsCommandList* InCommandList, NVSDK_NGX_Parameter* InParameters) = 0;
 
   public:
-    bool Init(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCommandList, NVSDK_NGX_Parameter* InParameters);
+    // InCreateMenu is false for contexts that are never shown, like the pre-warm one on its background thread
+    bool Init(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCommandList, NVSDK_NGX_Parameter* InParameters,
+              bool InCreateMenu = true);
     bool Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_NGX_Parameter* InParameters);
 
     IFeature_Dx12(unsigned int InHandleId, NVSDK_NGX_Parameter* InParameters);
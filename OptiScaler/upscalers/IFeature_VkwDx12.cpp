@@ -15,6 +15,7 @@
 #include <magic_enum.hpp>
 #include <imgui/ImGuiNotify.hpp>
 #include <misc/IdentifyGpu.h>
+#include <misc/VramRegistry.h>
 
 // Used Nukem's VKToDX as a base
 // https://github.com/Nukem9/dlssg-to-fsr3/blob/eca4a79b4d23339a1dcf02e30b9f3bafe7901513/source/maindll/FFFrameInterpolatorVKToDX.cpp
@@ -502,6 +503,8 @@ bool IFeature_VkwDx12::CreateSharedTexture(const VkImageCreateInfo& ImageInfo, V
         return false;
     }
 
+    VramRegistry::Instance().Track(createdResourceDX, "Vulkan with Dx12", "Shared texture");
+
     // Vulkan makes us create an image and allocate its backing memory by hand...
     //
     // "A VkExternalMemoryImageCreateInfo structure with a non-zero handleTypes field must
@@ -947,6 +950,43 @@ static bool NvVkResourceNotValid(NVSDK_NGX_Resource_VK* param)
            param->Resource.ImageViewInfo.Height == 0;
 }
 
+static VkwDx12InputKey InputKeyOf(NVSDK_NGX_Resource_VK* param)
+{
+    return { (uint64_t) param->Resource.ImageViewInfo.Image, (uint64_t) param->Resource.ImageViewInfo.ImageView,
+             param->Resource.ImageViewInfo.Width, param->Resource.ImageViewInfo.Height,
+             (uint32_t) param->Resource.ImageViewInfo.Format };
+}
+
+class Dx12QueueFence : public IVkwDx12Fence
+{
+  private:
+    ID3D12Fence* _fence = nullptr;
+    HANDLE _event = nullptr;
+
+  public:
+    Dx12QueueFence(ID3D12Fence* fence, HANDLE event) : _fence(fence), _event(event) {}
+
+    uint64_t CompletedValue() override { return _fence->GetCompletedValue(); }
+
+    bool WaitFor(uint64_t value, uint32_t timeoutMs) override
+    {
+        if (_fence->GetCompletedValue() >= value)
+            return true;
+
+        if (_fence->SetEventOnCompletion(value, _event) != S_OK)
+            return false;
+
+        // Event might be left signaled by an earlier timed out wait
+        while (_fence->GetCompletedValue() < value)
+        {
+            if (WaitForSingleObject(_event, timeoutMs == NoTimeout ? INFINITE : timeoutMs) != WAIT_OBJECT_0)
+                return false;
+        }
+
+        return true;
+    }
+};
+
 bool IFeature_VkwDx12::ProcessVulkanTextures(VkCommandBuffer InCmdList, const NVSDK_NGX_Parameter* InParameters)
 {
     LOG_FUNC();
@@ -985,15 +1025,18 @@ bool IFeature_VkwDx12::ProcessVulkanTextures(VkCommandBuffer InCmdList, const NV
 
     LOG_DEBUG("Upscaling command buffer: {:X}, frame: {}", (size_t) InCmdList, frame);
 
-    // Only wait if we're more than 1 frame behind (triple buffering protection)
-    uint64_t lastFrameToWaitFor = (_frameCount > 1) ? (_frameCount - 1) : 0;
-    if (Dx12Fence->GetCompletedValue() < lastFrameToWaitFor)
+    // Only wait when D3D12 is still using this ring slot
+    Dx12QueueFence queueFence(Dx12Fence, Dx12FenceEvent);
+    if (!_pipeline.AcquireSlot(queueFence, _frameCount, VKDX12_BUFFER_COUNT))
     {
-        // Only wait for N-1 frame, not current frame
-        Dx12Fence->SetEventOnCompletion(lastFrameToWaitFor, Dx12FenceEvent);
-        WaitForSingleObject(Dx12FenceEvent, INFINITE);
+        LOG_ERROR("Failed to wait for D3D12 queue!");
+        return false;
     }
 
+    unsigned int reset = 0;
+    InParameters->Get(NVSDK_NGX_Parameter_Reset, &reset);
+    _pipeline.BeginFrame(Config::Instance()->VulkanElideStaticInputs.value_or_default() && reset != 1);
+
     Dx12CommandAllocator[frame]->Reset();
     Dx12CommandList[frame]->Reset(Dx12CommandAllocator[frame], nullptr);
 
@@ -1108,13 +1151,18 @@ bool IFeature_VkwDx12::ProcessVulkanTextures(VkCommandBuffer InCmdList, const NV
                   magic_enum::enum_name(paramColor->Resource.ImageViewInfo.Format),
                   (int) paramColor->Resource.ImageViewInfo.Format);
 
-        if (!CopyTextureFromVkToDx12(InCmdList, paramColor, &vkColor, ColorCopy.get(), true, false))
+        auto key = InputKeyOf(paramColor);
+        auto elide = vkColor.VkSharedImage != VK_NULL_HANDLE && _pipeline.CanElide(VkwDx12Input::Color, key);
+
+        if (!elide && !CopyTextureFromVkToDx12(InCmdList, paramColor, &vkColor, ColorCopy.get(), true, false))
         {
             LOG_ERROR("Failed to copy color texture!");
             return false;
         }
         else
         {
+            _pipeline.Record(VkwDx12Input::Color, key, elide);
+
             vkColor.VkSourceImage = paramColor->Resource.ImageViewInfo.Image;
             vkColor.VkSourceImageView = paramColor->Resource.ImageViewInfo.ImageView;
 
@@ -1131,13 +1179,18 @@ bool IFeature_VkwDx12::ProcessVulkanTextures(VkCommandBuffer InCmdList, const NV
                   paramMv->Resource.ImageViewInfo.Height, magic_enum::enum_name(paramMv->Resource.ImageViewInfo.Format),
                   (int) paramMv->Resource.ImageViewInfo.Format);
 
-        if (!CopyTextureFromVkToDx12(InCmdList, paramMv, &vkMv, VelocityCopy.get(), true, false))
+        auto key = InputKeyOf(paramMv);
+        auto elide = vkMv.VkSharedImage != VK_NULL_HANDLE && _pipeline.CanElide(VkwDx12Input::MotionVectors, key);
+
+        if (!elide && !CopyTextureFromVkToDx12(InCmdList, paramMv, &vkMv, VelocityCopy.get(), true, false))
         {
             LOG_ERROR("Failed to copy motion vectors!");
             return false;
         }
         else
         {
+            _pipeline.Record(VkwDx12Input::MotionVectors, key, elide);
+
             vkMv.VkSourceImage = paramMv->Resource.ImageViewInfo.Image;
             vkMv.VkSourceImageView = paramMv->Resource.ImageViewInfo.ImageView;
 
@@ -1179,13 +1232,18 @@ bool IFeature_VkwDx12::ProcessVulkanTextures(VkCommandBuffer InCmdList, const NV
                   magic_enum::enum_name(paramDepth->Resource.ImageViewInfo.Format),
                   (int) paramDepth->Resource.ImageViewInfo.Format);
 
-        if (!CopyTextureFromVkToDx12(InCmdList, paramDepth, &vkDepth, DepthCopy.get(), true, true))
+        auto key = InputKeyOf(paramDepth);
+        auto elide = vkDepth.VkSharedImage != VK_NULL_HANDLE && _pipeline.CanElide(VkwDx12Input::Depth, key);
+
+        if (!elide && !CopyTextureFromVkToDx12(InCmdList, paramDepth, &vkDepth, DepthCopy.get(), true, true))
         {
             LOG_ERROR("Failed to copy depth texture!");
             return false;
         }
         else
         {
+            _pipeline.Record(VkwDx12Input::Depth, key, elide);
+
             vkDepth.VkSourceImage = paramDepth->Resource.ImageViewInfo.Image;
             vkDepth.VkSourceImageView = paramDepth->Resource.ImageViewInfo.ImageView;
 
@@ -1203,13 +1261,18 @@ bool IFeature_VkwDx12::ProcessVulkanTextures(VkCommandBuffer InCmdList, const NV
                   magic_enum::enum_name(paramExposure->Resource.ImageViewInfo.Format),
                   (int) paramExposure->Resource.ImageViewInfo.Format);
 
-        if (!CopyTextureFromVkToDx12(InCmdList, paramExposure, &vkExp, ExpCopy.get(), true, false))
+        auto key = InputKeyOf(paramExposure);
+        auto elide = vkExp.VkSharedImage != VK_NULL_HANDLE && _pipeline.CanElide(VkwDx12Input::Exposure, key);
+
+        if (!elide && !CopyTextureFromVkToDx12(InCmdList, paramExposure, &vkExp, ExpCopy.get(), true, false))
         {
             LOG_ERROR("Failed to copy exposure texture!");
             return false;
         }
         else
         {
+            _pipeline.Record(VkwDx12Input::Exposure, key, elide);
+
             vkExp.VkSourceImage = paramExposure->Resource.ImageViewInfo.Image;
             vkExp.VkSourceImageView = paramExposure->Resource.ImageViewInfo.ImageView;
 
@@ -1227,13 +1290,20 @@ bool IFeature_VkwDx12::ProcessVulkanTextures(VkCommandBuffer InCmdList, const NV
                   magic_enum::enum_name(paramReactiveMask->Resource.ImageViewInfo.Format),
                   (int) paramReactiveMask->Resource.ImageViewInfo.Format);
 
-        if (!CopyTextureFromVkToDx12(InCmdList, paramReactiveMask, &vkReactive, ReactiveCopy.get(), true, false))
+        auto key = InputKeyOf(paramReactiveMask);
+        auto elide =
+            vkReactive.VkSharedImage != VK_NULL_HANDLE && _pipeline.CanElide(VkwDx12Input::ReactiveMask, key);
+
+        if (!elide &&
+            !CopyTextureFromVkToDx12(InCmdList, paramReactiveMask, &vkReactive, ReactiveCopy.get(), true, false))
         {
             LOG_ERROR("Failed to copy reactive mask!");
             return false;
         }
         else
         {
+            _pipeline.Record(VkwDx12Input::ReactiveMask, key, elide);
+
             vkReactive.VkSourceImage = paramReactiveMask->Resource.ImageViewInfo.Image;
             vkReactive.VkSourceImageView = paramReactiveMask->Resource.ImageViewInfo.ImageView;
 
@@ -1457,13 +1527,15 @@ bool IFeature_VkwDx12::CopyBackOutput()
     }
 
     // Signal for next frame
-    result = Dx12CommandQueue->Signal(Dx12Fence, _frameCount);
+    result = Dx12CommandQueue->Signal(Dx12Fence, VkwDx12Pipeline::FenceValue(_frameCount));
     if (result != S_OK)
     {
         LOG_ERROR("Dx12CommandQueue->Signal failed: {0:x}", result);
         return false;
     }
 
+    _pipeline.Submitted(VkwDx12Pipeline::FenceValue(_frameCount));
+
     // D3D12 side is completed now copy back output to Vulkan image
     if (vkOut.VkSourceImage != VK_NULL_HANDLE && vkOut.VkSharedImage != VK_NULL_HANDLE)
     {
@@ -1732,6 +1804,8 @@ void IFeature_VkwDx12::ReleaseSharedResources()
 {
     LOG_FUNC();
 
+    _pipeline.Invalidate();
+
     // Release Vulkan resources
     SAFE_DESTROY_VK(vkDestroyImage, VulkanDevice, vkColor.VkSharedImage, nullptr);
     SAFE_DESTROY_VK(vkDestroyImage, VulkanDevice, vkMv.VkSharedImage, nullptr);
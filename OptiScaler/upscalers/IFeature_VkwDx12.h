@@ -1,5 +1,6 @@
 #pragma once
 #include "IFeature_Vk.h"
+#include "VkwDx12Pipeline.h"
 
 #include <menu/menu_overlay_vk.h>
 
@@ -19,7 +20,7 @@
 
 #include <nvsdk_ngx_vk.h>
 
-#define VKDX12_BUFFER_COUNT 2
+#define VKDX12_BUFFER_COUNT 3
 
 class IFeature_VkwDx12 : public virtual IFeature_Vk
 {
@@ -85,6 +86,9 @@ class IFeature_VkwDx12 : public virtual IFeature_Vk
     HANDLE vkSHForTextureCopy[VKDX12_BUFFER_COUNT] {};
     ULONG _fenceValue = 0;
 
+    // Ring slot pacing and copy elision
+    VkwDx12Pipeline _pipeline;
+
     // D3D12 processing shaders
     std::unique_ptr<OS_Dx12> OutputScaler = nullptr;
     std::unique_ptr<RCAS_Dx12> RCAS = nullptr;
@@ -139,4 +143,6 @@ class IFeature_VkwDx12 : public virtual IFeature_Vk
                       NVSDK_NGX_Parameter* InParameters) = 0;
 
     virtual bool Evaluate(VkCommandBuffer InCmdBuffer, NVSDK_NGX_Parameter* InParameters) = 0;
+
+    const VkwDx12PipelineStats& PipelineStats() const { return _pipeline.Stats(); }
 };
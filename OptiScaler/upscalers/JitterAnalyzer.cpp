@@ -0,0 +1,253 @@
+#include "pch.h"
+#include "JitterAnalyzer.h"
+
+#include <cmath>
+
+void JitterAnalyzer::AddSample(float x, float y, uint32_t renderWidth, uint32_t renderHeight)
+{
+    // Not resetting on size change, sequences usually stay the same with dynamic resolution
+    _renderWidth = renderWidth;
+    _renderHeight = renderHeight;
+
+    _samples[_head] = { x, y };
+    _head = (_head + 1) % HistorySize;
+
+    if (_count < HistorySize)
+        _count++;
+
+    // A locked sequence must repeat itself every period
+    if (_result.PeriodLocked && _count > _result.PhaseCount)
+    {
+        auto& current = At(0);
+        auto& previous = At(_result.PhaseCount);
+
+        if (!Equal(current.X, previous.X) || !Equal(current.Y, previous.Y))
+        {
+            _result.Resets++;
+            _result.PeriodLocked = false;
+            _result.Confidence = 0.0f;
+            LOG_DEBUG("Jitter sequence broke, resets: {}", _result.Resets);
+        }
+    }
+
+    if (++_sinceAnalyze >= AnalyzeInterval)
+    {
+        _sinceAnalyze = 0;
+        Analyze();
+    }
+}
+
+void JitterAnalyzer::Reset()
+{
+    auto resets = _result.Resets;
+
+    _head = 0;
+    _count = 0;
+    _sinceAnalyze = 0;
+    _result = {};
+    _result.Resets = resets;
+}
+
+uint32_t JitterAnalyzer::RecommendedPhaseCount(uint32_t renderWidth, uint32_t displayWidth)
+{
+    if (renderWidth == 0 || displayWidth == 0)
+        return 0;
+
+    auto ratio = (float) displayWidth / (float) renderWidth;
+    return (uint32_t) std::ceil(8.0f * ratio * ratio);
+}
+
+void JitterAnalyzer::Analyze()
+{
+    auto wasLocked = _result.PeriodLocked;
+    auto previousPhases = _result.PhaseCount;
+    auto resets = _result.Resets;
+
+    _result = {};
+    _result.Resets = resets;
+
+    auto period = DetectPeriod();
+
+    if (period == 0)
+    {
+        _result.PhaseCount = CountDistinct();
+        return;
+    }
+
+    _result.PeriodLocked = true;
+    _result.PhaseCount = period;
+
+    bool zero = true;
+    for (uint32_t i = 0; i < period && zero; i++)
+        zero = At(i).X == 0.0f && At(i).Y == 0.0f;
+
+    if (zero)
+    {
+        _result.ZeroJitter = true;
+        _result.Confidence = 1.0f;
+        return;
+    }
+
+    // Pick the best fitting base for each axis, usually 2 for X and 3 for Y
+    float bestX = 0.0f;
+    float bestY = 0.0f;
+
+    for (uint32_t base : { 2u, 3u })
+    {
+        float scale = 0.0f;
+
+        if (auto fit = FitHalton(true, period, base, scale); fit > bestX)
+        {
+            bestX = fit;
+            _result.BaseX = base;
+            _result.ScaleX = scale;
+        }
+
+        if (auto fit = FitHalton(false, period, base, scale); fit > bestY)
+        {
+            bestY = fit;
+            _result.BaseY = base;
+            _result.ScaleY = scale;
+        }
+    }
+
+    // Anything below this is not a Halton sequence
+    constexpr float minFit = 0.9f;
+
+    if (bestX < minFit)
+        _result.BaseX = 0;
+
+    if (bestY < minFit)
+        _result.BaseY = 0;
+
+    _result.FlippedX = _result.ScaleX < 0.0f;
+    _result.FlippedY = _result.ScaleY < 0.0f;
+
+    auto scaleX = std::abs(_result.ScaleX);
+    auto scaleY = std::abs(_result.ScaleY);
+    auto isNear = [](float value, float target) { return std::abs(value - target) < target * 0.1f; };
+
+    if (isNear(scaleX, 1.0f) && isNear(scaleY, 1.0f))
+        _result.Units = JitterUnits::Pixels;
+    else if (_renderWidth > 0 && _renderHeight > 0 && isNear(scaleX, 2.0f / _renderWidth) &&
+             isNear(scaleY, 2.0f / _renderHeight))
+        _result.Units = JitterUnits::NDC;
+
+    _result.Confidence = std::min(bestX, bestY);
+
+    // Longer history than a few periods makes the lock more trustworthy
+    if (_count < period * 3)
+        _result.Confidence *= (float) _count / (float) (period * 3);
+
+    if (!wasLocked || previousPhases != period)
+    {
+        LOG_INFO("Jitter sequence: {} phases, Halton {}/{}, scale: {:.4f}/{:.4f}, units: {}, confidence: {:.2f}",
+                 period, _result.BaseX, _result.BaseY, _result.ScaleX, _result.ScaleY,
+                 _result.Units == JitterUnits::Pixels ? "pixels"
+                 : _result.Units == JitterUnits::NDC  ? "NDC"
+                                                      : "unknown",
+                 _result.Confidence);
+    }
+}
+
+uint32_t JitterAnalyzer::DetectPeriod() const
+{
+    auto maxPeriod = std::min(MaxPeriod, _count / 2);
+
+    for (uint32_t period = 1; period <= maxPeriod; period++)
+    {
+        // Check only the recent part so an older reset doesn't hide the period
+        auto window = std::min(_count - period, period * 2);
+        bool match = true;
+
+        for (uint32_t i = 0; i < window && match; i++)
+            match = Equal(At(i).X, At(i + period).X) && Equal(At(i).Y, At(i + period).Y);
+
+        if (match)
+            return period;
+    }
+
+    return 0;
+}
+
+uint32_t JitterAnalyzer::CountDistinct() const
+{
+    uint32_t distinct = 0;
+
+    for (uint32_t i = 0; i < _count; i++)
+    {
+        bool seen = false;
+
+        for (uint32_t j = 0; j < i && !seen; j++)
+            seen = Equal(At(i).X, At(j).X) && Equal(At(i).Y, At(j).Y);
+
+        if (!seen)
+            distinct++;
+    }
+
+    return distinct;
+}
+
+// Least squares fit of the last period of samples to Halton(base) - 0.5 with every
+// phase offset and both 0 and 1 based indexing. Returns fit quality (1.0 is perfect)
+float JitterAnalyzer::FitHalton(bool useX, uint32_t period, uint32_t base, float& scale) const
+{
+    float best = 0.0f;
+    scale = 0.0f;
+
+    for (uint32_t start = 0; start < 2; start++)
+    {
+        for (uint32_t offset = 0; offset < period; offset++)
+        {
+            double sumVE = 0.0;
+            double sumEE = 0.0;
+            double sumVV = 0.0;
+
+            // Oldest to newest
+            for (uint32_t i = 0; i < period; i++)
+            {
+                auto& sample = At(period - 1 - i);
+                double value = useX ? sample.X : sample.Y;
+                double expected = Halton(((offset + i) % period) + start, base) - 0.5;
+
+                sumVE += value * expected;
+                sumEE += expected * expected;
+                sumVV += value * value;
+            }
+
+            if (sumEE <= 0.0 || sumVV <= 0.0)
+                continue;
+
+            auto k = sumVE / sumEE;
+
+            // Residual of v - k * e, expanded
+            auto residual = std::max(0.0, sumVV - k * sumVE) / sumVV;
+            auto fit = (float) (1.0 - std::sqrt(residual));
+
+            if (fit > best)
+            {
+                best = fit;
+                scale = (float) k;
+            }
+        }
+    }
+
+    return best;
+}
+
+bool JitterAnalyzer::Equal(float a, float b) { return std::abs(a - b) <= 1e-6f + std::abs(a) * 1e-5f; }
+
+float JitterAnalyzer::Halton(uint32_t index, uint32_t base)
+{
+    float f = 1.0f;
+    float result = 0.0f;
+
+    while (index > 0)
+    {
+        f /= (float) base;
+        result += f * (float) (index % base);
+        index /= base;
+    }
+
+    return result;
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include "SysUtils.h"
+
+#include <array>
+
+enum class JitterUnits : uint8_t
+{
+    Unknown,
+    Pixels,
+    NDC,
+};
+
+struct JitterAnalysis
+{
+    uint32_t PhaseCount = 0; // Detected period, distinct offsets in history when there is no period
+    bool PeriodLocked = false;
+    uint32_t BaseX = 0; // Halton base of X, 0 when it doesn't look like a Halton sequence
+    uint32_t BaseY = 0;
+    float ScaleX = 0.0f; // Fitted multiplier against pixel space Halton(-0.5 - 0.5)
+    float ScaleY = 0.0f;
+    JitterUnits Units = JitterUnits::Unknown;
+    bool FlippedX = false;
+    bool FlippedY = false;
+    bool ZeroJitter = false;
+    uint32_t Resets = 0;     // Times a locked sequence broke, camera cuts or jitter index resets
+    float Confidence = 0.0f; // 0.0 - 1.0
+};
+
+// Keeps jitter offsets of the last HistorySize frames in a fixed ring and
+// tries to identify the sequence (period, Halton bases, units and sign).
+// No allocations after construction, analysis runs every AnalyzeInterval frames.
+class JitterAnalyzer
+{
+  public:
+    static constexpr uint32_t HistorySize = 256;
+    static constexpr uint32_t MaxPeriod = 128;
+    static constexpr uint32_t AnalyzeInterval = 32;
+
+    void AddSample(float x, float y, uint32_t renderWidth, uint32_t renderHeight);
+    void Reset();
+
+    const JitterAnalysis& Result() const { return _result; }
+
+    // DLSS programming guide suggests 8 * (display / render)^2 phases
+    static uint32_t RecommendedPhaseCount(uint32_t renderWidth, uint32_t displayWidth);
+
+  private:
+    struct Sample
+    {
+        float X;
+        float Y;
+    };
+
+    std::array<Sample, HistorySize> _samples {};
+    uint32_t _head = 0;  // Next write position
+    uint32_t _count = 0; // Samples since reset, capped at HistorySize
+    uint32_t _sinceAnalyze = 0;
+    uint32_t _renderWidth = 0;
+    uint32_t _renderHeight = 0;
+    JitterAnalysis _result {};
+
+    // age 0 is the newest sample
+    const Sample& At(uint32_t age) const { return _samples[(_head + HistorySize - 1 - age) % HistorySize]; }
+
+    void Analyze();
+    uint32_t DetectPeriod() const;
+    uint32_t CountDistinct() const;
+    float FitHalton(bool useX, uint32_t period, uint32_t base, float& scale) const;
+
+    static bool Equal(float a, float b);
+    static float Halton(uint32_t index, uint32_t base);
+};
@@ -0,0 +1,172 @@
+#include "pch.h"
+#include "Prewarm_Dx12.h"
+
+#include "Util.h"
+#include "Config.h"
+
+#include "NVNGX_Parameter.h"
+#include "FeatureProvider_Dx12.h"
+
+#include <misc/IdentifyGpu.h>
+
+void Prewarm_Dx12::Start(ID3D12Device* device)
+{
+    if (_started || device == nullptr || !Config::Instance()->PrewarmUpscaler.value_or_default())
+        return;
+
+    _started = true;
+
+    // Config is owned by the menu and render threads, snapshot what the background thread needs
+    auto& cfg = *Config::Instance();
+    auto primaryGpu = IdentifyGpu::getPrimaryGpu();
+
+    // Same selection as the NGX input, DLSS needs an initialized NGX so it can't be created this early
+    Upscaler upscaler = primaryGpu.fsr4Capable ? Upscaler::FFX : Upscaler::XeSS;
+
+    if (cfg.Dx12Upscaler.has_value())
+        upscaler = cfg.Dx12Upscaler.value();
+    else if (primaryGpu.dlssCapable)
+        upscaler = Upscaler::DLSS;
+
+    if (upscaler == Upscaler::DLSS || upscaler == Upscaler::DLSSD)
+    {
+        LOG_INFO("Skipping pre-warm, DLSS is selected");
+        return;
+    }
+
+    auto ratio = cfg.QualityRatio_Quality.value_or_default();
+
+    // Released at the end of Run
+    device->AddRef();
+
+    LOG_INFO("Starting upscaler pre-warm");
+    _task = std::async(std::launch::async, [device, upscaler, ratio]() { Run(device, upscaler, ratio); }).share();
+}
+
+void Prewarm_Dx12::Wait()
+{
+    if (!_task.valid())
+        return;
+
+    if (_task.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+        LOG_INFO("Waiting for upscaler pre-warm to finish");
+        _task.wait();
+    }
+
+    _task = {};
+}
+
+bool Prewarm_Dx12::GetDisplaySize(uint32_t& width, uint32_t& height)
+{
+    auto& desc = State::Instance().currentSwapchainDesc;
+
+    if (desc.BufferDesc.Width > 0 && desc.BufferDesc.Height > 0)
+    {
+        width = desc.BufferDesc.Width;
+        height = desc.BufferDesc.Height;
+        return true;
+    }
+
+    // Swapchain is usually not created yet, use the primary monitor resolution
+    width = GetSystemMetrics(SM_CXSCREEN);
+    height = GetSystemMetrics(SM_CYSCREEN);
+
+    return width > 0 && height > 0;
+}
+
+void Prewarm_Dx12::Run(ID3D12Device* device, Upscaler upscaler, float ratio)
+{
+    auto start = Util::MillisecondsNow();
+
+    ID3D12CommandQueue* queue = nullptr;
+    ID3D12CommandAllocator* allocator = nullptr;
+    ID3D12GraphicsCommandList* cmdList = nullptr;
+    ID3D12Fence* fence = nullptr;
+    NVNGX_Parameters* params = nullptr;
+    std::unique_ptr<IFeature_Dx12> feature;
+
+    do
+    {
+        uint32_t displayWidth = 0;
+        uint32_t displayHeight = 0;
+
+        if (!GetDisplaySize(displayWidth, displayHeight))
+        {
+            LOG_WARN("Can't determine display size, skipping pre-warm");
+            break;
+        }
+
+        auto renderWidth = (uint32_t) (displayWidth / ratio);
+        auto renderHeight = (uint32_t) (displayHeight / ratio);
+
+        D3D12_COMMAND_QUEUE_DESC queueDesc {};
+        queueDesc.Type = D3D12_COMMAND_LIST_TYPE_DIRECT;
+
+        if (device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&queue)) != S_OK ||
+            device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&allocator)) != S_OK ||
+            device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, allocator, nullptr,
+                                      IID_PPV_ARGS(&cmdList)) != S_OK ||
+            device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence)) != S_OK)
+        {
+            LOG_ERROR("Can't create command objects for pre-warm");
+            break;
+        }
+
+        params = GetNGXParameters("OptiPrewarm", false);
+        params->Set(NVSDK_NGX_Parameter_DLSS_Feature_Create_Flags, (int) NVSDK_NGX_DLSS_Feature_Flags_MVLowRes);
+        params->Set(NVSDK_NGX_Parameter_Width, renderWidth);
+        params->Set(NVSDK_NGX_Parameter_Height, renderHeight);
+        params->Set(NVSDK_NGX_Parameter_OutWidth, displayWidth);
+        params->Set(NVSDK_NGX_Parameter_OutHeight, displayHeight);
+        params->Set(NVSDK_NGX_Parameter_PerfQualityValue, (int) NVSDK_NGX_PerfQuality_Value_MaxQuality);
+
+        LOG_DEBUG("Pre-warming {} at {}x{} -> {}x{}", UpscalerDisplayName(upscaler), renderWidth, renderHeight,
+                  displayWidth, displayHeight);
+
+        if (!FeatureProvider_Dx12::CreateFeature(upscaler, IFeature::GetNextHandleId(), params, &feature))
+        {
+            LOG_ERROR("Can't create {} for pre-warm", UpscalerDisplayName(upscaler));
+            break;
+        }
+
+        if (!feature->Init(device, cmdList, params, false))
+        {
+            LOG_ERROR("{} init failed during pre-warm", feature->Name());
+            break;
+        }
+
+        // Some upscalers record resource init commands, let them finish before destroying the context
+        cmdList->Close();
+        ID3D12CommandList* lists[] = { cmdList };
+        queue->ExecuteCommandLists(1, lists);
+        queue->Signal(fence, 1);
+
+        if (fence->GetCompletedValue() < 1)
+        {
+            auto event = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+
+            if (event != nullptr)
+            {
+                fence->SetEventOnCompletion(1, event);
+                WaitForSingleObject(event, 5000);
+                CloseHandle(event);
+            }
+        }
+
+        LOG_INFO("{} pre-warm done in {:.2f} ms", feature->Name(), Util::MillisecondsNow() - start);
+
+    } while (false);
+
+    feature.reset();
+
+    if (params != nullptr)
+        delete params;
+
+    SAFE_RELEASE(fence);
+    SAFE_RELEASE(cmdList);
+    SAFE_RELEASE(allocator);
+    SAFE_RELEASE(queue);
+
+    device->Release();
+}
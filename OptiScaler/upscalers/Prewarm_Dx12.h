@@ -0,0 +1,26 @@
+#pragma once
+
+#include "SysUtils.h"
+
+#include <d3d12.h>
+
+#include <future>
+
+// Creates and destroys a throwaway upscaler context on a background thread right after the D3D12 device is
+// hooked, so shader compilation, PSO creation and driver side caches are warm before the game creates its own
+// context. The dummy context is never handed to the game, its creation flags don't match the game's ones.
+class Prewarm_Dx12
+{
+  public:
+    static void Start(ID3D12Device* device);
+
+    // Blocks until a running pre-warm is finished, called before creating the real upscaler context
+    static void Wait();
+
+  private:
+    static void Run(ID3D12Device* device, Upscaler upscaler, float ratio);
+    static bool GetDisplaySize(uint32_t& width, uint32_t& height);
+
+    static inline std::shared_future<void> _task;
+    static inline bool _started = false;
+};
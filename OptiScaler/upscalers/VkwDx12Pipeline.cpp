@@ -0,0 +1,70 @@
+#include "pch.h"
+#include "VkwDx12Pipeline.h"
+
+#include <Util.h>
+
+void VkwDx12Pipeline::BeginFrame(bool elideStaticInputs)
+{
+    _frame++;
+    _stats.Frames++;
+    _elideStaticInputs = elideStaticInputs;
+}
+
+bool VkwDx12Pipeline::AcquireSlot(IVkwDx12Fence& fence, uint64_t frame, uint32_t ringSize)
+{
+    if (frame < ringSize)
+        return true;
+
+    auto target = std::min(FenceValue(frame - ringSize), _lastSubmitted);
+
+    if (fence.CompletedValue() >= target)
+        return true;
+
+    auto start = Util::MillisecondsNow();
+    auto result = fence.WaitFor(target, WaitTimeoutMs);
+
+    if (!result)
+    {
+        // Reusing the slot before D3D12 is done with it would corrupt the command lists, keep waiting
+        _stats.WaitTimeouts++;
+        LOG_WARN("D3D12 queue didn't reach {} in {} ms, completed: {}", target, WaitTimeoutMs,
+                 fence.CompletedValue());
+
+        result = fence.WaitFor(target, IVkwDx12Fence::NoTimeout);
+    }
+
+    auto elapsed = Util::MillisecondsNow() - start;
+
+    _stats.Waits++;
+    _stats.WaitMs += elapsed;
+    _stats.LastWaitMs = elapsed;
+    _stats.MaxWaitMs = std::max(_stats.MaxWaitMs, elapsed);
+
+    LOG_DEBUG("Waited {:.3f} ms for fence value {}", elapsed, target);
+
+    return result;
+}
+
+bool VkwDx12Pipeline::CanElide(VkwDx12Input input, const VkwDx12InputKey& key) const
+{
+    if (!_elideStaticInputs || (input != VkwDx12Input::Exposure && input != VkwDx12Input::ReactiveMask))
+        return false;
+
+    // Input must be copied in the previous frame, it might be changed while missing
+    auto& state = _inputs[(size_t) input];
+    return state.Frame != 0 && state.Frame + 1 == _frame && state.Key == key;
+}
+
+void VkwDx12Pipeline::Record(VkwDx12Input input, const VkwDx12InputKey& key, bool elided)
+{
+    auto& state = _inputs[(size_t) input];
+    state.Key = key;
+    state.Frame = _frame;
+
+    if (elided)
+        _stats.CopiesElided++;
+    else
+        _stats.Copies++;
+}
+
+void VkwDx12Pipeline::Invalidate() { _inputs = {}; }
@@ -0,0 +1,98 @@
+#pragma once
+#include "SysUtils.h"
+
+#include <array>
+
+// Completion side of the D3D12 queue. Kept behind an interface so
+// the pacing can be driven by a fake fence without a device
+class IVkwDx12Fence
+{
+  public:
+    static constexpr uint32_t NoTimeout = UINT32_MAX;
+
+    virtual ~IVkwDx12Fence() = default;
+
+    virtual uint64_t CompletedValue() = 0;
+
+    // Returns false when value is not reached in timeoutMs
+    virtual bool WaitFor(uint64_t value, uint32_t timeoutMs) = 0;
+};
+
+enum class VkwDx12Input : uint8_t
+{
+    Color,
+    MotionVectors,
+    Depth,
+    Exposure,
+    ReactiveMask,
+    Count,
+};
+
+// Identity of a Vulkan input, contents can't be compared on the CPU
+struct VkwDx12InputKey
+{
+    uint64_t Image = 0;
+    uint64_t View = 0;
+    uint32_t Width = 0;
+    uint32_t Height = 0;
+    uint32_t Format = 0;
+
+    bool operator==(const VkwDx12InputKey& other) const = default;
+};
+
+struct VkwDx12PipelineStats
+{
+    uint64_t Frames = 0;
+    uint64_t Copies = 0;
+    uint64_t CopiesElided = 0;
+    uint64_t Waits = 0;        // Frames the CPU had to wait for a free ring slot
+    uint64_t WaitTimeouts = 0; // Waits longer than WaitTimeoutMs
+    double WaitMs = 0.0;       // Total
+    double LastWaitMs = 0.0;
+    double MaxWaitMs = 0.0;
+};
+
+// Frame scheduling and copy elision of the Vulkan with Dx12 bridge.
+// Frame N reuses the command allocators & buffers of frame N - ringSize, so the CPU only waits
+// when D3D12 is a full ring behind instead of waiting for the previous frame every time.
+// Shared images are ordered on the GPU by the semaphores between the Vulkan and D3D12 queues.
+// Exposure and reactive mask copies can be skipped while the game keeps passing the same image,
+// this is opt-in because a game can update the contents of the same image every frame.
+class VkwDx12Pipeline
+{
+  public:
+    static constexpr uint32_t WaitTimeoutMs = 1000;
+
+    void BeginFrame(bool elideStaticInputs);
+
+    // Blocks until the slot of frame is free. Fence value of a frame is FenceValue(frame),
+    // the fence starts at 0 so the first frame can't signal 0
+    bool AcquireSlot(IVkwDx12Fence& fence, uint64_t frame, uint32_t ringSize);
+
+    static uint64_t FenceValue(uint64_t frame) { return frame + 1; }
+
+    // Frames which fail before submit never signal, waits are capped to the last submitted one
+    void Submitted(uint64_t fenceValue) { _lastSubmitted = fenceValue; }
+
+    // Shared image still has the contents of the same source from the previous frame
+    bool CanElide(VkwDx12Input input, const VkwDx12InputKey& key) const;
+    void Record(VkwDx12Input input, const VkwDx12InputKey& key, bool elided);
+
+    // Shared images are recreated, all of them need a copy
+    void Invalidate();
+
+    const VkwDx12PipelineStats& Stats() const { return _stats; }
+
+  private:
+    struct InputState
+    {
+        VkwDx12InputKey Key {};
+        uint64_t Frame = 0; // Frame of the last record, 0 is never recorded
+    };
+
+    std::array<InputState, (size_t) VkwDx12Input::Count> _inputs {};
+    uint64_t _frame = 0;
+    uint64_t _lastSubmitted = 0;
+    bool _elideStaticInputs = false;
+    VkwDx12PipelineStats _stats {};
+};
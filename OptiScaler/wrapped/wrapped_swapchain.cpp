@@ -11,6 +11,10 @@
 #include <menu/menu_overlay_dx.h>
 
 #include <misc/FrameLimit.h>
+#include <misc/PresentProfiler.h>
+#include <misc/VramRegistry.h>
+#include <misc/DynamicResolution.h>
+#include <framegen/ffx/FramePaceAutoTune.h>
 #include <upscaler_time/UpscalerTime_Dx11.h>
 #include <upscaler_time/UpscalerTime_Dx12.h>
 
@@ -46,6 +50,7 @@ static HRESULT LocalPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT
     HRESULT presentResult;
 
     auto willPresent = (Flags & DXGI_PRESENT_TEST) == 0;
+    PresentProfiler::ScopedFrame profilerFrame(willPresent);
 
     if (willPresent)
     {
@@ -119,16 +124,23 @@ static HRESULT LocalPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT
     }
 
     auto fg = State::Instance().currentFG;
-    if (willPresent && fg != nullptr)
-        ReflexHooks::update(fg->IsActive(), false);
-    else
-        ReflexHooks::update(false, false);
 
-    XellHooks::update();
+    {
+        PresentProfiler::ScopedPhase phase(PresentPhase::ReflexUpdate);
+
+        if (willPresent && fg != nullptr)
+            ReflexHooks::update(fg->IsActive(), false);
+        else
+            ReflexHooks::update(false, false);
+
+        XellHooks::update();
+    }
 
     // Upscaler GPU time computation
     if (willPresent && (fg == nullptr || !fg->IsActive() || fg->IsPaused()))
     {
+        PresentProfiler::ScopedPhase phase(PresentPhase::ReadUpscalerTime);
+
         if (cq != nullptr)
         {
             UpscalerTimeDx12::ReadUpscalingTime(cq);
@@ -177,10 +189,14 @@ static HRESULT LocalPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT
     // DXVK check, it's here because of upscaler time calculations
     if (IdentifyGpu::getPrimaryGpu().usesDxvk)
     {
-        if (pPresentParameters == nullptr)
-            presentResult = pSwapChain->Present(SyncInterval, Flags);
-        else
-            presentResult = ((IDXGISwapChain1*) pSwapChain)->Present1(SyncInterval, Flags, pPresentParameters);
+        {
+            PresentProfiler::ScopedPhase phase(PresentPhase::Present);
+
+            if (pPresentParameters == nullptr)
+                presentResult = pSwapChain->Present(SyncInterval, Flags);
+            else
+                presentResult = ((IDXGISwapChain1*) pSwapChain)->Present1(SyncInterval, Flags, pPresentParameters);
+        }
 
         if (presentResult == S_OK)
         {
@@ -214,7 +230,12 @@ static HRESULT LocalPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT
             currentFeature->TickFrozenCheck();
 
         // Draw overlay
-        MenuOverlayDx::Present(pSwapChain, SyncInterval, Flags, pPresentParameters, pDevice, hWnd, isUWP);
+        {
+            PresentProfiler::ScopedPhase phase(PresentPhase::Overlay);
+            MenuOverlayDx::Present(pSwapChain, SyncInterval, Flags, pPresentParameters, pDevice, hWnd, isUWP);
+        }
+
+        bool isInterpolated = false;
 
         if (State::Instance().activeFgOutput == FGOutput::FSRFG || State::Instance().activeFgOutput == FGOutput::XeFG)
         {
@@ -229,22 +250,38 @@ static HRESULT LocalPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT
                 fgPresentFrame = _frameCounter;
             }
 
-            auto isInterpolated = fgIsActive && (_frameCounter - fgPresentFrame) > 0;
+            isInterpolated = fgIsActive && (_frameCounter - fgPresentFrame) > 0;
 
             fakenvapi::reportFGPresent(pSwapChain, fgIsActive, isInterpolated);
+
+            if (State::Instance().activeFgOutput == FGOutput::FSRFG)
+                FramePaceAutoTune::OnPresent(isInterpolated, fgIsActive);
         }
 
         _frameCounter++;
         State::Instance().frameCount = _frameCounter;
+
+        if (device12 != nullptr)
+        {
+            VramRegistry::Instance().OnPresent(_frameCounter, device12->GetAdapterLuid());
+            D3D12Hooks::UpdateSamplers();
+        }
+
+        DynamicResolution::OnPresent(isInterpolated);
+        Config::Instance()->ApplyIniChanges();
     }
 
     LOG_DEBUG("Calling original present");
 
     // swapchain present
-    if (pPresentParameters == nullptr)
-        presentResult = pSwapChain->Present(SyncInterval, Flags);
-    else
-        presentResult = ((IDXGISwapChain1*) pSwapChain)->Present1(SyncInterval, Flags, pPresentParameters);
+    {
+        PresentProfiler::ScopedPhase phase(PresentPhase::Present);
+
+        if (pPresentParameters == nullptr)
+            presentResult = pSwapChain->Present(SyncInterval, Flags);
+        else
+            presentResult = ((IDXGISwapChain1*) pSwapChain)->Present1(SyncInterval, Flags, pPresentParameters);
+    }
 
     LOG_DEBUG("Original present result: {:X}", (UINT) presentResult);
 
@@ -404,6 +441,9 @@ ULONG STDMETHODCALLTYPE WrappedIDXGISwapChain4::Release()
 
         MenuOverlayDx::CleanupRenderTarget(true, _handle);
 
+        // Game might exit without closing the window, don't leave the write to DLL detach
+        Config::Instance()->FlushSave();
+
         if (State::Instance().currentSwapchain == this)
             State::Instance().currentSwapchain = nullptr;
 
@@ -469,12 +509,18 @@ HRESULT STDMETHODCALLTYPE WrappedIDXGISwapChain4::Present(UINT SyncInterval, UIN
 
     if ((Flags & DXGI_PRESENT_TEST) == 0)
     {
+        // Opened here so the limiter sleep after LocalPresent lands in the same record
+        PresentProfiler::ScopedFrame profilerFrame(true);
+
         result = LocalPresent(_real, SyncInterval, Flags, nullptr, _device, _handle, _uwp);
 
         // When Reflex can't be used to limit, sleep in present
         if (!State::Instance().reflexLimitsFps && State::Instance().activeFgOutput == FGOutput::NoFG &&
             !IdentifyGpu::getPrimaryGpu().usesDxvk && !XellHooks::canLimit())
+        {
+            PresentProfiler::ScopedPhase phase(PresentPhase::FrameLimit);
             FrameLimit::sleep(false);
+        }
     }
     else
     {
@@ -759,12 +805,18 @@ HRESULT STDMETHODCALLTYPE WrappedIDXGISwapChain4::Present1(UINT SyncInterval, UI
 
     if ((Flags & DXGI_PRESENT_TEST) == 0)
     {
+        // Opened here so the limiter sleep after LocalPresent lands in the same record
+        PresentProfiler::ScopedFrame profilerFrame(true);
+
         result = LocalPresent(_real1, SyncInterval, Flags, pPresentParameters, _device, _handle, _uwp);
 
         // When Reflex can't be used to limit, sleep in present
         if (!State::Instance().reflexLimitsFps && State::Instance().activeFgOutput == FGOutput::NoFG &&
             !IdentifyGpu::getPrimaryGpu().usesDxvk && !XellHooks::canLimit())
+        {
+            PresentProfiler::ScopedPhase phase(PresentPhase::FrameLimit);
             FrameLimit::sleep(false);
+        }
     }
     else
     {
@@ -0,0 +1,294 @@
+// Checks of BarrierBatch against a command list which records its ResourceBarrier calls: no-op transitions dropped,
+// A->B->C merged into A->C, round trips cancelled, a mismatched before state flushing the batch, the capacity flush
+// and the tracked state overload.
+//
+// Build and run on Linux from this directory, d3d12.h here stands in for the Windows SDK one:
+//   g++ -std=c++20 -O2 -I. -I../../OptiScaler barrier_batch_check.cpp -o check
+//   ./check
+// Exits with 1 and prints the failed checks when something is off.
+
+#include <shaders/Shader_Dx12Barriers.h>
+
+#include <cstdio>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(expr)                                                                                                    \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expr))                                                                                                   \
+        {                                                                                                              \
+            printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #expr);                                                   \
+            failures++;                                                                                                \
+        }                                                                                                              \
+    } while (0)
+
+constexpr auto Common = D3D12_RESOURCE_STATE_COMMON;
+constexpr auto RenderTarget = D3D12_RESOURCE_STATE_RENDER_TARGET;
+constexpr auto UnorderedAccess = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
+constexpr auto ShaderResource = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+constexpr auto CopyDest = D3D12_RESOURCE_STATE_COPY_DEST;
+constexpr auto CopySource = D3D12_RESOURCE_STATE_COPY_SOURCE;
+
+struct Transition
+{
+    ID3D12Resource* Resource;
+    D3D12_RESOURCE_STATES Before;
+    D3D12_RESOURCE_STATES After;
+
+    bool operator==(const Transition&) const = default;
+};
+
+using Call = std::vector<Transition>;
+
+// Keeps every ResourceBarrier call, in order
+class RecordingCommandList : public ID3D12GraphicsCommandList
+{
+  public:
+    std::vector<Call> Calls;
+    bool AllValid = true; // Type, subresource & count of every recorded barrier
+
+    void ResourceBarrier(UINT NumBarriers, const D3D12_RESOURCE_BARRIER* pBarriers) override
+    {
+        AllValid &= NumBarriers > 0 && NumBarriers <= BarrierBatch::Capacity;
+
+        auto& call = Calls.emplace_back();
+
+        for (UINT i = 0; i < NumBarriers; i++)
+        {
+            auto& barrier = pBarriers[i];
+            AllValid &= barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+            AllValid &= barrier.Flags == D3D12_RESOURCE_BARRIER_FLAG_NONE;
+            AllValid &= barrier.Transition.Subresource == D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+            AllValid &= barrier.Transition.StateBefore != barrier.Transition.StateAfter;
+
+            call.push_back(
+                { barrier.Transition.pResource, barrier.Transition.StateBefore, barrier.Transition.StateAfter });
+        }
+    }
+
+    // Out of range calls read as empty, a missing call fails the check instead of crashing it
+    Call At(size_t index) const { return index < Calls.size() ? Calls[index] : Call {}; }
+};
+
+static ID3D12Resource resources[BarrierBatch::Capacity + 4];
+
+static void NoOpDropped()
+{
+    RecordingCommandList cmdList;
+
+    {
+        BarrierBatch barriers(&cmdList);
+        barriers.Transition(&resources[0], ShaderResource, ShaderResource);
+        barriers.Transition(nullptr, ShaderResource, UnorderedAccess);
+        CHECK(barriers.Pending() == 0);
+
+        // Nothing to issue, no empty ResourceBarrier call either
+        barriers.Flush();
+        CHECK(cmdList.Calls.empty());
+
+        // Tracked state without a state is ignored
+        barriers.Transition(&resources[0], nullptr, UnorderedAccess);
+        CHECK(barriers.Pending() == 0);
+
+        // Tracked state already in place, nothing recorded and the state stays
+        auto state = CopyDest;
+        barriers.Transition(&resources[1], &state, CopyDest);
+        CHECK(barriers.Pending() == 0);
+        CHECK(state == CopyDest);
+    }
+
+    // Destructor has nothing to flush
+    CHECK(cmdList.Calls.empty());
+}
+
+static void ChainMerged()
+{
+    RecordingCommandList cmdList;
+
+    {
+        BarrierBatch barriers(&cmdList);
+        barriers.Transition(&resources[0], ShaderResource, CopyDest);
+        barriers.Transition(&resources[1], Common, RenderTarget);
+        barriers.Transition(&resources[0], CopyDest, UnorderedAccess);
+        CHECK(barriers.Pending() == 2);
+
+        // Still one entry after a third step, it keeps its place in the batch
+        barriers.Transition(&resources[0], UnorderedAccess, CopySource);
+        CHECK(barriers.Pending() == 2);
+        CHECK(cmdList.Calls.empty());
+
+        barriers.Flush();
+        CHECK(barriers.Pending() == 0);
+    }
+
+    CHECK(cmdList.Calls.size() == 1);
+    CHECK(cmdList.At(0) ==
+          (Call { { &resources[0], ShaderResource, CopySource }, { &resources[1], Common, RenderTarget } }));
+    CHECK(cmdList.AllValid);
+
+    // Tracked state overload merges the same way and leaves the final state
+    RecordingCommandList tracked;
+    auto state = ShaderResource;
+
+    {
+        BarrierBatch barriers(&tracked);
+        barriers.Transition(&resources[2], &state, CopyDest);
+        CHECK(state == CopyDest);
+        barriers.Transition(&resources[2], &state, UnorderedAccess);
+        CHECK(state == UnorderedAccess);
+        CHECK(barriers.Pending() == 1);
+    }
+
+    CHECK(tracked.Calls.size() == 1);
+    CHECK(tracked.At(0) == (Call { { &resources[2], ShaderResource, UnorderedAccess } }));
+}
+
+static void RoundTripCancelled()
+{
+    RecordingCommandList cmdList;
+
+    {
+        BarrierBatch barriers(&cmdList);
+        barriers.Transition(&resources[0], ShaderResource, CopySource);
+        barriers.Transition(&resources[1], RenderTarget, ShaderResource);
+        barriers.Transition(&resources[2], Common, CopyDest);
+
+        // Back where it started, removed without disturbing the order of the others
+        barriers.Transition(&resources[0], CopySource, ShaderResource);
+        CHECK(barriers.Pending() == 2);
+
+        // Longer loop cancels too
+        barriers.Transition(&resources[1], ShaderResource, UnorderedAccess);
+        barriers.Transition(&resources[1], UnorderedAccess, RenderTarget);
+        CHECK(barriers.Pending() == 1);
+
+        // Resource can start a new entry after its round trip
+        barriers.Transition(&resources[0], ShaderResource, UnorderedAccess);
+        CHECK(barriers.Pending() == 2);
+    }
+
+    CHECK(cmdList.Calls.size() == 1);
+    CHECK(cmdList.At(0) ==
+          (Call { { &resources[2], Common, CopyDest }, { &resources[0], ShaderResource, UnorderedAccess } }));
+
+    // Cancelling the first of several keeps the rest in recording order
+    RecordingCommandList ordered;
+
+    {
+        BarrierBatch barriers(&ordered);
+
+        for (UINT i = 0; i < 4; i++)
+            barriers.Transition(&resources[i], Common, CopyDest);
+
+        barriers.Transition(&resources[0], CopyDest, Common);
+    }
+
+    CHECK(ordered.At(0) == (Call { { &resources[1], Common, CopyDest },
+                                   { &resources[2], Common, CopyDest },
+                                   { &resources[3], Common, CopyDest } }));
+
+    // Everything cancelled, no call at all
+    RecordingCommandList cancelled;
+
+    {
+        BarrierBatch barriers(&cancelled);
+        barriers.Transition(&resources[0], ShaderResource, UnorderedAccess);
+        barriers.Transition(&resources[0], UnorderedAccess, ShaderResource);
+        CHECK(barriers.Pending() == 0);
+    }
+
+    CHECK(cancelled.Calls.empty());
+}
+
+static void MismatchedBeforeFlushes()
+{
+    RecordingCommandList cmdList;
+
+    {
+        BarrierBatch barriers(&cmdList);
+        barriers.Transition(&resources[0], ShaderResource, CopyDest);
+        barriers.Transition(&resources[1], Common, RenderTarget);
+
+        // Caller thinks resource 0 is in copy source, both transitions go out in the given order
+        barriers.Transition(&resources[0], CopySource, UnorderedAccess);
+        CHECK(cmdList.Calls.size() == 1);
+        CHECK(barriers.Pending() == 1);
+        CHECK(cmdList.At(0) ==
+              (Call { { &resources[0], ShaderResource, CopyDest }, { &resources[1], Common, RenderTarget } }));
+
+        // Pending one merges with the following transitions again
+        barriers.Transition(&resources[0], UnorderedAccess, ShaderResource);
+        CHECK(barriers.Pending() == 1);
+    }
+
+    CHECK(cmdList.Calls.size() == 2);
+    CHECK(cmdList.At(1) == (Call { { &resources[0], CopySource, ShaderResource } }));
+    CHECK(cmdList.AllValid);
+}
+
+static void CapacityFlushes()
+{
+    RecordingCommandList cmdList;
+    Call expected;
+
+    {
+        BarrierBatch barriers(&cmdList);
+
+        for (UINT i = 0; i < BarrierBatch::Capacity; i++)
+        {
+            barriers.Transition(&resources[i], ShaderResource, UnorderedAccess);
+            expected.push_back({ &resources[i], ShaderResource, UnorderedAccess });
+        }
+
+        CHECK(barriers.Pending() == BarrierBatch::Capacity);
+        CHECK(cmdList.Calls.empty());
+
+        // Merging into a full batch needs no room
+        barriers.Transition(&resources[0], UnorderedAccess, CopyDest);
+        expected[0].After = CopyDest;
+        CHECK(cmdList.Calls.empty());
+
+        // New resource doesn't fit, the full batch goes out first
+        barriers.Transition(&resources[BarrierBatch::Capacity], Common, CopySource);
+        CHECK(cmdList.Calls.size() == 1);
+        CHECK(cmdList.At(0) == expected);
+        CHECK(barriers.Pending() == 1);
+
+        barriers.Transition(&resources[BarrierBatch::Capacity + 1], Common, CopyDest);
+    }
+
+    CHECK(cmdList.Calls.size() == 2);
+    CHECK(cmdList.At(1) == (Call { { &resources[BarrierBatch::Capacity], Common, CopySource },
+                                   { &resources[BarrierBatch::Capacity + 1], Common, CopyDest } }));
+    CHECK(cmdList.AllValid);
+}
+
+static void SingleTransition()
+{
+    RecordingCommandList cmdList;
+
+    ResourceTransition(&cmdList, &resources[0], RenderTarget, ShaderResource);
+    CHECK(cmdList.Calls.size() == 1);
+    CHECK(cmdList.At(0) == (Call { { &resources[0], RenderTarget, ShaderResource } }));
+
+    ResourceTransition(&cmdList, &resources[0], ShaderResource, ShaderResource);
+    CHECK(cmdList.Calls.size() == 1);
+    CHECK(cmdList.AllValid);
+}
+
+int main()
+{
+    NoOpDropped();
+    ChainMerged();
+    RoundTripCancelled();
+    MismatchedBeforeFlushes();
+    CapacityFlushes();
+    SingleTransition();
+
+    if (failures == 0)
+        printf("All checks passed\n");
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+// Linux stand-in for the parts of CSimpleIniA which ConfigIni uses.
+// Keeps sections & keys in file order, comments are dropped.
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <strings.h>
+
+enum SI_Error
+{
+    SI_OK = 0,
+    SI_FAIL = -1,
+    SI_FILE = -3,
+};
+
+class CSimpleIniA
+{
+  public:
+    void Reset() { _sections.clear(); }
+
+    SI_Error LoadData(const std::string& data)
+    {
+        std::istringstream in(data);
+        std::string line;
+        Section* current = nullptr;
+
+        while (std::getline(in, line))
+        {
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+
+            if (line.empty() || line[0] == ';' || line[0] == '#')
+                continue;
+
+            if (line[0] == '[')
+            {
+                current = &Get(line.substr(1, line.find(']') - 1).c_str());
+                continue;
+            }
+
+            auto equals = line.find('=');
+            if (equals == std::string::npos || current == nullptr)
+                continue;
+
+            // CSimpleIniA trims keys & values
+            SetValue(current->Name.c_str(), Trim(line.substr(0, equals)).c_str(),
+                     Trim(line.substr(equals + 1)).c_str());
+        }
+
+        return SI_OK;
+    }
+
+    static std::string Trim(const std::string& text)
+    {
+        auto first = text.find_first_not_of(" \t");
+
+        if (first == std::string::npos)
+            return {};
+
+        return text.substr(first, text.find_last_not_of(" \t") - first + 1);
+    }
+
+    SI_Error LoadFile(const char* path)
+    {
+        std::ifstream file(path, std::ios::binary);
+
+        if (!file)
+            return SI_FILE;
+
+        std::stringstream data;
+        data << file.rdbuf();
+        return LoadData(data.str());
+    }
+
+    SI_Error SaveFile(const char* path) const
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+        if (!file)
+            return SI_FILE;
+
+        file << Text();
+        return file ? SI_OK : SI_FILE;
+    }
+
+    std::string Text() const
+    {
+        std::string text;
+
+        for (const auto& section : _sections)
+        {
+            text += "[" + section.Name + "]\n";
+
+            for (const auto& [key, value] : section.Keys)
+                text += key + "=" + value + "\n";
+
+            text += "\n";
+        }
+
+        return text;
+    }
+
+    const char* GetValue(const char* section, const char* key, const char* defaultValue) const
+    {
+        for (const auto& s : _sections)
+        {
+            if (strcasecmp(s.Name.c_str(), section) != 0)
+                continue;
+
+            for (const auto& [k, v] : s.Keys)
+            {
+                if (strcasecmp(k.c_str(), key) == 0)
+                    return v.c_str();
+            }
+        }
+
+        return defaultValue;
+    }
+
+    void SetValue(const char* section, const char* key, const char* value)
+    {
+        auto& s = Get(section);
+
+        for (auto& [k, v] : s.Keys)
+        {
+            if (strcasecmp(k.c_str(), key) == 0)
+            {
+                v = value;
+                return;
+            }
+        }
+
+        s.Keys.push_back({ key, value });
+    }
+
+  private:
+    struct Section
+    {
+        std::string Name;
+        std::vector<std::pair<std::string, std::string>> Keys;
+    };
+
+    Section& Get(const char* name)
+    {
+        for (auto& s : _sections)
+        {
+            if (strcasecmp(s.Name.c_str(), name) == 0)
+                return s;
+        }
+
+        _sections.push_back({ name, {} });
+        return _sections.back();
+    }
+
+    std::vector<Section> _sections;
+};
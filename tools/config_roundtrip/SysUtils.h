@@ -0,0 +1,12 @@
+#pragma once
+
+// Linux stand-in for OptiScaler/SysUtils.h, just enough for ConfigSchema.h and ConfigIni.h
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+inline std::string wstring_to_string(const std::wstring& text) { return std::string(text.begin(), text.end()); }
+inline std::wstring string_to_wstring(const std::string& text) { return std::wstring(text.begin(), text.end()); }
+
+#define LOG_DEBUG(...) ((void) 0)
@@ -0,0 +1,478 @@
+// Round trip checks of the ini handling: load -> save of changed values -> load again.
+// Uses the option table & ConfigIni the same way Config.cpp does, with a small schema of its own.
+// Also times a full parse of the shipped OptiScaler.ini through the real option table, which is rebuilt here from
+// Config::BuildSchema and the member types in Config.h.
+//
+// Build and run on Linux from this directory, the local headers stand in for the Windows ones:
+//   g++ -std=c++20 -O2 -I. -I../../OptiScaler config_roundtrip.cpp -o check
+//   ./check [parses]
+// Exits with 1 and prints the failed checks when something is off.
+
+#include <ConfigIni.h>
+#include <ConfigSchema.h>
+#include <CustomOptional.h>
+
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(expr)                                                                                                    \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expr))                                                                                                   \
+        {                                                                                                              \
+            printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #expr);                                                   \
+            failures++;                                                                                                \
+        }                                                                                                              \
+    } while (0)
+
+static const char* BaseIni = "[CAS]\n"
+                             "Enabled=true\n"
+                             "Sharpness=0.50\n"
+                             "Contrast=auto\n"
+                             "\n"
+                             "[Menu]\n"
+                             "ShowFps=auto\n"
+                             "FpsOverlayPos=2\n"
+                             "TTFFontPath=auto\n";
+
+// Same flow as Config: members, option table, snapshot after load, changed values on save
+struct TestConfig
+{
+    CustomOptional<bool> Enabled { false };
+    CustomOptional<float> Sharpness { 0.4f };
+    CustomOptional<float> Contrast { -0.3f };
+    CustomOptional<bool> ShowFps { false };
+    CustomOptional<int> FpsOverlayPos { 0 };
+    CustomOptional<std::wstring, NoDefault> TTFFontPath;
+
+    std::vector<ConfigOption> Schema {
+        { "CAS", "Enabled", Enabled },
+        { "CAS", "Sharpness", Sharpness, 0.0f, 1.3f },
+        { "CAS", "Contrast", Contrast, -2.0f, 2.0f, ConfigFlags_Hot },
+        { "Menu", "ShowFps", ShowFps, ConfigFlags_Hot },
+        { "Menu", "FpsOverlayPos", FpsOverlayPos },
+        { "Menu", "TTFFontPath", TTFFontPath },
+    };
+
+    ConfigIni Ini;
+
+    bool Load(const std::filesystem::path& path)
+    {
+        if (!Ini.LoadFile(path))
+            return false;
+
+        for (const auto& option : Schema)
+            option.Load(Ini.GetValue(option.Section(), option.Key(), "auto"));
+
+        Ini.ClearSaved();
+
+        for (const auto& option : Schema)
+            Ini.SetSaved(option.Section(), option.Key(), option.Text());
+
+        return true;
+    }
+
+    // Returns the number of changed values
+    int Write()
+    {
+        int changed = 0;
+
+        for (const auto& option : Schema)
+        {
+            if (Ini.Set(option.Section(), option.Key(), option.Text()))
+                changed++;
+        }
+
+        return changed;
+    }
+};
+
+static std::filesystem::path TempFile(const char* name)
+{
+    return std::filesystem::temp_directory_path() / name;
+}
+
+static void WriteFile(const std::filesystem::path& path, const std::string& text)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << text;
+}
+
+static std::string Value(const std::filesystem::path& path, const char* section, const char* key)
+{
+    CSimpleIniA ini;
+    ini.LoadFile(path.c_str());
+    return ini.GetValue(section, key, "missing");
+}
+
+static void Unchanged()
+{
+    auto path = TempFile("opti_roundtrip_unchanged.ini");
+    WriteFile(path, BaseIni);
+
+    TestConfig config;
+    CHECK(config.Load(path));
+    CHECK(config.Enabled.value_or_default());
+    CHECK(config.Sharpness.value_or_default() == 0.5f);
+    CHECK(config.FpsOverlayPos.value_or_default() == 2);
+    CHECK(!config.Contrast.has_value());
+
+    // Loaded values are the saved ones, even when the text differs ("0.50" vs "0.500000")
+    CHECK(config.Write() == 0);
+    CHECK(config.Ini.Unsaved() == 0);
+}
+
+static void ChangedValue()
+{
+    auto path = TempFile("opti_roundtrip_changed.ini");
+    WriteFile(path, BaseIni);
+
+    TestConfig config;
+    CHECK(config.Load(path));
+
+    config.ShowFps = true;
+    CHECK(config.Write() == 1);
+    CHECK(config.Ini.IsUnsaved("Menu", "ShowFps"));
+    CHECK(config.Ini.SaveFile(path));
+    CHECK(config.Ini.Unsaved() == 0);
+
+    // Only the changed key is rewritten, others keep their text
+    CHECK(Value(path, "Menu", "ShowFps") == "true");
+    CHECK(Value(path, "CAS", "Sharpness") == "0.50");
+    CHECK(Value(path, "Menu", "TTFFontPath") == "auto");
+
+    TestConfig reloaded;
+    CHECK(reloaded.Load(path));
+    CHECK(reloaded.ShowFps.value_or_default());
+    CHECK(reloaded.Write() == 0);
+
+    // Back to the default saves it as auto
+    reloaded.ShowFps = false;
+    CHECK(reloaded.Write() == 1);
+    CHECK(reloaded.Ini.SaveFile(path));
+    CHECK(Value(path, "Menu", "ShowFps") == "auto");
+}
+
+static void ClampedOnLoad()
+{
+    auto path = TempFile("opti_roundtrip_clamped.ini");
+    WriteFile(path, "[CAS]\nSharpness=5.0\nContrast=-9\n");
+
+    TestConfig config;
+    CHECK(config.Load(path));
+    CHECK(config.Sharpness.value_or_default() == 1.3f);
+    CHECK(config.Contrast.value_or_default() == -2.0f);
+
+    // Range & member lookup used by the menu widgets
+    const ConfigOption* sharpness = nullptr;
+    for (const auto& option : config.Schema)
+    {
+        if (option.Member() == &config.Sharpness)
+            sharpness = &option;
+    }
+
+    CHECK(sharpness != nullptr);
+    CHECK(sharpness != nullptr && sharpness->Range().has_value());
+    CHECK(sharpness != nullptr && sharpness->Range()->second == 1.3f);
+    CHECK(!config.Schema[0].Range().has_value());
+}
+
+static void ReloadKeepsUnsaved()
+{
+    auto path = TempFile("opti_roundtrip_reload.ini");
+    WriteFile(path, BaseIni);
+
+    TestConfig config;
+    CHECK(config.Load(path));
+
+    // Menu change waiting for the delayed save
+    config.ShowFps = true;
+    CHECK(config.Write() == 1);
+
+    // File edited meanwhile: other key changed and the same key set to something else
+    std::string edited = BaseIni;
+    edited.replace(edited.find("FpsOverlayPos=2"), 15, "FpsOverlayPos=3");
+    edited.replace(edited.find("ShowFps=auto"), 12, "ShowFps=false");
+    WriteFile(path, edited);
+
+    CHECK(config.Ini.LoadData(edited));
+    CHECK(config.Ini.IsUnsaved("Menu", "ShowFps"));
+    CHECK(std::string(config.Ini.GetValue("Menu", "ShowFps", "")) == "true");
+    CHECK(std::string(config.Ini.GetValue("Menu", "FpsOverlayPos", "")) == "3");
+
+    // Full reload from file, the queued change survives the snapshot
+    CHECK(config.Load(path));
+    CHECK(config.Ini.IsUnsaved("Menu", "ShowFps"));
+    CHECK(config.Write() == 0);
+
+    CHECK(config.Ini.SaveFile(path));
+    CHECK(Value(path, "Menu", "ShowFps") == "true");
+    CHECK(Value(path, "Menu", "FpsOverlayPos") == "3");
+    CHECK(Value(path, "CAS", "Sharpness") == "0.50");
+}
+
+static void NotAppliedEditSurvivesSave()
+{
+    auto path = TempFile("opti_roundtrip_notapplied.ini");
+    WriteFile(path, BaseIni);
+
+    TestConfig config;
+    CHECK(config.Load(path));
+
+    // FpsOverlayPos is not hot, the edit is only used after restart but must not be overwritten
+    std::string edited = BaseIni;
+    edited.replace(edited.find("FpsOverlayPos=2"), 15, "FpsOverlayPos=1");
+    WriteFile(path, edited);
+    CHECK(config.Ini.LoadData(edited));
+
+    config.Enabled = false;
+    CHECK(config.Write() == 1);
+    CHECK(config.Ini.SaveFile(path));
+    CHECK(Value(path, "Menu", "FpsOverlayPos") == "1");
+    CHECK(Value(path, "CAS", "Enabled") == "auto");
+}
+
+static void FailedSave()
+{
+    auto path = TempFile("opti_roundtrip_failed.ini");
+    WriteFile(path, BaseIni);
+
+    TestConfig config;
+    CHECK(config.Load(path));
+
+    config.Sharpness = 0.8f;
+    CHECK(config.Write() == 1);
+
+    // A directory can't be opened for writing
+    auto directory = TempFile("opti_roundtrip_dir");
+    std::filesystem::create_directories(directory);
+    CHECK(!config.Ini.SaveFile(directory));
+    CHECK(config.Ini.Unsaved() == 1);
+
+    // Nothing changed since, the value is still written by the next save
+    CHECK(config.Write() == 0);
+    CHECK(config.Ini.SaveFile(path));
+    CHECK(config.Ini.Unsaved() == 0);
+    CHECK(Value(path, "CAS", "Sharpness").starts_with("0.8"));
+
+    TestConfig reloaded;
+    CHECK(reloaded.Load(path));
+    CHECK(reloaded.Sharpness.value_or_default() == 0.8f);
+    CHECK(reloaded.Write() == 0);
+}
+
+static std::string ReadFile(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::stringstream text;
+    text << file.rdbuf();
+    return text.str();
+}
+
+// Config::BuildSchema as data, members are stand-ins of the same type as the real ones
+struct FullSchema
+{
+    std::deque<CustomOptional<bool, NoDefault>> Bools;
+    std::deque<CustomOptional<int, NoDefault>> Ints;
+    std::deque<CustomOptional<uint32_t, NoDefault>> Uints;
+    std::deque<CustomOptional<float, NoDefault>> Floats;
+    std::deque<CustomOptional<std::string, NoDefault>> Strings;
+    std::deque<CustomOptional<std::wstring, NoDefault>> WStrings;
+
+    // ConfigOption keeps the section & key pointers
+    std::deque<std::string> Names;
+
+    std::vector<ConfigOption> Schema;
+    size_t Entries = 0;
+    std::vector<std::string> Unresolved;
+
+    template <typename O>
+    void Add(std::deque<O>& members, const std::string& section, const std::string& key, const std::string& min,
+             const std::string& max, uint32_t flags)
+    {
+        using T = typename O::value_type;
+
+        auto& member = members.emplace_back();
+        auto sectionName = Names.emplace_back(section).c_str();
+        auto keyName = Names.emplace_back(key).c_str();
+
+        if (min.empty())
+            Schema.emplace_back(sectionName, keyName, member, flags);
+        else if constexpr (std::is_arithmetic_v<T>)
+            Schema.emplace_back(sectionName, keyName, member, (T) std::stof(min), (T) std::stof(max), flags);
+    }
+
+    bool Build(const std::filesystem::path& sourceDir)
+    {
+        auto header = ReadFile(sourceDir / "Config.h");
+        auto source = ReadFile(sourceDir / "Config.cpp");
+
+        std::map<std::string, std::string> types;
+        std::regex memberRe(R"(CustomOptional<([\w:]+)(?:, \w+)?>\s+(\w+))");
+
+        for (std::sregex_iterator it(header.begin(), header.end(), memberRe), end; it != end; ++it)
+            types[(*it)[2]] = (*it)[1];
+
+        auto begin = source.find("void Config::BuildSchema()");
+        auto finish = source.find("};", begin);
+
+        if (begin == std::string::npos || finish == std::string::npos)
+            return false;
+
+        auto table = source.substr(begin, finish - begin);
+        std::regex entryRe(R"re(\{ "([^"]+)", "([^"]+)", (\w+)([^}]*)\})re");
+        std::regex rangeRe(R"(^, ([-\d.]+)f?, ([-\d.]+)f?)");
+        std::regex flagRe(R"(ConfigFlags_(\w+))");
+
+        for (std::sregex_iterator it(table.begin(), table.end(), entryRe), end; it != end; ++it)
+        {
+            std::string section = (*it)[1], key = (*it)[2], member = (*it)[3], rest = (*it)[4], min, max;
+            uint32_t flags = ConfigFlags_None;
+
+            if (std::smatch range; std::regex_search(rest, range, rangeRe))
+            {
+                min = range[1];
+                max = range[2];
+            }
+
+            for (std::sregex_iterator f(rest.begin(), rest.end(), flagRe); f != end; ++f)
+            {
+                if ((*f)[1] == "Hot")
+                    flags |= ConfigFlags_Hot;
+                else if ((*f)[1] == "Lowercase")
+                    flags |= ConfigFlags_Lowercase;
+            }
+
+            auto type = types.contains(member) ? types[member] : "";
+            Entries++;
+
+            if (type == "bool")
+                Add(Bools, section, key, min, max, flags);
+            else if (type == "int" || type == "int32_t")
+                Add(Ints, section, key, min, max, flags);
+            else if (type == "uint32_t" || type == "UINT")
+                Add(Uints, section, key, min, max, flags);
+            else if (type == "float")
+                Add(Floats, section, key, min, max, flags);
+            else if (type == "std::string")
+                Add(Strings, section, key, min, max, flags);
+            else if (type == "std::wstring")
+                Add(WStrings, section, key, min, max, flags);
+            else
+                Unresolved.push_back(member + " (" + type + ")");
+        }
+
+        return true;
+    }
+};
+
+static size_t CountEntries(const std::filesystem::path& source)
+{
+    auto text = ReadFile(source);
+    auto begin = text.find("void Config::BuildSchema()");
+    auto finish = text.find("};", begin);
+    size_t count = 0;
+
+    for (auto pos = text.find("{ \"", begin); pos < finish; pos = text.find("{ \"", pos + 1))
+        count++;
+
+    return count;
+}
+
+// Same work as the start of Config::Reload, ini parse then every option of the table
+static void FullIniParse(size_t parses)
+{
+    auto sourceDir = std::filesystem::path("../../OptiScaler");
+    auto iniText = ReadFile("../../OptiScaler.ini");
+    CHECK(!iniText.empty());
+
+    FullSchema full;
+    CHECK(full.Build(sourceDir));
+
+    // Every table entry must be picked up, otherwise the timing is for a smaller table
+    CHECK(full.Entries > 0);
+    CHECK(full.Entries == CountEntries(sourceDir / "Config.cpp"));
+    CHECK(full.Schema.size() == full.Entries);
+
+    for (const auto& member : full.Unresolved)
+        printf("Unresolved member type: %s\n", member.c_str());
+
+    // Shipped ini has every key of the table and all of them parse
+    ConfigIni ini;
+    CHECK(ini.LoadData(iniText));
+
+    size_t missing = 0;
+    size_t invalid = 0;
+
+    for (const auto& option : full.Schema)
+    {
+        auto value = ini.GetValue(option.Section(), option.Key(), nullptr);
+
+        if (value == nullptr)
+        {
+            printf("Missing in OptiScaler.ini: %s.%s\n", option.Section(), option.Key());
+            missing++;
+        }
+        else if (!option.Load(value))
+        {
+            printf("Invalid in OptiScaler.ini: %s.%s = %s\n", option.Section(), option.Key(), value);
+            invalid++;
+        }
+    }
+
+    CHECK(missing == 0);
+    CHECK(invalid == 0);
+
+    if (parses == 0)
+        return;
+
+    double iniUs = 0.0;
+    double optionsUs = 0.0;
+
+    for (size_t i = 0; i < parses; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        ConfigIni timed;
+        timed.LoadData(iniText);
+        auto parsed = std::chrono::steady_clock::now();
+
+        for (const auto& option : full.Schema)
+            option.Load(timed.GetValue(option.Section(), option.Key(), "auto"));
+
+        auto loaded = std::chrono::steady_clock::now();
+        iniUs += std::chrono::duration<double, std::micro>(parsed - start).count();
+        optionsUs += std::chrono::duration<double, std::micro>(loaded - parsed).count();
+    }
+
+    printf("OptiScaler.ini, %zu lines, %zu options, %zu parses\n", (size_t) std::ranges::count(iniText, '\n'),
+           full.Schema.size(), parses);
+    printf("%14s %14s %14s\n", "ini us", "options us", "total us");
+    printf("%14.1f %14.1f %14.1f\n", iniUs / parses, optionsUs / parses, (iniUs + optionsUs) / parses);
+}
+
+int main(int argc, char** argv)
+{
+    size_t parses = argc > 1 ? strtoull(argv[1], nullptr, 10) : 200;
+
+    Unchanged();
+    ChangedValue();
+    ClampedOnLoad();
+    ReloadKeepsUnsaved();
+    NotAppliedEditSurvivesSave();
+    FailedSave();
+    FullIniParse(parses);
+
+    if (failures == 0)
+        printf("All checks passed\n");
+
+    return failures == 0 ? 0 : 1;
+}
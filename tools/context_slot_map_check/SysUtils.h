@@ -0,0 +1,5 @@
+#pragma once
+
+// Linux stand-in for OptiScaler/SysUtils.h, ContextSlotMap only needs the fixed width types
+#include <cstddef>
+#include <cstdint>
@@ -0,0 +1,284 @@
+// Checks of ContextSlotMap (generational handles, slot reuse, stable entries, handles minted for XeSS contexts) and a
+// lookup benchmark against the parallel per field maps the inputs used before.
+//
+// Build and run on Linux from this directory:
+//   g++ -std=c++20 -O2 -I. -I../../OptiScaler context_slot_map_check.cpp -o check
+//   ./check [lookups]
+// Exits with 1 and prints the failed checks when something is off.
+// ankerl/unordered_dense.h here maps to std::unordered_map, key lookups are slower than in the real build, the
+// handle lookups don't touch the map at all.
+
+#include <inputs/ContextSlotMap.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <unordered_map>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(expr)                                                                                                    \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expr))                                                                                                   \
+        {                                                                                                              \
+            printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #expr);                                                   \
+            failures++;                                                                                                \
+        }                                                                                                              \
+    } while (0)
+
+// Same shape as the input layer entries
+struct Entry
+{
+    int InitParams[16] {};
+    void* Params = nullptr;
+    void* Handle = nullptr;
+};
+
+using Map = ContextSlotMap<void*, Entry>;
+
+static void* Key(size_t value) { return (void*) (0x10000 + value * 0x40); }
+
+static void Basics()
+{
+    Map map;
+    CHECK(map.Find(Key(1)) == nullptr);
+    CHECK(!map.HandleOf(Key(1)).IsValid());
+    CHECK(map.Get({}) == nullptr);
+
+    auto& first = map.Emplace(Key(1));
+    first.Params = Key(100);
+
+    auto handle = map.HandleOf(Key(1));
+    CHECK(handle.IsValid());
+    CHECK(map.Get(handle) == &first);
+    CHECK(map.Find(Key(1)) == &first);
+    CHECK(map.Contains(Key(1)));
+    CHECK(map.Size() == 1);
+
+    // Default handle never resolves, even with slot 0 in use
+    CHECK(handle.Index == 0);
+    CHECK(map.Get({}) == nullptr);
+    CHECK(map.Get({ 5, handle.Generation }) == nullptr);
+
+    // Emplace of a known key keeps its data
+    auto& again = map.Emplace(Key(1));
+    CHECK(&again == &first);
+    CHECK(again.Params == Key(100));
+    CHECK(map.Size() == 1);
+
+    CHECK(!map.Erase(Key(2)));
+    CHECK(map.Erase(Key(1)));
+    CHECK(!map.Erase(Key(1)));
+    CHECK(map.Size() == 0);
+    CHECK(map.Find(Key(1)) == nullptr);
+}
+
+// Destroyed contexts must not resolve to a newer context reusing their slot
+static void StaleHandles()
+{
+    Map map;
+    map.Emplace(Key(1)).Params = Key(100);
+    map.Emplace(Key(2)).Params = Key(200);
+
+    auto stale = map.HandleOf(Key(1));
+    map.Erase(Key(1));
+    CHECK(map.Get(stale) == nullptr);
+
+    // Freed slot is reused with a new generation and cleared data
+    auto& reused = map.Emplace(Key(3));
+    auto handle = map.HandleOf(Key(3));
+    CHECK(handle.Index == stale.Index);
+    CHECK(handle.Generation != stale.Generation);
+    CHECK(reused.Params == nullptr);
+    CHECK(map.Get(stale) == nullptr);
+    CHECK(map.Get(handle) == &reused);
+
+    // Same key created again gets a new handle too
+    map.Erase(Key(3));
+    map.Emplace(Key(3));
+    CHECK(map.HandleOf(Key(3)) != handle);
+    CHECK(map.Get(handle) == nullptr);
+
+    // Others are untouched
+    CHECK(map.Find(Key(2))->Params == Key(200));
+}
+
+static void StableEntries()
+{
+    Map map;
+    std::vector<Entry*> entries;
+
+    for (size_t i = 0; i < 1000; i++)
+    {
+        auto& entry = map.Emplace(Key(i));
+        entry.Params = Key(i);
+        entries.push_back(&entry);
+    }
+
+    for (size_t i = 0; i < 1000; i += 2)
+        map.Erase(Key(i));
+
+    for (size_t i = 1000; i < 1500; i++)
+        map.Emplace(Key(i));
+
+    bool stable = true;
+
+    for (size_t i = 1; i < 1000 && stable; i += 2)
+        stable = map.Find(Key(i)) == entries[i] && entries[i]->Params == Key(i);
+
+    CHECK(stable);
+    CHECK(map.Size() == 1000);
+}
+
+// XeSS inputs give the game packed handles as context values
+static void MintedHandles()
+{
+    ContextSlotMap<uint64_t, Entry> map;
+
+    ContextSlotHandle packed { 7, 3 };
+    ContextSlotHandle first { 0, 1 };
+    CHECK(ContextSlotHandle::Unpack(packed.Pack()) == packed);
+    CHECK(first.Pack() != 0);
+
+    std::vector<uint64_t> contexts;
+
+    for (int i = 0; i < 4; i++)
+    {
+        auto next = map.NextHandle();
+        auto context = next.Pack();
+        map.Emplace(context);
+
+        CHECK(map.HandleOf(context) == next);
+        CHECK(map.Get(ContextSlotHandle::Unpack(context)) == map.Find(context));
+        contexts.push_back(context);
+    }
+
+    // Next handle after a destroy reuses the slot with a bumped generation, old value stays dead
+    map.Erase(contexts[1]);
+    auto next = map.NextHandle();
+    CHECK(next.Index == ContextSlotHandle::Unpack(contexts[1]).Index);
+    CHECK(next.Pack() != contexts[1]);
+
+    map.Emplace(next.Pack());
+    CHECK(map.HandleOf(next.Pack()) == next);
+    CHECK(map.Get(ContextSlotHandle::Unpack(contexts[1])) == nullptr);
+    CHECK(map.Get(next) != nullptr);
+
+    // Garbage from the game doesn't resolve
+    CHECK(map.Get(ContextSlotHandle::Unpack(0)) == nullptr);
+    CHECK(map.Get(ContextSlotHandle::Unpack(0x00007ff612345678)) == nullptr);
+
+    // NextHandle doesn't reserve anything
+    CHECK(map.NextHandle() == map.NextHandle());
+}
+
+// What the inputs kept before, one map per field
+struct ParallelMaps
+{
+    std::unordered_map<void*, int> InitParams;
+    std::unordered_map<void*, void*> Params;
+    std::unordered_map<void*, void*> Handles;
+    std::unordered_map<void*, float> MotionScales;
+};
+
+template <typename Fn> static double NsPerLookup(size_t lookups, Fn&& fn)
+{
+    auto start = std::chrono::steady_clock::now();
+    uintptr_t sink = 0;
+
+    for (size_t i = 0; i < lookups; i++)
+        sink += fn(i);
+
+    auto ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    // Keep the loop
+    if (sink == 1)
+        printf(" ");
+
+    return ns / (double) lookups;
+}
+
+static void Benchmark(size_t lookups)
+{
+    printf("%8s %16s %12s %14s %12s\n", "contexts", "parallel maps", "Find(key)", "HandleOf+Get", "Get(handle)");
+
+    for (size_t count : { 1, 4, 64 })
+    {
+        ParallelMaps parallel;
+        Map map;
+        std::vector<void*> keys;
+        std::vector<ContextSlotHandle> handles;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            keys.push_back(Key(i * 37 + 11));
+            parallel.InitParams[keys.back()] = (int) i;
+            parallel.Params[keys.back()] = Key(i);
+            parallel.Handles[keys.back()] = Key(i + 1);
+            parallel.MotionScales[keys.back()] = 1.0f;
+
+            auto& entry = map.Emplace(keys.back());
+            entry.InitParams[0] = (int) i;
+            entry.Params = Key(i);
+            entry.Handle = Key(i + 1);
+            handles.push_back(map.HandleOf(keys.back()));
+        }
+
+        // A dispatch reads init params, parameters, feature handle and motion scale of its context
+        auto old = NsPerLookup(lookups,
+                               [&](size_t i)
+                               {
+                                   auto key = keys[i % count];
+                                   return (uintptr_t) parallel.InitParams[key] + (uintptr_t) parallel.Params[key] +
+                                          (uintptr_t) parallel.Handles[key] + (uintptr_t) parallel.MotionScales[key];
+                               });
+
+        auto find = NsPerLookup(lookups,
+                                [&](size_t i)
+                                {
+                                    auto entry = map.Find(keys[i % count]);
+                                    return (uintptr_t) entry->InitParams[0] + (uintptr_t) entry->Params +
+                                           (uintptr_t) entry->Handle;
+                                });
+
+        // Dispatch of FSR2 / FSR3 / FFX API inputs, resolve once then the helpers go by handle
+        auto resolve = NsPerLookup(lookups,
+                                   [&](size_t i)
+                                   {
+                                       auto slot = map.HandleOf(keys[i % count]);
+                                       auto entry = map.Get(slot);
+                                       auto again = map.Get(slot);
+                                       return (uintptr_t) entry->InitParams[0] + (uintptr_t) entry->Params +
+                                              (uintptr_t) again->Handle;
+                                   });
+
+        // XeSS, context value is the handle
+        auto get = NsPerLookup(lookups,
+                               [&](size_t i)
+                               {
+                                   auto entry = map.Get(handles[i % count]);
+                                   return (uintptr_t) entry->InitParams[0] + (uintptr_t) entry->Params +
+                                          (uintptr_t) entry->Handle;
+                               });
+
+        printf("%8zu %13.2f ns %9.2f ns %11.2f ns %9.2f ns\n", count, old, find, resolve, get);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    size_t lookups = argc > 1 ? strtoull(argv[1], nullptr, 10) : 20000000;
+
+    Basics();
+    StaleHandles();
+    StableEntries();
+    MintedHandles();
+    Benchmark(lookups);
+
+    if (failures == 0)
+        printf("All checks passed\n");
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+// Linux stand-in for OptiScaler/Config.h with the dynamic resolution options
+
+template <typename T> struct Option
+{
+    T Value;
+    T value_or_default() const { return Value; }
+    void set_volatile_value(T value) { Value = value; }
+};
+
+class Config
+{
+  public:
+    Option<bool> DynamicResolution { false };
+    Option<float> DynamicResolutionTargetMs { 16.667f };
+
+    static Config* Instance()
+    {
+        static Config* instance = new Config();
+        return instance;
+    }
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+// Linux stand-in for OptiScaler/State.h with the frame times and the current feature the live controller reads
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+// Only the sizes of upscalers/IFeature.h
+class IFeature
+{
+  public:
+    uint32_t Display = 0;
+    uint32_t Render = 0;
+
+    uint32_t DisplayWidth() const { return Display; }
+    uint32_t RenderWidth() const { return Render; }
+};
+
+class State
+{
+  public:
+    std::deque<double> upscaleTimes;
+    std::deque<double> frameTimes;
+    std::mutex frameTimeMutex;
+
+    IFeature* currentFeature = nullptr;
+
+    static State& Instance()
+    {
+        static State instance;
+        return instance;
+    }
+};
@@ -0,0 +1,504 @@
+// Replays synthetic frame time traces through DynamicResolution::AddFrame against a game model whose render cost
+// scales with render pixels: convergence to the target, the hysteresis band, the DRS range and a game which never
+// applies the requested ratio. The live OnPresent path is driven through the State / Config stand-ins to check the
+// published ratio stays inside the range given by SetAdvertisedRange.
+//
+// Build and run on Linux from this directory:
+//   g++ -std=c++20 -O2 -I. -I../../OptiScaler dynamic_resolution_check.cpp
+//       ../../OptiScaler/misc/DynamicResolution.cpp -o check
+//   ./check
+// Exits with 1 and prints the failed checks when something is off.
+
+#include <misc/DynamicResolution.h>
+#include <Config.h>
+#include <State.h>
+
+#include <cmath>
+#include <cstdio>
+
+static int failures = 0;
+
+#define CHECK(expr)                                                                                                    \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expr))                                                                                                   \
+        {                                                                                                              \
+            printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #expr);                                                   \
+            failures++;                                                                                                \
+        }                                                                                                              \
+    } while (0)
+
+static constexpr double TargetMs = 16.667;
+
+// Game stand-in, frame time is upscaler time + render cost at native size / ratio^2 with some noise.
+// Requested ratios show up ApplyDelay frames later, or never when Follows is false.
+struct Game
+{
+    double NativeMs = 40.0;
+    double UpscaleMs = 1.5;
+    double Noise = 0.03;    // +/- share of the frame time
+    uint32_t SpikeEvery = 0; // Every n-th frame takes 3x, shader compiles & streaming
+    uint32_t ApplyDelay = 3;
+    bool Follows = true;
+
+    float RenderRatio = 1.5f;
+    float Requested = 0.0f;
+    uint32_t PendingFrames = 0;
+    uint64_t Frame = 0;
+    uint32_t Seed = 12345;
+
+    double Random()
+    {
+        Seed = Seed * 1664525u + 1013904223u;
+        return (double) (Seed >> 8) / (double) (1u << 24);
+    }
+
+    double FrameTimeMs()
+    {
+        if (Requested > 0.0f && Follows && ++PendingFrames >= ApplyDelay)
+        {
+            RenderRatio = Requested;
+            Requested = 0.0f;
+        }
+
+        auto ms = UpscaleMs + NativeMs / (RenderRatio * RenderRatio);
+        ms *= 1.0 + Noise * (Random() * 2.0 - 1.0);
+
+        if (SpikeEvery > 0 && ++Frame % SpikeEvery == 0)
+            ms *= 3.0;
+
+        return ms;
+    }
+
+    void Request(float ratio)
+    {
+        Requested = ratio;
+        PendingFrames = 0;
+    }
+};
+
+struct Replay
+{
+    uint32_t Changes = 0;
+    uint32_t LastChangeFrame = 0;
+    float MinRatio = 100.0f;
+    float MaxRatio = 0.0f;
+};
+
+static Replay Run(DynamicResolution& controller, Game& game, uint32_t frames)
+{
+    Replay replay;
+
+    for (uint32_t i = 0; i < frames; i++)
+    {
+        auto frameMs = game.FrameTimeMs();
+
+        if (auto ratio = controller.AddFrame(frameMs, game.UpscaleMs, game.RenderRatio); ratio.has_value())
+        {
+            game.Request(ratio.value());
+            replay.Changes++;
+            replay.LastChangeFrame = i;
+        }
+
+        replay.MinRatio = std::min(replay.MinRatio, controller.Ratio());
+        replay.MaxRatio = std::max(replay.MaxRatio, controller.Ratio());
+    }
+
+    return replay;
+}
+
+// Ratios are rounded to RatioStep in float
+static bool Near(float a, float b) { return std::abs(a - b) < 0.001f; }
+
+static bool InBand(double frameMs)
+{
+    return frameMs >= TargetMs * (1.0 - DynamicResolution::Hysteresis) &&
+           frameMs <= TargetMs * (1.0 + DynamicResolution::Hysteresis);
+}
+
+static double CleanFrameMs(const Game& game)
+{
+    return game.UpscaleMs + game.NativeMs / (game.RenderRatio * game.RenderRatio);
+}
+
+static void Convergence()
+{
+    // GPU bound at the initial ratio, 40 ms native: target is hit around 1.62
+    {
+        DynamicResolution controller({ (float) TargetMs, 1.0f, 2.0f, 1.5f });
+        Game game;
+        game.SpikeEvery = 7;
+
+        auto replay = Run(controller, game, 3000);
+
+        CHECK(replay.Changes >= 1 && replay.Changes <= 3);
+        CHECK(replay.LastChangeFrame < 500);
+        CHECK(controller.Ratio() > 1.5f && controller.Ratio() <= 1.7f);
+        CHECK(game.RenderRatio == controller.Ratio());
+        CHECK(InBand(CleanFrameMs(game)));
+        CHECK(InBand(controller.LastMedianMs()));
+    }
+
+    // Light load, steps down to native and stays there below the band
+    {
+        DynamicResolution controller({ (float) TargetMs, 1.0f, 2.0f, 1.5f });
+        Game game;
+        game.NativeMs = 10.0;
+        game.UpscaleMs = 1.0;
+
+        auto replay = Run(controller, game, 3000);
+
+        CHECK(controller.Ratio() == 1.0f);
+        CHECK(replay.Changes == 5); // MaxStep per change
+        CHECK(replay.LastChangeFrame < 500);
+        CHECK(CleanFrameMs(game) < TargetMs);
+    }
+
+    // Upscaler heavy, only the render part scales. Without keeping it out the ratio would overshoot.
+    {
+        DynamicResolution controller({ (float) TargetMs, 1.0f, 3.0f, 1.0f });
+        Game game;
+        game.NativeMs = 24.0;
+        game.UpscaleMs = 6.0;
+        game.RenderRatio = 1.0f;
+
+        auto replay = Run(controller, game, 4000);
+
+        CHECK(replay.LastChangeFrame < 1000);
+        CHECK(InBand(CleanFrameMs(game)));
+        CHECK(controller.Ratio() > 1.4f && controller.Ratio() < 1.6f);
+    }
+
+    // Loading screen frames are ignored
+    {
+        DynamicResolution controller({ (float) TargetMs, 1.0f, 2.0f, 1.5f });
+
+        for (int i = 0; i < 500; i++)
+            CHECK(!controller.AddFrame(1000.0, 1.0).has_value());
+
+        CHECK(controller.Ratio() == 1.5f);
+        CHECK(controller.Changes() == 0);
+    }
+}
+
+static void HysteresisBand()
+{
+    // Median inside target +/- 5% is left alone, noise included
+    for (double scale : { 0.96, 1.0, 1.04 })
+    {
+        DynamicResolution controller({ (float) TargetMs, 1.0f, 2.0f, 1.5f });
+        uint32_t seed = 777;
+
+        for (int i = 0; i < 2000; i++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            auto noise = 1.0 + 0.01 * ((double) (seed >> 8) / (double) (1u << 24) * 2.0 - 1.0);
+            CHECK(!controller.AddFrame(TargetMs * scale * noise, 1.0).has_value());
+        }
+
+        CHECK(controller.Changes() == 0);
+    }
+
+    // Just outside, one window after the settle frames decides
+    for (double scale : { 0.94, 1.06 })
+    {
+        DynamicResolution controller({ (float) TargetMs, 1.0f, 2.0f, 1.5f });
+        uint32_t first = 0;
+
+        for (uint32_t i = 0; i < 200 && first == 0; i++)
+        {
+            if (controller.AddFrame(TargetMs * scale, 1.0).has_value())
+                first = i + 1;
+        }
+
+        CHECK(first == DynamicResolution::SettleFrames + DynamicResolution::WindowSize);
+        CHECK(scale > 1.0 ? controller.Ratio() > 1.5f : controller.Ratio() < 1.5f);
+    }
+
+    // Noisy load sitting near the band edge doesn't flip back and forth
+    {
+        DynamicResolution controller({ (float) TargetMs, 1.0f, 2.0f, 1.5f });
+        Game game;
+        game.NativeMs = 34.0;
+        game.Noise = 0.05;
+        game.SpikeEvery = 11;
+
+        auto replay = Run(controller, game, 5000);
+
+        CHECK(replay.Changes == 0);
+    }
+}
+
+static void Range()
+{
+    // Heavy load wants far more than the range allows
+    {
+        DynamicResolution controller({ (float) TargetMs, 1.0f, 2.0f, 1.5f });
+        controller.SetRange(1.2f, 1.4f);
+        CHECK(controller.Ratio() == 1.4f);
+
+        Game game;
+        game.NativeMs = 80.0;
+        game.RenderRatio = 1.4f;
+
+        auto replay = Run(controller, game, 2000);
+        CHECK(replay.MaxRatio <= 1.4f);
+        CHECK(replay.Changes == 0);
+
+        // Light load, down to the bottom of the range only
+        game.NativeMs = 5.0;
+        replay = Run(controller, game, 2000);
+        CHECK(replay.MinRatio >= 1.2f);
+        CHECK(controller.Ratio() == 1.2f);
+    }
+
+    // Invalid ranges are ignored
+    {
+        DynamicResolution controller({ (float) TargetMs, 1.0f, 2.0f, 1.5f });
+        controller.SetRange(0.0f, 1.3f);
+        controller.SetRange(1.6f, 1.4f);
+        CHECK(controller.Ratio() == 1.5f);
+    }
+
+    // Resync to a ratio the game picked itself outside the range is clamped
+    {
+        DynamicResolution controller({ (float) TargetMs, 1.0f, 1.8f, 1.5f });
+        Game game;
+        game.NativeMs = 60.0;
+        game.Follows = false;
+        game.RenderRatio = 2.5f;
+
+        auto replay = Run(controller, game, 1000);
+        CHECK(replay.MaxRatio <= 1.8f);
+    }
+}
+
+static void NeverApplied()
+{
+    DynamicResolution controller({ (float) TargetMs, 1.0f, 2.0f, 1.5f });
+    Game game;
+    game.Follows = false;
+
+    // First request is made, then nothing until the timeout resyncs to what the game renders at
+    uint32_t frame = 0;
+
+    while (frame < 1000 && !controller.AddFrame(game.FrameTimeMs(), game.UpscaleMs, game.RenderRatio).has_value())
+        frame++;
+
+    CHECK(frame == DynamicResolution::SettleFrames + DynamicResolution::WindowSize - 1);
+    CHECK(Near(controller.Ratio(), 1.6f));
+
+    for (uint32_t i = 1; i < DynamicResolution::ApplyTimeoutFrames; i++)
+        CHECK(!controller.AddFrame(game.FrameTimeMs(), game.UpscaleMs, game.RenderRatio).has_value());
+
+    CHECK(Near(controller.Ratio(), 1.6f));
+    CHECK(!controller.AddFrame(game.FrameTimeMs(), game.UpscaleMs, game.RenderRatio).has_value());
+    CHECK(controller.Ratio() == 1.5f);
+
+    // Keeps asking for the same step instead of walking away from the game's size
+    auto replay = Run(controller, game, 5000);
+    CHECK(replay.MaxRatio <= 1.6f);
+    CHECK(replay.MinRatio >= 1.5f);
+
+    auto cycle = DynamicResolution::ApplyTimeoutFrames + DynamicResolution::SettleFrames +
+                 DynamicResolution::WindowSize;
+    CHECK(replay.Changes >= 5000 / cycle - 1 && replay.Changes <= 5000 / cycle + 1);
+
+    // Initial ratio counts as a request, game still at its own size is picked up
+    {
+        DynamicResolution initial({ (float) TargetMs, 1.0f, 2.0f, 1.5f });
+        Game own;
+        own.Follows = false;
+        own.RenderRatio = 1.3f;
+        own.NativeMs = 25.0;
+
+        for (uint32_t i = 0; i < DynamicResolution::ApplyTimeoutFrames; i++)
+            CHECK(!initial.AddFrame(own.FrameTimeMs(), own.UpscaleMs, own.RenderRatio).has_value());
+
+        CHECK(Near(initial.Ratio(), 1.3f));
+        CHECK(initial.Changes() == 0);
+    }
+
+    // Game applying late is waited for, frames at the old size don't cause a second step
+    {
+        DynamicResolution late({ (float) TargetMs, 1.0f, 2.0f, 1.5f });
+        Game slow;
+        slow.ApplyDelay = 90;
+
+        Run(late, slow, 3000);
+        CHECK(late.Changes() == 1);
+        CHECK(slow.RenderRatio == late.Ratio());
+    }
+
+    // Rounded render sizes count as applied
+    {
+        DynamicResolution rounded({ (float) TargetMs, 1.0f, 2.0f, 1.5f });
+        float requested = 0.0f;
+
+        for (int i = 0; i < 100 && requested == 0.0f; i++)
+            requested = rounded.AddFrame(20.0, 1.0).value_or(0.0f);
+
+        CHECK(requested > 1.5f);
+
+        // 3840 / 2399 vs 1.6, next step comes one window later instead of after the timeout
+        for (uint32_t i = 0; i < DynamicResolution::SettleFrames + DynamicResolution::WindowSize; i++)
+            rounded.AddFrame(20.0, 1.0, 3840.0f / 2399.0f);
+
+        CHECK(rounded.Changes() == 2);
+        CHECK(rounded.Ratio() > requested);
+    }
+}
+
+// Live controller, frame times come from State and the ratio is read back like the NGX callbacks do
+static void Present(IFeature& feature, Game& game, bool withFG)
+{
+    auto& state = State::Instance();
+
+    if (auto ratio = DynamicResolution::LiveRatio(); ratio.has_value() && ratio.value() != game.RenderRatio &&
+                                                       game.Requested != ratio.value())
+    {
+        game.Request(ratio.value());
+    }
+
+    auto frameMs = game.FrameTimeMs();
+    feature.Render = (uint32_t) std::lround(feature.Display / game.RenderRatio);
+    state.upscaleTimes.push_back(game.UpscaleMs);
+
+    // Interpolated present halves the interval
+    if (withFG)
+    {
+        state.frameTimes.push_back(frameMs * 0.5);
+        DynamicResolution::OnPresent(true);
+        frameMs *= 0.5;
+    }
+
+    state.frameTimes.push_back(frameMs);
+    DynamicResolution::OnPresent(false);
+}
+
+static void LiveAdvertisedRange()
+{
+    auto& config = *Config::Instance();
+    auto& state = State::Instance();
+    IFeature feature;
+    feature.Display = 3840;
+
+    // Not running
+    DynamicResolution::OnPresent(false);
+    CHECK(!DynamicResolution::LiveRatio().has_value());
+
+    config.DynamicResolution.set_volatile_value(true);
+    config.DynamicResolutionTargetMs.set_volatile_value((float) TargetMs);
+    state.currentFeature = &feature;
+
+    // Game was told 1.25 - 1.45, the default start ratio of 1.5 is out of it
+    DynamicResolution::SetAdvertisedRange(1.25f, 1.45f);
+
+    for (bool withFG : { false, true })
+    {
+        Game game;
+        game.NativeMs = 80.0;
+        game.RenderRatio = 1.45f;
+
+        float minSeen = 100.0f;
+        float maxSeen = 0.0f;
+
+        for (int i = 0; i < 2000; i++)
+        {
+            Present(feature, game, withFG);
+
+            auto ratio = DynamicResolution::LiveRatio();
+            CHECK(ratio.has_value());
+            minSeen = std::min(minSeen, ratio.value_or(0.0f));
+            maxSeen = std::max(maxSeen, ratio.value_or(100.0f));
+        }
+
+        CHECK(minSeen >= 1.25f && maxSeen <= 1.45f);
+        CHECK(Near(DynamicResolution::LiveRatio().value_or(0.0f), 1.45f));
+
+        // Range narrowed by a later optimal settings query, published ratio follows right away
+        DynamicResolution::SetAdvertisedRange(1.25f, 1.35f);
+        Present(feature, game, withFG);
+        CHECK(DynamicResolution::LiveRatio().value_or(0.0f) <= 1.35f);
+
+        // Light load goes down to the bottom of it
+        game.NativeMs = 8.0;
+
+        for (int i = 0; i < 3000; i++)
+        {
+            Present(feature, game, withFG);
+            minSeen = std::min(minSeen, DynamicResolution::LiveRatio().value_or(0.0f));
+        }
+
+        CHECK(minSeen >= 1.25f);
+        CHECK(Near(DynamicResolution::LiveRatio().value_or(0.0f), 1.25f));
+        CHECK(Near(game.RenderRatio, 1.25f));
+
+        // Stop and start over for the next run
+        config.DynamicResolution.set_volatile_value(false);
+        DynamicResolution::OnPresent(false);
+        CHECK(!DynamicResolution::LiveRatio().has_value());
+        config.DynamicResolution.set_volatile_value(true);
+        DynamicResolution::SetAdvertisedRange(1.25f, 1.45f);
+    }
+
+    // Frame generation, interpolated presents are summed up into the real frame they split
+    {
+        config.DynamicResolution.set_volatile_value(false);
+        DynamicResolution::OnPresent(false);
+        config.DynamicResolution.set_volatile_value(true);
+        DynamicResolution::SetAdvertisedRange(1.0f, 2.0f);
+
+        Game game;
+        game.NativeMs = 34.0;
+
+        for (int i = 0; i < 1000; i++)
+            Present(feature, game, true);
+
+        CHECK(Near(DynamicResolution::LiveRatio().value_or(0.0f), 1.5f));
+        DynamicResolution::SetAdvertisedRange(1.25f, 1.45f);
+    }
+
+    // Game ignoring the requests, published ratio goes back to what it renders at after the timeout
+    {
+        Game game;
+        game.NativeMs = 80.0;
+        game.RenderRatio = 1.3f;
+        game.Follows = false;
+
+        bool requested = false;
+        bool resynced = false;
+
+        for (int i = 0; i < 1000 && !resynced; i++)
+        {
+            Present(feature, game, false);
+            auto ratio = DynamicResolution::LiveRatio().value_or(0.0f);
+
+            if (ratio > 1.305f)
+                requested = true;
+            else if (requested && Near(ratio, 1.3f))
+                resynced = true;
+        }
+
+        CHECK(requested);
+        CHECK(resynced);
+    }
+
+    config.DynamicResolution.set_volatile_value(false);
+    DynamicResolution::OnPresent(false);
+    state.currentFeature = nullptr;
+}
+
+int main()
+{
+    Convergence();
+    HysteresisBand();
+    Range();
+    NeverApplied();
+    LiveAdvertisedRange();
+
+    if (failures == 0)
+        printf("All checks passed\n");
+
+    return failures == 0 ? 0 : 1;
+}
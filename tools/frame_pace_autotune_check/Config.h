@@ -0,0 +1,28 @@
+#pragma once
+
+// Linux stand-in for OptiScaler/Config.h with the frame pacing options FramePaceAutoTune reads
+
+template <typename T> struct Option
+{
+    T Value;
+    T value_or_default() const { return Value; }
+    void set_volatile_value(T value) { Value = value; }
+};
+
+class Config
+{
+  public:
+    Option<bool> FGFramePacingTuning { true };
+    Option<float> FGFPTSafetyMarginInMs { 0.01f };
+    Option<float> FGFPTVarianceFactor { 0.3f };
+    Option<bool> FGFPTAllowHybridSpin { false };
+    Option<int> FGFPTHybridSpinTime { 2 };
+    Option<bool> FGFPTAllowWaitForSingleObjectOnFence { false };
+    Option<bool> FGFPTAutoTune { false };
+
+    static Config* Instance()
+    {
+        static Config* instance = new Config();
+        return instance;
+    }
+};
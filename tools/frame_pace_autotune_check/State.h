@@ -0,0 +1,15 @@
+#pragma once
+
+// Linux stand-in for OptiScaler/State.h with the flag FramePaceAutoTune sets
+
+class State
+{
+  public:
+    bool FSRFGFTPchanged = false;
+
+    static State& Instance()
+    {
+        static State instance;
+        return instance;
+    }
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+// Linux stand-in for OptiScaler/SysUtils.h, just enough for FramePaceAutoTune.
+// The process time functions are only declared, the check replays traces through AddPresent.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+#define LOG_TRACE(...) ((void) 0)
+#define LOG_DEBUG(...) ((void) 0)
+#define LOG_INFO(...) ((void) 0)
+#define LOG_WARN(...) ((void) 0)
+#define LOG_ERROR(...) ((void) 0)
+
+typedef void* HANDLE;
+typedef unsigned long DWORD;
+typedef int BOOL;
+
+struct FILETIME
+{
+    DWORD dwLowDateTime;
+    DWORD dwHighDateTime;
+};
+
+HANDLE GetCurrentProcess();
+BOOL GetProcessTimes(HANDLE process, FILETIME* creationTime, FILETIME* exitTime, FILETIME* kernelTime,
+                     FILETIME* userTime);
+
+#include "State.h"
@@ -0,0 +1,310 @@
+// Replays synthetic FSR-FG present traces through FramePaceAutoTune::AddPresent. A small pacer model turns the
+// applied parameters into present interval jitter and CPU cost, so the check covers the closed loop: the margin
+// steps with their settle / hysteresis windows, the hybrid spin and WaitForSingleObjectOnFence trials (kept and
+// reverted) and the retune after convergence.
+//
+// Build and run on Linux from this directory:
+//   g++ -std=c++20 -O2 -I. -I../../OptiScaler frame_pace_autotune_check.cpp
+//       ../../OptiScaler/framegen/ffx/FramePaceAutoTune.cpp -o check
+//   ./check
+// Exits with 1 and prints the failed checks when something is off.
+
+#include <framegen/ffx/FramePaceAutoTune.h>
+
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(expr)                                                                                                    \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expr))                                                                                                   \
+        {                                                                                                              \
+            printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #expr);                                                   \
+            failures++;                                                                                                \
+        }                                                                                                              \
+    } while (0)
+
+// Only used by the live OnPresent path
+HANDLE GetCurrentProcess() { return nullptr; }
+BOOL GetProcessTimes(HANDLE, FILETIME*, FILETIME*, FILETIME*, FILETIME*) { return 0; }
+
+// What the pacer does with a set of parameters
+struct Behaviour
+{
+    double Jitter = 0.0; // relative stddev of the present intervals
+    double CpuMs = 1.0;  // CPU time per present
+};
+
+using PacerModel = std::function<Behaviour(const FramePaceParams&)>;
+
+struct Change
+{
+    uint32_t Window = 0;
+    FramePaceParams Params {};
+};
+
+// Feeds presents with alternating real / interpolated frames at 8 ms. Intervals follow +a, 0, -a, 0 per frame type,
+// which gives a median of 8 ms and a relative stddev of a / sqrt(2) for both types.
+class Replay
+{
+  public:
+    static constexpr double IntervalMs = 8.0;
+
+    FramePaceAutoTune Tuner;
+    FramePaceParams Applied;
+    PacerModel Pacer;
+
+    std::vector<Change> Changes;
+    uint32_t Windows = 0;
+
+    Replay(const FramePaceParams& initial, PacerModel pacer) : Tuner(initial), Applied(initial), Pacer(pacer) {}
+
+    void RunWindows(uint32_t count)
+    {
+        auto target = Windows + count;
+
+        while (Windows < target)
+            Present();
+    }
+
+  private:
+    uint64_t _presents = 0;
+    uint64_t _timeNs = 1'000'000'000;
+    uint64_t _cpuNs = 0;
+
+    void Present()
+    {
+        auto behaviour = Pacer(Applied);
+        auto amplitude = behaviour.Jitter * std::sqrt(2.0);
+        auto interpolated = (_presents % 2) == 1;
+
+        double pattern[] = { 1.0, 0.0, -1.0, 0.0 };
+        auto offset = pattern[(_presents / 2) % 4] * amplitude;
+
+        _timeNs += (uint64_t) (IntervalMs * (1.0 + offset) * 1'000'000.0);
+        _cpuNs += (uint64_t) (behaviour.CpuMs * 1'000'000.0);
+
+        auto params = Tuner.AddPresent(_timeNs, interpolated, _cpuNs);
+        _presents++;
+
+        // First window needs WindowSize + 1 presents, the last present of a window starts the next one
+        if (_presents > 1 && (_presents - 1) % FramePaceAutoTune::WindowSize == 0)
+            Windows++;
+
+        if (params.has_value())
+        {
+            Changes.push_back({ Windows, *params });
+            Applied = *params;
+        }
+    }
+};
+
+static bool Near(double a, double b, double tolerance = 0.001) { return std::abs(a - b) < tolerance; }
+
+static void PrintChanges(const char* scenario, const Replay& replay)
+{
+    printf("%s\n", scenario);
+
+    for (const auto& change : replay.Changes)
+    {
+        printf("  window %2u: margin %.2f, variance %.2f, hybrid spin %d (%d), wait on fence %d\n", change.Window,
+               change.Params.SafetyMarginInMs, change.Params.VarianceFactor, change.Params.AllowHybridSpin,
+               change.Params.HybridSpinTime, change.Params.AllowWaitForSingleObjectOnFence);
+    }
+}
+
+// Jitter over target until the variance factor is raised to 0.45, hybrid spin saves CPU, fence wait costs CPU
+static void RaiseThenTrials()
+{
+    Replay replay({},
+                  [](const FramePaceParams& params)
+                  {
+                      Behaviour behaviour {};
+                      behaviour.Jitter = params.VarianceFactor >= 0.449f ? 0.03 : 0.09;
+                      behaviour.CpuMs = params.AllowHybridSpin ? 0.8 : 1.0;
+
+                      if (params.AllowWaitForSingleObjectOnFence)
+                          behaviour.CpuMs += 0.1;
+
+                      return behaviour;
+                  });
+
+    // Settle window after start, nothing is evaluated even with the jitter over target
+    replay.RunWindows(2);
+    CHECK(replay.Changes.empty());
+    CHECK(Near(replay.Tuner.LastWindow().MedianIntervalMs, Replay::IntervalMs));
+    CHECK(Near(replay.Tuner.LastWindow().RealJitter, 0.09));
+    CHECK(Near(replay.Tuner.LastWindow().InterpolatedJitter, 0.09));
+    CHECK(Near(replay.Tuner.LastWindow().CpuMsPerPresent, 1.0));
+    CHECK(replay.Tuner.LastWindow().Presents == FramePaceAutoTune::WindowSize + 1);
+
+    replay.RunWindows(18);
+    PrintChanges("raise, hybrid spin kept, fence wait reverted", replay);
+
+    // Raised every second over target window, each change followed by a settle window
+    CHECK(replay.Changes.size() == 6);
+
+    if (replay.Changes.size() == 6)
+    {
+        CHECK(replay.Changes[0].Window == 3 && Near(replay.Changes[0].Params.VarianceFactor, 0.35));
+        CHECK(replay.Changes[1].Window == 6 && Near(replay.Changes[1].Params.VarianceFactor, 0.40));
+        CHECK(replay.Changes[2].Window == 9 && Near(replay.Changes[2].Params.VarianceFactor, 0.45));
+        CHECK(Near(replay.Changes[2].Params.SafetyMarginInMs, 0.01));
+
+        // In target for StableAfter windows, hybrid spin trial
+        CHECK(replay.Changes[3].Window == 13 && replay.Changes[3].Params.AllowHybridSpin);
+        CHECK(replay.Changes[3].Params.HybridSpinTime >= 2);
+        CHECK(!replay.Changes[3].Params.AllowWaitForSingleObjectOnFence);
+
+        // Hybrid spin saved CPU and kept the jitter, kept and the fence wait trial starts
+        CHECK(replay.Changes[4].Window == 15 && replay.Changes[4].Params.AllowHybridSpin);
+        CHECK(replay.Changes[4].Params.AllowWaitForSingleObjectOnFence);
+
+        // Fence wait cost CPU, reverted to the hybrid spin settings
+        CHECK(replay.Changes[5].Window == 17 && replay.Changes[5].Params.AllowHybridSpin);
+        CHECK(!replay.Changes[5].Params.AllowWaitForSingleObjectOnFence);
+        CHECK(Near(replay.Changes[5].Params.VarianceFactor, 0.45));
+    }
+
+    CHECK(replay.Tuner.CurrentPhase() == FramePaceAutoTune::Phase::Converged);
+    CHECK(Near(replay.Tuner.LastWindow().CpuMsPerPresent, 0.8));
+}
+
+// Headroom lowers the margins until jitter goes over target, lowering is blocked after that.
+// Hybrid spin costs CPU and is reverted, fence wait saves CPU and is kept. Jitter spike after that retunes.
+static void LowerThenTrials()
+{
+    bool spike = false;
+
+    Replay replay({},
+                  [&spike](const FramePaceParams& params)
+                  {
+                      Behaviour behaviour {};
+                      behaviour.Jitter = spike ? 0.2 : (params.VarianceFactor >= 0.199f ? 0.01 : 0.07);
+                      behaviour.CpuMs = 1.0;
+
+                      if (params.AllowHybridSpin)
+                          behaviour.CpuMs = 1.2;
+                      else if (params.AllowWaitForSingleObjectOnFence)
+                          behaviour.CpuMs = 0.7;
+
+                      return behaviour;
+                  });
+
+    replay.RunWindows(23);
+    PrintChanges("lower, blocked, hybrid spin reverted, fence wait kept", replay);
+
+    CHECK(replay.Changes.size() == 6);
+
+    if (replay.Changes.size() == 6)
+    {
+        // Safety margin is already at its minimum, variance factor goes down every LowerAfter windows
+        CHECK(replay.Changes[0].Window == 4 && Near(replay.Changes[0].Params.VarianceFactor, 0.25));
+        CHECK(replay.Changes[1].Window == 8 && Near(replay.Changes[1].Params.VarianceFactor, 0.20));
+        CHECK(replay.Changes[2].Window == 12 && Near(replay.Changes[2].Params.VarianceFactor, 0.15));
+
+        // Too low, raised back
+        CHECK(replay.Changes[3].Window == 15 && Near(replay.Changes[3].Params.VarianceFactor, 0.20));
+
+        // Headroom again but lowering is blocked, stable -> hybrid spin trial
+        CHECK(replay.Changes[4].Window == 19 && replay.Changes[4].Params.AllowHybridSpin);
+
+        // Reverted and the fence wait trial started in the same step
+        CHECK(replay.Changes[5].Window == 21 && !replay.Changes[5].Params.AllowHybridSpin);
+        CHECK(replay.Changes[5].Params.AllowWaitForSingleObjectOnFence);
+        CHECK(Near(replay.Changes[5].Params.VarianceFactor, 0.20));
+    }
+
+    CHECK(replay.Tuner.CurrentPhase() == FramePaceAutoTune::Phase::Converged);
+    CHECK(replay.Tuner.Params().AllowWaitForSingleObjectOnFence && !replay.Tuner.Params().AllowHybridSpin);
+
+    // Converged stays put
+    replay.RunWindows(10);
+    CHECK(replay.Changes.size() == 6);
+    CHECK(replay.Tuner.CurrentPhase() == FramePaceAutoTune::Phase::Converged);
+
+    // Jitter over twice the target for RetuneAfter windows restarts tuning
+    spike = true;
+    replay.RunWindows(2);
+    CHECK(replay.Tuner.CurrentPhase() == FramePaceAutoTune::Phase::Converged);
+    replay.RunWindows(1);
+    CHECK(replay.Tuner.CurrentPhase() == FramePaceAutoTune::Phase::TuneMargins);
+    CHECK(replay.Changes.size() == 6);
+
+    // Lowering block is lifted, raising works again after RaiseAfter windows
+    replay.RunWindows(2);
+    CHECK(replay.Changes.size() == 7);
+
+    if (replay.Changes.size() == 7)
+        CHECK(Near(replay.Changes[6].Params.VarianceFactor, 0.25));
+}
+
+// Hybrid spin saves CPU but makes the jitter worse than allowed, reverted
+static void TrialJitterLoss()
+{
+    Replay replay({},
+                  [](const FramePaceParams& params)
+                  {
+                      Behaviour behaviour {};
+                      behaviour.Jitter = params.AllowHybridSpin ? 0.06 : 0.03;
+                      behaviour.CpuMs = 1.0;
+
+                      if (params.AllowHybridSpin)
+                          behaviour.CpuMs = 0.5;
+                      else if (params.AllowWaitForSingleObjectOnFence)
+                          behaviour.CpuMs = 0.9;
+
+                      return behaviour;
+                  });
+
+    replay.RunWindows(10);
+    PrintChanges("hybrid spin reverted on jitter", replay);
+
+    CHECK(replay.Changes.size() == 2);
+
+    if (replay.Changes.size() == 2)
+    {
+        CHECK(replay.Changes[0].Window == 4 && replay.Changes[0].Params.AllowHybridSpin);
+        CHECK(replay.Changes[1].Window == 6 && !replay.Changes[1].Params.AllowHybridSpin);
+        CHECK(replay.Changes[1].Params.AllowWaitForSingleObjectOnFence);
+    }
+
+    CHECK(replay.Tuner.CurrentPhase() == FramePaceAutoTune::Phase::Converged);
+    CHECK(replay.Tuner.Params().AllowWaitForSingleObjectOnFence);
+}
+
+// Margins already at their maximum and trials already enabled, nothing left to change
+static void NothingToRaise()
+{
+    FramePaceParams initial {};
+    initial.SafetyMarginInMs = 1.0f;
+    initial.VarianceFactor = 0.5f;
+    initial.AllowHybridSpin = true;
+    initial.AllowWaitForSingleObjectOnFence = true;
+
+    Replay replay(initial, [](const FramePaceParams&) { return Behaviour { 0.09, 1.0 }; });
+
+    replay.RunWindows(3);
+    CHECK(replay.Changes.empty());
+    CHECK(replay.Tuner.CurrentPhase() == FramePaceAutoTune::Phase::Converged);
+
+    // Reset goes back to tuning with a settle window
+    replay.Tuner.Reset(initial);
+    CHECK(replay.Tuner.CurrentPhase() == FramePaceAutoTune::Phase::TuneMargins);
+}
+
+int main()
+{
+    RaiseThenTrials();
+    LowerThenTrials();
+    TrialJitterLoss();
+    NothingToRaise();
+
+    if (failures == 0)
+        printf("All checks passed\n");
+
+    return failures == 0 ? 0 : 1;
+}
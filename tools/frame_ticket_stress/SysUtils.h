@@ -0,0 +1,24 @@
+#pragma once
+
+// Linux stand-in for OptiScaler/SysUtils.h, just enough for FrameTicket.h and OwnedMutex.h
+
+#include <cstdint>
+#include <cstdio>
+
+#include <pthread.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define YieldProcessor() _mm_pause()
+#else
+#define YieldProcessor() ((void) 0)
+#endif
+
+#define BUFFER_COUNT 4
+
+typedef unsigned long DWORD;
+
+inline DWORD GetCurrentThreadId() { return (DWORD) pthread_self(); }
+
+// Timeouts are counted in the stats, the harness prints those instead
+#define LOG_WARN(...) ((void) 0)
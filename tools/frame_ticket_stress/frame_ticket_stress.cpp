@@ -0,0 +1,265 @@
+// Producer / consumer stress test of FrameTicket against the previous OwnedMutex based present sync.
+//
+// One dispatch thread produces frames like UpscalerInputsDx12::UpscaleStart, two present threads consume them
+// like FGHooks::FGPresent (game present and the interpolated present of FSR FG's own thread).
+// Prints p50 / p99 / p99.9 / max of the dispatch side wait and of the present side lock wait for both schemes.
+// Checks the ring index matching of FrameTicket first, exits with 1 when that fails.
+//
+// Build and run on Linux from this directory, the local SysUtils.h stands in for the Windows one:
+//   g++ -std=c++20 -O2 -pthread -I. -I../../OptiScaler frame_ticket_stress.cpp -o frame_ticket_stress
+//   ./frame_ticket_stress [frames]
+
+#include "FrameTicket.h"
+#include "OwnedMutex.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static uint64_t NowNs()
+{
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+// Busy work instead of sleeping, sleeps would measure the scheduler instead of the sync
+static void Work(uint64_t ns)
+{
+    auto end = NowNs() + ns;
+
+    while (NowNs() < end)
+        YieldProcessor();
+}
+
+struct Samples
+{
+    std::vector<uint64_t> Ns;
+
+    void Print(const char* name)
+    {
+        if (Ns.empty())
+            return;
+
+        std::sort(Ns.begin(), Ns.end());
+
+        auto at = [&](double p) { return Ns[std::min(Ns.size() - 1, (size_t) (p * (double) Ns.size()))] / 1000.0; };
+
+        printf("  %-22s n: %7zu  p50: %8.1f us  p99: %8.1f us  p99.9: %8.1f us  max: %8.1f us\n", name, Ns.size(),
+               at(0.50), at(0.99), at(0.999), Ns.back() / 1000.0);
+    }
+};
+
+struct Result
+{
+    Samples DispatchWait;
+    Samples PresentWait;
+    uint64_t Dropped = 0;
+};
+
+// Frame timings of a CPU bound game, present calls get an occasional long stall (compositor, vsync)
+struct Timings
+{
+    std::mt19937_64 Rng;
+
+    explicit Timings(uint64_t seed) : Rng(seed) {}
+
+    uint64_t Render() { return std::uniform_int_distribution<uint64_t>(300'000, 900'000)(Rng); }
+
+    uint64_t Present()
+    {
+        if (std::uniform_int_distribution<int>(0, 99)(Rng) == 0)
+            return 3'000'000;
+
+        return std::uniform_int_distribution<uint64_t>(50'000, 400'000)(Rng);
+    }
+};
+
+template <bool UseTicket> static Result Run(uint64_t frames)
+{
+    OwnedMutex mutex;
+    FrameTicket ticket;
+
+    std::atomic<uint64_t> produced { 0 };
+    std::atomic<bool> done { false };
+
+    Result result {};
+    Samples presentWaits[2];
+
+    // Real and interpolated presents, both present the newest produced frame
+    auto presenter = [&](int index)
+    {
+        Timings timings(100 + index);
+        uint64_t presented = 0;
+
+        while (!done.load(std::memory_order_acquire))
+        {
+            auto frame = produced.load(std::memory_order_acquire);
+
+            if (frame == presented)
+            {
+                YieldProcessor();
+                continue;
+            }
+
+            presented = frame;
+            auto start = NowNs();
+
+            if constexpr (UseTicket)
+            {
+                mutex.lock_shared();
+                presentWaits[index].Ns.push_back(NowNs() - start);
+
+                auto slot = ticket.Begin(frame);
+                Work(timings.Present());
+                ticket.End(slot, frame);
+
+                mutex.unlock_shared();
+            }
+            else
+            {
+                mutex.lock(2);
+                presentWaits[index].Ns.push_back(NowNs() - start);
+
+                Work(timings.Present());
+
+                mutex.unlockThis(2);
+            }
+        }
+    };
+
+    std::thread presenters[] = { std::thread(presenter, 0), std::thread(presenter, 1) };
+
+    Timings timings(1);
+
+    for (uint64_t frame = 1; frame <= frames; frame++)
+    {
+        auto start = NowNs();
+
+        if constexpr (UseTicket)
+        {
+            // Only a present of frame - BUFFER_COUNT still reads this index
+            if (!ticket.WaitFor(frame))
+                result.Dropped++;
+        }
+        else if (mutex.getOwner() == 2)
+        {
+            mutex.lock(4);
+            mutex.unlockThis(4);
+        }
+
+        result.DispatchWait.Ns.push_back(NowNs() - start);
+
+        Work(timings.Render());
+        produced.store(frame, std::memory_order_release);
+    }
+
+    done.store(true, std::memory_order_release);
+
+    for (auto& thread : presenters)
+        thread.join();
+
+    for (auto& waits : presentWaits)
+        result.PresentWait.Ns.insert(result.PresentWait.Ns.end(), waits.Ns.begin(), waits.Ns.end());
+
+    if constexpr (UseTicket)
+    {
+        auto stats = ticket.GetStats();
+        printf("FrameTicket: waits %llu, fast paths %llu, timeouts %llu, untracked %llu\n",
+               (unsigned long long) stats.Waits, (unsigned long long) stats.FastPaths,
+               (unsigned long long) stats.Timeouts, (unsigned long long) stats.Untracked);
+    }
+
+    return result;
+}
+
+// Dispatch only waits for presents using the same ring index, whatever the frame numbers are
+static bool CheckRingIndex()
+{
+    int failures = 0;
+    auto check = [&failures](bool ok, const char* what)
+    {
+        if (!ok)
+        {
+            printf("FAILED: %s\n", what);
+            failures++;
+        }
+    };
+
+    FrameTicket ticket;
+
+    // Present of frame 5 in flight, index 1
+    auto slot = ticket.Begin(5);
+    check(ticket.WaitFor(6, 1), "next frame doesn't wait for an older present");
+    check(ticket.WaitFor(8, 1), "other index doesn't wait");
+    check(!ticket.WaitFor(9, 1), "same index waits, times out");
+
+    // Overlapping interpolated present of the same frame
+    auto slot2 = ticket.Begin(5);
+    check(slot2 != slot && slot2 < FrameTicket::Slots, "overlapping present gets its own slot");
+    ticket.End(slot, 5);
+    check(!ticket.WaitFor(9, 1), "index stays taken while one present of it runs");
+    ticket.End(slot2, 5);
+    check(ticket.WaitFor(9, 1), "index free after both presents");
+    check(ticket.Completed() == 5, "completed frame");
+
+    // New FG context restarted the frame count, a present of the old context is still in flight
+    slot = ticket.Begin(500);
+    check(!ticket.WaitFor(0, 1), "restarted count still waits for the same index");
+    check(ticket.WaitFor(1, 1), "restarted count, other index");
+    ticket.End(slot, 500);
+
+    // Wakes up when the present ends
+    slot = ticket.Begin(12);
+    std::thread present(
+        [&]
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            ticket.End(slot, 12);
+        });
+
+    check(ticket.WaitFor(16, 1000), "waiter woken up by End");
+    present.join();
+
+    // All slots taken by index 0, the next present isn't tracked and nothing waits for its index
+    uint32_t slots[FrameTicket::Slots];
+    for (uint32_t i = 0; i < FrameTicket::Slots; i++)
+        slots[i] = ticket.Begin(20 + i * BUFFER_COUNT);
+
+    check(ticket.Begin(27) == FrameTicket::Slots, "untracked present");
+    check(ticket.WaitFor(31, 1), "untracked present isn't waited for");
+
+    for (uint32_t i = 0; i < FrameTicket::Slots; i++)
+        ticket.End(slots[i], 20 + i * BUFFER_COUNT);
+
+    auto stats = ticket.GetStats();
+    check(stats.Timeouts == 3 && stats.Untracked == 1, "stats");
+
+    return failures == 0;
+}
+
+int main(int argc, char** argv)
+{
+    uint64_t frames = argc > 1 ? strtoull(argv[1], nullptr, 10) : 5000;
+
+    if (!CheckRingIndex())
+        return 1;
+
+    auto mutex = Run<false>(frames);
+    auto ticket = Run<true>(frames);
+
+    printf("OwnedMutex (lock(2) in present):\n");
+    mutex.DispatchWait.Print("dispatch wait");
+    mutex.PresentWait.Print("present lock wait");
+
+    printf("FrameTicket (lock_shared in present):\n");
+    ticket.DispatchWait.Print("dispatch wait");
+    ticket.PresentWait.Print("present lock wait");
+    printf("  dropped frames: %llu\n", (unsigned long long) ticket.Dropped);
+
+    return 0;
+}
@@ -0,0 +1,216 @@
+#pragma once
+
+// Linux stand-in for the parts of CSimpleIniA which GameProfiles uses.
+// Keeps sections & keys in file order, comments are dropped.
+
+#include <cstdlib>
+#include <fstream>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <strings.h>
+
+enum SI_Error
+{
+    SI_OK = 0,
+    SI_FAIL = -1,
+    SI_FILE = -3,
+};
+
+class CSimpleIniA
+{
+  public:
+    struct Entry
+    {
+        const char* pItem;
+        int nOrder;
+
+        struct LoadOrder
+        {
+            bool operator()(const Entry& a, const Entry& b) const { return a.nOrder < b.nOrder; }
+        };
+    };
+
+    using TNamesDepend = std::list<Entry>;
+
+    SI_Error LoadData(const char* data, size_t size)
+    {
+        std::istringstream in(std::string(data, size));
+        std::string line;
+        Section* current = nullptr;
+
+        while (std::getline(in, line))
+        {
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+
+            if (line.empty() || line[0] == ';' || line[0] == '#')
+                continue;
+
+            if (line[0] == '[')
+            {
+                current = &Get(line.substr(1, line.find(']') - 1).c_str());
+                continue;
+            }
+
+            auto equals = line.find('=');
+            if (equals == std::string::npos || current == nullptr)
+                continue;
+
+            auto key = line.substr(0, equals);
+            while (!key.empty() && key.back() == ' ')
+                key.pop_back();
+
+            auto value = line.substr(equals + 1);
+            while (!value.empty() && value.front() == ' ')
+                value.erase(0, 1);
+
+            SetValue(current->Name.c_str(), key.c_str(), value.c_str());
+        }
+
+        return SI_OK;
+    }
+
+    SI_Error LoadFile(const wchar_t* path)
+    {
+        std::ifstream file(Narrow(path), std::ios::binary);
+
+        if (!file)
+            return SI_FILE;
+
+        std::stringstream data;
+        data << file.rdbuf();
+        auto text = data.str();
+        return LoadData(text.data(), text.size());
+    }
+
+    SI_Error SaveFile(const wchar_t* path) const
+    {
+        std::ofstream file(Narrow(path), std::ios::binary | std::ios::trunc);
+
+        if (!file)
+            return SI_FILE;
+
+        for (const auto& section : _sections)
+        {
+            file << "[" << section.Name << "]\n";
+
+            for (const auto& [key, value] : section.Keys)
+                file << key << "=" << value << "\n";
+
+            file << "\n";
+        }
+
+        return file ? SI_OK : SI_FILE;
+    }
+
+    const char* GetValue(const char* section, const char* key, const char* defaultValue) const
+    {
+        auto s = Find(section);
+
+        if (s == nullptr)
+            return defaultValue;
+
+        for (const auto& [k, v] : s->Keys)
+        {
+            if (strcasecmp(k.c_str(), key) == 0)
+                return v.c_str();
+        }
+
+        return defaultValue;
+    }
+
+    long GetLongValue(const char* section, const char* key, long defaultValue) const
+    {
+        auto value = GetValue(section, key, nullptr);
+        return value == nullptr ? defaultValue : atol(value);
+    }
+
+    void SetValue(const char* section, const char* key, const char* value)
+    {
+        auto& s = Get(section);
+
+        for (auto& [k, v] : s.Keys)
+        {
+            if (strcasecmp(k.c_str(), key) == 0)
+            {
+                v = value;
+                return;
+            }
+        }
+
+        s.Keys.push_back({ key, value });
+    }
+
+    void SetLongValue(const char* section, const char* key, long value)
+    {
+        SetValue(section, key, std::to_string(value).c_str());
+    }
+
+    // Only whole sections are deleted by GameProfiles
+    void Delete(const char* section, const char*)
+    {
+        std::erase_if(_sections, [section](const Section& s) { return strcasecmp(s.Name.c_str(), section) == 0; });
+    }
+
+    void GetAllSections(TNamesDepend& names) const
+    {
+        int order = 0;
+
+        for (const auto& section : _sections)
+            names.push_back({ section.Name.c_str(), order++ });
+    }
+
+    void GetAllKeys(const char* section, TNamesDepend& names) const
+    {
+        auto s = Find(section);
+
+        if (s == nullptr)
+            return;
+
+        int order = 0;
+
+        for (const auto& [key, value] : s->Keys)
+            names.push_back({ key.c_str(), order++ });
+    }
+
+  private:
+    struct Section
+    {
+        std::string Name;
+        std::vector<std::pair<std::string, std::string>> Keys;
+    };
+
+    static std::string Narrow(const wchar_t* text)
+    {
+        std::wstring wide(text);
+        return std::string(wide.begin(), wide.end());
+    }
+
+    const Section* Find(const char* name) const
+    {
+        for (const auto& s : _sections)
+        {
+            if (strcasecmp(s.Name.c_str(), name) == 0)
+                return &s;
+        }
+
+        return nullptr;
+    }
+
+    Section& Get(const char* name)
+    {
+        for (auto& s : _sections)
+        {
+            if (strcasecmp(s.Name.c_str(), name) == 0)
+                return s;
+        }
+
+        _sections.push_back({ name, {} });
+        return _sections.back();
+    }
+
+    std::vector<Section> _sections;
+};
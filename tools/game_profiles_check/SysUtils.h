@@ -0,0 +1,28 @@
+#pragma once
+
+// Linux stand-in for OptiScaler/SysUtils.h, just enough for GameProfiles, ConfigSchema & CustomOptional.
+// Warnings & errors are counted so the checks can see rejected profile lines.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include <strings.h>
+
+inline int logProblems = 0;
+
+#define LOG_DEBUG(...) ((void) 0)
+#define LOG_INFO(...) ((void) 0)
+#define LOG_WARN(...) (logProblems++)
+#define LOG_ERROR(...) (logProblems++)
+
+inline std::string wstring_to_string(const std::wstring& text) { return std::string(text.begin(), text.end()); }
+inline std::wstring string_to_wstring(const std::string& text) { return std::wstring(text.begin(), text.end()); }
+
+inline void to_lower_in_place(std::string& string)
+{
+    std::transform(string.begin(), string.end(), string.begin(), ::tolower);
+}
+
+inline int lstrcmpiA(const char* a, const char* b) { return strcasecmp(a, b); }
@@ -0,0 +1,362 @@
+// Checks of game profile matching, of the precedence between OptiScaler.ini, GameProfiles.user.ini,
+// GameProfiles.ini & built-in quirks, and of the shipped GameProfiles.ini.
+//
+// Build and run on Linux from this directory, the local headers stand in for the Windows ones:
+//   g++ -std=c++20 -I. -I../../OptiScaler -I../../OptiScaler/include -c ../../OptiScaler/misc/GameProfiles.cpp
+//   g++ -std=c++20 -I. -I../../OptiScaler -I../../OptiScaler/include game_profiles_check.cpp GameProfiles.o -o check
+//   ./check
+// Exits with 1 and prints the failed checks when something is off.
+
+#include <misc/GameProfiles.h>
+#include <ConfigSchema.h>
+#include <CustomOptional.h>
+#include <SimpleIni.h>
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+static int failures = 0;
+
+#define CHECK(expr)                                                                                                    \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expr))                                                                                                   \
+        {                                                                                                              \
+            printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #expr);                                                   \
+            failures++;                                                                                                \
+        }                                                                                                              \
+    } while (0)
+
+static const char* Shipped = "[GameProfiles]\n"
+                             "Version=1\n"
+                             "\n"
+                             "[Game]\n"
+                             "Exe=Game.exe|game-win64-shipping.exe\n"
+                             "Quirks=DisableHudfix|skipfirst10frames\n"
+                             "FrameGen.AllowedFrameAhead=2\n"
+                             "Spoofing.Dxgi=false\n"
+                             "\n"
+                             "[Game 1.2]\n"
+                             "Exe=game.exe\n"
+                             "ProductVersion=1.2\n"
+                             "DisabledQuirks=DisableDxgiSpoofing\n"
+                             "FrameGen.AllowedFrameAhead=3\n"
+                             "\n"
+                             "[Game 1.2.5]\n"
+                             "Exe=game.exe\n"
+                             "ProductVersion=1.2.5\n"
+                             "\n"
+                             "[Game Hashed]\n"
+                             "Exe=game.exe\n"
+                             "SHA1=ABCDEF\n";
+
+static const char* User = "[GameProfiles]\n"
+                          "Version=1\n"
+                          "\n"
+                          "[My Game 1.2]\n"
+                          "Exe=game.exe\n"
+                          "ProductVersion=1.2\n"
+                          "FrameGen.AllowedFrameAhead=4\n";
+
+static std::string ReadFile(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::stringstream data;
+    data << file.rdbuf();
+    return data.str();
+}
+
+static void Versions()
+{
+    GameProfiles profiles;
+
+    logProblems = 0;
+    CHECK(!profiles.Load("[GameProfiles]\nVersion=2\n", "future"));
+    CHECK(!profiles.Load("[Game]\nExe=game.exe\n", "no version"));
+    CHECK(profiles.Count() == 0);
+    CHECK(logProblems == 2);
+
+    // Profile without exe is skipped, unknown quirk is reported
+    logProblems = 0;
+    CHECK(profiles.Load("[GameProfiles]\nVersion=1\n[A]\nQuirks=DisableHudfix\n[B]\nExe=b.exe\nQuirks=Nope\n", "t"));
+    CHECK(profiles.Count() == 1);
+    CHECK(logProblems == 2);
+}
+
+static void Matching()
+{
+    GameProfiles profiles;
+    logProblems = 0;
+    CHECK(profiles.Load(Shipped, "shipped"));
+    CHECK(profiles.Count() == 4);
+    CHECK(logProblems == 0);
+
+    int hashed = 0;
+    auto hash = [&]()
+    {
+        hashed++;
+        return std::string("abcdef");
+    };
+    auto otherHash = [&]()
+    {
+        hashed++;
+        return std::string("012345");
+    };
+
+    CHECK(profiles.Find("other.exe", "1.2.0.0", hash) == nullptr);
+    CHECK(hashed == 0);
+
+    // Exe names are case insensitive, exe is only hashed when it has hash keyed profiles
+    auto profile = profiles.Find("GAME-Win64-Shipping.exe", "1.2.0.0", hash);
+    CHECK(profile != nullptr && profile->Name == "Game");
+    CHECK(hashed == 0);
+    CHECK(profile != nullptr && profile->Quirks[GameQuirk::DisableHudfix]);
+    CHECK(profile != nullptr && profile->Quirks[GameQuirk::SkipFirst10Frames]);
+    CHECK(profile != nullptr && profile->Quirks.count() == 2);
+    CHECK(profile != nullptr && profile->Options.size() == 2);
+
+    // Hash > longest product version prefix > exe only
+    profile = profiles.Find("game.exe", "1.2.5.0", hash);
+    CHECK(profile != nullptr && profile->Name == "Game Hashed");
+    CHECK(hashed == 1);
+
+    profile = profiles.Find("game.exe", "1.2.5.0", otherHash);
+    CHECK(profile != nullptr && profile->Name == "Game 1.2.5");
+
+    profile = profiles.Find("game.exe", "1.2.4.0", otherHash);
+    CHECK(profile != nullptr && profile->Name == "Game 1.2");
+
+    // Prefix is matched per version part, 1.2 doesn't match 1.20
+    profile = profiles.Find("game.exe", "1.20.0.0", otherHash);
+    CHECK(profile != nullptr && profile->Name == "Game");
+
+    profile = profiles.Find("game.exe", "", nullptr);
+    CHECK(profile != nullptr && profile->Name == "Game");
+
+    CHECK(profiles.Select("game.exe", "1.2.4.0", otherHash) == profiles.Active());
+    CHECK(profiles.Active() != nullptr && profiles.Active()->Name == "Game 1.2");
+}
+
+static void UserOverrides()
+{
+    GameProfiles profiles;
+    CHECK(profiles.Load(Shipped, "shipped"));
+    CHECK(profiles.Load(User, "user"));
+
+    // Same match keys replace the shipped profile, others are kept
+    auto profile = profiles.Find("game.exe", "1.2.0.0", nullptr);
+    CHECK(profile != nullptr && profile->Name == "My Game 1.2");
+    CHECK(profile != nullptr && profile->Source == "user");
+    CHECK(profile != nullptr && profile->Options.size() == 1 && profile->Options[0].second == "4");
+
+    profile = profiles.Find("game.exe", "1.2.5.0", nullptr);
+    CHECK(profile != nullptr && profile->Name == "Game 1.2.5");
+
+    profile = profiles.Find("game.exe", "1.3.0.0", nullptr);
+    CHECK(profile != nullptr && profile->Name == "Game");
+
+    // Export round trip, exported profile is found with the same keys
+    auto path = std::filesystem::temp_directory_path() / "opti_profiles_export.ini";
+    std::filesystem::remove(path);
+
+    GameProfile exported = *profiles.Find("game.exe", "", nullptr);
+    exported.Options.push_back({ "XeFG.DebugView", "true" });
+    CHECK(GameProfiles::Export(path, exported));
+
+    GameProfiles reloaded;
+    CHECK(reloaded.LoadFile(path));
+    profile = reloaded.Find("game-win64-shipping.exe", "9.0", nullptr);
+    CHECK(profile != nullptr && profile->Name == "Game");
+    CHECK(profile != nullptr && profile->Options.size() == 3);
+    CHECK(profile != nullptr && profile->Quirks == exported.Quirks);
+}
+
+// Same order as CheckQuirks in dllmain.cpp: OptiScaler.ini, profile options, profile quirks, built-in quirks
+struct Layers
+{
+    CustomOptional<bool> DxgiSpoofing { true };
+    CustomOptional<int> FGAllowedFrameAhead { 1 };
+    CustomOptional<int, NoDefault> SkipFirstFrames;
+
+    std::vector<ConfigOption> Schema {
+        { "Spoofing", "Dxgi", DxgiSpoofing },
+        { "FrameGen", "AllowedFrameAhead", FGAllowedFrameAhead, 1, 4 },
+        { "Hotfix", "SkipFirstFrames", SkipFirstFrames },
+    };
+
+    flag_set<GameQuirk> Quirks;
+
+    void Apply(const char* ini, const GameProfile* profile, flag_set<GameQuirk> builtIn)
+    {
+        CSimpleIniA file;
+        file.LoadData(ini, strlen(ini));
+
+        for (const auto& option : Schema)
+            option.Load(file.GetValue(option.Section(), option.Key(), "auto"));
+
+        Quirks = builtIn;
+
+        if (profile != nullptr)
+        {
+            Quirks |= profile->Quirks;
+            Quirks &= ~profile->DisabledQuirks;
+
+            for (const auto& [name, value] : profile->Options)
+            {
+                for (const auto& option : Schema)
+                {
+                    if (lstrcmpiA((std::string(option.Section()) + "." + option.Key()).c_str(), name.c_str()) == 0)
+                        option.LoadDefault(value);
+                }
+            }
+        }
+
+        if (Quirks & GameQuirk::DisableDxgiSpoofing && !DxgiSpoofing.has_value())
+            DxgiSpoofing.set_volatile_value(false);
+
+        if (Quirks & GameQuirk::SkipFirst10Frames && !SkipFirstFrames.has_value())
+            SkipFirstFrames.set_volatile_value(10);
+
+        if (Quirks & GameQuirk::AllowedFrameAhead2 && !FGAllowedFrameAhead.has_value())
+            FGAllowedFrameAhead.set_volatile_value(2);
+    }
+
+    std::string Saved(size_t index) const { return Schema[index].Text(); }
+};
+
+static void Precedence()
+{
+    GameProfiles profiles;
+    CHECK(profiles.Load(Shipped, "shipped"));
+    CHECK(profiles.Load(User, "user"));
+
+    flag_set<GameQuirk> builtIn;
+    builtIn |= GameQuirk::DisableDxgiSpoofing;
+    builtIn |= GameQuirk::AllowedFrameAhead2;
+
+    // Everything auto: profile values, then quirks for what the profile doesn't set
+    {
+        Layers layers;
+        layers.Apply("[Spoofing]\nDxgi=auto\n", profiles.Find("game-win64-shipping.exe", "", nullptr), builtIn);
+        CHECK(layers.FGAllowedFrameAhead.value_or_default() == 2);
+        CHECK(!layers.DxgiSpoofing.value_or_default());
+        CHECK(layers.SkipFirstFrames.value_or(0) == 10); // Quirk from the profile
+
+        // Profile & quirk values never end up in OptiScaler.ini
+        CHECK(layers.Saved(0) == "auto");
+        CHECK(layers.Saved(1) == "auto");
+        CHECK(layers.Saved(2) == "auto");
+    }
+
+    // OptiScaler.ini wins over the profile & quirks
+    {
+        Layers layers;
+        layers.Apply("[Spoofing]\nDxgi=true\n[FrameGen]\nAllowedFrameAhead=1\n[Hotfix]\nSkipFirstFrames=3\n",
+                     profiles.Find("game.exe", "", nullptr), builtIn);
+        CHECK(layers.DxgiSpoofing.value_or_default());
+        CHECK(layers.FGAllowedFrameAhead.value_or_default() == 1);
+        CHECK(layers.SkipFirstFrames.value_or(0) == 3);
+        CHECK(layers.Saved(2) == "3");
+    }
+
+    // GameProfiles.user.ini wins over GameProfiles.ini & quirks, disabled quirk of the shipped profile is gone
+    // with it and the built-in quirk applies again
+    {
+        Layers layers;
+        layers.Apply("", profiles.Find("game.exe", "1.2.0.0", nullptr), builtIn);
+        CHECK(layers.FGAllowedFrameAhead.value_or_default() == 4);
+        CHECK(!layers.DxgiSpoofing.value_or_default());
+    }
+
+    // Disabled quirk removes the built-in one
+    {
+        GameProfiles shipped;
+        CHECK(shipped.Load(Shipped, "shipped"));
+
+        Layers layers;
+        layers.Apply("", shipped.Find("game.exe", "1.2.0.0", nullptr), builtIn);
+        CHECK(layers.FGAllowedFrameAhead.value_or_default() == 3);
+        CHECK(layers.DxgiSpoofing.value_or_default());
+        CHECK(!(layers.Quirks & GameQuirk::DisableDxgiSpoofing));
+    }
+
+    // Out of range profile value is clamped like an ini value
+    {
+        GameProfiles clamped;
+        CHECK(clamped.Load("[GameProfiles]\nVersion=1\n[C]\nExe=c.exe\nFrameGen.AllowedFrameAhead=9\n", "c"));
+
+        Layers layers;
+        layers.Apply("", clamped.Find("c.exe", "", nullptr), {});
+        CHECK(layers.FGAllowedFrameAhead.value_or_default() == 4);
+    }
+}
+
+// Shipped GameProfiles.ini: loads without warnings, every option is a table option of Config.cpp and
+// every exe has built-in quirks, so the profile mirrors them
+static void ShippedFile()
+{
+    GameProfiles profiles;
+    logProblems = 0;
+    CHECK(profiles.LoadFile("../../GameProfiles.ini"));
+    CHECK(logProblems == 0);
+    CHECK(profiles.Count() > 0);
+
+    auto config = ReadFile("../../OptiScaler/Config.cpp");
+    CHECK(!config.empty());
+
+    auto profile = profiles.Find("tlou-i.exe", "", nullptr);
+    CHECK(profile != nullptr && profile->Name == "The Last of Us Part I");
+
+    const char* exes[] = { "tlou-i.exe",
+                           "horizonforbiddenwest.exe",
+                           "visionsofmana-win64-shipping.exe",
+                           "shf-win64-shipping.exe",
+                           "project_plague-deck-shipping.exe",
+                           "em-win64-shipping.exe",
+                           "ffxiv_dx11.exe",
+                           "wwm.exe",
+                           "forza_gaming.desktop.x64_release_final.exe",
+                           "thecallistoprotocol-win64-shipping.exe",
+                           "returnal-wingdk-shipping.exe",
+                           "prey.exe" };
+
+    for (const auto& exe : exes)
+    {
+        profile = profiles.Find(exe, "", nullptr);
+        CHECK(profile != nullptr);
+
+        if (profile == nullptr)
+            continue;
+
+        CHECK(getQuirksForExe(exe).count() > 0);
+
+        for (const auto& [name, value] : profile->Options)
+        {
+            auto dot = name.find('.');
+            auto entry = "{ \"" + name.substr(0, dot) + "\", \"" + name.substr(dot + 1) + "\",";
+
+            if (config.find(entry) == std::string::npos)
+            {
+                printf("Unknown option %s in profile %s\n", name.c_str(), profile->Name.c_str());
+                failures++;
+            }
+        }
+    }
+}
+
+int main()
+{
+    Versions();
+    Matching();
+    UserOverrides();
+    Precedence();
+    ShippedFile();
+
+    if (failures == 0)
+        printf("All checks passed\n");
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+// Linux stand-in for the parts of magic_enum which GameProfiles uses.
+// Names come from __PRETTY_FUNCTION__ like in the real library, values 0-127 are scanned.
+
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <strings.h>
+
+namespace magic_enum
+{
+struct case_insensitive_t
+{
+};
+
+inline constexpr case_insensitive_t case_insensitive {};
+
+namespace detail
+{
+constexpr size_t MaxValues = 128;
+
+template <auto V> std::string_view RawName() { return __PRETTY_FUNCTION__; }
+
+// "... [with auto V = GameQuirk::DisableHudfix; ...]", values without a name are printed as "(GameQuirk)60"
+template <auto V> std::string_view Name()
+{
+    auto raw = RawName<V>();
+    auto start = raw.find("V = ") + 4;
+    auto name = raw.substr(start, raw.find_first_of(";]", start) - start);
+
+    if (name.starts_with('('))
+        return {};
+
+    return name.substr(name.rfind("::") + 2);
+}
+
+template <typename E, size_t... I> std::vector<std::pair<E, std::string_view>> Scan(std::index_sequence<I...>)
+{
+    std::vector<std::pair<E, std::string_view>> entries;
+    ((Name<(E) I>().empty() ? void() : entries.push_back({ (E) I, Name<(E) I>() })), ...);
+    return entries;
+}
+
+template <typename E> const std::vector<std::pair<E, std::string_view>>& Entries()
+{
+    static auto entries = Scan<E>(std::make_index_sequence<MaxValues> {});
+    return entries;
+}
+} // namespace detail
+
+template <typename E> std::vector<E> enum_values()
+{
+    std::vector<E> values;
+
+    for (const auto& [value, name] : detail::Entries<E>())
+        values.push_back(value);
+
+    return values;
+}
+
+template <typename E> std::string_view enum_name(E value)
+{
+    for (const auto& [entry, name] : detail::Entries<E>())
+    {
+        if (entry == value)
+            return name;
+    }
+
+    return {};
+}
+
+template <typename E> std::optional<E> enum_cast(std::string_view text, case_insensitive_t)
+{
+    for (const auto& [value, name] : detail::Entries<E>())
+    {
+        if (name.size() == text.size() && strncasecmp(name.data(), text.data(), text.size()) == 0)
+            return value;
+    }
+
+    return std::nullopt;
+}
+} // namespace magic_enum
@@ -0,0 +1,6 @@
+#pragma once
+
+// Linux stand-in for OptiScaler/SysUtils.h, just enough for HudlessCandidates.h
+
+#include <cstddef>
+#include <cstdint>
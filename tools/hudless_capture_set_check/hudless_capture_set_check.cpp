@@ -0,0 +1,362 @@
+// Checks of HudlessCaptureSet (inserts, lookups, full set, clear, concurrent inserts with lock free readers) and of
+// the swapchain key / match packing, then a per frame benchmark against the std::set + mutex capture list it replaced.
+//
+// Build and run on Linux from this directory, the local SysUtils.h stands in for the Windows one:
+//   g++ -std=c++20 -O2 -pthread -I. -I../../OptiScaler hudless_capture_set_check.cpp -o check
+//   ./check [frames]
+// Exits with 1 and prints the failed checks when something is off.
+// Two threads inserting the same resource into the same empty slot only overlap on a machine with several cores,
+// on a single core the concurrent checks mostly see inserts one after the other.
+
+#include <hudfix/HudlessCandidates.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(expr)                                                                                                    \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expr))                                                                                                   \
+        {                                                                                                              \
+            printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #expr);                                                   \
+            failures++;                                                                                                \
+        }                                                                                                              \
+    } while (0)
+
+// Same capacity as Hudfix_Dx12
+static constexpr size_t Capacity = 4096;
+using CaptureSet = HudlessCaptureSet<Capacity>;
+
+// Fake resource pointers, page aligned like committed resources so the low bits are all zero
+static const void* Resource(size_t index) { return (const void*) (0x7f0000000000ull + (index + 1) * 0x10000ull); }
+
+static void Basics()
+{
+    auto set = std::make_unique<CaptureSet>();
+
+    CHECK(set->Count() == 0);
+    CHECK(!set->Contains(Resource(0)));
+
+    CHECK(set->Insert(Resource(0)));
+    CHECK(set->Insert(Resource(1)));
+    CHECK(set->Count() == 2);
+
+    // Inserting again is not a new entry
+    CHECK(set->Insert(Resource(0)));
+    CHECK(set->Count() == 2);
+
+    CHECK(set->Contains(Resource(0)));
+    CHECK(set->Contains(Resource(1)));
+    CHECK(!set->Contains(Resource(2)));
+
+    set->Clear();
+    CHECK(set->Count() == 0);
+    CHECK(!set->Contains(Resource(0)));
+    CHECK(!set->Contains(Resource(1)));
+
+    // Usable again after clear
+    CHECK(set->Insert(Resource(1)));
+    CHECK(set->Contains(Resource(1)));
+    CHECK(set->Count() == 1);
+}
+
+static void Full()
+{
+    HudlessCaptureSet<64> set;
+
+    bool allInserted = true;
+
+    for (size_t i = 0; i < 64; i++)
+        allInserted &= set.Insert(Resource(i));
+
+    CHECK(allInserted);
+    CHECK(set.Count() == 64);
+
+    // No free slot left, a new one fails but ones already in still succeed
+    CHECK(!set.Insert(Resource(64)));
+    CHECK(set.Insert(Resource(10)));
+    CHECK(set.Count() == 64);
+
+    bool allFound = true;
+
+    for (size_t i = 0; i < 64; i++)
+        allFound &= set.Contains(Resource(i));
+
+    CHECK(allFound);
+
+    // Lookup of a missing one has no empty slot to stop at, it must still end
+    CHECK(!set.Contains(Resource(64)));
+
+    // One slot left, it's found wherever the probe of the new resource starts
+    bool lastSlotFound = true;
+
+    for (size_t candidate = 1000; candidate < 1500 && lastSlotFound; candidate++)
+    {
+        HudlessCaptureSet<64> almostFull;
+
+        for (size_t i = 0; i < 63; i++)
+            almostFull.Insert(Resource(i));
+
+        lastSlotFound = almostFull.Insert(Resource(candidate)) && almostFull.Contains(Resource(candidate));
+    }
+
+    CHECK(lastSlotFound);
+}
+
+// Thousands of aligned pointers, every one must be found through its probe chain
+static void ManyResources()
+{
+    auto set = std::make_unique<CaptureSet>();
+
+    for (size_t frame = 0; frame < 3; frame++)
+    {
+        set->Clear();
+
+        bool allInserted = true;
+        bool allFound = true;
+        bool noneMissing = true;
+
+        for (size_t i = 0; i < 3500; i++)
+            allInserted &= set->Insert(Resource(frame * 1000 + i));
+
+        for (size_t i = 0; i < 3500; i++)
+            allFound &= set->Contains(Resource(frame * 1000 + i));
+
+        for (size_t i = 3500; i < 7000; i++)
+            noneMissing &= !set->Contains(Resource(frame * 1000 + i));
+
+        CHECK(allInserted);
+        CHECK(allFound);
+        CHECK(noneMissing);
+        CHECK(set->Count() == 3500);
+    }
+}
+
+static void MatchPacking()
+{
+    auto key = HudlessSwapchainKey(3840, 2160, 28);
+    auto other = HudlessSwapchainKey(2560, 1440, 28);
+    auto otherFormat = HudlessSwapchainKey(3840, 2160, 24);
+
+    CHECK(key != other);
+    CHECK(key != otherFormat);
+
+    // Zero initialized resource info never matches any swapchain
+    CHECK(key != 0);
+    CHECK(HudlessSwapchainKey(0, 0, 0) != 0);
+
+    uint8_t flags = HudlessMatch_Usable | HudlessMatch_Size | HudlessMatch_Format;
+    auto state = HudlessMatchState(key, flags);
+
+    CHECK(HudlessStateKey(state) == key);
+    CHECK(HudlessStateMatch(state) == flags);
+    CHECK(HudlessStateKey(state) != other);
+
+    // Flags use bits the key never has, so all of them round trip for the biggest key
+    auto biggest = HudlessSwapchainKey(0xFFFFF, 0xFFFFF, 0xFFF);
+    CHECK((biggest & HudlessMatchMask) == 0);
+    CHECK(HudlessStateKey(HudlessMatchState(biggest, 0xFF)) == biggest);
+    CHECK(HudlessStateMatch(HudlessMatchState(biggest, 0xFF)) == 0xFF);
+    CHECK(HudlessStateMatch(HudlessMatchState(biggest, HudlessMatch_None)) == HudlessMatch_None);
+}
+
+// Hudfix inserts from the draw/dispatch threads of the game, one insert per resource and check.
+// Every thread inserts the same resources in its own order, some only from one thread.
+static void ConcurrentInserts()
+{
+    constexpr size_t Threads = 8;
+    constexpr size_t Shared = 2000;
+    constexpr size_t PerThread = 200;
+    constexpr size_t Preinserted = 100;
+
+    auto set = std::make_unique<CaptureSet>();
+
+    for (size_t round = 0; round < 20; round++)
+    {
+        set->Clear();
+
+        // Already captured ones, readers must never miss these while others insert
+        for (size_t i = 0; i < Preinserted; i++)
+            set->Insert(Resource(100000 + i));
+
+        std::atomic<bool> go { false };
+        std::atomic<size_t> failedInserts { 0 };
+        std::atomic<size_t> missedLookups { 0 };
+        std::atomic<size_t> writersDone { 0 };
+        std::vector<std::thread> threads;
+
+        for (size_t t = 0; t < Threads; t++)
+        {
+            threads.emplace_back(
+                [&, t]
+                {
+                    std::vector<size_t> order;
+
+                    for (size_t i = 0; i < Shared; i++)
+                        order.push_back(i);
+
+                    for (size_t i = 0; i < PerThread; i++)
+                        order.push_back(Shared + t * PerThread + i);
+
+                    std::shuffle(order.begin(), order.end(), std::mt19937((uint32_t) (round * Threads + t)));
+
+                    while (!go.load(std::memory_order_acquire))
+                        ;
+
+                    for (auto index : order)
+                    {
+                        if (!set->Insert(Resource(index)))
+                            failedInserts++;
+
+                        // Own insert is visible right away
+                        if (!set->Contains(Resource(index)))
+                            missedLookups++;
+                    }
+
+                    writersDone++;
+                });
+        }
+
+        // Lock free reader like CheckResource with "only captured resources"
+        threads.emplace_back(
+            [&]
+            {
+                while (!go.load(std::memory_order_acquire))
+                    ;
+
+                while (writersDone.load() < Threads)
+                {
+                    for (size_t i = 0; i < Preinserted; i++)
+                    {
+                        if (!set->Contains(Resource(100000 + i)))
+                            missedLookups++;
+                    }
+                }
+            });
+
+        go.store(true, std::memory_order_release);
+
+        for (auto& thread : threads)
+            thread.join();
+
+        CHECK(failedInserts == 0);
+        CHECK(missedLookups == 0);
+
+        // Racing inserts of the same resource end up in one slot, counted once
+        CHECK(set->Count() == Preinserted + Shared + Threads * PerThread);
+
+        bool allFound = true;
+
+        for (size_t i = 0; i < Shared + Threads * PerThread; i++)
+            allFound &= set->Contains(Resource(i));
+
+        CHECK(allFound);
+
+        if (failures > 0)
+            break;
+    }
+}
+
+// Capture list before HudlessCaptureSet
+struct LockedSet
+{
+    std::mutex Mutex;
+    std::set<const void*> Set;
+
+    void Insert(const void* resource)
+    {
+        std::scoped_lock lock(Mutex);
+        Set.insert(resource);
+    }
+
+    bool Contains(const void* resource)
+    {
+        std::scoped_lock lock(Mutex);
+        return Set.contains(resource);
+    }
+
+    void Clear()
+    {
+        std::scoped_lock lock(Mutex);
+        Set.clear();
+    }
+};
+
+// One frame of Hudfix: clear at upscale start, insert every captured resource, then the checks of the following
+// draws & dispatches look up each resource a few times (hits) and the ones never captured (misses)
+template <typename Set> static double NsPerFrame(Set& set, size_t frames, size_t resources)
+{
+    constexpr size_t LookupsPerResource = 4;
+
+    auto start = std::chrono::steady_clock::now();
+    size_t hits = 0;
+
+    for (size_t frame = 0; frame < frames; frame++)
+    {
+        set.Clear();
+
+        for (size_t i = 0; i < resources; i++)
+            set.Insert(Resource(i));
+
+        for (size_t n = 0; n < LookupsPerResource; n++)
+        {
+            for (size_t i = 0; i < resources; i++)
+                hits += set.Contains(Resource(i + (n & 1) * resources)) ? 1 : 0;
+        }
+    }
+
+    auto ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    // Half of the lookups are hits
+    CHECK(hits == frames * resources * LookupsPerResource / 2);
+
+    return ns / (double) frames;
+}
+
+static void Benchmark(size_t frames)
+{
+    if (frames == 0)
+        return;
+
+    auto set = std::make_unique<CaptureSet>();
+    LockedSet locked;
+
+    printf("%10s %10s %16s %16s\n", "resources", "load", "std::set us", "capture set us");
+
+    for (size_t resources : { 500, 1000, 2000, 3000, 3500 })
+    {
+        auto lockedNs = NsPerFrame(locked, frames, resources);
+        auto setNs = NsPerFrame(*set, frames, resources);
+
+        printf("%10zu %9.0f%% %16.1f %16.1f\n", resources, resources * 100.0 / Capacity, lockedNs / 1000.0,
+               setNs / 1000.0);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    size_t frames = argc > 1 ? strtoull(argv[1], nullptr, 10) : 500;
+
+    Basics();
+    Full();
+    ManyResources();
+    MatchPacking();
+    ConcurrentInserts();
+    Benchmark(frames);
+
+    if (failures == 0)
+        printf("All checks passed\n");
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,421 @@
+// Feeds synthetic HV_Dx12 tile stats of 1080p frames through HudlessValidator the same way Hudfix_Dx12 does
+// (WantsSample, results HV_NUM_OF_SLOTS frames later, AddSample, Retry every frame): correct picks getting trusted,
+// dims / fades / pause menus not rejecting a candidate which matched before, wrong picks being rejected with the
+// back-off doubling up to its cap and candidates recovering after a back-off.
+//
+// Build and run on Linux from this directory:
+//   g++ -std=c++20 -O2 -I. -I../../OptiScaler hudless_validator_check.cpp
+//       ../../OptiScaler/hudfix/HudlessValidator.cpp -o check
+//   ./check
+// Exits with 1 and prints the failed checks when something is off.
+
+#include <hudfix/HudlessValidator.h>
+
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <map>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(expr)                                                                                                    \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expr))                                                                                                   \
+        {                                                                                                              \
+            printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #expr);                                                   \
+            failures++;                                                                                                \
+        }                                                                                                              \
+    } while (0)
+
+static constexpr uint32_t Width = 1920;
+static constexpr uint32_t Height = 1080;
+static constexpr uint32_t TileSize = 32; // HV_Dx12::TileSize
+static constexpr uint32_t TilesX = (Width + TileSize - 1) / TileSize;
+static constexpr uint32_t TilesY = (Height + TileSize - 1) / TileSize;
+static constexpr uint64_t ReadbackDelay = 4; // HV_NUM_OF_SLOTS
+
+enum class Scene
+{
+    Gameplay,    // Correct hudless, differs only under the HUD
+    NoHud,       // Photo mode, cutscene, same image
+    Dim,         // Pause menu darkening everything a bit
+    FadeToBlack, // Loading screen transitions
+    WrongPick,   // Target from before tonemapping, differs everywhere
+    Mismatch,    // Most of the image differs but not all, game switched to another target
+};
+
+// Share of the tile's pixels which differ and their mean delta (0.0 - 1.0)
+static HudlessTileStats Tile(uint32_t pixels, double diffShare, double delta)
+{
+    HudlessTileStats tile {};
+    tile.Pixels = pixels;
+    tile.DiffPixels = (uint32_t) (pixels * diffShare);
+    tile.DeltaSum = (uint32_t) (tile.DiffPixels * delta * 255.0);
+    tile.MaxDelta = tile.DiffPixels > 0 ? (uint32_t) std::min(255.0, delta * 2.0 * 255.0) : 0;
+    return tile;
+}
+
+static bool HudTile(uint32_t x, uint32_t y)
+{
+    // Health & ammo bar at the bottom, minimap at top left, crosshair
+    return y >= TilesY - 3 || (x < 6 && y < 5) || (x == TilesX / 2 && y == TilesY / 2);
+}
+
+static std::vector<HudlessTileStats> Tiles(Scene scene)
+{
+    std::vector<HudlessTileStats> tiles;
+
+    for (uint32_t y = 0; y < TilesY; y++)
+    {
+        for (uint32_t x = 0; x < TilesX; x++)
+        {
+            auto w = std::min(TileSize, Width - x * TileSize);
+            auto h = std::min(TileSize, Height - y * TileSize);
+            auto pixels = w * h;
+
+            switch (scene)
+            {
+            case Scene::Gameplay:
+                // Few pixels of TAA noise everywhere else, below the tile coverage limit
+                tiles.push_back(HudTile(x, y) ? Tile(pixels, 0.3, 0.5) : Tile(pixels, 0.005, 0.02));
+                break;
+
+            case Scene::NoHud:
+                tiles.push_back(Tile(pixels, 0.0, 0.0));
+                break;
+
+            case Scene::Dim:
+                tiles.push_back(Tile(pixels, 1.0, HudTile(x, y) ? 0.5 : 0.12));
+                break;
+
+            case Scene::FadeToBlack:
+                tiles.push_back(Tile(pixels, 0.95, 0.45));
+                break;
+
+            case Scene::WrongPick:
+                tiles.push_back(Tile(pixels, 0.9, 0.3));
+                break;
+
+            case Scene::Mismatch:
+                tiles.push_back(x < TilesX * 4 / 5 ? Tile(pixels, 0.6, 0.15) : Tile(pixels, 0.0, 0.0));
+                break;
+            }
+        }
+    }
+
+    return tiles;
+}
+
+static HudlessStats Stats(Scene scene)
+{
+    auto tiles = Tiles(scene);
+    return HudlessValidator::Reduce(tiles.data(), tiles.size());
+}
+
+// Hudfix_Dx12 & HV_Dx12 stand-in, candidates are Hudfix's hudless sources
+struct Sim
+{
+    struct Pending
+    {
+        uint64_t Ready;
+        uint64_t Id;
+        HudlessStats Stats;
+    };
+
+    struct Event
+    {
+        uint64_t Id;
+        uint64_t Frame;
+    };
+
+    HudlessValidator Validator;
+    std::map<uint64_t, bool> Enabled;
+    std::deque<Pending> InFlight;
+    uint64_t Frame = 1;
+    uint32_t Samples = 0;
+
+    std::vector<Event> Rejections;
+    std::vector<Event> Retries;
+    std::vector<Event> Trusted;
+
+    void Add(uint64_t id) { Enabled[id] = true; }
+
+    void Step(const std::function<Scene(uint64_t id)>& sceneOf)
+    {
+        Validator.Retry(Frame,
+                        [this](uint64_t id)
+                        {
+                            Enabled[id] = true;
+                            Retries.push_back({ id, Frame });
+                        });
+
+        while (!InFlight.empty() && InFlight.front().Ready <= Frame)
+        {
+            auto pending = InFlight.front();
+            InFlight.pop_front();
+
+            auto verdict = Validator.AddSample(pending.Id, pending.Stats, Frame);
+
+            if (verdict == HudlessVerdict::Bad)
+            {
+                Enabled[pending.Id] = false;
+                Rejections.push_back({ pending.Id, Frame });
+            }
+            else if (verdict == HudlessVerdict::Good)
+            {
+                Trusted.push_back({ pending.Id, Frame });
+            }
+        }
+
+        for (auto& [id, enabled] : Enabled)
+        {
+            if (!enabled || !Validator.WantsSample(id, Frame))
+                continue;
+
+            InFlight.push_back({ Frame + ReadbackDelay, id, Stats(sceneOf(id)) });
+            Samples++;
+        }
+
+        Frame++;
+    }
+
+    void Run(uint64_t frames, Scene scene)
+    {
+        for (uint64_t i = 0; i < frames; i++)
+            Step([scene](uint64_t) { return scene; });
+    }
+};
+
+static uint64_t RejectionsOf(const Sim& sim, uint64_t id)
+{
+    uint64_t count = 0;
+
+    for (auto& event : sim.Rejections)
+        count += event.Id == id;
+
+    return count;
+}
+
+static void Reduce()
+{
+    auto gameplay = Stats(Scene::Gameplay);
+    CHECK(gameplay.Tiles == TilesX * TilesY);
+    CHECK(gameplay.Pixels == (uint64_t) Width * Height);
+    CHECK(gameplay.ChangedTiles == 3 * TilesX + 30 + 1);
+    CHECK(HudlessValidator::Score(gameplay) == HudlessVerdict::Good);
+    CHECK(!HudlessValidator::WholeImage(gameplay));
+
+    // Unfinished copy or tiles outside the image are skipped
+    std::vector<HudlessTileStats> tiles { Tile(1024, 0.5, 0.5), {}, Tile(1024, 0.0, 0.0) };
+    tiles.push_back({ 100, 200, 0, 0 });
+
+    auto stats = HudlessValidator::Reduce(tiles.data(), tiles.size());
+    CHECK(stats.Tiles == 2);
+    CHECK(stats.Pixels == 2048);
+    CHECK(stats.DiffPixels == 512);
+    CHECK(stats.ChangedTiles == 1);
+    CHECK(stats.Coverage() == 0.25f);
+    CHECK(std::abs(stats.MeanDelta - 512 * 0.5f / 2048) < 0.001f);
+
+    // Exactly the tile coverage limit isn't a changed tile
+    HudlessTileStats limit { 1000, 10, 100, 20 };
+    HudlessTileStats above { 1000, 11, 100, 20 };
+    CHECK(HudlessValidator::Reduce(&limit, 1).ChangedTiles == 0);
+    CHECK(HudlessValidator::Reduce(&above, 1).ChangedTiles == 1);
+
+    // Single sample verdicts of the scenes
+    CHECK(HudlessValidator::Score(Stats(Scene::NoHud)) == HudlessVerdict::Unknown);
+    CHECK(HudlessValidator::Score(Stats(Scene::Dim)) == HudlessVerdict::Bad);
+    CHECK(HudlessValidator::Score(Stats(Scene::FadeToBlack)) == HudlessVerdict::Bad);
+    CHECK(HudlessValidator::Score(Stats(Scene::WrongPick)) == HudlessVerdict::Bad);
+    CHECK(HudlessValidator::WholeImage(Stats(Scene::Dim)));
+    CHECK(HudlessValidator::WholeImage(Stats(Scene::FadeToBlack)));
+    CHECK(HudlessValidator::Score(Stats(Scene::Mismatch)) == HudlessVerdict::Bad);
+    CHECK(!HudlessValidator::WholeImage(Stats(Scene::Mismatch)));
+
+    // Few tiles but very different is a wrong pick too
+    std::vector<HudlessTileStats> strong(100, Tile(1024, 0.0, 0.0));
+    strong[0] = Tile(1024, 1.0, 1.0);
+    strong[1] = Tile(1024, 1.0, 1.0);
+    for (int i = 2; i < 40; i++)
+        strong[i] = Tile(1024, 1.0, 0.5);
+
+    CHECK(HudlessValidator::Score(HudlessValidator::Reduce(strong.data(), strong.size())) == HudlessVerdict::Bad);
+}
+
+static void CorrectPick()
+{
+    Sim sim;
+    sim.Add(1);
+    sim.Run(2000, Scene::Gameplay);
+
+    CHECK(sim.Rejections.empty());
+    CHECK(sim.Trusted.size() == 1);
+    CHECK(sim.Validator.Verdict(1) == HudlessVerdict::Good);
+
+    // One sample every SampleInterval frames, none after it's trusted
+    auto trustFrame = HudlessValidator::TrustSamples * HudlessValidator::SampleInterval + ReadbackDelay;
+    CHECK(!sim.Trusted.empty() && sim.Trusted[0].Frame >= trustFrame - HudlessValidator::SampleInterval &&
+          sim.Trusted[0].Frame <= trustFrame + 1);
+    CHECK(sim.Samples <= HudlessValidator::TrustSamples + ReadbackDelay);
+
+    // Image without HUD tells nothing
+    Sim noHud;
+    noHud.Add(1);
+    noHud.Run(5000, Scene::NoHud);
+    CHECK(noHud.Rejections.empty() && noHud.Trusted.empty());
+    CHECK(noHud.Validator.Verdict(1) == HudlessVerdict::Unknown);
+
+    noHud.Run(2000, Scene::Gameplay);
+    CHECK(noHud.Validator.Verdict(1) == HudlessVerdict::Good);
+}
+
+// Whole image changes are ignored once the candidate matched the final image
+static void DimAndFadeAfterMatch()
+{
+    Sim sim;
+    sim.Add(1);
+    sim.Run(100, Scene::Gameplay);
+
+    // Long pause menu, then a loading screen
+    sim.Run(3000, Scene::Dim);
+    sim.Run(600, Scene::FadeToBlack);
+    CHECK(sim.Rejections.empty());
+    CHECK(sim.Validator.Verdict(1) == HudlessVerdict::Unknown);
+
+    sim.Run(1200, Scene::Gameplay);
+    CHECK(sim.Rejections.empty());
+    CHECK(sim.Validator.Verdict(1) == HudlessVerdict::Good);
+
+    // Menus opened now and then before it's trusted
+    Sim menus;
+    menus.Add(1);
+
+    for (int i = 0; i < 6; i++)
+    {
+        menus.Run(240, Scene::Gameplay);
+        menus.Run(240, i % 2 == 0 ? Scene::Dim : Scene::FadeToBlack);
+    }
+
+    menus.Run(400, Scene::Gameplay);
+    CHECK(menus.Rejections.empty());
+    CHECK(menus.Validator.Verdict(1) == HudlessVerdict::Good);
+}
+
+static void WrongPick()
+{
+    Sim sim;
+    sim.Add(1);
+    sim.Add(2);
+
+    // 2 is the right one
+    auto sceneOf = [](uint64_t id) { return id == 1 ? Scene::WrongPick : Scene::Gameplay; };
+
+    for (int i = 0; i < 60000; i++)
+        sim.Step(sceneOf);
+
+    CHECK(RejectionsOf(sim, 2) == 0);
+    CHECK(sim.Validator.Verdict(2) == HudlessVerdict::Good);
+
+    // Rejected after RejectSamples samples
+    auto firstReject = HudlessValidator::RejectSamples * HudlessValidator::SampleInterval + ReadbackDelay;
+    CHECK(!sim.Rejections.empty() && sim.Rejections[0].Id == 1);
+    CHECK(!sim.Rejections.empty() && sim.Rejections[0].Frame >= firstReject - HudlessValidator::SampleInterval &&
+          sim.Rejections[0].Frame <= firstReject + 1);
+
+    // Every rejection is retried after the back off, doubled each time up to 8x
+    CHECK(sim.Retries.size() >= 5);
+    CHECK(sim.Rejections.size() >= sim.Retries.size());
+
+    bool backOff = true;
+
+    for (size_t i = 0; i < sim.Retries.size() && i < sim.Rejections.size(); i++)
+    {
+        auto shift = std::min((uint32_t) i, HudlessValidator::MaxRetryShift);
+        backOff &= sim.Retries[i].Frame - sim.Rejections[i].Frame == HudlessValidator::RetryFrames << shift;
+        backOff &= sim.Retries[i].Id == 1;
+    }
+
+    CHECK(backOff);
+
+    // Matched for a while then the game changed its target, only recent samples count
+    Sim changed;
+    changed.Add(1);
+    changed.Run(400, Scene::Gameplay);
+    changed.Run(1200, Scene::Mismatch);
+    CHECK(changed.Rejections.size() == 1);
+    CHECK(changed.Validator.Verdict(1) == HudlessVerdict::Bad);
+
+    // Retry starts from a clean history, still wrong is rejected as fast as a new candidate
+    changed.Run(HudlessValidator::RetryFrames + 800, Scene::Mismatch);
+    CHECK(changed.Retries.size() == 1 && changed.Rejections.size() == 2);
+
+    if (changed.Retries.size() == 1 && changed.Rejections.size() == 2)
+        CHECK(changed.Rejections[1].Frame - changed.Retries[0].Frame <= firstReject + 1);
+
+    // Disabled between rejection and retry, nothing sampled
+    CHECK(sim.Samples < HudlessValidator::TrustSamples + 60000 / HudlessValidator::SampleInterval / 4);
+}
+
+// Loading screen before the first match rejects a correct candidate, it comes back after the back off
+static void RecoveryAfterBackOff()
+{
+    Sim sim;
+    sim.Add(1);
+    sim.Run(800, Scene::FadeToBlack);
+
+    CHECK(sim.Rejections.size() == 1);
+    CHECK(sim.Validator.Verdict(1) == HudlessVerdict::Bad);
+    CHECK(!sim.Enabled[1]);
+
+    auto rejectFrame = sim.Rejections.empty() ? 0 : sim.Rejections[0].Frame;
+    auto samples = sim.Samples;
+
+    // Game is running normally meanwhile, but the candidate isn't sampled
+    sim.Run(HudlessValidator::RetryFrames - (sim.Frame - rejectFrame), Scene::Gameplay);
+    CHECK(sim.Retries.empty());
+    CHECK(sim.Samples == samples);
+
+    sim.Run(1, Scene::Gameplay);
+    CHECK(sim.Retries.size() == 1);
+    CHECK(sim.Enabled[1]);
+    CHECK(sim.Validator.Verdict(1) == HudlessVerdict::Unknown);
+
+    // Earlier bad samples don't count anymore
+    sim.Run(1200, Scene::Gameplay);
+    CHECK(sim.Rejections.size() == 1);
+    CHECK(sim.Validator.Verdict(1) == HudlessVerdict::Good);
+
+    // Removed & reset candidates aren't retried
+    Sim removed;
+    removed.Add(1);
+    removed.Add(2);
+    removed.Run(800, Scene::WrongPick);
+    CHECK(removed.Rejections.size() == 2);
+
+    removed.Validator.Remove(1);
+    removed.Run(HudlessValidator::RetryFrames, Scene::WrongPick);
+    CHECK(removed.Retries.size() == 1);
+    CHECK(!removed.Retries.empty() && removed.Retries[0].Id == 2);
+
+    removed.Run(800, Scene::WrongPick);
+    removed.Validator.Reset();
+    removed.Run(HudlessValidator::RetryFrames * 8, Scene::NoHud);
+    CHECK(removed.Retries.size() == 1);
+}
+
+int main()
+{
+    Reduce();
+    CorrectPick();
+    DimAndFadeAfterMatch();
+    WrongPick();
+    RecoveryAfterBackOff();
+
+    if (failures == 0)
+        printf("All checks passed\n");
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+// Linux stand-in for OptiScaler/SysUtils.h, just enough for JitterAnalyzer
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#define LOG_TRACE(...) ((void) 0)
+#define LOG_DEBUG(...) ((void) 0)
+#define LOG_INFO(...) ((void) 0)
+#define LOG_WARN(...) ((void) 0)
+#define LOG_ERROR(...) ((void) 0)
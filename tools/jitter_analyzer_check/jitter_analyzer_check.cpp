@@ -0,0 +1,289 @@
+// Feeds synthetic jitter sequences through JitterAnalyzer::AddSample and checks what it detects: 8 / 16 / 32 / 72
+// phase Halton(2, 3) sequences in pixels and NDC, flipped axes, zero jitter, random jitter and sequence resets.
+//
+// Build and run on Linux from this directory:
+//   g++ -std=c++20 -O2 -I. -I../../OptiScaler jitter_analyzer_check.cpp ../../OptiScaler/upscalers/JitterAnalyzer.cpp
+//       -o check
+//   ./check
+// Exits with 1 and prints the failed checks when something is off.
+
+#include <upscalers/JitterAnalyzer.h>
+
+#include <cstdio>
+#include <random>
+
+static int failures = 0;
+
+#define CHECK(expr)                                                                                                    \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expr))                                                                                                   \
+        {                                                                                                              \
+            printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #expr);                                                   \
+            failures++;                                                                                                \
+        }                                                                                                              \
+    } while (0)
+
+static constexpr uint32_t RenderWidth = 1280;
+static constexpr uint32_t RenderHeight = 720;
+
+static float Halton(uint32_t index, uint32_t base)
+{
+    float f = 1.0f;
+    float result = 0.0f;
+
+    while (index > 0)
+    {
+        f /= (float) base;
+        result += f * (float) (index % base);
+        index /= base;
+    }
+
+    return result;
+}
+
+// How games usually generate it (FSR / DLSS samples), 1 based Halton(2, 3) in pixels
+struct Sequence
+{
+    uint32_t Phases = 8;
+    float ScaleX = 1.0f;
+    float ScaleY = 1.0f;
+    uint32_t Index = 0;
+
+    void Feed(JitterAnalyzer& analyzer, uint32_t frames)
+    {
+        for (uint32_t i = 0; i < frames; i++)
+        {
+            auto phase = (Index++ % Phases) + 1;
+            analyzer.AddSample((Halton(phase, 2) - 0.5f) * ScaleX, (Halton(phase, 3) - 0.5f) * ScaleY, RenderWidth,
+                               RenderHeight);
+        }
+    }
+};
+
+static void PixelSequences()
+{
+    for (uint32_t phases : { 8u, 16u, 32u, 72u })
+    {
+        JitterAnalyzer analyzer;
+        Sequence sequence { phases };
+
+        // Period detection needs two full periods, confidence grows up to three
+        sequence.Feed(analyzer, JitterAnalyzer::HistorySize);
+
+        auto& result = analyzer.Result();
+        CHECK(result.PeriodLocked);
+        CHECK(result.PhaseCount == phases);
+        CHECK(result.BaseX == 2);
+        CHECK(result.BaseY == 3);
+        CHECK(result.Units == JitterUnits::Pixels);
+        CHECK(!result.FlippedX);
+        CHECK(!result.FlippedY);
+        CHECK(!result.ZeroJitter);
+        CHECK(result.Resets == 0);
+        CHECK(result.Confidence > 0.95f);
+
+        if (failures > 0)
+            printf("  with %u phases\n", phases);
+    }
+}
+
+// Game starts somewhere in the middle of the sequence, the fit has to try every phase offset
+static void StartsMidSequence()
+{
+    JitterAnalyzer analyzer;
+    Sequence sequence { 16 };
+    sequence.Index = 11;
+    sequence.Feed(analyzer, JitterAnalyzer::HistorySize);
+
+    auto& result = analyzer.Result();
+    CHECK(result.PhaseCount == 16);
+    CHECK(result.BaseX == 2);
+    CHECK(result.BaseY == 3);
+    CHECK(result.Confidence > 0.95f);
+}
+
+// Vulkan style Y or a game negating both axes
+static void FlippedAxes()
+{
+    {
+        JitterAnalyzer analyzer;
+        Sequence sequence { 32, 1.0f, -1.0f };
+        sequence.Feed(analyzer, JitterAnalyzer::HistorySize);
+
+        auto& result = analyzer.Result();
+        CHECK(result.PhaseCount == 32);
+        CHECK(result.Units == JitterUnits::Pixels);
+        CHECK(!result.FlippedX);
+        CHECK(result.FlippedY);
+        CHECK(result.BaseY == 3);
+    }
+
+    {
+        JitterAnalyzer analyzer;
+        Sequence sequence { 8, -1.0f, -1.0f };
+        sequence.Feed(analyzer, JitterAnalyzer::HistorySize);
+
+        auto& result = analyzer.Result();
+        CHECK(result.PhaseCount == 8);
+        CHECK(result.Units == JitterUnits::Pixels);
+        CHECK(result.FlippedX);
+        CHECK(result.FlippedY);
+    }
+}
+
+// Jitter already converted to clip space, 2 / size per pixel
+static void NdcSequences()
+{
+    for (float sign : { 1.0f, -1.0f })
+    {
+        JitterAnalyzer analyzer;
+        Sequence sequence { 16, 2.0f / RenderWidth, sign * 2.0f / RenderHeight };
+        sequence.Feed(analyzer, JitterAnalyzer::HistorySize);
+
+        auto& result = analyzer.Result();
+        CHECK(result.PeriodLocked);
+        CHECK(result.PhaseCount == 16);
+        CHECK(result.Units == JitterUnits::NDC);
+        CHECK(result.BaseX == 2);
+        CHECK(result.BaseY == 3);
+        CHECK(!result.FlippedX);
+        CHECK(result.FlippedY == (sign < 0.0f));
+    }
+
+    // Neither pixels nor NDC of this render size
+    JitterAnalyzer analyzer;
+    Sequence sequence { 16, 0.25f, 0.25f };
+    sequence.Feed(analyzer, JitterAnalyzer::HistorySize);
+
+    CHECK(analyzer.Result().PeriodLocked);
+    CHECK(analyzer.Result().Units == JitterUnits::Unknown);
+}
+
+static void ZeroJitter()
+{
+    JitterAnalyzer analyzer;
+
+    for (uint32_t i = 0; i < JitterAnalyzer::AnalyzeInterval * 2; i++)
+        analyzer.AddSample(0.0f, 0.0f, RenderWidth, RenderHeight);
+
+    auto& result = analyzer.Result();
+    CHECK(result.ZeroJitter);
+    CHECK(result.PeriodLocked);
+    CHECK(result.PhaseCount == 1);
+    CHECK(result.Units == JitterUnits::Unknown);
+}
+
+// No period, jitter count falls back to distinct offsets in history
+static void RandomJitter()
+{
+    JitterAnalyzer analyzer;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-0.5f, 0.5f);
+
+    for (uint32_t i = 0; i < JitterAnalyzer::HistorySize * 2; i++)
+        analyzer.AddSample(dist(rng), dist(rng), RenderWidth, RenderHeight);
+
+    auto& result = analyzer.Result();
+    CHECK(!result.PeriodLocked);
+    CHECK(result.PhaseCount == JitterAnalyzer::HistorySize);
+    CHECK(result.BaseX == 0);
+    CHECK(result.BaseY == 0);
+    CHECK(result.Confidence == 0.0f);
+}
+
+// Camera cut restarts the jitter index mid period
+static void SequenceReset()
+{
+    JitterAnalyzer analyzer;
+    Sequence sequence { 16 };
+    sequence.Feed(analyzer, JitterAnalyzer::HistorySize);
+    CHECK(analyzer.Result().PeriodLocked);
+
+    sequence.Feed(analyzer, 5);
+    sequence.Index = 0;
+    sequence.Feed(analyzer, 1);
+
+    CHECK(analyzer.Result().Resets == 1);
+    CHECK(!analyzer.Result().PeriodLocked);
+    CHECK(analyzer.Result().Confidence == 0.0f);
+
+    // No more resets are counted until it locks again
+    sequence.Feed(analyzer, 7);
+    CHECK(analyzer.Result().Resets == 1);
+
+    // Relocks once the recent history repeats again
+    sequence.Feed(analyzer, JitterAnalyzer::AnalyzeInterval * 2);
+    CHECK(analyzer.Result().PeriodLocked);
+    CHECK(analyzer.Result().PhaseCount == 16);
+    CHECK(analyzer.Result().Resets == 1);
+
+    // Switching to a different phase count breaks it once more
+    sequence.Phases = 32;
+    sequence.Index = 0;
+    sequence.Feed(analyzer, JitterAnalyzer::HistorySize);
+    CHECK(analyzer.Result().Resets == 2);
+    CHECK(analyzer.Result().PeriodLocked);
+    CHECK(analyzer.Result().PhaseCount == 32);
+
+    // Reset() clears the history and the result but keeps the counter
+    analyzer.Reset();
+    CHECK(!analyzer.Result().PeriodLocked);
+    CHECK(analyzer.Result().PhaseCount == 0);
+    CHECK(analyzer.Result().Resets == 2);
+
+    // Not analyzed until AnalyzeInterval samples arrived again
+    sequence.Feed(analyzer, JitterAnalyzer::AnalyzeInterval - 1);
+    CHECK(analyzer.Result().PhaseCount == 0);
+    sequence.Feed(analyzer, 1);
+
+    // One period of 32 can't lock yet, it reports the distinct offsets
+    CHECK(!analyzer.Result().PeriodLocked);
+    CHECK(analyzer.Result().PhaseCount == 32);
+    CHECK(analyzer.Result().Resets == 2);
+}
+
+static void ShortHistory()
+{
+    // 72 phases need 144 samples before the period can be seen
+    JitterAnalyzer analyzer;
+    Sequence sequence { 72 };
+    sequence.Feed(analyzer, 128);
+    CHECK(!analyzer.Result().PeriodLocked);
+    CHECK(analyzer.Result().PhaseCount == 72);
+
+    sequence.Feed(analyzer, 32);
+    CHECK(analyzer.Result().PeriodLocked);
+    CHECK(analyzer.Result().PhaseCount == 72);
+
+    // Less than three periods in history
+    CHECK(analyzer.Result().Confidence < 0.8f);
+    CHECK(analyzer.Result().Confidence > 0.6f);
+}
+
+static void Recommended()
+{
+    CHECK(JitterAnalyzer::RecommendedPhaseCount(1920, 1920) == 8);
+    CHECK(JitterAnalyzer::RecommendedPhaseCount(1280, 1920) == 18);
+    CHECK(JitterAnalyzer::RecommendedPhaseCount(1280, 2560) == 32);
+    CHECK(JitterAnalyzer::RecommendedPhaseCount(1280, 3840) == 72);
+    CHECK(JitterAnalyzer::RecommendedPhaseCount(0, 3840) == 0);
+}
+
+int main()
+{
+    PixelSequences();
+    StartsMidSequence();
+    FlippedAxes();
+    NdcSequences();
+    ZeroJitter();
+    RandomJitter();
+    SequenceReset();
+    ShortHistory();
+    Recommended();
+
+    if (failures == 0)
+        printf("All checks passed\n");
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,947 @@
+// CPU ports of the output scaling, RCAS and FSR1 EASU compute shaders with a scalar and an AVX2 path.
+// Kernel bodies are templates instantiated for float (scalar reference) and Float8 (8 output pixels in AVX2 lanes),
+// both paths run the same operations in the same order and the AVX2 output is compared bit exact to the scalar one.
+//
+// Math follows the HLSL in output_scaling/OS_Common.h, rcas/RCAS_Common.h and output_scaling/fsr1/ffx_fsr1.h:
+// float32, clamp addressing, texel fetches instead of sampler reads, per axis filter weights. min / max use the SSE
+// operand order so NaNs end up the same in both paths. Results track the GPU within float32 rounding only
+// (sin / exp / rcp differ), image quality comparisons are done by shaders/shader_tools/kernel_reference.py.
+//
+// Build and run on Linux from this directory, needs an x86-64 CPU with AVX2:
+//   g++ -std=c++20 -O2 -mavx2 -ffp-contract=off kernel_bench.cpp -o check
+//   ./check [runs]
+// Prints scalar and AVX2 timings per kernel, exits with 1 when the paths don't match.
+
+#include <immintrin.h>
+
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(expr)                                                                                                    \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expr))                                                                                                   \
+        {                                                                                                              \
+            printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #expr);                                                   \
+            failures++;                                                                                                \
+        }                                                                                                              \
+    } while (0)
+
+// Planar RGB, the shaders ignore alpha
+struct Image
+{
+    int Width = 0;
+    int Height = 0;
+    std::vector<float> Planes[3];
+
+    Image() = default;
+
+    Image(int width, int height) : Width(width), Height(height)
+    {
+        for (auto& plane : Planes)
+            plane.resize((size_t) width * height);
+    }
+
+    float* Row(int channel, int y) { return Planes[channel].data() + (size_t) y * Width; }
+    const float* Row(int channel, int y) const { return Planes[channel].data() + (size_t) y * Width; }
+};
+
+//
+// Lane types, every kernel operation goes through these
+//
+
+struct Float8
+{
+    __m256 v;
+};
+
+struct Int8
+{
+    __m256i v;
+};
+
+template <typename V> struct Lanes;
+
+template <> struct Lanes<float>
+{
+    static constexpr int Count = 1;
+    using Index = int;
+    using Mask = bool;
+};
+
+template <> struct Lanes<Float8>
+{
+    static constexpr int Count = 8;
+    using Index = Int8;
+    using Mask = Float8;
+};
+
+static inline Float8 operator+(Float8 a, Float8 b) { return { _mm256_add_ps(a.v, b.v) }; }
+static inline Float8 operator-(Float8 a, Float8 b) { return { _mm256_sub_ps(a.v, b.v) }; }
+static inline Float8 operator*(Float8 a, Float8 b) { return { _mm256_mul_ps(a.v, b.v) }; }
+static inline Float8 operator/(Float8 a, Float8 b) { return { _mm256_div_ps(a.v, b.v) }; }
+static inline Float8 operator-(Float8 a) { return { _mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f)) }; }
+static inline Int8 operator+(Int8 a, int b) { return { _mm256_add_epi32(a.v, _mm256_set1_epi32(b)) }; }
+
+template <typename V> static inline V Splat(float value);
+template <> inline float Splat<float>(float value) { return value; }
+template <> inline Float8 Splat<Float8>(float value) { return { _mm256_set1_ps(value) }; }
+
+// Same results as minps / maxps, second operand when unordered
+static inline float Min(float a, float b) { return a < b ? a : b; }
+static inline float Max(float a, float b) { return a > b ? a : b; }
+static inline Float8 Min(Float8 a, Float8 b) { return { _mm256_min_ps(a.v, b.v) }; }
+static inline Float8 Max(Float8 a, Float8 b) { return { _mm256_max_ps(a.v, b.v) }; }
+
+static inline float Abs(float a) { return std::fabs(a); }
+static inline Float8 Abs(Float8 a) { return { _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v) }; }
+
+static inline float Floor(float a) { return std::floor(a); }
+static inline Float8 Floor(Float8 a) { return { _mm256_floor_ps(a.v) }; }
+
+static inline float Sqrt(float a) { return std::sqrt(a); }
+static inline Float8 Sqrt(Float8 a) { return { _mm256_sqrt_ps(a.v) }; }
+
+static inline bool Less(float a, float b) { return a < b; }
+static inline Float8 Less(Float8 a, Float8 b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ) }; }
+
+static inline float Select(bool mask, float a, float b) { return mask ? a : b; }
+static inline Float8 Select(Float8 mask, Float8 a, Float8 b) { return { _mm256_blendv_ps(b.v, a.v, mask.v) }; }
+
+// APrxLoRcpF1 / APrxLoRsqF1 of ffx_a.h
+static inline float PrxLoRcp(float a) { return std::bit_cast<float>(0x7ef07ebbu - std::bit_cast<uint32_t>(a)); }
+
+static inline Float8 PrxLoRcp(Float8 a)
+{
+    return { _mm256_castsi256_ps(_mm256_sub_epi32(_mm256_set1_epi32(0x7ef07ebb), _mm256_castps_si256(a.v))) };
+}
+
+static inline float PrxLoRsq(float a) { return std::bit_cast<float>(0x5f347d74u - (std::bit_cast<uint32_t>(a) >> 1)); }
+
+static inline Float8 PrxLoRsq(Float8 a)
+{
+    return { _mm256_castsi256_ps(
+        _mm256_sub_epi32(_mm256_set1_epi32(0x5f347d74), _mm256_srli_epi32(_mm256_castps_si256(a.v), 1))) };
+}
+
+template <typename V> static inline V Sat(V a) { return Min(Max(a, Splat<V>(0.0f)), Splat<V>(1.0f)); }
+template <typename V> static inline V Lerp(V a, V b, V t) { return a + (b - a) * t; }
+
+static inline int ToInt(float a) { return (int) a; }
+static inline Int8 ToInt(Float8 a) { return { _mm256_cvttps_epi32(a.v) }; }
+
+static inline int ClampIndex(int a, int lo, int hi) { return std::min(std::max(a, lo), hi); }
+
+static inline Int8 ClampIndex(Int8 a, int lo, int hi)
+{
+    return { _mm256_min_epi32(_mm256_max_epi32(a.v, _mm256_set1_epi32(lo)), _mm256_set1_epi32(hi)) };
+}
+
+static inline int RowOffset(int y, int width, int x) { return y * width + x; }
+
+static inline Int8 RowOffset(Int8 y, int width, Int8 x)
+{
+    return { _mm256_add_epi32(_mm256_mullo_epi32(y.v, _mm256_set1_epi32(width)), x.v) };
+}
+
+// Consecutive output pixels starting at x
+template <typename V> static inline V PixelCoord(int x);
+template <> inline float PixelCoord<float>(int x) { return (float) x; }
+
+template <> inline Float8 PixelCoord<Float8>(int x)
+{
+    return { _mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_set1_epi32(x), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7))) };
+}
+
+template <typename V> static inline V Load(const float* data);
+template <> inline float Load<float>(const float* data) { return *data; }
+template <> inline Float8 Load<Float8>(const float* data) { return { _mm256_loadu_ps(data) }; }
+
+template <typename V> static inline typename Lanes<V>::Index LoadIndex(const int* data);
+template <> inline int LoadIndex<float>(const int* data) { return *data; }
+template <> inline Int8 LoadIndex<Float8>(const int* data) { return { _mm256_loadu_si256((const __m256i*) data) }; }
+
+static inline float Gather(const float* base, int index) { return base[index]; }
+static inline Float8 Gather(const float* base, Int8 index) { return { _mm256_i32gather_ps(base, index.v, 4) }; }
+
+static inline void Store(float* data, float value) { *data = value; }
+static inline void Store(float* data, Float8 value) { _mm256_storeu_ps(data, value.v); }
+
+// Full vectors first, scalar tail for the rest of the row
+template <typename V, typename Fn> static void ForEachPixel(int width, int height, Fn&& fn)
+{
+    for (int y = 0; y < height; y++)
+    {
+        int x = 0;
+
+        if constexpr (Lanes<V>::Count > 1)
+        {
+            for (; x + Lanes<V>::Count <= width; x += Lanes<V>::Count)
+                fn.template operator()<V>(x, y);
+        }
+
+        for (; x < width; x++)
+            fn.template operator()<float>(x, y);
+    }
+}
+
+//
+// Output scaling, weights only depend on the fraction of one axis so they are built per column / row
+//
+
+static float Sinc(float x)
+{
+    x *= 3.1415926535f;
+    if (std::fabs(x) < 1e-5f)
+        return 1.0f;
+    return std::sin(x) / x;
+}
+
+static float Lanczos(float x, float a)
+{
+    if (std::fabs(x) >= a)
+        return 0.0f;
+    return Sinc(x) * Sinc(x / a);
+}
+
+static float I0(float x)
+{
+    float ax = std::fabs(x);
+    if (ax < 3.75f)
+    {
+        float t = x / 3.75f;
+        float t2 = t * t;
+        return 1.0f +
+               t2 * (3.5156229f +
+                     t2 * (3.0899424f + t2 * (1.2067492f + t2 * (0.2659732f + t2 * (0.0360768f + t2 * 0.0045813f)))));
+    }
+
+    float t = 3.75f / ax;
+    return (std::exp(ax) / std::sqrt(ax)) *
+           (0.39894228f +
+            t * (0.01328592f +
+                 t * (0.00225319f +
+                      t * (-0.00157565f +
+                           t * (0.00916281f +
+                                t * (-0.02057706f + t * (0.02635537f + t * (-0.01647633f + t * 0.00392377f))))))));
+}
+
+static float Kaiser(float x, float a, float beta)
+{
+    float ax = std::fabs(x);
+    if (ax >= a)
+        return 0.0f;
+
+    float r = ax / a;
+    float t = std::sqrt(std::min(std::max(1.0f - r * r, 0.0f), 1.0f));
+    return Sinc(x) * (I0(beta * t) * (1.0f / I0(beta)));
+}
+
+static float CubicKeys(float x, float a)
+{
+    x = std::fabs(x);
+    float x2 = x * x;
+    float x3 = x2 * x;
+
+    if (x < 1.0f)
+        return (a + 2.0f) * x3 - (a + 3.0f) * x2 + 1.0f;
+    else if (x < 2.0f)
+        return a * x3 - 5.0f * a * x2 + 8.0f * a * x - 4.0f * a;
+
+    return 0.0f;
+}
+
+// Destination pixel center in source texel space, split into integer and fraction
+static void SourcePosition(int src, int dst, int o, float& ip, float& f)
+{
+    float scale = (float) src / (float) dst;
+    float pos = ((float) o + 0.5f) * scale - 0.5f;
+    ip = std::floor(pos);
+    f = pos - ip;
+}
+
+// Taps stored [tap][dst] so consecutive output pixels load as one vector
+struct AxisTaps
+{
+    int Taps = 0;
+    int Size = 0;
+    std::vector<int> Index;
+    std::vector<float> Weight;
+};
+
+static AxisTaps BuildTaps(int src, int dst, int radius, const std::function<float(float)>& kernel)
+{
+    AxisTaps axis;
+    axis.Taps = 2 * radius;
+    axis.Size = dst;
+    axis.Index.resize((size_t) axis.Taps * dst);
+    axis.Weight.resize((size_t) axis.Taps * dst);
+
+    std::vector<float> w(axis.Taps);
+
+    for (int o = 0; o < dst; o++)
+    {
+        float ip, f;
+        SourcePosition(src, dst, o, ip, f);
+
+        int base = (int) ip - (radius - 1);
+        float sum = 0.0f;
+
+        for (int i = 0; i < axis.Taps; i++)
+        {
+            w[i] = kernel((float) i - (float) (radius - 1) - f);
+            sum += w[i];
+        }
+
+        float invSum = (sum != 0.0f) ? (1.0f / sum) : 0.0f;
+
+        for (int i = 0; i < axis.Taps; i++)
+        {
+            axis.Index[(size_t) i * dst + o] = ClampIndex(base + i, 0, src - 1);
+            axis.Weight[(size_t) i * dst + o] = w[i] * invSum;
+        }
+    }
+
+    return axis;
+}
+
+// Lanczos / Kaiser: weighted sum of the footprint, clamped to its min / max
+template <typename V>
+static void ResampleTapsAt(const Image& src, Image& dst, const AxisTaps& ax, const AxisTaps& ay, int x, int y)
+{
+    V acc[3], mn[3], mx[3];
+
+    for (int c = 0; c < 3; c++)
+    {
+        acc[c] = Splat<V>(0.0f);
+        mn[c] = Splat<V>(1e30f);
+        mx[c] = Splat<V>(-1e30f);
+    }
+
+    for (int j = 0; j < ay.Taps; j++)
+    {
+        int sy = ay.Index[(size_t) j * ay.Size + y];
+        V wyj = Splat<V>(ay.Weight[(size_t) j * ay.Size + y]);
+
+        for (int i = 0; i < ax.Taps; i++)
+        {
+            auto sx = LoadIndex<V>(&ax.Index[(size_t) i * ax.Size + x]);
+            V w = Load<V>(&ax.Weight[(size_t) i * ax.Size + x]) * wyj;
+
+            for (int c = 0; c < 3; c++)
+            {
+                V s = Gather(src.Row(c, sy), sx);
+                mn[c] = Min(mn[c], s);
+                mx[c] = Max(mx[c], s);
+                acc[c] = acc[c] + s * w;
+            }
+        }
+    }
+
+    for (int c = 0; c < 3; c++)
+        Store(dst.Row(c, y) + x, Min(Max(acc[c], mn[c]), mx[c]));
+}
+
+// Bicubic / Catmull: 4 cubic taps per axis as 2 bilinear reads
+struct AxisCubic
+{
+    std::vector<float> W01, W23;
+    std::vector<float> T01, T23;
+    std::vector<int> A01, B01, A23, B23;
+};
+
+static AxisCubic BuildCubic(int src, int dst, float a)
+{
+    AxisCubic axis;
+
+    for (auto* v : { &axis.W01, &axis.W23, &axis.T01, &axis.T23 })
+        v->resize(dst);
+
+    for (auto* v : { &axis.A01, &axis.B01, &axis.A23, &axis.B23 })
+        v->resize(dst);
+
+    for (int o = 0; o < dst; o++)
+    {
+        float ip, t;
+        SourcePosition(src, dst, o, ip, t);
+
+        float w0 = CubicKeys(1.0f + t, a);
+        float w1 = CubicKeys(t, a);
+        float w2 = CubicKeys(1.0f - t, a);
+        float w3 = CubicKeys(2.0f - t, a);
+
+        float w01 = w0 + w1;
+        float w23 = w2 + w3;
+        float invW01 = (w01 != 0.0f) ? (1.0f / w01) : 0.0f;
+        float invW23 = (w23 != 0.0f) ? (1.0f / w23) : 0.0f;
+
+        float base = ip - 1.0f;
+        float p01 = base + ((-1.0f) + (w1 * invW01));
+        float p23 = base + (1.0f + (w3 * invW23));
+
+        // Bilinear footprint of the sample positions in texel index space
+        float f01 = std::floor(p01);
+        float f23 = std::floor(p23);
+
+        axis.W01[o] = w01;
+        axis.W23[o] = w23;
+        axis.T01[o] = p01 - f01;
+        axis.T23[o] = p23 - f23;
+        axis.A01[o] = ClampIndex((int) f01, 0, src - 1);
+        axis.B01[o] = ClampIndex((int) f01 + 1, 0, src - 1);
+        axis.A23[o] = ClampIndex((int) f23, 0, src - 1);
+        axis.B23[o] = ClampIndex((int) f23 + 1, 0, src - 1);
+    }
+
+    return axis;
+}
+
+template <typename V>
+static V Bilinear(const Image& src, int c, typename Lanes<V>::Index xa, typename Lanes<V>::Index xb, V tx, int ya,
+                  int yb, float ty)
+{
+    V one = Splat<V>(1.0f);
+    V top = Gather(src.Row(c, ya), xa) * (one - tx) + Gather(src.Row(c, ya), xb) * tx;
+    V bottom = Gather(src.Row(c, yb), xa) * (one - tx) + Gather(src.Row(c, yb), xb) * tx;
+    return top * Splat<V>(1.0f - ty) + bottom * Splat<V>(ty);
+}
+
+template <typename V>
+static void ResampleCubicAt(const Image& src, Image& dst, const AxisCubic& ax, const AxisCubic& ay, int x, int y)
+{
+    auto xa01 = LoadIndex<V>(&ax.A01[x]);
+    auto xb01 = LoadIndex<V>(&ax.B01[x]);
+    auto xa23 = LoadIndex<V>(&ax.A23[x]);
+    auto xb23 = LoadIndex<V>(&ax.B23[x]);
+    V tx01 = Load<V>(&ax.T01[x]);
+    V tx23 = Load<V>(&ax.T23[x]);
+    V wx01 = Load<V>(&ax.W01[x]);
+    V wx23 = Load<V>(&ax.W23[x]);
+    V wy01 = Splat<V>(ay.W01[y]);
+    V wy23 = Splat<V>(ay.W23[y]);
+
+    for (int c = 0; c < 3; c++)
+    {
+        V s00 = Bilinear<V>(src, c, xa01, xb01, tx01, ay.A01[y], ay.B01[y], ay.T01[y]);
+        V s10 = Bilinear<V>(src, c, xa23, xb23, tx23, ay.A01[y], ay.B01[y], ay.T01[y]);
+        V s01 = Bilinear<V>(src, c, xa01, xb01, tx01, ay.A23[y], ay.B23[y], ay.T23[y]);
+        V s11 = Bilinear<V>(src, c, xa23, xb23, tx23, ay.A23[y], ay.B23[y], ay.T23[y]);
+
+        V out = (s00 * wx01 + s10 * wx23) * wy01 + (s01 * wx01 + s11 * wx23) * wy23;
+
+        V mn = Min(Min(s00, s10), Min(s01, s11));
+        V mx = Max(Max(s00, s10), Max(s01, s11));
+        Store(dst.Row(c, y) + x, Min(Max(out, mn), mx));
+    }
+}
+
+enum class OutputScaler
+{
+    Bicubic,
+    Catmull,
+    Lanczos2,
+    Lanczos3,
+    Kaiser2,
+    Kaiser3,
+};
+
+static const char* ScalerName(OutputScaler scaler)
+{
+    static const char* names[] = { "bicubic", "catmull", "lanczos2", "lanczos3", "kaiser2", "kaiser3" };
+    return names[(int) scaler];
+}
+
+template <typename V> static void OutputScale(const Image& src, Image& dst, OutputScaler scaler)
+{
+    if (scaler == OutputScaler::Bicubic || scaler == OutputScaler::Catmull)
+    {
+        float a = scaler == OutputScaler::Bicubic ? -0.6f : -0.45f;
+        auto ax = BuildCubic(src.Width, dst.Width, a);
+        auto ay = BuildCubic(src.Height, dst.Height, a);
+
+        ForEachPixel<V>(dst.Width, dst.Height,
+                        [&]<typename T>(int x, int y) { ResampleCubicAt<T>(src, dst, ax, ay, x, y); });
+        return;
+    }
+
+    int radius = (scaler == OutputScaler::Lanczos2 || scaler == OutputScaler::Kaiser2) ? 2 : 3;
+    std::function<float(float)> kernel;
+
+    switch (scaler)
+    {
+    case OutputScaler::Lanczos2:
+    case OutputScaler::Lanczos3:
+        kernel = [radius](float x) { return Lanczos(x, (float) radius); };
+        break;
+
+    default:
+        kernel = [radius](float x) { return Kaiser(x, (float) radius, radius == 2 ? 5.0f : 6.0f); };
+        break;
+    }
+
+    auto ax = BuildTaps(src.Width, dst.Width, radius, kernel);
+    auto ay = BuildTaps(src.Height, dst.Height, radius, kernel);
+
+    ForEachPixel<V>(dst.Width, dst.Height,
+                    [&]<typename T>(int x, int y) { ResampleTapsAt<T>(src, dst, ax, ay, x, y); });
+}
+
+//
+// RCAS, rcasCode without motion adaptive sharpness and debug tints
+//
+
+template <typename V> static V Max3(V r, V g, V b) { return Max(r, Max(g, b)); }
+
+template <typename V>
+static void RcasAt(const Image& src, Image& dst, float sharpness, float contrast, int x, int y)
+{
+    int maxX = src.Width - 1;
+    int maxY = src.Height - 1;
+
+    // Vectors only run where x - 1 and x + 8 are inside the row, see Rcas()
+    int yb = std::max(y - 1, 0);
+    int yh = std::min(y + 1, maxY);
+    int xd = std::max(x - 1, 0);
+    int xf = std::min(x + 1, maxX);
+
+    V e[3], b[3], d[3], f[3], h[3];
+
+    for (int c = 0; c < 3; c++)
+    {
+        e[c] = Load<V>(src.Row(c, y) + x);
+        b[c] = Load<V>(src.Row(c, yb) + x);
+        d[c] = Load<V>(src.Row(c, y) + xd);
+        f[c] = Load<V>(src.Row(c, y) + xf);
+        h[c] = Load<V>(src.Row(c, yh) + x);
+    }
+
+    V localScale = Max(Max3(e[0], e[1], e[2]),
+                       Max(Max3(b[0], b[1], b[2]),
+                           Max(Max3(d[0], d[1], d[2]), Max(Max3(f[0], f[1], f[2]), Max3(h[0], h[1], h[2])))));
+
+    localScale = Max(localScale, Splat<V>(1.0f));
+
+    V zero = Splat<V>(0.0f);
+    V en[3], bn[3], dn[3], fn[3], hn[3], minRGB[3], maxRGB[3], lobeRGB[3];
+
+    for (int c = 0; c < 3; c++)
+    {
+        en[c] = Max(e[c] / localScale, zero);
+        bn[c] = Max(b[c] / localScale, zero);
+        dn[c] = Max(d[c] / localScale, zero);
+        fn[c] = Max(f[c] / localScale, zero);
+        hn[c] = Max(h[c] / localScale, zero);
+
+        minRGB[c] = Min(Min(bn[c], dn[c]), Min(fn[c], hn[c]));
+        maxRGB[c] = Max(Max(bn[c], dn[c]), Max(fn[c], hn[c]));
+
+        V hitMin = minRGB[c] / Max(Splat<V>(4.0f) * maxRGB[c], Splat<V>(1e-5f));
+        V hitMax = (Splat<V>(1.0f) - maxRGB[c]) /
+                   Max(Splat<V>(4.0f) * minRGB[c] + Splat<V>(-4.0f), Splat<V>(-1e-5f));
+
+        lobeRGB[c] = Max(-hitMin, hitMax);
+    }
+
+    V lobe = Max(Splat<V>(-0.1875f), Min(Max(lobeRGB[0], Max(lobeRGB[1], lobeRGB[2])), zero)) * Splat<V>(sharpness);
+
+    if (contrast != 0.0f)
+    {
+        // Only green of amp is used
+        V amp = Sat(Min(minRGB[1], Splat<V>(2.0f) - maxRGB[1]) / Max(maxRGB[1], Splat<V>(1e-5f)));
+        amp = Splat<V>(1.0f) / Sqrt(Max(amp, Splat<V>(1e-5f)));
+
+        float peak = -3.0f * contrast + 8.0f;
+        V contrastFactor = Splat<V>(1.0f) / Max(amp * Splat<V>(peak), Splat<V>(1.0f));
+
+        lobe = lobe * Lerp(Splat<V>(1.0f), contrastFactor, Splat<V>(Sat(contrast)));
+    }
+
+    V rcpL = Splat<V>(1.0f) / (Splat<V>(4.0f) * lobe + Splat<V>(1.0f));
+
+    for (int c = 0; c < 3; c++)
+        Store(dst.Row(c, y) + x, (((bn[c] + dn[c] + fn[c] + hn[c]) * lobe + en[c]) * rcpL) * localScale);
+}
+
+template <typename V> static void Rcas(const Image& src, Image& dst, float sharpness, float contrast)
+{
+    if (sharpness == 0.0f)
+    {
+        dst = src;
+        return;
+    }
+
+    constexpr int lanes = Lanes<V>::Count;
+
+    for (int y = 0; y < src.Height; y++)
+    {
+        int x = 0;
+
+        // Border pixels clamp their left / right neighbours per lane, done by the scalar path
+        if constexpr (lanes > 1)
+        {
+            RcasAt<float>(src, dst, sharpness, contrast, x++, y);
+
+            for (; x + lanes < src.Width; x += lanes)
+                RcasAt<V>(src, dst, sharpness, contrast, x, y);
+        }
+
+        for (; x < src.Width; x++)
+            RcasAt<float>(src, dst, sharpness, contrast, x, y);
+    }
+}
+
+//
+// FSR1 EASU, FsrEasuF with the gathers replaced by clamped texel fetches
+//
+
+template <typename V>
+static void EasuSet(V& dirX, V& dirY, V& len, V w, V lA, V lB, V lC, V lD, V lE)
+{
+    V dc = lD - lC;
+    V cb = lC - lB;
+    V lenX = Max(Abs(dc), Abs(cb));
+    lenX = PrxLoRcp(lenX);
+    V dx = lD - lB;
+    dirX = dirX + dx * w;
+    lenX = Sat(Abs(dx) * lenX);
+    lenX = lenX * lenX;
+    len = len + lenX * w;
+
+    V ec = lE - lC;
+    V ca = lC - lA;
+    V lenY = Max(Abs(ec), Abs(ca));
+    lenY = PrxLoRcp(lenY);
+    V dy = lE - lA;
+    dirY = dirY + dy * w;
+    lenY = Sat(Abs(dy) * lenY);
+    lenY = lenY * lenY;
+    len = len + lenY * w;
+}
+
+template <typename V>
+static void EasuTap(V aC[3], V& aW, V offX, V offY, V dirX, V dirY, V lenX, V lenY, V lob, V clp, const V c[3])
+{
+    V vx = (offX * dirX) + (offY * dirY);
+    V vy = (offX * (-dirY)) + (offY * dirX);
+    vx = vx * lenX;
+    vy = vy * lenY;
+
+    V d2 = vx * vx + vy * vy;
+    d2 = Min(d2, clp);
+
+    V wB = Splat<V>(2.0f / 5.0f) * d2 + Splat<V>(-1.0f);
+    V wA = lob * d2 + Splat<V>(-1.0f);
+    wB = wB * wB;
+    wA = wA * wA;
+    wB = Splat<V>(25.0f / 16.0f) * wB + Splat<V>(-(25.0f / 16.0f - 1.0f));
+    V w = wB * wA;
+
+    for (int i = 0; i < 3; i++)
+        aC[i] = aC[i] + c[i] * w;
+
+    aW = aW + w;
+}
+
+struct EasuConstants
+{
+    float ScaleX, ScaleY, OffsetX, OffsetY;
+};
+
+static EasuConstants EasuCon(int inputWidth, int inputHeight, int outputWidth, int outputHeight)
+{
+    EasuConstants con;
+    con.ScaleX = (float) inputWidth * (1.0f / (float) outputWidth);
+    con.ScaleY = (float) inputHeight * (1.0f / (float) outputHeight);
+    con.OffsetX = 0.5f * (float) inputWidth * (1.0f / (float) outputWidth) - 0.5f;
+    con.OffsetY = 0.5f * (float) inputHeight * (1.0f / (float) outputHeight) - 0.5f;
+    return con;
+}
+
+template <typename V> static void EasuAt(const Image& src, Image& dst, const EasuConstants& con, int x, int y)
+{
+    using Index = typename Lanes<V>::Index;
+
+    V ppX = PixelCoord<V>(x) * Splat<V>(con.ScaleX) + Splat<V>(con.OffsetX);
+    V ppY = Splat<V>((float) y * con.ScaleY + con.OffsetY);
+    V fpX = Floor(ppX);
+    V fpY = Floor(ppY);
+    ppX = ppX - fpX;
+    ppY = ppY - fpY;
+
+    Index ix = ToInt(fpX);
+    Index iy = ToInt(fpY);
+
+    //    b c
+    //  e f g h
+    //  i j k l
+    //    n o
+    static constexpr int tapX[12] = { 0, 1, -1, 0, 1, 2, -1, 0, 1, 2, 0, 1 };
+    static constexpr int tapY[12] = { -1, -1, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2 };
+    enum
+    {
+        B, C, E, F, G, H, I, J, K, L, N, O
+    };
+
+    V tap[12][3];
+    V luma[12];
+
+    for (int t = 0; t < 12; t++)
+    {
+        auto offset = RowOffset(ClampIndex(iy + tapY[t], 0, src.Height - 1), src.Width,
+                                ClampIndex(ix + tapX[t], 0, src.Width - 1));
+
+        for (int c = 0; c < 3; c++)
+            tap[t][c] = Gather(src.Planes[c].data(), offset);
+
+        // Luma times 2
+        luma[t] = tap[t][2] * Splat<V>(0.5f) + (tap[t][0] * Splat<V>(0.5f) + tap[t][1]);
+    }
+
+    V one = Splat<V>(1.0f);
+    V dirX = Splat<V>(0.0f);
+    V dirY = Splat<V>(0.0f);
+    V len = Splat<V>(0.0f);
+
+    EasuSet(dirX, dirY, len, (one - ppX) * (one - ppY), luma[B], luma[E], luma[F], luma[G], luma[J]);
+    EasuSet(dirX, dirY, len, ppX * (one - ppY), luma[C], luma[F], luma[G], luma[H], luma[K]);
+    EasuSet(dirX, dirY, len, (one - ppX) * ppY, luma[F], luma[I], luma[J], luma[K], luma[N]);
+    EasuSet(dirX, dirY, len, ppX * ppY, luma[G], luma[J], luma[K], luma[L], luma[O]);
+
+    // Normalize with approximation, and cleanup close to zero
+    V dirR = dirX * dirX + dirY * dirY;
+    auto zro = Less(dirR, Splat<V>(1.0f / 32768.0f));
+    dirR = PrxLoRsq(dirR);
+    dirR = Select(zro, one, dirR);
+    dirX = Select(zro, one, dirX);
+    dirX = dirX * dirR;
+    dirY = dirY * dirR;
+
+    len = len * Splat<V>(0.5f);
+    len = len * len;
+
+    V stretch = (dirX * dirX + dirY * dirY) * PrxLoRcp(Max(Abs(dirX), Abs(dirY)));
+    V lenX = one + (stretch - one) * len;
+    V lenY = one + Splat<V>(-0.5f) * len;
+    V lob = Splat<V>(0.5f) + Splat<V>((1.0f / 4.0f - 0.04f) - 0.5f) * len;
+    V clp = PrxLoRcp(lob);
+
+    // Min / max of the 4 nearest: f g j k
+    V min4[3], max4[3];
+
+    for (int c = 0; c < 3; c++)
+    {
+        min4[c] = Min(Min(tap[F][c], Min(tap[G][c], tap[J][c])), tap[K][c]);
+        max4[c] = Max(Max(tap[F][c], Max(tap[G][c], tap[J][c])), tap[K][c]);
+    }
+
+    V aC[3] = { Splat<V>(0.0f), Splat<V>(0.0f), Splat<V>(0.0f) };
+    V aW = Splat<V>(0.0f);
+
+    // Accumulation order of FsrEasuF
+    static constexpr int order[12] = { B, C, I, J, F, E, K, L, H, G, O, N };
+
+    for (int t : order)
+    {
+        V offX = Splat<V>((float) tapX[t]) - ppX;
+        V offY = Splat<V>((float) tapY[t]) - ppY;
+        EasuTap(aC, aW, offX, offY, dirX, dirY, lenX, lenY, lob, clp, tap[t]);
+    }
+
+    V rcpW = one / aW;
+
+    for (int c = 0; c < 3; c++)
+        Store(dst.Row(c, y) + x, Min(max4[c], Max(min4[c], aC[c] * rcpW)));
+}
+
+template <typename V> static void Easu(const Image& src, Image& dst)
+{
+    auto con = EasuCon(src.Width, src.Height, dst.Width, dst.Height);
+    ForEachPixel<V>(dst.Width, dst.Height, [&]<typename T>(int x, int y) { EasuAt<T>(src, dst, con, x, y); });
+}
+
+//
+// Test images, comparison and timing
+//
+
+// Gradients, edges and noise with HDR highlights and a few negative texels
+static Image MakeImage(int width, int height, uint32_t seed)
+{
+    Image image(width, height);
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> noise(-0.05f, 0.05f);
+    std::uniform_int_distribution<int> rare(0, 199);
+
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            float gx = (float) x / (float) width;
+            float gy = (float) y / (float) height;
+            bool edge = ((x / 13) + (y / 7)) % 2 == 0;
+            int roll = rare(rng);
+
+            for (int c = 0; c < 3; c++)
+            {
+                float value = (edge ? 0.8f : 0.1f) * (0.5f + 0.5f * gx) + 0.3f * gy * (float) c / 2.0f + noise(rng);
+
+                if (roll == 0)
+                    value *= 12.0f;
+                else if (roll == 1)
+                    value = -value;
+
+                image.Row(c, y)[x] = value;
+            }
+        }
+    }
+
+    return image;
+}
+
+static bool SameBits(const Image& a, const Image& b, const std::string& name)
+{
+    if (a.Width != b.Width || a.Height != b.Height)
+    {
+        printf("%s: size mismatch\n", name.c_str());
+        return false;
+    }
+
+    int reported = 0;
+    size_t mismatches = 0;
+
+    for (int c = 0; c < 3; c++)
+    {
+        for (int y = 0; y < a.Height; y++)
+        {
+            for (int x = 0; x < a.Width; x++)
+            {
+                auto va = std::bit_cast<uint32_t>(a.Row(c, y)[x]);
+                auto vb = std::bit_cast<uint32_t>(b.Row(c, y)[x]);
+
+                if (va == vb)
+                    continue;
+
+                if (reported++ < 4)
+                {
+                    printf("%s: channel %d at %d,%d scalar %08x avx2 %08x\n", name.c_str(), c, x, y, va, vb);
+                }
+
+                mismatches++;
+            }
+        }
+    }
+
+    if (mismatches > 0)
+        printf("%s: %zu mismatching values\n", name.c_str(), mismatches);
+
+    return mismatches == 0;
+}
+
+// Best of the runs, in ms
+static double Time(int runs, const std::function<void()>& fn)
+{
+    double best = 1e30;
+
+    for (int i = 0; i < runs; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+
+    return best;
+}
+
+static void Compare(const std::string& name, int runs, const std::function<void(Image&)>& scalar,
+                    const std::function<void(Image&)>& avx2, Image scalarOut, Image avx2Out)
+{
+    double scalarMs = Time(runs, [&]() { scalar(scalarOut); });
+    double avx2Ms = Time(runs, [&]() { avx2(avx2Out); });
+
+    bool same = SameBits(scalarOut, avx2Out, name);
+    CHECK(same);
+
+    printf("%-34s scalar %8.2f ms  avx2 %8.2f ms  x%.2f%s\n", name.c_str(), scalarMs, avx2Ms, scalarMs / avx2Ms,
+           same ? "" : "  MISMATCH");
+}
+
+static void OutputScaling(int runs, int dstWidth, int dstHeight, float ratio)
+{
+    Image src = MakeImage((int) (dstWidth * ratio), (int) (dstHeight * ratio), 1);
+
+    for (int s = 0; s <= (int) OutputScaler::Kaiser3; s++)
+    {
+        auto scaler = (OutputScaler) s;
+        char name[96];
+        snprintf(name, sizeof(name), "os %s %dx%d->%dx%d", ScalerName(scaler), src.Width, src.Height, dstWidth,
+                 dstHeight);
+
+        Compare(
+            name, runs, [&](Image& out) { OutputScale<float>(src, out, scaler); },
+            [&](Image& out) { OutputScale<Float8>(src, out, scaler); }, Image(dstWidth, dstHeight),
+            Image(dstWidth, dstHeight));
+    }
+}
+
+static void Sharpening(int runs, int width, int height)
+{
+    Image src = MakeImage(width, height, 2);
+
+    for (auto [sharpness, contrast] : { std::pair { 0.5f, 0.0f }, std::pair { 1.0f, 0.6f } })
+    {
+        char name[96];
+        snprintf(name, sizeof(name), "rcas %.1f/%.1f %dx%d", sharpness, contrast, width, height);
+
+        Compare(
+            name, runs, [&](Image& out) { Rcas<float>(src, out, sharpness, contrast); },
+            [&](Image& out) { Rcas<Float8>(src, out, sharpness, contrast); }, Image(width, height),
+            Image(width, height));
+    }
+}
+
+static void Upscaling(int runs, int srcWidth, int srcHeight, int dstWidth, int dstHeight)
+{
+    Image src = MakeImage(srcWidth, srcHeight, 3);
+    char name[96];
+    snprintf(name, sizeof(name), "easu %dx%d->%dx%d", srcWidth, srcHeight, dstWidth, dstHeight);
+
+    Compare(
+        name, runs, [&](Image& out) { Easu<float>(src, out); }, [&](Image& out) { Easu<Float8>(src, out); },
+        Image(dstWidth, dstHeight), Image(dstWidth, dstHeight));
+}
+
+int main(int argc, char** argv)
+{
+    if (!__builtin_cpu_supports("avx2"))
+    {
+        printf("AVX2 is not supported by this CPU\n");
+        return 1;
+    }
+
+    int runs = argc > 1 ? std::max(atoi(argv[1]), 1) : 3;
+
+    // Odd sizes run the scalar tails and clamped borders of the vector paths
+    OutputScaling(1, 203, 117, 1.37f);
+    Sharpening(1, 203, 117);
+    Upscaling(1, 151, 89, 203, 117);
+
+    OutputScaling(runs, 1280, 720, 1.5f);
+    OutputScaling(runs, 1280, 720, 3.0f);
+    Sharpening(runs, 2560, 1440);
+    Upscaling(runs, 1706, 960, 2560, 1440);
+
+    if (failures == 0)
+        printf("All checks passed\n");
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,307 @@
+// Feeds synthetic Reflex report windows through LatencyAnalytics::Consume and checks the dedup of seen and
+// in-flight frames, the history reset when frame ids go backwards, p50 / p99 and the MAD outlier and stall counts.
+//
+// Build and run on Linux from this directory:
+//   g++ -std=c++20 -O2 -I. -I../../OptiScaler latency_analytics_check.cpp
+//       ../../OptiScaler/misc/LatencyAnalytics.cpp -o check
+//   ./check
+// Exits with 1 and prints the failed checks when something is off.
+
+#include <misc/LatencyAnalytics.h>
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(expr)                                                                                                    \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expr))                                                                                                   \
+        {                                                                                                              \
+            printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #expr);                                                   \
+            failures++;                                                                                                \
+        }                                                                                                              \
+    } while (0)
+
+// Same fields as the frameReport entries of NV_LATENCY_RESULT_PARAMS, times in us
+struct Report
+{
+    uint64_t frameID;
+    uint64_t inputSampleTime;
+    uint64_t simStartTime;
+    uint64_t simEndTime;
+    uint64_t renderSubmitStartTime;
+    uint64_t renderSubmitEndTime;
+    uint64_t presentStartTime;
+    uint64_t presentEndTime;
+    uint64_t driverStartTime;
+    uint64_t driverEndTime;
+    uint64_t osRenderQueueStartTime;
+    uint64_t osRenderQueueEndTime;
+    uint64_t gpuRenderStartTime;
+    uint64_t gpuRenderEndTime;
+};
+
+static constexpr size_t WindowSize = 64;
+
+struct FrameShape
+{
+    double IntervalMs = 16.0;
+    double SimMs = 3.0;
+    double SubmitMs = 2.0;
+    double PresentMs = 0.5;
+    double GpuMs = 8.0;
+};
+
+// Frames laid out back to back, sim -> submit -> present -> gpu
+class Trace
+{
+  public:
+    std::vector<Report> Frames;
+
+    void Add(const FrameShape& shape)
+    {
+        Report report {};
+        report.frameID = _nextId++;
+
+        auto us = [](double ms) { return (uint64_t) (ms * 1000.0 + 0.5); };
+
+        report.simStartTime = _simStart;
+        report.simEndTime = report.simStartTime + us(shape.SimMs);
+        report.renderSubmitStartTime = report.simEndTime;
+        report.renderSubmitEndTime = report.renderSubmitStartTime + us(shape.SubmitMs);
+        report.presentStartTime = report.renderSubmitEndTime;
+        report.presentEndTime = report.presentStartTime + us(shape.PresentMs);
+        report.driverStartTime = report.presentStartTime;
+        report.driverEndTime = report.driverStartTime + 100;
+        report.osRenderQueueStartTime = report.presentEndTime;
+        report.osRenderQueueEndTime = report.osRenderQueueStartTime + 100;
+        report.gpuRenderStartTime = report.renderSubmitStartTime;
+        report.gpuRenderEndTime = report.gpuRenderStartTime + us(shape.GpuMs);
+
+        Frames.push_back(report);
+        _simStart += us(shape.IntervalMs);
+    }
+
+    void Restart(uint64_t firstId) { _nextId = firstId; }
+
+    // Report window as the driver hands it over, the newest WindowSize frames ending at last
+    std::vector<Report> Window(size_t last) const
+    {
+        std::vector<Report> window(WindowSize);
+        auto count = std::min(WindowSize, last + 1);
+
+        for (size_t i = 0; i < count; i++)
+            window[WindowSize - count + i] = Frames[last + 1 - count + i];
+
+        return window;
+    }
+
+  private:
+    uint64_t _nextId = 1;
+    uint64_t _simStart = 1'000'000;
+};
+
+static uint32_t Consume(const std::vector<Report>& window)
+{
+    return LatencyAnalytics::Consume(window.data(), window.size());
+}
+
+static bool Near(double a, double b) { return std::abs(a - b) < 0.001; }
+
+static void Dedup()
+{
+    LatencyAnalytics::Reset();
+
+    Trace trace;
+    for (int i = 0; i < 200; i++)
+        trace.Add({});
+
+    // Partly filled window, empty slots (frameID 0) are skipped
+    CHECK(Consume(trace.Window(9)) == 10);
+    CHECK(LatencyAnalytics::GetStats().Frames == 10);
+
+    // Same window again, everything already seen
+    CHECK(Consume(trace.Window(9)) == 0);
+
+    // Window moved by 8 frames, only those are new
+    CHECK(Consume(trace.Window(17)) == 8);
+    CHECK(LatencyAnalytics::GetStats().LastFrameId == 18);
+
+    // Newest frame still on the GPU, it's picked up by the next call
+    auto window = trace.Window(18);
+    window.back().gpuRenderEndTime = 0;
+    CHECK(Consume(window) == 0);
+    CHECK(LatencyAnalytics::GetStats().LastFrameId == 18);
+
+    CHECK(Consume(trace.Window(18)) == 1);
+    CHECK(LatencyAnalytics::GetStats().LastFrameId == 19);
+
+    // Full window and out of order, nothing counted twice
+    window = trace.Window(80);
+    std::mt19937 rng(5);
+    std::shuffle(window.begin(), window.end(), rng);
+
+    CHECK(Consume(window) == 62);
+
+    auto stats = LatencyAnalytics::GetStats();
+    CHECK(stats.Frames == 81);
+    CHECK(stats.LastFrameId == 81);
+
+    // Intervals are taken in frame id order, a shuffled window doesn't create stalls
+    CHECK(Near(stats.IntervalP50Ms, 16.0));
+    CHECK(stats.Stalls == 0);
+}
+
+static void FrameIdReset()
+{
+    LatencyAnalytics::Reset();
+
+    Trace trace;
+    for (int i = 0; i < 100; i++)
+        trace.Add({ .GpuMs = 20.0 });
+
+    CHECK(Consume(trace.Window(99)) == WindowSize);
+    CHECK(LatencyAnalytics::GetStats().LastFrameId == 100);
+
+    // Level load, ids restart and the old frames are dropped from the history
+    trace.Restart(1);
+    for (int i = 0; i < 10; i++)
+        trace.Add({ .GpuMs = 4.0 });
+
+    std::vector<Report> window(WindowSize);
+    for (size_t i = 0; i < 10; i++)
+        window[i] = trace.Frames[100 + i];
+
+    CHECK(Consume(window) == 10);
+
+    auto stats = LatencyAnalytics::GetStats();
+    CHECK(stats.Frames == 10);
+    CHECK(stats.LastFrameId == 10);
+    CHECK(Near(stats.Stages[(size_t) LatencyStage::GpuRender].MaxMs, 4.0));
+    CHECK(stats.Stages[(size_t) LatencyStage::GpuRender].Outliers == 0);
+
+    // Only the intervals after the restart
+    CHECK(Near(stats.IntervalP50Ms, 16.0));
+}
+
+static void Percentiles()
+{
+    LatencyAnalytics::Reset();
+
+    // Simulation takes 1..100 ms
+    Trace trace;
+    for (int i = 1; i <= 100; i++)
+        trace.Add({ .IntervalMs = 110.0, .SimMs = (double) i });
+
+    for (size_t last = 0; last < trace.Frames.size(); last += 16)
+        Consume(trace.Window(last));
+
+    Consume(trace.Window(trace.Frames.size() - 1));
+
+    auto stats = LatencyAnalytics::GetStats();
+    CHECK(stats.Frames == 100);
+
+    auto& sim = stats.Stages[(size_t) LatencyStage::Simulation];
+    CHECK(Near(sim.P50Ms, 50.0));
+    CHECK(Near(sim.P99Ms, 99.0));
+    CHECK(Near(sim.MaxMs, 100.0));
+
+    auto& present = stats.Stages[(size_t) LatencyStage::Present];
+    CHECK(Near(present.P50Ms, 0.5) && Near(present.MaxMs, 0.5) && present.Outliers == 0);
+
+    // Sim start to GPU end, GPU starts with the submit
+    CHECK(Near(stats.Total.P50Ms, 50.0 + 8.0));
+    CHECK(Near(stats.Total.MaxMs, 100.0 + 8.0));
+
+    // History keeps the newest HistorySize frames
+    for (int i = 0; i < 300; i++)
+        trace.Add({ .IntervalMs = 110.0, .SimMs = 2.0 });
+
+    for (size_t last = 100; last < trace.Frames.size(); last += 32)
+        Consume(trace.Window(last));
+
+    Consume(trace.Window(trace.Frames.size() - 1));
+
+    stats = LatencyAnalytics::GetStats();
+    CHECK(stats.Frames == LatencyAnalytics::HistorySize);
+    CHECK(stats.LastFrameId == 400);
+    CHECK(Near(stats.Stages[(size_t) LatencyStage::Simulation].MaxMs, 2.0));
+}
+
+static void OutliersAndStalls()
+{
+    LatencyAnalytics::Reset();
+
+    // GPU time alternates 4.9 / 5.1 ms, three spikes and one frame only slightly slower
+    Trace trace;
+    for (int i = 0; i < 200; i++)
+    {
+        FrameShape shape {};
+        shape.GpuMs = (i % 2) == 0 ? 4.9 : 5.1;
+
+        if (i == 50 || i == 120 || i == 190)
+            shape.GpuMs = 20.0;
+
+        // Over 4 MADs (0.1 ms) but within the 1 ms minimum
+        if (i == 80)
+            shape.GpuMs = 5.8;
+
+        // Two hitches, 2.5 x median interval is the limit
+        if (i == 60 || i == 150)
+            shape.IntervalMs = 50.0;
+
+        // Just under the stall limit
+        if (i == 100)
+            shape.IntervalMs = 39.0;
+
+        trace.Add(shape);
+    }
+
+    for (size_t last = 0; last < trace.Frames.size(); last += 48)
+        Consume(trace.Window(last));
+
+    Consume(trace.Window(trace.Frames.size() - 1));
+
+    auto stats = LatencyAnalytics::GetStats();
+    CHECK(stats.Frames == 200);
+
+    auto& gpu = stats.Stages[(size_t) LatencyStage::GpuRender];
+    CHECK(gpu.Outliers == 3);
+    CHECK(Near(gpu.MaxMs, 20.0));
+    CHECK(Near(gpu.P50Ms, 4.9) || Near(gpu.P50Ms, 5.1));
+
+    // Sim and submit are constant, total follows the GPU
+    CHECK(stats.Total.Outliers == 3);
+    CHECK(stats.Stages[(size_t) LatencyStage::Simulation].Outliers == 0);
+
+    CHECK(Near(stats.IntervalP50Ms, 16.0));
+    CHECK(stats.Stalls == 2);
+
+    // Faster frames are never outliers, only the slow side counts
+    LatencyAnalytics::Reset();
+
+    Trace fast;
+    for (int i = 0; i < 100; i++)
+        fast.Add({ .GpuMs = i == 40 ? 0.5 : 10.0 });
+
+    Consume(fast.Window(63));
+    Consume(fast.Window(99));
+
+    CHECK(LatencyAnalytics::GetStats().Stages[(size_t) LatencyStage::GpuRender].Outliers == 0);
+}
+
+int main()
+{
+    Dedup();
+    FrameIdReset();
+    Percentiles();
+    OutliersAndStalls();
+
+    if (failures == 0)
+        printf("All checks passed\n");
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+// Linux stand-in for magic_enum::enum_name, names come from __PRETTY_FUNCTION__ like in the real library.
+// Values 0-31 are scanned, enough for the latency stages.
+
+#include <string_view>
+#include <utility>
+
+namespace magic_enum
+{
+namespace detail
+{
+template <auto V> std::string_view RawName() { return __PRETTY_FUNCTION__; }
+
+// "... [with auto V = LatencyStage::Present; ...]", values without a name are printed as "(LatencyStage)12"
+template <auto V> std::string_view Name()
+{
+    auto raw = RawName<V>();
+    auto start = raw.find("V = ") + 4;
+    auto name = raw.substr(start, raw.find_first_of(";]", start) - start);
+
+    if (name.starts_with('('))
+        return {};
+
+    return name.substr(name.rfind("::") + 2);
+}
+
+template <typename E, size_t... I> std::string_view Find(E value, std::index_sequence<I...>)
+{
+    std::string_view result;
+    ((value == (E) I ? void(result = Name<(E) I>()) : void()), ...);
+    return result;
+}
+} // namespace detail
+
+template <typename E> std::string_view enum_name(E value)
+{
+    return detail::Find(value, std::make_index_sequence<32> {});
+}
+} // namespace magic_enum
@@ -0,0 +1,426 @@
+// Headless benchmark of the reduced rate menu rebuild ([Menu] RefreshRate). Builds a menu sized UI with the real
+// ImGui core and records it through a backend stand-in that uploads vertices / indices and records draws per
+// backbuffer like the DX12 and Vulkan overlays. Frames between rebuilds submit the cached recording through
+// MenuDrawCache. Checks that skipped frames keep the draw data, that replays match a fresh recording and that every
+// backbuffer is recorded once per rebuild.
+//
+// Build and run on Linux from this directory, needs the FreeType headers (libfreetype-dev):
+//   IMGUI=../../OptiScaler/include/imgui
+//   g++ -std=c++20 -O2 -I. -I../../OptiScaler -I../../OptiScaler/include -I/usr/include/freetype2 menu_replay_bench.cpp
+//       $IMGUI/imgui.cpp $IMGUI/imgui_draw.cpp $IMGUI/imgui_widgets.cpp $IMGUI/imgui_tables.cpp
+//       $IMGUI/misc/freetype/imgui_freetype.cpp -lfreetype -o check
+//   ./check [frames]
+// Prints the CPU time per frame for each refresh rate, exits with 1 when a check fails.
+
+#include <menu/menu_draw_cache.h>
+
+#include <imgui/imgui.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(expr)                                                                                                    \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expr))                                                                                                   \
+        {                                                                                                              \
+            printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #expr);                                                   \
+            failures++;                                                                                                \
+        }                                                                                                              \
+    } while (0)
+
+static constexpr uint32_t BackbufferCount = 3;
+static constexpr double FrameRate = 144.0;
+
+// What ImGui_ImplDX12_RenderDrawData puts in a command list for one draw
+struct Draw
+{
+    int Scissor[4];
+    ImTextureID Texture;
+    uint32_t ElemCount;
+    uint32_t StartIndex;
+    int32_t BaseVertex;
+
+    bool operator==(const Draw& other) const { return memcmp(this, &other, sizeof(Draw)) == 0; }
+};
+
+// Per backbuffer vertex / index buffers and recorded draws, the GPU side of the overlay
+class RecordingBackend
+{
+  public:
+    struct Backbuffer
+    {
+        std::vector<ImDrawVert> Vertices;
+        std::vector<ImDrawIdx> Indices;
+        std::vector<Draw> Draws;
+    };
+
+    Backbuffer Backbuffers[BackbufferCount];
+    MenuDrawCache Cache;
+    uint32_t Recordings = 0;
+    uint32_t Replays = 0;
+    size_t SubmittedDraws = 0;
+
+    void Present(uint32_t backbuffer, uint64_t generation)
+    {
+        if (Cache.CanReplay(backbuffer, generation))
+        {
+            Replays++;
+            SubmittedDraws += Backbuffers[backbuffer].Draws.size();
+            return;
+        }
+
+        Cache.Invalidate(backbuffer);
+        Record(ImGui::GetDrawData(), Backbuffers[backbuffer]);
+        Cache.Recorded(backbuffer, generation);
+
+        Recordings++;
+        SubmittedDraws += Backbuffers[backbuffer].Draws.size();
+    }
+
+    static void Record(ImDrawData* drawData, Backbuffer& target)
+    {
+        UpdateTextures(drawData);
+
+        // Upload
+        target.Vertices.resize(drawData->TotalVtxCount);
+        target.Indices.resize(drawData->TotalIdxCount);
+
+        auto vtxDst = target.Vertices.data();
+        auto idxDst = target.Indices.data();
+
+        for (auto drawList : drawData->CmdLists)
+        {
+            memcpy(vtxDst, drawList->VtxBuffer.Data, drawList->VtxBuffer.Size * sizeof(ImDrawVert));
+            memcpy(idxDst, drawList->IdxBuffer.Data, drawList->IdxBuffer.Size * sizeof(ImDrawIdx));
+            vtxDst += drawList->VtxBuffer.Size;
+            idxDst += drawList->IdxBuffer.Size;
+        }
+
+        // Draws
+        target.Draws.clear();
+
+        int vtxOffset = 0;
+        int idxOffset = 0;
+        auto clipOff = drawData->DisplayPos;
+        auto clipScale = drawData->FramebufferScale;
+
+        for (auto drawList : drawData->CmdLists)
+        {
+            for (auto& cmd : drawList->CmdBuffer)
+            {
+                ImVec2 clipMin((cmd.ClipRect.x - clipOff.x) * clipScale.x, (cmd.ClipRect.y - clipOff.y) * clipScale.y);
+                ImVec2 clipMax((cmd.ClipRect.z - clipOff.x) * clipScale.x, (cmd.ClipRect.w - clipOff.y) * clipScale.y);
+
+                if (clipMax.x <= clipMin.x || clipMax.y <= clipMin.y)
+                    continue;
+
+                Draw draw {};
+                draw.Scissor[0] = (int) clipMin.x;
+                draw.Scissor[1] = (int) clipMin.y;
+                draw.Scissor[2] = (int) clipMax.x;
+                draw.Scissor[3] = (int) clipMax.y;
+                draw.Texture = cmd.GetTexID();
+                draw.ElemCount = cmd.ElemCount;
+                draw.StartIndex = cmd.IdxOffset + idxOffset;
+                draw.BaseVertex = cmd.VtxOffset + vtxOffset;
+                target.Draws.push_back(draw);
+            }
+
+            idxOffset += drawList->IdxBuffer.Size;
+            vtxOffset += drawList->VtxBuffer.Size;
+        }
+    }
+
+  private:
+    // Font atlas "upload", only the ids matter here
+    static void UpdateTextures(ImDrawData* drawData)
+    {
+        if (drawData->Textures == nullptr)
+            return;
+
+        for (auto texture : *drawData->Textures)
+        {
+            if (texture->Status == ImTextureStatus_WantCreate)
+                texture->SetTexID((ImTextureID) (texture->UniqueID + 1));
+
+            if (texture->Status == ImTextureStatus_WantDestroy)
+            {
+                texture->SetTexID(ImTextureID_Invalid);
+                texture->SetStatus(ImTextureStatus_Destroyed);
+                continue;
+            }
+
+            if (texture->Status != ImTextureStatus_OK)
+                texture->SetStatus(ImTextureStatus_OK);
+        }
+    }
+};
+
+// Roughly the open menu with the FPS overlay and its graphs
+static void BuildUi(uint64_t frame)
+{
+    static float frameTimes[300];
+    for (int i = 0; i < 300; i++)
+        frameTimes[i] = 6.9f + 0.5f * (float) ((frame + i) % 7);
+
+    ImGui::SetNextWindowPos({ 10, 10 });
+    ImGui::Begin("Overlay", nullptr, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoDecoration);
+    ImGui::Text("FPS: %5.1f  %5.2f ms", 144.0, 6.94);
+    ImGui::PlotLines("##FrameTimes", frameTimes, 300, 0, nullptr, 0.0f, 20.0f, { 300, 40 });
+    ImGui::PlotHistogram("##UpscalerTimes", frameTimes, 300, 0, nullptr, 0.0f, 20.0f, { 300, 40 });
+    ImGui::End();
+
+    ImGui::SetNextWindowPos({ 400, 100 });
+    ImGui::SetNextWindowSize({ 700, 900 });
+    ImGui::Begin("OptiScaler");
+
+    static bool checks[64] {};
+    static float sliders[32] {};
+    static int combos[16] {};
+    const char* items[] = { "FSR 3.1", "XeSS", "DLSS", "FSR 2.2" };
+
+    for (int section = 0; section < 8; section++)
+    {
+        ImGui::PushID(section);
+        ImGui::SetNextItemOpen(true);
+
+        if (ImGui::CollapsingHeader("Section"))
+        {
+            for (int i = 0; i < 8; i++)
+                ImGui::Checkbox("Option", &checks[section * 8 + i]);
+
+            for (int i = 0; i < 4; i++)
+                ImGui::SliderFloat("Value", &sliders[section * 4 + i], 0.0f, 1.0f);
+
+            for (int i = 0; i < 2; i++)
+                ImGui::Combo("Backend", &combos[section * 2 + i], items, 4);
+
+            ImGui::TextWrapped("Help text that explains what the options in this section do and when to use them.");
+        }
+
+        ImGui::PopID();
+    }
+
+    ImGui::End();
+}
+
+// Mirrors RenderMenu, the UI is only rebuilt at the refresh rate
+class MenuLoop
+{
+  public:
+    uint64_t Generation = 0;
+    uint64_t Frame = 0;
+
+    explicit MenuLoop(int refreshRate) : _refreshRate(refreshRate) {}
+
+    bool Rebuild()
+    {
+        auto now = (double) Frame * 1000.0 / FrameRate;
+        return _refreshRate <= 0 || Generation == 0 || now - _buildTime >= 1000.0 / _refreshRate;
+    }
+
+    void Run(RecordingBackend& backend)
+    {
+        auto& io = ImGui::GetIO();
+
+        if (Rebuild())
+        {
+            _buildTime = (double) Frame * 1000.0 / FrameRate;
+            Generation++;
+
+            io.DeltaTime = 1.0f / (float) FrameRate;
+            ImGui::NewFrame();
+            BuildUi(Frame);
+        }
+
+        // No op on skipped frames, draw data of the last build stays
+        ImGui::Render();
+
+        backend.Present((uint32_t) (Frame % BackbufferCount), Generation);
+        Frame++;
+    }
+
+  private:
+    int _refreshRate;
+    double _buildTime = 0.0;
+};
+
+static void SetupContext()
+{
+    ImGui::CreateContext();
+
+    auto& io = ImGui::GetIO();
+    io.DisplaySize = { 1920, 1080 };
+    io.DeltaTime = 1.0f / (float) FrameRate;
+    io.IniFilename = nullptr;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures | ImGuiBackendFlags_RendererHasVtxOffset;
+}
+
+static uint64_t HashDrawData(ImDrawData* drawData)
+{
+    uint64_t hash = 1469598103934665603ull;
+
+    auto add = [&hash](const void* data, size_t size)
+    {
+        auto bytes = (const uint8_t*) data;
+        for (size_t i = 0; i < size; i++)
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+    };
+
+    for (auto drawList : drawData->CmdLists)
+    {
+        add(drawList->VtxBuffer.Data, drawList->VtxBuffer.Size * sizeof(ImDrawVert));
+        add(drawList->IdxBuffer.Data, drawList->IdxBuffer.Size * sizeof(ImDrawIdx));
+    }
+
+    return hash;
+}
+
+static void DrawDataKept()
+{
+    SetupContext();
+
+    RecordingBackend backend;
+    MenuLoop loop(10);
+
+    // Settle the auto sized windows and the font atlas
+    for (int i = 0; i < 200; i++)
+        loop.Run(backend);
+
+    auto generation = loop.Generation;
+    auto hash = HashDrawData(ImGui::GetDrawData());
+    auto vertices = ImGui::GetDrawData()->TotalVtxCount;
+    CHECK(vertices > 1000);
+
+    // Frames up to the next rebuild keep the same draw data
+    while (!loop.Rebuild())
+    {
+        loop.Run(backend);
+
+        CHECK(loop.Generation == generation);
+        CHECK(ImGui::GetDrawData()->Valid);
+        CHECK(ImGui::GetDrawData()->TotalVtxCount == vertices);
+        CHECK(HashDrawData(ImGui::GetDrawData()) == hash);
+    }
+
+    // Replayed recordings match a fresh recording of the current draw data
+    RecordingBackend::Backbuffer fresh;
+    RecordingBackend::Record(ImGui::GetDrawData(), fresh);
+
+    for (auto& backbuffer : backend.Backbuffers)
+    {
+        CHECK(backbuffer.Draws == fresh.Draws);
+        CHECK(backbuffer.Vertices.size() == fresh.Vertices.size());
+        CHECK(memcmp(backbuffer.Vertices.data(), fresh.Vertices.data(), fresh.Vertices.size() * sizeof(ImDrawVert)) ==
+              0);
+    }
+
+    ImGui::DestroyContext();
+}
+
+static void RecordOncePerRebuild()
+{
+    SetupContext();
+
+    // 144 fps at 10 Hz, rebuild every 15th frame
+    RecordingBackend backend;
+    MenuLoop loop(10);
+
+    for (int i = 0; i < 1500; i++)
+        loop.Run(backend);
+
+    CHECK(loop.Generation == 100);
+    CHECK(backend.Recordings == loop.Generation * BackbufferCount);
+    CHECK(backend.Replays == 1500 - backend.Recordings);
+
+    // Recreated render targets, everything is recorded again
+    backend.Cache.Clear();
+    auto recordings = backend.Recordings;
+
+    for (uint32_t i = 0; i < BackbufferCount; i++)
+        CHECK(!backend.Cache.CanReplay(i, loop.Generation));
+
+    for (uint32_t i = 0; i < BackbufferCount; i++)
+        loop.Run(backend);
+
+    CHECK(backend.Recordings == recordings + BackbufferCount);
+
+    // Failed recording isn't replayed
+    backend.Cache.Invalidate(1);
+    CHECK(!backend.Cache.CanReplay(1, loop.Generation));
+    CHECK(backend.Cache.CanReplay(0, loop.Generation));
+
+    // Generation 0 means nothing was built
+    MenuDrawCache empty;
+    empty.Recorded(0, 0);
+    CHECK(!empty.CanReplay(0, 0));
+
+    // Rebuilding every frame never replays
+    RecordingBackend everyFrame;
+    MenuLoop always(0);
+
+    for (int i = 0; i < 100; i++)
+        always.Run(everyFrame);
+
+    CHECK(everyFrame.Replays == 0);
+    CHECK(everyFrame.Recordings == 100);
+
+    ImGui::DestroyContext();
+}
+
+static void Benchmark(int frames)
+{
+    const int rates[] = { 0, 30, 10, 4 };
+
+    for (auto rate : rates)
+    {
+        SetupContext();
+
+        RecordingBackend backend;
+        MenuLoop loop(rate);
+
+        for (int i = 0; i < 200; i++)
+            loop.Run(backend);
+
+        backend.Recordings = 0;
+        backend.Replays = 0;
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < frames; i++)
+            loop.Run(backend);
+
+        auto us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+        if (rate == 0)
+            printf("%-14s", "every frame");
+        else
+            printf("%-2d Hz%9s", rate, "");
+
+        printf(" %8.2f us/frame  %5u recordings  %5u replays  %6d vertices\n", us / frames, backend.Recordings,
+               backend.Replays, ImGui::GetDrawData()->TotalVtxCount);
+
+        ImGui::DestroyContext();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 5000;
+
+    DrawDataKept();
+    RecordOncePerRebuild();
+    Benchmark(frames);
+
+    if (failures == 0)
+        printf("All checks passed\n");
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+// Linux stand-in for OptiScaler/NVNGX_Parameter.h. Parameter matches the real variant, the table keeps
+// insertion order so the check knows the order snapshot() returns.
+
+#include "SysUtils.h"
+
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace NGX_AllocTypes
+{
+constexpr std::string_view AllocKey = "OptiScaler.ParamAllocType";
+
+constexpr uint32_t Unknown = 0;
+constexpr uint32_t NVDynamic = 1;
+constexpr uint32_t NVPersistent = 2;
+constexpr uint32_t InternDynamic = 3;
+constexpr uint32_t InternPersistent = 4;
+} // namespace NGX_AllocTypes
+
+struct Parameter
+{
+    template <typename T> void operator=(T value)
+    {
+        key = typeid(T).hash_code();
+        if constexpr (std::is_same<T, float>::value)
+            values.f = value;
+        else if constexpr (std::is_same<T, int>::value)
+            values.i = value;
+        else if constexpr (std::is_same<T, unsigned int>::value)
+            values.ui = value;
+        else if constexpr (std::is_same<T, double>::value)
+            values.d = value;
+        else if constexpr (std::is_same<T, unsigned long long>::value)
+            values.ull = value;
+        else if constexpr (std::is_same<T, void*>::value)
+            values.vp = value;
+        else if constexpr (std::is_same<T, ID3D11Resource*>::value)
+            values.d11r = value;
+        else if constexpr (std::is_same<T, ID3D12Resource*>::value)
+            values.d12r = value;
+    }
+
+    union
+    {
+        float f;
+        double d;
+        int i;
+        unsigned int ui;
+        unsigned long long ull;
+        void* vp;
+        ID3D11Resource* d11r;
+        ID3D12Resource* d12r;
+    } values;
+
+    size_t key = 0;
+};
+
+struct NVNGX_Parameters : public NVSDK_NGX_Parameter
+{
+    explicit NVNGX_Parameters(uint32_t allocType = NGX_AllocTypes::InternDynamic)
+    {
+        Set(NGX_AllocTypes::AllocKey.data(), (unsigned int) allocType);
+    }
+
+    template <typename T> void Set(const char* key, T value)
+    {
+        for (auto& [name, parameter] : m_values)
+        {
+            if (name == key)
+            {
+                parameter = value;
+                return;
+            }
+        }
+
+        m_values.emplace_back(key, Parameter {});
+        m_values.back().second = value;
+    }
+
+    NVSDK_NGX_Result Get(const char* key, unsigned int* value) const override
+    {
+        for (auto& [name, parameter] : m_values)
+        {
+            if (name == key && parameter.key == typeid(unsigned int).hash_code())
+            {
+                *value = parameter.values.ui;
+                return NVSDK_NGX_Result_Success;
+            }
+        }
+
+        return NVSDK_NGX_Result_Fail;
+    }
+
+    std::vector<std::pair<std::string, Parameter>> snapshot() const { return m_values; }
+
+  private:
+    std::vector<std::pair<std::string, Parameter>> m_values;
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+// Linux stand-in for OptiScaler/SysUtils.h and the NGX / D3D declarations ApiCapture uses.
+// Resource desc fields keep their D3D12 order, enums are plain integers.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <typeinfo>
+
+#define LOG_TRACE(...) ((void) 0)
+#define LOG_DEBUG(...) ((void) 0)
+#define LOG_INFO(...) ((void) 0)
+#define LOG_WARN(...) ((void) 0)
+#define LOG_ERROR(...) ((void) 0)
+
+enum NVSDK_NGX_Result : int32_t
+{
+    NVSDK_NGX_Result_Success = 0x1,
+    NVSDK_NGX_Result_Fail = (int32_t) 0xBAD00000,
+    NVSDK_NGX_Result_FAIL_InvalidParameter = (int32_t) 0xBAD00005,
+};
+
+struct D3D12_RESOURCE_DESC
+{
+    uint32_t Dimension;
+    uint64_t Alignment;
+    uint64_t Width;
+    uint32_t Height;
+    uint16_t DepthOrArraySize;
+    uint16_t MipLevels;
+    uint32_t Format;
+    struct
+    {
+        uint32_t Count;
+        uint32_t Quality;
+    } SampleDesc;
+    uint32_t Layout;
+    uint32_t Flags;
+};
+
+struct ID3D11Resource
+{
+};
+
+struct ID3D12Resource
+{
+    virtual D3D12_RESOURCE_DESC GetDesc() = 0;
+    virtual ~ID3D12Resource() = default;
+};
+
+// Only the getter ApiCapture uses to check the table type
+struct NVSDK_NGX_Parameter
+{
+    virtual NVSDK_NGX_Result Get(const char* key, unsigned int* value) const = 0;
+    virtual ~NVSDK_NGX_Parameter() = default;
+};
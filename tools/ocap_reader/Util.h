@@ -0,0 +1,11 @@
+#pragma once
+
+// Linux stand-in for OptiScaler/Util.h, the check provides the clock and the dll path
+
+#include <filesystem>
+
+namespace Util
+{
+double MillisecondsNow();
+std::filesystem::path DllPath();
+} // namespace Util
@@ -0,0 +1,404 @@
+// Reads OptiScaler API captures (optiscaler_capture.ocap, [Log] ApiCapture=true) and prints their records.
+// Without a file it checks the reader against the real writer: ApiCapture.cpp is built with stand-ins, a scripted
+// create / evaluate / release sequence is captured and parsed back field by field, then truncated and corrupted
+// copies of the file and the MaxEvaluates cut off are checked.
+//
+// Build and run on Linux from this directory:
+//   g++ -std=c++20 -O2 -I. -I../../OptiScaler ocap_reader.cpp ../../OptiScaler/misc/ApiCapture.cpp -o check
+//   ./check                      (round trip check)
+//   ./check optiscaler_capture.ocap  (dump a capture)
+// Exits with 1 when a check fails or the file can't be parsed.
+
+#include "ocap_reader.h"
+
+#include <NVNGX_Parameter.h>
+#include <Util.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+static int failures = 0;
+
+#define CHECK(expr)                                                                                                    \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expr))                                                                                                   \
+        {                                                                                                              \
+            printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #expr);                                                   \
+            failures++;                                                                                                \
+        }                                                                                                              \
+    } while (0)
+
+static double fakeNow = 1000.0;
+static std::filesystem::path captureDir;
+
+double Util::MillisecondsNow() { return fakeNow; }
+std::filesystem::path Util::DllPath() { return captureDir / "OptiScaler.dll"; }
+
+static std::vector<uint8_t> ReadFile(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+}
+
+static const char* EventName(ApiCaptureEvent event)
+{
+    switch (event)
+    {
+    case ApiCaptureEvent::CreateFeature:
+        return "CreateFeature";
+    case ApiCaptureEvent::Evaluate:
+        return "Evaluate";
+    case ApiCaptureEvent::Release:
+        return "Release";
+    }
+
+    return "?";
+}
+
+static void PrintParameter(const OcapParameter& parameter)
+{
+    printf("    %-40s ", parameter.Key.c_str());
+
+    switch (parameter.Type)
+    {
+    case ApiCaptureValue::Float:
+        printf("float %g\n", parameter.As<float>());
+        break;
+    case ApiCaptureValue::Double:
+        printf("double %g\n", parameter.As<double>());
+        break;
+    case ApiCaptureValue::Int:
+        printf("int %d\n", parameter.As<int32_t>());
+        break;
+    case ApiCaptureValue::UInt:
+        printf("uint %u\n", parameter.As<uint32_t>());
+        break;
+    case ApiCaptureValue::ULongLong:
+        printf("ulonglong %llu\n", (unsigned long long) parameter.Bits);
+        break;
+    case ApiCaptureValue::Pointer:
+        printf("pointer 0x%llx\n", (unsigned long long) parameter.Bits);
+        break;
+    case ApiCaptureValue::Dx11Resource:
+        printf("dx11 resource 0x%llx\n", (unsigned long long) parameter.Bits);
+        break;
+    case ApiCaptureValue::Dx12Resource:
+    {
+        auto& desc = *parameter.Resource;
+        printf("dx12 resource 0x%llx dim %u %llux%u x%u mips %u format %u flags 0x%x\n",
+               (unsigned long long) parameter.Bits, desc.Dimension, (unsigned long long) desc.Width, desc.Height,
+               desc.DepthOrArraySize, desc.MipLevels, desc.Format, desc.Flags);
+        break;
+    }
+    default:
+        printf("unknown 0x%llx\n", (unsigned long long) parameter.Bits);
+        break;
+    }
+}
+
+static int Dump(const char* path)
+{
+    OcapCapture capture;
+    std::string error;
+
+    if (!OcapReader::Parse(ReadFile(path), capture, &error))
+    {
+        printf("%s: %s\n", path, error.c_str());
+        return 1;
+    }
+
+    printf("%s: version %u, %zu records%s\n", path, capture.Version, capture.Records.size(),
+           capture.Truncated ? ", last record truncated" : "");
+
+    for (size_t i = 0; i < capture.Records.size(); i++)
+    {
+        auto& record = capture.Records[i];
+
+        printf("#%zu %10.3f ms %-13s handle %u result 0x%08x call %.3f ms", i, record.TimeNs / 1000000.0,
+               EventName(record.Event), record.HandleId, (uint32_t) record.Result, record.CallMs);
+
+        if (record.Event == ApiCaptureEvent::CreateFeature)
+            printf(" feature %u", record.FeatureId);
+
+        printf("\n");
+
+        for (auto& parameter : record.Parameters)
+            PrintParameter(parameter);
+    }
+
+    return 0;
+}
+
+class FakeResource : public ID3D12Resource
+{
+  public:
+    D3D12_RESOURCE_DESC Desc {};
+
+    D3D12_RESOURCE_DESC GetDesc() override { return Desc; }
+};
+
+static std::filesystem::path CapturePath() { return captureDir / "optiscaler_capture.ocap"; }
+
+static void RoundTrip()
+{
+    FakeResource color;
+    color.Desc.Dimension = 3; // TEXTURE2D
+    color.Desc.Width = 1920;
+    color.Desc.Height = 1080;
+    color.Desc.DepthOrArraySize = 1;
+    color.Desc.MipLevels = 1;
+    color.Desc.Format = 10; // R16G16B16A16_FLOAT
+    color.Desc.Flags = 0x4; // ALLOW_UNORDERED_ACCESS
+
+    NVNGX_Parameters params;
+    params.Set("Width", 3840u);
+    params.Set("Height", 2160u);
+    params.Set("Jitter.Offset.X", -0.25f);
+    params.Set("Sharpness", 0.5);
+    params.Set("Reset", -1);
+    params.Set("FrameIndex", 1ull << 40);
+    params.Set("Callback", (void*) 0x1234);
+    params.Set("Color11", (ID3D11Resource*) 0x5678);
+    params.Set("Color", (ID3D12Resource*) &color);
+    params.Set("Depth", (ID3D12Resource*) nullptr);
+
+    // Create, handle id is only known after the call
+    {
+        ApiCapture::CallRecord record(ApiCaptureEvent::CreateFeature, 0, &params, 11);
+        fakeNow += 2.5;
+        record.SetHandleId(7);
+        record.End(NVSDK_NGX_Result_Success);
+    }
+
+    // Evaluates, parameters are taken before the call even if the call changes them
+    for (int i = 0; i < 4; i++)
+    {
+        fakeNow += 16.0;
+        params.Set("Jitter.Offset.X", 0.125f * i);
+
+        ApiCapture::CallRecord record(ApiCaptureEvent::Evaluate, 7, &params);
+        params.Set("Jitter.Offset.X", 99.0f);
+        fakeNow += 1.25;
+        record.End(i == 2 ? NVSDK_NGX_Result_FAIL_InvalidParameter : NVSDK_NGX_Result_Success);
+    }
+
+    // Tables that can't be enumerated are written without parameters
+    NVNGX_Parameters foreign(NGX_AllocTypes::NVDynamic);
+    foreign.Set("Width", 1u);
+
+    fakeNow += 16.0;
+    ApiCapture::CallRecord(ApiCaptureEvent::Evaluate, 7, nullptr).End(NVSDK_NGX_Result_Success);
+    ApiCapture::CallRecord(ApiCaptureEvent::Evaluate, 7, &foreign).End(NVSDK_NGX_Result_Success);
+
+    // Never finished, nothing is written
+    {
+        ApiCapture::CallRecord abandoned(ApiCaptureEvent::Evaluate, 7, &params);
+    }
+
+    fakeNow += 3.0;
+    ApiCapture::CallRecord(ApiCaptureEvent::Release, 7, nullptr).End(NVSDK_NGX_Result_Success);
+
+    // Release flushes the file
+    auto data = ReadFile(CapturePath());
+
+    OcapCapture capture;
+    std::string error;
+    CHECK(OcapReader::Parse(data, capture, &error));
+    CHECK(error.empty());
+    CHECK(capture.Version == ApiCapture::Version);
+    CHECK(!capture.Truncated);
+    CHECK(capture.Records.size() == 8);
+
+    if (capture.Records.size() != 8)
+        return;
+
+    auto& create = capture.Records[0];
+    CHECK(create.Event == ApiCaptureEvent::CreateFeature);
+    CHECK(create.HandleId == 7);
+    CHECK(create.FeatureId == 11);
+    CHECK(create.TimeNs == 0);
+    CHECK(create.CallMs == 2.5f);
+    CHECK(create.Result == NVSDK_NGX_Result_Success);
+    CHECK(create.Parameters.size() == 11);
+
+    auto alloc = create.Find(std::string(NGX_AllocTypes::AllocKey));
+    CHECK(alloc != nullptr && alloc->Type == ApiCaptureValue::UInt &&
+          alloc->As<uint32_t>() == NGX_AllocTypes::InternDynamic);
+
+    auto width = create.Find("Width");
+    CHECK(width != nullptr && width->Type == ApiCaptureValue::UInt && width->As<uint32_t>() == 3840);
+
+    auto jitter = create.Find("Jitter.Offset.X");
+    CHECK(jitter != nullptr && jitter->Type == ApiCaptureValue::Float && jitter->As<float>() == -0.25f);
+
+    auto sharpness = create.Find("Sharpness");
+    CHECK(sharpness != nullptr && sharpness->Type == ApiCaptureValue::Double && sharpness->As<double>() == 0.5);
+
+    auto reset = create.Find("Reset");
+    CHECK(reset != nullptr && reset->Type == ApiCaptureValue::Int && reset->As<int32_t>() == -1);
+
+    auto frame = create.Find("FrameIndex");
+    CHECK(frame != nullptr && frame->Type == ApiCaptureValue::ULongLong && frame->Bits == (1ull << 40));
+
+    auto callback = create.Find("Callback");
+    CHECK(callback != nullptr && callback->Type == ApiCaptureValue::Pointer && callback->Bits == 0x1234);
+
+    auto color11 = create.Find("Color11");
+    CHECK(color11 != nullptr && color11->Type == ApiCaptureValue::Dx11Resource && color11->Bits == 0x5678 &&
+          !color11->Resource);
+
+    auto color12 = create.Find("Color");
+    CHECK(color12 != nullptr && color12->Type == ApiCaptureValue::Dx12Resource &&
+          color12->Bits == (uint64_t) (uintptr_t) (ID3D12Resource*) &color && color12->Resource.has_value());
+
+    if (color12 != nullptr && color12->Resource)
+    {
+        auto& desc = *color12->Resource;
+        CHECK(desc.Dimension == 3 && desc.Width == 1920 && desc.Height == 1080);
+        CHECK(desc.DepthOrArraySize == 1 && desc.MipLevels == 1 && desc.Format == 10 && desc.Flags == 0x4);
+    }
+
+    // Null resource is written with an empty desc
+    auto depth = create.Find("Depth");
+    CHECK(depth != nullptr && depth->Type == ApiCaptureValue::Dx12Resource && depth->Bits == 0 && depth->Resource &&
+          depth->Resource->Width == 0 && depth->Resource->Format == 0);
+
+    // Snapshot order is kept
+    CHECK(create.Parameters.front().Key == NGX_AllocTypes::AllocKey);
+    CHECK(create.Parameters.back().Key == "Depth");
+
+    for (int i = 0; i < 4; i++)
+    {
+        auto& evaluate = capture.Records[1 + i];
+        CHECK(evaluate.Event == ApiCaptureEvent::Evaluate);
+        CHECK(evaluate.HandleId == 7);
+        CHECK(evaluate.FeatureId == 0);
+        CHECK(evaluate.CallMs == 1.25f);
+        CHECK(evaluate.TimeNs == (uint64_t) ((i + 1) * 17.25 * 1000000.0));
+        CHECK(evaluate.Result ==
+              (i == 2 ? NVSDK_NGX_Result_FAIL_InvalidParameter : NVSDK_NGX_Result_Success));
+        CHECK(evaluate.Parameters.size() == 11);
+
+        auto evaluateJitter = evaluate.Find("Jitter.Offset.X");
+        CHECK(evaluateJitter != nullptr && evaluateJitter->As<float>() == 0.125f * i);
+    }
+
+    CHECK(capture.Records[5].Event == ApiCaptureEvent::Evaluate && capture.Records[5].Parameters.empty());
+    CHECK(capture.Records[6].Event == ApiCaptureEvent::Evaluate && capture.Records[6].Parameters.empty());
+
+    auto& release = capture.Records[7];
+    CHECK(release.Event == ApiCaptureEvent::Release);
+    CHECK(release.HandleId == 7);
+    CHECK(release.Parameters.empty());
+    CHECK(release.TimeNs == (uint64_t) ((4 * 17.25 + 16.0 + 3.0) * 1000000.0));
+
+    // Every cut keeps the complete records before it
+    size_t boundaries = 0;
+
+    for (size_t cut = 16; cut <= data.size(); cut++)
+    {
+        std::vector<uint8_t> prefix(data.begin(), data.begin() + cut);
+        OcapCapture partial;
+
+        if (!OcapReader::Parse(prefix, partial, nullptr))
+        {
+            CHECK(!"truncated capture failed to parse");
+            break;
+        }
+
+        if (!partial.Truncated)
+            boundaries++;
+
+        CHECK(partial.Records.size() <= capture.Records.size());
+
+        for (size_t i = 0; i < partial.Records.size() && i < capture.Records.size(); i++)
+        {
+            CHECK(partial.Records[i].Event == capture.Records[i].Event);
+            CHECK(partial.Records[i].TimeNs == capture.Records[i].TimeNs);
+            CHECK(partial.Records[i].Parameters.size() == capture.Records[i].Parameters.size());
+        }
+    }
+
+    CHECK(boundaries == capture.Records.size() + 1);
+
+    // Header checks
+    OcapCapture broken;
+    CHECK(!OcapReader::Parse(std::vector<uint8_t>(data.begin(), data.begin() + 10), broken, nullptr));
+
+    auto badMagic = data;
+    badMagic[0] = 'X';
+    CHECK(!OcapReader::Parse(badMagic, broken, &error));
+
+    auto badVersion = data;
+    badVersion[8] = ApiCapture::Version + 1;
+    CHECK(!OcapReader::Parse(badVersion, broken, &error));
+
+    // Record header is event, handle, time, call ms, result, payload size
+    auto badEvent = data;
+    badEvent[16] = 9;
+    CHECK(!OcapReader::Parse(badEvent, broken, &error));
+
+    // Payload size one byte larger than its contents
+    auto badPayload = data;
+    uint32_t payloadSize = 0;
+    memcpy(&payloadSize, &badPayload[16 + 21], sizeof(payloadSize));
+    payloadSize++;
+    memcpy(&badPayload[16 + 21], &payloadSize, sizeof(payloadSize));
+    badPayload.insert(badPayload.begin() + 16 + 25 + payloadSize - 1, 0);
+    CHECK(!OcapReader::Parse(badPayload, broken, &error));
+    CHECK(error.find("record 0") != std::string::npos);
+}
+
+// Runs last, the capture can't be restarted in the same process
+static void EvaluateLimit()
+{
+    NVNGX_Parameters params;
+    params.Set("Width", 1280u);
+
+    uint32_t calls = 0;
+
+    while (ApiCapture::IsActive() && calls < ApiCapture::MaxEvaluates * 2)
+    {
+        fakeNow += 1.0;
+        ApiCapture::CallRecord(ApiCaptureEvent::Evaluate, 7, &params).End(NVSDK_NGX_Result_Success);
+        calls++;
+    }
+
+    // Nothing written after the limit
+    ApiCapture::CallRecord(ApiCaptureEvent::Release, 7, nullptr).End(NVSDK_NGX_Result_Success);
+
+    OcapCapture capture;
+    CHECK(OcapReader::Parse(ReadFile(CapturePath()), capture, nullptr));
+    CHECK(!capture.Truncated);
+
+    uint32_t evaluates = 0;
+    for (auto& record : capture.Records)
+    {
+        if (record.Event == ApiCaptureEvent::Evaluate)
+            evaluates++;
+    }
+
+    CHECK(evaluates == ApiCapture::MaxEvaluates);
+    CHECK(!capture.Records.empty() && capture.Records.back().Event == ApiCaptureEvent::Evaluate);
+    CHECK(!ApiCapture::IsActive());
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 1)
+        return Dump(argv[1]);
+
+    captureDir = std::filesystem::temp_directory_path() / "ocap_reader_check";
+    std::filesystem::create_directories(captureDir);
+    std::filesystem::remove(CapturePath());
+
+    RoundTrip();
+    EvaluateLimit();
+
+    if (failures == 0)
+        printf("All checks passed\n");
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,224 @@
+#pragma once
+
+// Parser for the .ocap files ApiCapture writes, follows the layout documented in OptiScaler/misc/ApiCapture.h.
+// A capture cut short by a crash keeps every complete record and sets Truncated.
+
+#include <misc/ApiCapture.h>
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
+
+struct OcapResourceDesc
+{
+    uint32_t Dimension = 0;
+    uint64_t Width = 0;
+    uint32_t Height = 0;
+    uint16_t DepthOrArraySize = 0;
+    uint16_t MipLevels = 0;
+    uint32_t Format = 0;
+    uint32_t Flags = 0;
+};
+
+struct OcapParameter
+{
+    std::string Key;
+    ApiCaptureValue Type = ApiCaptureValue::Unknown;
+    uint64_t Bits = 0;
+    std::optional<OcapResourceDesc> Resource;
+
+    // Value as the parameter table's union held it
+    template <typename T> T As() const
+    {
+        T value {};
+        memcpy(&value, &Bits, sizeof(T) < sizeof(Bits) ? sizeof(T) : sizeof(Bits));
+        return value;
+    }
+};
+
+struct OcapRecord
+{
+    ApiCaptureEvent Event = ApiCaptureEvent::Release;
+    uint32_t HandleId = 0;
+    uint64_t TimeNs = 0;
+    float CallMs = 0.0f;
+    int32_t Result = 0;
+    uint32_t FeatureId = 0; // CreateFeature only
+    std::vector<OcapParameter> Parameters;
+
+    const OcapParameter* Find(const std::string& key) const
+    {
+        for (auto& parameter : Parameters)
+        {
+            if (parameter.Key == key)
+                return &parameter;
+        }
+
+        return nullptr;
+    }
+};
+
+struct OcapCapture
+{
+    uint32_t Version = 0;
+    std::vector<OcapRecord> Records;
+    bool Truncated = false;
+};
+
+class OcapReader
+{
+  private:
+    const uint8_t* _data;
+    size_t _size;
+    size_t _pos = 0;
+
+    OcapReader(const uint8_t* data, size_t size) : _data(data), _size(size) {}
+
+    template <typename T> bool Read(T& value)
+    {
+        if (_size - _pos < sizeof(T))
+            return false;
+
+        memcpy(&value, _data + _pos, sizeof(T));
+        _pos += sizeof(T);
+        return true;
+    }
+
+    bool ReadParameters(std::vector<OcapParameter>& parameters)
+    {
+        uint32_t count = 0;
+        if (!Read(count))
+            return false;
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            OcapParameter parameter;
+            uint16_t keyLength = 0;
+
+            if (!Read(keyLength) || _size - _pos < keyLength)
+                return false;
+
+            parameter.Key.assign((const char*) _data + _pos, keyLength);
+            _pos += keyLength;
+
+            uint8_t type = 0;
+            if (!Read(type) || !Read(parameter.Bits))
+                return false;
+
+            parameter.Type = (ApiCaptureValue) type;
+
+            if (parameter.Type == ApiCaptureValue::Dx12Resource)
+            {
+                OcapResourceDesc desc;
+
+                if (!Read(desc.Dimension) || !Read(desc.Width) || !Read(desc.Height) ||
+                    !Read(desc.DepthOrArraySize) || !Read(desc.MipLevels) || !Read(desc.Format) || !Read(desc.Flags))
+                {
+                    return false;
+                }
+
+                parameter.Resource = desc;
+            }
+
+            parameters.push_back(std::move(parameter));
+        }
+
+        return true;
+    }
+
+    // Payload is parsed on its own, it has to be consumed exactly
+    static bool ReadPayload(OcapRecord& record, const uint8_t* payload, size_t size, std::string* error)
+    {
+        OcapReader reader(payload, size);
+
+        if (record.Event == ApiCaptureEvent::CreateFeature && !reader.Read(record.FeatureId))
+        {
+            *error = "create payload without feature id";
+            return false;
+        }
+
+        if (record.Event != ApiCaptureEvent::Release && !reader.ReadParameters(record.Parameters))
+        {
+            *error = "malformed parameters";
+            return false;
+        }
+
+        if (reader._pos != size)
+        {
+            *error = "payload size doesn't match its contents";
+            return false;
+        }
+
+        return true;
+    }
+
+  public:
+    static bool Parse(const std::vector<uint8_t>& data, OcapCapture& capture, std::string* error)
+    {
+        std::string ignored;
+        if (error == nullptr)
+            error = &ignored;
+
+        capture = {};
+        OcapReader reader(data.data(), data.size());
+
+        char magic[8] {};
+        uint32_t reserved = 0;
+
+        if (!reader.Read(magic) || !reader.Read(capture.Version) || !reader.Read(reserved))
+        {
+            *error = "file is shorter than the header";
+            return false;
+        }
+
+        if (memcmp(magic, "OPTICAP", sizeof(magic)) != 0)
+        {
+            *error = "not an OptiScaler capture";
+            return false;
+        }
+
+        if (capture.Version != ApiCapture::Version)
+        {
+            *error = "unsupported capture version " + std::to_string(capture.Version);
+            return false;
+        }
+
+        while (reader._pos < reader._size)
+        {
+            OcapRecord record;
+            uint8_t event = 0;
+            uint32_t payloadSize = 0;
+
+            if (!reader.Read(event) || !reader.Read(record.HandleId) || !reader.Read(record.TimeNs) ||
+                !reader.Read(record.CallMs) || !reader.Read(record.Result) || !reader.Read(payloadSize) ||
+                reader._size - reader._pos < payloadSize)
+            {
+                capture.Truncated = true;
+                break;
+            }
+
+            record.Event = (ApiCaptureEvent) event;
+
+            if (record.Event != ApiCaptureEvent::CreateFeature && record.Event != ApiCaptureEvent::Evaluate &&
+                record.Event != ApiCaptureEvent::Release)
+            {
+                *error = "unknown event " + std::to_string(event) + " in record " +
+                         std::to_string(capture.Records.size());
+                return false;
+            }
+
+            if (!ReadPayload(record, reader._data + reader._pos, payloadSize, error))
+            {
+                *error += " in record " + std::to_string(capture.Records.size());
+                return false;
+            }
+
+            reader._pos += payloadSize;
+            capture.Records.push_back(std::move(record));
+        }
+
+        return true;
+    }
+};
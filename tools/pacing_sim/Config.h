@@ -0,0 +1,40 @@
+#pragma once
+
+// Linux stand-in for OptiScaler/Config.h with the options FrameLimit & LatencyFlex read
+
+#include <cstdint>
+
+enum class ForceReflex : uint32_t
+{
+    InGame,
+    ForceDisable,
+    ForceEnable,
+    Count
+};
+
+enum class LFXMode : uint32_t
+{
+    Conservative,
+    Aggressive,
+    ReflexIDs,
+    Count
+};
+
+template <typename T> struct Option
+{
+    T Value;
+    T value_or_default() const { return Value; }
+};
+
+class Config
+{
+  public:
+    Option<float> FramerateLimit { 0.0f };
+    Option<uint32_t> FN_LatencyFlexMode { (uint32_t) LFXMode::Conservative };
+
+    static Config* Instance()
+    {
+        static Config* instance = new Config();
+        return instance;
+    }
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+// Linux stand-in for OptiScaler/SysUtils.h, just enough for PacingSimulator, FrameLimit & LatencyFlex.
+// The Windows timer functions are only declared, the simulator replaces the clock with its own.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#define LOG_TRACE(...) ((void) 0)
+#define LOG_DEBUG(...) ((void) 0)
+#define LOG_INFO(...) ((void) 0)
+#define LOG_WARN(...) ((void) 0)
+#define LOG_ERROR(...) ((void) 0)
+
+typedef void* HANDLE;
+typedef unsigned long DWORD;
+typedef int BOOL;
+
+struct FILETIME
+{
+    DWORD dwLowDateTime;
+    DWORD dwHighDateTime;
+};
+
+union LARGE_INTEGER
+{
+    int64_t QuadPart;
+};
+
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x2
+#define TIMER_ALL_ACCESS 0x1F0003
+#define INFINITE 0xFFFFFFFF
+#define WAIT_OBJECT_0 0
+
+void GetSystemTimePreciseAsFileTime(FILETIME* fileTime);
+HANDLE CreateWaitableTimerExW(void* attributes, const wchar_t* name, DWORD flags, DWORD access);
+BOOL SetWaitableTimerEx(HANDLE timer, const LARGE_INTEGER* dueTime, long period, void* routine, void* arg,
+                        void* context, unsigned long delay);
+DWORD WaitForSingleObject(HANDLE handle, DWORD milliseconds);
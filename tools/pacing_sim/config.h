@@ -0,0 +1,4 @@
+#pragma once
+
+// fakenvapi includes it lowercase, case sensitive file systems need both names
+#include "Config.h"
@@ -0,0 +1,4 @@
+#pragma once
+
+// Linux stand-in, the low latency techs only pass IUnknown pointers around
+struct IUnknown;
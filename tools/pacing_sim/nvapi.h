@@ -0,0 +1,13 @@
+#pragma once
+
+// Linux stand-in for the nvapi.h types used by fakenvapi's fn_util.h
+
+#define NVAPI_SHORT_STRING_MAX 64
+
+typedef char NvAPI_ShortString[NVAPI_SHORT_STRING_MAX];
+
+enum NvAPI_Status
+{
+    NVAPI_OK = 0,
+    NVAPI_ERROR = -1,
+};
@@ -0,0 +1,8 @@
+#pragma once
+
+// Linux stand-in for fakenvapi's log.h, same includes without spdlog
+#include <SysUtils.h>
+#include <nvapi/fakenvapi/fn_util.h>
+#include "config.h"
+
+#define LOG_TRACE_FAKENVAPI(...) ((void) 0)
@@ -0,0 +1,253 @@
+// Runs the pacing simulator with fixed seeds and checks that every policy gives the same output for the same
+// seed, plus the latency report ring filled from the markers (LowLatency::add_marker_to_report).
+// PacingSimulator, FrameLimit and LatencyFlex are built from the OptiScaler sources, the local headers stand in for
+// the Windows ones. Exact numbers depend on the standard library's distributions, so only same-seed runs are compared.
+//
+// Build and run on Linux from this directory:
+//   SRC=../../OptiScaler
+//   g++ -std=c++20 -O2 -I. -I$SRC -I../../external/latencyflex pacing_sim.cpp $SRC/misc/PacingSimulator.cpp
+//       $SRC/misc/FrameLimit.cpp $SRC/nvapi/fakenvapi/low_latency_tech/ll_latencyflex.cpp -o check
+//   ./check
+// Prints the results per scenario, exits with 1 and the failed checks when something is off.
+
+#include <misc/PacingSimulator.h>
+#include <nvapi/fakenvapi/frame_reports.h>
+
+#include <magic_enum.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(expr)                                                                                                    \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expr))                                                                                                   \
+        {                                                                                                              \
+            printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #expr);                                                   \
+            failures++;                                                                                                \
+        }                                                                                                              \
+    } while (0)
+
+// Not used when the simulator installs its clock, fn_util.h needs them declared
+void GetSystemTimePreciseAsFileTime(FILETIME* fileTime) { *fileTime = {}; }
+HANDLE CreateWaitableTimerExW(void*, const wchar_t*, DWORD, DWORD) { return nullptr; }
+BOOL SetWaitableTimerEx(HANDLE, const LARGE_INTEGER*, long, void*, void*, void*, unsigned long) { return 0; }
+DWORD WaitForSingleObject(HANDLE, DWORD) { return 0; }
+
+static bool SameResult(const PacingSimResult& a, const PacingSimResult& b)
+{
+    return a.Policy == b.Policy && a.AvgLatencyMs == b.AvgLatencyMs && a.P99LatencyMs == b.P99LatencyMs &&
+           a.AvgReportedLatencyMs == b.AvgReportedLatencyMs && a.AvgFrameTimeMs == b.AvgFrameTimeMs &&
+           a.FrameTimeStdDevMs == b.FrameTimeStdDevMs && a.Fps == b.Fps;
+}
+
+static const PacingSimResult& ResultOf(const std::vector<PacingSimResult>& results, PacingPolicy policy)
+{
+    return results[(size_t) policy];
+}
+
+static void Print(const char* scenario, const std::vector<PacingSimResult>& results)
+{
+    printf("%s\n", scenario);
+
+    for (const auto& result : results)
+    {
+        printf("  %-16s latency %7.2f ms (p99 %7.2f, reported %7.2f)  %6.1f fps  +/-%.2f ms\n",
+               std::string(magic_enum::enum_name(result.Policy)).c_str(), result.AvgLatencyMs, result.P99LatencyMs,
+               result.AvgReportedLatencyMs, result.Fps, result.FrameTimeStdDevMs);
+    }
+}
+
+// Same seed gives the same output for every policy, another seed changes it
+static std::vector<PacingSimResult> RunDeterministic(const char* scenario, PacingSimParams params)
+{
+    auto first = PacingSimulator::Run(params);
+    auto second = PacingSimulator::Run(params);
+
+    CHECK(first.size() == (size_t) PacingPolicy::Count);
+    CHECK(second.size() == first.size());
+
+    for (size_t i = 0; i < first.size() && i < second.size(); i++)
+    {
+        CHECK(first[i].Policy == (PacingPolicy) i);
+
+        if (!SameResult(first[i], second[i]))
+        {
+            printf("%s: %s differs between runs\n", scenario,
+                   std::string(magic_enum::enum_name(first[i].Policy)).c_str());
+            failures++;
+        }
+
+        CHECK(std::isfinite(first[i].AvgLatencyMs) && first[i].AvgLatencyMs > 0.0);
+        CHECK(first[i].P99LatencyMs >= first[i].AvgLatencyMs);
+        CHECK(first[i].Fps > 0.0);
+    }
+
+    // Vsync can quantize some policies to the same numbers, at least one has to change
+    params.Seed++;
+    auto reseeded = PacingSimulator::Run(params);
+    bool changed = false;
+
+    for (size_t i = 0; i < first.size() && i < reseeded.size(); i++)
+        changed |= !SameResult(reseeded[i], first[i]);
+
+    CHECK(changed);
+
+    Print(scenario, first);
+    return first;
+}
+
+static void GpuBound()
+{
+    PacingSimParams params {};
+    params.Seed = 42;
+    params.SimulationMs = 4.0f;
+    params.RenderSubmitMs = 1.5f;
+    params.GpuMs = 12.0f;
+    params.MaxQueuedFrames = 2;
+
+    auto results = RunDeterministic("gpu bound, 12 ms gpu, 2 queued", params);
+    const auto& none = ResultOf(results, PacingPolicy::None);
+
+    // Full queue without pacing, latency is about queue depth + 1 GPU frames
+    CHECK(none.AvgLatencyMs > 2.0 * params.GpuMs);
+    CHECK(std::fabs(none.AvgFrameTimeMs - params.GpuMs) < 0.5);
+
+    // LatencyFlex keeps the queue empty for the same throughput
+    for (auto policy : { PacingPolicy::LFXConservative, PacingPolicy::LFXAggressive, PacingPolicy::LFXReflexIDs })
+    {
+        const auto& lfx = ResultOf(results, policy);
+        CHECK(lfx.AvgLatencyMs < none.AvgLatencyMs);
+        CHECK(lfx.Fps > none.Fps * 0.9);
+    }
+
+    // Reported latency ends at present, before the GPU work of the queued frames
+    CHECK(none.AvgReportedLatencyMs > params.SimulationMs + params.RenderSubmitMs);
+    CHECK(none.AvgReportedLatencyMs < none.AvgLatencyMs);
+}
+
+static void FrameLimited()
+{
+    PacingSimParams params {};
+    params.Seed = 7;
+    params.SimulationMs = 3.0f;
+    params.RenderSubmitMs = 1.0f;
+    params.GpuMs = 5.0f;
+    params.FpsLimit = 60.0f;
+
+    auto results = RunDeterministic("60 fps limit, 5 ms gpu", params);
+    const auto& limited = ResultOf(results, PacingPolicy::FrameLimit);
+
+    CHECK(std::fabs(limited.Fps - 60.0) < 1.0);
+    CHECK(limited.AvgLatencyMs < ResultOf(results, PacingPolicy::None).AvgLatencyMs ||
+          ResultOf(results, PacingPolicy::None).Fps > 60.0);
+}
+
+static void VSynced()
+{
+    PacingSimParams params {};
+    params.Seed = 1234;
+    params.SimulationMs = 2.0f;
+    params.RenderSubmitMs = 1.0f;
+    params.GpuMs = 4.0f;
+    params.RefreshRate = 60.0f;
+    params.VSync = true;
+
+    auto results = RunDeterministic("vsync 60 Hz, 4 ms gpu", params);
+
+    // One frame per refresh at most
+    for (const auto& result : results)
+        CHECK(result.Fps < 60.5);
+}
+
+class TestClock : public FnClock
+{
+  public:
+    uint64_t Now = 0;
+
+    uint64_t now() override { return Now; }
+
+    int sleep(int64_t ns) override
+    {
+        Now += ns;
+        return 0;
+    }
+};
+
+// Marker handling of LowLatency::add_marker_to_report
+static void Reports()
+{
+    TestClock clock;
+    fn_clock_override = &clock;
+
+    FrameReports reports;
+
+    clock.Now = 1'000'000'000;
+    reports.add_marker(10, MarkerType::SIMULATION_START, true);
+    clock.Now += 4'000'000;
+    reports.add_marker(10, MarkerType::SIMULATION_END, true);
+    reports.add_marker(10, MarkerType::RENDERSUBMIT_START, true);
+    clock.Now += 2'000'000;
+    reports.add_marker(10, MarkerType::RENDERSUBMIT_END, true);
+    reports.add_marker(10, MarkerType::PRESENT_START, true);
+    clock.Now += 500'000;
+    reports.add_marker(10, MarkerType::PRESENT_END, true);
+
+    auto report = reports.find(10);
+    CHECK(report != nullptr);
+
+    if (report != nullptr)
+    {
+        // Times are in us
+        CHECK(report->simStartTime == 1'000'000);
+        CHECK(report->simEndTime == 1'004'000);
+        CHECK(report->renderSubmitStartTime == 1'004'000);
+        CHECK(report->renderSubmitEndTime == 1'006'000);
+        CHECK(report->presentStartTime == 1'006'000);
+        CHECK(report->presentEndTime == 1'006'500);
+        CHECK(report->gpuRenderStartTime == 1'006'500);
+        CHECK(report->gpuActiveRenderTimeUs == 100);
+        CHECK(report->gpuFrameTimeUs == 0);
+    }
+
+    // GPU placeholder frame time is the distance of the last two sim starts
+    clock.Now = 1'016'000'000;
+    reports.add_marker(11, MarkerType::SIMULATION_START, true);
+    CHECK(reports.find(11) != nullptr && reports.find(11)->gpuFrameTimeUs == 0);
+    reports.add_marker(11, MarkerType::SIMULATION_END, true);
+    CHECK(reports.find(11) != nullptr && reports.find(11)->gpuFrameTimeUs == 16'000);
+
+    // Without placeholders the GPU times are left for the timestamp queries
+    auto& slot = reports[12 % FRAME_REPORTS_BUFFER_SIZE];
+    reports.add_marker(12, MarkerType::SIMULATION_START, false);
+    CHECK(slot.frameID == 12 && slot.gpuRenderStartTime == 0 && slot.gpuActiveRenderTimeUs == 0);
+
+    // Same slot used by a newer frame, old values are cleared
+    reports.add_marker(10 + FRAME_REPORTS_BUFFER_SIZE, MarkerType::PRESENT_START, true);
+    CHECK(reports.find(10) == nullptr);
+    CHECK(reports.find(10 + FRAME_REPORTS_BUFFER_SIZE) != nullptr);
+    CHECK(reports.find(10 + FRAME_REPORTS_BUFFER_SIZE)->simStartTime == 0);
+
+    reports.clear();
+    CHECK(reports.find(11) == nullptr);
+
+    fn_clock_override = nullptr;
+}
+
+int main()
+{
+    Reports();
+    GpuBound();
+    FrameLimited();
+    VSynced();
+
+    if (failures == 0)
+        printf("All checks passed\n");
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+// Linux stand-in for OptiScaler/pch.h
+#include "SysUtils.h"
@@ -0,0 +1,21 @@
+#pragma once
+
+// Linux stand-in for OptiScaler/Config.h with the option PresentProfiler reads
+
+template <typename T> struct Option
+{
+    T Value;
+    T value_or_default() const { return Value; }
+};
+
+class Config
+{
+  public:
+    Option<bool> PresentProfiler { true };
+
+    static Config* Instance()
+    {
+        static Config* instance = new Config();
+        return instance;
+    }
+};
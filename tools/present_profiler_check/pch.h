@@ -0,0 +1,5 @@
+#pragma once
+
+// Linux stand-in for OptiScaler/pch.h
+#include "SysUtils.h"
+#include "Config.h"
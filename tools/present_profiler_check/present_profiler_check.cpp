@@ -0,0 +1,406 @@
+// Drives PresentProfiler::ScopedFrame / ScopedPhase on a test clock (fn_clock_override) and checks the records:
+// exclusive phase times, nested presents folded into the outermost one, enable handling, ring wrap and stats.
+// Records are read back through DumpCsv, so the CSV layout is covered too.
+//
+// Build and run on Linux from this directory:
+//   g++ -std=c++20 -O2 -I. -I../../OptiScaler present_profiler_check.cpp
+//       ../../OptiScaler/misc/PresentProfiler.cpp -o check
+//   ./check
+// Exits with 1 and prints the failed checks when something is off.
+
+#include <Config.h>
+#include <misc/PresentProfiler.h>
+#include <nvapi/fakenvapi/fn_util.h>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(expr)                                                                                                    \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expr))                                                                                                   \
+        {                                                                                                              \
+            printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #expr);                                                   \
+            failures++;                                                                                                \
+        }                                                                                                              \
+    } while (0)
+
+// Not used while the test clock is installed, fn_util.h needs them declared
+void GetSystemTimePreciseAsFileTime(FILETIME* fileTime) { *fileTime = {}; }
+HANDLE CreateWaitableTimerExW(void*, const wchar_t*, DWORD, DWORD) { return nullptr; }
+BOOL SetWaitableTimerEx(HANDLE, const LARGE_INTEGER*, long, void*, void*, void*, unsigned long) { return 0; }
+DWORD WaitForSingleObject(HANDLE, DWORD) { return 0; }
+
+class TestClock : public FnClock
+{
+  public:
+    // ScopedPhase treats a start of 0 as inactive
+    uint64_t Now = 1'000'000'000;
+
+    uint64_t now() override { return Now; }
+
+    int sleep(int64_t ns) override
+    {
+        Now += ns;
+        return 0;
+    }
+
+    void AdvanceMs(double ms) { Now += (uint64_t) (ms * 1000000.0); }
+};
+
+static TestClock clock_;
+
+struct CsvRecord
+{
+    uint64_t Frame = 0;
+    double TotalMs = 0.0;
+    std::vector<double> PhaseMs;
+
+    double Phase(PresentPhase phase) const { return PhaseMs[(size_t) phase]; }
+};
+
+static std::vector<CsvRecord> ReadRecords()
+{
+    auto path = std::filesystem::temp_directory_path() / "present_profiler_check.csv";
+    std::vector<CsvRecord> records;
+
+    if (!PresentProfiler::DumpCsv(path))
+    {
+        CHECK(!"DumpCsv failed");
+        return records;
+    }
+
+    std::ifstream file(path);
+    std::string line;
+
+    std::getline(file, line);
+    CHECK(line.starts_with("Frame,TotalMs,ReflexUpdateMs,"));
+    CHECK(line.ends_with(",FrameLimitMs"));
+
+    while (std::getline(file, line))
+    {
+        std::stringstream stream(line);
+        std::string field;
+        CsvRecord record {};
+
+        std::getline(stream, field, ',');
+        record.Frame = std::stoull(field);
+        std::getline(stream, field, ',');
+        record.TotalMs = std::stod(field);
+
+        while (std::getline(stream, field, ','))
+            record.PhaseMs.push_back(std::stod(field));
+
+        CHECK(record.PhaseMs.size() == (size_t) PresentPhase::Count);
+        record.PhaseMs.resize((size_t) PresentPhase::Count);
+        records.push_back(record);
+    }
+
+    std::filesystem::remove(path);
+    return records;
+}
+
+static bool Near(double a, double b) { return std::fabs(a - b) < 0.0002; }
+
+// Phase that runs for ms on the test clock, body runs in the middle
+template <typename F> static void TimedPhase(PresentPhase phase, double beforeMs, double afterMs, F body)
+{
+    PresentProfiler::ScopedPhase scoped(phase);
+    clock_.AdvanceMs(beforeMs);
+    body();
+    clock_.AdvanceMs(afterMs);
+}
+
+static void TimedPhase(PresentPhase phase, double ms)
+{
+    TimedPhase(phase, ms, 0.0, [] {});
+}
+
+static void ExclusiveTime()
+{
+    PresentProfiler::Reset();
+
+    {
+        PresentProfiler::ScopedFrame frame(true);
+
+        TimedPhase(PresentPhase::Overlay, 2.0);
+        clock_.AdvanceMs(1.0); // Not in any phase
+
+        // Present 10 ms total, 3 ms of it in FrameLimit
+        TimedPhase(PresentPhase::Present, 4.0, 3.0, [] { TimedPhase(PresentPhase::FrameLimit, 3.0); });
+
+        // Three levels, each one only keeps its own time
+        TimedPhase(PresentPhase::FGPresent, 1.0, 1.0,
+                   []
+                   {
+                       TimedPhase(PresentPhase::StreamlineMarkers, 0.5, 0.5,
+                                  [] { TimedPhase(PresentPhase::Hudfix, 2.0); });
+                   });
+
+        // Siblings inside one phase are summed
+        TimedPhase(PresentPhase::FGMutexWait, 0.25, 0.25,
+                   []
+                   {
+                       TimedPhase(PresentPhase::ReadUpscalerTime, 1.0);
+                       clock_.AdvanceMs(0.5);
+                       TimedPhase(PresentPhase::ReadUpscalerTime, 1.5);
+                   });
+    }
+
+    auto records = ReadRecords();
+    CHECK(records.size() == 1);
+
+    if (records.size() != 1)
+        return;
+
+    auto& record = records[0];
+    CHECK(record.Frame == 0);
+    CHECK(Near(record.TotalMs, 2.0 + 1.0 + 10.0 + 5.0 + 3.5));
+    CHECK(Near(record.Phase(PresentPhase::Overlay), 2.0));
+    CHECK(Near(record.Phase(PresentPhase::Present), 7.0));
+    CHECK(Near(record.Phase(PresentPhase::FrameLimit), 3.0));
+    CHECK(Near(record.Phase(PresentPhase::FGPresent), 2.0));
+    CHECK(Near(record.Phase(PresentPhase::StreamlineMarkers), 1.0));
+    CHECK(Near(record.Phase(PresentPhase::Hudfix), 2.0));
+    CHECK(Near(record.Phase(PresentPhase::FGMutexWait), 1.0));
+    CHECK(Near(record.Phase(PresentPhase::ReadUpscalerTime), 2.5));
+    CHECK(Near(record.Phase(PresentPhase::ReflexUpdate), 0.0));
+
+    // Sum of exclusive times never exceeds the frame
+    double sum = 0.0;
+    for (auto ms : record.PhaseMs)
+        sum += ms;
+
+    CHECK(Near(sum, record.TotalMs - 1.0));
+}
+
+static void NestedFrames()
+{
+    PresentProfiler::Reset();
+
+    {
+        // Wrapped swapchain present calling into the FG present
+        PresentProfiler::ScopedFrame outer(true);
+        TimedPhase(PresentPhase::Overlay, 1.0);
+
+        TimedPhase(PresentPhase::FGPresent, 0.5, 0.5,
+                   []
+                   {
+                       PresentProfiler::ScopedFrame inner(true);
+                       TimedPhase(PresentPhase::Hudfix, 2.0);
+                       TimedPhase(PresentPhase::Present, 3.0);
+                   });
+
+        TimedPhase(PresentPhase::Present, 4.0);
+    }
+
+    {
+        // Enabled state of the outermost present decides for the nested ones
+        PresentProfiler::ScopedFrame outer(true);
+        TimedPhase(PresentPhase::Overlay, 1.0);
+
+        Config::Instance()->PresentProfiler.Value = false;
+
+        {
+            PresentProfiler::ScopedFrame inner(true);
+            TimedPhase(PresentPhase::Present, 2.0);
+        }
+
+        Config::Instance()->PresentProfiler.Value = true;
+    }
+
+    auto records = ReadRecords();
+    CHECK(records.size() == 2);
+
+    if (records.size() != 2)
+        return;
+
+    CHECK(records[0].Frame == 0 && records[1].Frame == 1);
+    CHECK(Near(records[0].TotalMs, 11.0));
+    CHECK(Near(records[0].Phase(PresentPhase::Overlay), 1.0));
+    CHECK(Near(records[0].Phase(PresentPhase::FGPresent), 1.0));
+    CHECK(Near(records[0].Phase(PresentPhase::Hudfix), 2.0));
+    CHECK(Near(records[0].Phase(PresentPhase::Present), 7.0));
+
+    CHECK(Near(records[1].TotalMs, 3.0));
+    CHECK(Near(records[1].Phase(PresentPhase::Present), 2.0));
+}
+
+static void Disabled()
+{
+    PresentProfiler::Reset();
+
+    // Phases outside of a frame are dropped
+    TimedPhase(PresentPhase::Present, 5.0);
+    PresentProfiler::AddPhase(PresentPhase::Overlay, 1'000'000);
+
+    {
+        PresentProfiler::ScopedFrame frame(false);
+        TimedPhase(PresentPhase::Present, 1.0);
+    }
+
+    Config::Instance()->PresentProfiler.Value = false;
+
+    {
+        PresentProfiler::ScopedFrame outer(true);
+        PresentProfiler::ScopedFrame inner(true);
+        TimedPhase(PresentPhase::Present, 1.0);
+    }
+
+    Config::Instance()->PresentProfiler.Value = true;
+
+    CHECK(ReadRecords().empty());
+
+    // Nothing leaked into the next frame
+    {
+        PresentProfiler::ScopedFrame frame(true);
+        TimedPhase(PresentPhase::FrameLimit, 1.0);
+    }
+
+    auto records = ReadRecords();
+    CHECK(records.size() == 1);
+
+    if (records.size() == 1)
+    {
+        CHECK(Near(records[0].TotalMs, 1.0));
+        CHECK(Near(records[0].Phase(PresentPhase::Present), 0.0));
+        CHECK(Near(records[0].Phase(PresentPhase::Overlay), 0.0));
+        CHECK(Near(records[0].Phase(PresentPhase::FrameLimit), 1.0));
+    }
+}
+
+// FSR FG presents from its own thread while the game's present is open
+static void Threads()
+{
+    PresentProfiler::Reset();
+
+    {
+        PresentProfiler::ScopedFrame frame(true);
+        TimedPhase(PresentPhase::Overlay, 1.0);
+
+        std::thread other(
+            []
+            {
+                TestClock threadClock;
+                fn_clock_override = &threadClock;
+
+                {
+                    PresentProfiler::ScopedFrame frame(true);
+                    PresentProfiler::ScopedPhase phase(PresentPhase::FGPresent);
+                    threadClock.AdvanceMs(5.0);
+                }
+
+                fn_clock_override = nullptr;
+            });
+
+        other.join();
+        TimedPhase(PresentPhase::Present, 2.0);
+    }
+
+    auto records = ReadRecords();
+    CHECK(records.size() == 2);
+
+    if (records.size() != 2)
+        return;
+
+    // Other thread finished first
+    CHECK(Near(records[0].TotalMs, 5.0));
+    CHECK(Near(records[0].Phase(PresentPhase::FGPresent), 5.0));
+    CHECK(Near(records[0].Phase(PresentPhase::Overlay), 0.0));
+
+    CHECK(Near(records[1].TotalMs, 3.0));
+    CHECK(Near(records[1].Phase(PresentPhase::FGPresent), 0.0));
+    CHECK(Near(records[1].Phase(PresentPhase::Present), 2.0));
+}
+
+static void RingAndStats()
+{
+    PresentProfiler::Reset();
+
+    auto runFrame = [](double presentMs)
+    {
+        PresentProfiler::ScopedFrame frame(true);
+        TimedPhase(PresentPhase::Present, presentMs);
+        TimedPhase(PresentPhase::FrameLimit, 1.0);
+    };
+
+    // Less than StatsInterval frames, nothing calculated yet
+    for (int i = 0; i < (int) PresentProfiler::StatsInterval - 1; i++)
+        runFrame(1.0);
+
+    CHECK(PresentProfiler::GetStats().Frames == 0);
+
+    PresentProfiler::Reset();
+
+    // Present takes 1..100 ms
+    for (int i = 1; i <= 100; i++)
+        runFrame((double) i);
+
+    auto stats = PresentProfiler::GetStats();
+    CHECK(stats.Frames == 100);
+
+    auto& present = stats.Phases[(size_t) PresentPhase::Present];
+    CHECK(Near(present.P50Ms, 50.0));
+    CHECK(Near(present.P99Ms, 99.0));
+    CHECK(Near(present.MaxMs, 100.0));
+
+    auto& limit = stats.Phases[(size_t) PresentPhase::FrameLimit];
+    CHECK(Near(limit.P50Ms, 1.0) && Near(limit.P99Ms, 1.0) && Near(limit.MaxMs, 1.0));
+    CHECK(Near(stats.Total.P50Ms, 51.0) && Near(stats.Total.MaxMs, 101.0));
+    CHECK(Near(stats.Phases[(size_t) PresentPhase::Overlay].MaxMs, 0.0));
+
+    // Cached until StatsInterval more frames
+    for (int i = 0; i < 10; i++)
+        runFrame(200.0);
+
+    CHECK(PresentProfiler::GetStats().Frames == 100);
+
+    for (int i = 0; i < (int) PresentProfiler::StatsInterval; i++)
+        runFrame(200.0);
+
+    stats = PresentProfiler::GetStats();
+    CHECK(stats.Frames == 140);
+    CHECK(Near(stats.Phases[(size_t) PresentPhase::Present].MaxMs, 200.0));
+
+    // Ring keeps the newest RingSize frames, oldest first
+    for (size_t i = 0; i < PresentProfiler::RingSize; i++)
+        runFrame(2.0);
+
+    auto records = ReadRecords();
+    CHECK(records.size() == PresentProfiler::RingSize);
+
+    if (records.size() == PresentProfiler::RingSize)
+    {
+        CHECK(records.front().Frame == 140);
+        CHECK(records.back().Frame == 140 + PresentProfiler::RingSize - 1);
+        CHECK(Near(records.front().Phase(PresentPhase::Present), 2.0));
+    }
+
+    stats = PresentProfiler::GetStats();
+    CHECK(stats.Frames == PresentProfiler::RingSize);
+    CHECK(Near(stats.Phases[(size_t) PresentPhase::Present].MaxMs, 2.0));
+}
+
+int main()
+{
+    fn_clock_override = &clock_;
+
+    ExclusiveTime();
+    NestedFrames();
+    Disabled();
+    Threads();
+    RingAndStats();
+
+    fn_clock_override = nullptr;
+
+    if (failures == 0)
+        printf("All checks passed\n");
+
+    return failures == 0 ? 0 : 1;
+}
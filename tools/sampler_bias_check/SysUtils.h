@@ -0,0 +1,8 @@
+#pragma once
+
+// Linux stand-in for OptiScaler/SysUtils.h, just enough for SamplerRegistry
+
+#include <cstdint>
+#include <cstdio>
+
+#define LOG_DEBUG(...) ((void) 0)
@@ -0,0 +1,9 @@
+#pragma once
+
+// Linux stand-in for ankerl::unordered_dense, the harness only needs the map interface
+#include <unordered_map>
+
+namespace ankerl::unordered_dense
+{
+template <typename Key, typename Value> using map = std::unordered_map<Key, Value>;
+}
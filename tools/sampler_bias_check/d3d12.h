@@ -0,0 +1,29 @@
+#pragma once
+
+// Linux stand-in for the few d3d12.h types SamplerRegistry uses
+
+#include <cstddef>
+
+typedef unsigned int UINT;
+typedef size_t SIZE_T;
+
+struct ID3D12Device;
+
+struct D3D12_CPU_DESCRIPTOR_HANDLE
+{
+    SIZE_T ptr;
+};
+
+struct D3D12_SAMPLER_DESC
+{
+    UINT Filter;
+    UINT AddressU;
+    UINT AddressV;
+    UINT AddressW;
+    float MipLODBias;
+    UINT MaxAnisotropy;
+    UINT ComparisonFunc;
+    float BorderColor[4];
+    float MinLOD;
+    float MaxLOD;
+};
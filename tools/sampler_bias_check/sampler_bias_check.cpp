@@ -0,0 +1,172 @@
+// Checks of the mipmap bias math and of the staging slot bookkeeping of SamplerRegistry.
+//
+// Build and run on Linux from this directory, the local headers stand in for the Windows ones:
+//   g++ -std=c++20 -I. -I../../OptiScaler sampler_bias_check.cpp ../../OptiScaler/misc/SamplerRegistry.cpp -o check
+//   ./check
+// Exits with 1 and prints the failed checks when something is off.
+
+#include <misc/SamplerRegistry.h>
+
+#include <cmath>
+#include <cstdio>
+
+static int failures = 0;
+
+#define CHECK(expr)                                                                                                    \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expr))                                                                                                   \
+        {                                                                                                              \
+            printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #expr);                                                   \
+            failures++;                                                                                                \
+        }                                                                                                              \
+    } while (0)
+
+static bool Near(float a, float b) { return std::fabs(a - b) < 0.0001f; }
+
+static D3D12_SAMPLER_DESC Sampler(float bias)
+{
+    D3D12_SAMPLER_DESC desc {};
+    desc.MipLODBias = bias;
+    desc.MaxLOD = 1000.0f;
+    return desc;
+}
+
+static void OverrideBias()
+{
+    CHECK(Near(SamplerRegistry::OverrideBias(-1.0f, -0.5f, SamplerBiasMode::Add), -1.5f));
+    CHECK(Near(SamplerRegistry::OverrideBias(-1.0f, -0.5f, SamplerBiasMode::Fixed), -0.5f));
+    CHECK(Near(SamplerRegistry::OverrideBias(-1.0f, 1.5f, SamplerBiasMode::Scale), -1.5f));
+    CHECK(Near(SamplerRegistry::OverrideBias(0.0f, 0.0f, SamplerBiasMode::Add), 0.0f));
+
+    // D3D12 range
+    CHECK(Near(SamplerRegistry::OverrideBias(-10.0f, -10.0f, SamplerBiasMode::Add), -16.0f));
+    CHECK(Near(SamplerRegistry::OverrideBias(10.0f, 10.0f, SamplerBiasMode::Add), 15.99f));
+    CHECK(Near(SamplerRegistry::OverrideBias(-4.0f, 8.0f, SamplerBiasMode::Scale), -16.0f));
+    CHECK(Near(SamplerRegistry::OverrideBias(0.0f, 20.0f, SamplerBiasMode::Fixed), 15.99f));
+}
+
+static void RatioBias()
+{
+    // Native, quality (1.5x), balanced (1.7x), performance (2x), ultra performance (3x)
+    CHECK(Near(SamplerRegistry::RatioBias(3840, 3840), 0.0f));
+    CHECK(Near(SamplerRegistry::RatioBias(2560, 3840), -0.6f));  // -0.585
+    CHECK(Near(SamplerRegistry::RatioBias(2259, 3840), -0.75f)); // -0.766
+    CHECK(Near(SamplerRegistry::RatioBias(1920, 3840), -1.0f));
+    CHECK(Near(SamplerRegistry::RatioBias(1280, 3840), -1.6f)); // -1.585
+
+    // Rounded to 0.05, a few pixels of DRS don't change it
+    CHECK(SamplerRegistry::RatioBias(1920, 3840) == SamplerRegistry::RatioBias(1930, 3840));
+
+    // Render above display (DLAA / supersampling) gives a positive bias
+    CHECK(Near(SamplerRegistry::RatioBias(3840, 1920), 1.0f));
+
+    // Not known yet
+    CHECK(Near(SamplerRegistry::RatioBias(0, 3840), 0.0f));
+    CHECK(Near(SamplerRegistry::RatioBias(1920, 0), 0.0f));
+}
+
+static size_t Count(SamplerRegistry& registry, float bias)
+{
+    size_t count = 0;
+    registry.ForEach(
+        [&](ID3D12Device*, const D3D12_SAMPLER_DESC& original, SIZE_T)
+        {
+            if (original.MipLODBias == bias)
+                count++;
+        });
+
+    return count;
+}
+
+static void Registry()
+{
+    SamplerRegistry registry;
+    constexpr UINT increment = 32;
+    constexpr SIZE_T staging = 0x10000;
+    constexpr SIZE_T other = 0x90000;
+
+    CHECK(!registry.HasHeaps());
+
+    int created = 0;
+    auto create = [&]() { created++; };
+
+    // Unknown heap, created but not recorded
+    CHECK(!registry.Create(nullptr, Sampler(-1.0f), staging, create));
+    CHECK(created == 1);
+    CHECK(registry.Slots() == 0);
+
+    registry.AddHeap(1, staging, staging + 8 * increment);
+    CHECK(registry.HasHeaps());
+
+    CHECK(registry.Create(nullptr, Sampler(-1.0f), staging, create));
+    CHECK(registry.Create(nullptr, Sampler(-2.0f), staging + increment, create));
+    CHECK(!registry.Create(nullptr, Sampler(-3.0f), staging + 8 * increment, create)); // one past the end
+    CHECK(registry.Slots() == 2);
+
+    // Overwrite keeps the newest original
+    CHECK(registry.Create(nullptr, Sampler(-0.5f), staging, create));
+    CHECK(registry.Slots() == 2);
+    CHECK(Count(registry, -0.5f) == 1);
+    CHECK(Count(registry, -1.0f) == 0);
+
+    int copied = 0;
+    auto copy = [&]() { copied++; };
+
+    // Staging to staging moves the original along: slots 0, 1 -> 4, 5
+    D3D12_CPU_DESCRIPTOR_HANDLE dest { staging + 4 * increment };
+    D3D12_CPU_DESCRIPTOR_HANDLE src { staging };
+    UINT size = 2;
+    registry.Copy(1, &dest, &size, 1, &src, &size, increment, copy);
+    CHECK(copied == 1);
+    CHECK(registry.Slots() == 4);
+    CHECK(Count(registry, -0.5f) == 2);
+    CHECK(Count(registry, -2.0f) == 2);
+
+    // Copy from an unknown heap forgets the destination, rewrite would restore the old sampler otherwise
+    dest = { staging + 4 * increment };
+    src = { other };
+    size = 1;
+    registry.Copy(1, &dest, &size, 1, &src, &size, increment, copy);
+    CHECK(registry.Slots() == 3);
+    CHECK(Count(registry, -0.5f) == 1);
+
+    // Copy out of the staging heap (shader visible destination) changes nothing
+    dest = { other };
+    src = { staging + increment };
+    registry.Copy(1, &dest, &size, 1, &src, &size, increment, copy);
+    CHECK(registry.Slots() == 3);
+
+    // Ranges of different sizes and null sizes: dest [6], [7] from src [0..1]
+    D3D12_CPU_DESCRIPTOR_HANDLE dests[] = { { staging + 6 * increment }, { staging + 7 * increment } };
+    src = { staging };
+    size = 2;
+    registry.Copy(2, dests, nullptr, 1, &src, &size, increment, copy);
+    CHECK(registry.Slots() == 5);
+    CHECK(Count(registry, -0.5f) == 2);
+    CHECK(Count(registry, -2.0f) == 3);
+
+    // Destroyed heap drops its slots, other heaps are kept
+    registry.AddHeap(2, other, other + 4 * increment);
+    CHECK(registry.Create(nullptr, Sampler(-1.0f), other, create));
+    registry.RemoveHeap(1);
+    CHECK(registry.Slots() == 1);
+    CHECK(registry.Heaps() == 1);
+    CHECK(registry.HasHeaps());
+
+    registry.RemoveHeap(2);
+    CHECK(registry.Slots() == 0);
+    CHECK(!registry.HasHeaps());
+}
+
+int main()
+{
+    OverrideBias();
+    RatioBias();
+    Registry();
+
+    if (failures == 0)
+        printf("All checks passed\n");
+
+    return failures == 0 ? 0 : 1;
+}
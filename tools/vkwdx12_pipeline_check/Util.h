@@ -0,0 +1,8 @@
+#pragma once
+
+// Linux stand-in for OptiScaler/Util.h, the check provides the clock
+
+namespace Util
+{
+double MillisecondsNow();
+} // namespace Util
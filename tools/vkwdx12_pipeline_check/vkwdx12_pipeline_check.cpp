@@ -0,0 +1,313 @@
+// Drives VkwDx12Pipeline with a fake IVkwDx12Fence and a fake clock: waits only on ring slot reuse, waits capped to
+// the last submitted frame, the timeout counter and the static input copy elision with its resets.
+//
+// Build and run on Linux from this directory:
+//   g++ -std=c++20 -O2 -I. -I../../OptiScaler vkwdx12_pipeline_check.cpp
+//       ../../OptiScaler/upscalers/VkwDx12Pipeline.cpp -o check
+//   ./check
+// Exits with 1 and prints the failed checks when something is off.
+
+#include <upscalers/VkwDx12Pipeline.h>
+#include <Util.h>
+
+#include <cstdio>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(expr)                                                                                                    \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expr))                                                                                                   \
+        {                                                                                                              \
+            printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #expr);                                                   \
+            failures++;                                                                                                \
+        }                                                                                                              \
+    } while (0)
+
+static double nowMs = 0.0;
+double Util::MillisecondsNow() { return nowMs; }
+
+static constexpr uint32_t RingSize = 3;
+
+struct Wait
+{
+    uint64_t Value;
+    uint32_t TimeoutMs;
+};
+
+// D3D12 queue stand-in, the GPU finishes a waited value after GpuMs unless it was never signaled
+class FakeFence : public IVkwDx12Fence
+{
+  public:
+    uint64_t Completed = 0;
+    uint64_t Signaled = 0;
+    double GpuMs = 2.0;
+    bool DeviceRemoved = false;
+    std::vector<Wait> Waits;
+
+    uint64_t CompletedValue() override { return Completed; }
+
+    bool WaitFor(uint64_t value, uint32_t timeoutMs) override
+    {
+        Waits.push_back({ value, timeoutMs });
+
+        if (Completed >= value)
+            return true;
+
+        // Never signaled values would block forever
+        if (value > Signaled || DeviceRemoved)
+        {
+            if (timeoutMs != NoTimeout)
+                nowMs += timeoutMs;
+
+            return false;
+        }
+
+        if (timeoutMs != NoTimeout && GpuMs > timeoutMs)
+        {
+            nowMs += timeoutMs;
+            GpuMs -= timeoutMs;
+            return false;
+        }
+
+        nowMs += GpuMs;
+        Completed = value;
+        return true;
+    }
+};
+
+// Out of range waits read as this, a missing wait fails the check instead of crashing it
+static Wait WaitAt(const FakeFence& fence, size_t index)
+{
+    return index < fence.Waits.size() ? fence.Waits[index] : Wait { UINT64_MAX, 0 };
+}
+
+// One evaluate of the bridge, same order as IFeature_VkwDx12
+static bool RunFrame(VkwDx12Pipeline& pipeline, FakeFence& fence, uint64_t frame, bool submit = true)
+{
+    if (!pipeline.AcquireSlot(fence, frame, RingSize))
+        return false;
+
+    pipeline.BeginFrame(false);
+
+    if (submit)
+    {
+        fence.Signaled = VkwDx12Pipeline::FenceValue(frame);
+        pipeline.Submitted(fence.Signaled);
+    }
+
+    return true;
+}
+
+static void WaitsOnlyOnSlotReuse()
+{
+    // GPU keeps up, completes each frame before the next one starts
+    {
+        VkwDx12Pipeline pipeline;
+        FakeFence fence;
+
+        for (uint64_t frame = 0; frame < 100; frame++)
+        {
+            CHECK(RunFrame(pipeline, fence, frame));
+            fence.Completed = fence.Signaled;
+        }
+
+        CHECK(fence.Waits.empty());
+        CHECK(pipeline.Stats().Waits == 0);
+        CHECK(pipeline.Stats().Frames == 100);
+    }
+
+    // GPU two frames behind, still a free slot every frame
+    {
+        VkwDx12Pipeline pipeline;
+        FakeFence fence;
+
+        for (uint64_t frame = 0; frame < 100; frame++)
+        {
+            CHECK(RunFrame(pipeline, fence, frame));
+
+            if (frame >= 2)
+                fence.Completed = VkwDx12Pipeline::FenceValue(frame - 2);
+        }
+
+        CHECK(fence.Waits.empty());
+    }
+
+    // GPU stalled, first frames fill the ring then every frame waits for the one using its slot
+    {
+        VkwDx12Pipeline pipeline;
+        FakeFence fence;
+
+        for (uint64_t frame = 0; frame < RingSize; frame++)
+            CHECK(RunFrame(pipeline, fence, frame));
+
+        CHECK(fence.Waits.empty());
+
+        // Frame 0 signals 1, the fence starts at 0 so the wait can't be skipped
+        CHECK(RunFrame(pipeline, fence, RingSize));
+        CHECK(fence.Waits.size() == 1);
+        CHECK(WaitAt(fence, 0).Value == VkwDx12Pipeline::FenceValue(0));
+        CHECK(WaitAt(fence, 0).TimeoutMs == VkwDx12Pipeline::WaitTimeoutMs);
+        CHECK(fence.Completed == VkwDx12Pipeline::FenceValue(0));
+
+        CHECK(RunFrame(pipeline, fence, RingSize + 1));
+        CHECK(fence.Waits.size() == 2);
+        CHECK(WaitAt(fence, 1).Value == VkwDx12Pipeline::FenceValue(1));
+
+        CHECK(pipeline.Stats().Waits == 2);
+        CHECK(pipeline.Stats().WaitMs == 4.0);
+        CHECK(pipeline.Stats().LastWaitMs == 2.0);
+        CHECK(pipeline.Stats().WaitTimeouts == 0);
+    }
+}
+
+// Frames failing before submit never signal, waiting for their slot would hang
+static void WaitsCappedToSubmitted()
+{
+    VkwDx12Pipeline pipeline;
+    FakeFence fence;
+
+    for (uint64_t frame = 0; frame < RingSize; frame++)
+        CHECK(RunFrame(pipeline, fence, frame));
+
+    // Frames 3 - 5 fail after acquiring their slot
+    for (uint64_t frame = RingSize; frame < RingSize * 2; frame++)
+        CHECK(RunFrame(pipeline, fence, frame, false));
+
+    auto lastSubmitted = VkwDx12Pipeline::FenceValue(RingSize - 1);
+    CHECK(fence.Completed == lastSubmitted);
+
+    // Frame 6 uses the slot of frame 3 which never signaled, nothing to wait for
+    auto waits = fence.Waits.size();
+    CHECK(RunFrame(pipeline, fence, RingSize * 2));
+    CHECK(fence.Waits.size() == waits);
+
+    bool neverAboveSubmitted = true;
+
+    for (auto& wait : fence.Waits)
+        neverAboveSubmitted &= wait.Value <= lastSubmitted;
+
+    CHECK(neverAboveSubmitted);
+
+    // Submitting again brings the normal slot waits back
+    CHECK(RunFrame(pipeline, fence, RingSize * 2 + 1));
+    CHECK(RunFrame(pipeline, fence, RingSize * 2 + 2));
+    CHECK(RunFrame(pipeline, fence, RingSize * 3));
+    CHECK(WaitAt(fence, fence.Waits.size() - 1).Value == VkwDx12Pipeline::FenceValue(RingSize * 2));
+}
+
+static void Timeouts()
+{
+    VkwDx12Pipeline pipeline;
+    FakeFence fence;
+
+    for (uint64_t frame = 0; frame < RingSize; frame++)
+        CHECK(RunFrame(pipeline, fence, frame));
+
+    // Slow GPU, times out once then keeps waiting without a limit
+    fence.GpuMs = 1500.0;
+    CHECK(RunFrame(pipeline, fence, RingSize));
+    CHECK(fence.Waits.size() == 2);
+    CHECK(WaitAt(fence, 0).TimeoutMs == VkwDx12Pipeline::WaitTimeoutMs);
+    CHECK(WaitAt(fence, 1).TimeoutMs == IVkwDx12Fence::NoTimeout);
+    CHECK(WaitAt(fence, 1).Value == WaitAt(fence, 0).Value);
+    CHECK(pipeline.Stats().WaitTimeouts == 1);
+    CHECK(pipeline.Stats().Waits == 1);
+    CHECK(pipeline.Stats().LastWaitMs == 1500.0);
+    CHECK(pipeline.Stats().MaxWaitMs == 1500.0);
+
+    // Back to normal, timeouts stay counted
+    fence.GpuMs = 3.0;
+    CHECK(RunFrame(pipeline, fence, RingSize + 1));
+    CHECK(pipeline.Stats().WaitTimeouts == 1);
+    CHECK(pipeline.Stats().Waits == 2);
+    CHECK(pipeline.Stats().LastWaitMs == 3.0);
+    CHECK(pipeline.Stats().MaxWaitMs == 1500.0);
+    CHECK(pipeline.Stats().WaitMs == 1503.0);
+
+    // Lost device, the frame fails instead of using the slot
+    fence.DeviceRemoved = true;
+    CHECK(!RunFrame(pipeline, fence, RingSize + 2));
+    CHECK(pipeline.Stats().WaitTimeouts == 2);
+}
+
+static VkwDx12InputKey Key(uint64_t image) { return { image, image + 1, 1920, 1080, 97 }; }
+
+static void CopyElision()
+{
+    VkwDx12Pipeline pipeline;
+
+    // Opt-in only
+    pipeline.BeginFrame(false);
+    pipeline.Record(VkwDx12Input::Exposure, Key(1), false);
+    pipeline.BeginFrame(false);
+    CHECK(!pipeline.CanElide(VkwDx12Input::Exposure, Key(1)));
+    pipeline.Record(VkwDx12Input::Exposure, Key(1), false);
+
+    // Same image as last frame
+    pipeline.BeginFrame(true);
+    CHECK(pipeline.CanElide(VkwDx12Input::Exposure, Key(1)));
+    CHECK(!pipeline.CanElide(VkwDx12Input::Exposure, Key(2)));
+    CHECK(!pipeline.CanElide(VkwDx12Input::ReactiveMask, Key(1)));
+    pipeline.Record(VkwDx12Input::Exposure, Key(1), true);
+    pipeline.Record(VkwDx12Input::ReactiveMask, Key(5), false);
+    pipeline.Record(VkwDx12Input::Color, Key(7), false);
+
+    // Other inputs change every frame, never elided
+    pipeline.BeginFrame(true);
+    CHECK(pipeline.CanElide(VkwDx12Input::Exposure, Key(1)));
+    CHECK(pipeline.CanElide(VkwDx12Input::ReactiveMask, Key(5)));
+    CHECK(!pipeline.CanElide(VkwDx12Input::Color, Key(7)));
+
+    // Any part of the identity changing needs a copy
+    auto resized = Key(5);
+    resized.Width = 1280;
+    CHECK(!pipeline.CanElide(VkwDx12Input::ReactiveMask, resized));
+
+    auto otherView = Key(5);
+    otherView.View = 99;
+    CHECK(!pipeline.CanElide(VkwDx12Input::ReactiveMask, otherView));
+
+    pipeline.Record(VkwDx12Input::Exposure, Key(1), true);
+
+    // Reactive mask missing for a frame, it might have been changed meanwhile
+    pipeline.BeginFrame(true);
+    CHECK(pipeline.CanElide(VkwDx12Input::Exposure, Key(1)));
+    pipeline.Record(VkwDx12Input::Exposure, Key(1), true);
+    pipeline.BeginFrame(true);
+    CHECK(!pipeline.CanElide(VkwDx12Input::ReactiveMask, Key(5)));
+    pipeline.Record(VkwDx12Input::Exposure, Key(1), true);
+
+    // Reset frame copies everything, elision resumes on the next frame
+    pipeline.BeginFrame(false);
+    CHECK(!pipeline.CanElide(VkwDx12Input::Exposure, Key(1)));
+    pipeline.Record(VkwDx12Input::Exposure, Key(1), false);
+    pipeline.BeginFrame(true);
+    CHECK(pipeline.CanElide(VkwDx12Input::Exposure, Key(1)));
+    pipeline.Record(VkwDx12Input::Exposure, Key(1), true);
+
+    // Shared images recreated, old contents are gone
+    pipeline.Invalidate();
+    pipeline.BeginFrame(true);
+    CHECK(!pipeline.CanElide(VkwDx12Input::Exposure, Key(1)));
+    pipeline.Record(VkwDx12Input::Exposure, Key(1), false);
+    pipeline.BeginFrame(true);
+    CHECK(pipeline.CanElide(VkwDx12Input::Exposure, Key(1)));
+
+    CHECK(pipeline.Stats().Copies == 6);
+    CHECK(pipeline.Stats().CopiesElided == 5);
+}
+
+int main()
+{
+    WaitsOnlyOnSlotReuse();
+    WaitsCappedToSubmitted();
+    Timeouts();
+    CopyElision();
+
+    if (failures == 0)
+        printf("All checks passed\n");
+
+    return failures == 0 ? 0 : 1;
+}
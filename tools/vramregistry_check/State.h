@@ -0,0 +1,11 @@
+#pragma once
+
+// Linux stand-in for OptiScaler/State.h, only the scopes DxgiBudgetSource opens
+
+struct ScopedSkipSpoofing
+{
+};
+
+struct ScopedSkipDxgiLoadChecks
+{
+};
@@ -0,0 +1,124 @@
+#pragma once
+
+// Linux stand-in for OptiScaler/SysUtils.h, just enough of the D3D12 & DXGI types VramRegistry uses
+
+#include <algorithm>
+#include <cstdint>
+
+#define LOG_TRACE(...) ((void) 0)
+#define LOG_DEBUG(...) ((void) 0)
+#define LOG_INFO(...) ((void) 0)
+#define LOG_WARN(...) ((void) 0)
+#define LOG_ERROR(...) ((void) 0)
+
+#define WINAPI
+
+using UINT = unsigned int;
+using UINT64 = uint64_t;
+using HRESULT = long;
+
+constexpr HRESULT S_OK = 0;
+constexpr HRESULT E_FAIL = (HRESULT) 0x80004005;
+constexpr HRESULT E_NOINTERFACE = (HRESULT) 0x80004002;
+
+struct LUID
+{
+    uint32_t LowPart = 0;
+    int32_t HighPart = 0;
+};
+
+// One id per interface type, enough for QueryInterface of the fakes
+struct IID
+{
+    const void* Type;
+};
+
+using REFIID = const IID&;
+
+template <typename T> REFIID IidOf(T*)
+{
+    static const char type = 0;
+    static const IID iid { &type };
+    return iid;
+}
+
+#define __uuidof(x) IidOf(x)
+#define IID_PPV_ARGS(pp) IidOf(*(pp)), (void**) (pp)
+
+#define SAFE_RELEASE(p)                                                                                                \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (p)                                                                                                         \
+        {                                                                                                              \
+            (p)->Release();                                                                                            \
+            (p) = nullptr;                                                                                             \
+        }                                                                                                              \
+    } while ((void) 0, 0)
+
+struct IUnknown
+{
+    virtual ~IUnknown() = default;
+    virtual HRESULT QueryInterface(REFIID riid, void** ppvObject) = 0;
+    virtual UINT Release() = 0;
+};
+
+struct D3D12_RESOURCE_DESC
+{
+    UINT64 Width = 0;
+    UINT Height = 0;
+};
+
+struct D3D12_RESOURCE_ALLOCATION_INFO
+{
+    UINT64 SizeInBytes = 0;
+    UINT64 Alignment = 0;
+};
+
+struct ID3D12Device : IUnknown
+{
+    virtual D3D12_RESOURCE_ALLOCATION_INFO GetResourceAllocationInfo(UINT visibleMask, UINT numResourceDescs,
+                                                                     const D3D12_RESOURCE_DESC* pResourceDescs) = 0;
+};
+
+struct ID3D12Resource : IUnknown
+{
+    virtual HRESULT GetDevice(REFIID riid, void** ppvDevice) = 0;
+    virtual D3D12_RESOURCE_DESC GetDesc() = 0;
+};
+
+using PFN_DESTRUCTION_CALLBACK = void(WINAPI*)(void* pData);
+
+struct ID3DDestructionNotifier : IUnknown
+{
+    virtual HRESULT RegisterDestructionCallback(PFN_DESTRUCTION_CALLBACK callbackFn, void* pData,
+                                                UINT* pCallbackID) = 0;
+};
+
+enum DXGI_MEMORY_SEGMENT_GROUP
+{
+    DXGI_MEMORY_SEGMENT_GROUP_LOCAL = 0,
+    DXGI_MEMORY_SEGMENT_GROUP_NON_LOCAL = 1,
+};
+
+struct DXGI_QUERY_VIDEO_MEMORY_INFO
+{
+    UINT64 Budget = 0;
+    UINT64 CurrentUsage = 0;
+    UINT64 AvailableForReservation = 0;
+    UINT64 CurrentReservation = 0;
+};
+
+struct IDXGIAdapter3 : IUnknown
+{
+    virtual HRESULT QueryVideoMemoryInfo(UINT nodeIndex, DXGI_MEMORY_SEGMENT_GROUP memorySegmentGroup,
+                                         DXGI_QUERY_VIDEO_MEMORY_INFO* pVideoMemoryInfo) = 0;
+};
+
+struct IDXGIFactory : IUnknown
+{
+};
+
+struct IDXGIFactory4 : IDXGIFactory
+{
+    virtual HRESULT EnumAdapterByLuid(LUID adapterLuid, REFIID riid, void** ppvAdapter) = 0;
+};
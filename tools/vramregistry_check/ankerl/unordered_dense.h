@@ -0,0 +1,11 @@
+#pragma once
+
+// Linux stand-in for ankerl::unordered_dense, the harness only needs the map & set interface
+#include <unordered_map>
+#include <unordered_set>
+
+namespace ankerl::unordered_dense
+{
+template <typename Key, typename Value> using map = std::unordered_map<Key, Value>;
+template <typename Key> using set = std::unordered_set<Key>;
+} // namespace ankerl::unordered_dense
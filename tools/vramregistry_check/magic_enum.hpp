@@ -0,0 +1,3 @@
+#pragma once
+
+// Linux stand-in for magic_enum, VramRegistry only uses it in log lines which compile out here
@@ -0,0 +1,20 @@
+#pragma once
+
+// Linux stand-in for OptiScaler/proxies/Dxgi_Proxy.h, there is no DXGI so the budget source never initializes
+
+#include "SysUtils.h"
+
+class DxgiProxy
+{
+  public:
+    typedef HRESULT (*PFN_CreateDxgiFactory)(REFIID riid, IDXGIFactory** ppFactory);
+
+    static PFN_CreateDxgiFactory CreateDxgiFactory_()
+    {
+        return [](REFIID, IDXGIFactory** ppFactory)
+        {
+            *ppFactory = nullptr;
+            return E_FAIL;
+        };
+    }
+};
@@ -0,0 +1,369 @@
+// Checks of VramRegistry against a fake IVramBudgetSource and fake D3D12 resources: the 90% / 85% pressure
+// hysteresis, per owner totals, tracking through the destruction notifier and idle buffer release selection.
+//
+// Build and run on Linux from this directory, SysUtils.h here stands in for the D3D12 & DXGI headers:
+//   g++ -std=c++20 -O2 -I. -I../../OptiScaler vramregistry_check.cpp ../../OptiScaler/misc/VramRegistry.cpp
+//       -o check
+//   ./check
+// Exits with 1 and prints the failed checks when something is off.
+
+#include <misc/VramRegistry.h>
+
+#include <cstdio>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(expr)                                                                                                    \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expr))                                                                                                   \
+        {                                                                                                              \
+            printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #expr);                                                   \
+            failures++;                                                                                                \
+        }                                                                                                              \
+    } while (0)
+
+static constexpr uint64_t MB = 1024 * 1024;
+
+// DXGI stand-in, usage is given in percent of the budget, 10000 MB so the limits are exact
+class FakeBudgetSource : public IVramBudgetSource
+{
+  public:
+    uint64_t Budget = 10000 * MB;
+    uint64_t Usage = 0;
+    bool Fail = false;
+    uint32_t Queries = 0;
+
+    bool Query(VramBudget& budget) override
+    {
+        Queries++;
+
+        if (Fail)
+            return false;
+
+        budget.Budget = Budget;
+        budget.Usage = Usage;
+        return true;
+    }
+
+    void SetPercent(double percent) { Usage = (uint64_t) (Budget * percent / 100.0); }
+};
+
+static VramPressure UpdateAt(VramRegistry& registry, FakeBudgetSource& source, double percent)
+{
+    source.SetPercent(percent);
+    return registry.Update(source);
+}
+
+static void Hysteresis()
+{
+    VramRegistry registry;
+    FakeBudgetSource source;
+
+    CHECK(registry.Pressure() == VramPressure::None);
+    CHECK(UpdateAt(registry, source, 50.0) == VramPressure::None);
+    CHECK(UpdateAt(registry, source, 88.0) == VramPressure::None);
+    CHECK(UpdateAt(registry, source, 90.0) == VramPressure::None);
+
+    // Enters above 90%
+    CHECK(UpdateAt(registry, source, 90.5) == VramPressure::High);
+    CHECK(registry.Pressure() == VramPressure::High);
+
+    // Stays until it drops to 85%
+    CHECK(UpdateAt(registry, source, 89.0) == VramPressure::High);
+    CHECK(UpdateAt(registry, source, 85.5) == VramPressure::High);
+    CHECK(UpdateAt(registry, source, 85.0) == VramPressure::None);
+
+    // Inside the band without being high before is nothing
+    CHECK(UpdateAt(registry, source, 87.0) == VramPressure::None);
+
+    // Over budget, then back through the band
+    CHECK(UpdateAt(registry, source, 100.0) == VramPressure::High);
+    CHECK(UpdateAt(registry, source, 100.5) == VramPressure::Critical);
+    CHECK(UpdateAt(registry, source, 95.0) == VramPressure::High);
+    CHECK(UpdateAt(registry, source, 101.0) == VramPressure::Critical);
+    CHECK(UpdateAt(registry, source, 86.0) == VramPressure::High);
+    CHECK(UpdateAt(registry, source, 80.0) == VramPressure::None);
+
+    // Critical straight to the band also keeps High
+    CHECK(UpdateAt(registry, source, 120.0) == VramPressure::Critical);
+    CHECK(UpdateAt(registry, source, 86.0) == VramPressure::High);
+
+    auto budget = registry.LastBudget();
+    CHECK(budget.Budget == source.Budget);
+    CHECK(budget.Usage == source.Usage);
+
+    // Failed queries and zero budgets keep the last state and budget
+    source.Fail = true;
+    CHECK(UpdateAt(registry, source, 10.0) == VramPressure::High);
+    CHECK(registry.LastBudget().Usage == budget.Usage);
+
+    source.Fail = false;
+    source.Budget = 0;
+    CHECK(UpdateAt(registry, source, 10.0) == VramPressure::High);
+    CHECK(registry.LastBudget().Budget == budget.Budget);
+
+    source.Budget = 10000 * MB;
+    CHECK(UpdateAt(registry, source, 10.0) == VramPressure::None);
+    CHECK(source.Queries == 19);
+}
+
+static const VramOwnerTotal* TotalOf(const std::vector<VramOwnerTotal>& totals, const std::string& owner)
+{
+    for (auto& total : totals)
+    {
+        if (total.Owner == owner)
+            return &total;
+    }
+
+    return nullptr;
+}
+
+static void OwnerTotals()
+{
+    VramRegistry registry;
+
+    CHECK(registry.Total() == 0);
+    CHECK(registry.Totals().empty());
+
+    registry.Add(1, "FSR3", "Upscaled output", 32 * MB);
+    registry.Add(2, "FSR3", "History", 64 * MB);
+    registry.Add(3, "RCAS", "Buffer", 16 * MB);
+    registry.Add(4, "Output Scaling", "Buffer", 48 * MB);
+
+    CHECK(registry.Total() == 160 * MB);
+
+    auto totals = registry.Totals();
+    CHECK(totals.size() == 3);
+
+    // Biggest first
+    bool sorted = true;
+
+    for (size_t i = 1; i < totals.size(); i++)
+        sorted &= totals[i - 1].Bytes >= totals[i].Bytes;
+
+    CHECK(sorted);
+    CHECK(!totals.empty() && totals[0].Owner == "FSR3");
+
+    auto fsr = TotalOf(totals, "FSR3");
+    CHECK(fsr != nullptr && fsr->Bytes == 96 * MB && fsr->Count == 2);
+
+    auto rcas = TotalOf(totals, "RCAS");
+    CHECK(rcas != nullptr && rcas->Bytes == 16 * MB && rcas->Count == 1);
+
+    // Same id again replaces the entry, recreated buffer of another size or another owner
+    registry.Add(3, "RCAS", "Buffer", 24 * MB);
+    CHECK(registry.Total() == 168 * MB);
+    totals = registry.Totals();
+    rcas = TotalOf(totals, "RCAS");
+    CHECK(rcas != nullptr && rcas->Bytes == 24 * MB && rcas->Count == 1);
+
+    registry.Add(1, "Bias", "Buffer", 8 * MB);
+    CHECK(registry.Total() == 144 * MB);
+
+    totals = registry.Totals();
+    fsr = TotalOf(totals, "FSR3");
+    CHECK(fsr != nullptr && fsr->Bytes == 64 * MB && fsr->Count == 1);
+    CHECK(TotalOf(totals, "Bias") != nullptr);
+
+    // Unknown ids are ignored, removing the last resource of an owner drops the owner
+    registry.Remove(99);
+    CHECK(registry.Total() == 144 * MB);
+
+    registry.Remove(2);
+    registry.Remove(2);
+    CHECK(registry.Total() == 80 * MB);
+
+    totals = registry.Totals();
+    CHECK(totals.size() == 3);
+    CHECK(TotalOf(totals, "FSR3") == nullptr);
+    CHECK(!totals.empty() && totals[0].Owner == "Output Scaling");
+}
+
+// D3D12 stand-ins, destruction notifier fires the callback when the resource is released
+static uint64_t Aligned(uint64_t bytes) { return (bytes + 65535) & ~(uint64_t) 65535; }
+
+class FakeDevice : public ID3D12Device
+{
+  public:
+    HRESULT QueryInterface(REFIID, void**) override { return E_NOINTERFACE; }
+    UINT Release() override { return 1; }
+
+    D3D12_RESOURCE_ALLOCATION_INFO GetResourceAllocationInfo(UINT, UINT count,
+                                                             const D3D12_RESOURCE_DESC* descs) override
+    {
+        // 64 KB alignment like placed resources
+        auto bytes = count > 0 ? descs[0].Width * descs[0].Height * 4 : 0;
+        return { Aligned(bytes), 65536 };
+    }
+};
+
+static FakeDevice device;
+
+class FakeResource : public ID3D12Resource, public ID3DDestructionNotifier
+{
+  public:
+    D3D12_RESOURCE_DESC Desc {};
+    bool HasNotifier = true;
+    PFN_DESTRUCTION_CALLBACK Callback = nullptr;
+    void* CallbackData = nullptr;
+
+    FakeResource(UINT64 width, UINT height, bool hasNotifier = true) : HasNotifier(hasNotifier)
+    {
+        Desc.Width = width;
+        Desc.Height = height;
+    }
+
+    HRESULT QueryInterface(REFIID riid, void** ppvObject) override
+    {
+        if (!HasNotifier || riid.Type != IidOf((ID3DDestructionNotifier*) nullptr).Type)
+            return E_NOINTERFACE;
+
+        *ppvObject = static_cast<ID3DDestructionNotifier*>(this);
+        return S_OK;
+    }
+
+    UINT Release() override { return 1; }
+
+    HRESULT GetDevice(REFIID, void** ppvDevice) override
+    {
+        *ppvDevice = &device;
+        return S_OK;
+    }
+
+    D3D12_RESOURCE_DESC GetDesc() override { return Desc; }
+
+    HRESULT RegisterDestructionCallback(PFN_DESTRUCTION_CALLBACK callbackFn, void* pData, UINT* pCallbackID) override
+    {
+        Callback = callbackFn;
+        CallbackData = pData;
+        *pCallbackID = 1;
+        return S_OK;
+    }
+
+    void Destroy()
+    {
+        if (Callback != nullptr)
+            Callback(CallbackData);
+    }
+};
+
+// Destruction callbacks go to the singleton
+static void Tracking()
+{
+    auto& registry = VramRegistry::Instance();
+    auto before = registry.Total();
+
+    FakeResource output(1920, 1080);
+    FakeResource history(3840, 2160);
+    FakeResource noNotifier(1024, 1024, false);
+
+    registry.Track(&output, "Output Scaling", "Buffer");
+    registry.Track(&history, "FSR3", "History");
+    registry.Track(&noNotifier, "RCAS", "Buffer");
+    registry.Track(nullptr, "RCAS", "Buffer");
+
+    auto outputBytes = Aligned((uint64_t) 1920 * 1080 * 4);
+    auto historyBytes = Aligned((uint64_t) 3840 * 2160 * 4);
+
+    CHECK(registry.Total() == before + outputBytes + historyBytes);
+    CHECK(output.Callback != nullptr);
+    CHECK(noNotifier.Callback == nullptr);
+
+    auto totals = registry.Totals();
+    CHECK(TotalOf(totals, "RCAS") == nullptr);
+
+    auto fsr = TotalOf(totals, "FSR3");
+    CHECK(fsr != nullptr && fsr->Bytes == historyBytes);
+
+    // Released resources leave the registry on their own
+    history.Destroy();
+    CHECK(registry.Total() == before + outputBytes);
+    CHECK(TotalOf(registry.Totals(), "FSR3") == nullptr);
+
+    output.Destroy();
+    CHECK(registry.Total() == before);
+}
+
+// Same selection as the idle release in IFeature_Dx12::Evaluate
+struct Pass
+{
+    bool HasBuffer;
+    uint64_t IdleFrames;
+    bool Released = false;
+};
+
+static uint32_t ReleaseIdle(VramRegistry& registry, std::vector<Pass>& passes)
+{
+    uint32_t released = 0;
+    auto pressure = registry.Pressure();
+
+    for (auto& pass : passes)
+    {
+        if (VramRegistry::ShouldReleaseIdle(pressure, pass.HasBuffer, pass.IdleFrames))
+        {
+            pass.Released = true;
+            pass.HasBuffer = false;
+            released++;
+        }
+    }
+
+    return released;
+}
+
+static void IdleRelease()
+{
+    constexpr auto idle = VramRegistry::IdleReleaseFrames;
+
+    CHECK(!VramRegistry::ShouldReleaseIdle(VramPressure::None, true, idle * 10));
+    CHECK(!VramRegistry::ShouldReleaseIdle(VramPressure::High, true, idle));
+    CHECK(VramRegistry::ShouldReleaseIdle(VramPressure::High, true, idle + 1));
+    CHECK(VramRegistry::ShouldReleaseIdle(VramPressure::Critical, true, idle + 1));
+    CHECK(!VramRegistry::ShouldReleaseIdle(VramPressure::Critical, false, idle + 1));
+
+    VramRegistry registry;
+    FakeBudgetSource source;
+
+    // Recently used, exactly at the limit, idle, idle but already released
+    std::vector<Pass> passes { { true, 5 }, { true, idle }, { true, idle + 100 }, { false, idle * 3 } };
+
+    UpdateAt(registry, source, 70.0);
+    CHECK(ReleaseIdle(registry, passes) == 0);
+
+    // In the band without pressure before, still nothing
+    UpdateAt(registry, source, 88.0);
+    CHECK(ReleaseIdle(registry, passes) == 0);
+
+    UpdateAt(registry, source, 93.0);
+    CHECK(ReleaseIdle(registry, passes) == 1);
+    CHECK(!passes[0].Released && !passes[1].Released && passes[2].Released && !passes[3].Released);
+
+    // Nothing left to release on the next check
+    CHECK(ReleaseIdle(registry, passes) == 0);
+
+    // The one at the limit goes once it ages while pressure holds in the band
+    passes[1].IdleFrames++;
+    UpdateAt(registry, source, 87.0);
+    CHECK(ReleaseIdle(registry, passes) == 1);
+    CHECK(passes[1].Released);
+
+    // Pressure gone, idle buffers stay
+    passes[0].IdleFrames = idle * 2;
+    UpdateAt(registry, source, 84.0);
+    CHECK(ReleaseIdle(registry, passes) == 0);
+    CHECK(!passes[0].Released);
+}
+
+int main()
+{
+    Hysteresis();
+    OwnerTotals();
+    Tracking();
+    IdleRelease();
+
+    if (failures == 0)
+        printf("All checks passed\n");
+
+    return failures == 0 ? 0 : 1;
+}
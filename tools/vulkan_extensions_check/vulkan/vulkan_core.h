@@ -0,0 +1,44 @@
+#pragma once
+
+// Linux stand-in for the Vulkan headers, only what Vulkan_Extensions.h uses
+
+#include <cstdint>
+
+#define VK_MAX_EXTENSION_NAME_SIZE 256U
+
+typedef enum VkResult
+{
+    VK_SUCCESS = 0,
+    VK_INCOMPLETE = 5,
+    VK_ERROR_OUT_OF_HOST_MEMORY = -1,
+    VK_ERROR_INITIALIZATION_FAILED = -3,
+} VkResult;
+
+typedef struct VkPhysicalDevice_T* VkPhysicalDevice;
+
+typedef struct VkExtensionProperties
+{
+    char extensionName[VK_MAX_EXTENSION_NAME_SIZE];
+    uint32_t specVersion;
+} VkExtensionProperties;
+
+typedef VkResult (*PFN_vkEnumerateDeviceExtensionProperties)(VkPhysicalDevice physicalDevice, const char* pLayerName,
+                                                             uint32_t* pPropertyCount,
+                                                             VkExtensionProperties* pProperties);
+typedef VkResult (*PFN_vkEnumerateInstanceExtensionProperties)(const char* pLayerName, uint32_t* pPropertyCount,
+                                                               VkExtensionProperties* pProperties);
+
+#define VK_NV_PRESENT_METERING_EXTENSION_NAME "VK_NV_present_metering"
+#define VK_NV_PRESENT_METERING_SPEC_VERSION 1
+#define VK_NV_OPTICAL_FLOW_EXTENSION_NAME "VK_NV_optical_flow"
+#define VK_NV_OPTICAL_FLOW_SPEC_VERSION 1
+#define VK_EXT_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME "VK_EXT_buffer_device_address"
+#define VK_EXT_BUFFER_DEVICE_ADDRESS_SPEC_VERSION 2
+#define VK_NV_LOW_LATENCY_EXTENSION_NAME "VK_NV_low_latency"
+#define VK_NV_LOW_LATENCY_SPEC_VERSION 1
+#define VK_NVX_MULTIVIEW_PER_VIEW_ATTRIBUTES_EXTENSION_NAME "VK_NVX_multiview_per_view_attributes"
+#define VK_NVX_MULTIVIEW_PER_VIEW_ATTRIBUTES_SPEC_VERSION 1
+#define VK_NVX_IMAGE_VIEW_HANDLE_EXTENSION_NAME "VK_NVX_image_view_handle"
+#define VK_NVX_IMAGE_VIEW_HANDLE_SPEC_VERSION 3
+#define VK_NVX_BINARY_IMPORT_EXTENSION_NAME "VK_NVX_binary_import"
+#define VK_NVX_BINARY_IMPORT_SPEC_VERSION 1
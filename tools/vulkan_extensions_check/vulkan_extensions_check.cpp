@@ -0,0 +1,260 @@
+// Checks of the Vulkan extension list helpers used by the enumerate hooks: merge dedup & order, the two call
+// enumeration against a driver whose list grows between the calls, VK_INCOMPLETE on a short game buffer and the
+// spoofed list rebuild when FG input changes.
+//
+// Build and run on Linux from this directory, vulkan/vulkan_core.h here stands in for the Vulkan SDK:
+//   g++ -std=c++20 -O2 -I. -I../../OptiScaler vulkan_extensions_check.cpp -o check
+//   ./check
+// Exits with 1 and prints the failed checks when something is off.
+
+#include <spoofing/Vulkan_Extensions.h>
+
+#include <cstdio>
+#include <string>
+
+static int failures = 0;
+
+#define CHECK(expr)                                                                                                    \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expr))                                                                                                   \
+        {                                                                                                              \
+            printf("FAILED %s:%d: %s\n", __FILE__, __LINE__, #expr);                                                   \
+            failures++;                                                                                                \
+        }                                                                                                              \
+    } while (0)
+
+static VkExtensionProperties Ext(const std::string& name, uint32_t version = 1)
+{
+    VkExtensionProperties ext {};
+    strncpy(ext.extensionName, name.c_str(), VK_MAX_EXTENSION_NAME_SIZE - 1);
+    ext.specVersion = version;
+    return ext;
+}
+
+static std::vector<std::string> Names(const std::vector<VkExtensionProperties>& list)
+{
+    std::vector<std::string> names;
+
+    for (const auto& ext : list)
+        names.push_back(ext.extensionName);
+
+    return names;
+}
+
+static size_t CountOf(const std::vector<VkExtensionProperties>& list, const char* name)
+{
+    size_t count = 0;
+
+    for (const auto& ext : list)
+    {
+        if (std::strcmp(ext.extensionName, name) == 0)
+            count++;
+    }
+
+    return count;
+}
+
+// Driver stand-in, list can grow after the count query like it does when a layer or ICD shows up in between
+static struct
+{
+    std::vector<VkExtensionProperties> List;
+    std::vector<VkExtensionProperties> GrowBy; // Added after the next count query
+    size_t GrowTimes = 0;
+    VkResult Error = VK_SUCCESS;
+    size_t Calls = 0;
+} driver;
+
+static VkResult FillLikeDriver(uint32_t* pPropertyCount, VkExtensionProperties* pProperties)
+{
+    driver.Calls++;
+
+    if (driver.Error != VK_SUCCESS)
+        return driver.Error;
+
+    if (pProperties == nullptr)
+    {
+        *pPropertyCount = (uint32_t) driver.List.size();
+
+        if (driver.GrowTimes > 0)
+        {
+            driver.GrowTimes--;
+            driver.List.insert(driver.List.end(), driver.GrowBy.begin(), driver.GrowBy.end());
+        }
+
+        return VK_SUCCESS;
+    }
+
+    auto count = std::min(*pPropertyCount, (uint32_t) driver.List.size());
+    memcpy(pProperties, driver.List.data(), count * sizeof(VkExtensionProperties));
+    *pPropertyCount = count;
+
+    return count < driver.List.size() ? VK_INCOMPLETE : VK_SUCCESS;
+}
+
+static VkResult FakeEnumerateDevice(VkPhysicalDevice, const char*, uint32_t* pPropertyCount,
+                                    VkExtensionProperties* pProperties)
+{
+    return FillLikeDriver(pPropertyCount, pProperties);
+}
+
+static VkResult FakeEnumerateInstance(const char*, uint32_t* pPropertyCount, VkExtensionProperties* pProperties)
+{
+    return FillLikeDriver(pPropertyCount, pProperties);
+}
+
+static void MergeDedupAndOrder()
+{
+    std::vector<VkExtensionProperties> list { Ext("VK_KHR_swapchain"), Ext(VK_NV_LOW_LATENCY_EXTENSION_NAME, 7),
+                                              Ext("VK_KHR_maintenance1") };
+
+    CHECK(!MergeExtension(list, Ext("VK_KHR_swapchain", 70)));
+    CHECK(MergeExtension(list, Ext("VK_KHR_maintenance2")));
+    CHECK(!MergeExtension(list, Ext("VK_KHR_maintenance2")));
+
+    auto expected = std::vector<std::string> { "VK_KHR_swapchain", VK_NV_LOW_LATENCY_EXTENSION_NAME,
+                                               "VK_KHR_maintenance1", "VK_KHR_maintenance2" };
+    CHECK(Names(list) == expected);
+
+    // Spoofed ones go after the driver's, the ones the driver has keep their position and version
+    AddSpoofedDeviceExtensions(list, false);
+    expected.insert(expected.end(),
+                    { VK_EXT_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME, VK_NVX_MULTIVIEW_PER_VIEW_ATTRIBUTES_EXTENSION_NAME,
+                      VK_NVX_IMAGE_VIEW_HANDLE_EXTENSION_NAME, VK_NVX_BINARY_IMPORT_EXTENSION_NAME });
+    CHECK(Names(list) == expected);
+    CHECK(list[1].specVersion == 7);
+
+    // Adding again changes nothing
+    AddSpoofedDeviceExtensions(list, false);
+    CHECK(Names(list) == expected);
+
+    std::vector<const char*> names { "VK_KHR_swapchain" };
+    std::string copy = "VK_KHR_swapchain";
+
+    CHECK(!MergeExtension(names, copy.c_str()));
+    CHECK(MergeExtension(names, VK_NV_LOW_LATENCY_EXTENSION_NAME));
+    CHECK(names.size() == 2);
+    CHECK(std::strcmp(names[0], "VK_KHR_swapchain") == 0);
+    CHECK(std::strcmp(names[1], VK_NV_LOW_LATENCY_EXTENSION_NAME) == 0);
+}
+
+static void GrowingDriverList()
+{
+    driver = {};
+    driver.List = { Ext("VK_KHR_swapchain"), Ext("VK_KHR_maintenance1") };
+    driver.GrowBy = { Ext("VK_EXT_layer_added") };
+    driver.GrowTimes = 2;
+
+    std::vector<VkExtensionProperties> extensions;
+    auto result = EnumerateDeviceExtensions(FakeEnumerateDevice, nullptr, extensions);
+
+    // Grew twice, so two short fills and one that fits
+    CHECK(result == VK_SUCCESS);
+    CHECK(driver.Calls == 6);
+    CHECK(extensions.size() == 4);
+    CHECK(Names(extensions) == Names(driver.List));
+
+    // Instance side works the same
+    driver.Calls = 0;
+    driver.GrowTimes = 1;
+
+    std::vector<VkExtensionProperties> instance;
+    result = EnumerateInstanceExtensions(FakeEnumerateInstance, instance);
+    CHECK(result == VK_SUCCESS);
+    CHECK(driver.Calls == 4);
+    CHECK(instance.size() == 5);
+
+    // Errors are returned as is
+    driver.Error = VK_ERROR_INITIALIZATION_FAILED;
+    driver.Calls = 0;
+    CHECK(EnumerateDeviceExtensions(FakeEnumerateDevice, nullptr, extensions) == VK_ERROR_INITIALIZATION_FAILED);
+    CHECK(driver.Calls == 1);
+}
+
+static void ShortGameBuffer()
+{
+    std::vector<VkExtensionProperties> extensions { Ext("A"), Ext("B"), Ext("C"), Ext("D") };
+
+    uint32_t count = 0;
+    CHECK(CopyExtensions(extensions, &count, nullptr) == VK_SUCCESS);
+    CHECK(count == 4);
+
+    // Short buffer, fills what fits and leaves the rest alone
+    VkExtensionProperties buffer[5] {};
+    buffer[2] = Ext("untouched");
+    count = 2;
+    CHECK(CopyExtensions(extensions, &count, buffer) == VK_INCOMPLETE);
+    CHECK(count == 2);
+    CHECK(std::strcmp(buffer[0].extensionName, "A") == 0);
+    CHECK(std::strcmp(buffer[1].extensionName, "B") == 0);
+    CHECK(std::strcmp(buffer[2].extensionName, "untouched") == 0);
+
+    count = 0;
+    CHECK(CopyExtensions(extensions, &count, buffer) == VK_INCOMPLETE);
+    CHECK(count == 0);
+
+    count = 4;
+    CHECK(CopyExtensions(extensions, &count, buffer) == VK_SUCCESS);
+    CHECK(count == 4);
+    CHECK(std::strcmp(buffer[3].extensionName, "D") == 0);
+
+    // Bigger buffer gets the real count back
+    buffer[4] = Ext("untouched");
+    count = 5;
+    CHECK(CopyExtensions(extensions, &count, buffer) == VK_SUCCESS);
+    CHECK(count == 4);
+    CHECK(std::strcmp(buffer[4].extensionName, "untouched") == 0);
+}
+
+static void FGSetChange()
+{
+    DeviceExtensionCache cache;
+    cache.Driver = { Ext("VK_KHR_swapchain"), Ext(VK_NV_OPTICAL_FLOW_EXTENSION_NAME) };
+
+    CHECK(UpdateSpoofedDeviceExtensions(cache, false));
+    CHECK(CountOf(cache.Spoofed, VK_NV_PRESENT_METERING_EXTENSION_NAME) == 0);
+    CHECK(CountOf(cache.Spoofed, VK_NV_OPTICAL_FLOW_EXTENSION_NAME) == 1);
+    CHECK(CountOf(cache.Spoofed, VK_NV_LOW_LATENCY_EXTENSION_NAME) == 1);
+    auto withoutFG = Names(cache.Spoofed);
+
+    // Same FG state serves the cached list
+    cache.Spoofed.pop_back();
+    CHECK(!UpdateSpoofedDeviceExtensions(cache, false));
+    CHECK(cache.Spoofed.size() == withoutFG.size() - 1);
+
+    // Empty list is rebuilt
+    cache.Spoofed.clear();
+    CHECK(UpdateSpoofedDeviceExtensions(cache, false));
+    CHECK(Names(cache.Spoofed) == withoutFG);
+
+    // DLSSG became active, FG extensions show up once without duplicating the driver's optical flow
+    CHECK(UpdateSpoofedDeviceExtensions(cache, true));
+    CHECK(cache.SpoofedWithFG);
+    CHECK(CountOf(cache.Spoofed, VK_NV_PRESENT_METERING_EXTENSION_NAME) == 1);
+    CHECK(CountOf(cache.Spoofed, VK_NV_OPTICAL_FLOW_EXTENSION_NAME) == 1);
+    CHECK(cache.Spoofed.size() == withoutFG.size() + 1);
+    CHECK(!UpdateSpoofedDeviceExtensions(cache, true));
+
+    // And back, driver list itself is never touched
+    CHECK(UpdateSpoofedDeviceExtensions(cache, false));
+    CHECK(Names(cache.Spoofed) == withoutFG);
+    CHECK(cache.Driver.size() == 2);
+
+    // Game sees the new count in the next two call enumeration
+    uint32_t count = 0;
+    CopyExtensions(cache.Spoofed, &count, nullptr);
+    CHECK(count == withoutFG.size());
+}
+
+int main()
+{
+    MergeDedupAndOrder();
+    GrowingDriverList();
+    ShortGameBuffer();
+    FGSetChange();
+
+    if (failures == 0)
+        printf("All checks passed\n");
+
+    return failures == 0 ? 0 : 1;
+}